@@ -0,0 +1,179 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocalution_bench.hpp"
+#include "utility.hpp"
+
+#include <boost/program_options.hpp>
+#include <iostream>
+#include <rocalution.hpp>
+#include <string>
+#include <vector>
+
+namespace po = boost::program_options;
+
+int device;
+
+int main(int argc, char* argv[])
+{
+    Arguments arg;
+
+    std::string format;
+    int         threads;
+
+    po::options_description opdesc("rocalution-bench command line options");
+    opdesc.add_options()("help,h", "produces this help message")
+        // clang-format off
+        ("sizen,n",
+         po::value<int>(&arg.size)->default_value(1000),
+         "Grid dimension for stencil generators, number of rows for random generator")
+
+        ("nnz-per-row",
+         po::value<int>(&arg.nnz_per_row)->default_value(20),
+         "Average number of non-zeros per row for random generator")
+
+        ("matrix,m",
+         po::value<std::string>(&arg.matrix)->default_value("laplace2d"),
+         "Matrix generator: laplace2d, laplace3d, stencil27, random, mtx")
+
+        ("file,f",
+         po::value<std::string>(&arg.filename)->default_value(""),
+         "Matrix Market file, if --matrix mtx is used")
+
+        ("format",
+         po::value<std::string>(&format)->default_value("CSR"),
+         "Matrix format: CSR, MCSR, COO, DIA, ELL, HYB, DENSE, AUTO")
+
+        ("function",
+         po::value<std::string>(&arg.function)->default_value("spmv"),
+         "Benchmark function: all, dot, nrm2, reduce, asum, axpy, scaleadd, axpby, pointwise, "
+         "spmv, spmv_add, lsolve, usolve, spgemm, convert, amg_sa, amg_ua, amg_rs, amg_pw, "
+         "cg, cg_jacobi, cg_saamg, gmres_ilu, bicgstab_ilu")
+
+        ("precision,r",
+         po::value<std::string>(&arg.precision)->default_value("d"),
+         "Value type: s (float), d (double)")
+
+        ("iters,i",
+         po::value<int>(&arg.iters)->default_value(10),
+         "Number of timed iterations per kernel")
+
+        ("threads,t",
+         po::value<int>(&threads)->default_value(0),
+         "Number of OpenMP threads (0 = default)")
+
+        ("device,d",
+         po::value<int>(&device)->default_value(0),
+         "Accelerator device ID")
+
+        ("json,j",
+         po::value<std::string>(&arg.json)->default_value(""),
+         "Write results to JSON file");
+    // clang-format on
+
+    po::variables_map vm;
+
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, opdesc), vm);
+        po::notify(vm);
+    }
+    catch(const po::error& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+
+    if(vm.count("help"))
+    {
+        std::cout << opdesc << std::endl;
+        return 0;
+    }
+
+    if(arg.precision != "s" && arg.precision != "d")
+    {
+        std::cerr << "Invalid value for --precision" << std::endl;
+        return -1;
+    }
+
+    if(bench_function_valid(arg.function) == false)
+    {
+        std::cerr << "Invalid value for --function" << std::endl;
+        return -1;
+    }
+
+    if(arg.matrix == "mtx" && arg.filename == "")
+    {
+        std::cerr << "--matrix mtx requires --file" << std::endl;
+        return -1;
+    }
+
+    // Matrix format
+    if(matrix_format_from_name(format, arg.format) == false || arg.format == BCSR)
+    {
+        std::cerr << "Invalid value for --format" << std::endl;
+        return -1;
+    }
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    if(threads > 0)
+    {
+        set_omp_threads_rocalution(threads);
+    }
+
+    info_rocalution();
+
+    int m   = 0;
+    int nnz = 0;
+
+    std::vector<bench_result> results;
+
+    bool status = (arg.precision == "s") ? run_benchmark<float>(arg, &m, &nnz, &results)
+                                         : run_benchmark<double>(arg, &m, &nnz, &results);
+
+    if(status == true)
+    {
+        std::cout << "matrix = " << (arg.matrix == "mtx" ? arg.filename : arg.matrix)
+                  << ", format = " << format << ", m = " << m << ", nnz = " << nnz << std::endl;
+
+        bench_print(results);
+
+        if(arg.json != "")
+        {
+            status = bench_write_json(arg.json, arg, get_omp_threads_rocalution(), m, nnz, results);
+
+            if(status == false)
+            {
+                std::cerr << "Cannot write JSON file " << arg.json << std::endl;
+            }
+        }
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return status ? 0 : -1;
+}
@@ -0,0 +1,664 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef ROCALUTION_BENCH_HPP
+#define ROCALUTION_BENCH_HPP
+
+#include "utility.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <rocalution.hpp>
+#include <string>
+#include <vector>
+
+using namespace rocalution;
+
+/* ============================================================================================ */
+/*! \brief Single benchmark record */
+struct bench_result
+{
+    std::string function;
+
+    // Averaged time per call
+    double msec;
+
+    // Effective memory bandwidth and compute throughput (0 if not meaningful)
+    double gbyte;
+    double gflop;
+
+    // Solver iterations (0 if not a solver benchmark)
+    int iter;
+};
+
+/* ============================================================================================ */
+/*! \brief All benchmark names that can be passed to --function */
+static const char* bench_functions[] = {"dot",
+                                        "nrm2",
+                                        "reduce",
+                                        "asum",
+                                        "axpy",
+                                        "scaleadd",
+                                        "axpby",
+                                        "pointwise",
+                                        "spmv",
+                                        "spmv_add",
+                                        "lsolve",
+                                        "usolve",
+                                        "spgemm",
+                                        "convert",
+                                        "amg_sa",
+                                        "amg_ua",
+                                        "amg_rs",
+                                        "amg_pw",
+                                        "cg",
+                                        "cg_jacobi",
+                                        "cg_saamg",
+                                        "gmres_ilu",
+                                        "bicgstab_ilu"};
+
+static bool bench_function_valid(const std::string& function)
+{
+    if(function == "all")
+    {
+        return true;
+    }
+
+    for(size_t i = 0; i < sizeof(bench_functions) / sizeof(bench_functions[0]); ++i)
+    {
+        if(function == bench_functions[i])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* ============================================================================================ */
+/*! \brief Run func() iters times (after one warm up call) and return msec per call */
+template <typename F>
+double bench_time(int iters, F func)
+{
+    func();
+
+    _rocalution_sync();
+    double tick = rocalution_time();
+
+    for(int i = 0; i < iters; ++i)
+    {
+        func();
+    }
+
+    _rocalution_sync();
+    double tack = rocalution_time();
+
+    return (tack - tick) / iters / 1e3;
+}
+
+/* ============================================================================================ */
+/*! \brief Build a record from time in msec, bytes and flops per call */
+static bench_result
+    bench_record(const std::string& function, double msec, double bytes, double flops)
+{
+    bench_result r;
+
+    r.function = function;
+    r.msec     = msec;
+    r.gbyte    = msec > 0.0 ? bytes / msec / 1e6 : 0.0;
+    r.gflop    = msec > 0.0 ? flops / msec / 1e6 : 0.0;
+    r.iter     = 0;
+
+    return r;
+}
+
+/* ============================================================================================ */
+/*! \brief Generate (or read) the benchmark matrix in CSR format */
+template <typename T>
+bool bench_generate_matrix(const Arguments& arg, LocalMatrix<T>* A)
+{
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = 0;
+
+    if(arg.matrix == "laplace2d")
+    {
+        nrow = gen_2d_laplacian(arg.size, &csr_ptr, &csr_col, &csr_val);
+    }
+    else if(arg.matrix == "laplace3d")
+    {
+        nrow = gen_3d_laplacian(arg.size, &csr_ptr, &csr_col, &csr_val, false);
+    }
+    else if(arg.matrix == "stencil27")
+    {
+        nrow = gen_3d_laplacian(arg.size, &csr_ptr, &csr_col, &csr_val, true);
+    }
+    else if(arg.matrix == "random")
+    {
+        nrow = gen_random_sparse(arg.size, arg.nnz_per_row, 12345U, &csr_ptr, &csr_col, &csr_val);
+    }
+    else if(arg.matrix == "mtx")
+    {
+        A->ReadFileMTX(arg.filename);
+        A->ConvertToCSR();
+        return A->GetNnz() > 0;
+    }
+    else
+    {
+        return false;
+    }
+
+    if(nrow == 0)
+    {
+        return false;
+    }
+
+    A->SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", csr_ptr[nrow], nrow, nrow);
+
+    return true;
+}
+
+/* ============================================================================================ */
+/*! \brief BLAS-1 benchmarks */
+template <typename T>
+bool bench_level1(const Arguments& arg, int size, std::vector<bench_result>* results)
+{
+    const std::string& f = arg.function;
+    const bool         a = (f == "all");
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+
+    x.MoveToAccelerator();
+    y.MoveToAccelerator();
+
+    x.Allocate("x", size);
+    y.Allocate("y", size);
+
+    x.Ones();
+    y.Ones();
+
+    double s = static_cast<double>(size);
+    double v = static_cast<double>(sizeof(T));
+
+    if(a || f == "dot")
+    {
+        double t = bench_time(arg.iters, [&]() { x.Dot(y); });
+        results->push_back(bench_record("dot", t, 2.0 * s * v, 2.0 * s));
+    }
+
+    if(a || f == "nrm2")
+    {
+        double t = bench_time(arg.iters, [&]() { x.Norm(); });
+        results->push_back(bench_record("nrm2", t, s * v, 2.0 * s));
+    }
+
+    if(a || f == "reduce")
+    {
+        double t = bench_time(arg.iters, [&]() { x.Reduce(); });
+        results->push_back(bench_record("reduce", t, s * v, s));
+    }
+
+    if(a || f == "asum")
+    {
+        double t = bench_time(arg.iters, [&]() { x.Asum(); });
+        results->push_back(bench_record("asum", t, s * v, 2.0 * s));
+    }
+
+    if(a || f == "axpy")
+    {
+        double t = bench_time(arg.iters, [&]() { y.AddScale(x, static_cast<T>(1e-8)); });
+        results->push_back(bench_record("axpy", t, 3.0 * s * v, 2.0 * s));
+    }
+
+    if(a || f == "scaleadd")
+    {
+        double t = bench_time(arg.iters, [&]() { y.ScaleAdd(static_cast<T>(0.5), x); });
+        results->push_back(bench_record("scaleadd", t, 3.0 * s * v, 2.0 * s));
+    }
+
+    if(a || f == "axpby")
+    {
+        double t = bench_time(arg.iters, [&]() {
+            y.ScaleAddScale(static_cast<T>(0.5), x, static_cast<T>(0.5));
+        });
+        results->push_back(bench_record("axpby", t, 3.0 * s * v, 3.0 * s));
+    }
+
+    if(a || f == "pointwise")
+    {
+        double t = bench_time(arg.iters, [&]() { y.PointWiseMult(x); });
+        results->push_back(bench_record("pointwise", t, 3.0 * s * v, s));
+    }
+
+    return true;
+}
+
+/* ============================================================================================ */
+/*! \brief Sparse matrix vector product, triangular solve, SpGEMM and conversion
+ *  benchmarks
+ */
+template <typename T>
+bool bench_sparse(const Arguments&           arg,
+                  const LocalMatrix<T>&      csr,
+                  std::vector<bench_result>* results)
+{
+    const std::string& f = arg.function;
+    const bool         a = (f == "all");
+
+    double m   = static_cast<double>(csr.GetM());
+    double n   = static_cast<double>(csr.GetN());
+    double nnz = static_cast<double>(csr.GetNnz());
+    double v   = static_cast<double>(sizeof(T));
+    double i   = static_cast<double>(sizeof(int));
+
+    // CSR matrix traffic, used as reference for all formats
+    double mat_bytes = nnz * (v + i) + (m + 1.0) * i;
+
+    if(a || f == "spmv" || f == "spmv_add")
+    {
+        LocalMatrix<T> A;
+        LocalVector<T> x;
+        LocalVector<T> y;
+
+        A.CloneFrom(csr);
+        A.ConvertTo(arg.format);
+
+        x.CloneBackend(A);
+        y.CloneBackend(A);
+
+        x.Allocate("x", A.GetN());
+        y.Allocate("y", A.GetM());
+
+        x.Ones();
+        y.Zeros();
+
+        if(a || f == "spmv")
+        {
+            double t = bench_time(arg.iters, [&]() { A.Apply(x, &y); });
+            results->push_back(bench_record("spmv", t, mat_bytes + (n + m) * v, 2.0 * nnz));
+        }
+
+        if(a || f == "spmv_add")
+        {
+            double t = bench_time(arg.iters, [&]() { A.ApplyAdd(x, static_cast<T>(1e-8), &y); });
+            results->push_back(
+                bench_record("spmv_add", t, mat_bytes + (n + 2.0 * m) * v, 3.0 * nnz));
+        }
+    }
+
+    if(a || f == "lsolve" || f == "usolve")
+    {
+        LocalMatrix<T> L;
+        LocalMatrix<T> U;
+        LocalVector<T> x;
+        LocalVector<T> y;
+
+        csr.ExtractL(&L, true);
+        csr.ExtractU(&U, true);
+
+        x.CloneBackend(csr);
+        y.CloneBackend(csr);
+
+        x.Allocate("x", csr.GetN());
+        y.Allocate("y", csr.GetM());
+
+        x.Ones();
+
+        if(a || f == "lsolve")
+        {
+            L.LAnalyse(false);
+
+            double lnnz = static_cast<double>(L.GetNnz());
+            double t    = bench_time(arg.iters, [&]() { L.LSolve(x, &y); });
+            results->push_back(bench_record(
+                "lsolve", t, lnnz * (v + i) + (m + 1.0) * i + 2.0 * m * v, 2.0 * lnnz));
+        }
+
+        if(a || f == "usolve")
+        {
+            U.UAnalyse(false);
+
+            double unnz = static_cast<double>(U.GetNnz());
+            double t    = bench_time(arg.iters, [&]() { U.USolve(x, &y); });
+            results->push_back(bench_record(
+                "usolve", t, unnz * (v + i) + (m + 1.0) * i + 2.0 * m * v, 2.0 * unnz));
+        }
+    }
+
+    if((a || f == "spgemm") && csr.GetM() == csr.GetN())
+    {
+        // Number of products of A*A is the sum over all entries a_ik of nnz(row k)
+        LocalMatrix<T> H;
+        H.CloneFrom(csr);
+        H.MoveToHost();
+
+        int* ptr = NULL;
+        int* col = NULL;
+        T*   val = NULL;
+
+        allocate_host(csr.GetM() + 1, &ptr);
+        allocate_host(csr.GetNnz(), &col);
+        allocate_host(csr.GetNnz(), &val);
+
+        H.CopyToCSR(ptr, col, val);
+
+        double prod = 0.0;
+        for(int j = 0; j < csr.GetNnz(); ++j)
+        {
+            prod += ptr[col[j] + 1] - ptr[col[j]];
+        }
+
+        free_host(&ptr);
+        free_host(&col);
+        free_host(&val);
+
+        LocalMatrix<T> C;
+        C.CloneBackend(csr);
+
+        double t = bench_time(arg.iters, [&]() { C.MatrixMult(csr, csr); });
+
+        results->push_back(bench_record(
+            "spgemm", t, 2.0 * mat_bytes + static_cast<double>(C.GetNnz()) * (v + i), 2.0 * prod));
+    }
+
+    if((a || f == "convert") && arg.format != CSR)
+    {
+        LocalMatrix<T> A;
+        A.CloneFrom(csr);
+
+        // Time a conversion into the requested format and back
+        double t = bench_time(arg.iters, [&]() {
+            A.ConvertTo(arg.format);
+            A.ConvertToCSR();
+        });
+
+        results->push_back(bench_record("convert", t, 4.0 * mat_bytes, 0.0));
+    }
+
+    return true;
+}
+
+/* ============================================================================================ */
+/*! \brief AMG setup benchmarks */
+template <typename T>
+bool bench_amg_setup(const Arguments&           arg,
+                     const LocalMatrix<T>&      csr,
+                     std::vector<bench_result>* results)
+{
+    const std::string& f = arg.function;
+    const bool         a = (f == "all");
+
+    // Hierarchy builds are expensive, do not repeat them more often than necessary
+    int iters = std::min(arg.iters, 5);
+
+    if(a || f == "amg_sa")
+    {
+        double t = bench_time(iters, [&]() {
+            SAAMG<LocalMatrix<T>, LocalVector<T>, T> p;
+            p.SetOperator(csr);
+            p.SetOperatorFormat(arg.format);
+            p.Verbose(0);
+            p.Build();
+        });
+        results->push_back(bench_record("amg_sa", t, 0.0, 0.0));
+    }
+
+    if(a || f == "amg_ua")
+    {
+        double t = bench_time(iters, [&]() {
+            UAAMG<LocalMatrix<T>, LocalVector<T>, T> p;
+            p.SetOperator(csr);
+            p.SetOperatorFormat(arg.format);
+            p.Verbose(0);
+            p.Build();
+        });
+        results->push_back(bench_record("amg_ua", t, 0.0, 0.0));
+    }
+
+    if(a || f == "amg_rs")
+    {
+        double t = bench_time(iters, [&]() {
+            RugeStuebenAMG<LocalMatrix<T>, LocalVector<T>, T> p;
+            p.SetOperator(csr);
+            p.SetOperatorFormat(arg.format);
+            p.Verbose(0);
+            p.Build();
+        });
+        results->push_back(bench_record("amg_rs", t, 0.0, 0.0));
+    }
+
+    if(a || f == "amg_pw")
+    {
+        double t = bench_time(iters, [&]() {
+            PairwiseAMG<LocalMatrix<T>, LocalVector<T>, T> p;
+            p.SetOperator(csr);
+            p.SetOperatorFormat(arg.format);
+            p.Verbose(0);
+            p.Build();
+        });
+        results->push_back(bench_record("amg_pw", t, 0.0, 0.0));
+    }
+
+    return true;
+}
+
+/* ============================================================================================ */
+/*! \brief Solve A x = A * 1 with the given solver and (optional) preconditioner */
+template <typename T>
+bench_result bench_solve_single(const std::string&                                        name,
+                                const LocalMatrix<T>&                                     csr,
+                                unsigned int                                              format,
+                                IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>& ls,
+                                Solver<LocalMatrix<T>, LocalVector<T>, T>*                p)
+{
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    A.CloneFrom(csr);
+
+    x.CloneBackend(A);
+    b.CloneBackend(A);
+    e.CloneBackend(A);
+
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    e.Ones();
+    A.Apply(e, &b);
+    x.Zeros();
+
+    ls.SetOperator(A);
+
+    if(p != NULL)
+    {
+        ls.SetPreconditioner(*p);
+    }
+
+    ls.Verbose(0);
+    ls.Init(1e-8, 1e-8, 1e+8, 10000);
+
+    _rocalution_sync();
+    double tick = rocalution_time();
+
+    ls.Build();
+
+    _rocalution_sync();
+    double tack = rocalution_time();
+
+    double build = (tack - tick) / 1e3;
+
+    A.ConvertTo(format);
+
+    _rocalution_sync();
+    tick = rocalution_time();
+
+    ls.Solve(b, &x);
+
+    _rocalution_sync();
+    tack = rocalution_time();
+
+    bench_result r = bench_record(name, build + (tack - tick) / 1e3, 0.0, 0.0);
+    r.iter         = ls.GetIterationCount();
+
+    ls.Clear();
+
+    return r;
+}
+
+/* ============================================================================================ */
+/*! \brief Full solver benchmarks (setup + solve) */
+template <typename T>
+bool bench_solve(const Arguments&           arg,
+                 const LocalMatrix<T>&      csr,
+                 std::vector<bench_result>* results)
+{
+    const std::string& f = arg.function;
+    const bool         a = (f == "all");
+
+    if(a || f == "cg")
+    {
+        CG<LocalMatrix<T>, LocalVector<T>, T> ls;
+        results->push_back(bench_solve_single<T>("cg", csr, arg.format, ls, NULL));
+    }
+
+    if(a || f == "cg_jacobi")
+    {
+        CG<LocalMatrix<T>, LocalVector<T>, T>     ls;
+        Jacobi<LocalMatrix<T>, LocalVector<T>, T> p;
+        results->push_back(bench_solve_single<T>("cg_jacobi", csr, arg.format, ls, &p));
+    }
+
+    if(a || f == "cg_saamg")
+    {
+        CG<LocalMatrix<T>, LocalVector<T>, T>    ls;
+        SAAMG<LocalMatrix<T>, LocalVector<T>, T> p;
+        p.SetOperatorFormat(arg.format);
+        p.InitMaxIter(1);
+        p.Verbose(0);
+        results->push_back(bench_solve_single<T>("cg_saamg", csr, arg.format, ls, &p));
+    }
+
+    if(a || f == "gmres_ilu")
+    {
+        GMRES<LocalMatrix<T>, LocalVector<T>, T> ls;
+        ILU<LocalMatrix<T>, LocalVector<T>, T>   p;
+        results->push_back(bench_solve_single<T>("gmres_ilu", csr, arg.format, ls, &p));
+    }
+
+    if(a || f == "bicgstab_ilu")
+    {
+        BiCGStab<LocalMatrix<T>, LocalVector<T>, T> ls;
+        ILU<LocalMatrix<T>, LocalVector<T>, T>      p;
+        results->push_back(bench_solve_single<T>("bicgstab_ilu", csr, arg.format, ls, &p));
+    }
+
+    return true;
+}
+
+/* ============================================================================================ */
+/*! \brief Run all requested benchmarks for value type T */
+template <typename T>
+bool run_benchmark(const Arguments& arg, int* m, int* nnz, std::vector<bench_result>* results)
+{
+    LocalMatrix<T> A;
+
+    if(bench_generate_matrix(arg, &A) == false)
+    {
+        std::cerr << "Cannot generate matrix '" << arg.matrix << "'" << std::endl;
+        return false;
+    }
+
+    A.MoveToAccelerator();
+
+    *m   = A.GetM();
+    *nnz = A.GetNnz();
+
+    return bench_level1<T>(arg, A.GetM(), results) && bench_sparse<T>(arg, A, results)
+           && bench_amg_setup<T>(arg, A, results) && bench_solve<T>(arg, A, results);
+}
+
+/* ============================================================================================ */
+/*! \brief Print results as table */
+static void bench_print(const std::vector<bench_result>& results)
+{
+    std::cout << std::setw(14) << "function" << std::setw(14) << "msec" << std::setw(14)
+              << "GB/s" << std::setw(14) << "GFlop/s" << std::setw(10) << "iter" << std::endl;
+
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        std::cout << std::setw(14) << results[i].function << std::setw(14) << results[i].msec
+                  << std::setw(14) << results[i].gbyte << std::setw(14) << results[i].gflop
+                  << std::setw(10) << results[i].iter << std::endl;
+    }
+}
+
+/* ============================================================================================ */
+/*! \brief Write results as JSON for regression tracking */
+static bool bench_write_json(const std::string&               filename,
+                             const Arguments&                 arg,
+                             int                              threads,
+                             int                              m,
+                             int                              nnz,
+                             const std::vector<bench_result>& results)
+{
+    std::ofstream out(filename.c_str());
+
+    if(!out.is_open())
+    {
+        return false;
+    }
+
+    out << "{" << std::endl;
+    out << "  \"matrix\": \"" << (arg.matrix == "mtx" ? arg.filename : arg.matrix) << "\","
+        << std::endl;
+    out << "  \"format\": \"" << matrix_format_name(arg.format) << "\"," << std::endl;
+    out << "  \"precision\": \"" << arg.precision << "\"," << std::endl;
+    out << "  \"threads\": " << threads << "," << std::endl;
+    out << "  \"m\": " << m << "," << std::endl;
+    out << "  \"nnz\": " << nnz << "," << std::endl;
+    out << "  \"iters\": " << arg.iters << "," << std::endl;
+    out << "  \"results\": [" << std::endl;
+
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        out << "    {\"function\": \"" << results[i].function << "\", \"msec\": "
+            << results[i].msec << ", \"gbyte_s\": " << results[i].gbyte
+            << ", \"gflop_s\": " << results[i].gflop << ", \"iter\": " << results[i].iter << "}"
+            << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+
+    out << "  ]" << std::endl;
+    out << "}" << std::endl;
+
+    return true;
+}
+
+#endif // ROCALUTION_BENCH_HPP
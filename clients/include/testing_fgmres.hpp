@@ -83,6 +83,9 @@ bool testing_fgmres(Arguments argus)
     // Preconditioner
     Preconditioner<LocalMatrix<T>, LocalVector<T>, T>* p;
 
+    // Solver of the last block of the multi-elimination preconditioner
+    Jacobi<LocalMatrix<T>, LocalVector<T>, T> me_last_block;
+
     if(precond == "None")
         p = NULL;
     else if(precond == "Chebyshev")
@@ -125,6 +128,14 @@ bool testing_fgmres(Arguments argus)
         p = new MultiColoredSGS<LocalMatrix<T>, LocalVector<T>, T>;
     else if(precond == "MCILU")
         p = new MultiColoredILU<LocalMatrix<T>, LocalVector<T>, T>;
+    else if(precond == "ME")
+    {
+        MultiElimination<LocalMatrix<T>, LocalVector<T>, T>* me
+            = new MultiElimination<LocalMatrix<T>, LocalVector<T>, T>;
+        me->Set(me_last_block, 2);
+
+        p = me;
+    }
     else
         return false;
 
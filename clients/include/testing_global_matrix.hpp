@@ -27,7 +27,11 @@
 
 #include "utility.hpp"
 
+#include <cmath>
+#include <cstdlib>
+#include <vector>
 #include <gtest/gtest.h>
+#include <mpi.h>
 #include <rocalution.hpp>
 
 using namespace rocalution;
@@ -375,4 +379,354 @@ void testing_global_matrix_bad_args(void)
     stop_rocalution();
 }
 
+template <typename T>
+void testing_global_matrix_apply_add(void)
+{
+    // The test driver does not initialize MPI
+    int mpi_init;
+    MPI_Initialized(&mpi_init);
+
+    if(mpi_init == false)
+    {
+        MPI_Init(NULL, NULL);
+        std::atexit([](void) { MPI_Finalize(); });
+    }
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    int rank;
+    int nprocs;
+
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &nprocs);
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Each process owns n rows and receives the last nb entries of the previous process
+    // as ghost values, a single process exchanges them with itself
+    int n    = 100;
+    int nb   = 10;
+    int prev = (rank + nprocs - 1) % nprocs;
+    int next = (rank + 1) % nprocs;
+
+    ParallelManager pm;
+    pm.SetMPICommunicator(&comm);
+    pm.SetGlobalSize(static_cast<IndexType2>(nprocs) * n);
+    pm.SetLocalSize(n);
+
+    int bnd[10];
+    int recvs[1]       = {prev};
+    int sends[1]       = {next};
+    int recv_offset[2] = {0, nb};
+    int send_offset[2] = {0, nb};
+
+    for(int k = 0; k < nb; ++k)
+    {
+        bnd[k] = n - nb + k;
+    }
+
+    pm.SetBoundaryIndex(nb, bnd);
+    pm.SetReceivers(1, recvs, recv_offset);
+    pm.SetSenders(1, sends, send_offset);
+
+    // Assembled rows of this process, with global column indices
+    std::vector<int> ref_ptr(n + 1, 0);
+    std::vector<int> ref_col;
+    std::vector<T>   ref_val;
+
+    // Interior and ghost part
+    int* int_ptr = NULL;
+    int* int_col = NULL;
+    T*   int_val = NULL;
+    int* gst_ptr = NULL;
+    int* gst_col = NULL;
+    T*   gst_val = NULL;
+
+    allocate_host(n + 1, &int_ptr);
+    allocate_host(n + 1, &gst_ptr);
+    allocate_host(3 * n, &int_col);
+    allocate_host(3 * n, &int_val);
+    allocate_host(2 * nb, &gst_col);
+    allocate_host(2 * nb, &gst_val);
+
+    int int_nnz = 0;
+    int gst_nnz = 0;
+
+    int_ptr[0] = 0;
+    gst_ptr[0] = 0;
+
+    for(int i = 0; i < n; ++i)
+    {
+        // Tridiagonal interior part
+        for(int j = std::max(i - 1, 0); j <= std::min(i + 1, n - 1); ++j)
+        {
+            T val = (i == j) ? static_cast<T>(4) : static_cast<T>(-1) + static_cast<T>(0.1) * j;
+
+            int_col[int_nnz] = j;
+            int_val[int_nnz] = val;
+            ++int_nnz;
+
+            ref_col.push_back(rank * n + j);
+            ref_val.push_back(val);
+        }
+
+        // The first rows couple to two ghost values
+        if(i < nb)
+        {
+            int g[2] = {i, (i + 3) % nb};
+
+            std::sort(g, g + 2);
+
+            for(int k = 0; k < 2; ++k)
+            {
+                T val = static_cast<T>(-0.5) - static_cast<T>(0.05) * (i + k);
+
+                gst_col[gst_nnz] = g[k];
+                gst_val[gst_nnz] = val;
+                ++gst_nnz;
+
+                ref_col.push_back(prev * n + bnd[g[k]]);
+                ref_val.push_back(val);
+            }
+        }
+
+        int_ptr[i + 1] = int_nnz;
+        gst_ptr[i + 1] = gst_nnz;
+        ref_ptr[i + 1] = static_cast<int>(ref_col.size());
+    }
+
+    GlobalMatrix<T> A(pm);
+    A.SetDataPtrCSR(
+        &int_ptr, &int_col, &int_val, &gst_ptr, &gst_col, &gst_val, "A", int_nnz, gst_nnz);
+
+    GlobalVector<T> x(pm);
+    GlobalVector<T> y(pm);
+
+    x.Allocate("x", A.GetN());
+    y.Allocate("y", A.GetM());
+
+    // Reference on the assembled rows and the complete vector x
+    int* lptr = NULL;
+    int* lcol = NULL;
+    T*   lval = NULL;
+
+    int ref_nnz = ref_ptr[n];
+
+    allocate_host(n + 1, &lptr);
+    allocate_host(ref_nnz, &lcol);
+    allocate_host(ref_nnz, &lval);
+
+    std::copy(ref_ptr.begin(), ref_ptr.end(), lptr);
+    std::copy(ref_col.begin(), ref_col.end(), lcol);
+    std::copy(ref_val.begin(), ref_val.end(), lval);
+
+    LocalMatrix<T> B;
+    B.SetDataPtrCSR(&lptr, &lcol, &lval, "B", ref_nnz, n, nprocs * n);
+
+    LocalVector<T> xg;
+    LocalVector<T> yr;
+
+    xg.Allocate("xg", nprocs * n);
+    yr.Allocate("yr", n);
+
+    for(int i = 0; i < nprocs * n; ++i)
+    {
+        xg[i] = static_cast<T>(std::sin(0.1 * i));
+    }
+
+    for(int i = 0; i < n; ++i)
+    {
+        x.GetInterior()[i] = xg[rank * n + i];
+        y.GetInterior()[i] = static_cast<T>(std::cos(0.1 * (rank * n + i)));
+        yr[i]              = y.GetInterior()[i];
+    }
+
+    T scalar = static_cast<T>(-0.75);
+
+    A.ApplyAdd(x, scalar, &y);
+    B.ApplyAdd(xg, scalar, &yr);
+
+    for(int i = 0; i < n; ++i)
+    {
+        ASSERT_NEAR(y.GetInterior()[i], yr[i], 1e-4);
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_global_matrix_distribute(void)
+{
+    // The test driver does not initialize MPI
+    int mpi_init;
+    MPI_Initialized(&mpi_init);
+
+    if(mpi_init == false)
+    {
+        MPI_Init(NULL, NULL);
+        std::atexit([](void) { MPI_Finalize(); });
+    }
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    int rank;
+    int nprocs;
+
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &nprocs);
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // 2D Laplacian with randomly shuffled rows and columns, assembled on all processes
+    // for the reference, but only distributed from the root process
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int n   = gen_2d_laplacian(30, &csr_ptr, &csr_col, &csr_val);
+    int nnz = csr_ptr[n];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, n, n);
+
+    std::vector<int> shuffle(n);
+
+    for(int i = 0; i < n; ++i)
+    {
+        shuffle[i] = i;
+    }
+
+    unsigned int seed = 12345;
+    for(int i = n - 1; i > 0; --i)
+    {
+        seed = seed * 1103515245 + 12345;
+        std::swap(shuffle[i], shuffle[(seed >> 8) % (i + 1)]);
+    }
+
+    LocalVector<int> shuffle_perm;
+    shuffle_perm.Allocate("shuffle", n);
+    shuffle_perm.CopyFromData(shuffle.data());
+
+    A.Permute(shuffle_perm);
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+
+    x.Allocate("x", n);
+    y.Allocate("y", n);
+
+    for(int i = 0; i < n; ++i)
+    {
+        x[i] = static_cast<T>(std::sin(0.1 * i));
+    }
+
+    A.Apply(x, &y);
+
+    // Distribute
+    ParallelManager pm;
+    pm.SetMPICommunicator(&comm);
+
+    LocalVector<int> perm;
+    GlobalMatrix<T>  GA;
+
+    GA.DistributeFrom(A, &pm, &perm);
+
+    ASSERT_EQ(pm.GetGlobalSize(), n);
+    ASSERT_EQ(GA.GetM(), n);
+
+    GlobalVector<T> gx(pm);
+    GlobalVector<T> gy(pm);
+    GlobalVector<T> gb(pm);
+
+    gx.DistributeFrom(x, perm);
+    gb.DistributeFrom(y, perm);
+    gy.Allocate("gy", n);
+
+    // Original row of each global row of the distribution
+    std::vector<int> hperm(n);
+    std::vector<int> rows(n);
+
+    if(rank == 0)
+    {
+        ASSERT_EQ(perm.GetSize(), n);
+        perm.CopyToData(hperm.data());
+    }
+
+    MPI_Bcast(hperm.data(), n, MPI_INT, 0, comm);
+
+    for(int i = 0; i < n; ++i)
+    {
+        rows[hperm[i]] = i;
+    }
+
+    int local_size = pm.GetLocalSize();
+    int begin      = 0;
+
+    MPI_Exscan(&local_size, &begin, 1, MPI_INT, MPI_SUM, comm);
+
+    if(rank == 0)
+    {
+        begin = 0;
+    }
+
+    // The distributed product matches the product of the assembled matrix
+    GA.Apply(gx, &gy);
+
+    for(int k = 0; k < local_size; ++k)
+    {
+        int i = rows[begin + k];
+
+        ASSERT_EQ(gx.GetInterior()[k], x[i]);
+        ASSERT_EQ(gb.GetInterior()[k], y[i]);
+        ASSERT_NEAR(gy.GetInterior()[k], y[i], 1e-4);
+    }
+
+    // CG on the distributed and on the assembled matrix, y = A x is the right-hand side
+    CG<GlobalMatrix<T>, GlobalVector<T>, T> gls;
+    CG<LocalMatrix<T>, LocalVector<T>, T>   ls;
+
+    gls.SetOperator(GA);
+    gls.Init(0.0, 1e-6, 1e+8, 1000);
+    gls.Verbose(0);
+    gls.Build();
+
+    ls.SetOperator(A);
+    ls.Init(0.0, 1e-6, 1e+8, 1000);
+    ls.Verbose(0);
+    ls.Build();
+
+    LocalVector<T> z;
+    z.Allocate("z", n);
+    z.Zeros();
+
+    gx.Zeros();
+
+    gls.Solve(gb, &gx);
+    ls.Solve(y, &z);
+
+    // Both stop on the relative tolerance
+    ASSERT_EQ(gls.GetSolverStatus(), 2);
+    ASSERT_EQ(ls.GetSolverStatus(), 2);
+    ASSERT_LE(std::abs(gls.GetIterationCount() - ls.GetIterationCount()), 1);
+
+    for(int k = 0; k < local_size; ++k)
+    {
+        int i = rows[begin + k];
+
+        ASSERT_NEAR(gx.GetInterior()[k], z[i], 1e-3);
+        ASSERT_NEAR(gx.GetInterior()[k], x[i], 1e-3);
+    }
+
+    gls.Clear();
+    ls.Clear();
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
 #endif // TESTING_GLOBAL_MATRIX_HPP
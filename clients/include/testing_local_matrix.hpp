@@ -27,8 +27,15 @@
 
 #include "utility.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <limits>
 #include <rocalution.hpp>
+#include <sys/mman.h>
+#include <vector>
 
 using namespace rocalution;
 
@@ -85,7 +92,8 @@ void testing_local_matrix_bad_args(void)
         delete[] pmat;
     }
 
-    // CMK, RCMK, ConnectivityOrder, MultiColoring, MaximalIndependentSet, ZeroBlockPermutation
+    // CMK, RCMK, ConnectivityOrder, NestedDissection, LocalityOrder, Partition,
+    // MultiColoring, MaximalIndependentSet, ZeroBlockPermutation
     {
         int               val;
         LocalVector<int>* null_vec = nullptr;
@@ -93,6 +101,12 @@ void testing_local_matrix_bad_args(void)
         ASSERT_DEATH(mat1.RCMK(null_vec), ".*Assertion.*permutation != (NULL|__null)*");
         ASSERT_DEATH(mat1.ConnectivityOrder(null_vec),
                      ".*Assertion.*permutation != (NULL|__null)*");
+        ASSERT_DEATH(mat1.NestedDissection(null_vec),
+                     ".*Assertion.*permutation != (NULL|__null)*");
+        ASSERT_DEATH(mat1.LocalityOrder(64, null_vec),
+                     ".*Assertion.*permutation != (NULL|__null)*");
+        ASSERT_DEATH(mat1.LocalityOrder(0, &int1), ".*Assertion.*block_size > 0*");
+        ASSERT_DEATH(mat1.Partition(1, null_vec), ".*Assertion.*partition != (NULL|__null)*");
         ASSERT_DEATH(mat1.MultiColoring(val, &vint, &int1),
                      ".*Assertion.*size_colors == (NULL|__null)*");
         ASSERT_DEATH(mat1.MultiColoring(val, &null_int, null_vec),
@@ -339,4 +353,1808 @@ void testing_local_matrix_bad_args(void)
     stop_rocalution();
 }
 
+template <typename T>
+void testing_local_matrix_file_io(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(50, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    // Previous binary container, values in double precision
+    {
+        std::ofstream out("rocalution_test_v1.csr", std::ios::out | std::ios::binary);
+
+        int header[4] = {0, nrow, nrow, nnz};
+
+        out << "#rocALUTION binary csr file" << std::endl;
+        out.write((char*)header, sizeof(header));
+        out.write((char*)csr_ptr, (nrow + 1) * sizeof(int));
+        out.write((char*)csr_col, nnz * sizeof(int));
+
+        for(int i = 0; i < nnz; ++i)
+        {
+            double val = static_cast<double>(csr_val[i]);
+            out.write((char*)&val, sizeof(double));
+        }
+    }
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> z;
+
+    x.Allocate("x", nrow);
+    y.Allocate("y", nrow);
+    z.Allocate("z", nrow);
+
+    x.SetRandomUniform(12345ULL, -1.0, 1.0);
+    A.Apply(x, &y);
+
+    A.WriteFileCSR("rocalution_test.csr");
+
+    // Read and map the current container
+    LocalMatrix<T> B;
+    LocalMatrix<T> C;
+    LocalMatrix<T> D;
+
+    B.ReadFileCSR("rocalution_test.csr");
+    C.MapFileCSR("rocalution_test.csr");
+    D.ReadFileCSR("rocalution_test_v1.csr");
+
+    ASSERT_EQ(B.GetM(), nrow);
+    ASSERT_EQ(C.GetNnz(), nnz);
+    ASSERT_EQ(D.GetNnz(), nnz);
+
+    B.Apply(x, &z);
+    z.ScaleAdd(-1.0, y);
+    ASSERT_EQ(z.Norm(), static_cast<T>(0));
+
+    C.Apply(x, &z);
+    z.ScaleAdd(-1.0, y);
+    ASSERT_EQ(z.Norm(), static_cast<T>(0));
+
+    D.Apply(x, &z);
+    z.ScaleAdd(-1.0, y);
+    ASSERT_EQ(z.Norm(), static_cast<T>(0));
+
+    // Modifications of the mapped matrix do not touch the file
+    C.Scale(2.0);
+    C.ConvertToCOO();
+    C.ConvertToCSR();
+
+    LocalMatrix<T> E;
+    E.MapFileCSR("rocalution_test.csr");
+    E.Apply(x, &z);
+    z.ScaleAdd(-1.0, y);
+    ASSERT_EQ(z.Norm(), static_cast<T>(0));
+
+    // Values of the mapped matrix are replaced by SPAI
+    LocalVector<T> w;
+    w.Allocate("w", nrow);
+
+    B.SPAI();
+    E.SPAI();
+
+    B.Apply(x, &w);
+    E.Apply(x, &z);
+    z.ScaleAdd(-1.0, w);
+    ASSERT_EQ(z.Norm(), static_cast<T>(0));
+
+    // Vector
+    y.WriteFileBinary("rocalution_test.vec");
+    z.ReadFileBinary("rocalution_test.vec");
+    z.ScaleAdd(-1.0, y);
+    ASSERT_EQ(z.Norm(), static_cast<T>(0));
+
+    std::remove("rocalution_test.csr");
+    std::remove("rocalution_test_v1.csr");
+    std::remove("rocalution_test.vec");
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_matrix_file_stream(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    int*    csr_ptr = NULL;
+    int*    csr_col = NULL;
+    double* csr_val = NULL;
+
+    // Column indices and values exceed the 16 MB chunks files are streamed in
+    int nrow = gen_2d_laplacian(1000, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    {
+        LocalMatrix<double> A;
+        A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+        A.WriteFileCSR("rocalution_test_stream.csr");
+    }
+
+    // Convert the double precision file, the converted file is read with checksums
+    LocalMatrix<T>::ConvertFileCSR("rocalution_test_stream.csr",
+                                   "rocalution_test_stream_conv.csr");
+
+    LocalMatrix<T> B;
+    LocalMatrix<T> C;
+    LocalMatrix<T> D;
+
+    B.ReadFileCSR("rocalution_test_stream.csr");
+    C.ReadFileCSR("rocalution_test_stream_conv.csr");
+
+    // Rows spanning several chunks
+    int row_begin = 200 * 1000 + 17;
+    int row_end   = nrow - 100 * 1000 - 3;
+
+    D.ReadFileCSR("rocalution_test_stream.csr", row_begin, row_end);
+
+    ASSERT_EQ(C.GetNnz(), nnz);
+    ASSERT_EQ(D.GetM(), row_end - row_begin);
+    ASSERT_EQ(D.GetN(), nrow);
+
+    int* b_ptr = NULL;
+    int* b_col = NULL;
+    T*   b_val = NULL;
+    int* c_ptr = NULL;
+    int* c_col = NULL;
+    T*   c_val = NULL;
+    int* d_ptr = NULL;
+    int* d_col = NULL;
+    T*   d_val = NULL;
+
+    B.LeaveDataPtrCSR(&b_ptr, &b_col, &b_val);
+    C.LeaveDataPtrCSR(&c_ptr, &c_col, &c_val);
+    D.LeaveDataPtrCSR(&d_ptr, &d_col, &d_val);
+
+    for(int i = 0; i < nrow + 1; ++i)
+    {
+        ASSERT_EQ(c_ptr[i], b_ptr[i]);
+    }
+
+    for(int i = 0; i < nnz; ++i)
+    {
+        ASSERT_EQ(c_col[i], b_col[i]);
+        ASSERT_EQ(c_val[i], b_val[i]);
+    }
+
+    int offset = b_ptr[row_begin];
+
+    for(int i = 0; i < row_end - row_begin + 1; ++i)
+    {
+        ASSERT_EQ(d_ptr[i], b_ptr[row_begin + i] - offset);
+    }
+
+    for(int j = 0; j < d_ptr[row_end - row_begin]; ++j)
+    {
+        ASSERT_EQ(d_col[j], b_col[offset + j]);
+        ASSERT_EQ(d_val[j], b_val[offset + j]);
+    }
+
+    free_host(&b_ptr);
+    free_host(&b_col);
+    free_host(&b_val);
+    free_host(&c_ptr);
+    free_host(&c_col);
+    free_host(&c_val);
+    free_host(&d_ptr);
+    free_host(&d_col);
+    free_host(&d_val);
+
+    std::remove("rocalution_test_stream.csr");
+    std::remove("rocalution_test_stream_conv.csr");
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+static T* testing_map_zero_pages(size_t size)
+{
+    // Untouched anonymous pages read as zero and are never backed by memory
+    void* ptr = mmap(NULL,
+                     size * sizeof(T),
+                     PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                     -1,
+                     0);
+
+    return (ptr == MAP_FAILED) ? NULL : static_cast<T*>(ptr);
+}
+
+template <typename T>
+void testing_local_matrix_row_offset64(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Round trip of a small matrix through the 64 bit row offsets
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(10, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    IndexType2* ptr64 = NULL;
+    allocate_host(nrow + 1, &ptr64);
+
+    for(int i = 0; i < nrow + 1; ++i)
+    {
+        ptr64[i] = csr_ptr[i];
+    }
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&ptr64, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    ASSERT_EQ(ptr64, (IndexType2*)NULL);
+    ASSERT_EQ(A.GetNnz(), nnz);
+
+    A.LeaveDataPtrCSR(&ptr64, &csr_col, &csr_val);
+
+    for(int i = 0; i < nrow + 1; ++i)
+    {
+        ASSERT_EQ(ptr64[i], csr_ptr[i]);
+    }
+
+    delete[] csr_ptr;
+    free_host(&csr_col);
+    free_host(&csr_val);
+    free_host(&ptr64);
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_matrix_large_nnz(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // The first rows hold 2^31 explicit zeros, such that the entries of the
+    // remaining rows are located past INT_MAX
+    int        nzero = 2048;
+    int        ntail = 16;
+    int        n     = nzero + ntail;
+    IndexType2 row   = static_cast<IndexType2>(1) << 20;
+    IndexType2 nnz   = nzero * row + 2 * ntail;
+
+    ASSERT_GT(nnz, static_cast<IndexType2>(std::numeric_limits<int>::max()));
+
+    int* col     = testing_map_zero_pages<int>(nnz);
+    T*   val     = testing_map_zero_pages<T>(nnz);
+    int* coo_row = testing_map_zero_pages<int>(nnz);
+
+    if(col == NULL || val == NULL || coo_row == NULL)
+    {
+        munmap(col, nnz * sizeof(int));
+        munmap(val, nnz * sizeof(T));
+        munmap(coo_row, nnz * sizeof(int));
+
+        FAIL() << "cannot map " << nnz << " entries";
+    }
+
+    IndexType2* ptr = new IndexType2[n + 1];
+
+    for(int i = 0; i <= nzero; ++i)
+    {
+        ptr[i] = i * row;
+    }
+
+    // Tail row i couples with its own column and with column zero
+    for(int i = nzero; i < n; ++i)
+    {
+        IndexType2 j = ptr[i];
+
+        coo_row[j]     = i;
+        coo_row[j + 1] = i;
+        col[j]         = 0;
+        col[j + 1]     = i;
+        val[j]         = static_cast<T>(1);
+        val[j + 1]     = static_cast<T>(i - nzero + 1);
+
+        ptr[i + 1] = j + 2;
+    }
+
+    std::vector<T> hx(n);
+    std::vector<T> hy(n, static_cast<T>(0));
+
+    for(int i = 0; i < n; ++i)
+    {
+        hx[i] = static_cast<T>(i % 7 + 1);
+    }
+
+    for(int i = nzero; i < n; ++i)
+    {
+        hy[i] = hx[0] + static_cast<T>(i - nzero + 1) * hx[i];
+    }
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> z;
+
+    x.Allocate("x", n);
+    y.Allocate("y", n);
+    z.Allocate("z", n);
+
+    x.CopyFromData(hx.data());
+    y.CopyFromData(hy.data());
+
+    IndexType2* ptr_in = ptr;
+    int*        col_in = col;
+    T*          val_in = val;
+
+    // The matrices only borrow the mapped pages, everything is checked once the
+    // pointers are detached again, such that a failure never frees them
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&ptr, &col, &val, "A", nnz, n, n);
+
+    IndexType2 csr_nnz   = A.GetNnz();
+    bool       csr_check = A.Check();
+
+    // z = A x
+    A.Apply(x, &z);
+    z.ScaleAdd(-1.0, y);
+    T csr_apply = z.Norm();
+
+    // z = y + 2 A x
+    z.CopyFrom(y);
+    A.ApplyAdd(x, 2.0, &z);
+    z.AddScale(y, -3.0);
+    T csr_apply_add = z.Norm();
+
+    A.LeaveDataPtrCSR(&ptr, &col, &val);
+
+    IndexType2 csr_nnz_left = A.GetNnz();
+
+    // Same matrix in COO format
+    int* coo_row_in = coo_row;
+
+    LocalMatrix<T> B;
+    B.SetDataPtrCOO(&coo_row, &col, &val, "B", nnz, n, n);
+
+    IndexType2 coo_nnz = B.GetNnz();
+
+    B.Apply(x, &z);
+    z.ScaleAdd(-1.0, y);
+    T coo_apply = z.Norm();
+
+    B.LeaveDataPtrCOO(&coo_row, &col, &val);
+
+    IndexType2 ptr_nnz = ptr[n];
+
+    bool same_ptr = (ptr == ptr_in) && (col == col_in) && (val == val_in)
+                    && (coo_row == coo_row_in);
+
+    munmap(coo_row_in, nnz * sizeof(int));
+    munmap(col_in, nnz * sizeof(int));
+    munmap(val_in, nnz * sizeof(T));
+
+    delete[] ptr_in;
+
+    ASSERT_TRUE(same_ptr);
+    ASSERT_EQ(ptr_nnz, nnz);
+
+    ASSERT_EQ(csr_nnz, nnz);
+    ASSERT_TRUE(csr_check);
+    ASSERT_EQ(csr_apply, static_cast<T>(0));
+    ASSERT_EQ(csr_apply_add, static_cast<T>(0));
+    ASSERT_EQ(csr_nnz_left, 0);
+
+    ASSERT_EQ(coo_nnz, nnz);
+    ASSERT_EQ(coo_apply, static_cast<T>(0));
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_matrix_spmv(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Use several threads also for small sizes
+    set_omp_threads_rocalution(4);
+    set_omp_threshold_rocalution(0);
+
+    // Skewed matrix with dense and empty rows, such that rows cross the
+    // boundaries of the nnz balanced parts
+    int n = 1000;
+
+    std::vector<int> ptr(n + 1, 0);
+    std::vector<int> col;
+    std::vector<T>   val;
+
+    for(int i = 0; i < n; ++i)
+    {
+        if(i < 4 || i == n / 2)
+        {
+            for(int j = 0; j < n; ++j)
+            {
+                col.push_back(j);
+                val.push_back(static_cast<T>(1.0 / (j + 1)));
+            }
+        }
+        else if(i % 97 != 1)
+        {
+            int len = 1 + i % 13;
+
+            for(int j = 0; j < len; ++j)
+            {
+                col.push_back((i + j * 37) % n);
+                val.push_back(static_cast<T>(j + 1));
+            }
+
+            std::sort(col.end() - len, col.end());
+        }
+
+        ptr[i + 1] = static_cast<int>(col.size());
+    }
+
+    int nnz = ptr[n];
+
+    // Reference
+    std::vector<T> hx(n);
+    std::vector<T> hy(n);
+
+    for(int i = 0; i < n; ++i)
+    {
+        hx[i] = static_cast<T>((i % 17) - 8);
+    }
+
+    for(int i = 0; i < n; ++i)
+    {
+        hy[i] = static_cast<T>(0);
+
+        for(int j = ptr[i]; j < ptr[i + 1]; ++j)
+        {
+            hy[i] += val[j] * hx[col[j]];
+        }
+    }
+
+    LocalMatrix<T> A;
+    A.AllocateCSR("A", nnz, n, n);
+    A.CopyFromCSR(ptr.data(), col.data(), val.data());
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> z;
+
+    x.Allocate("x", n);
+    y.Allocate("y", n);
+    z.Allocate("z", n);
+
+    x.CopyFromData(hx.data());
+    y.CopyFromData(hy.data());
+
+    T tol = static_cast<T>(1e-5) * y.Norm();
+
+    unsigned int formats[] = {CSR, COO, HYB};
+
+    for(int f = 0; f < 3; ++f)
+    {
+        LocalMatrix<T> B;
+        B.CloneFrom(A);
+        B.ConvertTo(formats[f]);
+
+        // z = A x
+        B.Apply(x, &z);
+        z.ScaleAdd(-1.0, y);
+        ASSERT_LE(z.Norm(), tol);
+
+        // z = y + 2 A x
+        z.CopyFrom(y);
+        B.ApplyAdd(x, 2.0, &z);
+        z.AddScale(y, -3.0);
+        ASSERT_LE(z.Norm(), tol);
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_matrix_select_format(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    int n = 2000;
+
+    // Banded, uniform row length and skewed row length patterns, and the formats that
+    // are selected for them on the accelerator
+    unsigned int accel_formats[] = {DIA, ELL, HYB};
+
+    for(int m = 0; m < 3; ++m)
+    {
+        std::vector<int> ptr(n + 1, 0);
+        std::vector<int> col;
+        std::vector<T>   val;
+
+        for(int i = 0; i < n; ++i)
+        {
+            if(m == 0)
+            {
+                for(int j = std::max(i - 1, 0); j <= std::min(i + 1, n - 1); ++j)
+                {
+                    col.push_back(j);
+                }
+            }
+            else
+            {
+                // A few long rows in the skewed pattern
+                int len = (m == 2 && i % 100 == 0) ? 60 : (m == 1 ? 5 : 4);
+
+                for(int k = 0; k < len; ++k)
+                {
+                    col.push_back((len == 60) ? (i + 31 * k) % n : (7 * i + 401 * k) % n);
+                }
+
+                std::sort(col.end() - len, col.end());
+            }
+
+            while(val.size() < col.size())
+            {
+                val.push_back(static_cast<T>(val.size() % 5 + 1));
+            }
+
+            ptr[i + 1] = static_cast<int>(col.size());
+        }
+
+        int nnz = ptr[n];
+
+        LocalMatrix<T> A;
+        A.AllocateCSR("A", nnz, n, n);
+        A.CopyFromCSR(ptr.data(), col.data(), val.data());
+
+        // The host kernels perform best in CSR format
+        ASSERT_EQ(A.SelectFormat(false), static_cast<unsigned int>(CSR));
+        ASSERT_EQ(A.SelectFormat(true), accel_formats[m]);
+
+        // Same pattern, different values, the selection is taken from the cache
+        LocalMatrix<T> B;
+        B.CloneFrom(A);
+        B.Scale(2.0);
+
+        bool cached = false;
+
+        ASSERT_EQ(B.SelectFormat(true, &cached), accel_formats[m]);
+        ASSERT_TRUE(cached);
+
+        A.ConvertTo(AUTO);
+        ASSERT_EQ(A.GetFormat(), static_cast<unsigned int>(CSR));
+
+        // Timed trial runs, the confirmed selection replaces the analysis in the cache
+        B.ConvertToBest(true);
+
+        unsigned int format = B.GetFormat();
+
+        ASSERT_TRUE(format == CSR || format == DIA || format == ELL || format == HYB);
+        ASSERT_EQ(B.SelectFormat(false, &cached), format);
+        ASSERT_TRUE(cached);
+
+        LocalVector<T> x;
+        LocalVector<T> y;
+        LocalVector<T> z;
+
+        x.Allocate("x", n);
+        y.Allocate("y", n);
+        z.Allocate("z", n);
+
+        x.SetRandomUniform(12345ULL, -1.0, 1.0);
+
+        A.Apply(x, &y);
+        B.Apply(x, &z);
+        z.ScaleAdd(-0.5, y);
+        ASSERT_LE(z.Norm(), static_cast<T>(1e-4) * y.Norm());
+    }
+
+    // AUTO is a selector, not a storage format
+    unsigned int format;
+
+    ASSERT_TRUE(matrix_format_from_name("AUTO", format));
+    ASSERT_EQ(format, AUTO);
+    ASSERT_EQ(matrix_format_name(AUTO), "AUTO");
+    ASSERT_EQ(sizeof(_matrix_format_names) / sizeof(_matrix_format_names[0]), AUTO);
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_matrix_partition(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // 2D Laplacian with randomly shuffled rows and columns
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(40, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    std::vector<int> shuffle(nrow);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        shuffle[i] = i;
+    }
+
+    unsigned int seed = 12345;
+    for(int i = nrow - 1; i > 0; --i)
+    {
+        seed = seed * 1103515245 + 12345;
+        std::swap(shuffle[i], shuffle[(seed >> 8) % (i + 1)]);
+    }
+
+    LocalVector<int> perm;
+    perm.Allocate("perm", nrow);
+    perm.CopyFromData(shuffle.data());
+
+    A.Permute(perm);
+
+    std::vector<int> ptr(nrow + 1);
+    std::vector<int> col(nnz);
+    std::vector<T>   val(nnz);
+
+    A.CopyToCSR(ptr.data(), col.data(), val.data());
+
+    int nparts[] = {1, 2, 3, 4, 7};
+
+    for(int t = 0; t < 5; ++t)
+    {
+        LocalVector<int> part;
+        A.Partition(nparts[t], &part);
+
+        ASSERT_EQ(part.GetSize(), nrow);
+
+        std::vector<int> hpart(nrow);
+        part.CopyToData(hpart.data());
+
+        // All parts are (almost) equally sized
+        std::vector<int> size(nparts[t], 0);
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            ASSERT_GE(hpart[i], 0);
+            ASSERT_LT(hpart[i], nparts[t]);
+
+            ++size[hpart[i]];
+        }
+
+        for(int p = 0; p < nparts[t]; ++p)
+        {
+            ASSERT_LE(std::abs(size[p] - nrow / nparts[t]), nparts[t]);
+        }
+
+        // Entries coupling different parts, compared to contiguous blocks of rows
+        int cut       = 0;
+        int cut_block = 0;
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            for(int j = ptr[i]; j < ptr[i + 1]; ++j)
+            {
+                cut += (hpart[i] != hpart[col[j]]);
+                cut_block += (i * nparts[t] / nrow != col[j] * nparts[t] / nrow);
+            }
+        }
+
+        if(nparts[t] == 1)
+        {
+            ASSERT_EQ(cut, 0);
+        }
+        else
+        {
+            ASSERT_LT(4 * cut, cut_block);
+        }
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_matrix_ordering(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // 2D Laplacian with randomly shuffled rows and columns
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(40, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    std::vector<int> shuffle(nrow);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        shuffle[i] = i;
+    }
+
+    unsigned int seed = 12345;
+    for(int i = nrow - 1; i > 0; --i)
+    {
+        seed = seed * 1103515245 + 12345;
+        std::swap(shuffle[i], shuffle[(seed >> 8) % (i + 1)]);
+    }
+
+    LocalVector<int> perm;
+    perm.Allocate("perm", nrow);
+    perm.CopyFromData(shuffle.data());
+
+    A.Permute(perm);
+
+    // Bandwidth, entries coupling different blocks of 64 rows and number of fill-in
+    // entries of a complete Cholesky factorization of the (permuted) matrix
+    auto stats = [nrow, nnz](const LocalMatrix<T>& mat, int* bw, int* cut, int* fill) {
+        std::vector<int> ptr(nrow + 1);
+        std::vector<int> col(nnz);
+        std::vector<T>   val(nnz);
+
+        mat.CopyToCSR(ptr.data(), col.data(), val.data());
+
+        std::vector<int> parent(nrow);
+        std::vector<int> mark(nrow);
+
+        *bw   = 0;
+        *cut  = 0;
+        *fill = 0;
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            parent[i] = -1;
+            mark[i]   = i;
+
+            for(int j = ptr[i]; j < ptr[i + 1]; ++j)
+            {
+                *bw = std::max(*bw, std::abs(i - col[j]));
+                *cut += (i / 64 != col[j] / 64);
+
+                // Walk up the elimination tree, each visited node is an entry of row i of L
+                for(int k = col[j]; k < i && mark[k] != i; k = parent[k])
+                {
+                    if(parent[k] == -1)
+                    {
+                        parent[k] = i;
+                    }
+
+                    mark[k] = i;
+                    ++(*fill);
+                }
+            }
+        }
+    };
+
+    int bw_ref;
+    int cut_ref;
+    int fill_ref;
+
+    stats(A, &bw_ref, &cut_ref, &fill_ref);
+
+    int fill_rcmk = fill_ref;
+
+    for(int t = 0; t < 4; ++t)
+    {
+        LocalVector<int> order;
+
+        switch(t)
+        {
+        case 0:
+            A.CMK(&order);
+            break;
+        case 1:
+            A.RCMK(&order);
+            break;
+        case 2:
+            A.NestedDissection(&order);
+            break;
+        case 3:
+            A.LocalityOrder(64, &order);
+            break;
+        }
+
+        ASSERT_EQ(order.GetSize(), nrow);
+
+        // The ordering has to be a permutation
+        std::vector<int> horder(nrow);
+        std::vector<int> count(nrow, 0);
+
+        order.CopyToData(horder.data());
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            ASSERT_GE(horder[i], 0);
+            ASSERT_LT(horder[i], nrow);
+
+            ++count[horder[i]];
+        }
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            ASSERT_EQ(count[i], 1);
+        }
+
+        LocalMatrix<T> B;
+        B.CloneFrom(A);
+        B.Permute(order);
+
+        int bw;
+        int cut;
+        int fill;
+
+        stats(B, &bw, &cut, &fill);
+
+        if(t < 2)
+        {
+            // Cuthill-McKee orderings recover a band of about the grid dimension
+            ASSERT_LE(bw, 80);
+
+            fill_rcmk = fill;
+        }
+        else if(t == 2)
+        {
+            // Nested dissection produces less fill-in than the band orderings
+            ASSERT_LT(4 * fill, fill_ref);
+            ASSERT_LT(fill, fill_rcmk);
+        }
+        else
+        {
+            ASSERT_LT(4 * cut, cut_ref);
+        }
+    }
+
+    // 3D Laplacian (27 point stencil) with shuffled rows and columns, its breadth-first
+    // search levels hold more than 1024 rows and are processed in parallel
+    {
+        int* ptr27 = NULL;
+        int* col27 = NULL;
+        T*   val27 = NULL;
+
+        int n27   = gen_3d_laplacian(32, &ptr27, &col27, &val27, true);
+        int nnz27 = ptr27[n27];
+
+        LocalMatrix<T> C;
+        C.SetDataPtrCSR(&ptr27, &col27, &val27, "C", nnz27, n27, n27);
+
+        std::vector<int> shuffle27(n27);
+
+        for(int i = 0; i < n27; ++i)
+        {
+            shuffle27[i] = i;
+        }
+
+        for(int i = n27 - 1; i > 0; --i)
+        {
+            seed = seed * 1103515245 + 12345;
+            std::swap(shuffle27[i], shuffle27[(seed >> 8) % (i + 1)]);
+        }
+
+        perm.Allocate("perm", n27);
+        perm.CopyFromData(shuffle27.data());
+
+        C.Permute(perm);
+
+        // Use several threads also for small sizes
+        set_omp_threshold_rocalution(0);
+
+        std::vector<int> ref_cmk(n27);
+        std::vector<int> ref_nd(n27);
+
+        for(int t = 0; t < 2; ++t)
+        {
+            set_omp_threads_rocalution(t == 0 ? 1 : 4);
+
+            LocalVector<int> cmk;
+            LocalVector<int> nd;
+
+            C.CMK(&cmk);
+            C.NestedDissection(&nd);
+
+            std::vector<int> hcmk(n27);
+            std::vector<int> hnd(n27);
+
+            cmk.CopyToData(hcmk.data());
+            nd.CopyToData(hnd.data());
+
+            if(t == 0)
+            {
+                ref_cmk = hcmk;
+                ref_nd  = hnd;
+
+                // Bandwidth of the Cuthill-McKee ordering, bounded by two levels
+                LocalMatrix<T> D;
+                D.CloneFrom(C);
+                D.Permute(cmk);
+
+                std::vector<int> ptr(n27 + 1);
+                std::vector<int> col(nnz27);
+                std::vector<T>   val(nnz27);
+
+                D.CopyToCSR(ptr.data(), col.data(), val.data());
+
+                int bw = 0;
+
+                for(int i = 0; i < n27; ++i)
+                {
+                    for(int j = ptr[i]; j < ptr[i + 1]; ++j)
+                    {
+                        bw = std::max(bw, std::abs(i - col[j]));
+                    }
+                }
+
+                ASSERT_LE(bw, 2 * 3 * 32 * 32);
+            }
+            else
+            {
+                // The orderings do not depend on the number of threads
+                for(int i = 0; i < n27; ++i)
+                {
+                    ASSERT_EQ(hcmk[i], ref_cmk[i]);
+                    ASSERT_EQ(hnd[i], ref_nd[i]);
+                }
+            }
+        }
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_matrix_aggregation(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(50, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Use several threads also for small sizes
+    set_omp_threshold_rocalution(0);
+
+    std::vector<int> ref(nrow);
+
+    for(int t = 0; t < 2; ++t)
+    {
+        set_omp_threads_rocalution(t == 0 ? 1 : 4);
+
+        LocalVector<int> connections;
+        LocalVector<int> aggregates;
+
+        A.AMGConnect(static_cast<T>(0.08), &connections);
+        A.AMGAggregate(connections, &aggregates);
+
+        ASSERT_EQ(aggregates.GetSize(), nrow);
+
+        std::vector<int> agg(nrow);
+        aggregates.CopyToData(agg.data());
+
+        if(t == 0)
+        {
+            ref = agg;
+
+            // All points are aggregated, the aggregates are numbered consecutively
+            int nagg = *std::max_element(agg.begin(), agg.end()) + 1;
+
+            std::vector<int> size(nagg, 0);
+
+            for(int i = 0; i < nrow; ++i)
+            {
+                ASSERT_GE(agg[i], 0);
+                ++size[agg[i]];
+            }
+
+            for(int i = 0; i < nagg; ++i)
+            {
+                ASSERT_GT(size[i], 0);
+            }
+
+            // Aggregates of a 5-point stencil contain the root, its neighbours and some
+            // points in distance two
+            ASSERT_GE(nrow, 4 * nagg);
+            ASSERT_LE(nrow, 13 * nagg);
+        }
+        else
+        {
+            // The aggregation does not depend on the number of threads
+            for(int i = 0; i < nrow; ++i)
+            {
+                ASSERT_EQ(agg[i], ref[i]);
+            }
+        }
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_matrix_pairwise_aggregation(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(100, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Use several threads also for small sizes
+    set_omp_threshold_rocalution(0);
+
+    std::vector<int> ref(nrow);
+    int              ref_nc = 0;
+
+    for(int t = 0; t < 2; ++t)
+    {
+        set_omp_threads_rocalution(t == 0 ? 1 : 4);
+
+        LocalVector<int> G;
+        G.Allocate("G", nrow);
+
+        int  nc;
+        int  Gsize;
+        int  rGsize;
+        int* rG = NULL;
+
+        // Two passes of pairwise aggregation
+        LocalMatrix<T> Ac;
+
+        A.InitialPairwiseAggregation(static_cast<T>(0.25), nc, &G, Gsize, &rG, rGsize, 0);
+        A.CoarsenOperator(&Ac, nc, nc, G, Gsize, rG, rGsize);
+        Ac.FurtherPairwiseAggregation(static_cast<T>(0.25), nc, &G, Gsize, &rG, rGsize, 0);
+
+        ASSERT_EQ(Gsize, 4);
+
+        std::vector<int> agg(nrow);
+        G.CopyToData(agg.data());
+
+        if(t == 0)
+        {
+            ref    = agg;
+            ref_nc = nc;
+
+            // Each aggregate holds up to four points, which are listed in rG
+            std::vector<int> size(nc, 0);
+
+            for(int i = 0; i < nrow; ++i)
+            {
+                ASSERT_GE(agg[i], 0);
+                ASSERT_LT(agg[i], nc);
+                ++size[agg[i]];
+            }
+
+            for(int c = 0; c < nc; ++c)
+            {
+                int count = 0;
+
+                for(int r = 0; r < Gsize; ++r)
+                {
+                    int i = rG[r * rGsize + c];
+
+                    if(i >= 0)
+                    {
+                        ASSERT_EQ(agg[i], c);
+                        ++count;
+                    }
+                }
+
+                ASSERT_GT(size[c], 0);
+                ASSERT_EQ(size[c], count);
+            }
+
+            // Almost all points are matched in both passes
+            ASSERT_LE(nc, nrow / 3);
+        }
+        else
+        {
+            // The aggregation does not depend on the number of threads
+            ASSERT_EQ(nc, ref_nc);
+
+            for(int i = 0; i < nrow; ++i)
+            {
+                ASSERT_EQ(agg[i], ref[i]);
+            }
+        }
+
+        delete[] rG;
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_matrix_matrix_powers(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Large enough to be split into several cache blocks
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(400, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    const int k = 4;
+
+    T alpha[] = {0.25, 0.5, 0.25, 0.125};
+    T beta[]  = {-1.0, 0.5, -2.0, 1.0};
+    T gamma[] = {0.0, -1.0, 0.5, -0.25};
+
+    LocalVector<T>  ref[k + 1];
+    LocalVector<T>  v[k + 1];
+    LocalVector<T>* pv[k + 1];
+
+    for(int j = 0; j <= k; ++j)
+    {
+        ref[j].Allocate("ref", nrow);
+        v[j].Allocate("v", nrow);
+        pv[j] = &v[j];
+    }
+
+    ref[0].SetRandomUniform(1234ULL, -1.0, 1.0);
+    v[0].CopyFrom(ref[0]);
+
+    // Reference, one SpMV per basis vector
+    for(int j = 0; j < k; ++j)
+    {
+        A.Apply(ref[j], &ref[j + 1]);
+
+        if(j > 0)
+        {
+            ref[j + 1].ScaleAdd2(alpha[j], ref[j], beta[j], ref[j - 1], gamma[j]);
+        }
+        else
+        {
+            ref[j + 1].ScaleAddScale(alpha[j], ref[j], beta[j]);
+        }
+    }
+
+    for(int t = 0; t < 2; ++t)
+    {
+        set_omp_threads_rocalution(t == 0 ? 1 : 4);
+
+        // Shorter sequences reuse the blocking of the longer one
+        for(int m = k; m > 0; m -= 2)
+        {
+            for(int j = 1; j <= k; ++j)
+            {
+                v[j].Zeros();
+            }
+
+            A.MatrixPowers(m, alpha, beta, gamma, pv);
+
+            for(int j = 1; j <= m; ++j)
+            {
+                v[j].ScaleAdd(-1.0, ref[j]);
+                ASSERT_LE(v[j].Norm(), static_cast<T>(1e-5) * ref[j].Norm());
+            }
+        }
+    }
+
+    // Other formats use a sequence of SpMVs
+    A.ConvertToCOO();
+    A.MatrixPowers(k, alpha, beta, gamma, pv);
+
+    v[k].ScaleAdd(-1.0, ref[k]);
+    ASSERT_LE(v[k].Norm(), static_cast<T>(1e-5) * ref[k].Norm());
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_matrix_matrix_polynomial(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Large enough to be split into several cache blocks
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(400, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    const int k = 4;
+
+    T alpha[]  = {0.25, 0.5, 0.25, 0.125};
+    T beta[]   = {-1.0, 0.5, -2.0, 1.0};
+    T gamma[]  = {0.0, -1.0, 0.5, -0.25};
+    T weight[] = {0.5, -1.0, 2.0, 0.25, -0.5};
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> ref;
+    LocalVector<T> scale;
+    LocalVector<T> v[k + 1];
+
+    x.Allocate("x", nrow);
+    y.Allocate("y", nrow);
+    ref.Allocate("ref", nrow);
+    scale.Allocate("scale", nrow);
+
+    for(int j = 0; j <= k; ++j)
+    {
+        v[j].Allocate("v", nrow);
+    }
+
+    x.SetRandomUniform(1234ULL, -1.0, 1.0);
+    scale.SetRandomUniform(4321ULL, 0.5, 1.5);
+
+    for(int s = 0; s < 2; ++s)
+    {
+        LocalVector<T>* S = (s == 0) ? NULL : &scale;
+
+        // Reference, one SpMV per basis vector
+        v[0].CopyFrom(x);
+        ref.CopyFrom(x);
+        ref.Scale(weight[0]);
+
+        for(int j = 0; j < k; ++j)
+        {
+            A.Apply(v[j], &v[j + 1]);
+
+            if(S != NULL)
+            {
+                v[j + 1].PointWiseMult(*S);
+            }
+
+            if(j > 0)
+            {
+                v[j + 1].ScaleAdd2(alpha[j], v[j], beta[j], v[j - 1], gamma[j]);
+            }
+            else
+            {
+                v[j + 1].ScaleAddScale(alpha[j], v[j], beta[j]);
+            }
+
+            ref.AddScale(v[j + 1], weight[j + 1]);
+        }
+
+        for(int t = 0; t < 2; ++t)
+        {
+            set_omp_threads_rocalution(t == 0 ? 1 : 4);
+
+            y.Zeros();
+            A.MatrixPolynomial(k, alpha, beta, gamma, weight, S, x, &y);
+
+            y.ScaleAdd(-1.0, ref);
+            ASSERT_LE(y.Norm(), static_cast<T>(1e-5) * ref.Norm());
+        }
+
+        // Other formats use a sequence of SpMVs
+        A.ConvertToCOO();
+        A.MatrixPolynomial(k, alpha, beta, gamma, weight, S, x, &y);
+        A.ConvertToCSR();
+
+        y.ScaleAdd(-1.0, ref);
+        ASSERT_LE(y.Norm(), static_cast<T>(1e-5) * ref.Norm());
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_matrix_schur_complement(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Large enough to be split into several blocks, the lower triangular part has a
+    // non-symmetric pattern
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(200, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> L;
+    L.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "L", nnz, nrow, nrow);
+
+    LocalMatrix<T> A;
+    L.ExtractL(&A, true);
+    L.Clear();
+
+    // The independent set does not depend on the number of threads
+    LocalVector<int> perm[2];
+    int              size[2];
+
+    for(int t = 0; t < 2; ++t)
+    {
+        set_omp_threads_rocalution(t == 0 ? 1 : 4);
+        A.MaximalIndependentSet(size[t], &perm[t]);
+    }
+
+    ASSERT_EQ(size[0], size[1]);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        ASSERT_EQ(perm[0][i], perm[1][i]);
+    }
+
+    A.Permute(perm[0]);
+
+    // The block of the independent set is diagonal
+    LocalMatrix<T> D;
+    A.ExtractSubMatrix(0, 0, size[0], size[0], &D);
+    ASSERT_EQ(D.GetNnz(), size[0]);
+
+    int nrow_S = nrow - size[0];
+
+    LocalVector<T> inv_diag[2];
+    LocalMatrix<T> E[2];
+    LocalMatrix<T> F[2];
+    LocalMatrix<T> S[2];
+
+    A.SchurComplement(size[0], &inv_diag[0], &E[0], &F[0], &S[0]);
+
+    // Other formats extract the blocks and multiply them
+    A.ConvertToCOO();
+    A.SchurComplement(size[0], &inv_diag[1], &E[1], &F[1], &S[1]);
+
+    ASSERT_EQ(S[0].GetM(), nrow_S);
+    ASSERT_EQ(S[0].GetN(), nrow_S);
+
+    // Compare the blocks by their action on random vectors
+    LocalVector<T> x_S;
+    LocalVector<T> x_D;
+    LocalVector<T> y_S[2];
+    LocalVector<T> y_E[2];
+    LocalVector<T> y_F[2];
+
+    x_S.Allocate("x_S", nrow_S);
+    x_D.Allocate("x_D", size[0]);
+
+    x_S.SetRandomUniform(1234ULL, -1.0, 1.0);
+    x_D.SetRandomUniform(4321ULL, -1.0, 1.0);
+
+    for(int i = 0; i < 2; ++i)
+    {
+        y_S[i].Allocate("y_S", nrow_S);
+        y_E[i].Allocate("y_E", nrow_S);
+        y_F[i].Allocate("y_F", size[0]);
+
+        S[i].Apply(x_S, &y_S[i]);
+        E[i].Apply(x_D, &y_E[i]);
+        F[i].Apply(x_S, &y_F[i]);
+    }
+
+    y_S[1].ScaleAdd(-1.0, y_S[0]);
+    y_E[1].ScaleAdd(-1.0, y_E[0]);
+    y_F[1].ScaleAdd(-1.0, y_F[0]);
+    inv_diag[1].ScaleAdd(-1.0, inv_diag[0]);
+
+    ASSERT_LE(y_S[1].Norm(), static_cast<T>(1e-5) * y_S[0].Norm());
+    ASSERT_LE(y_E[1].Norm(), static_cast<T>(1e-5) * y_E[0].Norm());
+    ASSERT_LE(y_F[1].Norm(), static_cast<T>(1e-5) * y_F[0].Norm());
+    ASSERT_LE(inv_diag[1].Norm(), static_cast<T>(1e-5) * inv_diag[0].Norm());
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_matrix_symbolic_ilup(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Non-symmetric pattern, such that the order of the interior nodes of fill paths
+    // matters
+    int n = 400;
+
+    std::vector<T>   dense(n * n, static_cast<T>(0));
+    std::vector<int> level(n * n, n);
+
+    for(int i = 0; i < n; ++i)
+    {
+        int c[] = {i, (7 * i + 3) % n, (13 * i + 5) % n, std::min(i + 1, n - 1)};
+
+        for(int k = 0; k < 4; ++k)
+        {
+            dense[i * n + c[k]] = (c[k] == i) ? static_cast<T>(10) : static_cast<T>(-1 - k);
+            level[i * n + c[k]] = 0;
+        }
+    }
+
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nnz = 0;
+
+    for(int i = 0; i < n * n; ++i)
+    {
+        nnz += (level[i] == 0);
+    }
+
+    allocate_host(n + 1, &csr_ptr);
+    allocate_host(nnz, &csr_col);
+    allocate_host(nnz, &csr_val);
+
+    csr_ptr[0] = 0;
+
+    for(int i = 0, k = 0; i < n; ++i)
+    {
+        for(int j = 0; j < n; ++j)
+        {
+            if(level[i * n + j] == 0)
+            {
+                csr_col[k]   = j;
+                csr_val[k++] = dense[i * n + j];
+            }
+        }
+
+        csr_ptr[i + 1] = k;
+    }
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, n, n);
+
+    // Use several threads also for small sizes
+    set_omp_threshold_rocalution(0);
+
+    for(int p = 1; p <= 3; ++p)
+    {
+        // Reference, dense ILU(p) with levels of fill
+        std::vector<T>   ref(dense);
+        std::vector<int> lev(level);
+
+        for(int i = 1; i < n; ++i)
+        {
+            for(int k = 0; k < i; ++k)
+            {
+                if(lev[i * n + k] > p)
+                {
+                    continue;
+                }
+
+                ref[i * n + k] /= ref[k * n + k];
+
+                for(int j = k + 1; j < n; ++j)
+                {
+                    if(lev[k * n + j] <= p)
+                    {
+                        lev[i * n + j]
+                            = std::min(lev[i * n + j], lev[i * n + k] + lev[k * n + j] + 1);
+                        ref[i * n + j] -= ref[i * n + k] * ref[k * n + j];
+                    }
+                }
+            }
+
+            for(int j = 0; j < n; ++j)
+            {
+                if(lev[i * n + j] > p)
+                {
+                    ref[i * n + j] = static_cast<T>(0);
+                }
+            }
+        }
+
+        int ref_nnz = 0;
+
+        for(int i = 0; i < n * n; ++i)
+        {
+            ref_nnz += (lev[i] <= p);
+        }
+
+        // The pattern does not depend on the number of threads
+        for(int t = 0; t < 2; ++t)
+        {
+            set_omp_threads_rocalution(t == 0 ? 1 : 4);
+
+            LocalMatrix<T> LU;
+            LU.CloneFrom(A);
+            LU.ILUpFactorize(p, true);
+
+            ASSERT_EQ(LU.GetNnz(), ref_nnz);
+
+            int* ptr = NULL;
+            int* col = NULL;
+            T*   val = NULL;
+
+            LU.LeaveDataPtrCSR(&ptr, &col, &val);
+
+            for(int i = 0; i < n; ++i)
+            {
+                for(int j = ptr[i]; j < ptr[i + 1]; ++j)
+                {
+                    ASSERT_LE(lev[i * n + col[j]], p);
+                    ASSERT_NEAR(val[j], ref[i * n + col[j]], 1e-4);
+                }
+            }
+
+            free_host(&ptr);
+            free_host(&col);
+            free_host(&val);
+        }
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_matrix_sor_sweep(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Non-symmetric pattern, the colors have to take both directions into account
+    int n = 400;
+
+    std::vector<int> ptr(n + 1, 0);
+    std::vector<int> col;
+    std::vector<T>   val;
+
+    for(int i = 0; i < n; ++i)
+    {
+        std::vector<int> c = {i, (7 * i + 3) % n, (13 * i + 5) % n, std::min(i + 1, n - 1)};
+
+        std::sort(c.begin(), c.end());
+        c.erase(std::unique(c.begin(), c.end()), c.end());
+
+        for(size_t k = 0; k < c.size(); ++k)
+        {
+            col.push_back(c[k]);
+            val.push_back((c[k] == i) ? static_cast<T>(10) : static_cast<T>(-1 - (int)k));
+        }
+
+        ptr[i + 1] = col.size();
+    }
+
+    int nnz = ptr[n];
+
+    LocalMatrix<T> A;
+    A.AllocateCSR("A", nnz, n, n);
+    A.CopyFromCSR(ptr.data(), col.data(), val.data());
+
+    // Colors of the rows
+    int              num_colors  = 0;
+    int*             size_colors = NULL;
+    LocalVector<int> perm;
+
+    A.MultiColoring(num_colors, &size_colors, &perm);
+
+    std::vector<int> color_perm(n);
+    std::vector<int> rows(n);
+    std::vector<int> offset(num_colors + 1, 0);
+
+    perm.CopyToData(color_perm.data());
+
+    for(int i = 0; i < n; ++i)
+    {
+        rows[color_perm[i]] = i;
+    }
+
+    for(int c = 0; c < num_colors; ++c)
+    {
+        offset[c + 1] = offset[c] + size_colors[c];
+    }
+
+    free_host(&size_colors);
+
+    // Rows of the same color do not couple
+    std::vector<int> color(n);
+
+    for(int c = 0; c < num_colors; ++c)
+    {
+        for(int k = offset[c]; k < offset[c + 1]; ++k)
+        {
+            color[rows[k]] = c;
+        }
+    }
+
+    for(int i = 0; i < n; ++i)
+    {
+        for(int j = ptr[i]; j < ptr[i + 1]; ++j)
+        {
+            if(col[j] != i)
+            {
+                ASSERT_NE(color[i], color[col[j]]);
+            }
+        }
+    }
+
+    LocalVector<int> color_rows;
+    color_rows.Allocate("color rows", n);
+    color_rows.CopyFromData(rows.data());
+
+    std::vector<T> b(n);
+
+    for(int i = 0; i < n; ++i)
+    {
+        b[i] = static_cast<T>(i % 7) - static_cast<T>(3);
+    }
+
+    LocalVector<T> rhs;
+    rhs.Allocate("rhs", n);
+    rhs.CopyFromData(b.data());
+
+    T omega = static_cast<T>(1.2);
+
+    for(int sym = 0; sym < 2; ++sym)
+    {
+        // Reference, sequential sweeps over the colors
+        std::vector<T> ref(n, static_cast<T>(0));
+
+        for(int s = 0; s < 2; ++s)
+        {
+            for(int dir = 0; dir <= sym; ++dir)
+            {
+                for(int c = 0; c < num_colors; ++c)
+                {
+                    int cc = (dir == 0) ? c : num_colors - 1 - c;
+
+                    for(int k = offset[cc]; k < offset[cc + 1]; ++k)
+                    {
+                        int i    = rows[k];
+                        T   res  = b[i];
+                        T   diag = static_cast<T>(0);
+
+                        for(int j = ptr[i]; j < ptr[i + 1]; ++j)
+                        {
+                            res -= val[j] * ref[col[j]];
+                            diag = (col[j] == i) ? val[j] : diag;
+                        }
+
+                        ref[i] += omega * res / diag;
+                    }
+                }
+            }
+        }
+
+        // The result does not depend on the number of threads
+        for(int t = 0; t < 2; ++t)
+        {
+            set_omp_threads_rocalution(t == 0 ? 1 : 4);
+
+            // The initial guess is not read
+            LocalVector<T> x;
+            x.Allocate("x", n);
+            x.Ones();
+
+            A.SORSweep(num_colors,
+                       offset.data(),
+                       color_rows,
+                       omega,
+                       sym == 1,
+                       true,
+                       2,
+                       rhs,
+                       &x);
+
+            std::vector<T> res(n);
+            x.CopyToData(res.data());
+
+            for(int i = 0; i < n; ++i)
+            {
+                ASSERT_NEAR(res[i], ref[i], 1e-4);
+            }
+        }
+    }
+
+    set_omp_threads_rocalution(1);
+
+    // Multi-colored SOR sweeps on a host CSR copy of operators in other formats, which is
+    // refreshed by ReBuildNumeric()
+    LocalMatrix<T> B;
+    B.CloneFrom(A);
+    B.ConvertToELL();
+
+    MultiColoredSOR<LocalMatrix<T>, LocalVector<T>, T> sor_csr;
+    MultiColoredSOR<LocalMatrix<T>, LocalVector<T>, T> sor_ell;
+
+    sor_csr.SetOperator(A);
+    sor_ell.SetOperator(B);
+
+    LocalVector<T> x_csr;
+    LocalVector<T> x_ell;
+    LocalVector<T> x_ref;
+
+    x_csr.Allocate("x csr", n);
+    x_ell.Allocate("x ell", n);
+    x_ref.Allocate("x ref", n);
+
+    for(int k = 0; k < 2; ++k)
+    {
+        MultiColoredSOR<LocalMatrix<T>, LocalVector<T>, T>* sor = (k == 0) ? &sor_csr : &sor_ell;
+
+        sor->SetRelaxation(omega);
+        sor->SetSymmetric(true);
+        sor->SetFixedSweeps(true);
+        sor->Init(0.0, 0.0, 1e+8, 2);
+        sor->Verbose(0);
+        sor->Build();
+    }
+
+    sor_csr.SolveZeroSol(rhs, &x_ref);
+    sor_ell.SolveZeroSol(rhs, &x_ell);
+
+    x_ell.ScaleAdd(-1.0, x_ref);
+    ASSERT_LE(x_ell.Norm(), static_cast<T>(1e-5) * x_ref.Norm());
+
+    // Scaling the operator scales the iterates of a zero initial guess inversely
+    A.Scale(2.0);
+    B.Scale(2.0);
+
+    sor_csr.ReBuildNumeric();
+    sor_ell.ReBuildNumeric();
+
+    sor_csr.SolveZeroSol(rhs, &x_csr);
+    sor_ell.SolveZeroSol(rhs, &x_ell);
+
+    x_csr.ScaleAdd(-2.0, x_ref);
+    x_ell.ScaleAdd(-2.0, x_ref);
+    ASSERT_LE(x_csr.Norm(), static_cast<T>(1e-5) * x_ref.Norm());
+    ASSERT_LE(x_ell.Norm(), static_cast<T>(1e-5) * x_ref.Norm());
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
 #endif // TESTING_LOCAL_MATRIX_HPP
@@ -0,0 +1,222 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_LOCAL_MATRIX_FREE_HPP
+#define TESTING_LOCAL_MATRIX_FREE_HPP
+
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+#include <rocalution.hpp>
+
+using namespace rocalution;
+
+template <typename T>
+void testing_local_matrix_free_bad_args(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    LocalMatrixFree<T> op;
+    LocalVector<T>     vec;
+
+    // Apply
+    {
+        LocalVector<T>* null_vec = nullptr;
+        ASSERT_DEATH(op.Apply(vec, null_vec), ".*Assertion.*out != (NULL|__null)*");
+    }
+
+    // ApplyAdd
+    {
+        LocalVector<T>* null_vec = nullptr;
+        ASSERT_DEATH(op.ApplyAdd(vec, 1.0, null_vec), ".*Assertion.*out != (NULL|__null)*");
+    }
+
+    // ExtractDiagonal, ExtractInverseDiagonal
+    {
+        LocalVector<T>* null_vec = nullptr;
+        ASSERT_DEATH(op.ExtractDiagonal(null_vec), ".*Assertion.*vec_diag != (NULL|__null)*");
+        ASSERT_DEATH(op.ExtractInverseDiagonal(null_vec),
+                     ".*Assertion.*vec_inv_diag != (NULL|__null)*");
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_matrix_free_solve(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    int ndim = 32;
+
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    // Assembled reference
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Matrix-free 2D Laplacian
+    LocalMatrixFree<T> op;
+    op.Allocate("Laplace2D", nrow, nrow);
+    op.SetApplyFunction([ndim](const LocalVector<T>& in, LocalVector<T>* out) {
+        for(int i = 0; i < ndim; ++i)
+        {
+            for(int j = 0; j < ndim; ++j)
+            {
+                int idx = i * ndim + j;
+                T   sum = static_cast<T>(4) * in[idx];
+
+                if(i > 0)
+                {
+                    sum -= in[idx - ndim];
+                }
+                if(i < ndim - 1)
+                {
+                    sum -= in[idx + ndim];
+                }
+                if(j > 0)
+                {
+                    sum -= in[idx - 1];
+                }
+                if(j < ndim - 1)
+                {
+                    sum -= in[idx + 1];
+                }
+
+                (*out)[idx] = sum;
+            }
+        }
+    });
+
+    LocalVector<T> diag;
+    A.ExtractDiagonal(&diag);
+    op.SetDiagonal(diag);
+
+    LocalVector<T> b;
+    LocalVector<T> x;
+    LocalVector<T> e;
+
+    b.Allocate("b", nrow);
+    x.Allocate("x", nrow);
+    e.Allocate("e", nrow);
+
+    b.SetRandomUniform(12345ULL, -1.0, 1.0);
+
+    // ApplyAdd without ApplyAdd function
+    e.Ones();
+    x.Ones();
+    op.ApplyAdd(b, static_cast<T>(-2), &x);
+    A.ApplyAdd(b, static_cast<T>(2), &x);
+    x.ScaleAdd(static_cast<T>(-1), e);
+
+    ASSERT_LT(x.Norm(), 1e2 * std::numeric_limits<T>::epsilon() * nrow);
+
+    for(int t = 0; t < 4; ++t)
+    {
+        IterativeLinearSolver<LocalMatrixFree<T>, LocalVector<T>, T>* ls_free = NULL;
+        IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>*     ls      = NULL;
+
+        Jacobi<LocalMatrixFree<T>, LocalVector<T>, T> p_free;
+        Jacobi<LocalMatrix<T>, LocalVector<T>, T>     p;
+
+        switch(t)
+        {
+        case 0:
+            ls_free = new CG<LocalMatrixFree<T>, LocalVector<T>, T>;
+            ls      = new CG<LocalMatrix<T>, LocalVector<T>, T>;
+            break;
+        case 1:
+            ls_free = new GMRES<LocalMatrixFree<T>, LocalVector<T>, T>;
+            ls      = new GMRES<LocalMatrix<T>, LocalVector<T>, T>;
+            break;
+        case 2:
+            ls_free = new BiCGStab<LocalMatrixFree<T>, LocalVector<T>, T>;
+            ls      = new BiCGStab<LocalMatrix<T>, LocalVector<T>, T>;
+            break;
+        case 3:
+        {
+            // Spectrum of the Jacobi preconditioned 2D Laplacian
+            T lambda_min = static_cast<T>(1.0 - cos(M_PI / (ndim + 1)));
+            T lambda_max = static_cast<T>(2.0) - lambda_min;
+
+            Chebyshev<LocalMatrixFree<T>, LocalVector<T>, T>* cheb_free
+                = new Chebyshev<LocalMatrixFree<T>, LocalVector<T>, T>;
+            Chebyshev<LocalMatrix<T>, LocalVector<T>, T>* cheb
+                = new Chebyshev<LocalMatrix<T>, LocalVector<T>, T>;
+
+            cheb_free->Set(lambda_min, lambda_max);
+            cheb->Set(lambda_min, lambda_max);
+
+            ls_free = cheb_free;
+            ls      = cheb;
+            break;
+        }
+        }
+
+        ls_free->SetOperator(op);
+        ls_free->SetPreconditioner(p_free);
+        ls_free->Verbose(0);
+        ls_free->Build();
+
+        ls->SetOperator(A);
+        ls->SetPreconditioner(p);
+        ls->Verbose(0);
+        ls->Build();
+
+        ls_free->Init(0.0, 1e-5, 1e+8, 2000);
+        ls->Init(0.0, 1e-5, 1e+8, 2000);
+
+        x.Zeros();
+        e.Zeros();
+
+        ls_free->Solve(b, &x);
+        ls->Solve(b, &e);
+
+        // Both operators have to give the same solution
+        ASSERT_EQ(ls_free->GetSolverStatus(), 2);
+        ASSERT_EQ(ls->GetSolverStatus(), 2);
+
+        x.ScaleAdd(static_cast<T>(-1), e);
+
+        ASSERT_LT(x.Norm(), 1e-2 * e.Norm());
+
+        delete ls_free;
+        delete ls;
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+#endif // TESTING_LOCAL_MATRIX_FREE_HPP
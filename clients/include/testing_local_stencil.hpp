@@ -28,7 +28,9 @@
 #include "utility.hpp"
 
 #include <gtest/gtest.h>
+#include <limits>
 #include <rocalution.hpp>
+#include <vector>
 
 using namespace rocalution;
 
@@ -54,6 +56,359 @@ void testing_local_stencil_bad_args(void)
         ASSERT_DEATH(stn.ApplyAdd(vec, 1.0, null_vec), ".*Assertion.*out != (NULL|__null)*");
     }
 
+    // ApplyPower
+    {
+        LocalVector<T>* null_vec = nullptr;
+        ASSERT_DEATH(stn.ApplyPower(vec, 2, null_vec), ".*Assertion.*out != (NULL|__null)*");
+        ASSERT_DEATH(stn.ApplyPower(vec, -1, &vec), ".*Assertion.*power >= 0*");
+    }
+
+    // SetStencil
+    {
+        int  offset[2] = {0, 1};
+        T    coef[2]   = {2.0, -1.0};
+        int* null_int  = nullptr;
+        T*   null_data = nullptr;
+        ASSERT_DEATH(stn.SetStencil(4, 2, offset, coef), ".*Assertion.*ndim >= 1 && ndim <= 3*");
+        ASSERT_DEATH(stn.SetStencil(1, 0, offset, coef), ".*Assertion.*nnz > 0*");
+        ASSERT_DEATH(stn.SetStencil(1, 2, null_int, coef),
+                     ".*Assertion.*offset != (NULL|__null)*");
+        ASSERT_DEATH(stn.SetStencil(1, 2, offset, null_data),
+                     ".*Assertion.*coef != (NULL|__null)*");
+    }
+
+    // SetVariableCoefficients
+    {
+        T* null_data = nullptr;
+        ASSERT_DEATH(stn.SetVariableCoefficients(null_data),
+                     ".*Assertion.*coef != (NULL|__null)*");
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+// Assemble the CSR matrix of a stencil on a nx x ny x nz grid, entry k couples point
+// (x, y, z) to (x + offset[3 * k], y + offset[3 * k + 1], z + offset[3 * k + 2])
+template <typename T>
+void stencil_to_csr(const int*        dim,
+                    int               nnz,
+                    const int*        offset,
+                    const T*          coef,
+                    const T*          var_coef,
+                    std::vector<int>& ptr,
+                    std::vector<int>& col,
+                    std::vector<T>&   val)
+{
+    int n = dim[0] * dim[1] * dim[2];
+
+    ptr.assign(1, 0);
+    col.clear();
+    val.clear();
+
+    for(int z = 0; z < dim[2]; ++z)
+    {
+        for(int y = 0; y < dim[1]; ++y)
+        {
+            for(int x = 0; x < dim[0]; ++x)
+            {
+                int row = (z * dim[1] + y) * dim[0] + x;
+
+                std::vector<std::pair<int, T>> entries;
+
+                for(int k = 0; k < nnz; ++k)
+                {
+                    int xx = x + offset[3 * k];
+                    int yy = y + offset[3 * k + 1];
+                    int zz = z + offset[3 * k + 2];
+
+                    if(xx < 0 || yy < 0 || zz < 0 || xx >= dim[0] || yy >= dim[1]
+                       || zz >= dim[2])
+                    {
+                        continue;
+                    }
+
+                    T c = (var_coef != NULL) ? var_coef[k * n + row] : coef[k];
+
+                    entries.push_back(std::make_pair((zz * dim[1] + yy) * dim[0] + xx, c));
+                }
+
+                std::sort(entries.begin(),
+                          entries.end(),
+                          [](const std::pair<int, T>& a, const std::pair<int, T>& b) {
+                              return a.first < b.first;
+                          });
+
+                for(size_t j = 0; j < entries.size(); ++j)
+                {
+                    col.push_back(entries[j].first);
+                    val.push_back(entries[j].second);
+                }
+
+                ptr.push_back(static_cast<int>(col.size()));
+            }
+        }
+    }
+}
+
+// Compare Apply, ApplyAdd and ApplyPower of a stencil to its assembled matrix
+template <typename T>
+void check_stencil(const LocalStencil<T>& stn, const LocalMatrix<T>& A)
+{
+    int n = A.GetM();
+
+    ASSERT_EQ(stn.GetM(), n);
+    ASSERT_EQ(stn.GetN(), n);
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> z;
+    LocalVector<T> tmp;
+
+    x.Allocate("x", n);
+    y.Allocate("y", n);
+    z.Allocate("z", n);
+    tmp.Allocate("tmp", n);
+
+    x.SetRandomUniform(12345ULL, static_cast<T>(-1), static_cast<T>(1));
+
+    double tol = std::numeric_limits<T>::epsilon() * 100.0;
+
+    // Apply
+    stn.Apply(x, &y);
+    A.Apply(x, &z);
+
+    double nrm = z.Norm();
+    z.ScaleAdd(static_cast<T>(-1), y);
+    ASSERT_LE(z.Norm(), tol * nrm);
+
+    // ApplyAdd
+    y.Ones();
+    z.Ones();
+    stn.ApplyAdd(x, static_cast<T>(-0.5), &y);
+    A.ApplyAdd(x, static_cast<T>(-0.5), &z);
+
+    nrm = z.Norm();
+    z.ScaleAdd(static_cast<T>(-1), y);
+    ASSERT_LE(z.Norm(), tol * nrm);
+
+    // ApplyPower
+    for(int power = 0; power <= 3; ++power)
+    {
+        stn.ApplyPower(x, power, &y);
+
+        z.CopyFrom(x);
+        for(int i = 0; i < power; ++i)
+        {
+            tmp.CopyFrom(z);
+            A.Apply(tmp, &z);
+        }
+
+        nrm = z.Norm();
+        z.ScaleAdd(static_cast<T>(-1), y);
+        ASSERT_LE(z.Norm(), tol * nrm);
+    }
+}
+
+template <typename T>
+void testing_local_stencil(unsigned int type)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    bool is_3d = (type == Laplace3D || type == Laplace3D27);
+    int  ndim  = is_3d ? 17 : 70;
+
+    // Assembled matrix of the stencil
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow;
+
+    if(type == Laplace2D)
+    {
+        nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    }
+    else if(type == Laplace2D9)
+    {
+        // 2D 9-point stencil
+        int dim[3] = {ndim, ndim, 1};
+
+        std::vector<int> offset;
+        std::vector<T>   coef;
+
+        for(int dy = -1; dy <= 1; ++dy)
+        {
+            for(int dx = -1; dx <= 1; ++dx)
+            {
+                offset.push_back(dx);
+                offset.push_back(dy);
+                offset.push_back(0);
+                coef.push_back(static_cast<T>((dx == 0 && dy == 0) ? 8 : -1));
+            }
+        }
+
+        std::vector<int> ptr;
+        std::vector<int> col;
+        std::vector<T>   val;
+
+        stencil_to_csr(dim, 9, offset.data(), coef.data(), (T*)NULL, ptr, col, val);
+
+        nrow    = ndim * ndim;
+        csr_ptr = new int[nrow + 1];
+        csr_col = new int[ptr[nrow]];
+        csr_val = new T[ptr[nrow]];
+
+        std::copy(ptr.begin(), ptr.end(), csr_ptr);
+        std::copy(col.begin(), col.end(), csr_col);
+        std::copy(val.begin(), val.end(), csr_val);
+    }
+    else
+    {
+        nrow = gen_3d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val, type == Laplace3D27);
+    }
+
+    int nnz = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    LocalStencil<T> stn(type);
+    stn.SetGrid(ndim);
+
+    EXPECT_EQ(stn.GetNDim(), is_3d ? 3 : 2);
+    int stencil_nnz[4] = {5, 7, 9, 27};
+
+    EXPECT_EQ(stn.GetNnz(), stencil_nnz[type]);
+
+    check_stencil(stn, A);
+
+    // Solve with the stencil as operator
+    LocalVector<T> b;
+    LocalVector<T> x;
+    LocalVector<T> r;
+
+    b.Allocate("b", nrow);
+    x.Allocate("x", nrow);
+    r.Allocate("r", nrow);
+
+    b.Ones();
+    x.Zeros();
+
+    CG<LocalStencil<T>, LocalVector<T>, T> ls;
+    ls.SetOperator(stn);
+    ls.Verbose(0);
+    ls.Init(1e-12, 0.0, 1e+8, 10000);
+    ls.Build();
+    ls.Solve(b, &x);
+
+    EXPECT_EQ(ls.GetSolverStatus(), 1);
+
+    // Residual with the assembled matrix
+    A.Apply(x, &r);
+    r.ScaleAdd(static_cast<T>(-1), b);
+    EXPECT_LE(r.Norm(), 1e-4 * b.Norm());
+
+    ls.Clear();
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_stencil_general(void)
+{
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Non-symmetric 3D stencil with offsets of reach two and grid point dependent
+    // coefficients on a non-uniform grid
+    {
+        int dim[3] = {37, 11, 9};
+        int n      = dim[0] * dim[1] * dim[2];
+
+        int offset[27]
+            = {0, 0, 0, -1, 0, 0, 2, 0, 0, 0, -1, 0, 0, 1, 1, 0, 0, -2, 0, 0, 1, -1, 0, 1, 1, -1, -1};
+        T   coef[9]    = {6.0, -1.0, -0.5, -1.0, -0.25, -1.0, -1.0, -0.5, -0.75};
+
+        std::vector<T> var_coef(9 * n);
+
+        unsigned int seed = 12345;
+        for(int i = 0; i < 9 * n; ++i)
+        {
+            seed        = seed * 1103515245 + 12345;
+            var_coef[i] = coef[i / n] * static_cast<T>(1.0 + ((seed >> 8) % 1000) / 1000.0);
+        }
+
+        std::vector<int> ptr;
+        std::vector<int> col;
+        std::vector<T>   val;
+
+        LocalStencil<T> stn(General);
+        stn.SetStencil(3, 9, offset, coef);
+        stn.SetGrid(dim[0], dim[1], dim[2]);
+
+        EXPECT_EQ(stn.GetNDim(), 3);
+        EXPECT_EQ(stn.GetNnz(), 9);
+
+        // Constant coefficients
+        stencil_to_csr(dim, 9, offset, coef, (T*)NULL, ptr, col, val);
+
+        LocalMatrix<T> A;
+        A.AllocateCSR("A", static_cast<int>(val.size()), n, n);
+        A.CopyFromCSR(ptr.data(), col.data(), val.data());
+
+        check_stencil(stn, A);
+
+        // Variable coefficients
+        stn.SetVariableCoefficients(var_coef.data());
+        stencil_to_csr(dim, 9, offset, coef, var_coef.data(), ptr, col, val);
+
+        A.CopyFromCSR(ptr.data(), col.data(), val.data());
+
+        check_stencil(stn, A);
+    }
+
+    // 2D and 1D stencils
+    for(int ndim = 1; ndim <= 2; ++ndim)
+    {
+        int dim[3] = {123, (ndim == 2) ? 19 : 1, 1};
+        int n      = dim[0] * dim[1];
+
+        int offset2d[12] = {0, 0, -1, 0, 1, 0, 0, -2, 0, 1, 3, 0};
+        int offset1d[6]  = {0, -1, 1, -3, 2, 3};
+        int offset[18];
+        T   coef[6] = {4.0, -1.0, -1.5, -0.5, -0.25, -0.75};
+
+        for(int k = 0; k < 6; ++k)
+        {
+            offset[3 * k]     = (ndim == 2) ? offset2d[2 * k] : offset1d[k];
+            offset[3 * k + 1] = (ndim == 2) ? offset2d[2 * k + 1] : 0;
+            offset[3 * k + 2] = 0;
+        }
+
+        std::vector<int> ptr;
+        std::vector<int> col;
+        std::vector<T>   val;
+
+        stencil_to_csr(dim, 6, offset, coef, (T*)NULL, ptr, col, val);
+
+        LocalMatrix<T> A;
+        A.AllocateCSR("A", static_cast<int>(val.size()), n, n);
+        A.CopyFromCSR(ptr.data(), col.data(), val.data());
+
+        LocalStencil<T> stn(General);
+        stn.SetStencil(ndim, 6, (ndim == 2) ? offset2d : offset1d, coef);
+        stn.SetGrid(dim[0], dim[1]);
+
+        EXPECT_EQ(stn.GetNDim(), ndim);
+
+        check_stencil(stn, A);
+    }
+
     // Stop rocALUTION
     stop_rocalution();
 }
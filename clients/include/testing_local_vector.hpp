@@ -137,4 +137,133 @@ void testing_local_vector_bad_args(void)
     stop_rocalution();
 }
 
+template <typename T>
+void testing_local_vector_reduction_batch(void)
+{
+    int size = 1000;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+
+    x.Allocate("x", size);
+    y.Allocate("y", size);
+
+    x.SetRandomUniform(1234ULL, static_cast<T>(-1), static_cast<T>(1));
+    y.SetRandomUniform(4321ULL, static_cast<T>(-1), static_cast<T>(1));
+
+    ReductionBatch<T> batch;
+
+    int dot  = batch.Dot(x, y);
+    int dotc = batch.DotNonConj(x, y);
+    int nrm  = batch.Norm(x);
+    int red  = batch.Reduce(y);
+    int asum = batch.Asum(y);
+    int val  = batch.Value(static_cast<T>(3));
+
+    ASSERT_EQ(batch.GetSize(), 6);
+
+    batch.Start();
+    batch.Wait();
+
+    // Local vectors are reduced when enqueued, results have to match exactly
+    EXPECT_EQ(batch.Get(dot), x.Dot(y));
+    EXPECT_EQ(batch.Get(dotc), x.DotNonConj(y));
+    EXPECT_EQ(batch.Get(nrm), x.Norm());
+    EXPECT_EQ(batch.Get(red), y.Reduce());
+    EXPECT_EQ(batch.Get(asum), y.Asum());
+    EXPECT_EQ(batch.Get(val), static_cast<T>(3));
+
+    // Handles start from zero after clearing the batch
+    batch.Clear();
+
+    ASSERT_EQ(batch.GetSize(), 0);
+    ASSERT_EQ(batch.Dot(y, y), 0);
+
+    batch.Wait();
+
+    EXPECT_EQ(batch.Get(0), y.Dot(y));
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_vector_random(void)
+{
+    int size = 100000;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    LocalVector<T> x[2];
+    LocalVector<T> y[2];
+
+    // The random values only depend on the seed and the index of the entry
+    for(int t = 0; t < 2; ++t)
+    {
+        set_omp_threads_rocalution((t == 0) ? 1 : 4);
+
+        x[t].Allocate("x", size);
+        y[t].Allocate("y", size);
+
+        x[t].SetRandomUniform(1234ULL, static_cast<T>(-2), static_cast<T>(3));
+        y[t].SetRandomNormal(1234ULL, static_cast<T>(1), static_cast<T>(2));
+    }
+
+    set_omp_threads_rocalution(1);
+
+    LocalVector<T> half;
+    half.Allocate("half", size / 2);
+    half.SetRandomUniform(1234ULL, static_cast<T>(-2), static_cast<T>(3));
+
+    LocalVector<T> other;
+    other.Allocate("other", size);
+    other.SetRandomUniform(4321ULL, static_cast<T>(-2), static_cast<T>(3));
+
+    double mean_x = 0.0;
+    double mean_y = 0.0;
+    double var_y  = 0.0;
+    int    same   = 0;
+
+    for(int i = 0; i < size; ++i)
+    {
+        ASSERT_EQ(x[0][i], x[1][i]);
+        ASSERT_EQ(y[0][i], y[1][i]);
+
+        if(i < size / 2)
+        {
+            ASSERT_EQ(half[i], x[0][i]);
+        }
+
+        EXPECT_GE(x[0][i], static_cast<T>(-2));
+        EXPECT_LE(x[0][i], static_cast<T>(3));
+
+        same += (other[i] == x[0][i]);
+
+        mean_x += x[0][i];
+        mean_y += y[0][i];
+        var_y += y[0][i] * y[0][i];
+    }
+
+    mean_x /= size;
+    mean_y /= size;
+    var_y = var_y / size - mean_y * mean_y;
+
+    // Different seeds give different streams
+    EXPECT_LT(same, 10);
+
+    // Moments of U(-2,3) and N(1,2^2)
+    EXPECT_NEAR(mean_x, 0.5, 0.05);
+    EXPECT_NEAR(mean_y, 1.0, 0.05);
+    EXPECT_NEAR(var_y, 4.0, 0.1);
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
 #endif // TESTING_LOCAL_VECTOR_HPP
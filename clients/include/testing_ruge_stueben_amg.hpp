@@ -173,4 +173,93 @@ bool testing_ruge_stueben_amg(Arguments argus)
     return success;
 }
 
+template <typename T>
+bool testing_ruge_stueben_amg_coarsening(Arguments argus)
+{
+    int ndim          = argus.size;
+    int coarsening    = argus.coarsening;
+    int interpolation = argus.interpolation;
+    int max_elements  = argus.max_elements;
+    int aggressive    = argus.aggressive;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    // Random initial guess
+    x.SetRandomUniform(12345ULL, -4.0, 6.0);
+
+    // Solver
+    CG<LocalMatrix<T>, LocalVector<T>, T> ls;
+
+    // AMG
+    RugeStuebenAMG<LocalMatrix<T>, LocalVector<T>, T> p;
+
+    p.SetCoarsestLevel(300);
+    p.SetCoarseningStrategy(coarsening);
+    p.SetInterpolationType(interpolation);
+    p.SetInterpolationTruncation(max_elements);
+    p.SetAggressiveCoarsening(aggressive);
+    p.InitMaxIter(1);
+    p.Verbose(0);
+
+    ls.Verbose(0);
+    ls.SetOperator(A);
+    ls.SetPreconditioner(p);
+
+    ls.Init(1e-8, 0.0, 1e+8, 10000);
+    ls.Build();
+
+    ls.Solve(b, &x);
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    T nrm2 = x.Norm();
+
+    bool success = check_residual(nrm2);
+
+    // Every level is coarser than the previous one
+    success &= p.GetGridComplexity() >= 1.0 && p.GetGridComplexity() < p.GetNumLevels();
+    success &= p.GetOperatorComplexity() >= 1.0;
+
+    // Clean up
+    ls.Clear();
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
 #endif // TESTING_RUGE_STUEBEN_AMG_HPP
@@ -27,6 +27,10 @@
 
 #include "utility.hpp"
 
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
 #include <rocalution.hpp>
 
 using namespace rocalution;
@@ -170,4 +174,197 @@ bool testing_saamg(Arguments argus)
     return success;
 }
 
+template <typename T>
+void testing_saamg_concurrent_setup(void)
+{
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(100, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    LocalVector<T> b;
+    LocalVector<T> x[2][3];
+
+    b.Allocate("b", nrow);
+    b.Ones();
+
+    int iter[2][3];
+
+    // The levels are set up in order with a single thread and as concurrent host
+    // tasks with several threads, the solvers have to be the same
+    for(int t = 0; t < 2; ++t)
+    {
+        set_omp_threads_rocalution((t == 0) ? 1 : 4);
+
+        for(int smoother = 0; smoother < 3; ++smoother)
+        {
+            SAAMG<LocalMatrix<T>, LocalVector<T>, T> p;
+
+            p.SetCoarsestLevel(50);
+            p.SetSmootherType((smoother == 0)   ? DefaultSmoother
+                              : (smoother == 1) ? ChebyshevSmoother
+                                                : GaussSeidelSmoother);
+            // Concurrent conversions with automatic format selection share its cache
+            p.SetOperatorFormat((smoother == 1) ? AUTO : ELL);
+            p.InitMaxIter(1);
+            p.Verbose(0);
+
+            FCG<LocalMatrix<T>, LocalVector<T>, T> ls;
+
+            ls.SetOperator(A);
+            ls.SetPreconditioner(p);
+            ls.Init(1e-6, 0.0, 1e+8, 1000);
+            ls.Verbose(0);
+            ls.Build();
+
+            ASSERT_GT(p.GetNumLevels(), 3);
+
+            // Numerical re-build overlaps the coarse operators with the smoothers
+            ls.ReBuildNumeric();
+
+            x[t][smoother].Allocate("x", nrow);
+            x[t][smoother].Zeros();
+
+            ls.Solve(b, &x[t][smoother]);
+
+            EXPECT_EQ(ls.GetSolverStatus(), 1);
+
+            iter[t][smoother] = ls.GetIterationCount();
+
+            ls.Clear();
+            p.Clear();
+        }
+    }
+
+    set_omp_threads_rocalution(1);
+
+    for(int smoother = 0; smoother < 3; ++smoother)
+    {
+        EXPECT_EQ(iter[0][smoother], iter[1][smoother]);
+
+        x[1][smoother].ScaleAdd(static_cast<T>(-1), x[0][smoother]);
+        EXPECT_LT(x[1][smoother].Norm(), 1e-3 * x[0][smoother].Norm());
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_saamg_hierarchy_stats(void)
+{
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(100, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    LocalVector<T> b;
+    LocalVector<T> x;
+
+    b.Allocate("b", nrow);
+    x.Allocate("x", nrow);
+    b.Ones();
+    x.Zeros();
+
+    SAAMG<LocalMatrix<T>, LocalVector<T>, T> p;
+
+    p.SetCoarsestLevel(50);
+    p.SetCycle(Kcycle);
+    p.SetLevelTiming(true);
+    p.InitMaxIter(1);
+    p.Verbose(0);
+
+    FCG<LocalMatrix<T>, LocalVector<T>, T> ls;
+
+    ls.SetOperator(A);
+    ls.SetPreconditioner(p);
+    ls.Init(1e-6, 0.0, 1e+8, 1000);
+    ls.Verbose(0);
+    ls.Build();
+
+    ls.Solve(b, &x);
+
+    EXPECT_EQ(ls.GetSolverStatus(), 1);
+
+    MultiGridStats stats;
+    p.GetHierarchyStats(&stats);
+
+    ASSERT_EQ(stats.levels, p.GetNumLevels());
+    ASSERT_EQ((int)stats.level.size(), stats.levels);
+
+    EXPECT_NEAR(stats.operator_complexity, p.GetOperatorComplexity(), 1e-12);
+    EXPECT_NEAR(stats.grid_complexity, p.GetGridComplexity(), 1e-12);
+
+    EXPECT_EQ(stats.level[0].nrow, nrow);
+    EXPECT_EQ(stats.level[0].nnz, nnz);
+    EXPECT_EQ(stats.level[0].nnz_transfer, 0);
+    EXPECT_GE(stats.time_build, stats.time_solvers);
+
+    double time_solve = 0.0;
+
+    for(int i = 0; i < stats.levels; ++i)
+    {
+        const MultiGridLevelStats& lvl = stats.level[i];
+
+        if(i > 0)
+        {
+            EXPECT_LT(lvl.nrow, stats.level[i - 1].nrow);
+            EXPECT_GT(lvl.nnz_transfer, 0);
+            EXPECT_GT(lvl.memory_transfer, 0u);
+        }
+
+        EXPECT_FALSE(lvl.host);
+        EXPECT_GT(lvl.memory_operator, 0u);
+        EXPECT_GT(lvl.memory_vectors, 0u);
+
+        // Every level is visited by each preconditioner application
+        EXPECT_GE(lvl.visits, ls.GetIterationCount());
+        EXPECT_GE(lvl.time_solve, lvl.time_smooth);
+        EXPECT_GE(lvl.time_smooth, 0.0);
+
+        time_solve += lvl.time_solve;
+    }
+
+    EXPECT_NEAR(stats.time_solve, time_solve, 1e-12);
+
+    // Statistics as JSON
+    std::string filename = "saamg_hierarchy_stats.json";
+    p.WriteHierarchyStats(filename);
+
+    std::ifstream in(filename.c_str());
+    std::string   json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::remove(filename.c_str());
+
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_NE(json.find("\"operator_complexity\""), std::string::npos);
+    EXPECT_NE(json.find("\"time_smooth\""), std::string::npos);
+
+    ls.Clear();
+    p.Clear();
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+}
+
 #endif // TESTING_SAAMG_HPP
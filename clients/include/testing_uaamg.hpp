@@ -100,7 +100,7 @@ bool testing_uaamg(Arguments argus)
     p.SetCoarsestLevel(200);
     p.SetCycle(cycle);
     p.SetOperator(A);
-    p.SetManualSmoothers(true);
+    p.SetManualSmoothers(smoother != "Chebyshev");
     p.SetManualSolver(true);
     p.SetScaling(scaling);
     p.BuildHierarchy();
@@ -112,30 +112,39 @@ bool testing_uaamg(Arguments argus)
     FCG<LocalMatrix<T>, LocalVector<T>, T> cgs;
     cgs.Verbose(0);
 
-    // Smoother for each level
-    IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>** sm
-        = new IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>*[levels - 1];
-
-    for(int i = 0; i < levels - 1; ++i)
+    if(smoother == "Chebyshev")
     {
-        FixedPoint<LocalMatrix<T>, LocalVector<T>, T>* fp
-            = new FixedPoint<LocalMatrix<T>, LocalVector<T>, T>;
-        sm[i] = fp;
-
-        Preconditioner<LocalMatrix<T>, LocalVector<T>, T>* smooth;
-
-        if(smoother == "FSAI")
-            smooth = new FSAI<LocalMatrix<T>, LocalVector<T>, T>;
-        else if(smoother == "ILU")
-            smooth = new ILU<LocalMatrix<T>, LocalVector<T>, T>;
-        else
-            return false;
-
-        sm[i]->SetPreconditioner(*smooth);
-        sm[i]->Verbose(0);
+        // Chebyshev smoothers are built internally
+        p.SetSmootherType(ChebyshevSmoother);
+    }
+    else
+    {
+        // Smoother for each level
+        IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>** sm
+            = new IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>*[levels - 1];
+
+        for(int i = 0; i < levels - 1; ++i)
+        {
+            FixedPoint<LocalMatrix<T>, LocalVector<T>, T>* fp
+                = new FixedPoint<LocalMatrix<T>, LocalVector<T>, T>;
+            sm[i] = fp;
+
+            Preconditioner<LocalMatrix<T>, LocalVector<T>, T>* smooth;
+
+            if(smoother == "FSAI")
+                smooth = new FSAI<LocalMatrix<T>, LocalVector<T>, T>;
+            else if(smoother == "ILU")
+                smooth = new ILU<LocalMatrix<T>, LocalVector<T>, T>;
+            else
+                return false;
+
+            sm[i]->SetPreconditioner(*smooth);
+            sm[i]->Verbose(0);
+        }
+
+        p.SetSmoother(sm);
     }
 
-    p.SetSmoother(sm);
     p.SetSolver(cgs);
     p.SetSmootherPreIter(pre_iter);
     p.SetSmootherPostIter(post_iter);
@@ -26,7 +26,10 @@
 #define TESTING_UTILITY_HPP
 
 #include <algorithm>
+#include <cstdlib>
+#include <random>
 #include <string>
+#include <vector>
 
 extern int device;
 
@@ -95,6 +98,147 @@ int gen_2d_laplacian(int ndim, int** rowptr, int** col, T** val)
     return n;
 }
 
+/* ============================================================================================ */
+/*! \brief  Generate 3D laplacian (7 or 27 point stencil) on unit cube in CSR format */
+template <typename T>
+int gen_3d_laplacian(int ndim, int** rowptr, int** col, T** val, bool full27 = false)
+{
+    if(ndim == 0)
+    {
+        return 0;
+    }
+
+    int n       = ndim * ndim * ndim;
+    int nnz_mat = full27 ? n * 27 : n * 7;
+
+    *rowptr = new int[n + 1];
+    *col    = new int[nnz_mat];
+    *val    = new T[nnz_mat];
+
+    int nnz = 0;
+
+    // Fill local arrays
+    for(int i = 0; i < ndim; ++i)
+    {
+        for(int j = 0; j < ndim; ++j)
+        {
+            for(int k = 0; k < ndim; ++k)
+            {
+                int idx        = (i * ndim + j) * ndim + k;
+                (*rowptr)[idx] = nnz;
+
+                // Loop over the neighborhood in increasing column order
+                for(int di = -1; di <= 1; ++di)
+                {
+                    for(int dj = -1; dj <= 1; ++dj)
+                    {
+                        for(int dk = -1; dk <= 1; ++dk)
+                        {
+                            int dist = std::abs(di) + std::abs(dj) + std::abs(dk);
+
+                            // 7 point stencil only couples face neighbors
+                            if(full27 == false && dist > 1)
+                            {
+                                continue;
+                            }
+
+                            int ii = i + di;
+                            int jj = j + dj;
+                            int kk = k + dk;
+
+                            if(ii < 0 || jj < 0 || kk < 0 || ii >= ndim || jj >= ndim
+                               || kk >= ndim)
+                            {
+                                continue;
+                            }
+
+                            (*col)[nnz] = (ii * ndim + jj) * ndim + kk;
+
+                            if(dist == 0)
+                            {
+                                (*val)[nnz] = static_cast<T>(full27 ? 26 : 6);
+                            }
+                            else
+                            {
+                                (*val)[nnz] = static_cast<T>(-1);
+                            }
+
+                            ++nnz;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    (*rowptr)[n] = nnz;
+
+    return n;
+}
+
+/* ============================================================================================ */
+/*! \brief  Generate random diagonally dominant sparse matrix in CSR format
+ *  \details
+ *  Every row has between 1 and 2 * nnz_per_row - 1 random off-diagonal entries, the
+ *  resulting row length distribution is therefore irregular (unlike stencils).
+ */
+template <typename T>
+int gen_random_sparse(int n, int nnz_per_row, unsigned int seed, int** rowptr, int** col, T** val)
+{
+    if(n == 0)
+    {
+        return 0;
+    }
+
+    std::mt19937                       gen(seed);
+    std::uniform_int_distribution<int> dist_len(1, std::max(1, 2 * nnz_per_row - 1));
+    std::uniform_int_distribution<int> dist_col(0, n - 1);
+
+    std::vector<int> row_cols;
+
+    std::vector<int> ptr(n + 1, 0);
+    std::vector<int> cols;
+    std::vector<T>   vals;
+
+    for(int i = 0; i < n; ++i)
+    {
+        int len = dist_len(gen);
+
+        row_cols.clear();
+        row_cols.push_back(i);
+
+        for(int j = 0; j < len; ++j)
+        {
+            row_cols.push_back(dist_col(gen));
+        }
+
+        // Sort and remove duplicates
+        std::sort(row_cols.begin(), row_cols.end());
+        row_cols.erase(std::unique(row_cols.begin(), row_cols.end()), row_cols.end());
+
+        int nod = static_cast<int>(row_cols.size()) - 1;
+
+        for(size_t j = 0; j < row_cols.size(); ++j)
+        {
+            cols.push_back(row_cols[j]);
+            vals.push_back(row_cols[j] == i ? static_cast<T>(nod + 1) : static_cast<T>(-1));
+        }
+
+        ptr[i + 1] = static_cast<int>(cols.size());
+    }
+
+    int nnz = ptr[n];
+
+    *rowptr = new int[n + 1];
+    *col    = new int[nnz];
+    *val    = new T[nnz];
+
+    std::copy(ptr.begin(), ptr.end(), *rowptr);
+    std::copy(cols.begin(), cols.end(), *col);
+    std::copy(vals.begin(), vals.end(), *val);
+
+    return n;
+}
+
 /* ============================================================================================ */
 
 /*! \brief Class used to parse command arguments in both client & gtest   */
@@ -119,9 +263,10 @@ public:
     int use_acc = true;
 
     // Structure variables
-    int size       = 100;
-    int index      = 50;
-    int chunk_size = 20;
+    int size        = 100;
+    int index       = 50;
+    int chunk_size  = 20;
+    int nnz_per_row = 20;
 
     // Computation variables
     double alpha = 1.0;
@@ -138,8 +283,22 @@ public:
     int ordering    = 1;
     int cycle       = 0;
 
+    // AMG variables
+    int coarsening    = 0;
+    int interpolation = 0;
+    int max_elements  = 0;
+    int aggressive    = 0;
+
     unsigned int format;
 
+    // Benchmark variables
+    std::string function  = "";
+    std::string precision = "d";
+    std::string matrix    = "laplace2d";
+    std::string filename  = "";
+    std::string json      = "";
+    int         iters     = 10;
+
     Arguments& operator=(const Arguments& rhs)
     {
         this->rank         = rhs.rank;
@@ -152,9 +311,10 @@ public:
         this->dev     = rhs.dev;
         this->use_acc = rhs.use_acc;
 
-        this->size       = rhs.size;
-        this->index      = rhs.index;
-        this->chunk_size = rhs.chunk_size;
+        this->size        = rhs.size;
+        this->index       = rhs.index;
+        this->chunk_size  = rhs.chunk_size;
+        this->nnz_per_row = rhs.nnz_per_row;
 
         this->alpha = rhs.alpha;
         this->beta  = rhs.beta;
@@ -169,8 +329,20 @@ public:
         this->ordering    = rhs.ordering;
         this->cycle       = rhs.cycle;
 
+        this->coarsening    = rhs.coarsening;
+        this->interpolation = rhs.interpolation;
+        this->max_elements  = rhs.max_elements;
+        this->aggressive    = rhs.aggressive;
+
         this->format = rhs.format;
 
+        this->function  = rhs.function;
+        this->precision = rhs.precision;
+        this->matrix    = rhs.matrix;
+        this->filename  = rhs.filename;
+        this->json      = rhs.json;
+        this->iters     = rhs.iters;
+
         return *this;
     }
 };
@@ -0,0 +1,76 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "testing_cacg.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, int, unsigned int, std::string, unsigned int> cacg_tuple;
+
+int          cacg_size[]    = {7, 63};
+int          cacg_step[]    = {2, 3};
+unsigned int cacg_basis[]   = {0, 1, 2};
+std::string  cacg_precond[] = {"None", "Jacobi", "FSAI", "IC"};
+unsigned int cacg_format[]  = {1, 2, 4, 5, 6, 7};
+
+class parameterized_cacg : public testing::TestWithParam<cacg_tuple>
+{
+protected:
+    parameterized_cacg() {}
+    virtual ~parameterized_cacg() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_cacg_arguments(cacg_tuple tup)
+{
+    Arguments arg;
+    arg.size    = std::get<0>(tup);
+    arg.index   = std::get<1>(tup);
+    arg.cycle   = std::get<2>(tup);
+    arg.precond = std::get<3>(tup);
+    arg.format  = std::get<4>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_cacg, cacg_float)
+{
+    Arguments arg = setup_cacg_arguments(GetParam());
+    ASSERT_EQ(testing_cacg<float>(arg), true);
+}
+
+TEST_P(parameterized_cacg, cacg_double)
+{
+    Arguments arg = setup_cacg_arguments(GetParam());
+    ASSERT_EQ(testing_cacg<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(cacg,
+                        parameterized_cacg,
+                        testing::Combine(testing::ValuesIn(cacg_size),
+                                         testing::ValuesIn(cacg_step),
+                                         testing::ValuesIn(cacg_basis),
+                                         testing::ValuesIn(cacg_precond),
+                                         testing::ValuesIn(cacg_format)));
@@ -31,7 +31,8 @@ typedef std::tuple<int, int, std::string, unsigned int> fgmres_tuple;
 int         fgmres_size[]  = {7, 63};
 int         fgmres_basis[] = {20, 60};
 std::string fgmres_precond[]
-    = {"None", "Chebyshev", "SPAI", "TNS", "Jacobi", /*"GS", "ILU",*/ "ILUT", "MCGS" /*, "MCILU"*/};
+    = {"None", "Chebyshev", "SPAI", "TNS", "Jacobi", /*"GS", "ILU",*/ "ILUT", "MCGS" /*, "MCILU"*/,
+       "ME"};
 unsigned int fgmres_format[] = {1, 2, 4, 5, 6, 7};
 
 class parameterized_fgmres : public testing::TestWithParam<fgmres_tuple>
@@ -0,0 +1,73 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "testing_gcrodr.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, int, std::string, unsigned int> gcrodr_tuple;
+
+int         gcrodr_size[]    = {7, 63};
+int         gcrodr_recycle[] = {4, 10};
+std::string gcrodr_precond[] = {"None", "Chebyshev", "Jacobi", "SPAI"};
+unsigned int gcrodr_format[] = {1, 2, 4, 5, 6, 7};
+
+class parameterized_gcrodr : public testing::TestWithParam<gcrodr_tuple>
+{
+protected:
+    parameterized_gcrodr() {}
+    virtual ~parameterized_gcrodr() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_gcrodr_arguments(gcrodr_tuple tup)
+{
+    Arguments arg;
+    arg.size    = std::get<0>(tup);
+    arg.index   = std::get<1>(tup);
+    arg.precond = std::get<2>(tup);
+    arg.format  = std::get<3>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_gcrodr, gcrodr_float)
+{
+    Arguments arg = setup_gcrodr_arguments(GetParam());
+    ASSERT_EQ(testing_gcrodr<float>(arg), true);
+}
+
+TEST_P(parameterized_gcrodr, gcrodr_double)
+{
+    Arguments arg = setup_gcrodr_arguments(GetParam());
+    ASSERT_EQ(testing_gcrodr<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(gcrodr,
+                        parameterized_gcrodr,
+                        testing::Combine(testing::ValuesIn(gcrodr_size),
+                                         testing::ValuesIn(gcrodr_recycle),
+                                         testing::ValuesIn(gcrodr_precond),
+                                         testing::ValuesIn(gcrodr_format)));
@@ -62,6 +62,26 @@ TEST(global_matrix_bad_args, global_matrix)
 {
     testing_global_matrix_bad_args<float>();
 }
+
+TEST(global_matrix_apply_add_float, global_matrix)
+{
+    testing_global_matrix_apply_add<float>();
+}
+
+TEST(global_matrix_apply_add_double, global_matrix)
+{
+    testing_global_matrix_apply_add<double>();
+}
+
+TEST(global_matrix_distribute_float, global_matrix)
+{
+    testing_global_matrix_distribute<float>();
+}
+
+TEST(global_matrix_distribute_double, global_matrix)
+{
+    testing_global_matrix_distribute<double>();
+}
 /*
 TEST_P(parameterized_backend, backend)
 {
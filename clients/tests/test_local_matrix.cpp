@@ -62,6 +62,148 @@ TEST(local_matrix_bad_args, local_matrix)
 {
     testing_local_matrix_bad_args<float>();
 }
+
+TEST(local_matrix_file_io_float, local_matrix)
+{
+    testing_local_matrix_file_io<float>();
+}
+
+TEST(local_matrix_file_io_double, local_matrix)
+{
+    testing_local_matrix_file_io<double>();
+}
+
+TEST(local_matrix_file_stream_float, local_matrix)
+{
+    testing_local_matrix_file_stream<float>();
+}
+
+TEST(local_matrix_file_stream_double, local_matrix)
+{
+    testing_local_matrix_file_stream<double>();
+}
+
+TEST(local_matrix_row_offset64_float, local_matrix)
+{
+    testing_local_matrix_row_offset64<float>();
+}
+
+// Maps more than 2^31 entries and touches a few pages of them, run it explicitly
+// with --gtest_also_run_disabled_tests
+TEST(DISABLED_local_matrix_large_nnz_float, local_matrix)
+{
+    testing_local_matrix_large_nnz<float>();
+}
+
+TEST(local_matrix_spmv_float, local_matrix)
+{
+    testing_local_matrix_spmv<float>();
+}
+
+TEST(local_matrix_spmv_double, local_matrix)
+{
+    testing_local_matrix_spmv<double>();
+}
+
+TEST(local_matrix_select_format_float, local_matrix)
+{
+    testing_local_matrix_select_format<float>();
+}
+
+TEST(local_matrix_select_format_double, local_matrix)
+{
+    testing_local_matrix_select_format<double>();
+}
+
+TEST(local_matrix_partition_float, local_matrix)
+{
+    testing_local_matrix_partition<float>();
+}
+
+TEST(local_matrix_partition_double, local_matrix)
+{
+    testing_local_matrix_partition<double>();
+}
+
+TEST(local_matrix_ordering_float, local_matrix)
+{
+    testing_local_matrix_ordering<float>();
+}
+
+TEST(local_matrix_ordering_double, local_matrix)
+{
+    testing_local_matrix_ordering<double>();
+}
+
+TEST(local_matrix_aggregation_float, local_matrix)
+{
+    testing_local_matrix_aggregation<float>();
+}
+
+TEST(local_matrix_aggregation_double, local_matrix)
+{
+    testing_local_matrix_aggregation<double>();
+}
+
+TEST(local_matrix_pairwise_aggregation_float, local_matrix)
+{
+    testing_local_matrix_pairwise_aggregation<float>();
+}
+
+TEST(local_matrix_pairwise_aggregation_double, local_matrix)
+{
+    testing_local_matrix_pairwise_aggregation<double>();
+}
+
+TEST(local_matrix_matrix_powers_float, local_matrix)
+{
+    testing_local_matrix_matrix_powers<float>();
+}
+
+TEST(local_matrix_matrix_powers_double, local_matrix)
+{
+    testing_local_matrix_matrix_powers<double>();
+}
+
+TEST(local_matrix_matrix_polynomial_float, local_matrix)
+{
+    testing_local_matrix_matrix_polynomial<float>();
+}
+
+TEST(local_matrix_matrix_polynomial_double, local_matrix)
+{
+    testing_local_matrix_matrix_polynomial<double>();
+}
+
+TEST(local_matrix_schur_complement_float, local_matrix)
+{
+    testing_local_matrix_schur_complement<float>();
+}
+
+TEST(local_matrix_schur_complement_double, local_matrix)
+{
+    testing_local_matrix_schur_complement<double>();
+}
+
+TEST(local_matrix_symbolic_ilup_float, local_matrix)
+{
+    testing_local_matrix_symbolic_ilup<float>();
+}
+
+TEST(local_matrix_symbolic_ilup_double, local_matrix)
+{
+    testing_local_matrix_symbolic_ilup<double>();
+}
+
+TEST(local_matrix_sor_sweep_float, local_matrix)
+{
+    testing_local_matrix_sor_sweep<float>();
+}
+
+TEST(local_matrix_sor_sweep_double, local_matrix)
+{
+    testing_local_matrix_sor_sweep<double>();
+}
 /*
 TEST_P(parameterized_backend, backend)
 {
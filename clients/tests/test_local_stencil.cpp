@@ -62,6 +62,41 @@ TEST(local_stencil_bad_args, local_stencil)
 {
     testing_local_stencil_bad_args<float>();
 }
+
+TEST(local_stencil_laplace2d_double, local_stencil)
+{
+    testing_local_stencil<double>(Laplace2D);
+}
+
+TEST(local_stencil_laplace3d_float, local_stencil)
+{
+    testing_local_stencil<float>(Laplace3D);
+}
+
+TEST(local_stencil_laplace3d_double, local_stencil)
+{
+    testing_local_stencil<double>(Laplace3D);
+}
+
+TEST(local_stencil_laplace2d9_double, local_stencil)
+{
+    testing_local_stencil<double>(Laplace2D9);
+}
+
+TEST(local_stencil_laplace3d27_double, local_stencil)
+{
+    testing_local_stencil<double>(Laplace3D27);
+}
+
+TEST(local_stencil_general_float, local_stencil)
+{
+    testing_local_stencil_general<float>();
+}
+
+TEST(local_stencil_general_double, local_stencil)
+{
+    testing_local_stencil_general<double>();
+}
 /*
 TEST_P(parameterized_backend, backend)
 {
@@ -62,6 +62,26 @@ TEST(local_vector_bad_args, local_vector)
 {
     testing_local_vector_bad_args<float>();
 }
+
+TEST(local_vector_reduction_batch_float, local_vector)
+{
+    testing_local_vector_reduction_batch<float>();
+}
+
+TEST(local_vector_reduction_batch_double, local_vector)
+{
+    testing_local_vector_reduction_batch<double>();
+}
+
+TEST(local_vector_random_float, local_vector)
+{
+    testing_local_vector_random<float>();
+}
+
+TEST(local_vector_random_double, local_vector)
+{
+    testing_local_vector_random<double>();
+}
 /*
 TEST_P(parameterized_backend, backend)
 {
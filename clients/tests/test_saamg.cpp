@@ -35,7 +35,7 @@ int         saamg_post_iter[] = {1, 2};
 int         saamg_cycle[]     = {0, 2};
 int         saamg_scaling[]   = {0, 1};
 
-unsigned int saamg_format[] = {1, 6};
+unsigned int saamg_format[] = {1, 6, 8};
 
 class parameterized_saamg : public testing::TestWithParam<saamg_tuple>
 {
@@ -71,6 +71,26 @@ TEST_P(parameterized_saamg, saamg_double)
     ASSERT_EQ(testing_saamg<double>(arg), true);
 }
 
+TEST(saamg_concurrent_setup_float, saamg)
+{
+    testing_saamg_concurrent_setup<float>();
+}
+
+TEST(saamg_concurrent_setup_double, saamg)
+{
+    testing_saamg_concurrent_setup<double>();
+}
+
+TEST(saamg_hierarchy_stats_float, saamg)
+{
+    testing_saamg_hierarchy_stats<float>();
+}
+
+TEST(saamg_hierarchy_stats_double, saamg)
+{
+    testing_saamg_hierarchy_stats<double>();
+}
+
 INSTANTIATE_TEST_CASE_P(saamg,
                         parameterized_saamg,
                         testing::Combine(testing::ValuesIn(saamg_size),
@@ -38,6 +38,9 @@ else()
   option(SUPPORT_OMP "Compile WITH OpenMP support." ON)
 endif()
 
+# Threads, used by the host task graph
+find_package(Threads REQUIRED)
+
 # MPI
 find_package(MPI)
 if (NOT MPI_FOUND)
@@ -39,6 +39,10 @@
 #include "host/host_vector.hpp"
 #include "version.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
 #include <stdlib.h>
 #include <string.h>
 
@@ -258,6 +262,15 @@ namespace rocalution
 #endif // omp
     }
 
+    int get_omp_threads_rocalution(void)
+    {
+        log_debug(0, "get_omp_threads_rocalution()");
+
+        assert(_get_backend_descriptor()->init == true);
+
+        return _get_backend_descriptor()->OpenMP_threads;
+    }
+
     void set_device_rocalution(int dev)
     {
         log_debug(0, "set_device_rocalution()", dev);
@@ -462,13 +475,19 @@ namespace rocalution
 
     template <typename ValueType>
     HostMatrix<ValueType>* _rocalution_init_base_host_matrix(
-        const struct Rocalution_Backend_Descriptor backend_descriptor, unsigned int matrix_format)
+        const struct Rocalution_Backend_Descriptor backend_descriptor,
+        unsigned int                               matrix_format,
+        IndexType2                                 nnz)
     {
-        log_debug(0, "_rocalution_init_base_host_matrix()", matrix_format);
+        log_debug(0, "_rocalution_init_base_host_matrix()", matrix_format, nnz);
 
         switch(matrix_format)
         {
         case CSR:
+            if(nnz > std::numeric_limits<int>::max())
+            {
+                return new HostMatrixCSRBase<ValueType, IndexType2>(backend_descriptor);
+            }
             return new HostMatrixCSR<ValueType>(backend_descriptor);
             break;
         case COO:
@@ -507,29 +526,77 @@ namespace rocalution
         }
     }
 
-    void _set_omp_backend_threads(const struct Rocalution_Backend_Descriptor backend_descriptor,
-                                  int                                        size)
+    // Number of running host tasks and if the calling thread is running one, see TaskGraph
+    static std::atomic<int>   _running_tasks(0);
+    static thread_local bool _in_task = false;
+
+    // OMP threads of the calling thread before it started the task
+    static thread_local int _task_omp_threads = 1;
+
+    // Objects can be created and deleted by concurrent host tasks
+    static std::mutex _obj_tracking_mutex;
+
+    int _get_omp_backend_threads(const struct Rocalution_Backend_Descriptor backend_descriptor,
+                                 IndexType2                                 size)
     {
         // if the threshold is disabled or if the size is not in the threshold limit
         if((backend_descriptor.OpenMP_threshold > 0)
            && (size <= backend_descriptor.OpenMP_threshold) && (size >= 0))
         {
-#ifdef _OPENMP
-            omp_set_num_threads(1);
-#endif
+            return 1;
         }
-        else
+
+        // Running host tasks share the threads
+        if(_in_task == true)
         {
+            int ntasks = std::max(1, _running_tasks.load());
+
+            return std::max(1, backend_descriptor.OpenMP_threads / ntasks);
+        }
+
+        return backend_descriptor.OpenMP_threads;
+    }
+
+    void _set_omp_backend_threads(const struct Rocalution_Backend_Descriptor backend_descriptor,
+                                  IndexType2                                 size)
+    {
 #ifdef _OPENMP
-            omp_set_num_threads(backend_descriptor.OpenMP_threads);
+        omp_set_num_threads(_get_omp_backend_threads(backend_descriptor, size));
+#endif
+    }
+
+    void _rocalution_task_begin(void)
+    {
+        assert(_in_task == false);
+
+        _in_task = true;
+        ++_running_tasks;
+
+        // Kernels that do not set the OMP threads themselves use the share of the task
+#ifdef _OPENMP
+        _task_omp_threads = omp_get_max_threads();
+        _set_omp_backend_threads(_Backend_Descriptor, -1);
+#endif
+    }
+
+    void _rocalution_task_end(void)
+    {
+        assert(_in_task == true);
+
+        _in_task = false;
+        --_running_tasks;
+
+#ifdef _OPENMP
+        omp_set_num_threads(_task_omp_threads);
 #endif
-        }
     }
 
     size_t _rocalution_add_obj(class RocalutionObj* ptr)
     {
 #ifndef OBJ_TRACKING_OFF
 
+        std::lock_guard<std::mutex> lock(_obj_tracking_mutex);
+
         log_debug(0, "Creating new rocALUTION object, ptr=", ptr);
 
         Rocalution_Object_Data_Tracking.all_obj.push_back(ptr);
@@ -553,6 +620,8 @@ namespace rocalution
 
 #ifndef OBJ_TRACKING_OFF
 
+        std::lock_guard<std::mutex> lock(_obj_tracking_mutex);
+
         log_debug(0, "Deleting rocALUTION object, ptr=", ptr);
 
         log_debug(0, "Deleting rocALUTION object, id=", id);
@@ -636,14 +705,22 @@ namespace rocalution
         const struct Rocalution_Backend_Descriptor backend_descriptor, unsigned int matrix_format);
 #endif
     template HostMatrix<float>* _rocalution_init_base_host_matrix(
-        const struct Rocalution_Backend_Descriptor backend_descriptor, unsigned int matrix_format);
+        const struct Rocalution_Backend_Descriptor backend_descriptor,
+        unsigned int                               matrix_format,
+        IndexType2                                 nnz);
     template HostMatrix<double>* _rocalution_init_base_host_matrix(
-        const struct Rocalution_Backend_Descriptor backend_descriptor, unsigned int matrix_format);
+        const struct Rocalution_Backend_Descriptor backend_descriptor,
+        unsigned int                               matrix_format,
+        IndexType2                                 nnz);
 #ifdef SUPPORT_COMPLEX
     template HostMatrix<std::complex<float>>* _rocalution_init_base_host_matrix(
-        const struct Rocalution_Backend_Descriptor backend_descriptor, unsigned int matrix_format);
+        const struct Rocalution_Backend_Descriptor backend_descriptor,
+        unsigned int                               matrix_format,
+        IndexType2                                 nnz);
     template HostMatrix<std::complex<double>>* _rocalution_init_base_host_matrix(
-        const struct Rocalution_Backend_Descriptor backend_descriptor, unsigned int matrix_format);
+        const struct Rocalution_Backend_Descriptor backend_descriptor,
+        unsigned int                               matrix_format,
+        IndexType2                                 nnz);
 #endif
 
 } // namespace rocalution
@@ -24,6 +24,8 @@
 #ifndef ROCALUTION_BACKEND_MANAGER_HPP_
 #define ROCALUTION_BACKEND_MANAGER_HPP_
 
+#include "../utils/types.hpp"
+
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -190,6 +192,16 @@ namespace rocalution
   */
     void set_omp_threads_rocalution(int nthreads);
 
+    /** \ingroup backend_module
+  * \brief Get number of OpenMP threads
+  * \details
+  * \p get_omp_threads_rocalution returns the number of OpenMP threads rocALUTION has
+  * been set up with, see set_omp_threads_rocalution().
+  *
+  * \retval number of OpenMP threads
+  */
+    int get_omp_threads_rocalution(void);
+
     /** \ingroup backend_module
   * \brief Enable/disable OpenMP host affinity
   * \details
@@ -255,19 +267,31 @@ namespace rocalution
     // Set backend descriptor
     void _set_backend_descriptor(const struct Rocalution_Backend_Descriptor backend_descriptor);
 
+    // Return the OMP threads based on the size threshold and the running host tasks
+    int _get_omp_backend_threads(const struct Rocalution_Backend_Descriptor backend_descriptor,
+                                 IndexType2                                 size);
+
     // Set the OMP threads based on the size threshold
     void _set_omp_backend_threads(const struct Rocalution_Backend_Descriptor backend_descriptor,
-                                  int                                        size);
+                                  IndexType2                                 size);
+
+    // Mark the calling thread as running a host task (see TaskGraph), the OMP threads
+    // are split between all running tasks
+    void _rocalution_task_begin(void);
+    void _rocalution_task_end(void);
 
     // Build (and return) a vector on the selected in the descriptor accelerator
     template <typename ValueType>
     AcceleratorVector<ValueType>* _rocalution_init_base_backend_vector(
         const struct Rocalution_Backend_Descriptor backend_descriptor);
 
-    // Build (and return) a matrix on the host
+    // Build (and return) a matrix on the host, a CSR matrix with more non-zero entries
+    // (nnz) than int can address gets 64 bit row offsets
     template <typename ValueType>
     HostMatrix<ValueType>* _rocalution_init_base_host_matrix(
-        const struct Rocalution_Backend_Descriptor backend_descriptor, unsigned int matrix_format);
+        const struct Rocalution_Backend_Descriptor backend_descriptor,
+        unsigned int                               matrix_format,
+        IndexType2                                 nnz = 0);
 
     // Build (and return) a matrix on the selected in the descriptor accelerator
     template <typename ValueType>
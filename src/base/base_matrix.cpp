@@ -61,7 +61,7 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    inline int BaseMatrix<ValueType>::GetNnz(void) const
+    IndexType2 BaseMatrix<ValueType>::GetNnz(void) const
     {
         return this->nnz_;
     }
@@ -138,9 +138,9 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void BaseMatrix<ValueType>::AllocateCSR(int nnz, int nrow, int ncol)
+    void BaseMatrix<ValueType>::AllocateCSR(IndexType2 nnz, int nrow, int ncol)
     {
-        LOG_INFO("AllocateCSR(int nnz, int nrow, int ncol)");
+        LOG_INFO("AllocateCSR(IndexType2 nnz, int nrow, int ncol)");
         LOG_INFO("Matrix format=" << _matrix_format_names[this->GetMatFormat()]);
         this->Info();
         LOG_INFO("This is NOT a CSR matrix");
@@ -148,9 +148,9 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void BaseMatrix<ValueType>::AllocateCOO(int nnz, int nrow, int ncol)
+    void BaseMatrix<ValueType>::AllocateCOO(IndexType2 nnz, int nrow, int ncol)
     {
-        LOG_INFO("AllocateCOO(int nnz, int nrow, int ncol)");
+        LOG_INFO("AllocateCOO(IndexType2 nnz, int nrow, int ncol)");
         LOG_INFO("Matrix format=" << _matrix_format_names[this->GetMatFormat()]);
         this->Info();
         LOG_INFO("This is NOT a COO matrix");
@@ -228,6 +228,12 @@ namespace rocalution
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::MapFileCSR(const std::string filename)
+    {
+        return false;
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::WriteFileCSR(const std::string filename) const
     {
@@ -350,6 +356,24 @@ namespace rocalution
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::NestedDissection(BaseVector<int>* permutation) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::LocalityOrder(int block_size, BaseVector<int>* permutation) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::Partition(int nparts, BaseVector<int>* partition) const
+    {
+        return false;
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::MultiColoring(int&             num_colors,
                                               int**            size_colors,
@@ -370,12 +394,28 @@ namespace rocalution
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::SchurComplement(int                    size,
+                                                BaseVector<ValueType>* inv_diag,
+                                                BaseMatrix<ValueType>* E,
+                                                BaseMatrix<ValueType>* F,
+                                                BaseMatrix<ValueType>* S) const
+    {
+        return false;
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::SymbolicPower(int p)
     {
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::SymbolicILUp(int p)
+    {
+        return false;
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::SymbolicMatMatMult(const BaseMatrix<ValueType>& src)
     {
@@ -403,6 +443,49 @@ namespace rocalution
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::MatrixPowers(int                     k,
+                                             const ValueType*        alpha,
+                                             const ValueType*        beta,
+                                             const ValueType*        gamma,
+                                             BaseVector<ValueType>** v) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::MatrixPolynomial(int                          k,
+                                                 const ValueType*             alpha,
+                                                 const ValueType*             beta,
+                                                 const ValueType*             gamma,
+                                                 const ValueType*             weight,
+                                                 const BaseVector<ValueType>* scale,
+                                                 const BaseVector<ValueType>& in,
+                                                 BaseVector<ValueType>*       out) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::SORSweep(int                          num_colors,
+                                         const int*                   color_offset,
+                                         const BaseVector<int>&       color_rows,
+                                         ValueType                    omega,
+                                         bool                         symmetric,
+                                         bool                         zero_guess,
+                                         int                          sweeps,
+                                         const BaseVector<ValueType>& rhs,
+                                         BaseVector<ValueType>*       x) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::SelectFormat(bool accel, unsigned int& mat_format) const
+    {
+        return false;
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::Scale(ValueType alpha)
     {
@@ -586,6 +669,18 @@ namespace rocalution
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::RugeStueben(ValueType              eps,
+                                            int                    coarsening,
+                                            int                    interpolation,
+                                            bool                   aggressive,
+                                            int                    max_elements,
+                                            BaseMatrix<ValueType>* prolong,
+                                            BaseMatrix<ValueType>* restrict) const
+    {
+        return false;
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::InitialPairwiseAggregation(ValueType        beta,
                                                            int&             nc,
@@ -750,7 +845,7 @@ namespace rocalution
 
     template <typename ValueType>
     void BaseMatrix<ValueType>::SetDataPtrCOO(
-        int** row, int** col, ValueType** val, int nnz, int nrow, int ncol)
+        int** row, int** col, ValueType** val, IndexType2 nnz, int nrow, int ncol)
     {
         LOG_INFO("BaseMatrix<ValueType>::SetDataPtrCOO(...)");
         LOG_INFO("Matrix format=" << _matrix_format_names[this->GetMatFormat()]);
@@ -790,6 +885,33 @@ namespace rocalution
         FATAL_ERROR(__FILE__, __LINE__);
     }
 
+    template <typename ValueType>
+    void BaseMatrix<ValueType>::SetDataPtrCSR64(IndexType2** row_offset,
+                                                int**        col,
+                                                ValueType**  val,
+                                                IndexType2   nnz,
+                                                int          nrow,
+                                                int          ncol)
+    {
+        LOG_INFO("BaseMatrix<ValueType>::SetDataPtrCSR64(...)");
+        LOG_INFO("Matrix format=" << _matrix_format_names[this->GetMatFormat()]);
+        this->Info();
+        LOG_INFO("The function is not implemented (yet)! Check the backend?");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void BaseMatrix<ValueType>::LeaveDataPtrCSR64(IndexType2** row_offset,
+                                                  int**        col,
+                                                  ValueType**  val)
+    {
+        LOG_INFO("BaseMatrix<ValueType>::LeaveDataPtrCSR64(...)");
+        LOG_INFO("Matrix format=" << _matrix_format_names[this->GetMatFormat()]);
+        this->Info();
+        LOG_INFO("The function is not implemented (yet)! Check the backend?");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
     template <typename ValueType>
     void BaseMatrix<ValueType>::SetDataPtrMCSR(
         int** row_offset, int** col, ValueType** val, int nnz, int nrow, int ncol)
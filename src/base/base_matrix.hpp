@@ -24,6 +24,7 @@
 #ifndef ROCALUTION_BASE_MATRIX_HPP_
 #define ROCALUTION_BASE_MATRIX_HPP_
 
+#include "../utils/types.hpp"
 #include "backend_manager.hpp"
 #include "matrix_formats.hpp"
 
@@ -39,6 +40,8 @@ namespace rocalution
 
     template <typename ValueType>
     class HostMatrixCSR;
+    template <typename ValueType, typename PointerType>
+    class HostMatrixCSRBase;
     template <typename ValueType>
     class HostMatrixCOO;
     template <typename ValueType>
@@ -84,7 +87,7 @@ namespace rocalution
         /// Return the number of columns in the matrix
         int GetN(void) const;
         /// Return the non-zeros of the matrix
-        int GetNnz(void) const;
+        IndexType2 GetNnz(void) const;
         /// Shows simple info about the object
         virtual void Info(void) const = 0;
         /// Return the matrix format id (see matrix_formats.hpp)
@@ -95,11 +98,11 @@ namespace rocalution
         virtual bool Check(void) const;
 
         /// Allocate CSR Matrix
-        virtual void AllocateCSR(int nnz, int nrow, int ncol);
+        virtual void AllocateCSR(IndexType2 nnz, int nrow, int ncol);
         /// Allocate MCSR Matrix
         virtual void AllocateMCSR(int nnz, int nrow, int ncol);
         /// Allocate COO Matrix
-        virtual void AllocateCOO(int nnz, int nrow, int ncol);
+        virtual void AllocateCOO(IndexType2 nnz, int nrow, int ncol);
         /// Allocate DIA Matrix
         virtual void AllocateDIA(int nnz, int nrow, int ncol, int ndiag);
         /// Allocate ELL Matrix
@@ -110,8 +113,8 @@ namespace rocalution
         virtual void AllocateDENSE(int nrow, int ncol);
 
         /// Initialize a COO matrix on the Host with externally allocated data
-        virtual void
-            SetDataPtrCOO(int** row, int** col, ValueType** val, int nnz, int nrow, int ncol);
+        virtual void SetDataPtrCOO(
+            int** row, int** col, ValueType** val, IndexType2 nnz, int nrow, int ncol);
         /// Leave a COO matrix to Host pointers
         virtual void LeaveDataPtrCOO(int** row, int** col, ValueType** val);
 
@@ -120,6 +123,16 @@ namespace rocalution
             int** row_offset, int** col, ValueType** val, int nnz, int nrow, int ncol);
         /// Leave a CSR matrix to Host pointers
         virtual void LeaveDataPtrCSR(int** row_offset, int** col, ValueType** val);
+        /// Initialize a CSR matrix on the Host with externally allocated data and 64 bit row
+        /// offsets
+        virtual void SetDataPtrCSR64(IndexType2** row_offset,
+                                     int**        col,
+                                     ValueType**  val,
+                                     IndexType2   nnz,
+                                     int          nrow,
+                                     int          ncol);
+        /// Leave a CSR matrix to Host pointers with 64 bit row offsets
+        virtual void LeaveDataPtrCSR64(IndexType2** row_offset, int** col, ValueType** val);
 
         /// Initialize a MCSR matrix on the Host with externally allocated data
         virtual void SetDataPtrMCSR(
@@ -195,6 +208,12 @@ namespace rocalution
         virtual bool RCMK(BaseVector<int>* permutation) const;
         /// Create permutation vector for connectivity reordering of the matrix (increasing nnz per row)
         virtual bool ConnectivityOrder(BaseVector<int>* permutation) const;
+        /// Create permutation vector for nested dissection reordering of the matrix
+        virtual bool NestedDissection(BaseVector<int>* permutation) const;
+        /// Create permutation vector for cache-oriented reordering of the matrix in blocks
+        virtual bool LocalityOrder(int block_size, BaseVector<int>* permutation) const;
+        /// Partition the adjacency graph of the matrix into nparts parts with few couplings
+        virtual bool Partition(int nparts, BaseVector<int>* partition) const;
 
         /// Perform multi-coloring decomposition of the matrix; Returns number of
         /// colors, the corresponding sizes (the array is allocated in the function)
@@ -211,6 +230,15 @@ namespace rocalution
         /// the return size is the size of the first block
         virtual bool ZeroBlockPermutation(int& size, BaseVector<int>* permutation) const;
 
+        /// Split the matrix into the blocks [D, F; E, C], where D is the diagonal block of
+        /// the first size rows and columns; Returns the inverse diagonal of D, E*D^-1, F and
+        /// the Schur complement S = C - E*D^-1*F
+        virtual bool SchurComplement(int                    size,
+                                     BaseVector<ValueType>* inv_diag,
+                                     BaseMatrix<ValueType>* E,
+                                     BaseMatrix<ValueType>* F,
+                                     BaseMatrix<ValueType>* S) const;
+
         /// Convert the matrix from another matrix (with different structure)
         virtual bool ConvertFrom(const BaseMatrix<ValueType>& mat) = 0;
 
@@ -259,12 +287,18 @@ namespace rocalution
 
         /// Read matrix from CSR (ROCALUTION binary format) file
         virtual bool ReadFileCSR(const std::string filename);
+        /// Map matrix from CSR (ROCALUTION binary format) file into memory
+        virtual bool MapFileCSR(const std::string filename);
         /// Write matrix to CSR (ROCALUTION binary format) file
         virtual bool WriteFileCSR(const std::string filename) const;
 
         /// Perform symbolic computation (structure only) of |this|^p
         virtual bool SymbolicPower(int p);
 
+        /// Replace the structure by the level-of-fill ILU(p) pattern, the values are kept
+        /// and fill-in entries are zero
+        virtual bool SymbolicILUp(int p);
+
         /// Perform symbolic matrix-matrix multiplication (i.e. determine the structure),
         /// this = this*src
         virtual bool SymbolicMatMatMult(const BaseMatrix<ValueType>& src);
@@ -360,6 +394,43 @@ namespace rocalution
         /// Compute the spectrum approximation with Gershgorin circles theorem
         virtual bool Gershgorin(ValueType& lambda_min, ValueType& lambda_max) const;
 
+        /// Select the most suitable matrix format for the host (accel == false) or the
+        /// accelerator (accel == true) backend, based on the sparsity pattern
+        virtual bool SelectFormat(bool accel, unsigned int& mat_format) const;
+
+        /// Compute the polynomial basis v[j+1] = alpha[j]*this*v[j] + beta[j]*v[j] +
+        /// gamma[j]*v[j-1], j = 0, ..., k-1 (matrix powers kernel)
+        virtual bool MatrixPowers(int                     k,
+                                  const ValueType*        alpha,
+                                  const ValueType*        beta,
+                                  const ValueType*        gamma,
+                                  BaseVector<ValueType>** v) const;
+
+        /// Compute out = weight[0]*v[0] + ... + weight[k]*v[k] of the polynomial basis
+        /// v[j+1] = alpha[j]*diag(scale)*this*v[j] + beta[j]*v[j] + gamma[j]*v[j-1] with
+        /// v[0] = in, scale can be NULL (matrix powers kernel)
+        virtual bool MatrixPolynomial(int                          k,
+                                      const ValueType*             alpha,
+                                      const ValueType*             beta,
+                                      const ValueType*             gamma,
+                                      const ValueType*             weight,
+                                      const BaseVector<ValueType>* scale,
+                                      const BaseVector<ValueType>& in,
+                                      BaseVector<ValueType>*       out) const;
+
+        /// Perform sweeps of (symmetric) SOR relaxation in place, visiting the rows of each
+        /// color color_rows[color_offset[c]], ..., color_rows[color_offset[c+1]-1] in turn;
+        /// If zero_guess is set, x is set to zero before the first sweep
+        virtual bool SORSweep(int                          num_colors,
+                              const int*                   color_offset,
+                              const BaseVector<int>&       color_rows,
+                              ValueType                    omega,
+                              bool                         symmetric,
+                              bool                         zero_guess,
+                              int                          sweeps,
+                              const BaseVector<ValueType>& rhs,
+                              BaseVector<ValueType>*       x) const;
+
         /// Apply the matrix to vector, out = this*in;
         virtual void Apply(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const = 0;
         /// Apply and add the matrix to vector, out = out + scalar*this*in;
@@ -409,6 +480,15 @@ namespace rocalution
                                  BaseMatrix<ValueType>* prolong,
                                  BaseMatrix<ValueType>* restrict) const;
 
+        /// Ruge Stüben coarsening with given C/F splitting and interpolation
+        virtual bool RugeStueben(ValueType              eps,
+                                 int                    coarsening,
+                                 int                    interpolation,
+                                 bool                   aggressive,
+                                 int                    max_elements,
+                                 BaseMatrix<ValueType>* prolong,
+                                 BaseMatrix<ValueType>* restrict) const;
+
         /// Factorized Sparse Approximate Inverse assembly for given system
         /// matrix power pattern or external sparsity pattern
         virtual bool FSAI(int power, const BaseMatrix<ValueType>* pattern);
@@ -465,7 +545,7 @@ namespace rocalution
         /// Number of columns
         int ncol_;
         /// Number of non-zero elements
-        int nnz_;
+        IndexType2 nnz_;
 
         /// Backend descriptor (local copy)
         Rocalution_Backend_Descriptor local_backend_;
@@ -89,6 +89,43 @@ namespace rocalution
         this->size_ = size;
     }
 
+    template <typename ValueType>
+    bool BaseStencil<ValueType>::SetGrid(int nx, int ny, int nz)
+    {
+        // Only uniform grids are supported by default
+        if((this->ndim_ > 1 && ny != nx) || (this->ndim_ > 2 && nz != nx))
+        {
+            return false;
+        }
+
+        this->SetGrid(nx);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool BaseStencil<ValueType>::SetStencil(int              ndim,
+                                            int              nnz,
+                                            const int*       offset,
+                                            const ValueType* coef)
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseStencil<ValueType>::SetVariableCoefficients(const ValueType* coef)
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseStencil<ValueType>::ApplyPower(const BaseVector<ValueType>& in,
+                                            int                          power,
+                                            BaseVector<ValueType>*       out) const
+    {
+        return false;
+    }
+
     template <typename ValueType>
     HostStencil<ValueType>::HostStencil()
     {
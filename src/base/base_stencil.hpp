@@ -39,6 +39,8 @@ namespace rocalution
     template <typename ValueType>
     class HostStencilLaplace2D;
     template <typename ValueType>
+    class HostStencilGeneral;
+    template <typename ValueType>
     class HIPAcceleratorStencil;
     template <typename ValueType>
     class HIPAcceleratorStencilLaplace2D;
@@ -52,9 +54,9 @@ namespace rocalution
         virtual ~BaseStencil();
 
         /// Return the number of rows in the stencil
-        int GetM(void) const;
+        virtual int GetM(void) const;
         /// Return the number of columns in the stencil
-        int GetN(void) const;
+        virtual int GetN(void) const;
         /// Return the dimension of the stencil
         int GetNDim(void) const;
         /// Return the nnz per row
@@ -68,6 +70,13 @@ namespace rocalution
         virtual void set_backend(const Rocalution_Backend_Descriptor local_backend);
         // Set the grid size
         virtual void SetGrid(int size);
+        /// Set the grid size per dimension, unused dimensions are 1
+        virtual bool SetGrid(int nx, int ny, int nz);
+        /// Set the offsets and (constant) coefficients of a general stencil
+        virtual bool SetStencil(int ndim, int nnz, const int* offset, const ValueType* coef);
+        /// Set grid point dependent coefficients, coef[k * GetM() + i] belongs to entry k
+        /// of row i
+        virtual bool SetVariableCoefficients(const ValueType* coef);
 
         /// Apply the stencil to vector, out = this*in;
         virtual void Apply(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const = 0;
@@ -75,6 +84,9 @@ namespace rocalution
         virtual void ApplyAdd(const BaseVector<ValueType>& in,
                               ValueType                    scalar,
                               BaseVector<ValueType>*       out) const = 0;
+        /// Apply the stencil power times, out = this^power*in;
+        virtual bool
+            ApplyPower(const BaseVector<ValueType>& in, int power, BaseVector<ValueType>* out) const;
 
     protected:
         /// Number of rows
@@ -39,6 +39,7 @@
 #include <complex>
 #include <limits>
 #include <sstream>
+#include <vector>
 
 namespace rocalution
 {
@@ -297,8 +298,6 @@ namespace rocalution
                                           this->pm_->GetLocalSize(),
                                           this->pm_->GetNumReceivers());
 
-        this->matrix_ghost_.ConvertTo(COO);
-
 #ifdef SUPPORT_MULTINODE
         IndexType2 nnz_local;
         IndexType2 nnz_ghost;
@@ -376,6 +375,10 @@ namespace rocalution
                                           this->pm_->GetLocalSize(),
                                           this->pm_->GetNumReceivers());
 
+        // Ghost part is kept in CSR
+        this->matrix_ghost_.Sort();
+        this->matrix_ghost_.ConvertTo(CSR);
+
 #ifdef SUPPORT_MULTINODE
         IndexType2 nnz_local;
         IndexType2 nnz_ghost;
@@ -501,8 +504,6 @@ namespace rocalution
                                           this->pm_->GetLocalSize(),
                                           this->pm_->GetNumReceivers());
 
-        this->matrix_ghost_.ConvertTo(COO);
-
 #ifdef SUPPORT_MULTINODE
         IndexType2 nnz_local;
         IndexType2 nnz_ghost;
@@ -544,8 +545,9 @@ namespace rocalution
                                           this->pm_->GetLocalSize(),
                                           this->pm_->GetNumReceivers());
 
-        // Sort ghost matrix
+        // Sort ghost matrix, ghost part is kept in CSR
         this->matrix_ghost_.Sort();
+        this->matrix_ghost_.ConvertTo(CSR);
 
 #ifdef SUPPORT_MULTINODE
         IndexType2 nnz_local;
@@ -869,8 +871,8 @@ namespace rocalution
 
         this->matrix_interior_.ConvertTo(matrix_format);
 
-        // Ghost part remains COO
-        this->matrix_ghost_.ConvertTo(COO);
+        // Ghost part remains CSR
+        this->matrix_ghost_.ConvertTo(CSR);
     }
 
     template <typename ValueType>
@@ -912,7 +914,13 @@ namespace rocalution
         assert(this->is_host_() == in.is_host_());
         assert(this->is_host_() == out->is_host_());
 
-        FATAL_ERROR(__FILE__, __LINE__);
+        out->UpdateGhostValuesAsync_(in);
+
+        this->matrix_interior_.ApplyAdd(in.vector_interior_, scalar, &out->vector_interior_);
+
+        out->UpdateGhostValuesSync_();
+
+        this->matrix_ghost_.ApplyAdd(out->vector_ghost_, scalar, &out->vector_interior_);
     }
 
     template <typename ValueType>
@@ -958,8 +966,8 @@ namespace rocalution
         this->matrix_interior_.ReadFileMTX(path + interior_name);
         this->matrix_ghost_.ReadFileMTX(path + ghost_name);
 
-        // Convert ghost matrix to COO
-        this->matrix_ghost_.ConvertToCOO();
+        // Convert ghost matrix to CSR
+        this->matrix_ghost_.ConvertToCSR();
 
         this->object_name_ = filename;
 
@@ -1059,8 +1067,8 @@ namespace rocalution
         this->matrix_interior_.ReadFileCSR(path + interior_name);
         this->matrix_ghost_.ReadFileCSR(path + ghost_name);
 
-        // Convert ghost matrix to COO
-        this->matrix_ghost_.ConvertToCOO();
+        // Convert ghost matrix to CSR
+        this->matrix_ghost_.ConvertToCSR();
 
         this->object_name_ = filename;
 
@@ -1117,6 +1125,348 @@ namespace rocalution
         this->matrix_ghost_.WriteFileCSR(ghost_name);
     }
 
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::DistributeFrom(const LocalMatrix<ValueType>& mat,
+                                                 ParallelManager*              pm,
+                                                 LocalVector<int>*             permutation)
+    {
+        log_debug(this, "GlobalMatrix::DistributeFrom()", (const void*&)mat, pm, permutation);
+
+        assert(pm != NULL);
+        assert(pm->comm_ != NULL);
+        assert(permutation != NULL);
+
+#ifdef SUPPORT_MULTINODE
+        int rank      = pm->rank_;
+        int num_procs = pm->num_procs_;
+
+        // Header of the data of each process: global size, local size, interior nnz,
+        // ghost nnz, number of receivers, number of senders and boundary size
+        int              header[7];
+        std::vector<int> idata;
+
+        std::vector<ValueType> vdata;
+
+        if(rank == 0)
+        {
+            assert(mat.GetM() == mat.GetN());
+            assert(mat.GetM() >= num_procs);
+
+            // Partition on the host in CSR format
+            LocalMatrix<ValueType> host;
+            host.CloneFrom(mat);
+            host.MoveToHost();
+            host.ConvertToCSR();
+
+            LocalVector<int> part;
+            host.Partition(num_procs, &part);
+
+            int n = host.GetM();
+
+            int*       row_offset = NULL;
+            int*       col        = NULL;
+            ValueType* val        = NULL;
+
+            host.LeaveDataPtrCSR(&row_offset, &col, &val);
+
+            // First global row of each process
+            std::vector<int> offset(num_procs + 1, 0);
+
+            for(int i = 0; i < n; ++i)
+            {
+                ++offset[part[i] + 1];
+            }
+
+            for(int p = 0; p < num_procs; ++p)
+            {
+                offset[p + 1] += offset[p];
+            }
+
+            // New global index of each row, the rows of a process keep their order
+            std::vector<int> perm(n);
+            std::vector<int> rows(n);
+            std::vector<int> next(offset.begin(), offset.end() - 1);
+
+            for(int i = 0; i < n; ++i)
+            {
+                perm[i]       = next[part[i]]++;
+                rows[perm[i]] = i;
+            }
+
+            permutation->Allocate("Distribution permutation of " + mat.object_name_, n);
+            permutation->CopyFromData(perm.data());
+
+            // Global indices of the ghost values of each process, sorted and therefore
+            // grouped by their owning process
+            std::vector<std::vector<int>> ghost(num_procs);
+
+            // Processes and boundary indices each process sends its boundary to
+            std::vector<std::vector<int>> send_procs(num_procs);
+            std::vector<std::vector<int>> send_offset(num_procs, std::vector<int>(1, 0));
+            std::vector<std::vector<int>> boundary(num_procs);
+
+            std::vector<int> marker(n, -1);
+
+            for(int p = 0; p < num_procs; ++p)
+            {
+                for(int r = offset[p]; r < offset[p + 1]; ++r)
+                {
+                    int i = rows[r];
+
+                    for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+                    {
+                        int c = col[j];
+
+                        if(part[c] != p && marker[c] != p)
+                        {
+                            marker[c] = p;
+                            ghost[p].push_back(perm[c]);
+                        }
+                    }
+                }
+
+                std::sort(ghost[p].begin(), ghost[p].end());
+
+                for(size_t k = 0; k < ghost[p].size(); ++k)
+                {
+                    int q = part[rows[ghost[p][k]]];
+
+                    if(send_procs[q].empty() == true || send_procs[q].back() != p)
+                    {
+                        send_procs[q].push_back(p);
+                        send_offset[q].push_back(send_offset[q].back());
+                    }
+
+                    boundary[q].push_back(ghost[p][k] - offset[q]);
+                    ++send_offset[q].back();
+                }
+            }
+
+            // Position of each ghost value of the current process in its ghost vector
+            std::vector<int> ghost_pos(n);
+
+            // Send the data to all other processes, the root process is last
+            for(int p = num_procs - 1; p >= 0; --p)
+            {
+                int nrow = offset[p + 1] - offset[p];
+
+                std::vector<int> recv_procs;
+                std::vector<int> recv_offset(1, 0);
+
+                for(size_t k = 0; k < ghost[p].size(); ++k)
+                {
+                    int q = part[rows[ghost[p][k]]];
+
+                    if(recv_procs.empty() == true || recv_procs.back() != q)
+                    {
+                        recv_procs.push_back(q);
+                        recv_offset.push_back(recv_offset.back());
+                    }
+
+                    ++recv_offset.back();
+                    ghost_pos[ghost[p][k]] = k;
+                }
+
+                // Split the rows into interior and ghost part
+                std::vector<int> interior_row_offset(nrow + 1, 0);
+                std::vector<int> interior_col;
+                std::vector<int> ghost_row_offset(nrow + 1, 0);
+                std::vector<int> ghost_col;
+
+                std::vector<ValueType> interior_val;
+                std::vector<ValueType> ghost_val;
+
+                for(int r = 0; r < nrow; ++r)
+                {
+                    int i = rows[offset[p] + r];
+
+                    for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+                    {
+                        int c = col[j];
+
+                        if(part[c] == p)
+                        {
+                            interior_col.push_back(perm[c] - offset[p]);
+                            interior_val.push_back(val[j]);
+                        }
+                        else
+                        {
+                            ghost_col.push_back(ghost_pos[perm[c]]);
+                            ghost_val.push_back(val[j]);
+                        }
+                    }
+
+                    interior_row_offset[r + 1] = interior_col.size();
+                    ghost_row_offset[r + 1]    = ghost_col.size();
+                }
+
+                header[0] = n;
+                header[1] = nrow;
+                header[2] = interior_col.size();
+                header[3] = ghost_col.size();
+                header[4] = recv_procs.size();
+                header[5] = send_procs[p].size();
+                header[6] = boundary[p].size();
+
+                idata.clear();
+                idata.insert(idata.end(), interior_row_offset.begin(), interior_row_offset.end());
+                idata.insert(idata.end(), interior_col.begin(), interior_col.end());
+                idata.insert(idata.end(), ghost_row_offset.begin(), ghost_row_offset.end());
+                idata.insert(idata.end(), ghost_col.begin(), ghost_col.end());
+                idata.insert(idata.end(), recv_procs.begin(), recv_procs.end());
+                idata.insert(idata.end(), recv_offset.begin(), recv_offset.end());
+                idata.insert(idata.end(), send_procs[p].begin(), send_procs[p].end());
+                idata.insert(idata.end(), send_offset[p].begin(), send_offset[p].end());
+                idata.insert(idata.end(), boundary[p].begin(), boundary[p].end());
+
+                vdata.clear();
+                vdata.insert(vdata.end(), interior_val.begin(), interior_val.end());
+                vdata.insert(vdata.end(), ghost_val.begin(), ghost_val.end());
+
+                if(p > 0)
+                {
+                    MRequest req[3];
+
+                    communication_async_send(header, 7, p, 0, &req[0], pm->comm_);
+                    communication_async_send(idata.data(), idata.size(), p, 0, &req[1], pm->comm_);
+                    communication_async_send(vdata.data(), vdata.size(), p, 0, &req[2], pm->comm_);
+
+                    communication_syncall(3, req);
+                }
+            }
+
+            free_host(&row_offset);
+            free_host(&col);
+            free_host(&val);
+        }
+        else
+        {
+            MRequest req[2];
+
+            communication_async_recv(header, 7, 0, 0, &req[0], pm->comm_);
+            communication_syncall(1, req);
+
+            idata.resize(2 * header[1] + header[2] + header[3] + 2 * header[4] + 2 * header[5]
+                         + header[6] + 4);
+            vdata.resize(header[2] + header[3]);
+
+            communication_async_recv(idata.data(), idata.size(), 0, 0, &req[0], pm->comm_);
+            communication_async_recv(vdata.data(), vdata.size(), 0, 0, &req[1], pm->comm_);
+            communication_syncall(2, req);
+        }
+
+        int nrow          = header[1];
+        int interior_nnz  = header[2];
+        int ghost_nnz     = header[3];
+        int nrecv         = header[4];
+        int nsend         = header[5];
+        int boundary_size = header[6];
+
+        const int* interior_row_offset = idata.data();
+        const int* interior_col        = interior_row_offset + nrow + 1;
+        const int* ghost_row_offset    = interior_col + interior_nnz;
+        const int* ghost_col           = ghost_row_offset + nrow + 1;
+        const int* recv_procs          = ghost_col + ghost_nnz;
+        const int* recv_offset         = recv_procs + nrecv;
+        const int* send_procs          = recv_offset + nrecv + 1;
+        const int* send_offset         = send_procs + nsend;
+        const int* boundary            = send_offset + nsend + 1;
+
+        // Parallel manager
+        pm->Clear();
+        pm->SetGlobalSize(header[0]);
+        pm->SetLocalSize(nrow);
+
+        if(boundary_size > 0)
+        {
+            pm->SetBoundaryIndex(boundary_size, boundary);
+        }
+
+        if(nrecv > 0)
+        {
+            pm->SetReceivers(nrecv, recv_procs, recv_offset);
+        }
+
+        if(nsend > 0)
+        {
+            pm->SetSenders(nsend, send_procs, send_offset);
+        }
+
+        // Matrix
+        this->Clear();
+        this->SetParallelManager(*pm);
+
+        int*       local_row_offset = NULL;
+        int*       local_col        = NULL;
+        ValueType* local_val        = NULL;
+
+        allocate_host(nrow + 1, &local_row_offset);
+        allocate_host(interior_nnz, &local_col);
+        allocate_host(interior_nnz, &local_val);
+
+        for(int i = 0; i < nrow + 1; ++i)
+        {
+            local_row_offset[i] = interior_row_offset[i];
+        }
+
+        for(int i = 0; i < interior_nnz; ++i)
+        {
+            local_col[i] = interior_col[i];
+            local_val[i] = vdata[i];
+        }
+
+        this->matrix_interior_.SetDataPtrCSR(&local_row_offset,
+                                             &local_col,
+                                             &local_val,
+                                             "Interior of " + this->object_name_,
+                                             interior_nnz,
+                                             nrow,
+                                             nrow);
+
+        if(ghost_nnz > 0)
+        {
+            int*       ghost_row_offset_ptr = NULL;
+            int*       ghost_col_ptr        = NULL;
+            ValueType* ghost_val_ptr        = NULL;
+
+            allocate_host(nrow + 1, &ghost_row_offset_ptr);
+            allocate_host(ghost_nnz, &ghost_col_ptr);
+            allocate_host(ghost_nnz, &ghost_val_ptr);
+
+            for(int i = 0; i < nrow + 1; ++i)
+            {
+                ghost_row_offset_ptr[i] = ghost_row_offset[i];
+            }
+
+            for(int i = 0; i < ghost_nnz; ++i)
+            {
+                ghost_col_ptr[i] = ghost_col[i];
+                ghost_val_ptr[i] = vdata[interior_nnz + i];
+            }
+
+            this->matrix_ghost_.SetDataPtrCSR(&ghost_row_offset_ptr,
+                                              &ghost_col_ptr,
+                                              &ghost_val_ptr,
+                                              "Ghost of " + this->object_name_,
+                                              ghost_nnz,
+                                              nrow,
+                                              pm->GetNumReceivers());
+
+            this->matrix_ghost_.Sort();
+        }
+
+        IndexType2 nnz_local;
+        IndexType2 nnz_ghost;
+
+        communication_allreduce_single_sum(
+            this->matrix_interior_.GetNnz(), &nnz_local, this->pm_->comm_);
+        communication_allreduce_single_sum(
+            this->matrix_ghost_.GetNnz(), &nnz_ghost, this->pm_->comm_);
+
+        this->nnz_ = nnz_local + nnz_ghost;
+#endif
+    }
+
     template <typename ValueType>
     void
         GlobalMatrix<ValueType>::ExtractInverseDiagonal(GlobalVector<ValueType>* vec_inv_diag) const
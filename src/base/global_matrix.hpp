@@ -179,6 +179,50 @@ namespace rocalution
                               ValueType                      scalar,
                               GlobalVector<ValueType>*       out) const;
 
+        /** \brief Distribute a matrix from the root process to all processes
+      * \details
+      * The matrix \p mat, which is only accessed on the root process (rank 0), is
+      * partitioned with LocalMatrix::Partition() into one part per process, such that
+      * few entries couple different processes. The rows of each part are renumbered
+      * contiguously, sent to their process and split into interior and ghost part. The
+      * parallel manager \p pm, which needs to have the MPI communicator set, is set up
+      * with the sizes, the boundary and the receivers and senders of each process.
+      * Thus, only the root process needs to read or assemble the matrix, e.g. from a
+      * single file.
+      *
+      * @param[in]
+      * mat         matrix to distribute, only accessed on the root process
+      * @param[out]
+      * pm          parallel manager of the distributed matrix
+      * @param[out]
+      * permutation new global index of each row of \p mat, only set on the root process
+      *
+      * \par Example
+      * \code{.cpp}
+      *   ParallelManager pm;
+      *   pm.SetMPICommunicator(&comm);
+      *
+      *   LocalMatrix<ValueType> lmat;
+      *   LocalVector<ValueType> lrhs;
+      *   LocalVector<int> perm;
+      *
+      *   if(rank == 0)
+      *   {
+      *       lmat.ReadFileMTX("matrix.mtx");
+      *       lrhs.ReadFileASCII("rhs.dat");
+      *   }
+      *
+      *   GlobalMatrix<ValueType> mat;
+      *   mat.DistributeFrom(lmat, &pm, &perm);
+      *
+      *   GlobalVector<ValueType> rhs(pm);
+      *   rhs.DistributeFrom(lrhs, perm);
+      * \endcode
+      */
+        void DistributeFrom(const LocalMatrix<ValueType>& mat,
+                            ParallelManager*              pm,
+                            LocalVector<int>*             permutation);
+
         /** \brief Read matrix from MTX (Matrix Market Format) file */
         void ReadFileMTX(const std::string filename);
         /** \brief Write matrix to MTX (Matrix Market Format) file */
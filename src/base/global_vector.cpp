@@ -37,6 +37,7 @@
 #include <limits>
 #include <math.h>
 #include <sstream>
+#include <vector>
 
 namespace rocalution
 {
@@ -204,8 +205,11 @@ namespace rocalution
         this->vector_interior_.Allocate(interior_name, this->pm_->GetLocalSize());
         this->vector_ghost_.Allocate(ghost_name, this->pm_->GetNumReceivers());
 
-        this->vector_interior_.SetIndexArray(this->pm_->GetNumSenders(),
-                                             this->pm_->boundary_index_);
+        if(this->pm_->GetNumSenders() > 0)
+        {
+            this->vector_interior_.SetIndexArray(this->pm_->GetNumSenders(),
+                                                 this->pm_->boundary_index_);
+        }
 
         // Allocate send and receive buffer
         allocate_host(this->pm_->GetNumReceivers(), &this->recv_boundary_);
@@ -269,8 +273,11 @@ namespace rocalution
         this->vector_interior_.SetDataPtr(ptr, interior_name, this->pm_->local_size_);
         this->vector_ghost_.Allocate(ghost_name, this->pm_->GetNumReceivers());
 
-        this->vector_interior_.SetIndexArray(this->pm_->GetNumSenders(),
-                                             this->pm_->boundary_index_);
+        if(this->pm_->GetNumSenders() > 0)
+        {
+            this->vector_interior_.SetIndexArray(this->pm_->GetNumSenders(),
+                                                 this->pm_->boundary_index_);
+        }
 
         // Allocate send and receive buffer
         allocate_host(this->pm_->GetNumReceivers(), &this->recv_boundary_);
@@ -299,7 +306,7 @@ namespace rocalution
     {
         log_debug(this, "GlobalVector::SetRandomUniform()", seed, a, b);
 
-        this->vector_interior_.SetRandomUniform(seed, a, b);
+        this->vector_interior_.SetRandomUniform_(seed, this->GlobalOffset_(), a, b);
     }
 
     template <typename ValueType>
@@ -309,7 +316,23 @@ namespace rocalution
     {
         log_debug(this, "GlobalVector::SetRandomNormal()", seed, mean, var);
 
-        this->vector_interior_.SetRandomUniform(seed, mean, var);
+        this->vector_interior_.SetRandomNormal_(seed, this->GlobalOffset_(), mean, var);
+    }
+
+    template <typename ValueType>
+    IndexType2 GlobalVector<ValueType>::GlobalOffset_(void) const
+    {
+        IndexType2 offset = 0;
+
+#ifdef SUPPORT_MULTINODE
+        assert(this->pm_ != NULL);
+
+        // Global index of the first interior entry, processes own consecutive ranges
+        IndexType2 local_size = this->vector_interior_.GetSize();
+        communication_exscan_single_sum(local_size, &offset, this->pm_->comm_);
+#endif
+
+        return offset;
     }
 
     template <typename ValueType>
@@ -319,12 +342,86 @@ namespace rocalution
 
         assert(this != &src);
         assert(this->pm_ == src.pm_);
-        assert(this->recv_boundary_ != NULL);
-        assert(this->send_boundary_ != NULL);
+        assert(this->recv_boundary_ != NULL || this->pm_->GetNumReceivers() == 0);
+        assert(this->send_boundary_ != NULL || this->pm_->GetNumSenders() == 0);
 
         this->vector_interior_.CopyFrom(src.vector_interior_);
     }
 
+    template <typename ValueType>
+    void GlobalVector<ValueType>::DistributeFrom(const LocalVector<ValueType>& vec,
+                                                 const LocalVector<int>&       permutation)
+    {
+        log_debug(
+            this, "GlobalVector::DistributeFrom()", (const void*&)vec, (const void*&)permutation);
+
+        assert(this->pm_ != NULL);
+        assert(this->pm_->Status() == true);
+
+        this->Clear();
+        this->Allocate(this->object_name_, this->pm_->global_size_);
+
+#ifdef SUPPORT_MULTINODE
+        int rank       = this->pm_->rank_;
+        int num_procs  = this->pm_->num_procs_;
+        int local_size = this->pm_->local_size_;
+
+        std::vector<ValueType> data;
+        std::vector<MRequest>  req(num_procs);
+
+        if(rank == 0)
+        {
+            assert(vec.GetSize() == this->pm_->global_size_);
+            assert(permutation.GetSize() == vec.GetSize());
+
+            // Local sizes of all processes
+            std::vector<int> local_sizes(num_procs, local_size);
+
+            for(int p = 1; p < num_procs; ++p)
+            {
+                communication_async_recv(&local_sizes[p], 1, p, 0, &req[p - 1], this->pm_->comm_);
+            }
+
+            // Reorder on the host, such that the data of each process is contiguous
+            LocalVector<ValueType> host;
+            LocalVector<int>       perm;
+
+            host.CloneFrom(vec);
+            host.MoveToHost();
+            perm.CloneFrom(permutation);
+            perm.MoveToHost();
+
+            host.Permute(perm);
+
+            data.resize(vec.GetSize());
+            host.CopyToData(data.data());
+
+            communication_syncall(num_procs - 1, &req[0]);
+
+            int offset = local_size;
+            for(int p = 1; p < num_procs; ++p)
+            {
+                communication_async_send(
+                    data.data() + offset, local_sizes[p], p, 0, &req[p - 1], this->pm_->comm_);
+
+                offset += local_sizes[p];
+            }
+
+            communication_syncall(num_procs - 1, &req[0]);
+        }
+        else
+        {
+            data.resize(local_size);
+
+            communication_async_send(&local_size, 1, 0, 0, &req[0], this->pm_->comm_);
+            communication_async_recv(data.data(), local_size, 0, 0, &req[1], this->pm_->comm_);
+            communication_syncall(2, &req[0]);
+        }
+
+        this->vector_interior_.CopyFromData(data.data());
+#endif
+    }
+
     template <typename ValueType>
     void GlobalVector<ValueType>::CloneFrom(const GlobalVector<ValueType>& src)
     {
@@ -462,8 +559,11 @@ namespace rocalution
 
         this->object_name_ = filename;
 
-        this->vector_interior_.SetIndexArray(this->pm_->GetNumSenders(),
-                                             this->pm_->boundary_index_);
+        if(this->pm_->GetNumSenders() > 0)
+        {
+            this->vector_interior_.SetIndexArray(this->pm_->GetNumSenders(),
+                                                 this->pm_->boundary_index_);
+        }
 
         // Allocate ghost vector
         this->vector_ghost_.Allocate("ghost", this->pm_->GetNumReceivers());
@@ -558,8 +658,11 @@ namespace rocalution
 
         this->object_name_ = filename;
 
-        this->vector_interior_.SetIndexArray(this->pm_->GetNumSenders(),
-                                             this->pm_->boundary_index_);
+        if(this->pm_->GetNumSenders() > 0)
+        {
+            this->vector_interior_.SetIndexArray(this->pm_->GetNumSenders(),
+                                                 this->pm_->boundary_index_);
+        }
 
         // Allocate ghost vector
         this->vector_ghost_.Allocate("ghost", this->pm_->GetNumReceivers());
@@ -787,7 +890,10 @@ namespace rocalution
         }
 
         // prepare send buffer
-        in.vector_interior_.GetIndexValues(this->send_boundary_);
+        if(this->pm_->GetNumSenders() > 0)
+        {
+            in.vector_interior_.GetIndexValues(this->send_boundary_);
+        }
 
         // async send boundary to neighbors
         for(int i = 0; i < this->pm_->nsend_; ++i)
@@ -822,8 +928,11 @@ namespace rocalution
         communication_syncall(this->pm_->nrecv_, this->recv_event_);
         communication_syncall(this->pm_->nsend_, this->send_event_);
 
-        this->vector_ghost_.SetContinuousValues(
-            0, this->pm_->GetNumReceivers(), this->recv_boundary_);
+        if(this->pm_->GetNumReceivers() > 0)
+        {
+            this->vector_ghost_.SetContinuousValues(
+                0, this->pm_->GetNumReceivers(), this->recv_boundary_);
+        }
 #endif
 
         log_debug(this, "GlobalVector::UpdateGhostValuesSync_()", "#*# end");
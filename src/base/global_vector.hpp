@@ -37,6 +37,8 @@ namespace rocalution
     class LocalMatrix;
     template <typename ValueType>
     class GlobalMatrix;
+    template <typename ValueType>
+    class ReductionBatch;
     struct MRequest;
 
     /** \ingroup op_vec_module
@@ -108,6 +110,23 @@ namespace rocalution
         void LeaveDataPtr(ValueType** ptr);
 
         virtual void CopyFrom(const GlobalVector<ValueType>& src);
+
+        /** \brief Distribute a vector from the root process to all processes
+      * \details
+      * The vector \p vec, which is only accessed on the root process (rank 0), is
+      * reordered by \p permutation and its parts are sent to their processes. The global
+      * vector needs to be initialized with the parallel manager and the permutation that
+      * were set up by GlobalMatrix::DistributeFrom().
+      *
+      * @param[in]
+      * vec         vector to distribute, only accessed on the root process
+      * @param[in]
+      * permutation permutation from GlobalMatrix::DistributeFrom(), only accessed on the
+      *             root process
+      */
+        void DistributeFrom(const LocalVector<ValueType>& vec,
+                            const LocalVector<int>&       permutation);
+
         virtual void ReadFileASCII(const std::string filename);
         virtual void WriteFileASCII(const std::string filename) const;
         virtual void ReadFileBinary(const std::string filename);
@@ -150,6 +169,9 @@ namespace rocalution
         /** \brief Update ghost values synchronously */
         void UpdateGhostValuesSync_(void);
 
+        /** \brief Global index of the first interior entry */
+        IndexType2 GlobalOffset_(void) const;
+
     private:
         MRequest* recv_event_;
         MRequest* send_event_;
@@ -162,6 +184,7 @@ namespace rocalution
 
         friend class LocalMatrix<ValueType>;
         friend class GlobalMatrix<ValueType>;
+        friend class ReductionBatch<ValueType>;
 
         friend class BaseRocalution<ValueType>;
     };
@@ -40,6 +40,7 @@
 
 #include <algorithm>
 #include <hip/hip_runtime.h>
+#include <limits>
 #include <rocsparse.h>
 
 namespace rocalution
@@ -102,9 +103,10 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void HIPAcceleratorMatrixCOO<ValueType>::AllocateCOO(int nnz, int nrow, int ncol)
+    void HIPAcceleratorMatrixCOO<ValueType>::AllocateCOO(IndexType2 nnz, int nrow, int ncol)
     {
         assert(nnz >= 0);
+        assert(nnz <= std::numeric_limits<int>::max());
         assert(ncol >= 0);
         assert(nrow >= 0);
 
@@ -125,18 +127,19 @@ namespace rocalution
 
             this->nrow_ = nrow;
             this->ncol_ = ncol;
-            this->nnz_  = nnz;
+            this->nnz_  = static_cast<int>(nnz);
         }
     }
 
     template <typename ValueType>
     void HIPAcceleratorMatrixCOO<ValueType>::SetDataPtrCOO(
-        int** row, int** col, ValueType** val, int nnz, int nrow, int ncol)
+        int** row, int** col, ValueType** val, IndexType2 nnz, int nrow, int ncol)
     {
         assert(*row != NULL);
         assert(*col != NULL);
         assert(*val != NULL);
         assert(nnz > 0);
+        assert(nnz <= std::numeric_limits<int>::max());
         assert(nrow > 0);
         assert(ncol > 0);
 
@@ -144,7 +147,7 @@ namespace rocalution
 
         this->nrow_ = nrow;
         this->ncol_ = ncol;
-        this->nnz_  = nnz;
+        this->nnz_  = static_cast<int>(nnz);
 
         hipDeviceSynchronize();
 
@@ -707,7 +710,7 @@ namespace rocalution
             this->Clear();
 
             if(csr_to_coo_hip(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                              cast_mat_csr->nnz_,
+                              static_cast<int>(cast_mat_csr->nnz_),
                               cast_mat_csr->nrow_,
                               cast_mat_csr->ncol_,
                               cast_mat_csr->mat_,
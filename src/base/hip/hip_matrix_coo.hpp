@@ -48,10 +48,10 @@ namespace rocalution
         }
 
         virtual void Clear(void);
-        virtual void AllocateCOO(int nnz, int nrow, int ncol);
+        virtual void AllocateCOO(IndexType2 nnz, int nrow, int ncol);
 
-        virtual void
-                     SetDataPtrCOO(int** row, int** col, ValueType** val, int nnz, int nrow, int ncol);
+        virtual void SetDataPtrCOO(
+            int** row, int** col, ValueType** val, IndexType2 nnz, int nrow, int ncol);
         virtual void LeaveDataPtrCOO(int** row, int** col, ValueType** val);
 
         virtual bool ConvertFrom(const BaseMatrix<ValueType>& mat);
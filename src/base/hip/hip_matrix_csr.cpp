@@ -60,6 +60,7 @@
 
 #include "hip_sparse.hpp"
 
+#include <limits>
 #include <vector>
 
 #include <rocprim/rocprim.hpp>
@@ -141,9 +142,10 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::AllocateCSR(int nnz, int nrow, int ncol)
+    void HIPAcceleratorMatrixCSR<ValueType>::AllocateCSR(IndexType2 nnz, int nrow, int ncol)
     {
         assert(nnz >= 0);
+        assert(nnz <= std::numeric_limits<int>::max());
         assert(ncol >= 0);
         assert(nrow >= 0);
 
@@ -164,7 +166,7 @@ namespace rocalution
 
             this->nrow_ = nrow;
             this->ncol_ = ncol;
-            this->nnz_  = nnz;
+            this->nnz_  = static_cast<int>(nnz);
         }
     }
 
@@ -781,7 +783,7 @@ namespace rocalution
             this->Clear();
 
             if(coo_to_csr_hip(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                              cast_mat_coo->nnz_,
+                              static_cast<int>(cast_mat_coo->nnz_),
                               cast_mat_coo->nrow_,
                               cast_mat_coo->ncol_,
                               cast_mat_coo->mat_,
@@ -805,7 +807,7 @@ namespace rocalution
             int nnz;
 
             if(ell_to_csr_hip(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                              cast_mat_ell->nnz_,
+                              static_cast<int>(cast_mat_ell->nnz_),
                               cast_mat_ell->nrow_,
                               cast_mat_ell->ncol_,
                               cast_mat_ell->mat_,
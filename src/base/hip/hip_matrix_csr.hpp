@@ -50,7 +50,7 @@ namespace rocalution
         virtual void Clear(void);
         virtual bool Zeros(void);
 
-        virtual void AllocateCSR(int nnz, int nrow, int ncol);
+        virtual void AllocateCSR(IndexType2 nnz, int nrow, int ncol);
         virtual void SetDataPtrCSR(
             int** row_offset, int** col, ValueType** val, int nnz, int nrow, int ncol);
         virtual void LeaveDataPtrCSR(int** row_offset, int** col, ValueType** val);
@@ -631,7 +631,7 @@ namespace rocalution
             int num_diag;
 
             if(csr_to_dia_hip(this->local_backend_.HIP_block_size,
-                              cast_mat_csr->nnz_,
+                              static_cast<int>(cast_mat_csr->nnz_),
                               cast_mat_csr->nrow_,
                               cast_mat_csr->ncol_,
                               cast_mat_csr->mat_,
@@ -628,7 +628,7 @@ namespace rocalution
             int ell_nnz;
 
             if(csr_to_ell_hip(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                              cast_mat_csr->nnz_,
+                              static_cast<int>(cast_mat_csr->nnz_),
                               cast_mat_csr->nrow_,
                               cast_mat_csr->ncol_,
                               cast_mat_csr->mat_,
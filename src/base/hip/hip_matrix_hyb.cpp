@@ -847,7 +847,7 @@ namespace rocalution
             int nnz_coo;
 
             if(csr_to_hyb_hip(this->local_backend_.HIP_block_size,
-                              cast_mat_csr->nnz_,
+                              static_cast<int>(cast_mat_csr->nnz_),
                               cast_mat_csr->nrow_,
                               cast_mat_csr->ncol_,
                               cast_mat_csr->mat_,
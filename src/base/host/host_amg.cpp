@@ -0,0 +1,1153 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "host_amg.hpp"
+#include "../../utils/def.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_set_num_threads(num) ;
+#endif
+
+namespace rocalution
+{
+
+    // Number of consecutive points that are split by the classical first pass in HMIS
+    static const int hmis_block_size = 4096;
+
+    // Number of consecutive nodes that are visited by the greedy pass of the independent set
+    static const int mis_block_size = 4096;
+
+    // Number of consecutive nodes that are matched greedily in the pairwise matching
+    static const int pairwise_block_size = 4096;
+
+    // Hash of a point index, the random part of the PMIS measure
+    static inline unsigned int hash_point(unsigned int x)
+    {
+        x ^= x >> 16;
+        x *= 0x7feb352dU;
+        x ^= x >> 15;
+        x *= 0x846ca68bU;
+        x ^= x >> 16;
+
+        return x;
+    }
+
+    void graph_transpose(int               n,
+                         const int*        ptr,
+                         const int*        col,
+                         std::vector<int>* t_ptr,
+                         std::vector<int>* t_col)
+    {
+        assert(t_ptr != NULL);
+        assert(t_col != NULL);
+
+        t_ptr->assign(n + 1, 0);
+        t_col->resize(ptr[n]);
+
+        std::vector<int>& tp = *t_ptr;
+
+        for(int j = 0; j < ptr[n]; ++j)
+        {
+            ++tp[col[j] + 1];
+        }
+
+        for(int i = 0; i < n; ++i)
+        {
+            tp[i + 1] += tp[i];
+        }
+
+        std::vector<int> pos(tp.begin(), tp.end() - 1);
+
+        for(int i = 0; i < n; ++i)
+        {
+            for(int j = ptr[i]; j < ptr[i + 1]; ++j)
+            {
+                (*t_col)[pos[col[j]]++] = i;
+            }
+        }
+    }
+
+    void rs_strength_power2(int               omp_threads,
+                            int               n,
+                            const int*        S_ptr,
+                            const int*        S_col,
+                            std::vector<int>* S2_ptr,
+                            std::vector<int>* S2_col)
+    {
+        assert(S2_ptr != NULL);
+        assert(S2_col != NULL);
+
+        omp_set_num_threads(omp_threads);
+
+        S2_ptr->assign(n + 1, 0);
+
+        std::vector<int>& ptr = *S2_ptr;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            // marker[j] == i if j is already part of row i
+            std::vector<int> marker(n, -1);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+            for(int i = 0; i < n; ++i)
+            {
+                int count = 0;
+                marker[i] = i;
+
+                for(int j = S_ptr[i]; j < S_ptr[i + 1]; ++j)
+                {
+                    int k = S_col[j];
+
+                    if(marker[k] != i)
+                    {
+                        marker[k] = i;
+                        ++count;
+                    }
+
+                    for(int jj = S_ptr[k]; jj < S_ptr[k + 1]; ++jj)
+                    {
+                        int l = S_col[jj];
+
+                        if(marker[l] != i)
+                        {
+                            marker[l] = i;
+                            ++count;
+                        }
+                    }
+                }
+
+                ptr[i + 1] = count;
+            }
+        }
+
+        for(int i = 0; i < n; ++i)
+        {
+            ptr[i + 1] += ptr[i];
+        }
+
+        S2_col->resize(ptr[n]);
+
+        int* col = S2_col->data();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<int> marker(n, -1);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+            for(int i = 0; i < n; ++i)
+            {
+                int idx   = ptr[i];
+                marker[i] = i;
+
+                for(int j = S_ptr[i]; j < S_ptr[i + 1]; ++j)
+                {
+                    int k = S_col[j];
+
+                    if(marker[k] != i)
+                    {
+                        marker[k]  = i;
+                        col[idx++] = k;
+                    }
+
+                    for(int jj = S_ptr[k]; jj < S_ptr[k + 1]; ++jj)
+                    {
+                        int l = S_col[jj];
+
+                        if(marker[l] != i)
+                        {
+                            marker[l]  = i;
+                            col[idx++] = l;
+                        }
+                    }
+                }
+
+                assert(idx == ptr[i + 1]);
+            }
+        }
+    }
+
+    // Modified and adopted from AMGCL,
+    // https://github.com/ddemidov/amgcl
+    // MIT License
+    // ----------------------------------------------------------
+    // CHANGELOG
+    // - adopted interface
+    // - restricted to a subgraph
+    // ----------------------------------------------------------
+    void rs_classical_split(int        begin,
+                            int        end,
+                            const int* S_ptr,
+                            const int* S_col,
+                            const int* ST_ptr,
+                            const int* ST_col,
+                            bool       coarsen_remaining,
+                            int*       cf)
+    {
+        int n = end - begin;
+
+        // Measure of each (local) point, decided points that depend on it count twice
+        std::vector<int> lambda(n);
+
+        int lam_max = 0;
+
+        for(int i = 0; i < n; ++i)
+        {
+            int temp = 0;
+            for(int j = ST_ptr[begin + i]; j < ST_ptr[begin + i + 1]; ++j)
+            {
+                int c = ST_col[j];
+
+                if(c < begin || c >= end)
+                {
+                    continue;
+                }
+
+                temp += (cf[c] == -1 ? 1 : 2);
+            }
+
+            lambda[i] = temp;
+            lam_max   = std::max(lam_max, temp);
+        }
+
+        int nbucket = std::max(n, lam_max + 1);
+
+        std::vector<int> ptr(nbucket + 1, static_cast<int>(0));
+        std::vector<int> cnt(nbucket, static_cast<int>(0));
+        std::vector<int> i2n(n);
+        std::vector<int> n2i(n);
+
+        for(int i = 0; i < n; ++i)
+        {
+            ptr[lambda[i] + 1]++;
+        }
+
+        for(unsigned int i = 1; i < ptr.size(); ++i)
+        {
+            ptr[i] += ptr[i - 1];
+        }
+
+        for(int i = 0; i < n; ++i)
+        {
+            int lam  = lambda[i];
+            int idx  = ptr[lam] + cnt[lam]++;
+            i2n[idx] = i;
+            n2i[i]   = idx;
+        }
+
+        for(int top = n - 1; top >= 0; --top)
+        {
+            int i   = i2n[top];
+            int lam = lambda[i];
+
+            if(lam == 0)
+            {
+                if(coarsen_remaining == true)
+                {
+                    for(int ai = begin; ai < end; ++ai)
+                    {
+                        if(cf[ai] == -1)
+                        {
+                            cf[ai] = 1;
+                        }
+                    }
+                }
+
+                break;
+            }
+
+            cnt[lam]--;
+
+            if(cf[begin + i] != -1)
+            {
+                continue;
+            }
+
+            cf[begin + i] = 1;
+
+            for(int j = ST_ptr[begin + i]; j < ST_ptr[begin + i + 1]; ++j)
+            {
+                int c = ST_col[j];
+
+                if(c < begin || c >= end || cf[c] != -1)
+                {
+                    continue;
+                }
+
+                cf[c] = 0;
+
+                for(int jj = S_ptr[c]; jj < S_ptr[c + 1]; ++jj)
+                {
+                    int cc = S_col[jj];
+
+                    if(cc < begin || cc >= end)
+                    {
+                        continue;
+                    }
+
+                    int lcc    = cc - begin;
+                    int lam_cc = lambda[lcc];
+
+                    if(cf[cc] != -1 || lam_cc >= n - 1)
+                    {
+                        continue;
+                    }
+
+                    int old_pos = n2i[lcc];
+                    int new_pos = ptr[lam_cc] + cnt[lam_cc] - 1;
+
+                    n2i[i2n[old_pos]] = new_pos;
+                    n2i[i2n[new_pos]] = old_pos;
+
+                    std::swap(i2n[old_pos], i2n[new_pos]);
+
+                    --cnt[lam_cc];
+                    ++cnt[lam_cc + 1];
+                    ptr[lam_cc + 1] = ptr[lam_cc] + cnt[lam_cc];
+
+                    ++lambda[lcc];
+                }
+            }
+
+            for(int j = S_ptr[begin + i]; j < S_ptr[begin + i + 1]; ++j)
+            {
+                int c = S_col[j];
+
+                if(c < begin || c >= end)
+                {
+                    continue;
+                }
+
+                int lc  = c - begin;
+                int lam = lambda[lc];
+
+                if(cf[c] != -1 || lam == 0)
+                {
+                    continue;
+                }
+
+                int old_pos = n2i[lc];
+                int new_pos = ptr[lam];
+
+                n2i[i2n[old_pos]] = new_pos;
+                n2i[i2n[new_pos]] = old_pos;
+
+                std::swap(i2n[old_pos], i2n[new_pos]);
+
+                --cnt[lam];
+                ++cnt[lam - 1];
+                ++ptr[lam];
+                --lambda[lc];
+
+                assert(ptr[lam - 1] == ptr[lam] - cnt[lam - 1]);
+            }
+        }
+    }
+
+    void rs_pmis_split(int        omp_threads,
+                       int        n,
+                       const int* S_ptr,
+                       const int* S_col,
+                       const int* ST_ptr,
+                       const int* ST_col,
+                       int*       cf)
+    {
+        omp_set_num_threads(omp_threads);
+
+        // Number of points that strongly depend on a point plus a random number in [0, 1)
+        std::vector<double> measure(n);
+        // State of the undecided points after the current step
+        std::vector<int> state(cf, cf + n);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < n; ++i)
+        {
+            measure[i] = static_cast<double>(ST_ptr[i + 1] - ST_ptr[i])
+                         + static_cast<double>(hash_point(i)) / 4294967296.0;
+        }
+
+        // Points that no other point depends on and points that depend on a C point
+        // become F points
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(int i = 0; i < n; ++i)
+        {
+            if(cf[i] != -1)
+            {
+                continue;
+            }
+
+            if(ST_ptr[i + 1] == ST_ptr[i])
+            {
+                state[i] = 0;
+                continue;
+            }
+
+            for(int j = S_ptr[i]; j < S_ptr[i + 1]; ++j)
+            {
+                if(cf[S_col[j]] == 1)
+                {
+                    state[i] = 0;
+                    break;
+                }
+            }
+        }
+
+        std::vector<int> undecided;
+
+        for(int i = 0; i < n; ++i)
+        {
+            cf[i] = state[i];
+
+            if(cf[i] == -1)
+            {
+                undecided.push_back(i);
+            }
+        }
+
+        while(undecided.empty() == false)
+        {
+            int size = undecided.size();
+
+            // Points of maximal measure among their undecided neighbours become C points,
+            // ties are broken by the point index
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+            for(int k = 0; k < size; ++k)
+            {
+                int    i = undecided[k];
+                double m = measure[i];
+
+                state[k] = 1;
+
+                for(int j = S_ptr[i]; j < S_ptr[i + 1] && state[k] == 1; ++j)
+                {
+                    int c = S_col[j];
+
+                    if(cf[c] == -1 && (measure[c] > m || (measure[c] == m && c > i)))
+                    {
+                        state[k] = -1;
+                    }
+                }
+
+                for(int j = ST_ptr[i]; j < ST_ptr[i + 1] && state[k] == 1; ++j)
+                {
+                    int c = ST_col[j];
+
+                    if(cf[c] == -1 && (measure[c] > m || (measure[c] == m && c > i)))
+                    {
+                        state[k] = -1;
+                    }
+                }
+            }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int k = 0; k < size; ++k)
+            {
+                if(state[k] == 1)
+                {
+                    cf[undecided[k]] = 1;
+                }
+            }
+
+            // Undecided points that depend on a new C point become F points
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+            for(int k = 0; k < size; ++k)
+            {
+                if(state[k] == 1)
+                {
+                    continue;
+                }
+
+                int i = undecided[k];
+
+                for(int j = S_ptr[i]; j < S_ptr[i + 1]; ++j)
+                {
+                    if(cf[S_col[j]] == 1)
+                    {
+                        state[k] = 0;
+                        break;
+                    }
+                }
+            }
+
+            int next = 0;
+
+            for(int k = 0; k < size; ++k)
+            {
+                int i = undecided[k];
+
+                if(state[k] == 0)
+                {
+                    cf[i] = 0;
+                }
+                else if(state[k] == -1)
+                {
+                    undecided[next++] = i;
+                }
+            }
+
+            undecided.resize(next);
+        }
+    }
+
+    void rs_hmis_split(int        omp_threads,
+                       int        n,
+                       const int* S_ptr,
+                       const int* S_col,
+                       const int* ST_ptr,
+                       const int* ST_col,
+                       int*       cf)
+    {
+        omp_set_num_threads(omp_threads);
+
+        int nblocks = (n + hmis_block_size - 1) / hmis_block_size;
+
+        // Classical first pass on each block, points that do not depend on a C point of
+        // their block are left undecided
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for(int b = 0; b < nblocks; ++b)
+        {
+            rs_classical_split(b * hmis_block_size,
+                               std::min(n, (b + 1) * hmis_block_size),
+                               S_ptr,
+                               S_col,
+                               ST_ptr,
+                               ST_col,
+                               false,
+                               cf);
+        }
+
+        rs_pmis_split(omp_threads, n, S_ptr, S_col, ST_ptr, ST_col, cf);
+    }
+
+    int graph_mis(int omp_threads, int n, const int* adj_ptr, const int* adj, int* mis)
+    {
+        omp_set_num_threads(omp_threads);
+
+        const int undecided = -1;
+
+        int nblocks = (n + mis_block_size - 1) / mis_block_size;
+
+        // Greedy pass on each block, only nodes without neighbours in other blocks join the
+        // set, such that the blocks do not interfere
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for(int b = 0; b < nblocks; ++b)
+        {
+            int begin = b * mis_block_size;
+            int end   = std::min(n, begin + mis_block_size);
+
+            for(int i = begin; i < end; ++i)
+            {
+                mis[i] = undecided;
+            }
+
+            for(int i = begin; i < end; ++i)
+            {
+                if(mis[i] != undecided)
+                {
+                    continue;
+                }
+
+                bool interior = true;
+
+                for(int j = adj_ptr[i]; j < adj_ptr[i + 1]; ++j)
+                {
+                    if(adj[j] < begin || adj[j] >= end)
+                    {
+                        interior = false;
+                        break;
+                    }
+                }
+
+                if(interior == true)
+                {
+                    mis[i] = 1;
+
+                    for(int j = adj_ptr[i]; j < adj_ptr[i + 1]; ++j)
+                    {
+                        mis[adj[j]] = 0;
+                    }
+                }
+            }
+        }
+
+        std::vector<int> list;
+
+        for(int i = 0; i < n; ++i)
+        {
+            if(mis[i] == undecided)
+            {
+                list.push_back(i);
+            }
+        }
+
+        std::vector<int> state(list.size());
+
+        while(list.empty() == false)
+        {
+            int size = list.size();
+
+            // Nodes of maximal priority among their undecided neighbours join the set, ties
+            // are broken by the node index
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+            for(int k = 0; k < size; ++k)
+            {
+                int          i = list[k];
+                unsigned int h = hash_point(i);
+
+                state[k] = 1;
+
+                for(int j = adj_ptr[i]; j < adj_ptr[i + 1]; ++j)
+                {
+                    int c = adj[j];
+
+                    if(mis[c] == undecided)
+                    {
+                        unsigned int hc = hash_point(c);
+
+                        if(hc > h || (hc == h && c > i))
+                        {
+                            state[k] = undecided;
+                            break;
+                        }
+                    }
+                }
+            }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int k = 0; k < size; ++k)
+            {
+                if(state[k] == 1)
+                {
+                    mis[list[k]] = 1;
+                }
+            }
+
+            // Neighbours of the new nodes of the set drop out
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+            for(int k = 0; k < size; ++k)
+            {
+                if(state[k] == 1)
+                {
+                    continue;
+                }
+
+                int i = list[k];
+
+                for(int j = adj_ptr[i]; j < adj_ptr[i + 1]; ++j)
+                {
+                    if(mis[adj[j]] == 1)
+                    {
+                        state[k] = 0;
+                        break;
+                    }
+                }
+            }
+
+            int next = 0;
+
+            for(int k = 0; k < size; ++k)
+            {
+                if(state[k] == 0)
+                {
+                    mis[list[k]] = 0;
+                }
+                else if(state[k] == undecided)
+                {
+                    list[next++] = list[k];
+                }
+            }
+
+            list.resize(next);
+        }
+
+        int size = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : size)
+#endif
+        for(int i = 0; i < n; ++i)
+        {
+            size += mis[i];
+        }
+
+        return size;
+    }
+
+    int graph_mis2_aggregate(int        omp_threads,
+                             int        n,
+                             const int* row_offset,
+                             const int* col,
+                             const int* conn,
+                             int*       agg)
+    {
+        omp_set_num_threads(omp_threads);
+
+        const int undefined = -1;
+        const int removed   = -2;
+
+        // Key of a node, its state in the two highest bits, followed by its hashed
+        // priority and its index, such that the maximum key decides
+        const unsigned long long state_mask = 3ULL << 62;
+        const unsigned long long out        = 0ULL;
+        const unsigned long long undecided  = 1ULL << 62;
+        const unsigned long long in         = 2ULL << 62;
+
+        std::vector<unsigned long long> key(n);
+        std::vector<unsigned long long> key1(n);
+
+        // Nodes that are decided, as well as all of their neighbours
+        std::vector<char> settled(n, 0);
+
+        // Remove nodes without neighbours
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < n; ++i)
+        {
+            bool isolated = true;
+
+            for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+            {
+                if(conn[j])
+                {
+                    isolated = false;
+                    break;
+                }
+            }
+
+            agg[i] = isolated ? removed : undefined;
+            key[i] = (isolated ? out : undecided)
+                     | (static_cast<unsigned long long>(hash_point(i) >> 2) << 32)
+                     | static_cast<unsigned long long>(i);
+        }
+
+        std::vector<int> list;
+
+        for(int i = 0; i < n; ++i)
+        {
+            if(agg[i] == undefined)
+            {
+                list.push_back(i);
+            }
+        }
+
+        // Distance-two maximal independent set, an undecided node joins the set if its key
+        // is the maximum within distance two, and drops out if a node of the set is within
+        // distance two
+        while(list.empty() == false)
+        {
+            int size = list.size();
+
+            // Maximum key of each neighbourhood, unchanged once the node is settled
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+            for(int i = 0; i < n; ++i)
+            {
+                if(settled[i])
+                {
+                    continue;
+                }
+
+                unsigned long long m = key[i];
+
+                bool decided = (key[i] & state_mask) != undecided;
+
+                for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+                {
+                    if(conn[j])
+                    {
+                        m = std::max(m, key[col[j]]);
+                        decided &= (key[col[j]] & state_mask) != undecided;
+                    }
+                }
+
+                key1[i]    = m;
+                settled[i] = decided;
+            }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+            for(int k = 0; k < size; ++k)
+            {
+                int i = list[k];
+
+                unsigned long long m = key1[i];
+
+                for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+                {
+                    if(conn[j])
+                    {
+                        m = std::max(m, key1[col[j]]);
+                    }
+                }
+
+                if(m == key[i])
+                {
+                    key[i] = (key[i] & ~state_mask) | in;
+                }
+                else if((m & state_mask) == in)
+                {
+                    key[i] = (key[i] & ~state_mask) | out;
+                }
+            }
+
+            int next = 0;
+
+            for(int k = 0; k < size; ++k)
+            {
+                if((key[list[k]] & state_mask) == undecided)
+                {
+                    list[next++] = list[k];
+                }
+            }
+
+            list.resize(next);
+        }
+
+        // Number the roots in the order of the nodes
+        int nagg = 0;
+
+        for(int i = 0; i < n; ++i)
+        {
+            if((key[i] & state_mask) == in)
+            {
+                agg[i] = nagg++;
+            }
+        }
+
+        // Neighbours of a root join its aggregate
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(int i = 0; i < n; ++i)
+        {
+            if(agg[i] != undefined)
+            {
+                continue;
+            }
+
+            for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+            {
+                if(conn[j] && (key[col[j]] & state_mask) == in)
+                {
+                    agg[i] = agg[col[j]];
+                    break;
+                }
+            }
+        }
+
+        // Remaining nodes join the adjacent aggregate with the most strong connections,
+        // ties are broken by the order of the neighbours
+        std::vector<int> agg1(agg, agg + n);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<int> cand;
+            std::vector<int> count;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+            for(int i = 0; i < n; ++i)
+            {
+                if(agg1[i] != undefined)
+                {
+                    continue;
+                }
+
+                cand.clear();
+                count.clear();
+
+                for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+                {
+                    int a = agg1[col[j]];
+
+                    if(!conn[j] || a < 0)
+                    {
+                        continue;
+                    }
+
+                    size_t k = std::find(cand.begin(), cand.end(), a) - cand.begin();
+
+                    if(k == cand.size())
+                    {
+                        cand.push_back(a);
+                        count.push_back(0);
+                    }
+
+                    ++count[k];
+                }
+
+                if(cand.empty() == false)
+                {
+                    agg[i] = cand[std::max_element(count.begin(), count.end()) - count.begin()];
+                }
+            }
+        }
+
+        // Nodes that are not connected to any aggregate, which only happens for
+        // non-symmetric strength graphs, form aggregates of their own
+        for(int i = 0; i < n; ++i)
+        {
+            if(agg[i] == undefined)
+            {
+                agg[i] = nagg++;
+            }
+        }
+
+        return nagg;
+    }
+
+    // Priority of the edge between nodes i and j, the same for both of its end points
+    static inline unsigned int hash_edge(int i, int j)
+    {
+        unsigned int lo = static_cast<unsigned int>(std::min(i, j));
+        unsigned int hi = static_cast<unsigned int>(std::max(i, j));
+
+        return hash_point(hash_point(lo) + hi);
+    }
+
+    void graph_pairwise_match(int           omp_threads,
+                              int           n,
+                              const int*    ptr,
+                              const int*    col,
+                              const double* weight,
+                              int*          mate)
+    {
+        omp_set_num_threads(omp_threads);
+
+        // Proposal of each node in the current round and its number of unmatched neighbours
+        std::vector<int> choice(n, -1);
+        std::vector<int> degree(n, 0);
+
+        // Greedy matching within blocks of consecutive nodes, each node is matched to its
+        // unmatched neighbour of largest weight in the same block
+        int nblocks = (n + pairwise_block_size - 1) / pairwise_block_size;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for(int b = 0; b < nblocks; ++b)
+        {
+            int begin = b * pairwise_block_size;
+            int end   = std::min(begin + pairwise_block_size, n);
+
+            for(int i = begin; i < end; ++i)
+            {
+                if(mate[i] != -1)
+                {
+                    continue;
+                }
+
+                int    best   = -1;
+                double best_w = 0.0;
+
+                for(int j = ptr[i]; j < ptr[i + 1]; ++j)
+                {
+                    int c = col[j];
+
+                    if(c < begin || c >= end || weight[j] <= best_w || mate[c] != -1 || c == i)
+                    {
+                        continue;
+                    }
+
+                    best   = c;
+                    best_w = weight[j];
+                }
+
+                if(best != -1)
+                {
+                    mate[i]    = best;
+                    mate[best] = i;
+                }
+            }
+        }
+
+        // Nodes at the borders of the blocks are matched by handshaking
+        std::vector<int> list;
+
+        for(int i = 0; i < n; ++i)
+        {
+            if(mate[i] == -1)
+            {
+                list.push_back(i);
+            }
+        }
+
+        // Weighted rounds first, rounds by edge priority only if they stall
+        bool use_weight = true;
+
+        while(list.empty() == false)
+        {
+            int size = list.size();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+            for(int k = 0; k < size; ++k)
+            {
+                int i = list[k];
+                int d = 0;
+
+                for(int j = ptr[i]; j < ptr[i + 1]; ++j)
+                {
+                    if(weight[j] > 0.0 && mate[col[j]] == -1)
+                    {
+                        ++d;
+                    }
+                }
+
+                degree[i] = d;
+            }
+
+            // Propose to the neighbour of largest weight, among those prefer neighbours
+            // that have few other options
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+            for(int k = 0; k < size; ++k)
+            {
+                int i = list[k];
+
+                int          best   = -1;
+                int          best_d = 0;
+                double       best_w = 0.0;
+                unsigned int best_h = 0;
+
+                for(int j = ptr[i]; j < ptr[i + 1]; ++j)
+                {
+                    int c = col[j];
+
+                    if(weight[j] <= 0.0 || mate[c] != -1)
+                    {
+                        continue;
+                    }
+
+                    double w  = use_weight ? weight[j] : 0.0;
+                    int    dc = degree[c];
+
+                    if(best != -1 && (w < best_w || (w == best_w && dc > best_d)))
+                    {
+                        continue;
+                    }
+
+                    unsigned int h = hash_edge(i, c);
+
+                    if(best == -1 || w > best_w || dc < best_d || h > best_h
+                       || (h == best_h && c > best))
+                    {
+                        best   = c;
+                        best_w = w;
+                        best_d = dc;
+                        best_h = h;
+                    }
+                }
+
+                choice[i] = best;
+            }
+
+            // Handshake
+            int matched = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024) reduction(+ : matched)
+#endif
+            for(int k = 0; k < size; ++k)
+            {
+                int i = list[k];
+                int j = choice[i];
+
+                if(j != -1 && choice[j] == i)
+                {
+                    mate[i] = j;
+                    ++matched;
+                }
+            }
+
+            if(matched == 0)
+            {
+                if(use_weight == false)
+                {
+                    break;
+                }
+
+                use_weight = false;
+                continue;
+            }
+
+            // Keep the unmatched nodes that still have unmatched neighbours
+            int next = 0;
+
+            for(int k = 0; k < size; ++k)
+            {
+                int i = list[k];
+
+                if(mate[i] == -1 && choice[i] != -1)
+                {
+                    list[next++] = i;
+                }
+            }
+
+            list.resize(next);
+        }
+    }
+
+} // namespace rocalution
@@ -0,0 +1,126 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+
+#ifndef ROCALUTION_HOST_HOST_AMG_HPP_
+#define ROCALUTION_HOST_HOST_AMG_HPP_
+
+#include <vector>
+
+namespace rocalution
+{
+
+    // C/F splitting of a strength graph for Ruge-Stueben coarsening. Row i of S holds the
+    // points that i strongly depends on, row i of ST the points that strongly depend on i.
+    // Entries of cf are 1 for C points, 0 for F points and -1 for undecided points, points
+    // that are already decided on entry keep their state.
+
+    // Transpose of a graph in CSR layout, the rows of the transpose are sorted
+    void graph_transpose(int               n,
+                         const int*        ptr,
+                         const int*        col,
+                         std::vector<int>* t_ptr,
+                         std::vector<int>* t_col);
+
+    // Distance-two strength graph, i strongly depends on j if there is a path of at most
+    // two strong dependencies from i to j (used for aggressive coarsening)
+    void rs_strength_power2(int               omp_threads,
+                            int               n,
+                            const int*        S_ptr,
+                            const int*        S_col,
+                            std::vector<int>* S2_ptr,
+                            std::vector<int>* S2_col);
+
+    // Classical sequential splitting of the subgraph of the points begin <= i < end, edges
+    // leaving the subgraph are ignored. If coarsen_remaining is set, the points that are
+    // left undecided by the first pass become C points, otherwise they stay undecided.
+    void rs_classical_split(int        begin,
+                            int        end,
+                            const int* S_ptr,
+                            const int* S_col,
+                            const int* ST_ptr,
+                            const int* ST_col,
+                            bool       coarsen_remaining,
+                            int*       cf);
+
+    // Parallel modified independent set splitting (PMIS). The measure of a point is the
+    // number of points depending on it plus a random number, that is obtained by hashing
+    // the point index, such that the splitting does not depend on the number of threads.
+    void rs_pmis_split(int        omp_threads,
+                       int        n,
+                       const int* S_ptr,
+                       const int* S_col,
+                       const int* ST_ptr,
+                       const int* ST_col,
+                       int*       cf);
+
+    // Hybrid modified independent set splitting (HMIS). The classical first pass is applied
+    // to blocks of consecutive points in parallel, the remaining points are split by PMIS.
+    void rs_hmis_split(int        omp_threads,
+                       int        n,
+                       const int* S_ptr,
+                       const int* S_col,
+                       const int* ST_ptr,
+                       const int* ST_col,
+                       int*       cf);
+
+    // Maximal independent set of a symmetric graph without self loops. The greedy pass in
+    // the order of the nodes is applied to blocks of consecutive nodes in parallel, nodes
+    // with neighbours outside of their block are skipped. The remaining nodes join the set
+    // in parallel rounds if their hashed priority is the maximum among their undecided
+    // neighbours, such that the set does not depend on the number of threads. On exit,
+    // mis[i] is 1 if i is in the set and 0 otherwise. Returns the size of the set.
+    int graph_mis(int omp_threads, int n, const int* adj_ptr, const int* adj, int* mis);
+
+    // Aggregation of the strength graph, given by the strong entries (conn[j] != 0) of a
+    // matrix in CSR layout. The roots of the aggregates form a distance-two maximal
+    // independent set, that is computed in parallel using hashed priorities. Each root is
+    // aggregated with its neighbours, the remaining nodes join the adjacent aggregate they
+    // are most strongly connected to. agg[i] is the aggregate of node i, or -2 if i has no
+    // strong connections. Returns the number of aggregates.
+    int graph_mis2_aggregate(int        omp_threads,
+                             int        n,
+                             const int* row_offset,
+                             const int* col,
+                             const int* conn,
+                             int*       agg);
+
+    // Pairwise matching of a weighted graph by handshaking, the edges are the entries of
+    // positive weight. In each round, every unmatched node proposes to its unmatched
+    // neighbour of largest weight, ties are broken in favour of neighbours with fewer
+    // unmatched neighbours and then by a hashed edge priority. Mutual proposals are
+    // matched. If the weights are not symmetric and the rounds stall, the remaining nodes
+    // are matched by the edge priority only. On entry, mate[i] is -1 for nodes to be
+    // matched and -2 for excluded nodes, on exit mate[i] holds the partner of i, or -1 if
+    // i is left alone.
+    void graph_pairwise_match(int           omp_threads,
+                              int           n,
+                              const int*    ptr,
+                              const int*    col,
+                              const double* weight,
+                              int*          mate);
+
+} // namespace rocalution
+
+#endif // ROCALUTION_HOST_HOST_AMG_HPP_
@@ -25,10 +25,12 @@
 #include "../../utils/allocate_free.hpp"
 #include "../../utils/def.hpp"
 #include "../../utils/log.hpp"
+#include "../../utils/types.hpp"
 #include "../matrix_formats.hpp"
 #include "../matrix_formats_ind.hpp"
 
 #include <complex>
+#include <limits>
 #include <stdlib.h>
 
 #ifdef _OPENMP
@@ -52,6 +54,12 @@ namespace rocalution
         assert(nrow > 0);
         assert(ncol > 0);
 
+        // Dense size has to be addressable by IndexType
+        if(static_cast<IndexType2>(nrow) * ncol > std::numeric_limits<IndexType>::max())
+        {
+            return false;
+        }
+
         omp_set_num_threads(omp_threads);
 
         allocate_host(nrow * ncol, &dst->val);
@@ -316,13 +324,13 @@ namespace rocalution
         return true;
     }
 
-    template <typename ValueType, typename IndexType>
-    bool csr_to_coo(int                                    omp_threads,
-                    IndexType                              nnz,
-                    IndexType                              nrow,
-                    IndexType                              ncol,
-                    const MatrixCSR<ValueType, IndexType>& src,
-                    MatrixCOO<ValueType, IndexType>*       dst)
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool csr_to_coo(int                                                 omp_threads,
+                    PointerType                                         nnz,
+                    IndexType                                           nrow,
+                    IndexType                                           ncol,
+                    const MatrixCSR<ValueType, IndexType, PointerType>& src,
+                    MatrixCOO<ValueType, IndexType>*                    dst)
     {
         assert(nnz > 0);
         assert(nrow > 0);
@@ -343,7 +351,7 @@ namespace rocalution
 #endif
         for(IndexType i = 0; i < nrow; ++i)
         {
-            for(IndexType j = src.row_offset[i]; j < src.row_offset[i + 1]; ++j)
+            for(PointerType j = src.row_offset[i]; j < src.row_offset[i + 1]; ++j)
             {
                 dst->row[j] = i;
             }
@@ -352,7 +360,7 @@ namespace rocalution
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for(IndexType i = 0; i < nnz; ++i)
+        for(PointerType i = 0; i < nnz; ++i)
         {
             dst->col[i] = src.col[i];
         }
@@ -360,7 +368,7 @@ namespace rocalution
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for(IndexType i = 0; i < nnz; ++i)
+        for(PointerType i = 0; i < nnz; ++i)
         {
             dst->val[i] = src.val[i];
         }
@@ -394,14 +402,20 @@ namespace rocalution
             }
         }
 
-        *nnz_ell = dst->max_row * nrow;
-
         // Limit ELL size to 5 times CSR nnz
         if(dst->max_row > 5 * (nnz / nrow))
         {
             return false;
         }
 
+        // ELL size has to be addressable by IndexType
+        if(static_cast<IndexType2>(dst->max_row) * nrow > std::numeric_limits<IndexType>::max())
+        {
+            return false;
+        }
+
+        *nnz_ell = dst->max_row * nrow;
+
         allocate_host(*nnz_ell, &dst->val);
         allocate_host(*nnz_ell, &dst->col);
 
@@ -627,13 +641,13 @@ namespace rocalution
         return true;
     }
 
-    template <typename ValueType, typename IndexType>
-    bool coo_to_csr(int                                    omp_threads,
-                    IndexType                              nnz,
-                    IndexType                              nrow,
-                    IndexType                              ncol,
-                    const MatrixCOO<ValueType, IndexType>& src,
-                    MatrixCSR<ValueType, IndexType>*       dst)
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool coo_to_csr(int                                           omp_threads,
+                    PointerType                                   nnz,
+                    IndexType                                     nrow,
+                    IndexType                                     ncol,
+                    const MatrixCOO<ValueType, IndexType>&        src,
+                    MatrixCSR<ValueType, IndexType, PointerType>* dst)
     {
         assert(nnz > 0);
         assert(nrow > 0);
@@ -646,7 +660,7 @@ namespace rocalution
         allocate_host(nnz, &dst->val);
 
         // COO has to be sorted by rows
-        for(IndexType i = 1; i < nnz; ++i)
+        for(PointerType i = 1; i < nnz; ++i)
         {
             assert(src.row[i] >= src.row[i - 1]);
         }
@@ -655,7 +669,7 @@ namespace rocalution
         set_to_zero_host(nrow + 1, dst->row_offset);
 
         // Compute nnz entries per row of CSR
-        for(IndexType i = 0; i < nnz; ++i)
+        for(PointerType i = 0; i < nnz; ++i)
         {
             ++dst->row_offset[src.row[i] + 1];
         }
@@ -671,7 +685,7 @@ namespace rocalution
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for(IndexType i = 0; i < nnz; ++i)
+        for(PointerType i = 0; i < nnz; ++i)
         {
             dst->col[i] = src.col[i];
             dst->val[i] = src.val[i];
@@ -684,9 +698,9 @@ namespace rocalution
 #endif
         for(IndexType i = 0; i < nrow; ++i)
         {
-            for(IndexType j = dst->row_offset[i]; j < dst->row_offset[i + 1]; ++j)
+            for(PointerType j = dst->row_offset[i]; j < dst->row_offset[i + 1]; ++j)
             {
-                for(IndexType jj = dst->row_offset[i]; jj < dst->row_offset[i + 1] - 1; ++jj)
+                for(PointerType jj = dst->row_offset[i]; jj < dst->row_offset[i + 1] - 1; ++jj)
                 {
                     if(dst->col[jj] > dst->col[jj + 1])
                     {
@@ -744,7 +758,6 @@ namespace rocalution
         }
 
         IndexType size = nrow > ncol ? nrow : ncol;
-        *nnz_dia       = size * dst->num_diag;
 
         // Conversion fails if DIA nnz exceeds 5 times CSR nnz
         if(dst->num_diag > 5 * (nnz / size))
@@ -752,6 +765,14 @@ namespace rocalution
             return false;
         }
 
+        // DIA size has to be addressable by IndexType
+        if(static_cast<IndexType2>(size) * dst->num_diag > std::numeric_limits<IndexType>::max())
+        {
+            return false;
+        }
+
+        *nnz_dia = size * dst->num_diag;
+
         // Allocate DIA matrix
         allocate_host(dst->num_diag, &dst->offset);
         allocate_host(*nnz_dia, &dst->val);
@@ -887,6 +908,12 @@ namespace rocalution
             dst->ELL.max_row = (nnz - 1) / nrow + 1;
         }
 
+        // ELL size has to be addressable by IndexType
+        if(static_cast<IndexType2>(dst->ELL.max_row) * nrow > std::numeric_limits<IndexType>::max())
+        {
+            return false;
+        }
+
         // ELL nnz is ELL width times nrow
         *nnz_ell = dst->ELL.max_row * nrow;
         *nnz_coo = 0;
@@ -923,6 +950,13 @@ namespace rocalution
             *nnz_coo = coo_row_ptr[nrow];
         }
 
+        // HYB size has to be addressable by IndexType
+        if(static_cast<IndexType2>(*nnz_coo) + *nnz_ell > std::numeric_limits<IndexType>::max())
+        {
+            free_host(&coo_row_ptr);
+            return false;
+        }
+
         *nnz_hyb = *nnz_coo + *nnz_ell;
 
         if(*nnz_hyb <= 0)
@@ -1025,6 +1059,36 @@ namespace rocalution
                              const MatrixCSR<int, int>& src,
                              MatrixCOO<int, int>*       dst);
 
+    template bool csr_to_coo(int                                       omp_threads,
+                             IndexType2                                nnz,
+                             int                                       nrow,
+                             int                                       ncol,
+                             const MatrixCSR<double, int, IndexType2>& src,
+                             MatrixCOO<double, int>*                   dst);
+
+    template bool csr_to_coo(int                                      omp_threads,
+                             IndexType2                               nnz,
+                             int                                      nrow,
+                             int                                      ncol,
+                             const MatrixCSR<float, int, IndexType2>& src,
+                             MatrixCOO<float, int>*                   dst);
+
+#ifdef SUPPORT_COMPLEX
+    template bool csr_to_coo(int                                                     omp_threads,
+                             IndexType2                                              nnz,
+                             int                                                     nrow,
+                             int                                                     ncol,
+                             const MatrixCSR<std::complex<double>, int, IndexType2>& src,
+                             MatrixCOO<std::complex<double>, int>*                   dst);
+
+    template bool csr_to_coo(int                                                    omp_threads,
+                             IndexType2                                             nnz,
+                             int                                                    nrow,
+                             int                                                    ncol,
+                             const MatrixCSR<std::complex<float>, int, IndexType2>& src,
+                             MatrixCOO<std::complex<float>, int>*                   dst);
+#endif
+
     template bool csr_to_mcsr(int                           omp_threads,
                               int                           nnz,
                               int                           nrow,
@@ -1430,6 +1494,36 @@ namespace rocalution
                              const MatrixCOO<int, int>& src,
                              MatrixCSR<int, int>*       dst);
 
+    template bool coo_to_csr(int                                 omp_threads,
+                             IndexType2                          nnz,
+                             int                                 nrow,
+                             int                                 ncol,
+                             const MatrixCOO<double, int>&       src,
+                             MatrixCSR<double, int, IndexType2>* dst);
+
+    template bool coo_to_csr(int                                omp_threads,
+                             IndexType2                         nnz,
+                             int                                nrow,
+                             int                                ncol,
+                             const MatrixCOO<float, int>&       src,
+                             MatrixCSR<float, int, IndexType2>* dst);
+
+#ifdef SUPPORT_COMPLEX
+    template bool coo_to_csr(int                                               omp_threads,
+                             IndexType2                                        nnz,
+                             int                                               nrow,
+                             int                                               ncol,
+                             const MatrixCOO<std::complex<double>, int>&       src,
+                             MatrixCSR<std::complex<double>, int, IndexType2>* dst);
+
+    template bool coo_to_csr(int                                              omp_threads,
+                             IndexType2                                       nnz,
+                             int                                              nrow,
+                             int                                              ncol,
+                             const MatrixCOO<std::complex<float>, int>&       src,
+                             MatrixCSR<std::complex<float>, int, IndexType2>* dst);
+#endif
+
     template bool hyb_to_csr(int                           omp_threads,
                              int                           nnz,
                              int                           nrow,
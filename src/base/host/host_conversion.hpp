@@ -29,13 +29,14 @@
 namespace rocalution
 {
 
-    template <typename ValueType, typename IndexType>
-    bool csr_to_coo(int                                    omp_threads,
-                    IndexType                              nnz,
-                    IndexType                              nrow,
-                    IndexType                              ncol,
-                    const MatrixCSR<ValueType, IndexType>& src,
-                    MatrixCOO<ValueType, IndexType>*       dst);
+    // The number of non-zero entries and the row offsets can be wider than the indices
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool csr_to_coo(int                                                 omp_threads,
+                    PointerType                                         nnz,
+                    IndexType                                           nrow,
+                    IndexType                                           ncol,
+                    const MatrixCSR<ValueType, IndexType, PointerType>& src,
+                    MatrixCOO<ValueType, IndexType>*                    dst);
 
     template <typename ValueType, typename IndexType>
     bool csr_to_mcsr(int                                    omp_threads,
@@ -108,13 +109,14 @@ namespace rocalution
                     MatrixCSR<ValueType, IndexType>*       dst,
                     IndexType*                             nnz_csr);
 
-    template <typename ValueType, typename IndexType>
-    bool coo_to_csr(int                                    omp_threads,
-                    IndexType                              nnz,
-                    IndexType                              nrow,
-                    IndexType                              ncol,
-                    const MatrixCOO<ValueType, IndexType>& src,
-                    MatrixCSR<ValueType, IndexType>*       dst);
+    // The number of non-zero entries and the row offsets can be wider than the indices
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool coo_to_csr(int                                           omp_threads,
+                    PointerType                                   nnz,
+                    IndexType                                     nrow,
+                    IndexType                                     ncol,
+                    const MatrixCOO<ValueType, IndexType>&        src,
+                    MatrixCSR<ValueType, IndexType, PointerType>* dst);
 
     template <typename ValueType, typename IndexType>
     bool mcsr_to_csr(int                                     omp_threads,
@@ -25,11 +25,21 @@
 #include "../../utils/allocate_free.hpp"
 #include "../../utils/def.hpp"
 #include "../../utils/log.hpp"
+#include "../../utils/types.hpp"
+#include "version.hpp"
 
+#include <algorithm>
 #include <complex>
+#include <limits>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <typeinfo>
+#include <unistd.h>
+#include <vector>
 
 namespace rocalution
 {
@@ -109,7 +119,7 @@ namespace rocalution
                             mm_banner&  b,
                             int&        nrow,
                             int&        ncol,
-                            int&        nnz,
+                            IndexType2& nnz,
                             int**       row,
                             int**       col,
                             ValueType** val)
@@ -127,7 +137,11 @@ namespace rocalution
         } while(line[0] == '%');
 
         // Read m, n, nnz
-        while(sscanf(line, "%d %d %d", &nrow, &ncol, &nnz) != 3)
+        long long m;
+        long long n;
+        long long nz;
+
+        while(sscanf(line, "%lld %lld %lld", &m, &n, &nz) != 3)
         {
             // Check for EOF and loop until line with 3 integer entries found
             if(!fgets(line, 1025, fin))
@@ -136,6 +150,19 @@ namespace rocalution
             }
         }
 
+        // Row and column indices have to be addressable by int
+        if(m < 0 || n < 0 || nz < 0 || m > std::numeric_limits<int>::max()
+           || n > std::numeric_limits<int>::max())
+        {
+            LOG_INFO("ReadFileMTX: matrix size " << m << " x " << n
+                                                 << " exceeds 32 bit indexing");
+            return false;
+        }
+
+        nrow = static_cast<int>(m);
+        ncol = static_cast<int>(n);
+        nnz  = static_cast<IndexType2>(nz);
+
         // Allocate arrays
         allocate_host(nnz, row);
         allocate_host(nnz, col);
@@ -145,7 +172,7 @@ namespace rocalution
         if(!strncmp(b.matrix_type, "complex", 7))
         {
             double tmp1, tmp2;
-            for(int i = 0; i < nnz; ++i)
+            for(IndexType2 i = 0; i < nnz; ++i)
             {
                 if(fscanf(fin, "%d %d %lg %lg", (*row) + i, (*col) + i, &tmp1, &tmp2) != 4)
                 {
@@ -159,7 +186,7 @@ namespace rocalution
         else if(!strncmp(b.matrix_type, "real", 4) || !strncmp(b.matrix_type, "integer", 7))
         {
             double tmp;
-            for(int i = 0; i < nnz; ++i)
+            for(IndexType2 i = 0; i < nnz; ++i)
             {
                 if(fscanf(fin, "%d %d %lg\n", (*row) + i, (*col) + i, &tmp) != 3)
                 {
@@ -172,7 +199,7 @@ namespace rocalution
         }
         else if(!strncmp(b.matrix_type, "pattern", 7))
         {
-            for(int i = 0; i < nnz; ++i)
+            for(IndexType2 i = 0; i < nnz; ++i)
             {
                 if(fscanf(fin, "%d %d\n", (*row) + i, (*col) + i) != 2)
                 {
@@ -192,8 +219,8 @@ namespace rocalution
         if(strncmp(b.storage_type, "general", 7))
         {
             // Count diagonal entries
-            int ndiag = 0;
-            for(int i = 0; i < nnz; ++i)
+            IndexType2 ndiag = 0;
+            for(IndexType2 i = 0; i < nnz; ++i)
             {
                 if((*row)[i] == (*col)[i])
                 {
@@ -201,7 +228,7 @@ namespace rocalution
                 }
             }
 
-            int tot_nnz = (nnz - ndiag) * 2 + ndiag;
+            IndexType2 tot_nnz = (nnz - ndiag) * 2 + ndiag;
 
             // Allocate memory
             int*       sym_row = *row;
@@ -216,8 +243,8 @@ namespace rocalution
             allocate_host(tot_nnz, col);
             allocate_host(tot_nnz, val);
 
-            int idx = 0;
-            for(int i = 0; i < nnz; ++i)
+            IndexType2 idx = 0;
+            for(IndexType2 i = 0; i < nnz; ++i)
             {
                 (*row)[idx] = sym_row[i];
                 (*col)[idx] = sym_col[i];
@@ -250,8 +277,13 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    bool read_matrix_mtx(
-        int& nrow, int& ncol, int& nnz, int** row, int** col, ValueType** val, const char* filename)
+    bool read_matrix_mtx(int&        nrow,
+                         int&        ncol,
+                         IndexType2& nnz,
+                         int**       row,
+                         int**       col,
+                         ValueType** val,
+                         const char* filename)
     {
         FILE* file = fopen(filename, "r");
 
@@ -305,7 +337,7 @@ namespace rocalution
     template <typename ValueType>
     bool write_matrix_mtx(int              nrow,
                           int              ncol,
-                          int              nnz,
+                          IndexType2       nnz,
                           const int*       row,
                           const int*       col,
                           const ValueType* val,
@@ -323,9 +355,9 @@ namespace rocalution
         write_banner<ValueType>(file);
 
         // Write matrix sizes
-        fprintf(file, "%d %d %d\n", nrow, ncol, nnz);
+        fprintf(file, "%d %d %lld\n", nrow, ncol, static_cast<long long>(nnz));
 
-        for(int i = 0; i < nnz; ++i)
+        for(IndexType2 i = 0; i < nnz; ++i)
         {
             fprintf(file, "%d %d ", row[i] + 1, col[i] + 1);
             write_value(file, val[i]);
@@ -336,56 +368,1465 @@ namespace rocalution
         return true;
     }
 
-    template bool read_matrix_mtx(
-        int& nrow, int& ncol, int& nnz, int** row, int** col, float** val, const char* filename);
-    template bool read_matrix_mtx(
-        int& nrow, int& ncol, int& nnz, int** row, int** col, double** val, const char* filename);
+    // rocALUTION binary container (see LocalMatrix::WriteFileCSR())
+    static const char bin_csr_header_v1[]    = "#rocALUTION binary csr file";
+    static const char bin_csr_header[]       = "#rocALUTION binary csr file v2";
+    static const char bin_vector_header_v1[] = "#rocALUTION binary vector file";
+    static const char bin_vector_header[]    = "#rocALUTION binary vector file v2";
+
+    // Sections are aligned to pages, such that they can be mapped
+    static const int64_t bin_alignment = 4096;
+
+    // Files are streamed in chunks of this size (bytes)
+    static const int64_t bin_chunk_size = 16777216;
+
+    // Header flags, row offsets are stored as 64 bit integers if the number of
+    // non-zero entries exceeds 32 bit indexing
+    static const int bin_flag_checksum = 1;
+    static const int bin_flag_offset64 = 2;
+
+    // Value types
+    enum _bin_value_type
+    {
+        BIN_INT            = 0,
+        BIN_FLOAT          = 1,
+        BIN_DOUBLE         = 2,
+        BIN_COMPLEX_FLOAT  = 3,
+        BIN_COMPLEX_DOUBLE = 4,
+        BIN_INT64          = 5
+    };
+
+    struct bin_header
+    {
+        int32_t version;
+        int32_t index_size;
+        int32_t value_type;
+        int32_t flags;
+        int64_t nrow;
+        int64_t ncol;
+        int64_t nnz;
+        int32_t nsection;
+        int32_t alignment;
+    };
+
+    struct bin_section
+    {
+        int64_t  offset;
+        int64_t  size;
+        uint64_t checksum;
+    };
+
+    static int bin_value_type(const int*)
+    {
+        return BIN_INT;
+    }
+
+    static int bin_value_type(const int64_t*)
+    {
+        return BIN_INT64;
+    }
+
+    static int bin_value_type(const float*)
+    {
+        return BIN_FLOAT;
+    }
+
+    static int bin_value_type(const double*)
+    {
+        return BIN_DOUBLE;
+    }
+
 #ifdef SUPPORT_COMPLEX
-    template bool read_matrix_mtx(int&                  nrow,
-                                  int&                  ncol,
-                                  int&                  nnz,
-                                  int**                 row,
-                                  int**                 col,
-                                  std::complex<float>** val,
-                                  const char*           filename);
-    template bool read_matrix_mtx(int&                   nrow,
-                                  int&                   ncol,
-                                  int&                   nnz,
-                                  int**                  row,
-                                  int**                  col,
-                                  std::complex<double>** val,
-                                  const char*            filename);
+    static int bin_value_type(const std::complex<float>*)
+    {
+        return BIN_COMPLEX_FLOAT;
+    }
+
+    static int bin_value_type(const std::complex<double>*)
+    {
+        return BIN_COMPLEX_DOUBLE;
+    }
 #endif
 
-    template bool write_matrix_mtx(int          nrow,
-                                   int          ncol,
-                                   int          nnz,
-                                   const int*   row,
-                                   const int*   col,
-                                   const float* val,
-                                   const char*  filename);
-    template bool write_matrix_mtx(int           nrow,
-                                   int           ncol,
-                                   int           nnz,
-                                   const int*    row,
-                                   const int*    col,
-                                   const double* val,
-                                   const char*   filename);
-#ifdef SUPPORT_COMPLEX
-    template bool write_matrix_mtx(int                        nrow,
-                                   int                        ncol,
-                                   int                        nnz,
-                                   const int*                 row,
-                                   const int*                 col,
-                                   const std::complex<float>* val,
-                                   const char*                filename);
-    template bool write_matrix_mtx(int                         nrow,
-                                   int                         ncol,
-                                   int                         nnz,
-                                   const int*                  row,
-                                   const int*                  col,
-                                   const std::complex<double>* val,
-                                   const char*                 filename);
+    static int64_t bin_value_size(int value_type)
+    {
+        switch(value_type)
+        {
+        case BIN_INT: return sizeof(int);
+        case BIN_FLOAT: return sizeof(float);
+        case BIN_DOUBLE: return sizeof(double);
+        case BIN_COMPLEX_FLOAT: return sizeof(std::complex<float>);
+        case BIN_COMPLEX_DOUBLE: return sizeof(std::complex<double>);
+        case BIN_INT64: return sizeof(int64_t);
+        }
+
+        return 0;
+    }
+
+    static int64_t bin_align(int64_t offset)
+    {
+        return (offset + bin_alignment - 1) / bin_alignment * bin_alignment;
+    }
+
+    // 64 bit FNV-1a hash, processing 8 byte words
+    static const uint64_t bin_checksum_init = 14695981039346656037ULL;
+
+    static uint64_t bin_checksum(uint64_t hash, const char* data, int64_t size)
+    {
+        int64_t nword = size / 8;
+
+        for(int64_t i = 0; i < nword; ++i)
+        {
+            uint64_t word;
+            memcpy(&word, data + 8 * i, 8);
+
+            hash = (hash ^ word) * 1099511628211ULL;
+        }
+
+        for(int64_t i = 8 * nword; i < size; ++i)
+        {
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+        }
+
+        return hash;
+    }
+
+    // Value conversion from file to memory type, complex to real conversion is
+    // rejected before reading
+    template <typename ValueType, typename FileType>
+    struct bin_cast
+    {
+        static ValueType get(const FileType& val)
+        {
+            return static_cast<ValueType>(val);
+        }
+    };
+
+    template <typename ValueType, typename FileType>
+    struct bin_cast<ValueType, std::complex<FileType>>
+    {
+        static ValueType get(const std::complex<FileType>& val)
+        {
+            return static_cast<ValueType>(val.real());
+        }
+    };
+
+    template <typename ValueType, typename FileType>
+    struct bin_cast<std::complex<ValueType>, std::complex<FileType>>
+    {
+        static std::complex<ValueType> get(const std::complex<FileType>& val)
+        {
+            return std::complex<ValueType>(val);
+        }
+    };
+
+    // Read the text header line, returns 2 for the current and 1 for the previous
+    // container version, 0 otherwise
+    static int bin_read_text(FILE* file, const char* header, const char* header_v1)
+    {
+        char line[64];
+
+        if(!fgets(line, 64, file))
+        {
+            return 0;
+        }
+
+        line[strcspn(line, "\n")] = '\0';
+
+        if(!strcmp(line, header))
+        {
+            return 2;
+        }
+
+        if(!strcmp(line, header_v1))
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+
+    static bool bin_read_header(FILE* file, bin_header& header, bin_section* section, int nsection)
+    {
+        if(fread(&header, sizeof(bin_header), 1, file) != 1)
+        {
+            return false;
+        }
+
+        if(header.nsection != nsection || header.index_size != sizeof(int)
+           || bin_value_size(header.value_type) == 0)
+        {
+            return false;
+        }
+
+        // Sizes have to be addressable by int, unless the row offsets are 64 bit
+        if(header.nrow < 0 || header.ncol < 0 || header.nnz < 0
+           || header.nrow > std::numeric_limits<int>::max()
+           || header.ncol > std::numeric_limits<int>::max()
+           || (header.nnz > std::numeric_limits<int>::max()
+               && !(header.flags & bin_flag_offset64)))
+        {
+            LOG_INFO("Binary file exceeds 32 bit indexing");
+            return false;
+        }
+
+        if(fread(section, sizeof(bin_section), nsection, file) != static_cast<size_t>(nsection))
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    // Stream a section from file to memory, converting values in chunks if the file
+    // type differs from the memory type
+    template <typename FileType, typename ValueType>
+    bool bin_read_chunks(FILE* file, int64_t size, ValueType* data, uint64_t& hash)
+    {
+        if(typeid(FileType) == typeid(ValueType))
+        {
+            int64_t bytes = size * sizeof(ValueType);
+            char*   ptr   = reinterpret_cast<char*>(data);
+
+            for(int64_t i = 0; i < bytes; i += bin_chunk_size)
+            {
+                int64_t chunk = std::min(bin_chunk_size, bytes - i);
+
+                if(fread(ptr + i, 1, chunk, file) != static_cast<size_t>(chunk))
+                {
+                    return false;
+                }
+
+                hash = bin_checksum(hash, ptr + i, chunk);
+            }
+
+            return true;
+        }
+
+        int64_t               chunk_size = bin_chunk_size / sizeof(FileType);
+        std::vector<FileType> buffer(std::min(chunk_size, size));
+
+        for(int64_t i = 0; i < size; i += chunk_size)
+        {
+            int64_t chunk = std::min(chunk_size, size - i);
+
+            if(fread(buffer.data(), sizeof(FileType), chunk, file) != static_cast<size_t>(chunk))
+            {
+                return false;
+            }
+
+            hash = bin_checksum(
+                hash, reinterpret_cast<const char*>(buffer.data()), chunk * sizeof(FileType));
+
+            for(int64_t j = 0; j < chunk; ++j)
+            {
+                data[i + j] = bin_cast<ValueType, FileType>::get(buffer[j]);
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool bin_read_values(FILE* file, int value_type, int64_t size, ValueType* data, uint64_t& hash)
+    {
+        // Complex values cannot be read into real data
+        bool file_complex = value_type == BIN_COMPLEX_FLOAT || value_type == BIN_COMPLEX_DOUBLE;
+        int  data_type    = bin_value_type(data);
+
+        if(file_complex && data_type != BIN_COMPLEX_FLOAT && data_type != BIN_COMPLEX_DOUBLE)
+        {
+            LOG_INFO("Binary file contains complex values");
+            return false;
+        }
+
+        switch(value_type)
+        {
+        case BIN_INT: return bin_read_chunks<int>(file, size, data, hash);
+        case BIN_FLOAT: return bin_read_chunks<float>(file, size, data, hash);
+        case BIN_DOUBLE: return bin_read_chunks<double>(file, size, data, hash);
+        case BIN_COMPLEX_FLOAT: return bin_read_chunks<std::complex<float>>(file, size, data, hash);
+        case BIN_COMPLEX_DOUBLE:
+            return bin_read_chunks<std::complex<double>>(file, size, data, hash);
+        case BIN_INT64: return bin_read_chunks<int64_t>(file, size, data, hash);
+        }
+
+        return false;
+    }
+
+    // Read a section of the container and verify its checksum
+    template <typename ValueType>
+    bool bin_read_section(FILE*              file,
+                          const bin_header&  header,
+                          const bin_section& section,
+                          int                value_type,
+                          int64_t            size,
+                          ValueType*         data)
+    {
+        if(section.size != size * bin_value_size(value_type))
+        {
+            return false;
+        }
+
+        if(fseeko(file, section.offset, SEEK_SET) != 0)
+        {
+            return false;
+        }
+
+        uint64_t hash = bin_checksum_init;
+
+        if(bin_read_values(file, value_type, size, data, hash) != true)
+        {
+            return false;
+        }
+
+        if((header.flags & bin_flag_checksum) && hash != section.checksum)
+        {
+            LOG_INFO("Binary file checksum mismatch");
+            return false;
+        }
+
+        return true;
+    }
+
+    // Write the header line, the header and the section table of the container. The
+    // checksums of the table are completed by bin_write_table() once the sections are
+    // written
+    static bool bin_write_header(FILE*          file,
+                                 const char*    text,
+                                 bin_header&    header,
+                                 int            nsection,
+                                 const int64_t* size,
+                                 bin_section*   section)
+    {
+        header.version   = __ROCALUTION_VER;
+        header.flags     = header.flags | bin_flag_checksum;
+        header.nsection  = nsection;
+        header.alignment = bin_alignment;
+
+        int64_t offset = strlen(text) + 1 + sizeof(bin_header) + nsection * sizeof(bin_section);
+
+        for(int i = 0; i < nsection; ++i)
+        {
+            section[i].offset   = bin_align(offset);
+            section[i].size     = size[i];
+            section[i].checksum = bin_checksum_init;
+
+            offset = section[i].offset + size[i];
+        }
+
+        if(fprintf(file, "%s\n", text) < 0)
+        {
+            return false;
+        }
+
+        if(fwrite(&header, sizeof(bin_header), 1, file) != 1)
+        {
+            return false;
+        }
+
+        if(fwrite(section, sizeof(bin_section), nsection, file) != static_cast<size_t>(nsection))
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    // Zero padding up to the aligned section offset
+    static bool bin_write_padding(FILE* file, const bin_section& section)
+    {
+        int64_t pad = section.offset - ftello(file);
+
+        for(int64_t j = 0; j < pad; ++j)
+        {
+            if(fputc(0, file) == EOF)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static bool bin_write_table(FILE*              file,
+                                const char*        text,
+                                int                nsection,
+                                const bin_section* section)
+    {
+        if(fseeko(file, strlen(text) + 1 + sizeof(bin_header), SEEK_SET) != 0)
+        {
+            return false;
+        }
+
+        if(fwrite(section, sizeof(bin_section), nsection, file) != static_cast<size_t>(nsection))
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    // Write the container, sections are streamed in chunks and the section table is
+    // completed with the checksums afterwards
+    static bool bin_write(FILE*              file,
+                          const char*        text,
+                          bin_header&        header,
+                          int                nsection,
+                          const char* const* data,
+                          const int64_t*     size)
+    {
+        std::vector<bin_section> section(nsection);
+
+        if(bin_write_header(file, text, header, nsection, size, section.data()) != true)
+        {
+            return false;
+        }
+
+        for(int i = 0; i < nsection; ++i)
+        {
+            if(bin_write_padding(file, section[i]) != true)
+            {
+                return false;
+            }
+
+            for(int64_t j = 0; j < size[i]; j += bin_chunk_size)
+            {
+                int64_t chunk = std::min(bin_chunk_size, size[i] - j);
+
+                if(fwrite(data[i] + j, 1, chunk, file) != static_cast<size_t>(chunk))
+                {
+                    return false;
+                }
+
+                section[i].checksum = bin_checksum(section[i].checksum, data[i] + j, chunk);
+            }
+        }
+
+        return bin_write_table(file, text, nsection, section.data());
+    }
+
+    // Read the header of a binary CSR file and locate its sections. The sections of the
+    // previous container follow the header without alignment and carry no checksum
+    static bool
+        bin_read_csr_header(FILE* file, int version, bin_header& header, bin_section* section)
+    {
+        if(version == 2)
+        {
+            return bin_read_header(file, header, section, 3);
+        }
+
+        if(version != 1)
+        {
+            return false;
+        }
+
+        // Previous container, int sizes and double precision values
+        int size[4];
+
+        if(fread(size, sizeof(int), 4, file) != 4 || size[1] < 0 || size[2] < 0 || size[3] < 0)
+        {
+            return false;
+        }
+
+        header.index_size = sizeof(int);
+        header.value_type = BIN_DOUBLE;
+        header.flags      = 0;
+        header.nrow       = size[1];
+        header.ncol       = size[2];
+        header.nnz        = size[3];
+        header.nsection   = 3;
+        header.alignment  = 0;
+
+        int64_t offset = ftello(file);
+
+        section[0].offset = offset;
+        section[0].size   = (header.nrow + 1) * static_cast<int64_t>(sizeof(int));
+        section[1].offset = section[0].offset + section[0].size;
+        section[1].size   = header.nnz * static_cast<int64_t>(sizeof(int));
+        section[2].offset = section[1].offset + section[1].size;
+        section[2].size   = header.nnz * static_cast<int64_t>(sizeof(double));
+
+        for(int i = 0; i < 3; ++i)
+        {
+            section[i].checksum = 0;
+        }
+
+        return offset >= 0;
+    }
+
+    // Read a range of entries of a section. Checksums cover whole sections and cannot be
+    // verified here
+    template <typename ValueType>
+    bool bin_read_range(FILE*              file,
+                        const bin_section& section,
+                        int                value_type,
+                        int64_t            begin,
+                        int64_t            size,
+                        ValueType*         data)
+    {
+        int64_t value_size = bin_value_size(value_type);
+
+        if(begin < 0 || size < 0 || (begin + size) * value_size > section.size)
+        {
+            return false;
+        }
+
+        if(fseeko(file, section.offset + begin * value_size, SEEK_SET) != 0)
+        {
+            return false;
+        }
+
+        uint64_t hash = bin_checksum_init;
+
+        return bin_read_values(file, value_type, size, data, hash);
+    }
+
+    // Stream a section of one container into another, entries are converted to OutType
+    // chunk by chunk
+    template <typename OutType>
+    bool bin_convert_section(FILE*              input,
+                             const bin_header&  header,
+                             const bin_section& in_section,
+                             int                value_type,
+                             int64_t            size,
+                             FILE*              output,
+                             bin_section&       out_section)
+    {
+        if(in_section.size != size * bin_value_size(value_type))
+        {
+            return false;
+        }
+
+        if(fseeko(input, in_section.offset, SEEK_SET) != 0
+           || bin_write_padding(output, out_section) != true)
+        {
+            return false;
+        }
+
+        // Chunks are a multiple of 8 bytes for all types, such that the hashes over
+        // the chunks equal the hashes over the whole sections
+        int64_t              chunk_size = bin_chunk_size / 16;
+        std::vector<OutType> buffer(std::min(chunk_size, size));
+        uint64_t             hash = bin_checksum_init;
+
+        for(int64_t i = 0; i < size; i += chunk_size)
+        {
+            int64_t chunk = std::min(chunk_size, size - i);
+
+            if(bin_read_values(input, value_type, chunk, buffer.data(), hash) != true)
+            {
+                return false;
+            }
+
+            if(fwrite(buffer.data(), sizeof(OutType), chunk, output)
+               != static_cast<size_t>(chunk))
+            {
+                return false;
+            }
+
+            out_section.checksum
+                = bin_checksum(out_section.checksum,
+                               reinterpret_cast<const char*>(buffer.data()),
+                               chunk * static_cast<int64_t>(sizeof(OutType)));
+        }
+
+        if((header.flags & bin_flag_checksum) && hash != in_section.checksum)
+        {
+            LOG_INFO("Binary file checksum mismatch");
+            return false;
+        }
+
+        return true;
+    }
+
+    template <typename ValueType, typename PointerType>
+    bool read_matrix_csr(int&          nrow,
+                         int&          ncol,
+                         PointerType&  nnz,
+                         PointerType** row_offset,
+                         int**         col,
+                         ValueType**   val,
+                         const char*   filename)
+    {
+        FILE* file = fopen(filename, "rb");
+
+        if(!file)
+        {
+            LOG_INFO("ReadFileCSR: cannot open file " << filename);
+            return false;
+        }
+
+        int version = bin_read_text(file, bin_csr_header, bin_csr_header_v1);
+
+        if(version == 0)
+        {
+            LOG_INFO("ReadFileCSR: " << filename << " is not a rocALUTION matrix");
+            fclose(file);
+            return false;
+        }
+
+        bin_header  header;
+        bin_section section[3];
+
+        if(bin_read_csr_header(file, version, header, section) != true)
+        {
+            LOG_INFO("ReadFileCSR: " << filename << " has an invalid header");
+            fclose(file);
+            return false;
+        }
+
+        if(header.nnz > std::numeric_limits<PointerType>::max())
+        {
+            LOG_INFO("ReadFileCSR: " << filename << " exceeds 32 bit indexing");
+            fclose(file);
+            return false;
+        }
+
+        nrow = static_cast<int>(header.nrow);
+        ncol = static_cast<int>(header.ncol);
+        nnz  = static_cast<PointerType>(header.nnz);
+
+        if(nnz == 0)
+        {
+            fclose(file);
+            return true;
+        }
+
+        allocate_host(nrow + 1, row_offset);
+        allocate_host(nnz, col);
+        allocate_host(nnz, val);
+
+        int offset_type = (header.flags & bin_flag_offset64) ? BIN_INT64 : BIN_INT;
+
+        bool status
+            = bin_read_section(file, header, section[0], offset_type, nrow + 1, *row_offset)
+              && bin_read_section(file, header, section[1], BIN_INT, nnz, *col)
+              && bin_read_section(file, header, section[2], header.value_type, nnz, *val);
+
+        fclose(file);
+
+        if(status != true)
+        {
+            LOG_INFO("ReadFileCSR: could not read from file " << filename);
+
+            free_host(row_offset);
+            free_host(col);
+            free_host(val);
+
+            return false;
+        }
+
+        return true;
+    }
+
+    template <typename ValueType, typename PointerType>
+    bool write_matrix_csr(int                nrow,
+                          int                ncol,
+                          PointerType        nnz,
+                          const PointerType* row_offset,
+                          const int*         col,
+                          const ValueType*   val,
+                          const char*        filename)
+    {
+        FILE* file = fopen(filename, "wb");
+
+        if(!file)
+        {
+            LOG_INFO("WriteFileCSR: cannot open file " << filename);
+            return false;
+        }
+
+        bin_header header;
+
+        header.index_size = sizeof(int);
+        header.value_type = bin_value_type(val);
+        header.flags      = (sizeof(PointerType) > sizeof(int)) ? bin_flag_offset64 : 0;
+        header.nrow       = nrow;
+        header.ncol       = ncol;
+        header.nnz        = nnz;
+
+        const char* data[3] = {reinterpret_cast<const char*>(row_offset),
+                               reinterpret_cast<const char*>(col),
+                               reinterpret_cast<const char*>(val)};
+
+        int64_t size[3]
+            = {static_cast<int64_t>(nnz > 0 ? nrow + 1 : 0)
+                   * static_cast<int64_t>(sizeof(PointerType)),
+               static_cast<int64_t>(nnz) * static_cast<int64_t>(sizeof(int)),
+               static_cast<int64_t>(nnz) * static_cast<int64_t>(sizeof(ValueType))};
+
+        bool status = bin_write(file, bin_csr_header, header, 3, data, size);
+
+        if(fclose(file) != 0 || status != true)
+        {
+            LOG_INFO("WriteFileCSR: could not write to file " << filename);
+            return false;
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool read_matrix_csr_rows(int         row_begin,
+                              int         row_end,
+                              int&        nrow,
+                              int&        ncol,
+                              int&        nnz,
+                              int**       row_offset,
+                              int**       col,
+                              ValueType** val,
+                              const char* filename)
+    {
+        FILE* file = fopen(filename, "rb");
+
+        if(!file)
+        {
+            LOG_INFO("ReadFileCSR: cannot open file " << filename);
+            return false;
+        }
+
+        int         version = bin_read_text(file, bin_csr_header, bin_csr_header_v1);
+        bin_header  header;
+        bin_section section[3];
+
+        if(bin_read_csr_header(file, version, header, section) != true)
+        {
+            LOG_INFO("ReadFileCSR: " << filename << " is not a valid rocALUTION matrix");
+            fclose(file);
+            return false;
+        }
+
+        if(row_begin < 0 || row_begin > row_end || row_end > header.nrow)
+        {
+            LOG_INFO("ReadFileCSR: rows [" << row_begin << ", " << row_end << ") exceed "
+                                           << filename);
+            fclose(file);
+            return false;
+        }
+
+        nrow = row_end - row_begin;
+        ncol = static_cast<int>(header.ncol);
+        nnz  = 0;
+
+        if(nrow == 0 || header.nnz == 0)
+        {
+            fclose(file);
+            return true;
+        }
+
+        // Only the row offsets of the block are read, they locate the column indices
+        // and values of the block in their sections
+        int                  offset_type = (header.flags & bin_flag_offset64) ? BIN_INT64 : BIN_INT;
+        std::vector<int64_t> offset(nrow + 1);
+
+        if(bin_read_range(file, section[0], offset_type, row_begin, nrow + 1, offset.data())
+               != true
+           || offset[0] > offset[nrow])
+        {
+            LOG_INFO("ReadFileCSR: could not read from file " << filename);
+            fclose(file);
+            return false;
+        }
+
+        if(offset[nrow] - offset[0] > std::numeric_limits<int>::max())
+        {
+            LOG_INFO("ReadFileCSR: rows of " << filename << " exceed 32 bit indexing");
+            fclose(file);
+            return false;
+        }
+
+        nnz = static_cast<int>(offset[nrow] - offset[0]);
+
+        if(nnz == 0)
+        {
+            fclose(file);
+            return true;
+        }
+
+        allocate_host(nrow + 1, row_offset);
+        allocate_host(nnz, col);
+        allocate_host(nnz, val);
+
+        for(int i = 0; i < nrow + 1; ++i)
+        {
+            (*row_offset)[i] = static_cast<int>(offset[i] - offset[0]);
+        }
+
+        bool status = bin_read_range(file, section[1], BIN_INT, offset[0], nnz, *col)
+                      && bin_read_range(file, section[2], header.value_type, offset[0], nnz, *val);
+
+        fclose(file);
+
+        if(status != true)
+        {
+            LOG_INFO("ReadFileCSR: could not read from file " << filename);
+
+            free_host(row_offset);
+            free_host(col);
+            free_host(val);
+
+            return false;
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool convert_matrix_csr(const char* input_name, const char* output_name)
+    {
+        FILE* input = fopen(input_name, "rb");
+
+        if(!input)
+        {
+            LOG_INFO("ConvertFileCSR: cannot open file " << input_name);
+            return false;
+        }
+
+        int         version = bin_read_text(input, bin_csr_header, bin_csr_header_v1);
+        bin_header  header;
+        bin_section section[3];
+
+        if(bin_read_csr_header(input, version, header, section) != true)
+        {
+            LOG_INFO("ConvertFileCSR: " << input_name << " is not a valid rocALUTION matrix");
+            fclose(input);
+            return false;
+        }
+
+        FILE* output = fopen(output_name, "wb");
+
+        if(!output)
+        {
+            LOG_INFO("ConvertFileCSR: cannot open file " << output_name);
+            fclose(input);
+            return false;
+        }
+
+        // Row offsets are written as 64 bit integers only if int cannot address nnz
+        int64_t nrow        = header.nrow;
+        int64_t nnz         = header.nnz;
+        int     offset_type = (header.flags & bin_flag_offset64) ? BIN_INT64 : BIN_INT;
+        bool    offset64    = nnz > std::numeric_limits<int>::max();
+
+        bin_header out_header;
+
+        out_header.index_size = sizeof(int);
+        out_header.value_type = bin_value_type(static_cast<const ValueType*>(NULL));
+        out_header.flags      = offset64 ? bin_flag_offset64 : 0;
+        out_header.nrow       = nrow;
+        out_header.ncol       = header.ncol;
+        out_header.nnz        = nnz;
+
+        int64_t size[3]
+            = {(nnz > 0 ? nrow + 1 : 0)
+                   * static_cast<int64_t>(offset64 ? sizeof(int64_t) : sizeof(int)),
+               nnz * static_cast<int64_t>(sizeof(int)),
+               nnz * static_cast<int64_t>(sizeof(ValueType))};
+
+        bin_section out_section[3];
+
+        bool status = bin_write_header(output, bin_csr_header, out_header, 3, size, out_section);
+
+        if(status == true && nnz > 0)
+        {
+            status = (offset64 ? bin_convert_section<int64_t>(input,
+                                                              header,
+                                                              section[0],
+                                                              offset_type,
+                                                              nrow + 1,
+                                                              output,
+                                                              out_section[0])
+                               : bin_convert_section<int>(input,
+                                                          header,
+                                                          section[0],
+                                                          offset_type,
+                                                          nrow + 1,
+                                                          output,
+                                                          out_section[0]))
+                     && bin_convert_section<int>(
+                         input, header, section[1], BIN_INT, nnz, output, out_section[1])
+                     && bin_convert_section<ValueType>(input,
+                                                       header,
+                                                       section[2],
+                                                       header.value_type,
+                                                       nnz,
+                                                       output,
+                                                       out_section[2]);
+        }
+
+        status = status && bin_write_table(output, bin_csr_header, 3, out_section);
+
+        fclose(input);
+
+        if(fclose(output) != 0 || status != true)
+        {
+            LOG_INFO("ConvertFileCSR: could not convert " << input_name << " to "
+                                                          << output_name);
+            return false;
+        }
+
+        return true;
+    }
+
+    template <typename ValueType, typename PointerType>
+    bool map_matrix_csr(int&          nrow,
+                        int&          ncol,
+                        PointerType&  nnz,
+                        PointerType** row_offset,
+                        int**         col,
+                        ValueType**   val,
+                        void**        map,
+                        size_t*       map_size,
+                        const char*   filename)
+    {
+        FILE* file = fopen(filename, "rb");
+
+        if(!file)
+        {
+            LOG_INFO("MapFileCSR: cannot open file " << filename);
+            return false;
+        }
+
+        bin_header  header;
+        bin_section section[3];
+
+        // Only the current container with native types and data can be mapped
+        if(bin_read_text(file, bin_csr_header, bin_csr_header_v1) != 2
+           || bin_read_header(file, header, section, 3) != true
+           || header.value_type != bin_value_type(*val) || header.nnz == 0
+           || ((header.flags & bin_flag_offset64) ? BIN_INT64 : BIN_INT)
+                  != bin_value_type(*row_offset)
+           || header.alignment % sysconf(_SC_PAGESIZE) != 0)
+        {
+            fclose(file);
+            return false;
+        }
+
+        struct stat st;
+
+        if(fstat(fileno(file), &st) != 0
+           || st.st_size < section[2].offset + static_cast<int64_t>(header.nnz * sizeof(ValueType)))
+        {
+            fclose(file);
+            return false;
+        }
+
+        // Private mapping, modifications are never written back to the file. Pages are
+        // only copied when written, hence no swap is reserved for the whole file
+        void* ptr = mmap(NULL,
+                         st.st_size,
+                         PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_NORESERVE,
+                         fileno(file),
+                         0);
+
+        fclose(file);
+
+        if(ptr == MAP_FAILED)
+        {
+            return false;
+        }
+
+        nrow = static_cast<int>(header.nrow);
+        ncol = static_cast<int>(header.ncol);
+        nnz  = static_cast<PointerType>(header.nnz);
+
+        *row_offset = reinterpret_cast<PointerType*>(static_cast<char*>(ptr) + section[0].offset);
+        *col        = reinterpret_cast<int*>(static_cast<char*>(ptr) + section[1].offset);
+        *val        = reinterpret_cast<ValueType*>(static_cast<char*>(ptr) + section[2].offset);
+
+        *map      = ptr;
+        *map_size = st.st_size;
+
+        return true;
+    }
+
+    void unmap_file(void* map, size_t map_size)
+    {
+        munmap(map, map_size);
+    }
+
+    bool read_matrix_csr_nnz(IndexType2& nnz, const char* filename)
+    {
+        FILE* file = fopen(filename, "rb");
+
+        if(!file)
+        {
+            return false;
+        }
+
+        int        version = bin_read_text(file, bin_csr_header, bin_csr_header_v1);
+        bin_header header;
+        bool       status = false;
+
+        if(version == 1)
+        {
+            int size[4];
+
+            if(fread(size, sizeof(int), 4, file) == 4)
+            {
+                nnz    = size[3];
+                status = true;
+            }
+        }
+        else if(version == 2)
+        {
+            if(fread(&header, sizeof(bin_header), 1, file) == 1)
+            {
+                nnz    = header.nnz;
+                status = true;
+            }
+        }
+
+        fclose(file);
+
+        return status;
+    }
+
+    template <typename ValueType>
+    bool read_vector_binary(int& size, ValueType** val, const char* filename)
+    {
+        FILE* file = fopen(filename, "rb");
+
+        if(!file)
+        {
+            LOG_INFO("ReadFileBinary: cannot open file " << filename);
+            return false;
+        }
+
+        int version = bin_read_text(file, bin_vector_header, bin_vector_header_v1);
+
+        if(version == 0)
+        {
+            LOG_INFO("ReadFileBinary: " << filename << " is not a rocALUTION vector");
+            fclose(file);
+            return false;
+        }
+
+        bin_header  header;
+        bin_section section;
+
+        if(version == 1)
+        {
+            // Previous container, int size and double precision values (int for int
+            // vectors) without alignment
+            int v1[2];
+
+            if(fread(v1, sizeof(int), 2, file) != 2)
+            {
+                fclose(file);
+                return false;
+            }
+
+            header.value_type = (bin_value_type(*val) == BIN_INT) ? BIN_INT : BIN_DOUBLE;
+            header.nrow       = v1[1];
+        }
+        else if(bin_read_header(file, header, &section, 1) != true)
+        {
+            LOG_INFO("ReadFileBinary: " << filename << " has an invalid header");
+            fclose(file);
+            return false;
+        }
+
+        size = static_cast<int>(header.nrow);
+
+        if(size == 0)
+        {
+            fclose(file);
+            return true;
+        }
+
+        allocate_host(size, val);
+
+        bool status;
+
+        if(version == 1)
+        {
+            uint64_t hash = bin_checksum_init;
+            status        = bin_read_values(file, header.value_type, size, *val, hash);
+        }
+        else
+        {
+            status = bin_read_section(file, header, section, header.value_type, size, *val);
+        }
+
+        fclose(file);
+
+        if(status != true)
+        {
+            LOG_INFO("ReadFileBinary: could not read from file " << filename);
+            free_host(val);
+
+            return false;
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool write_vector_binary(int size, const ValueType* val, const char* filename)
+    {
+        FILE* file = fopen(filename, "wb");
+
+        if(!file)
+        {
+            LOG_INFO("WriteFileBinary: cannot open file " << filename);
+            return false;
+        }
+
+        bin_header header;
+
+        header.index_size = sizeof(int);
+        header.value_type = bin_value_type(val);
+        header.flags      = 0;
+        header.nrow       = size;
+        header.ncol       = 1;
+        header.nnz        = size;
+
+        const char* data   = reinterpret_cast<const char*>(val);
+        int64_t     nbytes = static_cast<int64_t>(size) * sizeof(ValueType);
+        bool        status = bin_write(file, bin_vector_header, header, 1, &data, &nbytes);
+
+        if(fclose(file) != 0 || status != true)
+        {
+            LOG_INFO("WriteFileBinary: could not write to file " << filename);
+            return false;
+        }
+
+        return true;
+    }
+
+    template bool read_matrix_mtx(int&        nrow,
+                                  int&        ncol,
+                                  IndexType2& nnz,
+                                  int**       row,
+                                  int**       col,
+                                  float**     val,
+                                  const char* filename);
+    template bool read_matrix_mtx(int&        nrow,
+                                  int&        ncol,
+                                  IndexType2& nnz,
+                                  int**       row,
+                                  int**       col,
+                                  double**    val,
+                                  const char* filename);
+#ifdef SUPPORT_COMPLEX
+    template bool read_matrix_mtx(int&                  nrow,
+                                  int&                  ncol,
+                                  IndexType2&           nnz,
+                                  int**                 row,
+                                  int**                 col,
+                                  std::complex<float>** val,
+                                  const char*           filename);
+    template bool read_matrix_mtx(int&                   nrow,
+                                  int&                   ncol,
+                                  IndexType2&            nnz,
+                                  int**                  row,
+                                  int**                  col,
+                                  std::complex<double>** val,
+                                  const char*            filename);
+#endif
+
+    template bool write_matrix_mtx(int          nrow,
+                                   int          ncol,
+                                   IndexType2   nnz,
+                                   const int*   row,
+                                   const int*   col,
+                                   const float* val,
+                                   const char*  filename);
+    template bool write_matrix_mtx(int           nrow,
+                                   int           ncol,
+                                   IndexType2    nnz,
+                                   const int*    row,
+                                   const int*    col,
+                                   const double* val,
+                                   const char*   filename);
+#ifdef SUPPORT_COMPLEX
+    template bool write_matrix_mtx(int                        nrow,
+                                   int                        ncol,
+                                   IndexType2                 nnz,
+                                   const int*                 row,
+                                   const int*                 col,
+                                   const std::complex<float>* val,
+                                   const char*                filename);
+    template bool write_matrix_mtx(int                         nrow,
+                                   int                         ncol,
+                                   IndexType2                  nnz,
+                                   const int*                  row,
+                                   const int*                  col,
+                                   const std::complex<double>* val,
+                                   const char*                 filename);
+#endif
+
+    template bool read_matrix_csr(int&        nrow,
+                                  int&        ncol,
+                                  int&        nnz,
+                                  int**       row_offset,
+                                  int**       col,
+                                  float**     val,
+                                  const char* filename);
+    template bool read_matrix_csr(int&        nrow,
+                                  int&        ncol,
+                                  int&        nnz,
+                                  int**       row_offset,
+                                  int**       col,
+                                  double**    val,
+                                  const char* filename);
+#ifdef SUPPORT_COMPLEX
+    template bool read_matrix_csr(int&                  nrow,
+                                  int&                  ncol,
+                                  int&                  nnz,
+                                  int**                 row_offset,
+                                  int**                 col,
+                                  std::complex<float>** val,
+                                  const char*           filename);
+    template bool read_matrix_csr(int&                   nrow,
+                                  int&                   ncol,
+                                  int&                   nnz,
+                                  int**                  row_offset,
+                                  int**                  col,
+                                  std::complex<double>** val,
+                                  const char*            filename);
+#endif
+
+    template bool read_matrix_csr(int&         nrow,
+                                  int&         ncol,
+                                  IndexType2&  nnz,
+                                  IndexType2** row_offset,
+                                  int**        col,
+                                  float**      val,
+                                  const char*  filename);
+    template bool read_matrix_csr(int&         nrow,
+                                  int&         ncol,
+                                  IndexType2&  nnz,
+                                  IndexType2** row_offset,
+                                  int**        col,
+                                  double**     val,
+                                  const char*  filename);
+#ifdef SUPPORT_COMPLEX
+    template bool read_matrix_csr(int&                  nrow,
+                                  int&                  ncol,
+                                  IndexType2&           nnz,
+                                  IndexType2**          row_offset,
+                                  int**                 col,
+                                  std::complex<float>** val,
+                                  const char*           filename);
+    template bool read_matrix_csr(int&                   nrow,
+                                  int&                   ncol,
+                                  IndexType2&            nnz,
+                                  IndexType2**           row_offset,
+                                  int**                  col,
+                                  std::complex<double>** val,
+                                  const char*            filename);
+#endif
+
+    template bool write_matrix_csr(int          nrow,
+                                   int          ncol,
+                                   int          nnz,
+                                   const int*   row_offset,
+                                   const int*   col,
+                                   const float* val,
+                                   const char*  filename);
+    template bool write_matrix_csr(int           nrow,
+                                   int           ncol,
+                                   int           nnz,
+                                   const int*    row_offset,
+                                   const int*    col,
+                                   const double* val,
+                                   const char*   filename);
+#ifdef SUPPORT_COMPLEX
+    template bool write_matrix_csr(int                        nrow,
+                                   int                        ncol,
+                                   int                        nnz,
+                                   const int*                 row_offset,
+                                   const int*                 col,
+                                   const std::complex<float>* val,
+                                   const char*                filename);
+    template bool write_matrix_csr(int                         nrow,
+                                   int                         ncol,
+                                   int                         nnz,
+                                   const int*                  row_offset,
+                                   const int*                  col,
+                                   const std::complex<double>* val,
+                                   const char*                 filename);
+#endif
+
+    template bool write_matrix_csr(int               nrow,
+                                   int               ncol,
+                                   IndexType2        nnz,
+                                   const IndexType2* row_offset,
+                                   const int*        col,
+                                   const float*      val,
+                                   const char*       filename);
+    template bool write_matrix_csr(int               nrow,
+                                   int               ncol,
+                                   IndexType2        nnz,
+                                   const IndexType2* row_offset,
+                                   const int*        col,
+                                   const double*     val,
+                                   const char*       filename);
+#ifdef SUPPORT_COMPLEX
+    template bool write_matrix_csr(int                        nrow,
+                                   int                        ncol,
+                                   IndexType2                 nnz,
+                                   const IndexType2*          row_offset,
+                                   const int*                 col,
+                                   const std::complex<float>* val,
+                                   const char*                filename);
+    template bool write_matrix_csr(int                         nrow,
+                                   int                         ncol,
+                                   IndexType2                  nnz,
+                                   const IndexType2*           row_offset,
+                                   const int*                  col,
+                                   const std::complex<double>* val,
+                                   const char*                 filename);
+#endif
+
+    template bool map_matrix_csr(int&        nrow,
+                                 int&        ncol,
+                                 int&        nnz,
+                                 int**       row_offset,
+                                 int**       col,
+                                 float**     val,
+                                 void**      map,
+                                 size_t*     map_size,
+                                 const char* filename);
+    template bool map_matrix_csr(int&        nrow,
+                                 int&        ncol,
+                                 int&        nnz,
+                                 int**       row_offset,
+                                 int**       col,
+                                 double**    val,
+                                 void**      map,
+                                 size_t*     map_size,
+                                 const char* filename);
+#ifdef SUPPORT_COMPLEX
+    template bool map_matrix_csr(int&                  nrow,
+                                 int&                  ncol,
+                                 int&                  nnz,
+                                 int**                 row_offset,
+                                 int**                 col,
+                                 std::complex<float>** val,
+                                 void**                map,
+                                 size_t*               map_size,
+                                 const char*           filename);
+    template bool map_matrix_csr(int&                   nrow,
+                                 int&                   ncol,
+                                 int&                   nnz,
+                                 int**                  row_offset,
+                                 int**                  col,
+                                 std::complex<double>** val,
+                                 void**                 map,
+                                 size_t*                map_size,
+                                 const char*            filename);
+#endif
+
+    template bool map_matrix_csr(int&         nrow,
+                                 int&         ncol,
+                                 IndexType2&  nnz,
+                                 IndexType2** row_offset,
+                                 int**        col,
+                                 float**      val,
+                                 void**       map,
+                                 size_t*      map_size,
+                                 const char*  filename);
+    template bool map_matrix_csr(int&         nrow,
+                                 int&         ncol,
+                                 IndexType2&  nnz,
+                                 IndexType2** row_offset,
+                                 int**        col,
+                                 double**     val,
+                                 void**       map,
+                                 size_t*      map_size,
+                                 const char*  filename);
+#ifdef SUPPORT_COMPLEX
+    template bool map_matrix_csr(int&                  nrow,
+                                 int&                  ncol,
+                                 IndexType2&           nnz,
+                                 IndexType2**          row_offset,
+                                 int**                 col,
+                                 std::complex<float>** val,
+                                 void**                map,
+                                 size_t*               map_size,
+                                 const char*           filename);
+    template bool map_matrix_csr(int&                   nrow,
+                                 int&                   ncol,
+                                 IndexType2&            nnz,
+                                 IndexType2**           row_offset,
+                                 int**                  col,
+                                 std::complex<double>** val,
+                                 void**                 map,
+                                 size_t*                map_size,
+                                 const char*            filename);
+#endif
+
+    template bool read_matrix_csr_rows(int         row_begin,
+                                       int         row_end,
+                                       int&        nrow,
+                                       int&        ncol,
+                                       int&        nnz,
+                                       int**       row_offset,
+                                       int**       col,
+                                       float**     val,
+                                       const char* filename);
+    template bool read_matrix_csr_rows(int         row_begin,
+                                       int         row_end,
+                                       int&        nrow,
+                                       int&        ncol,
+                                       int&        nnz,
+                                       int**       row_offset,
+                                       int**       col,
+                                       double**    val,
+                                       const char* filename);
+#ifdef SUPPORT_COMPLEX
+    template bool read_matrix_csr_rows(int                   row_begin,
+                                       int                   row_end,
+                                       int&                  nrow,
+                                       int&                  ncol,
+                                       int&                  nnz,
+                                       int**                 row_offset,
+                                       int**                 col,
+                                       std::complex<float>** val,
+                                       const char*           filename);
+    template bool read_matrix_csr_rows(int                    row_begin,
+                                       int                    row_end,
+                                       int&                   nrow,
+                                       int&                   ncol,
+                                       int&                   nnz,
+                                       int**                  row_offset,
+                                       int**                  col,
+                                       std::complex<double>** val,
+                                       const char*            filename);
+#endif
+
+    template bool convert_matrix_csr<float>(const char* input_name, const char* output_name);
+    template bool convert_matrix_csr<double>(const char* input_name, const char* output_name);
+#ifdef SUPPORT_COMPLEX
+    template bool convert_matrix_csr<std::complex<float>>(const char* input_name,
+                                                          const char* output_name);
+    template bool convert_matrix_csr<std::complex<double>>(const char* input_name,
+                                                           const char* output_name);
+#endif
+
+    template bool read_vector_binary(int& size, float** val, const char* filename);
+    template bool read_vector_binary(int& size, double** val, const char* filename);
+    template bool read_vector_binary(int& size, int** val, const char* filename);
+#ifdef SUPPORT_COMPLEX
+    template bool read_vector_binary(int& size, std::complex<float>** val, const char* filename);
+    template bool read_vector_binary(int& size, std::complex<double>** val, const char* filename);
+#endif
+
+    template bool write_vector_binary(int size, const float* val, const char* filename);
+    template bool write_vector_binary(int size, const double* val, const char* filename);
+    template bool write_vector_binary(int size, const int* val, const char* filename);
+#ifdef SUPPORT_COMPLEX
+    template bool write_vector_binary(int                        size,
+                                      const std::complex<float>* val,
+                                      const char*                filename);
+    template bool write_vector_binary(int                         size,
+                                      const std::complex<double>* val,
+                                      const char*                 filename);
 #endif
 
 } // namespace rocalution
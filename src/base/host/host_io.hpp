@@ -24,6 +24,9 @@
 #ifndef ROCALUTION_HOST_IO_HPP_
 #define ROCALUTION_HOST_IO_HPP_
 
+#include "../../utils/types.hpp"
+
+#include <stddef.h>
 #include <string>
 
 namespace rocalution
@@ -32,7 +35,7 @@ namespace rocalution
     template <typename ValueType>
     bool read_matrix_mtx(int&        nrow,
                          int&        ncol,
-                         int&        nnz,
+                         IndexType2& nnz,
                          int**       row,
                          int**       col,
                          ValueType** val,
@@ -41,12 +44,71 @@ namespace rocalution
     template <typename ValueType>
     bool write_matrix_mtx(int              nrow,
                           int              ncol,
-                          int              nnz,
+                          IndexType2       nnz,
                           const int*       row,
                           const int*       col,
                           const ValueType* val,
                           const char*      filename);
 
+    // PointerType is int or IndexType2, files with more non-zero entries than int can
+    // address store 64 bit row offsets
+    template <typename ValueType, typename PointerType>
+    bool read_matrix_csr(int&          nrow,
+                         int&          ncol,
+                         PointerType&  nnz,
+                         PointerType** row_offset,
+                         int**         col,
+                         ValueType**   val,
+                         const char*   filename);
+
+    template <typename ValueType, typename PointerType>
+    bool write_matrix_csr(int                nrow,
+                          int                ncol,
+                          PointerType        nnz,
+                          const PointerType* row_offset,
+                          const int*         col,
+                          const ValueType*   val,
+                          const char*        filename);
+
+    // Rows [row_begin, row_end) of a binary CSR file, only the corresponding parts of the
+    // file are read. Column indices remain global
+    template <typename ValueType>
+    bool read_matrix_csr_rows(int         row_begin,
+                              int         row_end,
+                              int&        nrow,
+                              int&        ncol,
+                              int&        nnz,
+                              int**       row_offset,
+                              int**       col,
+                              ValueType** val,
+                              const char* filename);
+
+    // Streams a binary CSR file into the current container with ValueType values
+    template <typename ValueType>
+    bool convert_matrix_csr(const char* input_name, const char* output_name);
+
+    template <typename ValueType, typename PointerType>
+    bool map_matrix_csr(int&          nrow,
+                        int&          ncol,
+                        PointerType&  nnz,
+                        PointerType** row_offset,
+                        int**         col,
+                        ValueType**   val,
+                        void**        map,
+                        size_t*       map_size,
+                        const char*   filename);
+
+    void unmap_file(void* map, size_t map_size);
+
+    // Number of non-zero entries of a binary CSR file, without reading the matrix
+    bool read_matrix_csr_nnz(IndexType2& nnz, const char* filename);
+
+    template <typename ValueType>
+    bool read_vector_binary(int& size, ValueType** val, const char* filename);
+
+    template <typename ValueType>
+    bool write_vector_binary(int size, const ValueType* val, const char* filename);
+
 } // namespace rocalution
 
 #endif // ROCALUTION_HOST_IO_HPP_
@@ -31,6 +31,7 @@
 #include "../../utils/allocate_free.hpp"
 #include "../../utils/def.hpp"
 #include "../../utils/log.hpp"
+#include "../../utils/types.hpp"
 #include "host_conversion.hpp"
 #include "host_io.hpp"
 #include "host_matrix_csr.hpp"
@@ -39,6 +40,7 @@
 #include <algorithm>
 #include <complex>
 #include <stdio.h>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -49,6 +51,85 @@
 namespace rocalution
 {
 
+    template <typename ValueType, typename IndexType>
+    void coo_spmv(IndexType2                             nnz,
+                  const MatrixCOO<ValueType, IndexType>& mat,
+                  ValueType                              scalar,
+                  const ValueType*                       in,
+                  ValueType*                             out)
+    {
+#ifdef _OPENMP
+        int nthreads = omp_get_max_threads();
+#else
+        int nthreads = 1;
+#endif
+
+        // Not worth to split
+        if(nthreads < 2 || nnz < 2 * nthreads)
+        {
+            for(IndexType2 i = 0; i < nnz; ++i)
+            {
+                out[mat.row[i]] += scalar * mat.val[i] * in[mat.col[i]];
+            }
+
+            return;
+        }
+
+        // Row and partial sum of the last segment of each part
+        std::vector<IndexType> carry_row(nthreads, -1);
+        std::vector<ValueType> carry_val(nthreads, static_cast<ValueType>(0));
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nthreads)
+#endif
+        {
+#ifdef _OPENMP
+            int tid = omp_get_thread_num();
+            int nt  = omp_get_num_threads();
+#else
+            int tid = 0;
+            int nt  = 1;
+#endif
+
+            // nnz balanced part of this thread
+            IndexType2 begin = nnz * tid / nt;
+            IndexType2 end   = nnz * (tid + 1) / nt;
+
+            if(begin < end)
+            {
+                IndexType row = mat.row[begin];
+                ValueType sum = static_cast<ValueType>(0);
+
+                for(IndexType2 i = begin; i < end; ++i)
+                {
+                    // Segment is complete, no other thread writes to this row
+                    if(mat.row[i] != row)
+                    {
+                        out[row] += scalar * sum;
+
+                        row = mat.row[i];
+                        sum = static_cast<ValueType>(0);
+                    }
+
+                    sum += mat.val[i] * in[mat.col[i]];
+                }
+
+                // The last segment might continue in the next part
+                carry_row[tid] = row;
+                carry_val[tid] = sum;
+            }
+        }
+
+        // Carry-out fix-up
+        for(int i = 0; i < nthreads; ++i)
+        {
+            if(carry_row[i] >= 0)
+            {
+                out[carry_row[i]] += scalar * carry_val[i];
+            }
+        }
+    }
+
     template <typename ValueType>
     HostMatrixCOO<ValueType>::HostMatrixCOO()
     {
@@ -65,6 +146,7 @@ namespace rocalution
         this->mat_.row = NULL;
         this->mat_.col = NULL;
         this->mat_.val = NULL;
+
         this->set_backend(local_backend);
     }
 
@@ -97,7 +179,7 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void HostMatrixCOO<ValueType>::AllocateCOO(int nnz, int nrow, int ncol)
+    void HostMatrixCOO<ValueType>::AllocateCOO(IndexType2 nnz, int nrow, int ncol)
     {
         assert(nnz >= 0);
         assert(ncol >= 0);
@@ -126,7 +208,7 @@ namespace rocalution
 
     template <typename ValueType>
     void HostMatrixCOO<ValueType>::SetDataPtrCOO(
-        int** row, int** col, ValueType** val, int nnz, int nrow, int ncol)
+        int** row, int** col, ValueType** val, IndexType2 nnz, int nrow, int ncol)
     {
         assert(*row != NULL);
         assert(*col != NULL);
@@ -170,17 +252,19 @@ namespace rocalution
     template <typename ValueType>
     void HostMatrixCOO<ValueType>::CopyFromCOO(const int* row, const int* col, const ValueType* val)
     {
-        if(this->nnz_ > 0)
+        IndexType2 nnz = this->nnz_;
+
+        if(nnz > 0)
         {
             assert(this->nrow_ > 0);
             assert(this->ncol_ > 0);
 
-            _set_omp_backend_threads(this->local_backend_, this->nnz_);
+            _set_omp_backend_threads(this->local_backend_, nnz);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(int i = 0; i < this->nnz_; ++i)
+            for(IndexType2 i = 0; i < nnz; ++i)
             {
                 this->mat_.row[i] = row[i];
             }
@@ -188,7 +272,7 @@ namespace rocalution
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(int j = 0; j < this->nnz_; ++j)
+            for(IndexType2 j = 0; j < nnz; ++j)
             {
                 this->mat_.col[j] = col[j];
             }
@@ -196,7 +280,7 @@ namespace rocalution
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(int j = 0; j < this->nnz_; ++j)
+            for(IndexType2 j = 0; j < nnz; ++j)
             {
                 this->mat_.val[j] = val[j];
             }
@@ -206,17 +290,19 @@ namespace rocalution
     template <typename ValueType>
     void HostMatrixCOO<ValueType>::CopyToCOO(int* row, int* col, ValueType* val) const
     {
-        if(this->nnz_ > 0)
+        IndexType2 nnz = this->nnz_;
+
+        if(nnz > 0)
         {
             assert(this->nrow_ > 0);
             assert(this->ncol_ > 0);
 
-            _set_omp_backend_threads(this->local_backend_, this->nnz_);
+            _set_omp_backend_threads(this->local_backend_, nnz);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(int i = 0; i < this->nnz_; ++i)
+            for(IndexType2 i = 0; i < nnz; ++i)
             {
                 row[i] = this->mat_.row[i];
             }
@@ -224,7 +310,7 @@ namespace rocalution
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(int j = 0; j < this->nnz_; ++j)
+            for(IndexType2 j = 0; j < nnz; ++j)
             {
                 col[j] = this->mat_.col[j];
             }
@@ -232,7 +318,7 @@ namespace rocalution
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(int j = 0; j < this->nnz_; ++j)
+            for(IndexType2 j = 0; j < nnz; ++j)
             {
                 val[j] = this->mat_.val[j];
             }
@@ -256,14 +342,16 @@ namespace rocalution
             assert((this->nnz_ == cast_mat->nnz_) && (this->nrow_ == cast_mat->nrow_)
                    && (this->ncol_ == cast_mat->ncol_));
 
-            if(this->nnz_ > 0)
+            IndexType2 nnz = this->nnz_;
+
+            if(nnz > 0)
             {
-                _set_omp_backend_threads(this->local_backend_, this->nnz_);
+                _set_omp_backend_threads(this->local_backend_, nnz);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-                for(int j = 0; j < this->nnz_; ++j)
+                for(IndexType2 j = 0; j < nnz; ++j)
                 {
                     this->mat_.row[j] = cast_mat->mat_.row[j];
                 }
@@ -271,7 +359,7 @@ namespace rocalution
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-                for(int j = 0; j < this->nnz_; ++j)
+                for(IndexType2 j = 0; j < nnz; ++j)
                 {
                     this->mat_.col[j] = cast_mat->mat_.col[j];
                 }
@@ -279,7 +367,7 @@ namespace rocalution
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-                for(int j = 0; j < this->nnz_; ++j)
+                for(IndexType2 j = 0; j < nnz; ++j)
                 {
                     this->mat_.val[j] = cast_mat->mat_.val[j];
                 }
@@ -322,7 +410,26 @@ namespace rocalution
         {
             this->Clear();
 
-            if(csr_to_coo(this->local_backend_.OpenMP_threads,
+            if(csr_to_coo(_get_omp_backend_threads(this->local_backend_, cast_mat->nrow_),
+                          static_cast<int>(cast_mat->nnz_),
+                          cast_mat->nrow_,
+                          cast_mat->ncol_,
+                          cast_mat->mat_,
+                          &this->mat_)
+               == true)
+            {
+                this->nrow_ = cast_mat->nrow_;
+                this->ncol_ = cast_mat->ncol_;
+                this->nnz_  = cast_mat->nnz_;
+
+                return true;
+            }
+        }
+
+        if(const HostMatrixCSRBase<ValueType, IndexType2>* cast_mat
+           = dynamic_cast<const HostMatrixCSRBase<ValueType, IndexType2>*>(&mat))
+        {
+            if(csr_to_coo(_get_omp_backend_threads(this->local_backend_, cast_mat->nrow_),
                           cast_mat->nnz_,
                           cast_mat->nrow_,
                           cast_mat->ncol_,
@@ -344,9 +451,9 @@ namespace rocalution
     template <typename ValueType>
     bool HostMatrixCOO<ValueType>::ReadFileMTX(const std::string filename)
     {
-        int nrow;
-        int ncol;
-        int nnz;
+        int        nrow;
+        int        ncol;
+        IndexType2 nnz;
 
         int*       row = NULL;
         int*       col = NULL;
@@ -411,11 +518,8 @@ namespace rocalution
             cast_out->vec_[i] = static_cast<ValueType>(0);
         }
 
-        for(int i = 0; i < this->nnz_; ++i)
-        {
-            cast_out->vec_[this->mat_.row[i]]
-                += this->mat_.val[i] * cast_in->vec_[this->mat_.col[i]];
-        }
+        coo_spmv(
+            this->nnz_, this->mat_, static_cast<ValueType>(1), cast_in->vec_, cast_out->vec_);
     }
 
     template <typename ValueType>
@@ -436,25 +540,25 @@ namespace rocalution
             assert(cast_in != NULL);
             assert(cast_out != NULL);
 
-            for(int i = 0; i < this->nnz_; ++i)
-            {
-                cast_out->vec_[this->mat_.row[i]]
-                    += scalar * this->mat_.val[i] * cast_in->vec_[this->mat_.col[i]];
-            }
+            _set_omp_backend_threads(this->local_backend_, this->nnz_);
+
+            coo_spmv(this->nnz_, this->mat_, scalar, cast_in->vec_, cast_out->vec_);
         }
     }
 
     template <typename ValueType>
     bool HostMatrixCOO<ValueType>::Sort(void)
     {
-        if(this->nnz_ > 0)
+        IndexType2 nnz = this->nnz_;
+
+        if(nnz > 0)
         {
             // Sort by row and column index
-            std::vector<int> perm(this->nnz_);
+            std::vector<IndexType2> perm(nnz);
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(int i = 0; i < this->nnz_; ++i)
+            for(IndexType2 i = 0; i < nnz; ++i)
             {
                 perm[i] = i;
             }
@@ -467,12 +571,12 @@ namespace rocalution
             this->mat_.col = NULL;
             this->mat_.val = NULL;
 
-            allocate_host(this->nnz_, &this->mat_.row);
-            allocate_host(this->nnz_, &this->mat_.col);
-            allocate_host(this->nnz_, &this->mat_.val);
+            allocate_host(nnz, &this->mat_.row);
+            allocate_host(nnz, &this->mat_.col);
+            allocate_host(nnz, &this->mat_.val);
 
             // Compare function object to sort by row first, then by column
-            std::sort(perm.begin(), perm.end(), [&](const int& a, const int& b) {
+            std::sort(perm.begin(), perm.end(), [&](const IndexType2& a, const IndexType2& b) {
                 if(row[a] < row[b])
                     return true;
                 if(row[a] == row[b])
@@ -483,7 +587,7 @@ namespace rocalution
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(int i = 0; i < this->nnz_; ++i)
+            for(IndexType2 i = 0; i < nnz; ++i)
             {
                 this->mat_.row[i] = row[perm[i]];
                 this->mat_.col[i] = col[perm[i]];
@@ -507,16 +611,18 @@ namespace rocalution
         const HostVector<int>* cast_perm = dynamic_cast<const HostVector<int>*>(&permutation);
         assert(cast_perm != NULL);
 
+        IndexType2 nnz = this->nnz_;
+
         HostMatrixCOO<ValueType> src(this->local_backend_);
-        src.AllocateCOO(this->nnz_, this->nrow_, this->ncol_);
+        src.AllocateCOO(nnz, this->nrow_, this->ncol_);
         src.CopyFrom(*this);
 
-        _set_omp_backend_threads(this->local_backend_, this->nnz_);
+        _set_omp_backend_threads(this->local_backend_, nnz);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for(int i = 0; i < this->nnz_; ++i)
+        for(IndexType2 i = 0; i < nnz; ++i)
         {
             this->mat_.row[i] = cast_perm->vec_[src.mat_.row[i]];
             this->mat_.col[i] = cast_perm->vec_[src.mat_.col[i]];
@@ -534,11 +640,13 @@ namespace rocalution
         const HostVector<int>* cast_perm = dynamic_cast<const HostVector<int>*>(&permutation);
         assert(cast_perm != NULL);
 
+        IndexType2 nnz = this->nnz_;
+
         HostMatrixCOO<ValueType> src(this->local_backend_);
-        src.AllocateCOO(this->nnz_, this->nrow_, this->ncol_);
+        src.AllocateCOO(nnz, this->nrow_, this->ncol_);
         src.CopyFrom(*this);
 
-        _set_omp_backend_threads(this->local_backend_, this->nnz_);
+        _set_omp_backend_threads(this->local_backend_, nnz);
 
         // TODO
         // Is there a better way?
@@ -556,7 +664,7 @@ namespace rocalution
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for(int i = 0; i < this->nnz_; ++i)
+        for(IndexType2 i = 0; i < nnz; ++i)
         {
             this->mat_.row[i] = pb[src.mat_.row[i]];
             this->mat_.col[i] = pb[src.mat_.col[i]];
@@ -570,12 +678,14 @@ namespace rocalution
     template <typename ValueType>
     bool HostMatrixCOO<ValueType>::Scale(ValueType alpha)
     {
-        _set_omp_backend_threads(this->local_backend_, this->nnz_);
+        IndexType2 nnz = this->nnz_;
+
+        _set_omp_backend_threads(this->local_backend_, nnz);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for(int i = 0; i < this->nnz_; ++i)
+        for(IndexType2 i = 0; i < nnz; ++i)
         {
             this->mat_.val[i] *= alpha;
         }
@@ -586,12 +696,14 @@ namespace rocalution
     template <typename ValueType>
     bool HostMatrixCOO<ValueType>::ScaleDiagonal(ValueType alpha)
     {
-        _set_omp_backend_threads(this->local_backend_, this->nnz_);
+        IndexType2 nnz = this->nnz_;
+
+        _set_omp_backend_threads(this->local_backend_, nnz);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for(int i = 0; i < this->nnz_; ++i)
+        for(IndexType2 i = 0; i < nnz; ++i)
         {
             if(this->mat_.row[i] == this->mat_.col[i])
             {
@@ -605,12 +717,14 @@ namespace rocalution
     template <typename ValueType>
     bool HostMatrixCOO<ValueType>::ScaleOffDiagonal(ValueType alpha)
     {
-        _set_omp_backend_threads(this->local_backend_, this->nnz_);
+        IndexType2 nnz = this->nnz_;
+
+        _set_omp_backend_threads(this->local_backend_, nnz);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for(int i = 0; i < this->nnz_; ++i)
+        for(IndexType2 i = 0; i < nnz; ++i)
         {
             if(this->mat_.row[i] != this->mat_.col[i])
             {
@@ -624,12 +738,14 @@ namespace rocalution
     template <typename ValueType>
     bool HostMatrixCOO<ValueType>::AddScalar(ValueType alpha)
     {
-        _set_omp_backend_threads(this->local_backend_, this->nnz_);
+        IndexType2 nnz = this->nnz_;
+
+        _set_omp_backend_threads(this->local_backend_, nnz);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for(int i = 0; i < this->nnz_; ++i)
+        for(IndexType2 i = 0; i < nnz; ++i)
         {
             this->mat_.val[i] += alpha;
         }
@@ -640,12 +756,14 @@ namespace rocalution
     template <typename ValueType>
     bool HostMatrixCOO<ValueType>::AddScalarDiagonal(ValueType alpha)
     {
-        _set_omp_backend_threads(this->local_backend_, this->nnz_);
+        IndexType2 nnz = this->nnz_;
+
+        _set_omp_backend_threads(this->local_backend_, nnz);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for(int i = 0; i < this->nnz_; ++i)
+        for(IndexType2 i = 0; i < nnz; ++i)
         {
             if(this->mat_.row[i] == this->mat_.col[i])
             {
@@ -659,12 +777,14 @@ namespace rocalution
     template <typename ValueType>
     bool HostMatrixCOO<ValueType>::AddScalarOffDiagonal(ValueType alpha)
     {
-        _set_omp_backend_threads(this->local_backend_, this->nnz_);
+        IndexType2 nnz = this->nnz_;
+
+        _set_omp_backend_threads(this->local_backend_, nnz);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for(int i = 0; i < this->nnz_; ++i)
+        for(IndexType2 i = 0; i < nnz; ++i)
         {
             if(this->mat_.row[i] != this->mat_.col[i])
             {
@@ -682,4 +802,30 @@ namespace rocalution
     template class HostMatrixCOO<std::complex<float>>;
 #endif
 
+    template void coo_spmv(IndexType2                    nnz,
+                           const MatrixCOO<double, int>& mat,
+                           double                        scalar,
+                           const double*                 in,
+                           double*                       out);
+
+    template void coo_spmv(IndexType2                   nnz,
+                           const MatrixCOO<float, int>& mat,
+                           float                        scalar,
+                           const float*                 in,
+                           float*                       out);
+
+#ifdef SUPPORT_COMPLEX
+    template void coo_spmv(IndexType2                                  nnz,
+                           const MatrixCOO<std::complex<double>, int>& mat,
+                           std::complex<double>                        scalar,
+                           const std::complex<double>*                 in,
+                           std::complex<double>*                       out);
+
+    template void coo_spmv(IndexType2                                 nnz,
+                           const MatrixCOO<std::complex<float>, int>& mat,
+                           std::complex<float>                        scalar,
+                           const std::complex<float>*                 in,
+                           std::complex<float>*                       out);
+#endif
+
 } // namespace rocalution
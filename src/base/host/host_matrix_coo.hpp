@@ -46,10 +46,10 @@ namespace rocalution
         }
 
         virtual void Clear(void);
-        virtual void AllocateCOO(int nnz, int nrow, int ncol);
+        virtual void AllocateCOO(IndexType2 nnz, int nrow, int ncol);
 
-        virtual void
-                     SetDataPtrCOO(int** row, int** col, ValueType** val, int nnz, int nrow, int ncol);
+        virtual void SetDataPtrCOO(
+            int** row, int** col, ValueType** val, IndexType2 nnz, int nrow, int ncol);
         virtual void LeaveDataPtrCOO(int** row, int** col, ValueType** val);
 
         virtual bool Scale(ValueType alpha);
@@ -85,6 +85,8 @@ namespace rocalution
         friend class BaseVector<ValueType>;
         friend class HostVector<ValueType>;
         friend class HostMatrixCSR<ValueType>;
+        friend class HostMatrixCSRBase<ValueType, int>;
+        friend class HostMatrixCSRBase<ValueType, IndexType2>;
         friend class HostMatrixDIA<ValueType>;
         friend class HostMatrixELL<ValueType>;
         friend class HostMatrixHYB<ValueType>;
@@ -93,6 +95,16 @@ namespace rocalution
         friend class HIPAcceleratorMatrixCOO<ValueType>;
     };
 
+    // Computes out = out + scalar * mat * in for a row sorted COO matrix. The non-zeros
+    // are split evenly among the OpenMP threads, each thread reduces the row segments of
+    // its part and the partial sums of rows crossing a part boundary are added at the end
+    template <typename ValueType, typename IndexType>
+    void coo_spmv(IndexType2                             nnz,
+                  const MatrixCOO<ValueType, IndexType>& mat,
+                  ValueType                              scalar,
+                  const ValueType*                       in,
+                  ValueType*                             out);
+
 } // namespace rocalution
 
 #endif // ROCALUTION_HOST_MATRIX_COO_HPP_
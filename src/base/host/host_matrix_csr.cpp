@@ -27,7 +27,9 @@
 #include "../../utils/log.hpp"
 #include "../../utils/math_functions.hpp"
 #include "../matrix_formats_ind.hpp"
+#include "host_amg.hpp"
 #include "host_conversion.hpp"
+#include "host_io.hpp"
 #include "host_matrix_bcsr.hpp"
 #include "host_matrix_coo.hpp"
 #include "host_matrix_dense.hpp"
@@ -35,6 +37,8 @@
 #include "host_matrix_ell.hpp"
 #include "host_matrix_hyb.hpp"
 #include "host_matrix_mcsr.hpp"
+#include "host_matrix_powers.hpp"
+#include "host_ordering.hpp"
 #include "host_vector.hpp"
 #include "version.hpp"
 
@@ -62,44 +66,80 @@
 namespace rocalution
 {
 
-    template <typename ValueType>
-    HostMatrixCSR<ValueType>::HostMatrixCSR()
+    // Working set of a matrix powers tile (matrix rows and basis vectors) in bytes
+    static const int matrix_powers_cache_size = 2 * 1024 * 1024;
+
+    // Maximal work of the tiled matrix powers kernel relative to plain SpMVs
+    static const double matrix_powers_redundancy = 1.5;
+
+    // Number of consecutive rows that are numbered by a thread in a block permutation
+    static const int permutation_block_size = 4096;
+
+    template <typename ValueType, typename PointerType>
+    HostMatrixCSRBase<ValueType, PointerType>::HostMatrixCSRBase()
     {
         // no default constructors
         LOG_INFO("no default constructor");
         FATAL_ERROR(__FILE__, __LINE__);
     }
 
-    template <typename ValueType>
-    HostMatrixCSR<ValueType>::HostMatrixCSR(const Rocalution_Backend_Descriptor local_backend)
+    template <typename ValueType, typename PointerType>
+    HostMatrixCSRBase<ValueType, PointerType>::HostMatrixCSRBase(
+        const Rocalution_Backend_Descriptor local_backend)
     {
-        log_debug(this, "HostMatrixCSR::HostMatrixCSR()", "constructor with local_backend");
+        log_debug(this, "HostMatrixCSRBase::HostMatrixCSRBase()", "constructor with local_backend");
 
         this->mat_.row_offset = NULL;
         this->mat_.col        = NULL;
         this->mat_.val        = NULL;
         this->set_backend(local_backend);
 
-        this->L_diag_unit_ = false;
-        this->U_diag_unit_ = false;
+        this->map_      = NULL;
+        this->map_size_ = 0;
+
+        this->spmv_parts_ = 0;
+        this->spmv_row_   = NULL;
+        this->spmv_nnz_   = NULL;
     }
 
-    template <typename ValueType>
-    HostMatrixCSR<ValueType>::~HostMatrixCSR()
+    template <typename ValueType, typename PointerType>
+    HostMatrixCSRBase<ValueType, PointerType>::~HostMatrixCSRBase()
     {
-        log_debug(this, "HostMatrixCSR::~HostMatrixCSR()", "destructor");
+        log_debug(this, "HostMatrixCSRBase::~HostMatrixCSRBase()", "destructor");
 
         this->Clear();
     }
 
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::Clear()
+    template <typename ValueType, typename PointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::Clear()
     {
         if(this->nnz_ > 0)
         {
-            free_host(&this->mat_.row_offset);
-            free_host(&this->mat_.col);
-            free_host(&this->mat_.val);
+            if(this->map_ != NULL)
+            {
+                unmap_file(this->map_, this->map_size_);
+
+                this->map_      = NULL;
+                this->map_size_ = 0;
+
+                this->mat_.row_offset = NULL;
+                this->mat_.col        = NULL;
+                this->mat_.val        = NULL;
+            }
+            else
+            {
+                free_host(&this->mat_.row_offset);
+                free_host(&this->mat_.col);
+                free_host(&this->mat_.val);
+            }
+
+            if(this->spmv_parts_ > 0)
+            {
+                free_host(&this->spmv_row_);
+                free_host(&this->spmv_nnz_);
+
+                this->spmv_parts_ = 0;
+            }
 
             this->nrow_ = 0;
             this->ncol_ = 0;
@@ -107,26 +147,39 @@ namespace rocalution
         }
     }
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::Zeros(void)
+    template <typename ValueType, typename PointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::unmap_(void)
     {
-        if(this->nnz_ > 0)
+        if(this->map_ == NULL)
         {
-            set_to_zero_host(this->nnz_, mat_.val);
+            return;
         }
 
-        return true;
+        PointerType* row_offset = NULL;
+        int*         col        = NULL;
+        ValueType*   val        = NULL;
+
+        allocate_host(this->nrow_ + 1, &row_offset);
+        allocate_host(this->nnz_, &col);
+        allocate_host(this->nnz_, &val);
+
+        memcpy(row_offset, this->mat_.row_offset, (this->nrow_ + 1) * sizeof(PointerType));
+        memcpy(col, this->mat_.col, this->nnz_ * sizeof(int));
+        memcpy(val, this->mat_.val, this->nnz_ * sizeof(ValueType));
+
+        this->set_data_ptr_(&row_offset, &col, &val, this->nnz_, this->nrow_, this->ncol_);
     }
 
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::Info(void) const
+    template <typename ValueType, typename PointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::Info(void) const
     {
-        LOG_INFO(
-            "HostMatrixCSR<ValueType>, OpenMP threads: " << this->local_backend_.OpenMP_threads);
+        LOG_INFO("HostMatrixCSR<ValueType>, " << 8 * sizeof(PointerType)
+                                              << " bit row offsets, OpenMP threads: "
+                                              << this->local_backend_.OpenMP_threads);
     }
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::Check(void) const
+    template <typename ValueType, typename PointerType>
+    bool HostMatrixCSRBase<ValueType, PointerType>::Check(void) const
     {
         bool sorted = true;
 
@@ -158,7 +211,7 @@ namespace rocalution
 
             for(int ai = 0; ai < this->nrow_ + 1; ++ai)
             {
-                int row = this->mat_.row_offset[ai];
+                PointerType row = this->mat_.row_offset[ai];
                 if((row < 0) || (row > this->nnz_))
                 {
                     LOG_VERBOSE_INFO(
@@ -172,7 +225,8 @@ namespace rocalution
             {
                 int s = this->mat_.col[this->mat_.row_offset[ai]];
 
-                for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+                for(PointerType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1];
+                    ++aj)
                 {
                     int col = this->mat_.col[aj];
 
@@ -220,10 +274,11 @@ namespace rocalution
         return true;
     }
 
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::AllocateCSR(int nnz, int nrow, int ncol)
+    template <typename ValueType, typename PointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::AllocateCSR(IndexType2 nnz, int nrow, int ncol)
     {
         assert(nnz >= 0);
+        assert(nnz <= std::numeric_limits<PointerType>::max());
         assert(ncol >= 0);
         assert(nrow >= 0);
 
@@ -238,9 +293,9 @@ namespace rocalution
             allocate_host(nnz, &this->mat_.col);
             allocate_host(nnz, &this->mat_.val);
 
-            set_to_zero_host(nrow + 1, mat_.row_offset);
-            set_to_zero_host(nnz, mat_.col);
-            set_to_zero_host(nnz, mat_.val);
+            set_to_zero_host(nrow + 1, this->mat_.row_offset);
+            set_to_zero_host(nnz, this->mat_.col);
+            set_to_zero_host(nnz, this->mat_.val);
 
             this->nrow_ = nrow;
             this->ncol_ = ncol;
@@ -248,9 +303,47 @@ namespace rocalution
         }
     }
 
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::SetDataPtrCSR(
+    template <typename ValueType, typename PointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::SetDataPtrCSR(
         int** row_offset, int** col, ValueType** val, int nnz, int nrow, int ncol)
+    {
+        this->set_data_ptr_(row_offset, col, val, nnz, nrow, ncol);
+    }
+
+    template <typename ValueType, typename PointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::SetDataPtrCSR64(IndexType2** row_offset,
+                                                                    int**        col,
+                                                                    ValueType**  val,
+                                                                    IndexType2   nnz,
+                                                                    int          nrow,
+                                                                    int          ncol)
+    {
+        this->set_data_ptr_(row_offset, col, val, nnz, nrow, ncol);
+    }
+
+    template <typename ValueType, typename PointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::LeaveDataPtrCSR(int**       row_offset,
+                                                                    int**       col,
+                                                                    ValueType** val)
+    {
+        this->leave_data_ptr_(row_offset, col, val);
+    }
+
+    template <typename ValueType, typename PointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::LeaveDataPtrCSR64(IndexType2** row_offset,
+                                                                      int**        col,
+                                                                      ValueType**  val)
+    {
+        this->leave_data_ptr_(row_offset, col, val);
+    }
+
+    template <typename ValueType, typename PointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::set_data_ptr_(PointerType** row_offset,
+                                                                  int**         col,
+                                                                  ValueType**   val,
+                                                                  IndexType2    nnz,
+                                                                  int           nrow,
+                                                                  int           ncol)
     {
         assert(*row_offset != NULL);
         assert(*col != NULL);
@@ -268,15 +361,37 @@ namespace rocalution
         this->mat_.row_offset = *row_offset;
         this->mat_.col        = *col;
         this->mat_.val        = *val;
+
+        this->ApplyAnalysis();
     }
 
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::LeaveDataPtrCSR(int** row_offset, int** col, ValueType** val)
+    template <typename ValueType, typename PointerType>
+    template <typename OtherPointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::set_data_ptr_(OtherPointerType** row_offset,
+                                                                  int**              col,
+                                                                  ValueType**        val,
+                                                                  IndexType2         nnz,
+                                                                  int                nrow,
+                                                                  int                ncol)
+    {
+        LOG_INFO("HostMatrixCSR::SetDataPtrCSR() " << 8 * sizeof(OtherPointerType)
+                                                   << " bit row offsets are not supported");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType, typename PointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::leave_data_ptr_(PointerType** row_offset,
+                                                                    int**         col,
+                                                                    ValueType**   val)
     {
         assert(this->nrow_ > 0);
         assert(this->ncol_ > 0);
         assert(this->nnz_ > 0);
 
+        // File mapped data cannot be passed on
+        this->unmap_();
+
         // see free_host function for details
         *row_offset = this->mat_.row_offset;
         *col        = this->mat_.col;
@@ -291,74 +406,26 @@ namespace rocalution
         this->nnz_  = 0;
     }
 
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::CopyFromCSR(const int*       row_offsets,
-                                               const int*       col,
-                                               const ValueType* val)
-    {
-        if(this->nnz_ > 0)
-        {
-            assert(this->nrow_ > 0);
-            assert(this->ncol_ > 0);
-
-            _set_omp_backend_threads(this->local_backend_, this->nrow_);
-
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for(int i = 0; i < this->nrow_ + 1; ++i)
-            {
-                this->mat_.row_offset[i] = row_offsets[i];
-            }
-
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for(int j = 0; j < this->nnz_; ++j)
-            {
-                this->mat_.col[j] = col[j];
-                this->mat_.val[j] = val[j];
-            }
-        }
-    }
-
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::CopyToCSR(int* row_offsets, int* col, ValueType* val) const
+    template <typename ValueType, typename PointerType>
+    template <typename OtherPointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::leave_data_ptr_(OtherPointerType** row_offset,
+                                                                    int**              col,
+                                                                    ValueType**        val)
     {
-        if(this->nnz_ > 0)
-        {
-            assert(this->nrow_ > 0);
-            assert(this->ncol_ > 0);
-
-            _set_omp_backend_threads(this->local_backend_, this->nrow_);
-
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for(int i = 0; i < this->nrow_ + 1; ++i)
-            {
-                row_offsets[i] = this->mat_.row_offset[i];
-            }
-
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for(int j = 0; j < this->nnz_; ++j)
-            {
-                col[j] = this->mat_.col[j];
-                val[j] = this->mat_.val[j];
-            }
-        }
+        LOG_INFO("HostMatrixCSR::LeaveDataPtrCSR() " << 8 * sizeof(OtherPointerType)
+                                                     << " bit row offsets are not supported");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
     }
 
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::CopyFrom(const BaseMatrix<ValueType>& mat)
+    template <typename ValueType, typename PointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::CopyFrom(const BaseMatrix<ValueType>& mat)
     {
         // copy only in the same format
         assert(this->GetMatFormat() == mat.GetMatFormat());
 
-        if(const HostMatrixCSR<ValueType>* cast_mat
-           = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat))
+        if(const HostMatrixCSRBase<ValueType, PointerType>* cast_mat
+           = dynamic_cast<const HostMatrixCSRBase<ValueType, PointerType>*>(&mat))
         {
             if(this->nnz_ == 0)
             {
@@ -383,13 +450,23 @@ namespace rocalution
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-                for(int j = 0; j < this->nnz_; ++j)
+                for(PointerType j = 0; j < this->nnz_; ++j)
                 {
                     this->mat_.col[j] = cast_mat->mat_.col[j];
                     this->mat_.val[j] = cast_mat->mat_.val[j];
                 }
+
+                this->ApplyAnalysis();
             }
         }
+        else if(dynamic_cast<const HostMatrix<ValueType>*>(&mat) != NULL)
+        {
+            // Host CSR matrices with other row offsets would dispatch back to this matrix
+            LOG_INFO("Error unsupported HostMatrixCSR row offset type");
+            this->Info();
+            mat.Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
         else
         {
             // Host matrix knows only host matrices
@@ -398,245 +475,656 @@ namespace rocalution
         }
     }
 
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::CopyTo(BaseMatrix<ValueType>* mat) const
+    template <typename ValueType, typename PointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::CopyTo(BaseMatrix<ValueType>* mat) const
     {
         mat->CopyFrom(*this);
     }
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ReadFileCSR(const std::string filename)
+    template <typename ValueType, typename PointerType>
+    bool HostMatrixCSRBase<ValueType, PointerType>::ReadFileCSR(const std::string filename)
     {
         LOG_INFO("ReadFileCSR: filename=" << filename << "; reading...");
 
-        std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+        int         nrow;
+        int         ncol;
+        PointerType nnz;
+
+        PointerType* row_offset = NULL;
+        int*         col        = NULL;
+        ValueType*   val        = NULL;
 
-        if(!in.is_open())
+        if(read_matrix_csr(nrow, ncol, nnz, &row_offset, &col, &val, filename.c_str()) != true)
         {
-            LOG_INFO("ReadFileCSR: filename=" << filename << "; cannot open file");
             return false;
         }
 
-        // Header
-        std::string header;
-        std::getline(in, header);
+        this->Clear();
 
-        if(header != "#rocALUTION binary csr file")
+        if(nnz > 0)
         {
-            LOG_INFO("ReadFileCSR: filename=" << filename << " is not a rocALUTION matrix");
-            return false;
+            this->set_data_ptr_(&row_offset, &col, &val, nnz, nrow, ncol);
         }
 
-        // rocALUTION version
-        int version;
-        in.read((char*)&version, sizeof(int));
+        LOG_INFO("ReadFileCSR: filename=" << filename << "; done");
 
-        /* TODO might need this in the future
-      if(version != __ROCALUTION_VER)
-      {
-          LOG_INFO("ReadFileCSR: filename=" << filename << "; file version mismatch");
-          return false;
-      }
-    */
+        return true;
+    }
 
-        // Read data
-        int nrow;
-        int ncol;
-        int nnz;
+    template <typename ValueType, typename PointerType>
+    bool HostMatrixCSRBase<ValueType, PointerType>::MapFileCSR(const std::string filename)
+    {
+        LOG_INFO("MapFileCSR: filename=" << filename << "; mapping...");
 
-        in.read((char*)&nrow, sizeof(int));
-        in.read((char*)&ncol, sizeof(int));
-        in.read((char*)&nnz, sizeof(int));
+        int         nrow;
+        int         ncol;
+        PointerType nnz;
 
-        this->AllocateCSR(nnz, nrow, ncol);
+        PointerType* row_offset = NULL;
+        int*         col        = NULL;
+        ValueType*   val        = NULL;
 
-        in.read((char*)this->mat_.row_offset, (nrow + 1) * sizeof(int));
-        in.read((char*)this->mat_.col, nnz * sizeof(int));
+        void*  map      = NULL;
+        size_t map_size = 0;
 
-        // We read always in double precision
-        if(typeid(ValueType) == typeid(double))
+        if(map_matrix_csr(
+               nrow, ncol, nnz, &row_offset, &col, &val, &map, &map_size, filename.c_str())
+           != true)
         {
-            in.read((char*)this->mat_.val, sizeof(ValueType) * nnz);
+            // Previous container version, different row offset or value type
+            LOG_VERBOSE_INFO(2, "*** warning: HostMatrixCSR::MapFileCSR() file cannot be mapped");
+
+            return this->ReadFileCSR(filename);
         }
-        else if(typeid(ValueType) == typeid(float))
-        {
-            std::vector<double> tmp(nnz);
 
-            in.read((char*)tmp.data(), sizeof(double) * nnz);
+        this->Clear();
 
-            for(int i = 0; i < nnz; ++i)
-            {
-                this->mat_.val[i] = static_cast<ValueType>(tmp[i]);
-            }
-        }
-        else
-        {
-            LOG_INFO("ReadFileCSR: filename=" << filename << "; internal error");
-            return false;
-        }
+        this->nrow_ = nrow;
+        this->ncol_ = ncol;
+        this->nnz_  = nnz;
+
+        this->mat_.row_offset = row_offset;
+        this->mat_.col        = col;
+        this->mat_.val        = val;
+
+        this->map_      = map;
+        this->map_size_ = map_size;
+
+        this->ApplyAnalysis();
+
+        LOG_INFO("MapFileCSR: filename=" << filename << "; done");
+
+        return true;
+    }
+
+    template <typename ValueType, typename PointerType>
+    bool HostMatrixCSRBase<ValueType, PointerType>::WriteFileCSR(const std::string filename) const
+    {
+        LOG_INFO("WriteFileCSR: filename=" << filename << "; writing...");
 
-        // Check ifstream status
-        if(!in)
+        if(write_matrix_csr(this->nrow_,
+                            this->ncol_,
+                            static_cast<PointerType>(this->nnz_),
+                            this->mat_.row_offset,
+                            this->mat_.col,
+                            this->mat_.val,
+                            filename.c_str())
+           != true)
         {
-            LOG_INFO("ReadFileCSR: filename=" << filename << "; could not read from file");
             return false;
         }
 
-        in.close();
-
-        LOG_INFO("ReadFileCSR: filename=" << filename << "; done");
+        LOG_INFO("WriteFileCSR: filename=" << filename << "; done");
 
         return true;
     }
 
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::CopyFromHostCSR(
-        const int* row_offset, const int* col, const ValueType* val, int nnz, int nrow, int ncol)
+    template <typename ValueType, typename PointerType>
+    bool HostMatrixCSRBase<ValueType, PointerType>::ConvertFrom(const BaseMatrix<ValueType>& mat)
     {
-        assert(nnz >= 0);
-        assert(ncol >= 0);
-        assert(nrow >= 0);
-        assert(row_offset != NULL);
-        assert(col != NULL);
-        assert(val != NULL);
+        this->Clear();
 
-        // Allocate matrix
-        if(this->nnz_ > 0)
+        // empty matrix is empty matrix
+        if(mat.GetNnz() == 0)
         {
-            this->Clear();
+            return true;
         }
 
-        if(nnz > 0)
+        if(const HostMatrixCSRBase<ValueType, PointerType>* cast_mat
+           = dynamic_cast<const HostMatrixCSRBase<ValueType, PointerType>*>(&mat))
         {
-            allocate_host(nrow + 1, &this->mat_.row_offset);
-            allocate_host(nnz, &this->mat_.col);
-            allocate_host(nnz, &this->mat_.val);
+            this->CopyFrom(*cast_mat);
+            return true;
+        }
 
-            this->nrow_ = nrow;
-            this->ncol_ = ncol;
-            this->nnz_  = nnz;
+        // Widen the row offsets of a compact CSR matrix
+        if(const HostMatrixCSRBase<ValueType, int>* cast_mat
+           = dynamic_cast<const HostMatrixCSRBase<ValueType, int>*>(&mat))
+        {
+            this->AllocateCSR(cast_mat->nnz_, cast_mat->nrow_, cast_mat->ncol_);
 
-            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+            _set_omp_backend_threads(this->local_backend_, cast_mat->nrow_);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(int i = 0; i < this->nrow_ + 1; ++i)
+            for(int i = 0; i < cast_mat->nrow_ + 1; ++i)
             {
-                this->mat_.row_offset[i] = row_offset[i];
+                this->mat_.row_offset[i] = cast_mat->mat_.row_offset[i];
             }
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(int j = 0; j < this->nnz_; ++j)
+            for(int j = 0; j < cast_mat->nnz_; ++j)
             {
-                this->mat_.col[j] = col[j];
-                this->mat_.val[j] = val[j];
+                this->mat_.col[j] = cast_mat->mat_.col[j];
+                this->mat_.val[j] = cast_mat->mat_.val[j];
+            }
+
+            this->ApplyAnalysis();
+
+            return true;
+        }
+
+        if(const HostMatrixCOO<ValueType>* cast_mat
+           = dynamic_cast<const HostMatrixCOO<ValueType>*>(&mat))
+        {
+            // More non-zero entries than the row offsets can address
+            if(cast_mat->nnz_ > std::numeric_limits<PointerType>::max())
+            {
+                return false;
+            }
+
+            if(coo_to_csr(_get_omp_backend_threads(this->local_backend_, cast_mat->nrow_),
+                          static_cast<PointerType>(cast_mat->nnz_),
+                          cast_mat->nrow_,
+                          cast_mat->ncol_,
+                          cast_mat->mat_,
+                          &this->mat_)
+               == true)
+            {
+                this->nrow_ = cast_mat->nrow_;
+                this->ncol_ = cast_mat->ncol_;
+                this->nnz_  = cast_mat->nnz_;
+
+                this->ApplyAnalysis();
+
+                return true;
             }
         }
+
+        return false;
     }
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::WriteFileCSR(const std::string filename) const
+    template <typename ValueType, typename PointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::ApplyAnalysis(void)
     {
-        LOG_INFO("WriteFileCSR: filename=" << filename << "; writing...");
+        // Drop previous partition
+        if(this->spmv_parts_ > 0)
+        {
+            free_host(&this->spmv_row_);
+            free_host(&this->spmv_nnz_);
+
+            this->spmv_parts_ = 0;
+        }
 
-        std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+        int nparts = this->local_backend_.OpenMP_threads;
 
-        if(!out.is_open())
+        if(this->nnz_ == 0 || nparts < 2 || this->nrow_ < nparts)
         {
-            LOG_INFO("WriteFileCSR: filename=" << filename << "; cannot open file");
-            return false;
+            return;
         }
 
-        // Header
-        out << "#rocALUTION binary csr file" << std::endl;
+        // Each row costs its number of non-zeros plus one
+        IndexType2 total = static_cast<IndexType2>(this->nrow_) + this->nnz_;
+
+        // Most expensive part of the static row partition of the default SpMV
+        IndexType2 max_cost = 0;
+        int        chunk    = (this->nrow_ - 1) / nparts + 1;
+
+        for(int i = 0; i < nparts; ++i)
+        {
+            int row_beg = std::min(i * chunk, this->nrow_);
+            int row_end = std::min(row_beg + chunk, this->nrow_);
 
-        // rocALUTION version
-        int version = __ROCALUTION_VER;
-        out.write((char*)&version, sizeof(int));
+            IndexType2 cost = row_end - row_beg + this->mat_.row_offset[row_end]
+                              - this->mat_.row_offset[row_beg];
 
-        // Data
-        out.write((char*)&this->nrow_, sizeof(int));
-        out.write((char*)&this->ncol_, sizeof(int));
-        out.write((char*)&this->nnz_, sizeof(int));
-        out.write((char*)this->mat_.row_offset, (this->nrow_ + 1) * sizeof(int));
-        out.write((char*)this->mat_.col, this->nnz_ * sizeof(int));
+            max_cost = std::max(max_cost, cost);
+        }
 
-        // We write always in double precision
-        if(typeid(ValueType) == typeid(double))
+        // Row lengths are balanced, keep the row partition
+        if(static_cast<double>(max_cost) * nparts < 1.2 * static_cast<double>(total))
         {
-            out.write((char*)this->mat_.val, this->nnz_ * sizeof(ValueType));
+            return;
         }
-        else if(typeid(ValueType) == typeid(float))
+
+        LOG_VERBOSE_INFO(4,
+                         "HostMatrixCSR::ApplyAnalysis() merge path SpMV, row partition imbalance "
+                             << static_cast<double>(max_cost) * nparts / total);
+
+        allocate_host(nparts + 1, &this->spmv_row_);
+        allocate_host(nparts + 1, &this->spmv_nnz_);
+
+        // Split the merge path of row ends and non-zeros into parts of equal length
+        for(int i = 0; i <= nparts; ++i)
         {
-            std::vector<double> tmp(this->nnz_);
+            IndexType2 diag = total * i / nparts;
 
-            for(int i = 0; i < this->nnz_; ++i)
+            // Binary search along the diagonal
+            int lo = static_cast<int>(std::max(diag - this->nnz_, static_cast<IndexType2>(0)));
+            int hi = static_cast<int>(std::min(diag, static_cast<IndexType2>(this->nrow_)));
+
+            while(lo < hi)
             {
-                tmp[i] = rocalution_double(this->mat_.val[i]);
+                int mid = (lo + hi) / 2;
+
+                if(this->mat_.row_offset[mid + 1] <= diag - mid - 1)
+                {
+                    lo = mid + 1;
+                }
+                else
+                {
+                    hi = mid;
+                }
             }
 
-            out.write((char*)tmp.data(), sizeof(double) * this->nnz_);
+            this->spmv_row_[i] = lo;
+            this->spmv_nnz_[i] = static_cast<PointerType>(diag - lo);
         }
-        else // TODO complex
+
+        this->spmv_parts_ = nparts;
+    }
+
+    template <typename ValueType, typename PointerType>
+    bool HostMatrixCSRBase<ValueType, PointerType>::spmv_valid_(void) const
+    {
+        if(this->spmv_parts_ == 0)
         {
-            LOG_INFO("WriteFileCSR: filename=" << filename << "; internal error");
             return false;
         }
 
-        // Check ofstream status
-        if(!out)
+        if(this->spmv_row_[this->spmv_parts_] != this->nrow_
+           || this->spmv_nnz_[this->spmv_parts_] != this->nnz_)
         {
-            LOG_INFO("ReadFileCSR: filename=" << filename << "; could not write to file");
             return false;
         }
 
-        out.close();
+        // Every part boundary has to lie on the merge path of the current structure,
+        // then the SpMV is correct (even if not balanced)
+        for(int i = 1; i <= this->spmv_parts_; ++i)
+        {
+            int         row = this->spmv_row_[i];
+            PointerType nnz = this->spmv_nnz_[i];
 
-        LOG_INFO("WriteFileCSR: filename=" << filename << "; done");
+            if(row < this->spmv_row_[i - 1] || nnz < this->spmv_nnz_[i - 1])
+            {
+                return false;
+            }
+
+            if(nnz < this->mat_.row_offset[row]
+               || (row < this->nrow_ && nnz > this->mat_.row_offset[row + 1]))
+            {
+                return false;
+            }
+        }
 
         return true;
     }
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ConvertFrom(const BaseMatrix<ValueType>& mat)
+    template <typename ValueType, typename PointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::Apply(const BaseVector<ValueType>& in,
+                                                          BaseVector<ValueType>*       out) const
     {
+        assert(in.GetSize() >= 0);
+        assert(out->GetSize() >= 0);
+        assert(in.GetSize() == this->ncol_);
+        assert(out->GetSize() == this->nrow_);
+
+        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+        // Merge path SpMV for skewed row lengths
+        if(omp_get_max_threads() > 1 && this->spmv_valid_() == true)
+        {
+            int nparts = this->spmv_parts_;
+
+            // Partial sum of the last row of each part
+            std::vector<int>       carry_row(nparts);
+            std::vector<ValueType> carry_val(nparts);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+            for(int p = 0; p < nparts; ++p)
+            {
+                int         row     = this->spmv_row_[p];
+                PointerType aj      = this->spmv_nnz_[p];
+                int         row_end = this->spmv_row_[p + 1];
+                PointerType nnz_end = this->spmv_nnz_[p + 1];
+
+                // Rows that end in this part
+                for(; row < row_end; ++row)
+                {
+                    ValueType sum = static_cast<ValueType>(0);
+
+                    for(; aj < this->mat_.row_offset[row + 1]; ++aj)
+                    {
+                        sum += this->mat_.val[aj] * cast_in->vec_[this->mat_.col[aj]];
+                    }
+
+                    cast_out->vec_[row] = sum;
+                }
+
+                // Row that continues in the next part
+                ValueType sum = static_cast<ValueType>(0);
+
+                for(; aj < nnz_end; ++aj)
+                {
+                    sum += this->mat_.val[aj] * cast_in->vec_[this->mat_.col[aj]];
+                }
+
+                carry_row[p] = row_end;
+                carry_val[p] = sum;
+            }
+
+            // Carry-out fix-up
+            for(int p = 0; p < nparts; ++p)
+            {
+                if(carry_row[p] < this->nrow_)
+                {
+                    cast_out->vec_[carry_row[p]] += carry_val[p];
+                }
+            }
+
+            return;
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            ValueType   sum     = static_cast<ValueType>(0);
+            PointerType row_beg = this->mat_.row_offset[ai];
+            PointerType row_end = this->mat_.row_offset[ai + 1];
+
+            for(PointerType aj = row_beg; aj < row_end; ++aj)
+            {
+                sum += this->mat_.val[aj] * cast_in->vec_[this->mat_.col[aj]];
+            }
+
+            cast_out->vec_[ai] = sum;
+        }
+    }
+
+    template <typename ValueType, typename PointerType>
+    void HostMatrixCSRBase<ValueType, PointerType>::ApplyAdd(const BaseVector<ValueType>& in,
+                                                             ValueType                    scalar,
+                                                             BaseVector<ValueType>* out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(in.GetSize() >= 0);
+            assert(out->GetSize() >= 0);
+            assert(in.GetSize() == this->ncol_);
+            assert(out->GetSize() == this->nrow_);
+
+            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+            // Merge path SpMV for skewed row lengths
+            if(omp_get_max_threads() > 1 && this->spmv_valid_() == true)
+            {
+                int nparts = this->spmv_parts_;
+
+                // Partial sum of the last row of each part
+                std::vector<int>       carry_row(nparts);
+                std::vector<ValueType> carry_val(nparts);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+                for(int p = 0; p < nparts; ++p)
+                {
+                    int         row     = this->spmv_row_[p];
+                    PointerType aj      = this->spmv_nnz_[p];
+                    int         row_end = this->spmv_row_[p + 1];
+                    PointerType nnz_end = this->spmv_nnz_[p + 1];
+
+                    // Rows that end in this part
+                    for(; row < row_end; ++row)
+                    {
+                        ValueType sum = static_cast<ValueType>(0);
+
+                        for(; aj < this->mat_.row_offset[row + 1]; ++aj)
+                        {
+                            sum += this->mat_.val[aj] * cast_in->vec_[this->mat_.col[aj]];
+                        }
+
+                        cast_out->vec_[row] += scalar * sum;
+                    }
+
+                    // Row that continues in the next part
+                    ValueType sum = static_cast<ValueType>(0);
+
+                    for(; aj < nnz_end; ++aj)
+                    {
+                        sum += this->mat_.val[aj] * cast_in->vec_[this->mat_.col[aj]];
+                    }
+
+                    carry_row[p] = row_end;
+                    carry_val[p] = sum;
+                }
+
+                // Carry-out fix-up
+                for(int p = 0; p < nparts; ++p)
+                {
+                    if(carry_row[p] < this->nrow_)
+                    {
+                        cast_out->vec_[carry_row[p]] += scalar * carry_val[p];
+                    }
+                }
+
+                return;
+            }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int ai = 0; ai < this->nrow_; ++ai)
+            {
+                for(PointerType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1];
+                    ++aj)
+                {
+                    cast_out->vec_[ai]
+                        += scalar * this->mat_.val[aj] * cast_in->vec_[this->mat_.col[aj]];
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    HostMatrixCSR<ValueType>::HostMatrixCSR()
+    {
+        // no default constructors
+        LOG_INFO("no default constructor");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    HostMatrixCSR<ValueType>::HostMatrixCSR(const Rocalution_Backend_Descriptor local_backend)
+        : HostMatrixCSRBase<ValueType, int>(local_backend)
+    {
+        log_debug(this, "HostMatrixCSR::HostMatrixCSR()", "constructor with local_backend");
+
+        this->powers_ = NULL;
+
+        this->L_diag_unit_ = false;
+        this->U_diag_unit_ = false;
+    }
+
+    template <typename ValueType>
+    HostMatrixCSR<ValueType>::~HostMatrixCSR()
+    {
+        log_debug(this, "HostMatrixCSR::~HostMatrixCSR()", "destructor");
+
         this->Clear();
+    }
 
-        // empty matrix is empty matrix
-        if(mat.GetNnz() == 0)
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::Clear()
+    {
+        if(this->nnz_ > 0 && this->powers_ != NULL)
         {
-            return true;
+            delete this->powers_;
+            this->powers_ = NULL;
         }
 
-        if(const HostMatrixCSR<ValueType>* cast_mat
-           = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat))
+        HostMatrixCSRBase<ValueType, int>::Clear();
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::Zeros(void)
+    {
+        if(this->nnz_ > 0)
         {
-            this->CopyFrom(*cast_mat);
-            return true;
+            set_to_zero_host(this->nnz_, this->mat_.val);
         }
 
-        if(const HostMatrixCOO<ValueType>* cast_mat
-           = dynamic_cast<const HostMatrixCOO<ValueType>*>(&mat))
+        return true;
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::CopyFromCSR(const int*       row_offsets,
+                                               const int*       col,
+                                               const ValueType* val)
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(this->nrow_ > 0);
+            assert(this->ncol_ > 0);
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_ + 1; ++i)
+            {
+                this->mat_.row_offset[i] = row_offsets[i];
+            }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int j = 0; j < this->nnz_; ++j)
+            {
+                this->mat_.col[j] = col[j];
+                this->mat_.val[j] = val[j];
+            }
+
+            this->ApplyAnalysis();
+        }
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::CopyToCSR(int* row_offsets, int* col, ValueType* val) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(this->nrow_ > 0);
+            assert(this->ncol_ > 0);
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_ + 1; ++i)
+            {
+                row_offsets[i] = this->mat_.row_offset[i];
+            }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int j = 0; j < this->nnz_; ++j)
+            {
+                col[j] = this->mat_.col[j];
+                val[j] = this->mat_.val[j];
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::CopyFromHostCSR(
+        const int* row_offset, const int* col, const ValueType* val, int nnz, int nrow, int ncol)
+    {
+        assert(nnz >= 0);
+        assert(ncol >= 0);
+        assert(nrow >= 0);
+        assert(row_offset != NULL);
+        assert(col != NULL);
+        assert(val != NULL);
+
+        // Allocate matrix
+        if(this->nnz_ > 0)
         {
             this->Clear();
+        }
 
-            if(coo_to_csr(this->local_backend_.OpenMP_threads,
-                          cast_mat->nnz_,
-                          cast_mat->nrow_,
-                          cast_mat->ncol_,
-                          cast_mat->mat_,
-                          &this->mat_)
-               == true)
+        if(nnz > 0)
+        {
+            allocate_host(nrow + 1, &this->mat_.row_offset);
+            allocate_host(nnz, &this->mat_.col);
+            allocate_host(nnz, &this->mat_.val);
+
+            this->nrow_ = nrow;
+            this->ncol_ = ncol;
+            this->nnz_  = nnz;
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_ + 1; ++i)
             {
-                this->nrow_ = cast_mat->nrow_;
-                this->ncol_ = cast_mat->ncol_;
-                this->nnz_  = cast_mat->nnz_;
+                this->mat_.row_offset[i] = row_offset[i];
+            }
 
-                return true;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int j = 0; j < this->nnz_; ++j)
+            {
+                this->mat_.col[j] = col[j];
+                this->mat_.val[j] = val[j];
             }
+
+            this->ApplyAnalysis();
+        }
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ConvertFrom(const BaseMatrix<ValueType>& mat)
+    {
+        // Empty, CSR and COO matrices
+        if(HostMatrixCSRBase<ValueType, int>::ConvertFrom(mat) == true)
+        {
+            return true;
         }
 
         if(const HostMatrixDENSE<ValueType>* cast_mat
@@ -645,7 +1133,7 @@ namespace rocalution
             this->Clear();
             int nnz = 0;
 
-            if(dense_to_csr(this->local_backend_.OpenMP_threads,
+            if(dense_to_csr(_get_omp_backend_threads(this->local_backend_, cast_mat->nrow_),
                             cast_mat->nrow_,
                             cast_mat->ncol_,
                             cast_mat->mat_,
@@ -657,6 +1145,8 @@ namespace rocalution
                 this->ncol_ = cast_mat->ncol_;
                 this->nnz_  = nnz;
 
+                this->ApplyAnalysis();
+
                 return true;
             }
         }
@@ -667,8 +1157,8 @@ namespace rocalution
             this->Clear();
             int nnz;
 
-            if(dia_to_csr(this->local_backend_.OpenMP_threads,
-                          cast_mat->nnz_,
+            if(dia_to_csr(_get_omp_backend_threads(this->local_backend_, cast_mat->nrow_),
+                          static_cast<int>(cast_mat->nnz_),
                           cast_mat->nrow_,
                           cast_mat->ncol_,
                           cast_mat->mat_,
@@ -680,6 +1170,8 @@ namespace rocalution
                 this->ncol_ = cast_mat->ncol_;
                 this->nnz_  = nnz;
 
+                this->ApplyAnalysis();
+
                 return true;
             }
         }
@@ -690,8 +1182,8 @@ namespace rocalution
             this->Clear();
             int nnz;
 
-            if(ell_to_csr(this->local_backend_.OpenMP_threads,
-                          cast_mat->nnz_,
+            if(ell_to_csr(_get_omp_backend_threads(this->local_backend_, cast_mat->nrow_),
+                          static_cast<int>(cast_mat->nnz_),
                           cast_mat->nrow_,
                           cast_mat->ncol_,
                           cast_mat->mat_,
@@ -703,6 +1195,8 @@ namespace rocalution
                 this->ncol_ = cast_mat->ncol_;
                 this->nnz_  = nnz;
 
+                this->ApplyAnalysis();
+
                 return true;
             }
         }
@@ -712,8 +1206,8 @@ namespace rocalution
         {
             this->Clear();
 
-            if(mcsr_to_csr(this->local_backend_.OpenMP_threads,
-                           cast_mat->nnz_,
+            if(mcsr_to_csr(_get_omp_backend_threads(this->local_backend_, cast_mat->nrow_),
+                           static_cast<int>(cast_mat->nnz_),
                            cast_mat->nrow_,
                            cast_mat->ncol_,
                            cast_mat->mat_,
@@ -724,105 +1218,430 @@ namespace rocalution
                 this->ncol_ = cast_mat->ncol_;
                 this->nnz_  = cast_mat->nnz_;
 
+                this->ApplyAnalysis();
+
+                return true;
+            }
+        }
+
+        if(const HostMatrixHYB<ValueType>* cast_mat
+           = dynamic_cast<const HostMatrixHYB<ValueType>*>(&mat))
+        {
+            this->Clear();
+            int nnz;
+
+            if(hyb_to_csr(_get_omp_backend_threads(this->local_backend_, cast_mat->nrow_),
+                          static_cast<int>(cast_mat->nnz_),
+                          cast_mat->nrow_,
+                          cast_mat->ncol_,
+                          cast_mat->ell_nnz_,
+                          cast_mat->coo_nnz_,
+                          cast_mat->mat_,
+                          &this->mat_,
+                          &nnz)
+               == true)
+            {
+                this->nrow_ = cast_mat->nrow_;
+                this->ncol_ = cast_mat->ncol_;
+                this->nnz_  = nnz;
+
+                this->ApplyAnalysis();
+
                 return true;
             }
         }
 
-        if(const HostMatrixHYB<ValueType>* cast_mat
-           = dynamic_cast<const HostMatrixHYB<ValueType>*>(&mat))
+        return false;
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::ApplyAnalysis(void)
+    {
+        // Drop the matrix powers tiles, they are rebuilt on demand
+        if(this->powers_ != NULL)
+        {
+            delete this->powers_;
+            this->powers_ = NULL;
+        }
+
+        HostMatrixCSRBase<ValueType, int>::ApplyAnalysis();
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::powers_tiles_(int k) const
+    {
+        assert(k > 0);
+
+        // Tiles are built for the current structure and the largest number of powers
+        if(this->powers_ == NULL || this->powers_->depth < k
+           || this->powers_->nrow != this->nrow_ || this->powers_->nnz != this->nnz_)
+        {
+            if(this->powers_ == NULL)
+            {
+                this->powers_ = new HostMatrixPowersTiles;
+            }
+
+            IndexType2 tile_nnz
+                = matrix_powers_cache_size / (2 * (sizeof(int) + sizeof(ValueType)));
+
+            bool tiled
+                = matrix_powers_tiles(_get_omp_backend_threads(this->local_backend_, this->nrow_),
+                                      this->nrow_,
+                                      this->mat_.row_offset,
+                                      this->mat_.col,
+                                      k,
+                                      tile_nnz,
+                                      matrix_powers_redundancy,
+                                      this->powers_);
+
+            LOG_VERBOSE_INFO(4,
+                             "HostMatrixCSR::powers_tiles_() depth " << k << ", tiles "
+                                                                     << this->powers_->ntile
+                                                                     << (tiled ? "" : " (SpMV)"));
+        }
+
+        return this->powers_->ntile > 0;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::MatrixPowers(int                     k,
+                                                const ValueType*        alpha,
+                                                const ValueType*        beta,
+                                                const ValueType*        gamma,
+                                                BaseVector<ValueType>** v) const
+    {
+        assert(k >= 0);
+        assert(v != NULL);
+
+        if(this->nrow_ != this->ncol_)
+        {
+            return false;
+        }
+
+        if(k == 0)
+        {
+            return true;
+        }
+
+        assert(alpha != NULL);
+        assert(beta != NULL);
+        assert(gamma != NULL);
+
+        std::vector<ValueType*> vec(k + 1);
+
+        for(int j = 0; j <= k; ++j)
+        {
+            HostVector<ValueType>* cast_v = dynamic_cast<HostVector<ValueType>*>(v[j]);
+
+            assert(cast_v != NULL);
+            assert(cast_v->GetSize() == this->nrow_);
+
+            vec[j] = cast_v->vec_;
+        }
+
+        // Cache blocked kernel
+        if(this->powers_tiles_(k) == true)
+        {
+            matrix_powers_apply(_get_omp_backend_threads(this->local_backend_, this->nrow_),
+                                *this->powers_,
+                                this->mat_.row_offset,
+                                this->mat_.val,
+                                k,
+                                alpha,
+                                beta,
+                                gamma,
+                                vec.data());
+
+            return true;
+        }
+
+        // Sequence of SpMVs
+        for(int j = 0; j < k; ++j)
+        {
+            this->Apply(*v[j], v[j + 1]);
+
+            ValueType*       out  = vec[j + 1];
+            const ValueType* cur  = vec[j];
+            const ValueType* prev = (j > 0) ? vec[j - 1] : NULL;
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                ValueType val = alpha[j] * out[i] + beta[j] * cur[i];
+
+                if(prev != NULL)
+                {
+                    val += gamma[j] * prev[i];
+                }
+
+                out[i] = val;
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::MatrixPolynomial(int                          k,
+                                                    const ValueType*             alpha,
+                                                    const ValueType*             beta,
+                                                    const ValueType*             gamma,
+                                                    const ValueType*             weight,
+                                                    const BaseVector<ValueType>* scale,
+                                                    const BaseVector<ValueType>& in,
+                                                    BaseVector<ValueType>*       out) const
+    {
+        assert(k > 0);
+        assert(alpha != NULL);
+        assert(beta != NULL);
+        assert(gamma != NULL);
+        assert(weight != NULL);
+        assert(out != NULL);
+
+        if(this->nrow_ != this->ncol_)
+        {
+            return false;
+        }
+
+        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+        assert(cast_in->GetSize() == this->nrow_);
+        assert(cast_out->GetSize() == this->nrow_);
+
+        const ValueType* diag = NULL;
+
+        if(scale != NULL)
+        {
+            const HostVector<ValueType>* cast_scale
+                = dynamic_cast<const HostVector<ValueType>*>(scale);
+
+            assert(cast_scale != NULL);
+            assert(cast_scale->GetSize() == this->nrow_);
+
+            diag = cast_scale->vec_;
+        }
+
+        // Cache blocked kernel
+        if(this->powers_tiles_(k) == true)
+        {
+            matrix_powers_polynomial(_get_omp_backend_threads(this->local_backend_, this->nrow_),
+                                     *this->powers_,
+                                     this->mat_.row_offset,
+                                     this->mat_.val,
+                                     diag,
+                                     k,
+                                     alpha,
+                                     beta,
+                                     gamma,
+                                     weight,
+                                     cast_in->vec_,
+                                     cast_out->vec_);
+
+            return true;
+        }
+
+        // Sequence of SpMVs, the last three basis vectors are kept in memory
+        HostVector<ValueType> work0(this->local_backend_);
+        HostVector<ValueType> work1(this->local_backend_);
+        HostVector<ValueType> work2(this->local_backend_);
+
+        work0.Allocate(this->nrow_);
+        work1.Allocate(this->nrow_);
+        work2.Allocate(this->nrow_);
+
+        HostVector<ValueType>* v0 = &work0;
+        HostVector<ValueType>* v1 = &work1;
+        HostVector<ValueType>* v2 = &work2;
+
+        v1->CopyFrom(*cast_in);
+
+        ValueType* y = cast_out->vec_;
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            y[i] = weight[0] * v1->vec_[i];
+        }
+
+        for(int j = 0; j < k; ++j)
         {
-            this->Clear();
-            int nnz;
+            this->Apply(*v1, v2);
 
-            if(hyb_to_csr(this->local_backend_.OpenMP_threads,
-                          cast_mat->nnz_,
-                          cast_mat->nrow_,
-                          cast_mat->ncol_,
-                          cast_mat->ell_nnz_,
-                          cast_mat->coo_nnz_,
-                          cast_mat->mat_,
-                          &this->mat_,
-                          &nnz)
-               == true)
+            ValueType*       next = v2->vec_;
+            const ValueType* cur  = v1->vec_;
+            const ValueType* prev = (j > 0) ? v0->vec_ : NULL;
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
             {
-                this->nrow_ = cast_mat->nrow_;
-                this->ncol_ = cast_mat->ncol_;
-                this->nnz_  = nnz;
+                ValueType val = (diag != NULL) ? diag[i] * next[i] : next[i];
 
-                return true;
+                val = alpha[j] * val + beta[j] * cur[i];
+
+                if(prev != NULL)
+                {
+                    val += gamma[j] * prev[i];
+                }
+
+                next[i] = val;
+                y[i] += weight[j + 1] * val;
             }
+
+            HostVector<ValueType>* tmp = v0;
+            v0                         = v1;
+            v1                         = v2;
+            v2                         = tmp;
         }
 
-        return false;
+        return true;
     }
 
+    // SOR update of row i, the residual of the row and its scaling by the diagonal entry are
+    // computed in a single pass over the row; If x is zero, only the diagonal entry is read
     template <typename ValueType>
-    void HostMatrixCSR<ValueType>::Apply(const BaseVector<ValueType>& in,
-                                         BaseVector<ValueType>*       out) const
+    static inline void sor_row(int              i,
+                               const int*       row_offset,
+                               const int*       col,
+                               const ValueType* val,
+                               ValueType        omega,
+                               bool             zero,
+                               const ValueType* rhs,
+                               ValueType*       x)
     {
-        assert(in.GetSize() >= 0);
-        assert(out->GetSize() >= 0);
-        assert(in.GetSize() == this->ncol_);
-        assert(out->GetSize() == this->nrow_);
-
-        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
-        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
-
-        assert(cast_in != NULL);
-        assert(cast_out != NULL);
-
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        ValueType res  = rhs[i];
+        ValueType diag = static_cast<ValueType>(0);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int ai = 0; ai < this->nrow_; ++ai)
+        for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
         {
-            ValueType sum     = static_cast<ValueType>(0);
-            int       row_beg = this->mat_.row_offset[ai];
-            int       row_end = this->mat_.row_offset[ai + 1];
+            int c = col[j];
 
-            for(int aj = row_beg; aj < row_end; ++aj)
+            if(c == i)
             {
-                sum += this->mat_.val[aj] * cast_in->vec_[this->mat_.col[aj]];
+                diag = val[j];
+            }
+            else if(zero == false)
+            {
+                res -= val[j] * x[c];
             }
+        }
 
-            cast_out->vec_[ai] = sum;
+        if(zero == false)
+        {
+            // The diagonal part of the residual
+            res -= diag * x[i];
         }
+
+        x[i] += omega * res / diag;
     }
 
     template <typename ValueType>
-    void HostMatrixCSR<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
-                                            ValueType                    scalar,
-                                            BaseVector<ValueType>*       out) const
+    bool HostMatrixCSR<ValueType>::SORSweep(int                          num_colors,
+                                            const int*                   color_offset,
+                                            const BaseVector<int>&       color_rows,
+                                            ValueType                    omega,
+                                            bool                         symmetric,
+                                            bool                         zero_guess,
+                                            int                          sweeps,
+                                            const BaseVector<ValueType>& rhs,
+                                            BaseVector<ValueType>*       x) const
     {
-        if(this->nnz_ > 0)
+        assert(num_colors > 0);
+        assert(color_offset != NULL);
+        assert(sweeps > 0);
+        assert(x != NULL);
+
+        if(this->nrow_ != this->ncol_)
         {
-            assert(in.GetSize() >= 0);
-            assert(out->GetSize() >= 0);
-            assert(in.GetSize() == this->ncol_);
-            assert(out->GetSize() == this->nrow_);
+            return false;
+        }
 
-            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
-            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+        const HostVector<int>*       cast_rows = dynamic_cast<const HostVector<int>*>(&color_rows);
+        const HostVector<ValueType>* cast_rhs  = dynamic_cast<const HostVector<ValueType>*>(&rhs);
+        HostVector<ValueType>*       cast_x    = dynamic_cast<HostVector<ValueType>*>(x);
 
-            assert(cast_in != NULL);
-            assert(cast_out != NULL);
+        assert(cast_rows != NULL);
+        assert(cast_rhs != NULL);
+        assert(cast_x != NULL);
+        assert(cast_rows->GetSize() == this->nrow_);
+        assert(cast_rhs->GetSize() == this->nrow_);
+        assert(cast_x->GetSize() == this->nrow_);
+        assert(color_offset[num_colors] == this->nrow_);
 
-            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        const int*       row_offset = this->mat_.row_offset;
+        const int*       col        = this->mat_.col;
+        const ValueType* val        = this->mat_.val;
+        const int*       rows       = cast_rows->vec_;
+        const ValueType* b          = cast_rhs->vec_;
+        ValueType*       y          = cast_x->vec_;
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
+        // The rows of a color do not depend on each other, the colors are swept in order
+        // within a single parallel region
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel
 #endif
-            for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            for(int s = 0; s < sweeps; ++s)
             {
-                for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+                bool zero = (s == 0 && zero_guess == true);
+
+                if(zero == true)
                 {
-                    cast_out->vec_[ai]
-                        += scalar * this->mat_.val[aj] * cast_in->vec_[this->mat_.col[aj]];
+#ifdef _OPENMP
+#pragma omp for
+#endif
+                    for(int i = 0; i < this->nrow_; ++i)
+                    {
+                        y[i] = static_cast<ValueType>(0);
+                    }
+                }
+
+                // Forward sweep, x is still zero when the first color is visited
+                for(int c = 0; c < num_colors; ++c)
+                {
+#ifdef _OPENMP
+#pragma omp for
+#endif
+                    for(int k = color_offset[c]; k < color_offset[c + 1]; ++k)
+                    {
+                        sor_row(rows[k], row_offset, col, val, omega, zero && c == 0, b, y);
+                    }
+                }
+
+                // Backward sweep
+                if(symmetric == true)
+                {
+                    for(int c = num_colors - 1; c >= 0; --c)
+                    {
+#ifdef _OPENMP
+#pragma omp for
+#endif
+                        for(int k = color_offset[c]; k < color_offset[c + 1]; ++k)
+                        {
+                            sor_row(rows[k], row_offset, col, val, omega, false, b, y);
+                        }
+                    }
                 }
             }
         }
+
+        return true;
     }
 
     template <typename ValueType>
@@ -1953,6 +2772,13 @@ namespace rocalution
         HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
         assert(cast_perm != NULL);
 
+        // Dependencies in both directions are taken into account, such that the rows of
+        // a color do not couple with each other
+        std::vector<int> adj_ptr;
+        std::vector<int> adj;
+
+        graph_symmetric(this->nrow_, this->mat_.row_offset, this->mat_.col, &adj_ptr, &adj);
+
         // node colors (init value = 0 i.e. no color)
         int* color = NULL;
         allocate_host(this->nrow_, &color);
@@ -1968,20 +2794,15 @@ namespace rocalution
             row_col.reserve(num_colors + 2);
             row_col.assign(num_colors + 2, false);
 
-            for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            for(int aj = adj_ptr[ai]; aj < adj_ptr[ai + 1]; ++aj)
             {
-                if(ai != this->mat_.col[aj])
-                {
-                    row_col[color[this->mat_.col[aj]]] = true;
-                }
+                row_col[color[adj[aj]]] = true;
             }
 
-            for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            // Smallest color that is not used by a neighbor
+            while(row_col[color[ai]] == true)
             {
-                if(row_col[color[ai]] == true)
-                {
-                    ++color[ai];
-                }
+                ++color[ai];
             }
 
             if(color[ai] > num_colors)
@@ -2024,6 +2845,64 @@ namespace rocalution
         return true;
     }
 
+    // Permutation that moves the rows with flag[i] != 0 to the front, the order within both
+    // parts is kept; Returns the number of flagged rows
+    static int front_permutation(int omp_threads, int n, const int* flag, int* perm)
+    {
+        omp_set_num_threads(omp_threads);
+
+        int nblocks = (n + permutation_block_size - 1) / permutation_block_size;
+
+        std::vector<int> offset(nblocks + 1, 0);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int b = 0; b < nblocks; ++b)
+        {
+            int end = std::min(n, (b + 1) * permutation_block_size);
+
+            for(int i = b * permutation_block_size; i < end; ++i)
+            {
+                if(flag[i] != 0)
+                {
+                    ++offset[b + 1];
+                }
+            }
+        }
+
+        for(int b = 0; b < nblocks; ++b)
+        {
+            offset[b + 1] += offset[b];
+        }
+
+        int size = offset[nblocks];
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int b = 0; b < nblocks; ++b)
+        {
+            int end = std::min(n, (b + 1) * permutation_block_size);
+            int pos = offset[b];
+
+            for(int i = b * permutation_block_size; i < end; ++i)
+            {
+                if(flag[i] != 0)
+                {
+                    perm[i] = pos;
+                    ++pos;
+                }
+                else
+                {
+                    perm[i] = size + i - pos;
+                }
+            }
+        }
+
+        return size;
+    }
+
     template <typename ValueType>
     bool HostMatrixCSR<ValueType>::MaximalIndependentSet(int&             size,
                                                          BaseVector<int>* permutation) const
@@ -2034,104 +2913,319 @@ namespace rocalution
         HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
         assert(cast_perm != NULL);
 
-        int* mis = NULL;
-        allocate_host(this->nrow_, &mis);
-        memset(mis, 0, sizeof(int) * this->nrow_);
+        // Independence in both directions, such that the block of the set is diagonal
+        std::vector<int> adj_ptr;
+        std::vector<int> adj;
+
+        graph_symmetric(this->nrow_, this->mat_.row_offset, this->mat_.col, &adj_ptr, &adj);
+
+        std::vector<int> mis(this->nrow_);
+
+        graph_mis(_get_omp_backend_threads(this->local_backend_, this->nrow_),
+                  this->nrow_,
+                  adj_ptr.data(),
+                  adj.data(),
+                  mis.data());
+
+        cast_perm->Allocate(this->nrow_);
+
+        size = front_permutation(_get_omp_backend_threads(this->local_backend_, this->nrow_),
+                                 this->nrow_,
+                                 mis.data(),
+                                 cast_perm->vec_);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ZeroBlockPermutation(int&             size,
+                                                        BaseVector<int>* permutation) const
+    {
+        assert(permutation != NULL);
+        assert(permutation->GetSize() == this->nrow_);
+        assert(permutation->GetSize() == this->ncol_);
+
+        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+        assert(cast_perm != NULL);
+
+        std::vector<int> hit(this->nrow_, 0);
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                if(ai == this->mat_.col[aj])
+                {
+                    hit[ai] = 1;
+                    break;
+                }
+            }
+        }
+
+        size = front_permutation(_get_omp_backend_threads(this->local_backend_, this->nrow_),
+                                 this->nrow_,
+                                 hit.data(),
+                                 cast_perm->vec_);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::SchurComplement(int                    size,
+                                                   BaseVector<ValueType>* inv_diag,
+                                                   BaseMatrix<ValueType>* E,
+                                                   BaseMatrix<ValueType>* F,
+                                                   BaseMatrix<ValueType>* S) const
+    {
+        assert(inv_diag != NULL);
+        assert(E != NULL);
+        assert(F != NULL);
+        assert(S != NULL);
+        assert(this->nrow_ == this->ncol_);
+        assert(size > 0 && size < this->nrow_);
+        assert(inv_diag->GetSize() == size);
+
+        HostVector<ValueType>*    cast_inv = dynamic_cast<HostVector<ValueType>*>(inv_diag);
+        HostMatrixCSR<ValueType>* cast_E   = dynamic_cast<HostMatrixCSR<ValueType>*>(E);
+        HostMatrixCSR<ValueType>* cast_F   = dynamic_cast<HostMatrixCSR<ValueType>*>(F);
+        HostMatrixCSR<ValueType>* cast_S   = dynamic_cast<HostMatrixCSR<ValueType>*>(S);
+
+        if(cast_inv == NULL || cast_E == NULL || cast_F == NULL || cast_S == NULL)
+        {
+            return false;
+        }
+
+        const int*       row_offset = this->mat_.row_offset;
+        const int*       col        = this->mat_.col;
+        const ValueType* val        = this->mat_.val;
+
+        int nrow = this->nrow_ - size;
+
+        std::vector<int> E_ptr(nrow + 1, 0);
+        std::vector<int> F_ptr(size + 1, 0);
+        std::vector<int> S_ptr(nrow + 1, 0);
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+        // Inverse diagonal of D and the sizes of the rows of F
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < size; ++i)
+        {
+            for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+            {
+                if(col[j] == i)
+                {
+                    cast_inv->vec_[i] = static_cast<ValueType>(1) / val[j];
+                }
+                else if(col[j] >= size)
+                {
+                    ++F_ptr[i + 1];
+                }
+            }
+        }
+
+        // Sizes of the rows of E and of the Schur complement, C - E D^-1 F has the
+        // structure of C and the rows of F that are referenced by E
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<int> marker(nrow, -1);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+            for(int i = 0; i < nrow; ++i)
+            {
+                int ai = size + i;
+
+                for(int j = row_offset[ai]; j < row_offset[ai + 1]; ++j)
+                {
+                    int c = col[j];
+
+                    if(c >= size)
+                    {
+                        if(marker[c - size] != i)
+                        {
+                            marker[c - size] = i;
+                            ++S_ptr[i + 1];
+                        }
+
+                        continue;
+                    }
+
+                    ++E_ptr[i + 1];
+
+                    for(int k = row_offset[c]; k < row_offset[c + 1]; ++k)
+                    {
+                        int cf = col[k] - size;
+
+                        if(cf >= 0 && marker[cf] != i)
+                        {
+                            marker[cf] = i;
+                            ++S_ptr[i + 1];
+                        }
+                    }
+                }
+            }
+        }
+
+        for(int i = 0; i < size; ++i)
+        {
+            F_ptr[i + 1] += F_ptr[i];
+        }
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            E_ptr[i + 1] += E_ptr[i];
+            S_ptr[i + 1] += S_ptr[i];
+        }
+
+        cast_E->AllocateCSR(E_ptr[nrow], nrow, size);
+        cast_F->AllocateCSR(F_ptr[size], size, nrow);
+        cast_S->AllocateCSR(S_ptr[nrow], nrow, nrow);
+
+        // Blocks F and E D^-1
+        if(F_ptr[size] > 0)
+        {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < size; ++i)
+            {
+                int pos = F_ptr[i];
+
+                cast_F->mat_.row_offset[i + 1] = F_ptr[i + 1];
 
-        size = 0;
+                for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+                {
+                    if(col[j] >= size)
+                    {
+                        cast_F->mat_.col[pos] = col[j] - size;
+                        cast_F->mat_.val[pos] = val[j];
+                        ++pos;
+                    }
+                }
+            }
+        }
 
-        for(int ai = 0; ai < this->nrow_; ++ai)
+        if(E_ptr[nrow] > 0)
         {
-            if(mis[ai] == 0)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < nrow; ++i)
             {
-                // set the node
-                mis[ai] = 1;
-                ++size;
+                int ai  = size + i;
+                int pos = E_ptr[i];
 
-                // remove all nbh nodes (without diagonal)
-                for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+                cast_E->mat_.row_offset[i + 1] = E_ptr[i + 1];
+
+                for(int j = row_offset[ai]; j < row_offset[ai + 1]; ++j)
                 {
-                    if(ai != this->mat_.col[aj])
+                    if(col[j] < size)
                     {
-                        mis[this->mat_.col[aj]] = -1;
+                        cast_E->mat_.col[pos] = col[j];
+                        cast_E->mat_.val[pos] = val[j] * cast_inv->vec_[col[j]];
+                        ++pos;
                     }
                 }
             }
         }
 
-        cast_perm->Allocate(this->nrow_);
-
-        int pos = 0;
-        for(int ai = 0; ai < this->nrow_; ++ai)
+        // Schur complement, the sorted structure of each row is built first, then the
+        // entries of C and of E D^-1 F are accumulated
+        if(S_ptr[nrow] > 0)
         {
-            if(mis[ai] == 1)
-            {
-                cast_perm->vec_[ai] = pos;
-                ++pos;
-            }
-            else
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
             {
-                cast_perm->vec_[ai] = size + ai - pos;
-            }
-        }
+                std::vector<int> marker(nrow, -1);
 
-        // Check the permutation
-        //
-        //  for (int ai=0; ai<this->nrow_; ++ai) {
-        //    assert( cast_perm->vec_[ai] >= 0 );
-        //    assert( cast_perm->vec_[ai] < this->nrow_ );
-        //  }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+                for(int i = 0; i < nrow; ++i)
+                {
+                    int  ai    = size + i;
+                    int  begin = S_ptr[i];
+                    int  pos   = begin;
+                    int* S_col = cast_S->mat_.col;
 
-        free_host(&mis);
+                    cast_S->mat_.row_offset[i + 1] = S_ptr[i + 1];
 
-        return true;
-    }
+                    for(int j = row_offset[ai]; j < row_offset[ai + 1]; ++j)
+                    {
+                        int c = col[j];
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ZeroBlockPermutation(int&             size,
-                                                        BaseVector<int>* permutation) const
-    {
-        assert(permutation != NULL);
-        assert(permutation->GetSize() == this->nrow_);
-        assert(permutation->GetSize() == this->ncol_);
+                        if(c >= size)
+                        {
+                            if(marker[c - size] != i)
+                            {
+                                marker[c - size] = i;
+                                S_col[pos++]     = c - size;
+                            }
 
-        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
-        assert(cast_perm != NULL);
+                            continue;
+                        }
 
-        size = 0;
+                        for(int k = row_offset[c]; k < row_offset[c + 1]; ++k)
+                        {
+                            int cf = col[k] - size;
 
-        for(int ai = 0; ai < this->nrow_; ++ai)
-        {
-            for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-            {
-                if(ai == this->mat_.col[aj])
-                {
-                    ++size;
-                }
-            }
-        }
+                            if(cf >= 0 && marker[cf] != i)
+                            {
+                                marker[cf]   = i;
+                                S_col[pos++] = cf;
+                            }
+                        }
+                    }
 
-        int k_z  = size;
-        int k_nz = 0;
+                    std::sort(S_col + begin, S_col + pos);
 
-        for(int ai = 0; ai < this->nrow_; ++ai)
-        {
-            bool hit = false;
+                    // Position of each column within the row
+                    for(int j = begin; j < pos; ++j)
+                    {
+                        marker[S_col[j]] = j;
+                    }
 
-            for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-            {
-                if(ai == this->mat_.col[aj])
-                {
-                    cast_perm->vec_[ai] = k_nz;
-                    ++k_nz;
-                    hit = true;
-                }
-            }
+                    for(int j = row_offset[ai]; j < row_offset[ai + 1]; ++j)
+                    {
+                        int c = col[j];
 
-            if(hit == false)
-            {
-                cast_perm->vec_[ai] = k_z;
-                ++k_z;
+                        if(c >= size)
+                        {
+                            cast_S->mat_.val[marker[c - size]] += val[j];
+                            continue;
+                        }
+
+                        ValueType e = val[j] * cast_inv->vec_[c];
+
+                        for(int k = row_offset[c]; k < row_offset[c + 1]; ++k)
+                        {
+                            int cf = col[k] - size;
+
+                            if(cf >= 0)
+                            {
+                                cast_S->mat_.val[marker[cf]] -= e * val[k];
+                            }
+                        }
+                    }
+
+                    // Reset the marker to a value that no later row can match
+                    for(int j = begin; j < pos; ++j)
+                    {
+                        marker[S_col[j]] = -1;
+                    }
+                }
             }
         }
 
@@ -2264,6 +3358,9 @@ namespace rocalution
             row_offset[i] = 0;
         }
 
+        // Set, if the product cannot be addressed by int
+        bool overflow = false;
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -2315,16 +3412,29 @@ namespace rocalution
 #pragma omp single
 #endif
             {
+                IndexType2 nnz = 0;
+
                 for(int i = 1; i < n + 1; ++i)
                 {
+                    nnz += row_offset[i];
+
+                    if(nnz > std::numeric_limits<int>::max())
+                    {
+                        overflow = true;
+                        break;
+                    }
+
                     row_offset[i] += row_offset[i - 1];
                 }
 
-                allocate_host(row_offset[n], &col);
-                allocate_host(row_offset[n], &val);
+                if(overflow == false)
+                {
+                    allocate_host(row_offset[n], &col);
+                    allocate_host(row_offset[n], &val);
+                }
             }
 
-            for(int ia = chunk_start; ia < chunk_end; ++ia)
+            for(int ia = chunk_start; ia < chunk_end && overflow == false; ++ia)
             {
                 int row_begin = row_offset[ia];
                 int row_end   = row_begin;
@@ -2361,6 +3471,14 @@ namespace rocalution
             }
         }
 
+        if(overflow == true)
+        {
+            LOG_INFO("HostMatrixCSR::MatMatMult() product exceeds 32 bit indexing");
+            free_host(&row_offset);
+
+            return false;
+        }
+
         this->SetDataPtrCSR(
             &row_offset, &col, &val, row_offset[n], cast_mat_A->nrow_, cast_mat_B->ncol_);
 
@@ -2607,6 +3725,189 @@ namespace rocalution
         return true;
     }
 
+    // Work space of the level-of-fill search of a single row
+    struct ilup_work
+    {
+        // Smallest maximal interior node of the paths to a node found so far, and of the
+        // paths of the current length
+        std::vector<int> best;
+        std::vector<int> next_max;
+        // Row that a node was added to the pattern for
+        std::vector<int> marker;
+
+        std::vector<int> front;
+        std::vector<int> front_max;
+        std::vector<int> next;
+        std::vector<int> visited;
+    };
+
+    // Columns of row i of the level-of-fill ILU(p) pattern, in ascending order. (i,j) is an
+    // entry of level l if there is a path of length l+1 from i to j, whose interior nodes
+    // are smaller than i and j. The search extends the paths by one edge per step, only
+    // through nodes smaller than i, and keeps the smallest maximal interior node of the
+    // paths to each node. Paths that are not better than a shorter one are dropped.
+    static void ilup_row_pattern(
+        int i, int p, const int* row_offset, const int* col, ilup_work& w, std::vector<int>* row)
+    {
+        const int none = std::numeric_limits<int>::max();
+
+        row->assign(1, i);
+
+        w.marker[i] = i;
+        w.best[i]   = -1;
+        w.visited.assign(1, i);
+
+        w.front.assign(1, i);
+        w.front_max.assign(1, -1);
+
+        for(int len = 1; len <= p + 1 && w.front.empty() == false; ++len)
+        {
+            w.next.clear();
+
+            for(size_t k = 0; k < w.front.size(); ++k)
+            {
+                int h = w.front[k];
+                int m = (len == 1) ? -1 : std::max(w.front_max[k], h);
+
+                for(int j = row_offset[h]; j < row_offset[h + 1]; ++j)
+                {
+                    int c = col[j];
+
+                    if(m >= w.best[c])
+                    {
+                        continue;
+                    }
+
+                    if(w.next_max[c] == none)
+                    {
+                        w.next.push_back(c);
+                    }
+
+                    w.next_max[c] = std::min(w.next_max[c], m);
+                }
+            }
+
+            w.front.clear();
+            w.front_max.clear();
+
+            for(size_t k = 0; k < w.next.size(); ++k)
+            {
+                int c = w.next[k];
+                int m = w.next_max[c];
+
+                w.next_max[c] = none;
+
+                if(w.best[c] == none)
+                {
+                    w.visited.push_back(c);
+                }
+
+                w.best[c] = m;
+
+                if(w.marker[c] != i && (c > i || m < c))
+                {
+                    w.marker[c] = i;
+                    row->push_back(c);
+                }
+
+                if(c < i)
+                {
+                    w.front.push_back(c);
+                    w.front_max.push_back(m);
+                }
+            }
+        }
+
+        for(size_t k = 0; k < w.visited.size(); ++k)
+        {
+            w.best[w.visited[k]] = none;
+        }
+
+        std::sort(row->begin(), row->end());
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::SymbolicILUp(int p)
+    {
+        assert(p >= 0);
+        assert(this->nrow_ == this->ncol_);
+
+        if(this->nnz_ == 0)
+        {
+            return true;
+        }
+
+        std::vector<int>  row_offset(this->nrow_ + 1, 0);
+        std::vector<int>* new_col = new std::vector<int>[this->nrow_];
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+        // The rows do not depend on each other
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ilup_work w;
+
+            w.best.assign(this->nrow_, std::numeric_limits<int>::max());
+            w.next_max.assign(this->nrow_, std::numeric_limits<int>::max());
+            w.marker.assign(this->nrow_, -1);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 256)
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                ilup_row_pattern(i, p, this->mat_.row_offset, this->mat_.col, w, &new_col[i]);
+
+                row_offset[i + 1] = new_col[i].size();
+            }
+        }
+
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            row_offset[i + 1] += row_offset[i];
+        }
+
+        HostMatrixCSR<ValueType> tmp(this->local_backend_);
+        tmp.CopyFrom(*this);
+
+        this->AllocateCSR(row_offset[this->nrow_], this->nrow_, this->ncol_);
+
+        // Values of the original entries, fill-in entries are zero
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<int> pos(this->nrow_, -1);
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                int begin = row_offset[i];
+
+                this->mat_.row_offset[i + 1] = row_offset[i + 1];
+
+                for(size_t k = 0; k < new_col[i].size(); ++k)
+                {
+                    this->mat_.col[begin + k] = new_col[i][k];
+                    pos[new_col[i][k]]        = begin + k;
+                }
+
+                for(int j = tmp.mat_.row_offset[i]; j < tmp.mat_.row_offset[i + 1]; ++j)
+                {
+                    this->mat_.val[pos[tmp.mat_.col[j]]] += tmp.mat_.val[j];
+                }
+            }
+        }
+
+        delete[] new_col;
+
+        return true;
+    }
+
     template <typename ValueType>
     bool HostMatrixCSR<ValueType>::ILUpFactorizeNumeric(int p, const BaseMatrix<ValueType>& mat)
     {
@@ -2981,10 +4282,117 @@ namespace rocalution
 
             if(diag - sum < lambda_min)
             {
-                lambda_min = diag - sum;
+                lambda_min = diag - sum;
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::SelectFormat(bool accel, unsigned int& mat_format) const
+    {
+        mat_format = CSR;
+
+        if(this->nnz_ == 0)
+        {
+            return true;
+        }
+
+        double nrow = static_cast<double>(this->nrow_);
+        double ncol = static_cast<double>(this->ncol_);
+        double nnz  = static_cast<double>(this->nnz_);
+
+        // Small and (almost) dense matrices
+        if(nrow * ncol <= 4194304.0 && nnz >= 0.5 * nrow * ncol)
+        {
+            mat_format = DENSE;
+            return true;
+        }
+
+        // Row length histogram and bandwidth
+        int max_row   = 0;
+        int bandwidth = 0;
+
+        // Width of the ELL part of a HYB matrix (see csr_to_hyb())
+        int ell_width = (this->nnz_ - 1) / this->nrow_ + 1;
+        int ell_nnz   = 0;
+
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            int row_beg = this->mat_.row_offset[ai];
+            int row_end = this->mat_.row_offset[ai + 1];
+            int row_nnz = row_end - row_beg;
+
+            max_row = std::max(max_row, row_nnz);
+            ell_nnz += std::min(row_nnz, ell_width);
+
+            if(row_nnz > 0)
+            {
+                // Column indices are sorted
+                bandwidth = std::max(bandwidth, std::abs(this->mat_.col[row_beg] - ai));
+                bandwidth = std::max(bandwidth, std::abs(this->mat_.col[row_end - 1] - ai));
+            }
+        }
+
+        // Diagonal structure; 2 * bandwidth + 1 is an upper bound for the number of
+        // diagonals, count them only if the bound is not sufficient already
+        int num_diag = 2 * bandwidth + 1;
+        int max_diag = 5 * (this->nnz_ / this->nrow_);
+
+        if(num_diag * nrow > 1.5 * nnz)
+        {
+            std::vector<bool> diag_idx(this->nrow_ + this->ncol_, false);
+
+            num_diag = 0;
+
+            // Stop, as soon as DIA conversion would fail (see csr_to_dia())
+            for(int ai = 0; ai < this->nrow_ && num_diag <= max_diag; ++ai)
+            {
+                for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+                {
+                    int offset = this->mat_.col[aj] - ai + this->nrow_;
+
+                    if(diag_idx[offset] == false)
+                    {
+                        diag_idx[offset] = true;
+                        ++num_diag;
+                    }
+                }
+            }
+        }
+
+        // Ratio of stored to actual non-zero entries for DIA and ELL
+        double dia_fill = num_diag * nrow / nnz;
+        double ell_fill = max_row * nrow / nnz;
+
+        // Fraction of non-zero entries that fit into the ELL part of HYB
+        double hyb_ell = ell_nnz / nnz;
+
+        // The host kernels process one row per thread, where CSR performs best; padded
+        // formats only pay off on accelerators
+        if(accel == true)
+        {
+            if(dia_fill <= 1.5)
+            {
+                mat_format = DIA;
+            }
+            else if(ell_fill <= 1.5)
+            {
+                mat_format = ELL;
+            }
+            else if(hyb_ell >= 0.8 && ell_width * nrow <= 1.5 * nnz)
+            {
+                mat_format = HYB;
             }
         }
 
+        LOG_VERBOSE_INFO(4,
+                         "*** info: HostMatrixCSR::SelectFormat() max_row="
+                             << max_row << " bandwidth=" << bandwidth << " dia_fill=" << dia_fill
+                             << " ell_fill=" << ell_fill << " hyb_ell=" << hyb_ell << " -> "
+                             << _matrix_format_names[mat_format]);
+
         return true;
     }
 
@@ -3223,6 +4631,8 @@ namespace rocalution
                     }
                 }
             }
+
+            this->ApplyAnalysis();
         }
 
         return true;
@@ -3275,6 +4685,8 @@ namespace rocalution
             this->mat_.row_offset[this->nrow_] = shift;
 
             assert(tmp.nnz_ == shift);
+
+            this->ApplyAnalysis();
         }
 
         return true;
@@ -3325,6 +4737,9 @@ namespace rocalution
             const HostVector<int>* cast_perm = dynamic_cast<const HostVector<int>*>(&permutation);
             assert(cast_perm != NULL);
 
+            // Row offsets are replaced below
+            this->unmap_();
+
             _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
             // Calculate nnz per row
@@ -3422,6 +4837,8 @@ namespace rocalution
             free_host<ValueType>(&val);
             free_host<int>(&row_nnz);
             free_host<int>(&perm_row_nnz);
+
+            this->ApplyAnalysis();
         }
 
         return true;
@@ -3431,6 +4848,7 @@ namespace rocalution
     bool HostMatrixCSR<ValueType>::CMK(BaseVector<int>* permutation) const
     {
         assert(this->nnz_ > 0);
+        assert(this->nrow_ == this->ncol_);
         assert(permutation != NULL);
 
         HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
@@ -3439,108 +4857,15 @@ namespace rocalution
         cast_perm->Clear();
         cast_perm->Allocate(this->nrow_);
 
-        int next     = 0;
-        int head     = 0;
-        int tmp      = 0;
-        int test     = 1;
-        int position = 0;
-        int maxdeg   = 0;
-
-        int* nd         = NULL;
-        int* marker     = NULL;
-        int* levset     = NULL;
-        int* nextlevset = NULL;
-
-        allocate_host<int>(this->nrow_, &nd);
-        allocate_host<int>(this->nrow_, &marker);
-        allocate_host<int>(this->nrow_, &levset);
-        allocate_host<int>(this->nrow_, &nextlevset);
-
-        int qlength = 1;
-
-        for(int k = 0; k < this->nrow_; ++k)
-        {
-            marker[k] = 0;
-            nd[k]     = this->mat_.row_offset[k + 1] - this->mat_.row_offset[k] - 1;
-
-            if(nd[k] > maxdeg)
-            {
-                maxdeg = nd[k];
-            }
-        }
-
-        head               = this->mat_.col[0];
-        levset[0]          = head;
-        cast_perm->vec_[0] = 0;
-        ++next;
-        marker[head] = 1;
-
-        while(next < this->nrow_)
-        {
-            position = 0;
-
-            for(int h = 0; h < qlength; ++h)
-            {
-                head = levset[h];
-
-                for(int k = this->mat_.row_offset[head]; k < this->mat_.row_offset[head + 1]; ++k)
-                {
-                    tmp = this->mat_.col[k];
-
-                    if((marker[tmp] == 0) && (tmp != head))
-                    {
-                        nextlevset[position] = tmp;
-                        marker[tmp]          = 1;
-                        cast_perm->vec_[tmp] = next;
-                        ++next;
-                        ++position;
-                    }
-                }
-            }
-
-            qlength = position;
-
-            while(test == 1)
-            {
-                test = 0;
-
-                for(int j = position - 1; j > 0; --j)
-                {
-                    if(nd[nextlevset[j]] < nd[nextlevset[j - 1]])
-                    {
-                        tmp               = nextlevset[j];
-                        nextlevset[j]     = nextlevset[j - 1];
-                        nextlevset[j - 1] = tmp;
-                        test              = 1;
-                    }
-                }
-            }
-
-            for(int i = 0; i < position; ++i)
-            {
-                levset[i] = nextlevset[i];
-            }
-
-            if(qlength == 0)
-            {
-                for(int i = 0; i < this->nrow_; ++i)
-                {
-                    if(marker[i] == 0)
-                    {
-                        levset[0]          = i;
-                        qlength            = 1;
-                        cast_perm->vec_[i] = next;
-                        marker[i]          = 1;
-                        ++next;
-                    }
-                }
-            }
-        }
+        std::vector<int> adj_ptr;
+        std::vector<int> adj;
 
-        free_host(&nd);
-        free_host(&marker);
-        free_host(&levset);
-        free_host(&nextlevset);
+        graph_symmetric(this->nrow_, this->mat_.row_offset, this->mat_.col, &adj_ptr, &adj);
+        graph_cuthill_mckee(_get_omp_backend_threads(this->local_backend_, this->nrow_),
+                            this->nrow_,
+                            adj_ptr.data(),
+                            adj.data(),
+                            cast_perm->vec_);
 
         return true;
     }
@@ -3593,6 +4918,332 @@ namespace rocalution
         return true;
     }
 
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::NestedDissection(BaseVector<int>* permutation) const
+    {
+        assert(this->nrow_ == this->ncol_);
+        assert(permutation != NULL);
+
+        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+        assert(cast_perm != NULL);
+
+        cast_perm->Clear();
+        cast_perm->Allocate(this->nrow_);
+
+        std::vector<int> adj_ptr;
+        std::vector<int> adj;
+
+        graph_symmetric(this->nrow_, this->mat_.row_offset, this->mat_.col, &adj_ptr, &adj);
+        graph_nested_dissection(_get_omp_backend_threads(this->local_backend_, this->nrow_),
+                                this->nrow_,
+                                adj_ptr.data(),
+                                adj.data(),
+                                cast_perm->vec_);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::LocalityOrder(int block_size, BaseVector<int>* permutation) const
+    {
+        assert(block_size > 0);
+        assert(this->nrow_ == this->ncol_);
+        assert(permutation != NULL);
+
+        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+        assert(cast_perm != NULL);
+
+        cast_perm->Clear();
+        cast_perm->Allocate(this->nrow_);
+
+        std::vector<int> adj_ptr;
+        std::vector<int> adj;
+
+        graph_symmetric(this->nrow_, this->mat_.row_offset, this->mat_.col, &adj_ptr, &adj);
+        graph_locality_order(_get_omp_backend_threads(this->local_backend_, this->nrow_),
+                             this->nrow_,
+                             adj_ptr.data(),
+                             adj.data(),
+                             block_size,
+                             cast_perm->vec_);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::Partition(int nparts, BaseVector<int>* partition) const
+    {
+        assert(nparts > 0);
+        assert(nparts <= this->nrow_);
+        assert(this->nrow_ == this->ncol_);
+        assert(partition != NULL);
+
+        HostVector<int>* cast_part = dynamic_cast<HostVector<int>*>(partition);
+        assert(cast_part != NULL);
+
+        cast_part->Clear();
+        cast_part->Allocate(this->nrow_);
+
+        int n = this->nrow_;
+
+        // Adjacency graph of the structure of A + A^T, without the diagonal
+        std::vector<int> adj_ptr;
+        std::vector<int> adj;
+
+        graph_symmetric(n, this->mat_.row_offset, this->mat_.col, &adj_ptr, &adj);
+
+        // Nodes of all parts, each part is a contiguous range of vtx
+        std::vector<int> vtx(n);
+        // Id of the range a node belongs to (its first position in vtx)
+        std::vector<int> region(n, 0);
+        // Side of a node in the current bisection
+        std::vector<int> side(n);
+        // Breadth-first search helpers
+        std::vector<int> order(n);
+        std::vector<int> visited(n, -1);
+        std::vector<int> gain(n);
+        std::vector<int> locked(n, -1);
+
+        for(int i = 0; i < n; ++i)
+        {
+            vtx[i] = i;
+        }
+
+        // Stack of ranges [begin, end) that are split into nsub parts starting at part
+        struct range
+        {
+            int begin;
+            int end;
+            int part;
+            int nsub;
+        };
+
+        std::vector<range> stack(1);
+
+        stack[0].begin = 0;
+        stack[0].end   = n;
+        stack[0].part  = 0;
+        stack[0].nsub  = nparts;
+
+        int stamp = 0;
+
+        while(stack.empty() == false)
+        {
+            range r = stack.back();
+            stack.pop_back();
+
+            if(r.nsub == 1)
+            {
+                for(int i = r.begin; i < r.end; ++i)
+                {
+                    cast_part->vec_[vtx[i]] = r.part;
+                }
+
+                continue;
+            }
+
+            int size  = r.end - r.begin;
+            int nsub0 = r.nsub / 2;
+            int size0 = static_cast<int>(static_cast<IndexType2>(size) * nsub0 / r.nsub);
+
+            // Breadth-first search within the range, restricted to its nodes. The first
+            // component is started from a pseudo-peripheral node, found by searching from
+            // the node of minimal degree and restarting from the last node reached.
+            int head = vtx[r.begin];
+
+            for(int i = r.begin + 1; i < r.end; ++i)
+            {
+                if(adj_ptr[vtx[i] + 1] - adj_ptr[vtx[i]] < adj_ptr[head + 1] - adj_ptr[head])
+                {
+                    head = vtx[i];
+                }
+            }
+
+            int length = 0;
+            int next   = r.begin;
+
+            for(int sweep = 0; sweep < 3; ++sweep)
+            {
+                ++stamp;
+
+                length          = 0;
+                next            = r.begin;
+                order[length++] = head;
+                visited[head]   = stamp;
+
+                for(int q = 0; q < size; ++q)
+                {
+                    // Restart in the next unvisited node if this component is exhausted
+                    if(q == length)
+                    {
+                        // Only the first component is needed to find the peripheral node
+                        if(sweep < 2)
+                        {
+                            break;
+                        }
+
+                        while(visited[vtx[next]] == stamp)
+                        {
+                            ++next;
+                        }
+
+                        order[length++]    = vtx[next];
+                        visited[vtx[next]] = stamp;
+                    }
+
+                    int v = order[q];
+
+                    for(int j = adj_ptr[v]; j < adj_ptr[v + 1]; ++j)
+                    {
+                        int u = adj[j];
+
+                        if(region[u] == r.begin && visited[u] != stamp)
+                        {
+                            visited[u]      = stamp;
+                            order[length++] = u;
+                        }
+                    }
+                }
+
+                if(sweep < 2)
+                {
+                    head = order[length - 1];
+                }
+            }
+
+            for(int i = 0; i < size; ++i)
+            {
+                side[order[i]] = (i < size0) ? 0 : 1;
+            }
+
+            // Refine the bisection by swapping pairs of boundary nodes, which keeps
+            // both halves at their size
+            for(int pass = 0; pass < 8; ++pass)
+            {
+                std::vector<std::pair<int, int>> cand[2];
+
+                for(int i = r.begin; i < r.end; ++i)
+                {
+                    int v   = vtx[i];
+                    int ext = 0;
+                    int itn = 0;
+
+                    for(int j = adj_ptr[v]; j < adj_ptr[v + 1]; ++j)
+                    {
+                        int u = adj[j];
+
+                        if(region[u] == r.begin)
+                        {
+                            if(side[u] == side[v])
+                            {
+                                ++itn;
+                            }
+                            else
+                            {
+                                ++ext;
+                            }
+                        }
+                    }
+
+                    gain[v] = ext - itn;
+
+                    if(ext > 0)
+                    {
+                        cand[side[v]].push_back(std::pair<int, int>(-gain[v], v));
+                    }
+                }
+
+                std::sort(cand[0].begin(), cand[0].end());
+                std::sort(cand[1].begin(), cand[1].end());
+
+                ++stamp;
+
+                int    swaps = 0;
+                size_t p0    = 0;
+                size_t p1    = 0;
+
+                while(p0 < cand[0].size() && p1 < cand[1].size())
+                {
+                    int a = cand[0][p0].second;
+                    int b = cand[1][p1].second;
+
+                    // Nodes next to a swapped node have outdated gains
+                    if(locked[a] == stamp)
+                    {
+                        ++p0;
+                        continue;
+                    }
+
+                    if(locked[b] == stamp)
+                    {
+                        ++p1;
+                        continue;
+                    }
+
+                    int coupled = 0;
+                    for(int j = adj_ptr[a]; j < adj_ptr[a + 1]; ++j)
+                    {
+                        if(adj[j] == b)
+                        {
+                            coupled = 1;
+                            break;
+                        }
+                    }
+
+                    // Candidates are sorted by gain, no further improvement can be found
+                    if(gain[a] + gain[b] - 2 * coupled <= 0)
+                    {
+                        break;
+                    }
+
+                    side[a] = 1;
+                    side[b] = 0;
+
+                    for(int j = adj_ptr[a]; j < adj_ptr[a + 1]; ++j)
+                    {
+                        locked[adj[j]] = stamp;
+                    }
+
+                    for(int j = adj_ptr[b]; j < adj_ptr[b + 1]; ++j)
+                    {
+                        locked[adj[j]] = stamp;
+                    }
+
+                    locked[a] = stamp;
+                    locked[b] = stamp;
+
+                    ++swaps;
+                    ++p0;
+                    ++p1;
+                }
+
+                if(swaps == 0)
+                {
+                    break;
+                }
+            }
+
+            // Reorder the range such that the first half precedes the second one
+            std::stable_partition(vtx.begin() + r.begin,
+                                  vtx.begin() + r.end,
+                                  [&side](int v) { return side[v] == 0; });
+
+            // The second half forms a new range, the first one keeps the id
+            for(int i = r.begin + size0; i < r.end; ++i)
+            {
+                region[vtx[i]] = r.begin + size0;
+            }
+
+            range r0 = {r.begin, r.begin + size0, r.part, nsub0};
+            range r1 = {r.begin + size0, r.end, r.part + nsub0, r.nsub - nsub0};
+
+            stack.push_back(r1);
+            stack.push_back(r0);
+        }
+
+        return true;
+    }
+
     template <typename ValueType>
     bool HostMatrixCSR<ValueType>::CreateFromMap(const BaseVector<int>& map, int n, int m)
     {
@@ -3750,102 +5401,27 @@ namespace rocalution
         return true;
     }
 
-    // ----------------------------------------------------------
-    // original function aggregates( const spmat &A,
-    //                               const std::vector<char> &S )
-    // ----------------------------------------------------------
-    // Modified and adapted from AMGCL,
-    // https://github.com/ddemidov/amgcl
-    // MIT License
-    // ----------------------------------------------------------
-    // CHANGELOG
-    // - adapted interface
-    // ----------------------------------------------------------
     template <typename ValueType>
     bool HostMatrixCSR<ValueType>::AMGAggregate(const BaseVector<int>& connections,
-                                                BaseVector<int>*       aggregates) const
-    {
-        assert(aggregates != NULL);
-
-        HostVector<int>*       cast_agg  = dynamic_cast<HostVector<int>*>(aggregates);
-        const HostVector<int>* cast_conn = dynamic_cast<const HostVector<int>*>(&connections);
-
-        assert(cast_agg != NULL);
-        assert(cast_conn != NULL);
-
-        aggregates->Clear();
-        aggregates->Allocate(this->nrow_);
-
-        const int undefined = -1;
-        const int removed   = -2;
-
-        // Remove nodes without neighbours
-        int max_neib = 0;
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            int j = this->mat_.row_offset[i];
-            int e = this->mat_.row_offset[i + 1];
-
-            max_neib = std::max(e - j, max_neib);
-
-            int state = removed;
-            for(; j < e; ++j)
-            {
-                if(cast_conn->vec_[j])
-                {
-                    state = undefined;
-                    break;
-                }
-            }
-
-            cast_agg->vec_[i] = state;
-        }
-
-        std::vector<int> neib;
-        neib.reserve(max_neib);
-
-        int last_g = -1;
-
-        // Perform plain aggregation
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            if(cast_agg->vec_[i] != undefined)
-            {
-                continue;
-            }
+                                                BaseVector<int>*       aggregates) const
+    {
+        assert(aggregates != NULL);
 
-            // The point is not adjacent to a core of any previous aggregate:
-            // so its a seed of a new aggregate.
-            cast_agg->vec_[i] = ++last_g;
+        HostVector<int>*       cast_agg  = dynamic_cast<HostVector<int>*>(aggregates);
+        const HostVector<int>* cast_conn = dynamic_cast<const HostVector<int>*>(&connections);
 
-            neib.clear();
+        assert(cast_agg != NULL);
+        assert(cast_conn != NULL);
 
-            // Include its neighbors as well.
-            for(int j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e; ++j)
-            {
-                int c = this->mat_.col[j];
-                if(cast_conn->vec_[j] && cast_agg->vec_[c] != removed)
-                {
-                    cast_agg->vec_[c] = last_g;
-                    neib.push_back(c);
-                }
-            }
+        aggregates->Clear();
+        aggregates->Allocate(this->nrow_);
 
-            // Temporarily mark undefined points adjacent to the new aggregate as
-            // belonging to the aggregate. If nobody claims them later, they will
-            // stay here.
-            for(typename std::vector<int>::const_iterator nb = neib.begin(); nb != neib.end(); ++nb)
-            {
-                for(int j = this->mat_.row_offset[*nb], e = this->mat_.row_offset[*nb + 1]; j < e;
-                    ++j)
-                {
-                    if(cast_conn->vec_[j] && cast_agg->vec_[this->mat_.col[j]] == undefined)
-                    {
-                        cast_agg->vec_[this->mat_.col[j]] = last_g;
-                    }
-                }
-            }
-        }
+        graph_mis2_aggregate(_get_omp_backend_threads(this->local_backend_, this->nrow_),
+                             this->nrow_,
+                             this->mat_.row_offset,
+                             this->mat_.col,
+                             cast_conn->vec_,
+                             cast_agg->vec_);
 
         return true;
     }
@@ -4260,6 +5836,9 @@ namespace rocalution
     template <typename ValueType>
     bool HostMatrixCSR<ValueType>::SPAI(void)
     {
+        // Values are replaced below
+        this->unmap_();
+
         int nrow = this->nrow_;
         int nnz  = this->nnz_;
 
@@ -4359,1387 +5938,1119 @@ namespace rocalution
 
         this->Transpose();
 
-        return true;
-    }
-
-    // ----------------------------------------------------------
-    // original functions:
-    //   transfer_operators(const Matrix &A, const params &prm)
-    //   connect(backend::crs<Val, Col, Ptr> const &A,
-    //           float eps_strong,
-    //           backend::crs<char, Col, Ptr> &S,
-    //           std::vector<char> &cf)
-    //   cfsplit(backend::crs<Val, Col, Ptr> const &A,
-    //           backend::crs<char, Col, Ptr> const &S,
-    //           std::vector<char> &cf)
-    // ----------------------------------------------------------
-    // Modified and adopted from AMGCL,
-    // https://github.com/ddemidov/amgcl
-    // MIT License
-    // ----------------------------------------------------------
-    // CHANGELOG
-    // - adopted interface
-    // ----------------------------------------------------------
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::RugeStueben(ValueType              eps,
-                                               BaseMatrix<ValueType>* prolong,
-                                               BaseMatrix<ValueType>* restrict) const
-    {
-        assert(prolong != NULL);
-        assert(restrict != NULL);
-
-        HostMatrixCSR<ValueType>* cast_prolong  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong);
-        HostMatrixCSR<ValueType>* cast_restrict = dynamic_cast<HostMatrixCSR<ValueType>*>(restrict);
-
-        assert(cast_prolong != NULL);
-        assert(cast_restrict != NULL);
-
-        // Allocate
-        cast_prolong->Clear();
-        cast_prolong->AllocateCSR(this->nnz_, this->nrow_, this->ncol_);
-
-        // Array to hold C-F points
-        int* connect = NULL;
-
-        allocate_host(this->nrow_, &connect);
-
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            connect[i] = -1;
-        }
-
-        // Array of strong couplings S
-        int* S_row_offset = NULL;
-        int* S_col        = NULL;
-        int* S_val        = NULL;
-
-        allocate_host(this->nrow_ + 1, &S_row_offset);
-        allocate_host(this->nnz_, &S_val);
-
-        set_to_zero_host(this->nrow_ + 1, S_row_offset);
-        set_to_zero_host(this->nnz_, S_val);
-
-// Determine strong influences in matrix (Ruge Stüben approach)
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            int sign_diag = -1;
-
-            // Determine diagonal sign
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-            {
-                if(this->mat_.col[j] == i)
-                {
-                    sign_diag = (this->mat_.val[j] < static_cast<ValueType>(0)) ? -1 : 1;
-                }
-            }
-
-            ValueType val = static_cast<ValueType>(0);
-
-            // Look up val = max|a_ik| with i != k and a_ik < 0 if a_ii > 0 or a_ik > 0 if a_ii < 0
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-            {
-                if(this->mat_.col[j] != i)
-                {
-                    if(sign_diag == 1)
-                    {
-                        val = (this->mat_.val[j] < val) ? this->mat_.val[j] : val;
-                    }
-
-                    if(sign_diag == -1)
-                    {
-                        val = (this->mat_.val[j] > val) ? this->mat_.val[j] : val;
-                    }
-                }
-            }
-
-            // if val is zero -> i is independent of other grid points
-            if(val == static_cast<ValueType>(0))
-            {
-                connect[i] = 0;
-                continue;
-            }
-
-            // val = eps * a_ik
-            val *= eps;
-
-            // Fill S
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-            {
-                S_val[j] = this->mat_.col[j] != i && this->mat_.val[j] < val;
-            }
-        }
-
-        // Transpose S
-        for(int i = 0; i < this->nnz_; ++i)
-        {
-            if(S_val[i])
-            {
-                S_row_offset[this->mat_.col[i] + 1]++;
-            }
-        }
-
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            S_row_offset[i + 1] += S_row_offset[i];
-        }
-
-        allocate_host(S_row_offset[this->nrow_], &S_col);
-
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-            {
-                if(S_val[j])
-                {
-                    S_col[S_row_offset[this->mat_.col[j]]++] = i;
-                }
-            }
-        }
-
-        for(int i = this->nrow_; i > 0; --i)
-        {
-            S_row_offset[i] = S_row_offset[i - 1];
-        }
-
-        S_row_offset[0] = 0;
-
-        // Split into C and F
-        std::vector<int> lambda(this->nrow_);
-
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            int temp = 0;
-            for(int j = S_row_offset[i]; j < S_row_offset[i + 1]; ++j)
-            {
-                temp += (connect[S_col[j]] == -1 ? 1 : 2);
-            }
-
-            lambda[i] = temp;
-        }
-
-        std::vector<int> ptr(this->nrow_ + 1, static_cast<int>(0));
-        std::vector<int> cnt(this->nrow_, static_cast<int>(0));
-        std::vector<int> i2n(this->nrow_);
-        std::vector<int> n2i(this->nrow_);
-
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            ptr[lambda[i] + 1]++;
-        }
-
-        for(unsigned int i = 1; i < ptr.size(); ++i)
-        {
-            ptr[i] += ptr[i - 1];
-        }
-
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            int lam  = lambda[i];
-            int idx  = ptr[lam] + cnt[lam]++;
-            i2n[idx] = i;
-            n2i[i]   = idx;
-        }
-
-        for(int top = this->nrow_ - 1; top >= 0; --top)
-        {
-            int i   = i2n[top];
-            int lam = lambda[i];
-
-            if(lam == 0)
-            {
-                for(int ai = 0; ai < this->nrow_; ++ai)
-                {
-                    if(connect[ai] == -1)
-                    {
-                        connect[ai] = 1;
-                    }
-                }
-
-                break;
-            }
-
-            cnt[lam]--;
-
-            if(connect[i] == 0)
-            {
-                continue;
-            }
-
-            assert(connect[i] == -1);
-
-            connect[i] = 1;
-
-            for(int j = S_row_offset[i]; j < S_row_offset[i + 1]; ++j)
-            {
-                int c = S_col[j];
-
-                if(connect[c] != -1)
-                {
-                    continue;
-                }
-
-                connect[c] = 0;
-
-                for(int jj = this->mat_.row_offset[c]; jj < this->mat_.row_offset[c + 1]; ++jj)
-                {
-                    if(!S_val[jj])
-                    {
-                        continue;
-                    }
-
-                    int cc     = this->mat_.col[jj];
-                    int lam_cc = lambda[cc];
-
-                    if(connect[cc] != -1 || lam_cc >= this->nrow_ - 1)
-                    {
-                        continue;
-                    }
-
-                    int old_pos = n2i[cc];
-                    int new_pos = ptr[lam_cc] + cnt[lam_cc] - 1;
-
-                    n2i[i2n[old_pos]] = new_pos;
-                    n2i[i2n[new_pos]] = old_pos;
-
-                    std::swap(i2n[old_pos], i2n[new_pos]);
-
-                    --cnt[lam_cc];
-                    ++cnt[lam_cc + 1];
-                    ptr[lam_cc + 1] = ptr[lam_cc] + cnt[lam_cc];
-
-                    ++lambda[cc];
-                }
-            }
-
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-            {
-                if(!S_val[j])
-                {
-                    continue;
-                }
-
-                int c   = this->mat_.col[j];
-                int lam = lambda[c];
-
-                if(connect[c] != -1 || lam == 0)
-                {
-                    continue;
-                }
-
-                int old_pos = n2i[c];
-                int new_pos = ptr[lam];
-
-                n2i[i2n[old_pos]] = new_pos;
-                n2i[i2n[new_pos]] = old_pos;
-
-                std::swap(i2n[old_pos], i2n[new_pos]);
-
-                --cnt[lam];
-                ++cnt[lam - 1];
-                ++ptr[lam];
-                --lambda[c];
-
-                assert(ptr[lam - 1] == ptr[lam] - cnt[lam - 1]);
-            }
-        }
-
-        // Build coarsening operators
-        int              nc = 0;
-        std::vector<int> cidx(this->nrow_);
-
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            if(connect[i] == 1)
-            {
-                cidx[i] = nc++;
-            }
-        }
-
-        std::vector<ValueType> Amin(this->nrow_);
-        std::vector<ValueType> Amax(this->nrow_);
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            if(connect[i] == 1)
-            {
-                ++cast_prolong->mat_.row_offset[i + 1];
-                continue;
-            }
+        return true;
+    }
 
-            ValueType amin = static_cast<ValueType>(0);
-            ValueType amax = static_cast<ValueType>(0);
+    // ----------------------------------------------------------
+    // original functions:
+    //   transfer_operators(const Matrix &A, const params &prm)
+    //   connect(backend::crs<Val, Col, Ptr> const &A,
+    //           float eps_strong,
+    //           backend::crs<char, Col, Ptr> &S,
+    //           std::vector<char> &cf)
+    //   cfsplit(backend::crs<Val, Col, Ptr> const &A,
+    //           backend::crs<char, Col, Ptr> const &S,
+    //           std::vector<char> &cf)
+    // ----------------------------------------------------------
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::RugeStueben(ValueType              eps,
+                                               BaseMatrix<ValueType>* prolong,
+                                               BaseMatrix<ValueType>* restrict) const
+    {
+        return this->RugeStueben(eps, 0, 0, false, 0, prolong, restrict);
+    }
 
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-            {
-                if(!S_val[j] || connect[this->mat_.col[j]] != 1)
-                {
-                    continue;
-                }
+    // Modified and adopted from AMGCL,
+    // https://github.com/ddemidov/amgcl
+    // MIT License
+    // ----------------------------------------------------------
+    // CHANGELOG
+    // - adopted interface
+    // - PMIS / HMIS splitting and aggressive coarsening
+    // - extended+i interpolation and truncation
+    // ----------------------------------------------------------
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::RugeStueben(ValueType              eps,
+                                               int                    coarsening,
+                                               int                    interpolation,
+                                               bool                   aggressive,
+                                               int                    max_elements,
+                                               BaseMatrix<ValueType>* prolong,
+                                               BaseMatrix<ValueType>* restrict) const
+    {
+        assert(prolong != NULL);
+        assert(restrict != NULL);
 
-                amin = (amin < this->mat_.val[j]) ? amin : this->mat_.val[j];
-                amax = (amax > this->mat_.val[j]) ? amax : this->mat_.val[j];
-            }
+        HostMatrixCSR<ValueType>* cast_prolong  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong);
+        HostMatrixCSR<ValueType>* cast_restrict = dynamic_cast<HostMatrixCSR<ValueType>*>(restrict);
 
-            Amin[i] = amin = amin * static_cast<ValueType>(0.2);
-            Amax[i] = amax = amax * static_cast<ValueType>(0.2);
+        assert(cast_prolong != NULL);
+        assert(cast_restrict != NULL);
 
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-            {
-                if(!S_val[j] || connect[this->mat_.col[j]] != 1)
-                {
-                    continue;
-                }
+        // Array to hold C-F points
+        int* connect = NULL;
 
-                if(this->mat_.val[j] <= amin || this->mat_.val[j] >= amax)
-                {
-                    ++cast_prolong->mat_.row_offset[i + 1];
-                }
-            }
-        }
+        allocate_host(this->nrow_, &connect);
 
         for(int i = 0; i < this->nrow_; ++i)
         {
-            cast_prolong->mat_.row_offset[i + 1] += cast_prolong->mat_.row_offset[i];
+            connect[i] = -1;
         }
 
-        cast_prolong->mat_.col = (int*)realloc(
-            cast_prolong->mat_.col, cast_prolong->mat_.row_offset[this->nrow_] * sizeof(int));
-        cast_prolong->mat_.val = (ValueType*)realloc(
-            cast_prolong->mat_.val, cast_prolong->mat_.row_offset[this->nrow_] * sizeof(ValueType));
+        // Array of strong couplings S
+        int* S_val = NULL;
+
+        allocate_host(this->nnz_, &S_val);
 
-        cast_prolong->nnz_  = cast_prolong->mat_.row_offset[this->nrow_];
-        cast_prolong->ncol_ = nc;
+        set_to_zero_host(this->nnz_, S_val);
 
+// Determine strong influences in matrix (Ruge Stüben approach)
 #ifdef _OPENMP
 #pragma omp parallel for schedule(dynamic, 1024)
 #endif
         for(int i = 0; i < this->nrow_; ++i)
         {
-            int row_head = cast_prolong->mat_.row_offset[i];
+            int sign_diag = -1;
 
-            if(connect[i] == 1)
+            // Determine diagonal sign
+            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
             {
-                cast_prolong->mat_.col[row_head] = cidx[i];
-                cast_prolong->mat_.val[row_head] = static_cast<ValueType>(1);
-                continue;
+                if(this->mat_.col[j] == i)
+                {
+                    sign_diag = (this->mat_.val[j] < static_cast<ValueType>(0)) ? -1 : 1;
+                }
             }
 
-            ValueType diag  = static_cast<ValueType>(0);
-            ValueType a_num = static_cast<ValueType>(0), a_den = static_cast<ValueType>(0);
-            ValueType b_num = static_cast<ValueType>(0), b_den = static_cast<ValueType>(0);
-            ValueType d_neg = static_cast<ValueType>(0), d_pos = static_cast<ValueType>(0);
+            ValueType val = static_cast<ValueType>(0);
 
+            // Look up val = max|a_ik| with i != k and a_ik < 0 if a_ii > 0 or a_ik > 0 if a_ii < 0
             for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
             {
-                int       c = this->mat_.col[j];
-                ValueType v = this->mat_.val[j];
-
-                if(c == i)
-                {
-                    diag = v;
-                    continue;
-                }
-
-                if(v < static_cast<ValueType>(0))
+                if(this->mat_.col[j] != i)
                 {
-                    a_num += v;
-                    if(S_val[j] && connect[c] == 1)
+                    if(sign_diag == 1)
                     {
-                        a_den += v;
-                        if(v > Amin[i])
-                        {
-                            d_neg += v;
-                        }
+                        val = (this->mat_.val[j] < val) ? this->mat_.val[j] : val;
                     }
-                }
-                else
-                {
-                    b_num += v;
-                    if(S_val[j] && connect[c] == 1)
+
+                    if(sign_diag == -1)
                     {
-                        b_den += v;
-                        if(v < Amax[i])
-                        {
-                            d_pos += v;
-                        }
+                        val = (this->mat_.val[j] > val) ? this->mat_.val[j] : val;
                     }
                 }
             }
 
-            ValueType cf_neg = static_cast<ValueType>(1);
-            ValueType cf_pos = static_cast<ValueType>(1);
-
-            if(std::abs(a_den - d_neg) > 1e-32)
+            // if val is zero -> i is independent of other grid points
+            if(val == static_cast<ValueType>(0))
             {
-                cf_neg = a_den / (a_den - d_neg);
+                connect[i] = 0;
+                continue;
             }
 
-            if(std::abs(b_den - d_pos) > 1e-32)
-            {
-                cf_pos = b_den / (b_den - d_pos);
-            }
+            // val = eps * a_ik
+            val *= eps;
 
-            if(b_num > static_cast<ValueType>(0) && std::abs(b_den) < 1e-32)
+            // Fill S
+            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
             {
-                diag += b_num;
+                S_val[j] = this->mat_.col[j] != i && this->mat_.val[j] < val;
             }
+        }
 
-            ValueType alpha = std::abs(a_den) > 1e-32 ? -cf_neg * a_num / (diag * a_den)
-                                                      : static_cast<ValueType>(0);
-            ValueType beta = std::abs(b_den) > 1e-32 ? -cf_pos * b_num / (diag * b_den)
-                                                     : static_cast<ValueType>(0);
+        // Compress S, row i holds the points that i strongly depends on
+        std::vector<int> S_ptr(this->nrow_ + 1, 0);
 
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(int i = 0; i < this->nrow_; ++i)
+        {
             for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
             {
-                int       c = this->mat_.col[j];
-                ValueType v = this->mat_.val[j];
-
-                if(!S_val[j] || connect[c] != 1)
-                {
-                    continue;
-                }
-
-                if(v > Amin[i] && v < Amax[i])
-                {
-                    continue;
-                }
-
-                cast_prolong->mat_.col[row_head] = cidx[c];
-                cast_prolong->mat_.val[row_head]
-                    = (v < static_cast<ValueType>(0) ? alpha : beta) * v;
-                ++row_head;
+                S_ptr[i + 1] += S_val[j];
             }
         }
 
-        free_host(&connect);
-        free_host(&S_row_offset);
-        free_host(&S_col);
-        free_host(&S_val);
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            S_ptr[i + 1] += S_ptr[i];
+        }
+
+        std::vector<int> S_col(S_ptr[this->nrow_]);
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic, 1024)
 #endif
-        for(int i = 0; i < cast_prolong->GetM(); ++i)
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            for(int j = cast_prolong->mat_.row_offset[i]; j < cast_prolong->mat_.row_offset[i + 1];
-                ++j)
+            int idx = S_ptr[i];
+
+            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
             {
-                for(int jj = cast_prolong->mat_.row_offset[i];
-                    jj < cast_prolong->mat_.row_offset[i + 1] - 1;
-                    ++jj)
+                if(S_val[j])
                 {
-                    if(cast_prolong->mat_.col[jj] > cast_prolong->mat_.col[jj + 1])
-                    {
-                        // swap elements
-                        int       ind = cast_prolong->mat_.col[jj];
-                        ValueType val = cast_prolong->mat_.val[jj];
-
-                        cast_prolong->mat_.col[jj] = cast_prolong->mat_.col[jj + 1];
-                        cast_prolong->mat_.val[jj] = cast_prolong->mat_.val[jj + 1];
-
-                        cast_prolong->mat_.col[jj + 1] = ind;
-                        cast_prolong->mat_.val[jj + 1] = val;
-                    }
+                    S_col[idx++] = this->mat_.col[j];
                 }
             }
         }
 
-        cast_restrict->CopyFrom(*cast_prolong);
-        cast_restrict->Transpose();
+        // Transpose S, row i holds the points that strongly depend on i
+        std::vector<int> ST_ptr;
+        std::vector<int> ST_col;
 
-        return true;
-    }
+        graph_transpose(this->nrow_, S_ptr.data(), S_col.data(), &ST_ptr, &ST_col);
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::InitialPairwiseAggregation(ValueType        beta,
-                                                              int&             nc,
-                                                              BaseVector<int>* G,
-                                                              int&             Gsize,
-                                                              int**            rG,
-                                                              int&             rGsize,
-                                                              int              ordering) const
-    {
-        assert(G != NULL);
+        // Aggressive coarsening splits the distance-two strength graph
+        std::vector<int> S2_ptr;
+        std::vector<int> S2_col;
+        std::vector<int> S2T_ptr;
+        std::vector<int> S2T_col;
 
-        HostVector<int>* cast_G = dynamic_cast<HostVector<int>*>(G);
+        if(aggressive == true)
+        {
+            rs_strength_power2(_get_omp_backend_threads(this->local_backend_, this->nrow_),
+                               this->nrow_,
+                               S_ptr.data(),
+                               S_col.data(),
+                               &S2_ptr,
+                               &S2_col);
+            graph_transpose(this->nrow_, S2_ptr.data(), S2_col.data(), &S2T_ptr, &S2T_col);
+        }
 
-        assert(cast_G != NULL);
+        const int* split_ptr  = (aggressive == true) ? S2_ptr.data() : S_ptr.data();
+        const int* split_col  = (aggressive == true) ? S2_col.data() : S_col.data();
+        const int* split_tptr = (aggressive == true) ? S2T_ptr.data() : ST_ptr.data();
+        const int* split_tcol = (aggressive == true) ? S2T_col.data() : ST_col.data();
 
-        // Initialize G
-        for(int i = 0; i < cast_G->size_; ++i)
+        // Split into C and F
+        if(coarsening == 1)
+        {
+            rs_pmis_split(_get_omp_backend_threads(this->local_backend_, this->nrow_),
+                          this->nrow_,
+                          split_ptr,
+                          split_col,
+                          split_tptr,
+                          split_tcol,
+                          connect);
+        }
+        else if(coarsening == 2)
+        {
+            rs_hmis_split(_get_omp_backend_threads(this->local_backend_, this->nrow_),
+                          this->nrow_,
+                          split_ptr,
+                          split_col,
+                          split_tptr,
+                          split_tcol,
+                          connect);
+        }
+        else
         {
-            cast_G->vec_[i] = -2;
+            rs_classical_split(
+                0, this->nrow_, split_ptr, split_col, split_tptr, split_tcol, true, connect);
         }
 
-        int  Usize    = 0;
-        int* ind_diag = NULL;
-        allocate_host(this->nrow_, &ind_diag);
+        // Build coarsening operators
+        int              nc = 0;
+        std::vector<int> cidx(this->nrow_);
 
-        // Build U
         for(int i = 0; i < this->nrow_; ++i)
         {
-            ValueType sum = static_cast<ValueType>(0);
-
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-            {
-                if(i != this->mat_.col[j])
-                {
-                    sum += std::abs(this->mat_.val[j]);
-                }
-                else
-                {
-                    ind_diag[i] = j;
-                }
-            }
-
-            sum *= static_cast<ValueType>(5);
-
-            if(this->mat_.val[ind_diag[i]] > sum)
+            if(connect[i] == 1)
             {
-                cast_G->vec_[i] = -1;
-                ++Usize;
+                cidx[i] = nc++;
             }
         }
 
-        // Initialize rG and sizes
-        Gsize  = 2;
-        rGsize = this->nrow_ - Usize;
-        allocate_host(Gsize * rGsize, rG);
-
-        for(int i = 0; i < Gsize * rGsize; ++i)
+        // F points of aggressive coarsening may only have C points in distance two, thus
+        // extended+i interpolation is used in this case
+        if(interpolation == 1 || aggressive == true)
         {
-            (*rG)[i] = -1;
-        }
+            int* P_row_offset = NULL;
+            int* P_col        = NULL;
 
-        nc              = 0;
-        ValueType betam = -beta;
+            ValueType* P_val = NULL;
 
-        // Ordering
-        HostVector<int> perm(this->local_backend_);
+            allocate_host(this->nrow_ + 1, &P_row_offset);
+            set_to_zero_host(this->nrow_ + 1, P_row_offset);
 
-        switch(ordering)
-        {
-        case 0: // No ordering
-            break;
+            // Interpolatory set of F point i, its strong C neighbours and the strong C
+            // neighbours of its strong F neighbours
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+            {
+                // marker[j] == i if j is part of the interpolatory set of i
+                std::vector<int> marker(this->nrow_, -1);
 
-        case 1: // Connectivity ordering
-            this->ConnectivityOrder(&perm);
-            break;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+                for(int i = 0; i < this->nrow_; ++i)
+                {
+                    if(connect[i] == 1)
+                    {
+                        P_row_offset[i + 1] = 1;
+                        continue;
+                    }
+
+                    int count = 0;
 
-        case 2: // CMK
-            this->CMK(&perm);
-            break;
+                    for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+                    {
+                        if(!S_val[j])
+                        {
+                            continue;
+                        }
 
-        case 3: // RCMK
-            this->RCMK(&perm);
-            break;
+                        int k = this->mat_.col[j];
 
-        case 4: // MIS
-            int size;
-            this->MaximalIndependentSet(size, &perm);
-            break;
+                        if(connect[k] == 1)
+                        {
+                            if(marker[k] != i)
+                            {
+                                marker[k] = i;
+                                ++count;
+                            }
 
-        case 5: // MultiColoring
-            int  num_colors;
-            int* size_colors = NULL;
-            this->MultiColoring(num_colors, &size_colors, &perm);
-            free_host(&size_colors);
-            break;
-        }
+                            continue;
+                        }
 
-        // Main algorithm
+                        for(int jj = this->mat_.row_offset[k]; jj < this->mat_.row_offset[k + 1];
+                            ++jj)
+                        {
+                            int c = this->mat_.col[jj];
 
-        // While U != empty
-        for(int k = 0; k < this->nrow_; ++k)
-        {
-            // Pick i according to the connectivity
-            int i;
-            if(ordering == 0)
-            {
-                i = k;
-            }
-            else
-            {
-                i = perm.vec_[k];
+                            if(S_val[jj] && connect[c] == 1 && marker[c] != i)
+                            {
+                                marker[c] = i;
+                                ++count;
+                            }
+                        }
+                    }
+
+                    P_row_offset[i + 1] = count;
+                }
             }
 
-            // Check if i in G
-            if(cast_G->vec_[i] != -2)
+            for(int i = 0; i < this->nrow_; ++i)
             {
-                continue;
+                P_row_offset[i + 1] += P_row_offset[i];
             }
 
-            // Mark i visited and fill G and rG
-            cast_G->vec_[i] = nc;
-            (*rG)[nc]       = i;
+            int P_nnz = P_row_offset[this->nrow_];
 
-            // Determine minimum and maximum offdiagonal entry and j index
-            ValueType min_a_ij = static_cast<ValueType>(0);
-            ValueType max_a_ij = static_cast<ValueType>(0);
-            int       min_j    = -1;
-            bool      neg      = false;
-            if(this->mat_.val[ind_diag[i]] < static_cast<ValueType>(0))
-            {
-                neg = true;
-            }
+            allocate_host(P_nnz, &P_col);
+            allocate_host(P_nnz, &P_val);
 
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
             {
-                int       col_j = this->mat_.col[j];
-                ValueType val_j = this->mat_.val[j];
+                // Position of j in the row that is currently computed, if j is part of it
+                std::vector<int> pos(this->nrow_, -1);
 
-                if(neg == true)
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+                for(int i = 0; i < this->nrow_; ++i)
                 {
-                    val_j *= static_cast<ValueType>(-1);
-                }
+                    int row_begin = P_row_offset[i];
+                    int row_end   = row_begin;
 
-                if(i == col_j)
-                {
-                    continue;
-                }
+                    if(connect[i] == 1)
+                    {
+                        P_col[row_begin] = cidx[i];
+                        P_val[row_begin] = static_cast<ValueType>(1);
+                        continue;
+                    }
 
-                if(min_j == -1)
-                {
-                    max_a_ij = val_j;
-                    if(cast_G->vec_[col_j] == -2)
+                    // Fine grid column indices are used until the row is complete
+                    auto in_row = [&](int c) {
+                        return pos[c] >= row_begin && pos[c] < row_end && P_col[pos[c]] == c;
+                    };
+
+                    auto insert = [&](int c) {
+                        if(in_row(c) == false)
+                        {
+                            pos[c]         = row_end;
+                            P_col[row_end] = c;
+                            P_val[row_end] = static_cast<ValueType>(0);
+                            ++row_end;
+                        }
+                    };
+
+                    for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
                     {
-                        min_j    = j;
-                        min_a_ij = val_j;
+                        if(!S_val[j])
+                        {
+                            continue;
+                        }
+
+                        int k = this->mat_.col[j];
+
+                        if(connect[k] == 1)
+                        {
+                            insert(k);
+                            continue;
+                        }
+
+                        for(int jj = this->mat_.row_offset[k]; jj < this->mat_.row_offset[k + 1];
+                            ++jj)
+                        {
+                            if(S_val[jj] && connect[this->mat_.col[jj]] == 1)
+                            {
+                                insert(this->mat_.col[jj]);
+                            }
+                        }
                     }
-                }
 
-                if(val_j < min_a_ij && cast_G->vec_[col_j] == -2)
-                {
-                    min_a_ij = val_j;
-                    min_j    = j;
-                }
+                    assert(row_end == P_row_offset[i + 1]);
 
-                if(val_j > max_a_ij)
-                {
-                    max_a_ij = val_j;
-                }
-            }
+                    // Diagonal including the lumped weak connections and the parts of the
+                    // strong F connections that are distributed back to i
+                    ValueType diag = static_cast<ValueType>(0);
 
-            // Fill G
-            if(min_j != -1)
-            {
-                max_a_ij *= betam;
+                    for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+                    {
+                        int       k    = this->mat_.col[j];
+                        ValueType a_ik = this->mat_.val[j];
 
-                int       col_j = this->mat_.col[min_j];
-                ValueType val_j = this->mat_.val[min_j];
+                        if(k == i)
+                        {
+                            diag += a_ik;
+                            continue;
+                        }
 
-                if(neg == true)
-                {
-                    val_j *= static_cast<ValueType>(-1);
-                }
+                        if(in_row(k) == true)
+                        {
+                            P_val[pos[k]] += a_ik;
+                            continue;
+                        }
 
-                // Add j if conditions are fulfilled
-                if(val_j < max_a_ij)
-                {
-                    cast_G->vec_[col_j] = nc;
-                    (*rG)[rGsize + nc]  = col_j;
-                }
-            }
+                        if(!S_val[j] || connect[k] == 1)
+                        {
+                            diag += a_ik;
+                            continue;
+                        }
 
-            ++nc;
-        }
+                        // Distribute a_ik to the interpolatory set and i, using the
+                        // entries of row k with sign opposite to its diagonal
+                        bool neg_diag = false;
 
-        free_host(&ind_diag);
+                        for(int jj = this->mat_.row_offset[k]; jj < this->mat_.row_offset[k + 1];
+                            ++jj)
+                        {
+                            if(this->mat_.col[jj] == k)
+                            {
+                                neg_diag = this->mat_.val[jj] < static_cast<ValueType>(0);
+                                break;
+                            }
+                        }
 
-        return true;
-    }
+                        ValueType sum = static_cast<ValueType>(0);
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::InitialPairwiseAggregation(const BaseMatrix<ValueType>& mat,
-                                                              ValueType                    beta,
-                                                              int&                         nc,
-                                                              BaseVector<int>*             G,
-                                                              int&                         Gsize,
-                                                              int**                        rG,
-                                                              int&                         rGsize,
-                                                              int ordering) const
-    {
-        assert(G != NULL);
+                        for(int jj = this->mat_.row_offset[k]; jj < this->mat_.row_offset[k + 1];
+                            ++jj)
+                        {
+                            int       l    = this->mat_.col[jj];
+                            ValueType a_kl = this->mat_.val[jj];
 
-        HostVector<int>*                cast_G = dynamic_cast<HostVector<int>*>(G);
-        const HostMatrixCSR<ValueType>* cast_mat
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat);
+                            if((neg_diag ? a_kl > static_cast<ValueType>(0)
+                                         : a_kl < static_cast<ValueType>(0))
+                               && (l == i || in_row(l) == true))
+                            {
+                                sum += a_kl;
+                            }
+                        }
 
-        assert(cast_G != NULL);
-        assert(cast_mat != NULL);
+                        if(sum == static_cast<ValueType>(0))
+                        {
+                            diag += a_ik;
+                            continue;
+                        }
 
-        // Initialize G
-        for(int i = 0; i < cast_G->size_; ++i)
-        {
-            cast_G->vec_[i] = -2;
-        }
+                        ValueType scale = a_ik / sum;
 
-        int  Usize    = 0;
-        int* ind_diag = NULL;
-        allocate_host(this->nrow_, &ind_diag);
+                        for(int jj = this->mat_.row_offset[k]; jj < this->mat_.row_offset[k + 1];
+                            ++jj)
+                        {
+                            int       l    = this->mat_.col[jj];
+                            ValueType a_kl = this->mat_.val[jj];
 
-        // Build U
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            ValueType sum = static_cast<ValueType>(0);
+                            if(neg_diag ? a_kl <= static_cast<ValueType>(0)
+                                        : a_kl >= static_cast<ValueType>(0))
+                            {
+                                continue;
+                            }
 
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-            {
-                if(i != this->mat_.col[j])
-                {
-                    sum += std::abs(this->mat_.val[j]);
-                }
-                else
-                {
-                    ind_diag[i] = j;
-                }
-            }
+                            if(l == i)
+                            {
+                                diag += scale * a_kl;
+                            }
+                            else if(in_row(l) == true)
+                            {
+                                P_val[pos[l]] += scale * a_kl;
+                            }
+                        }
+                    }
 
-            for(int j = cast_mat->mat_.row_offset[i]; j < cast_mat->mat_.row_offset[i + 1]; ++j)
-            {
-                sum += std::abs(cast_mat->mat_.val[j]);
+                    for(int j = row_begin; j < row_end; ++j)
+                    {
+                        P_val[j] = (diag != static_cast<ValueType>(0)) ? -P_val[j] / diag
+                                                                       : static_cast<ValueType>(0);
+                        P_col[j] = cidx[P_col[j]];
+                    }
+                }
             }
 
-            sum *= static_cast<ValueType>(5);
-
-            if(this->mat_.val[ind_diag[i]] > sum)
-            {
-                cast_G->vec_[i] = -1;
-                ++Usize;
-            }
+            cast_prolong->Clear();
+            cast_prolong->SetDataPtrCSR(&P_row_offset, &P_col, &P_val, P_nnz, this->nrow_, nc);
         }
-
-        // Initialize rG and sizes
-        Gsize  = 2;
-        rGsize = this->nrow_ - Usize;
-        allocate_host(Gsize * rGsize, rG);
-
-        for(int i = 0; i < Gsize * rGsize; ++i)
+        else
         {
-            (*rG)[i] = -1;
-        }
-
-        nc              = 0;
-        ValueType betam = -beta;
+            // Allocate
+            cast_prolong->Clear();
+            cast_prolong->AllocateCSR(this->nnz_, this->nrow_, this->ncol_);
 
-        // Ordering
-        HostVector<int> perm(this->local_backend_);
-
-        switch(ordering)
-        {
-        case 0: // No ordering
-            break;
+            std::vector<ValueType> Amin(this->nrow_);
+            std::vector<ValueType> Amax(this->nrow_);
 
-        case 1: // Connectivity ordering
-            this->ConnectivityOrder(&perm);
-            break;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                if(connect[i] == 1)
+                {
+                    ++cast_prolong->mat_.row_offset[i + 1];
+                    continue;
+                }
 
-        case 2: // CMK
-            this->CMK(&perm);
-            break;
+                ValueType amin = static_cast<ValueType>(0);
+                ValueType amax = static_cast<ValueType>(0);
 
-        case 3: // RCMK
-            this->RCMK(&perm);
-            break;
+                for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+                {
+                    if(!S_val[j] || connect[this->mat_.col[j]] != 1)
+                    {
+                        continue;
+                    }
 
-        case 4: // MIS
-            int size;
-            this->MaximalIndependentSet(size, &perm);
-            break;
+                    amin = (amin < this->mat_.val[j]) ? amin : this->mat_.val[j];
+                    amax = (amax > this->mat_.val[j]) ? amax : this->mat_.val[j];
+                }
 
-        case 5: // MultiColoring
-            int  num_colors;
-            int* size_colors = NULL;
-            this->MultiColoring(num_colors, &size_colors, &perm);
-            free_host(&size_colors);
-            break;
-        }
+                Amin[i] = amin = amin * static_cast<ValueType>(0.2);
+                Amax[i] = amax = amax * static_cast<ValueType>(0.2);
 
-        // Main algorithm
+                for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+                {
+                    if(!S_val[j] || connect[this->mat_.col[j]] != 1)
+                    {
+                        continue;
+                    }
 
-        // While U != empty
-        for(int k = 0; k < this->nrow_; ++k)
-        {
-            // Pick i according to the connectivity
-            int i;
-            if(ordering == 0)
-            {
-                i = k;
-            }
-            else
-            {
-                i = perm.vec_[k];
+                    if(this->mat_.val[j] <= amin || this->mat_.val[j] >= amax)
+                    {
+                        ++cast_prolong->mat_.row_offset[i + 1];
+                    }
+                }
             }
 
-            // Check if i in G
-            if(cast_G->vec_[i] != -2)
+            for(int i = 0; i < this->nrow_; ++i)
             {
-                continue;
+                cast_prolong->mat_.row_offset[i + 1] += cast_prolong->mat_.row_offset[i];
             }
 
-            // Mark i visited and fill G and rG
-            cast_G->vec_[i] = nc;
-            (*rG)[nc]       = i;
+            cast_prolong->mat_.col = (int*)realloc(
+                cast_prolong->mat_.col, cast_prolong->mat_.row_offset[this->nrow_] * sizeof(int));
+            cast_prolong->mat_.val = (ValueType*)realloc(
+                cast_prolong->mat_.val,
+                cast_prolong->mat_.row_offset[this->nrow_] * sizeof(ValueType));
 
-            // Determine minimum and maximum offdiagonal entry and j index
-            ValueType min_a_ij = static_cast<ValueType>(0);
-            ValueType max_a_ij = static_cast<ValueType>(0);
-            int       min_j    = -1;
-            bool      neg      = false;
-            if(this->mat_.val[ind_diag[i]] < static_cast<ValueType>(0))
-            {
-                neg = true;
-            }
+            cast_prolong->nnz_  = cast_prolong->mat_.row_offset[this->nrow_];
+            cast_prolong->ncol_ = nc;
 
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
             {
-                int       col_j = this->mat_.col[j];
-                ValueType val_j = this->mat_.val[j];
-
-                if(neg == true)
-                {
-                    val_j *= static_cast<ValueType>(-1);
-                }
+                int row_head = cast_prolong->mat_.row_offset[i];
 
-                if(i == col_j)
+                if(connect[i] == 1)
                 {
+                    cast_prolong->mat_.col[row_head] = cidx[i];
+                    cast_prolong->mat_.val[row_head] = static_cast<ValueType>(1);
                     continue;
                 }
 
-                if(min_j == -1)
+                ValueType diag  = static_cast<ValueType>(0);
+                ValueType a_num = static_cast<ValueType>(0), a_den = static_cast<ValueType>(0);
+                ValueType b_num = static_cast<ValueType>(0), b_den = static_cast<ValueType>(0);
+                ValueType d_neg = static_cast<ValueType>(0), d_pos = static_cast<ValueType>(0);
+
+                for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
                 {
-                    max_a_ij = val_j;
-                    if(cast_G->vec_[col_j] == -2)
+                    int       c = this->mat_.col[j];
+                    ValueType v = this->mat_.val[j];
+
+                    if(c == i)
+                    {
+                        diag = v;
+                        continue;
+                    }
+
+                    if(v < static_cast<ValueType>(0))
+                    {
+                        a_num += v;
+                        if(S_val[j] && connect[c] == 1)
+                        {
+                            a_den += v;
+                            if(v > Amin[i])
+                            {
+                                d_neg += v;
+                            }
+                        }
+                    }
+                    else
                     {
-                        min_j    = col_j;
-                        min_a_ij = val_j;
+                        b_num += v;
+                        if(S_val[j] && connect[c] == 1)
+                        {
+                            b_den += v;
+                            if(v < Amax[i])
+                            {
+                                d_pos += v;
+                            }
+                        }
                     }
                 }
 
-                if(val_j < min_a_ij && cast_G->vec_[col_j] == -2)
-                {
-                    min_a_ij = val_j;
-                    min_j    = col_j;
-                }
+                ValueType cf_neg = static_cast<ValueType>(1);
+                ValueType cf_pos = static_cast<ValueType>(1);
 
-                if(val_j > max_a_ij)
+                if(std::abs(a_den - d_neg) > 1e-32)
                 {
-                    max_a_ij = val_j;
+                    cf_neg = a_den / (a_den - d_neg);
                 }
-            }
-
-            for(int j = cast_mat->mat_.row_offset[i]; j < cast_mat->mat_.row_offset[i + 1]; ++j)
-            {
-                ValueType val_j = cast_mat->mat_.val[j];
 
-                if(neg == true)
+                if(std::abs(b_den - d_pos) > 1e-32)
                 {
-                    val_j *= static_cast<ValueType>(-1);
+                    cf_pos = b_den / (b_den - d_pos);
                 }
 
-                if(val_j > max_a_ij)
+                if(b_num > static_cast<ValueType>(0) && std::abs(b_den) < 1e-32)
                 {
-                    max_a_ij = val_j;
+                    diag += b_num;
                 }
-            }
 
-            // Fill G
-            if(min_j != -1)
-            {
-                max_a_ij *= betam;
+                ValueType alpha = std::abs(a_den) > 1e-32 ? -cf_neg * a_num / (diag * a_den)
+                                                          : static_cast<ValueType>(0);
+                ValueType beta = std::abs(b_den) > 1e-32 ? -cf_pos * b_num / (diag * b_den)
+                                                         : static_cast<ValueType>(0);
 
                 for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
                 {
-                    int       col_j = this->mat_.col[j];
-                    ValueType val_j = this->mat_.val[j];
+                    int       c = this->mat_.col[j];
+                    ValueType v = this->mat_.val[j];
 
-                    if(neg == true)
+                    if(!S_val[j] || connect[c] != 1)
                     {
-                        val_j *= static_cast<ValueType>(-1);
+                        continue;
                     }
 
-                    // Skip diagonal
-                    if(i == col_j)
+                    if(v > Amin[i] && v < Amax[i])
                     {
                         continue;
                     }
 
-                    // Skip j which is not in U
-                    if(cast_G->vec_[col_j] != -2)
+                    cast_prolong->mat_.col[row_head] = cidx[c];
+                    cast_prolong->mat_.val[row_head]
+                        = (v < static_cast<ValueType>(0) ? alpha : beta) * v;
+                    ++row_head;
+                }
+            }
+        }
+
+        free_host(&connect);
+        free_host(&S_val);
+
+        // Truncate the interpolation to the max_elements largest entries of each row, the
+        // remaining entries are scaled such that the row sum is preserved
+        if(max_elements > 0)
+        {
+            int* T_row_offset = NULL;
+            int* T_col        = NULL;
+
+            ValueType* T_val = NULL;
+
+            allocate_host(this->nrow_ + 1, &T_row_offset);
+            set_to_zero_host(this->nrow_ + 1, T_row_offset);
+
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                T_row_offset[i + 1]
+                    = T_row_offset[i]
+                      + std::min(max_elements,
+                                 cast_prolong->mat_.row_offset[i + 1]
+                                     - cast_prolong->mat_.row_offset[i]);
+            }
+
+            int T_nnz = T_row_offset[this->nrow_];
+
+            allocate_host(T_nnz, &T_col);
+            allocate_host(T_nnz, &T_val);
+
+            const int*       P_row_offset = cast_prolong->mat_.row_offset;
+            const int*       P_col        = cast_prolong->mat_.col;
+            const ValueType* P_val        = cast_prolong->mat_.val;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+            {
+                std::vector<int> idx;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+                for(int i = 0; i < this->nrow_; ++i)
+                {
+                    int row_begin = P_row_offset[i];
+                    int row_end   = P_row_offset[i + 1];
+                    int t         = T_row_offset[i];
+
+                    if(row_end - row_begin <= max_elements)
                     {
+                        for(int j = row_begin; j < row_end; ++j, ++t)
+                        {
+                            T_col[t] = P_col[j];
+                            T_val[t] = P_val[j];
+                        }
+
                         continue;
                     }
 
-                    // Add j if conditions are fulfilled
-                    if(val_j < max_a_ij)
+                    idx.resize(row_end - row_begin);
+
+                    ValueType sum = static_cast<ValueType>(0);
+
+                    for(int j = row_begin; j < row_end; ++j)
                     {
-                        if(min_j == col_j)
-                        {
-                            cast_G->vec_[min_j] = nc;
-                            (*rG)[rGsize + nc]  = min_j;
-                            break;
-                        }
+                        idx[j - row_begin] = j;
+                        sum += P_val[j];
                     }
-                }
-            }
 
-            ++nc;
-        }
+                    // Largest entries first, ties are broken by the position
+                    std::nth_element(
+                        idx.begin(), idx.begin() + max_elements, idx.end(), [&](int a, int b) {
+                            return std::abs(P_val[a]) > std::abs(P_val[b])
+                                   || (std::abs(P_val[a]) == std::abs(P_val[b]) && a < b);
+                        });
+                    std::sort(idx.begin(), idx.begin() + max_elements);
 
-        free_host(&ind_diag);
+                    ValueType sum_kept = static_cast<ValueType>(0);
 
-        return true;
-    }
+                    for(int j = 0; j < max_elements; ++j)
+                    {
+                        sum_kept += P_val[idx[j]];
+                    }
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::FurtherPairwiseAggregation(ValueType        beta,
-                                                              int&             nc,
-                                                              BaseVector<int>* G,
-                                                              int&             Gsize,
-                                                              int**            rG,
-                                                              int&             rGsize,
-                                                              int              ordering) const
-    {
-        assert(G != NULL);
-        HostVector<int>* cast_G = dynamic_cast<HostVector<int>*>(G);
-        assert(cast_G != NULL);
+                    ValueType scale = (sum_kept != static_cast<ValueType>(0))
+                                          ? sum / sum_kept
+                                          : static_cast<ValueType>(1);
 
-        // Initialize G and inverse indexing for G
-        Gsize *= 2;
-        int  rGsizec = this->nrow_;
-        int* rGc     = NULL;
-        allocate_host(Gsize * rGsizec, &rGc);
+                    for(int j = 0; j < max_elements; ++j, ++t)
+                    {
+                        T_col[t] = P_col[idx[j]];
+                        T_val[t] = scale * P_val[idx[j]];
+                    }
+                }
+            }
 
-        for(int i = 0; i < Gsize * rGsizec; ++i)
-        {
-            rGc[i] = -1;
+            cast_prolong->Clear();
+            cast_prolong->SetDataPtrCSR(&T_row_offset, &T_col, &T_val, T_nnz, this->nrow_, nc);
         }
 
-        for(int i = 0; i < cast_G->size_; ++i)
+        // Sort the columns of each row
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(int i = 0; i < cast_prolong->GetM(); ++i)
         {
-            cast_G->vec_[i] = -1;
-        }
+            for(int j = cast_prolong->mat_.row_offset[i] + 1;
+                j < cast_prolong->mat_.row_offset[i + 1];
+                ++j)
+            {
+                int       ind = cast_prolong->mat_.col[j];
+                ValueType val = cast_prolong->mat_.val[j];
 
-        // Initialize U
-        int* U = NULL;
-        allocate_host(this->nrow_, &U);
-        set_to_zero_host(this->nrow_, U);
+                int jj = j;
 
-        nc              = 0;
-        ValueType betam = -beta;
+                while(jj > cast_prolong->mat_.row_offset[i] && cast_prolong->mat_.col[jj - 1] > ind)
+                {
+                    cast_prolong->mat_.col[jj] = cast_prolong->mat_.col[jj - 1];
+                    cast_prolong->mat_.val[jj] = cast_prolong->mat_.val[jj - 1];
+                    --jj;
+                }
 
-        // Ordering
-        HostVector<int> perm(this->local_backend_);
+                cast_prolong->mat_.col[jj] = ind;
+                cast_prolong->mat_.val[jj] = val;
+            }
+        }
 
-        switch(ordering)
-        {
-        case 0: // No ordering
-            break;
+        cast_restrict->CopyFrom(*cast_prolong);
+        cast_restrict->Transpose();
+
+        return true;
+    }
 
-        case 1: // Connectivity ordering
-            this->ConnectivityOrder(&perm);
-            break;
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::pairwise_match_(const HostMatrixCSR<ValueType>* ghost,
+                                                   ValueType                       beta,
+                                                   bool                            dominant,
+                                                   int*                            mate) const
+    {
+        assert(mate != NULL);
 
-        case 2: // CMK
-            this->CMK(&perm);
-            break;
+        int    n     = this->nrow_;
+        double dbeta = rocalution_double(beta);
 
-        case 3: // RCMK
-            this->RCMK(&perm);
-            break;
+        // Sign of the diagonal entry, the inverse square root of its modulus and the
+        // threshold for the couplings of each row, which is beta times the largest
+        // off-diagonal entry of the same sign as the diagonal entry
+        std::vector<double> sign(n);
+        std::vector<double> scale(n);
+        std::vector<double> threshold(n);
 
-        case 4: // MIS
-            int size;
-            this->MaximalIndependentSet(size, &perm);
-            break;
+        // Entries of the matrix, converted to the weights of the couplings below
+        std::vector<double> weight(this->nnz_);
 
-        case 5: // MultiColoring
-            int  num_colors;
-            int* size_colors = NULL;
-            this->MultiColoring(num_colors, &size_colors, &perm);
-            free_host(&size_colors);
-            break;
-        }
+        _set_omp_backend_threads(this->local_backend_, n);
 
-        // While U != empty
-        for(int k = 0; k < this->nrow_; ++k)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(int i = 0; i < n; ++i)
         {
-            // Pick i according to connectivity
-            int i;
-            if(ordering == 0)
-            {
-                i = k;
-            }
-            else
-            {
-                i = perm.vec_[k];
-            }
+            double d     = 0.0;
+            double a_max = 0.0;
+            double a_min = 0.0;
+            double sum   = 0.0;
 
-            // Check if i in U
-            if(U[i] == 1)
+            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
             {
-                continue;
-            }
+                double a = rocalution_double(this->mat_.val[j]);
 
-            // Mark i visited
-            U[i] = 1;
+                weight[j] = a;
 
-            // Fill G and rG
-            for(int r = 0; r < Gsize / 2; ++r)
-            {
-                rGc[r * rGsizec + nc] = (*rG)[r * rGsize + i];
-
-                if((*rG)[r * rGsize + i] >= 0)
+                if(this->mat_.col[j] == i)
+                {
+                    d = a;
+                }
+                else
                 {
-                    cast_G->vec_[(*rG)[r * rGsize + i]] = nc;
+                    a_max = std::max(a_max, a);
+                    a_min = std::min(a_min, a);
+                    sum += std::abs(a);
                 }
             }
 
-            // Get sign
-            bool neg = false;
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            if(ghost != NULL)
             {
-                if(i == this->mat_.col[j])
+                for(int j = ghost->mat_.row_offset[i]; j < ghost->mat_.row_offset[i + 1]; ++j)
                 {
-                    if(this->mat_.val[j] < static_cast<ValueType>(0))
-                    {
-                        neg = true;
-                    }
+                    double a = rocalution_double(ghost->mat_.val[j]);
 
-                    break;
+                    a_max = std::max(a_max, a);
+                    a_min = std::min(a_min, a);
+                    sum += std::abs(a);
                 }
             }
 
-            // Determine minimum and maximum offdiagonal entry and j index
-            ValueType min_a_ij = static_cast<ValueType>(0);
-            ValueType max_a_ij = static_cast<ValueType>(0);
-            int       min_j    = -1;
+            // Strongly diagonally dominant rows are not aggregated
+            mate[i]      = (dominant == true && d > 5.0 * sum) ? -2 : -1;
+            sign[i]      = (d < 0.0) ? 1.0 : -1.0;
+            scale[i]     = (d != 0.0) ? 1.0 / std::sqrt(std::abs(d)) : 0.0;
+            threshold[i] = dbeta * ((d < 0.0) ? -a_min : a_max);
+        }
+
+        // Weight of the couplings of opposite sign to the diagonal entry that exceed the
+        // threshold, scaled by the diagonal entries, and zero for all other entries
 
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(int i = 0; i < n; ++i)
+        {
             for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
             {
-                int       col_j = this->mat_.col[j];
-                ValueType val_j = this->mat_.val[j];
+                int    c = this->mat_.col[j];
+                double w = sign[i] * weight[j];
 
-                if(neg == true)
-                {
-                    val_j *= static_cast<ValueType>(-1);
-                }
+                weight[j] = 0.0;
 
-                if(i == col_j)
+                if(c != i && mate[i] != -2 && mate[c] != -2 && w > 0.0 && w > threshold[i])
                 {
-                    continue;
+                    weight[j] = w * scale[i] * scale[c];
                 }
+            }
+        }
 
-                if(min_j == -1)
-                {
-                    max_a_ij = val_j;
+        graph_pairwise_match(_get_omp_backend_threads(this->local_backend_, this->nrow_),
+                             n,
+                             this->mat_.row_offset,
+                             this->mat_.col,
+                             weight.data(),
+                             mate);
+    }
 
-                    if(U[col_j] == 0)
-                    {
-                        min_j    = j;
-                        min_a_ij = max_a_ij;
-                    }
-                }
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::initial_pairwise_aggregation_(
+        const HostMatrixCSR<ValueType>* ghost,
+        ValueType                       beta,
+        int&                            nc,
+        BaseVector<int>*                G,
+        int&                            Gsize,
+        int**                           rG,
+        int&                            rGsize) const
+    {
+        assert(G != NULL);
 
-                if(val_j < min_a_ij && U[col_j] == 0)
-                {
-                    min_a_ij = val_j;
-                    min_j    = j;
-                }
+        HostVector<int>* cast_G = dynamic_cast<HostVector<int>*>(G);
 
-                if(val_j < max_a_ij)
-                {
-                    max_a_ij = val_j;
-                }
-            }
+        assert(cast_G != NULL);
 
-            // Fill G
-            if(min_j != -1)
-            {
-                max_a_ij *= betam;
+        int n = this->nrow_;
 
-                int       col_j = this->mat_.col[min_j];
-                ValueType val_j = this->mat_.val[min_j];
+        std::vector<int> mate(n);
+        this->pairwise_match_(ghost, beta, true, mate.data());
 
-                if(neg == true)
-                {
-                    val_j *= static_cast<ValueType>(-1);
-                }
+        // Number the aggregates in the order of their first node, excluded nodes are
+        // marked by -1
+        int Usize = 0;
+        nc        = 0;
 
-                // Add j if conditions are fulfilled
-                if(val_j < max_a_ij)
-                {
-                    for(int r = 0; r < Gsize / 2; ++r)
-                    {
-                        rGc[(r + Gsize / 2) * rGsizec + nc] = (*rG)[r * rGsize + col_j];
+        for(int i = 0; i < n; ++i)
+        {
+            if(mate[i] == -2)
+            {
+                cast_G->vec_[i] = -1;
+                ++Usize;
+            }
+            else if(mate[i] == -1 || i < mate[i])
+            {
+                cast_G->vec_[i] = nc++;
+            }
+        }
 
-                        if((*rG)[r * rGsize + col_j] >= 0)
-                        {
-                            cast_G->vec_[(*rG)[r * rGsize + col_j]] = nc;
-                        }
-                    }
+        // Initialize rG and sizes
+        Gsize  = 2;
+        rGsize = n - Usize;
+        allocate_host(Gsize * rGsize, rG);
 
-                    U[col_j] = 1;
-                }
+        _set_omp_backend_threads(this->local_backend_, n);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < n; ++i)
+        {
+            int j = mate[i];
+
+            if(j == -2 || (j != -1 && j < i))
+            {
+                continue;
             }
 
-            ++nc;
-        }
+            int c = cast_G->vec_[i];
 
-        free_host(&U);
-        free_host(rG);
+            (*rG)[c]          = i;
+            (*rG)[rGsize + c] = j;
 
-        (*rG)  = rGc;
-        rGsize = rGsizec;
+            if(j != -1)
+            {
+                cast_G->vec_[j] = c;
+            }
+        }
 
-        return true;
+        for(int c = nc; c < rGsize; ++c)
+        {
+            (*rG)[c]          = -1;
+            (*rG)[rGsize + c] = -1;
+        }
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::FurtherPairwiseAggregation(const BaseMatrix<ValueType>& mat,
-                                                              ValueType                    beta,
-                                                              int&                         nc,
-                                                              BaseVector<int>*             G,
-                                                              int&                         Gsize,
-                                                              int**                        rG,
-                                                              int&                         rGsize,
-                                                              int ordering) const
+    void HostMatrixCSR<ValueType>::further_pairwise_aggregation_(
+        const HostMatrixCSR<ValueType>* ghost,
+        ValueType                       beta,
+        int&                            nc,
+        BaseVector<int>*                G,
+        int&                            Gsize,
+        int**                           rG,
+        int&                            rGsize) const
     {
         assert(G != NULL);
 
-        HostVector<int>*                cast_G = dynamic_cast<HostVector<int>*>(G);
-        const HostMatrixCSR<ValueType>* cast_mat
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat);
+        HostVector<int>* cast_G = dynamic_cast<HostVector<int>*>(G);
 
         assert(cast_G != NULL);
-        assert(cast_mat != NULL);
+
+        int n = this->nrow_;
+
+        std::vector<int> mate(n);
+        this->pairwise_match_(ghost, beta, false, mate.data());
+
+        // Number the aggregates in the order of their first node
+        std::vector<int> agg(n);
+        nc = 0;
+
+        for(int i = 0; i < n; ++i)
+        {
+            if(mate[i] == -1 || i < mate[i])
+            {
+                agg[i] = nc++;
+            }
+        }
 
         // Initialize G and inverse indexing for G
+        int half = Gsize;
         Gsize *= 2;
-        int  rGsizec = this->nrow_;
+        int  rGsizec = n;
         int* rGc     = NULL;
         allocate_host(Gsize * rGsizec, &rGc);
 
+        _set_omp_backend_threads(this->local_backend_, n);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
         for(int i = 0; i < Gsize * rGsizec; ++i)
         {
             rGc[i] = -1;
         }
 
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
         for(int i = 0; i < cast_G->size_; ++i)
         {
             cast_G->vec_[i] = -1;
         }
 
-        // Initialize U
-        int* U = NULL;
-        allocate_host(this->nrow_, &U);
-        set_to_zero_host(this->nrow_, U);
-
-        nc              = 0;
-        ValueType betam = -beta;
-
-        // Ordering
-        HostVector<int> perm(this->local_backend_);
-
-        switch(ordering)
-        {
-        case 0: // No ordering
-            break;
-
-        case 1: // Connectivity ordering
-            this->ConnectivityOrder(&perm);
-            break;
-
-        case 2: // CMK
-            this->CMK(&perm);
-            break;
-
-        case 3: // RCMK
-            this->RCMK(&perm);
-            break;
-
-        case 4: // MIS
-            int size;
-            this->MaximalIndependentSet(size, &perm);
-            break;
-
-        case 5: // MultiColoring
-            int  num_colors;
-            int* size_colors = NULL;
-            this->MultiColoring(num_colors, &size_colors, &perm);
-            free_host(&size_colors);
-            break;
-        }
-
-        // While U != empty
-        for(int k = 0; k < this->nrow_; ++k)
+        // The fine nodes of the pair (i, j) form the aggregate of i
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < n; ++i)
         {
-            // Pick i according to connectivity
-            int i;
-            if(ordering == 0)
-            {
-                i = k;
-            }
-            else
-            {
-                i = perm.vec_[k];
-            }
+            int j = mate[i];
 
-            // Check if i in U
-            if(U[i] == 1)
+            if(j != -1 && j < i)
             {
                 continue;
             }
 
-            // Mark i visited
-            U[i] = 1;
+            int c = agg[i];
 
-            // Fill G and rG
-            for(int r = 0; r < Gsize / 2; ++r)
+            for(int r = 0; r < half; ++r)
             {
-                rGc[r * rGsizec + nc] = (*rG)[r * rGsize + i];
+                int fine = (*rG)[r * rGsize + i];
 
-                if((*rG)[r * rGsize + i] >= 0)
-                {
-                    cast_G->vec_[(*rG)[r * rGsize + i]] = nc;
-                }
-            }
+                rGc[r * rGsizec + c] = fine;
 
-            // Get sign
-            bool neg = false;
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-            {
-                if(i == this->mat_.col[j])
+                if(fine >= 0)
                 {
-                    if(this->mat_.val[j] < static_cast<ValueType>(0))
-                    {
-                        neg = true;
-                    }
-
-                    break;
+                    cast_G->vec_[fine] = c;
                 }
-            }
-
-            // Determine minimum and maximum offdiagonal entry and j index
-            ValueType min_a_ij = static_cast<ValueType>(0);
-            ValueType max_a_ij = static_cast<ValueType>(0);
-            int       min_j    = -1;
-
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-            {
-                int       col_j = this->mat_.col[j];
-                ValueType val_j = this->mat_.val[j];
 
-                if(neg == true)
+                if(j != -1)
                 {
-                    val_j *= static_cast<ValueType>(-1);
-                }
+                    fine = (*rG)[r * rGsize + j];
 
-                if(i == col_j)
-                {
-                    continue;
-                }
+                    rGc[(r + half) * rGsizec + c] = fine;
 
-                if(min_j == -1)
-                {
-                    max_a_ij = val_j;
-                    if(U[col_j] == 0)
+                    if(fine >= 0)
                     {
-                        min_j    = col_j;
-                        min_a_ij = max_a_ij;
+                        cast_G->vec_[fine] = c;
                     }
                 }
-
-                if(val_j < min_a_ij && U[col_j] == 0)
-                {
-                    min_a_ij = val_j;
-                    min_j    = col_j;
-                }
-
-                if(val_j < max_a_ij)
-                {
-                    max_a_ij = val_j;
-                }
             }
+        }
 
-            for(int j = cast_mat->mat_.row_offset[i]; j < cast_mat->mat_.row_offset[i + 1]; ++j)
-            {
-                ValueType val_j = cast_mat->mat_.val[j];
-
-                if(neg == true)
-                {
-                    val_j *= static_cast<ValueType>(-1);
-                }
+        free_host(rG);
 
-                if(val_j > max_a_ij)
-                {
-                    max_a_ij = val_j;
-                }
-            }
+        (*rG)  = rGc;
+        rGsize = rGsizec;
+    }
 
-            // Fill G
-            if(min_j != -1)
-            {
-                max_a_ij *= betam;
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::InitialPairwiseAggregation(ValueType        beta,
+                                                              int&             nc,
+                                                              BaseVector<int>* G,
+                                                              int&             Gsize,
+                                                              int**            rG,
+                                                              int&             rGsize,
+                                                              int              ordering) const
+    {
+        // The parallel matching does not depend on the ordering of the nodes
+        this->initial_pairwise_aggregation_(NULL, beta, nc, G, Gsize, rG, rGsize);
 
-                for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-                {
-                    int       col_j = this->mat_.col[j];
-                    ValueType val_j = this->mat_.val[j];
+        return true;
+    }
 
-                    if(neg == true)
-                    {
-                        val_j *= static_cast<ValueType>(-1);
-                    }
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::InitialPairwiseAggregation(const BaseMatrix<ValueType>& mat,
+                                                              ValueType                    beta,
+                                                              int&                         nc,
+                                                              BaseVector<int>*             G,
+                                                              int&                         Gsize,
+                                                              int**                        rG,
+                                                              int&                         rGsize,
+                                                              int ordering) const
+    {
+        const HostMatrixCSR<ValueType>* cast_mat
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat);
 
-                    // Skip diagonal
-                    if(i == col_j)
-                    {
-                        continue;
-                    }
+        assert(cast_mat != NULL);
 
-                    // Skip j which is not in U
-                    if(U[col_j] == 1)
-                    {
-                        continue;
-                    }
+        this->initial_pairwise_aggregation_(cast_mat, beta, nc, G, Gsize, rG, rGsize);
 
-                    // Add j if conditions are fulfilled
-                    if(val_j < max_a_ij)
-                    {
-                        if(min_j == col_j)
-                        {
-                            for(int r = 0; r < Gsize / 2; ++r)
-                            {
-                                rGc[(r + Gsize / 2) * rGsizec + nc] = (*rG)[r * rGsize + min_j];
+        return true;
+    }
 
-                                if((*rG)[r * rGsize + min_j] >= 0)
-                                {
-                                    cast_G->vec_[(*rG)[r * rGsize + min_j]] = nc;
-                                }
-                            }
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::FurtherPairwiseAggregation(ValueType        beta,
+                                                              int&             nc,
+                                                              BaseVector<int>* G,
+                                                              int&             Gsize,
+                                                              int**            rG,
+                                                              int&             rGsize,
+                                                              int              ordering) const
+    {
+        this->further_pairwise_aggregation_(NULL, beta, nc, G, Gsize, rG, rGsize);
 
-                            U[min_j] = 1;
-                            break;
-                        }
-                    }
-                }
-            }
+        return true;
+    }
 
-            ++nc;
-        }
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::FurtherPairwiseAggregation(const BaseMatrix<ValueType>& mat,
+                                                              ValueType                    beta,
+                                                              int&                         nc,
+                                                              BaseVector<int>*             G,
+                                                              int&                         Gsize,
+                                                              int**                        rG,
+                                                              int&                         rGsize,
+                                                              int ordering) const
+    {
+        const HostMatrixCSR<ValueType>* cast_mat
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat);
 
-        free_host(&U);
-        free_host(rG);
+        assert(cast_mat != NULL);
 
-        (*rG)  = rGc;
-        rGsize = rGsizec;
+        this->further_pairwise_aggregation_(cast_mat, beta, nc, G, Gsize, rG, rGsize);
 
         return true;
     }
@@ -6217,6 +7528,17 @@ namespace rocalution
         return true;
     }
 
+    template class HostMatrixCSRBase<double, int>;
+    template class HostMatrixCSRBase<float, int>;
+    template class HostMatrixCSRBase<double, IndexType2>;
+    template class HostMatrixCSRBase<float, IndexType2>;
+#ifdef SUPPORT_COMPLEX
+    template class HostMatrixCSRBase<std::complex<double>, int>;
+    template class HostMatrixCSRBase<std::complex<float>, int>;
+    template class HostMatrixCSRBase<std::complex<double>, IndexType2>;
+    template class HostMatrixCSRBase<std::complex<float>, IndexType2>;
+#endif
+
     template class HostMatrixCSR<double>;
     template class HostMatrixCSR<float>;
 #ifdef SUPPORT_COMPLEX
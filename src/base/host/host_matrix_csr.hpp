@@ -31,13 +31,21 @@
 namespace rocalution
 {
 
-    template <typename ValueType>
-    class HostMatrixCSR : public HostMatrix<ValueType>
+    struct HostMatrixPowersTiles;
+
+    // CSR matrix with PointerType row offsets and int column indices. It holds the data
+    // and all operations that work for any width of the row offsets: allocation, data
+    // pointers, conversion from CSR and COO, file I/O and SpMV. HostMatrixCSR adds all
+    // other operations to the int instance. The IndexType2 instance holds matrices with
+    // more non-zero entries than int can address, everything else fails through the
+    // BaseMatrix defaults.
+    template <typename ValueType, typename PointerType>
+    class HostMatrixCSRBase : public HostMatrix<ValueType>
     {
     public:
-        HostMatrixCSR();
-        HostMatrixCSR(const Rocalution_Backend_Descriptor local_backend);
-        virtual ~HostMatrixCSR();
+        HostMatrixCSRBase();
+        HostMatrixCSRBase(const Rocalution_Backend_Descriptor local_backend);
+        virtual ~HostMatrixCSRBase();
 
         virtual void         Info(void) const;
         virtual unsigned int GetMatFormat(void) const
@@ -46,10 +54,86 @@ namespace rocalution
         }
 
         virtual bool Check(void) const;
-        virtual void AllocateCSR(int nnz, int nrow, int ncol);
+        virtual void AllocateCSR(IndexType2 nnz, int nrow, int ncol);
         virtual void SetDataPtrCSR(
             int** row_offset, int** col, ValueType** val, int nnz, int nrow, int ncol);
         virtual void LeaveDataPtrCSR(int** row_offset, int** col, ValueType** val);
+        virtual void SetDataPtrCSR64(IndexType2** row_offset,
+                                     int**        col,
+                                     ValueType**  val,
+                                     IndexType2   nnz,
+                                     int          nrow,
+                                     int          ncol);
+        virtual void LeaveDataPtrCSR64(IndexType2** row_offset, int** col, ValueType** val);
+
+        virtual void Clear(void);
+
+        virtual bool ConvertFrom(const BaseMatrix<ValueType>& mat);
+
+        virtual void CopyFrom(const BaseMatrix<ValueType>& mat);
+        virtual void CopyTo(BaseMatrix<ValueType>* mat) const;
+
+        virtual bool ReadFileCSR(const std::string);
+        virtual bool MapFileCSR(const std::string);
+        virtual bool WriteFileCSR(const std::string) const;
+
+        virtual void ApplyAnalysis(void);
+        virtual void Apply(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
+        virtual void ApplyAdd(const BaseVector<ValueType>& in,
+                              ValueType                    scalar,
+                              BaseVector<ValueType>*       out) const;
+
+    protected:
+        /// Replace file mapped data by host allocated copies (see MapFileCSR())
+        void unmap_(void);
+
+        MatrixCSR<ValueType, int, PointerType> mat_;
+
+        // File mapping holding the matrix data, if mapped by MapFileCSR()
+        void*  map_;
+        size_t map_size_;
+
+        // Merge path partition of the SpMV (see ApplyAnalysis()), part i starts in row
+        // spmv_row_[i] at non-zero spmv_nnz_[i]; spmv_parts_ is 0 if not in use
+        int          spmv_parts_;
+        int*         spmv_row_;
+        PointerType* spmv_nnz_;
+
+    private:
+        /// Take over the data pointers, row offsets of another width are rejected
+        void set_data_ptr_(PointerType** row_offset,
+                           int**         col,
+                           ValueType**   val,
+                           IndexType2    nnz,
+                           int           nrow,
+                           int           ncol);
+        template <typename OtherPointerType>
+        void set_data_ptr_(OtherPointerType** row_offset,
+                           int**              col,
+                           ValueType**        val,
+                           IndexType2         nnz,
+                           int                nrow,
+                           int                ncol);
+
+        /// Pass the data pointers on, row offsets of another width are rejected
+        void leave_data_ptr_(PointerType** row_offset, int** col, ValueType** val);
+        template <typename OtherPointerType>
+        void leave_data_ptr_(OtherPointerType** row_offset, int** col, ValueType** val);
+
+        /// Check if the merge path partition fits the current matrix structure
+        bool spmv_valid_(void) const;
+
+        friend class HostMatrixCSRBase<ValueType, IndexType2>;
+        friend class HostMatrixCOO<ValueType>;
+    };
+
+    template <typename ValueType>
+    class HostMatrixCSR : public HostMatrixCSRBase<ValueType, int>
+    {
+    public:
+        HostMatrixCSR();
+        HostMatrixCSR(const Rocalution_Backend_Descriptor local_backend);
+        virtual ~HostMatrixCSR();
 
         virtual void Clear(void);
         virtual bool Zeros(void);
@@ -81,7 +165,14 @@ namespace rocalution
 
         virtual bool ZeroBlockPermutation(int& size, BaseVector<int>* permutation) const;
 
+        virtual bool SchurComplement(int                    size,
+                                     BaseVector<ValueType>* inv_diag,
+                                     BaseMatrix<ValueType>* E,
+                                     BaseMatrix<ValueType>* F,
+                                     BaseMatrix<ValueType>* S) const;
+
         virtual bool SymbolicPower(int p);
+        virtual bool SymbolicILUp(int p);
 
         virtual bool SymbolicMatMatMult(const BaseMatrix<ValueType>& src);
         virtual bool MatMatMult(const BaseMatrix<ValueType>& A, const BaseMatrix<ValueType>& B);
@@ -103,16 +194,15 @@ namespace rocalution
         virtual bool CMK(BaseVector<int>* permutation) const;
         virtual bool RCMK(BaseVector<int>* permutation) const;
         virtual bool ConnectivityOrder(BaseVector<int>* permutation) const;
+        virtual bool NestedDissection(BaseVector<int>* permutation) const;
+        virtual bool LocalityOrder(int block_size, BaseVector<int>* permutation) const;
+        virtual bool Partition(int nparts, BaseVector<int>* partition) const;
 
         virtual bool ConvertFrom(const BaseMatrix<ValueType>& mat);
 
-        virtual void CopyFrom(const BaseMatrix<ValueType>& mat);
-
         virtual void CopyFromCSR(const int* row_offsets, const int* col, const ValueType* val);
         virtual void CopyToCSR(int* row_offsets, int* col, ValueType* val) const;
 
-        virtual void CopyTo(BaseMatrix<ValueType>* mat) const;
-
         virtual void CopyFromHostCSR(const int*       row_offset,
                                      const int*       col,
                                      const ValueType* val,
@@ -120,9 +210,6 @@ namespace rocalution
                                      int              nrow,
                                      int              ncol);
 
-        virtual bool ReadFileCSR(const std::string);
-        virtual bool WriteFileCSR(const std::string) const;
-
         virtual bool CreateFromMap(const BaseVector<int>& map, int n, int m);
         virtual bool
             CreateFromMap(const BaseVector<int>& map, int n, int m, BaseMatrix<ValueType>* pro);
@@ -154,10 +241,34 @@ namespace rocalution
 
         virtual bool Gershgorin(ValueType& lambda_min, ValueType& lambda_max) const;
 
-        virtual void Apply(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
-        virtual void ApplyAdd(const BaseVector<ValueType>& in,
-                              ValueType                    scalar,
-                              BaseVector<ValueType>*       out) const;
+        virtual bool SelectFormat(bool accel, unsigned int& mat_format) const;
+
+        virtual bool MatrixPowers(int                     k,
+                                  const ValueType*        alpha,
+                                  const ValueType*        beta,
+                                  const ValueType*        gamma,
+                                  BaseVector<ValueType>** v) const;
+
+        virtual bool MatrixPolynomial(int                          k,
+                                      const ValueType*             alpha,
+                                      const ValueType*             beta,
+                                      const ValueType*             gamma,
+                                      const ValueType*             weight,
+                                      const BaseVector<ValueType>* scale,
+                                      const BaseVector<ValueType>& in,
+                                      BaseVector<ValueType>*       out) const;
+
+        virtual bool SORSweep(int                          num_colors,
+                              const int*                   color_offset,
+                              const BaseVector<int>&       color_rows,
+                              ValueType                    omega,
+                              bool                         symmetric,
+                              bool                         zero_guess,
+                              int                          sweeps,
+                              const BaseVector<ValueType>& rhs,
+                              BaseVector<ValueType>*       x) const;
+
+        virtual void ApplyAnalysis(void);
 
         virtual bool Compress(double drop_off);
         virtual bool Transpose(void);
@@ -185,6 +296,13 @@ namespace rocalution
         virtual bool RugeStueben(ValueType              eps,
                                  BaseMatrix<ValueType>* prolong,
                                  BaseMatrix<ValueType>* restrict) const;
+        virtual bool RugeStueben(ValueType              eps,
+                                 int                    coarsening,
+                                 int                    interpolation,
+                                 bool                   aggressive,
+                                 int                    max_elements,
+                                 BaseMatrix<ValueType>* prolong,
+                                 BaseMatrix<ValueType>* restrict) const;
 
         virtual bool FSAI(int power, const BaseMatrix<ValueType>* pattern);
         virtual bool SPAI(void);
@@ -228,11 +346,40 @@ namespace rocalution
                                      int                    rGsize) const;
 
     private:
-        MatrixCSR<ValueType, int> mat_;
+        /// Build the matrix powers tiles for depth k if required, returns false if the
+        /// tiles cannot be used for this matrix
+        bool powers_tiles_(int k) const;
+
+        // Parallel matching of the strong couplings for the pairwise aggregation, ghost holds
+        // the couplings to neighbouring processes (or NULL). Strongly diagonally dominant
+        // rows are excluded (mate[i] = -2) if dominant is set.
+        void pairwise_match_(const HostMatrixCSR<ValueType>* ghost,
+                             ValueType                       beta,
+                             bool                            dominant,
+                             int*                            mate) const;
+        void initial_pairwise_aggregation_(const HostMatrixCSR<ValueType>* ghost,
+                                           ValueType                       beta,
+                                           int&                            nc,
+                                           BaseVector<int>*                G,
+                                           int&                            Gsize,
+                                           int**                           rG,
+                                           int&                            rGsize) const;
+        void further_pairwise_aggregation_(const HostMatrixCSR<ValueType>* ghost,
+                                           ValueType                       beta,
+                                           int&                            nc,
+                                           BaseVector<int>*                G,
+                                           int&                            Gsize,
+                                           int**                           rG,
+                                           int&                            rGsize) const;
+
+        // Cache blocking of the matrix powers kernel, built by the first MatrixPowers() or
+        // MatrixPolynomial() call and dropped whenever the structure changes (see ApplyAnalysis())
+        mutable HostMatrixPowersTiles* powers_;
 
         friend class BaseVector<ValueType>;
         friend class HostVector<ValueType>;
         friend class HostMatrixCOO<ValueType>;
+        friend class HostMatrixCSRBase<ValueType, IndexType2>;
         friend class HostMatrixDIA<ValueType>;
         friend class HostMatrixELL<ValueType>;
         friend class HostMatrixHYB<ValueType>;
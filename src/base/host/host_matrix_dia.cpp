@@ -253,8 +253,8 @@ namespace rocalution
             this->Clear();
             int nnz = 0;
 
-            if(csr_to_dia(this->local_backend_.OpenMP_threads,
-                          cast_mat->nnz_,
+            if(csr_to_dia(_get_omp_backend_threads(this->local_backend_, cast_mat->nrow_),
+                          static_cast<int>(cast_mat->nnz_),
                           cast_mat->nrow_,
                           cast_mat->ncol_,
                           cast_mat->mat_,
@@ -27,6 +27,7 @@
 #include "../../utils/log.hpp"
 #include "../matrix_formats_ind.hpp"
 #include "host_conversion.hpp"
+#include "host_matrix_coo.hpp"
 #include "host_matrix_csr.hpp"
 #include "host_vector.hpp"
 
@@ -259,8 +260,8 @@ namespace rocalution
             int coo_nnz = 0;
             int ell_nnz = 0;
 
-            if(csr_to_hyb(this->local_backend_.OpenMP_threads,
-                          cast_mat->nnz_,
+            if(csr_to_hyb(_get_omp_backend_threads(this->local_backend_, cast_mat->nrow_),
+                          static_cast<int>(cast_mat->nnz_),
                           cast_mat->nrow_,
                           cast_mat->ncol_,
                           cast_mat->mat_,
@@ -324,15 +325,27 @@ namespace rocalution
                     }
                 }
             }
+            else
+            {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+                for(int ai = 0; ai < this->nrow_; ++ai)
+                {
+                    cast_out->vec_[ai] = static_cast<ValueType>(0);
+                }
+            }
 
             // COO
             if(this->coo_nnz_ > 0)
             {
-                for(int i = 0; i < this->coo_nnz_; ++i)
-                {
-                    cast_out->vec_[this->mat_.COO.row[i]]
-                        += this->mat_.COO.val[i] * cast_in->vec_[this->mat_.COO.col[i]];
-                }
+                _set_omp_backend_threads(this->local_backend_, this->coo_nnz_);
+
+                coo_spmv(this->coo_nnz_,
+                         this->mat_.COO,
+                         static_cast<ValueType>(1),
+                         cast_in->vec_,
+                         cast_out->vec_);
             }
         }
     }
@@ -381,11 +394,9 @@ namespace rocalution
             // COO
             if(this->coo_nnz_ > 0)
             {
-                for(int i = 0; i < this->coo_nnz_; ++i)
-                {
-                    cast_out->vec_[this->mat_.COO.row[i]]
-                        += scalar * this->mat_.COO.val[i] * cast_in->vec_[this->mat_.COO.col[i]];
-                }
+                _set_omp_backend_threads(this->local_backend_, this->coo_nnz_);
+
+                coo_spmv(this->coo_nnz_, this->mat_.COO, scalar, cast_in->vec_, cast_out->vec_);
             }
         }
     }
@@ -0,0 +1,546 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "host_matrix_powers.hpp"
+#include "../../utils/def.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <complex>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_set_num_threads(num) ;
+#endif
+
+namespace rocalution
+{
+
+    bool matrix_powers_tiles(int                    omp_threads,
+                             int                    n,
+                             const int*             row_offset,
+                             const int*             col,
+                             int                    depth,
+                             IndexType2             tile_nnz,
+                             double                 max_redundancy,
+                             HostMatrixPowersTiles* tiles)
+    {
+        assert(n >= 0);
+        assert(depth > 0);
+        assert(tile_nnz > 0);
+        assert(tiles != NULL);
+
+        omp_set_num_threads(omp_threads);
+
+        tiles->depth    = depth;
+        tiles->nrow     = n;
+        tiles->nnz      = row_offset[n];
+        tiles->ntile    = 0;
+        tiles->max_rows = 0;
+
+        tiles->row.clear();
+        tiles->ptr.clear();
+        tiles->layer_row.clear();
+        tiles->layer.clear();
+        tiles->col_ptr.clear();
+        tiles->col.clear();
+
+        // Consecutive rows with about tile_nnz non-zeros each
+        std::vector<int> row(1, 0);
+
+        for(int i = 0; i < n;)
+        {
+            int end = i + 1;
+            while(end < n && row_offset[end + 1] - row_offset[i] <= tile_nnz)
+            {
+                ++end;
+            }
+
+            row.push_back(end);
+            i = end;
+        }
+
+        int ntile = static_cast<int>(row.size()) - 1;
+
+        // A single tile is equivalent to depth plain SpMVs
+        if(ntile < 2)
+        {
+            return false;
+        }
+
+        std::vector<std::vector<int>> tile_rows(ntile);
+        std::vector<std::vector<int>> tile_cols(ntile);
+        std::vector<int>              layer(ntile * (depth + 1));
+        std::vector<IndexType2>       work(ntile, 0);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            // Tile that has reached a row last and the position of the row in that tile
+            std::vector<int> mark(n, -1);
+            std::vector<int> loc(n);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+            for(int t = 0; t < ntile; ++t)
+            {
+                std::vector<int>& rows = tile_rows[t];
+                std::vector<int>& cols = tile_cols[t];
+
+                int* size = &layer[t * (depth + 1)];
+
+                for(int i = row[t]; i < row[t + 1]; ++i)
+                {
+                    mark[i] = t;
+                    loc[i]  = static_cast<int>(rows.size());
+                    rows.push_back(i);
+                }
+
+                size[0] = static_cast<int>(rows.size());
+
+                // Breadth-first search of depth levels, level m holds the rows with
+                // distance m to the tile
+                int begin = 0;
+                for(int m = 1; m <= depth; ++m)
+                {
+                    int end = size[m - 1];
+
+                    for(int r = begin; r < end; ++r)
+                    {
+                        int i = rows[r];
+                        for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+                        {
+                            int c = col[j];
+                            if(mark[c] != t)
+                            {
+                                mark[c] = t;
+                                loc[c]  = static_cast<int>(rows.size());
+                                rows.push_back(c);
+                            }
+                        }
+                    }
+
+                    size[m] = static_cast<int>(rows.size());
+                    begin   = end;
+                }
+
+                // Local column indices of the rows that are multiplied, these only refer to
+                // rows of the tile
+                for(int r = 0; r < size[depth - 1]; ++r)
+                {
+                    int i = rows[r];
+                    for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+                    {
+                        cols.push_back(loc[col[j]]);
+                    }
+                }
+
+                // Power j is computed on the rows with distance <= depth - j
+                IndexType2 nnz = 0;
+                int        r   = 0;
+                for(int m = 0; m < depth; ++m)
+                {
+                    for(; r < size[m]; ++r)
+                    {
+                        nnz += row_offset[rows[r] + 1] - row_offset[rows[r]];
+                    }
+
+                    work[t] += nnz;
+                }
+            }
+        }
+
+        IndexType2 total = 0;
+        IndexType2 nrows = 0;
+        IndexType2 ncols = 0;
+        int        max_rows = 0;
+
+        for(int t = 0; t < ntile; ++t)
+        {
+            total += work[t];
+            nrows += tile_rows[t].size();
+            ncols += tile_cols[t].size();
+
+            max_rows = std::max(max_rows, static_cast<int>(tile_rows[t].size()));
+        }
+
+        // Too much redundant work in the ghost layers, e.g. if the matrix has a large
+        // bandwidth
+        if(static_cast<double>(total)
+           > max_redundancy * static_cast<double>(depth) * static_cast<double>(row_offset[n]))
+        {
+            return false;
+        }
+
+        tiles->ntile    = ntile;
+        tiles->max_rows = max_rows;
+
+        tiles->row.swap(row);
+        tiles->layer.swap(layer);
+
+        tiles->ptr.resize(ntile + 1);
+        tiles->col_ptr.resize(ntile + 1);
+
+        tiles->ptr[0]     = 0;
+        tiles->col_ptr[0] = 0;
+
+        for(int t = 0; t < ntile; ++t)
+        {
+            tiles->ptr[t + 1]     = tiles->ptr[t] + tile_rows[t].size();
+            tiles->col_ptr[t + 1] = tiles->col_ptr[t] + tile_cols[t].size();
+        }
+
+        tiles->layer_row.resize(nrows);
+        tiles->col.resize(ncols);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for(int t = 0; t < ntile; ++t)
+        {
+            std::copy(
+                tile_rows[t].begin(), tile_rows[t].end(), tiles->layer_row.begin() + tiles->ptr[t]);
+            std::copy(
+                tile_cols[t].begin(), tile_cols[t].end(), tiles->col.begin() + tiles->col_ptr[t]);
+        }
+
+        return true;
+    }
+
+    // v2 = a S A v1 + b v1 + c v0 on the first nrow rows of a tile, S is the diagonal
+    // matrix of the row factors scale (identity if NULL) and v0 is only used if three is set
+    template <typename ValueType>
+    static inline void tile_product_(const int*       rows,
+                                     const int*       cols,
+                                     const int*       row_offset,
+                                     const ValueType* val,
+                                     const ValueType* scale,
+                                     int              nrow,
+                                     ValueType        a,
+                                     ValueType        b,
+                                     ValueType        c,
+                                     bool             three,
+                                     const ValueType* v0,
+                                     const ValueType* v1,
+                                     ValueType*       v2)
+    {
+        IndexType2 pos = 0;
+
+        for(int r = 0; r < nrow; ++r)
+        {
+            int i       = rows[r];
+            int row_beg = row_offset[i];
+            int row_end = row_offset[i + 1];
+
+            const ValueType* aval = val + row_beg;
+            const int*       acol = cols + pos;
+
+            ValueType sum = static_cast<ValueType>(0);
+            for(int aj = 0; aj < row_end - row_beg; ++aj)
+            {
+                sum += aval[aj] * v1[acol[aj]];
+            }
+
+            if(scale != NULL)
+            {
+                sum *= scale[i];
+            }
+
+            v2[r] = a * sum + b * v1[r];
+            if(three == true)
+            {
+                v2[r] += c * v0[r];
+            }
+
+            pos += row_end - row_beg;
+        }
+    }
+
+    template <typename ValueType>
+    void matrix_powers_apply(int                          omp_threads,
+                             const HostMatrixPowersTiles& tiles,
+                             const int*                   row_offset,
+                             const ValueType*             val,
+                             int                          k,
+                             const ValueType*             alpha,
+                             const ValueType*             beta,
+                             const ValueType*             gamma,
+                             ValueType**                  v)
+    {
+        assert(tiles.ntile > 0);
+        assert(k > 0 && k <= tiles.depth);
+        assert(v != NULL);
+
+        omp_set_num_threads(omp_threads);
+
+        int depth = tiles.depth;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            // Last three basis vectors on the rows of the tile
+            std::vector<ValueType> work(3 * tiles.max_rows);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+            for(int t = 0; t < tiles.ntile; ++t)
+            {
+                const int* rows  = &tiles.layer_row[tiles.ptr[t]];
+                const int* cols  = &tiles.col[tiles.col_ptr[t]];
+                const int* layer = &tiles.layer[t * (depth + 1)];
+
+                int begin = tiles.row[t];
+                int owned = layer[0];
+
+                ValueType* v0 = &work[0];
+                ValueType* v1 = &work[tiles.max_rows];
+                ValueType* v2 = &work[2 * tiles.max_rows];
+
+                // v_0 on all rows with distance <= k
+                for(int r = 0; r < layer[k]; ++r)
+                {
+                    v1[r] = v[0][rows[r]];
+                }
+
+                for(int j = 0; j < k; ++j)
+                {
+                    // v_j+1 is required on the rows with distance <= k - j - 1
+                    tile_product_(rows,
+                                  cols,
+                                  row_offset,
+                                  val,
+                                  (const ValueType*)NULL,
+                                  layer[k - j - 1],
+                                  alpha[j],
+                                  beta[j],
+                                  gamma[j],
+                                  j > 0,
+                                  v0,
+                                  v1,
+                                  v2);
+
+                    // Owned rows are stored in order
+                    ValueType* out = v[j + 1] + begin;
+                    for(int r = 0; r < owned; ++r)
+                    {
+                        out[r] = v2[r];
+                    }
+
+                    ValueType* tmp = v0;
+                    v0             = v1;
+                    v1             = v2;
+                    v2             = tmp;
+                }
+            }
+        }
+    }
+
+    template void matrix_powers_apply(int                          omp_threads,
+                                      const HostMatrixPowersTiles& tiles,
+                                      const int*                   row_offset,
+                                      const float*                 val,
+                                      int                          k,
+                                      const float*                 alpha,
+                                      const float*                 beta,
+                                      const float*                 gamma,
+                                      float**                      v);
+    template void matrix_powers_apply(int                          omp_threads,
+                                      const HostMatrixPowersTiles& tiles,
+                                      const int*                   row_offset,
+                                      const double*                val,
+                                      int                          k,
+                                      const double*                alpha,
+                                      const double*                beta,
+                                      const double*                gamma,
+                                      double**                     v);
+#ifdef SUPPORT_COMPLEX
+    template void matrix_powers_apply(int                          omp_threads,
+                                      const HostMatrixPowersTiles& tiles,
+                                      const int*                   row_offset,
+                                      const std::complex<float>*   val,
+                                      int                          k,
+                                      const std::complex<float>*   alpha,
+                                      const std::complex<float>*   beta,
+                                      const std::complex<float>*   gamma,
+                                      std::complex<float>**        v);
+    template void matrix_powers_apply(int                          omp_threads,
+                                      const HostMatrixPowersTiles& tiles,
+                                      const int*                   row_offset,
+                                      const std::complex<double>*  val,
+                                      int                          k,
+                                      const std::complex<double>*  alpha,
+                                      const std::complex<double>*  beta,
+                                      const std::complex<double>*  gamma,
+                                      std::complex<double>**       v);
+#endif
+
+    template <typename ValueType>
+    void matrix_powers_polynomial(int                          omp_threads,
+                                  const HostMatrixPowersTiles& tiles,
+                                  const int*                   row_offset,
+                                  const ValueType*             val,
+                                  const ValueType*             scale,
+                                  int                          k,
+                                  const ValueType*             alpha,
+                                  const ValueType*             beta,
+                                  const ValueType*             gamma,
+                                  const ValueType*             weight,
+                                  const ValueType*             x,
+                                  ValueType*                   y)
+    {
+        assert(tiles.ntile > 0);
+        assert(k > 0 && k <= tiles.depth);
+        assert(x != NULL);
+        assert(y != NULL);
+        assert(x != y);
+
+        omp_set_num_threads(omp_threads);
+
+        int depth = tiles.depth;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            // Last three basis vectors on the rows of the tile
+            std::vector<ValueType> work(3 * tiles.max_rows);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+            for(int t = 0; t < tiles.ntile; ++t)
+            {
+                const int* rows  = &tiles.layer_row[tiles.ptr[t]];
+                const int* cols  = &tiles.col[tiles.col_ptr[t]];
+                const int* layer = &tiles.layer[t * (depth + 1)];
+
+                int begin = tiles.row[t];
+                int owned = layer[0];
+
+                ValueType* v0 = &work[0];
+                ValueType* v1 = &work[tiles.max_rows];
+                ValueType* v2 = &work[2 * tiles.max_rows];
+
+                // v_0 on all rows with distance <= k
+                for(int r = 0; r < layer[k]; ++r)
+                {
+                    v1[r] = x[rows[r]];
+                }
+
+                // Owned rows are stored in order
+                ValueType* out = y + begin;
+                for(int r = 0; r < owned; ++r)
+                {
+                    out[r] = weight[0] * v1[r];
+                }
+
+                for(int j = 0; j < k; ++j)
+                {
+                    // v_j+1 is required on the rows with distance <= k - j - 1
+                    tile_product_(rows,
+                                  cols,
+                                  row_offset,
+                                  val,
+                                  scale,
+                                  layer[k - j - 1],
+                                  alpha[j],
+                                  beta[j],
+                                  gamma[j],
+                                  j > 0,
+                                  v0,
+                                  v1,
+                                  v2);
+
+                    ValueType w = weight[j + 1];
+                    for(int r = 0; r < owned; ++r)
+                    {
+                        out[r] += w * v2[r];
+                    }
+
+                    ValueType* tmp = v0;
+                    v0             = v1;
+                    v1             = v2;
+                    v2             = tmp;
+                }
+            }
+        }
+    }
+
+    template void matrix_powers_polynomial(int                          omp_threads,
+                                           const HostMatrixPowersTiles& tiles,
+                                           const int*                   row_offset,
+                                           const float*                 val,
+                                           const float*                 scale,
+                                           int                          k,
+                                           const float*                 alpha,
+                                           const float*                 beta,
+                                           const float*                 gamma,
+                                           const float*                 weight,
+                                           const float*                 x,
+                                           float*                       y);
+    template void matrix_powers_polynomial(int                          omp_threads,
+                                           const HostMatrixPowersTiles& tiles,
+                                           const int*                   row_offset,
+                                           const double*                val,
+                                           const double*                scale,
+                                           int                          k,
+                                           const double*                alpha,
+                                           const double*                beta,
+                                           const double*                gamma,
+                                           const double*                weight,
+                                           const double*                x,
+                                           double*                      y);
+#ifdef SUPPORT_COMPLEX
+    template void matrix_powers_polynomial(int                          omp_threads,
+                                           const HostMatrixPowersTiles& tiles,
+                                           const int*                   row_offset,
+                                           const std::complex<float>*   val,
+                                           const std::complex<float>*   scale,
+                                           int                          k,
+                                           const std::complex<float>*   alpha,
+                                           const std::complex<float>*   beta,
+                                           const std::complex<float>*   gamma,
+                                           const std::complex<float>*   weight,
+                                           const std::complex<float>*   x,
+                                           std::complex<float>*         y);
+    template void matrix_powers_polynomial(int                          omp_threads,
+                                           const HostMatrixPowersTiles& tiles,
+                                           const int*                   row_offset,
+                                           const std::complex<double>*  val,
+                                           const std::complex<double>*  scale,
+                                           int                          k,
+                                           const std::complex<double>*  alpha,
+                                           const std::complex<double>*  beta,
+                                           const std::complex<double>*  gamma,
+                                           const std::complex<double>*  weight,
+                                           const std::complex<double>*  x,
+                                           std::complex<double>*        y);
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,109 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_HOST_HOST_MATRIX_POWERS_HPP_
+#define ROCALUTION_HOST_HOST_MATRIX_POWERS_HPP_
+
+#include "../../utils/types.hpp"
+
+#include <vector>
+
+namespace rocalution
+{
+
+    // Cache blocking of the matrix powers kernel. The rows are split into tiles of
+    // consecutive rows. Each tile holds all rows that are required to compute its own
+    // rows of the first depth basis vectors, ordered by their distance to the tile (ghost
+    // layers), such that the tile can be processed without synchronization.
+    struct HostMatrixPowersTiles
+    {
+        // Number of powers and matrix structure the tiles have been built for, the tiles
+        // are not used if ntile is 0
+        int        depth;
+        int        nrow;
+        IndexType2 nnz;
+        int        ntile;
+
+        // Largest number of rows of a tile, including its ghost layers
+        int max_rows;
+
+        // Tile t owns the rows row[t] <= i < row[t + 1]
+        std::vector<int> row;
+        // Rows of tile t (owned rows first, then the ghost layers) are
+        // layer_row[ptr[t]], ..., layer_row[ptr[t + 1] - 1]
+        std::vector<IndexType2> ptr;
+        std::vector<int>        layer_row;
+        // layer[t * (depth + 1) + m] is the number of rows of tile t with distance <= m
+        std::vector<int> layer;
+        // Local column indices of the rows with distance < depth, starting at col_ptr[t]
+        std::vector<IndexType2> col_ptr;
+        std::vector<int>        col;
+    };
+
+    // Build the tiles of the matrix powers kernel of a square CSR matrix for up to depth
+    // powers, each tile owns about tile_nnz non-zeros. Returns false (and ntile = 0) if
+    // the ghost layers add more than max_redundancy times the work of depth SpMVs.
+    bool matrix_powers_tiles(int                    omp_threads,
+                             int                    n,
+                             const int*             row_offset,
+                             const int*             col,
+                             int                    depth,
+                             IndexType2             tile_nnz,
+                             double                 max_redundancy,
+                             HostMatrixPowersTiles* tiles);
+
+    // Polynomial basis v[j + 1] = alpha[j] A v[j] + beta[j] v[j] + gamma[j] v[j - 1] for
+    // j = 0, ..., k - 1 (with v[-1] = 0), k must not exceed the depth of the tiles. The
+    // tiles are processed in parallel, each tile performs its k SpMVs in cache.
+    template <typename ValueType>
+    void matrix_powers_apply(int                          omp_threads,
+                             const HostMatrixPowersTiles& tiles,
+                             const int*                   row_offset,
+                             const ValueType*             val,
+                             int                          k,
+                             const ValueType*             alpha,
+                             const ValueType*             beta,
+                             const ValueType*             gamma,
+                             ValueType**                  v);
+
+    // Polynomial y = weight[0] v[0] + ... + weight[k] v[k] of the basis v[j + 1] =
+    // alpha[j] S A v[j] + beta[j] v[j] + gamma[j] v[j - 1] with v[0] = x, where S is the
+    // diagonal matrix of the row factors scale (identity if NULL). Only x and y are
+    // accessed in memory, the basis vectors are kept in the tiles.
+    template <typename ValueType>
+    void matrix_powers_polynomial(int                          omp_threads,
+                                  const HostMatrixPowersTiles& tiles,
+                                  const int*                   row_offset,
+                                  const ValueType*             val,
+                                  const ValueType*             scale,
+                                  int                          k,
+                                  const ValueType*             alpha,
+                                  const ValueType*             beta,
+                                  const ValueType*             gamma,
+                                  const ValueType*             weight,
+                                  const ValueType*             x,
+                                  ValueType*                   y);
+
+} // namespace rocalution
+
+#endif // ROCALUTION_HOST_HOST_MATRIX_POWERS_HPP_
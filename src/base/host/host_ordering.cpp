@@ -0,0 +1,564 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "host_ordering.hpp"
+#include "../../utils/def.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <limits>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_set_num_threads(num) ;
+#endif
+
+namespace rocalution
+{
+
+    // Minimal size of a level to be processed in parallel by the breadth-first search
+    static const int bfs_parallel_size = 1024;
+
+    // Maximal size of a nested dissection subgraph that is not split any further
+    static const int nd_leaf_size = 64;
+
+    void graph_symmetric(int               n,
+                         const int*        row_offset,
+                         const int*        col,
+                         std::vector<int>* adj_ptr,
+                         std::vector<int>* adj)
+    {
+        assert(adj_ptr != NULL);
+        assert(adj != NULL);
+
+        adj_ptr->assign(n + 1, 0);
+        adj->clear();
+
+        std::vector<int>& ptr = *adj_ptr;
+
+        for(int i = 0; i < n; ++i)
+        {
+            for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+            {
+                int c = col[j];
+
+                if(c != i)
+                {
+                    ++ptr[i + 1];
+                    ++ptr[c + 1];
+                }
+            }
+        }
+
+        for(int i = 0; i < n; ++i)
+        {
+            ptr[i + 1] += ptr[i];
+        }
+
+        std::vector<int> raw(ptr[n]);
+        std::vector<int> pos(ptr.begin(), ptr.end() - 1);
+
+        for(int i = 0; i < n; ++i)
+        {
+            for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+            {
+                int c = col[j];
+
+                if(c != i)
+                {
+                    raw[pos[i]++] = c;
+                    raw[pos[c]++] = i;
+                }
+            }
+        }
+
+        // Remove duplicated edges
+        std::vector<int> marker(n, -1);
+
+        adj->reserve(raw.size());
+
+        int start = 0;
+        for(int i = 0; i < n; ++i)
+        {
+            int end = ptr[i + 1];
+
+            for(int j = start; j < end; ++j)
+            {
+                if(marker[raw[j]] != i)
+                {
+                    marker[raw[j]] = i;
+                    adj->push_back(raw[j]);
+                }
+            }
+
+            start      = end;
+            ptr[i + 1] = adj->size();
+        }
+    }
+
+    // Claim the unvisited node v for its neighbor at position p of the current level. Like
+    // in a sequential breadth-first search, v is attached to the claiming neighbor of lowest
+    // position. Claims are stored in pos as p - INT_MAX, i.e. below -1 (unvisited), such
+    // that an atomic minimum selects the parent.
+    static inline void bfs_claim(int v, int p, int* pos)
+    {
+        int claim = p - std::numeric_limits<int>::max();
+        int cur   = __atomic_load_n(&pos[v], __ATOMIC_RELAXED);
+
+        // On failure, cur is updated to the current claim
+        while(cur < 0 && claim < cur)
+        {
+            if(__atomic_compare_exchange_n(
+                   &pos[v], &cur, claim, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+    }
+
+    // Level-synchronous breadth-first search from root, restricted to the nodes i with
+    // region[i] == id (all nodes, if region is NULL). The visited nodes are stored in
+    // Cuthill-McKee order, i.e. the children of each node are appended by increasing degree.
+    // All nodes that can be reached have to be unvisited (pos = -1). On return, pos holds
+    // the position of each visited node in order and level_ptr the start of each level.
+    // Returns the number of visited nodes.
+    static int bfs_cuthill_mckee(int               root,
+                                 const int*        adj_ptr,
+                                 const int*        adj,
+                                 const int*        region,
+                                 int               id,
+                                 int*              pos,
+                                 int*              order,
+                                 std::vector<int>* level_ptr)
+    {
+        std::vector<int> count;
+
+        level_ptr->clear();
+        level_ptr->push_back(0);
+
+        order[0]  = root;
+        pos[root] = 0;
+
+        int begin = 0;
+        int end   = 1;
+
+        while(begin < end)
+        {
+            level_ptr->push_back(end);
+
+            int size = end - begin;
+
+            count.resize(size + 1);
+            count[0] = 0;
+
+            // Each unvisited neighbor of the current level is claimed by its parent
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) if(size >= bfs_parallel_size)
+#endif
+            for(int i = 0; i < size; ++i)
+            {
+                int u = order[begin + i];
+
+                for(int j = adj_ptr[u]; j < adj_ptr[u + 1]; ++j)
+                {
+                    int v = adj[j];
+
+                    if(region == NULL || region[v] == id)
+                    {
+                        bfs_claim(v, begin + i, pos);
+                    }
+                }
+            }
+
+            // Count the children of each node in the current level
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) if(size >= bfs_parallel_size)
+#endif
+            for(int i = 0; i < size; ++i)
+            {
+                int u     = order[begin + i];
+                int claim = begin + i - std::numeric_limits<int>::max();
+                int c     = 0;
+
+                for(int j = adj_ptr[u]; j < adj_ptr[u + 1]; ++j)
+                {
+                    if(pos[adj[j]] == claim)
+                    {
+                        ++c;
+                    }
+                }
+
+                count[i + 1] = c;
+            }
+
+            for(int i = 0; i < size; ++i)
+            {
+                count[i + 1] += count[i];
+            }
+
+            // Append the children of each node, sorted by increasing degree
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) if(size >= bfs_parallel_size)
+#endif
+            for(int i = 0; i < size; ++i)
+            {
+                int u     = order[begin + i];
+                int claim = begin + i - std::numeric_limits<int>::max();
+                int first = end + count[i];
+                int last  = first;
+
+                for(int j = adj_ptr[u]; j < adj_ptr[u + 1]; ++j)
+                {
+                    if(pos[adj[j]] == claim)
+                    {
+                        order[last++] = adj[j];
+                    }
+                }
+
+                std::sort(order + first, order + last, [adj_ptr](int a, int b) {
+                    int deg_a = adj_ptr[a + 1] - adj_ptr[a];
+                    int deg_b = adj_ptr[b + 1] - adj_ptr[b];
+
+                    return (deg_a < deg_b) || (deg_a == deg_b && a < b);
+                });
+            }
+
+            int next = end + count[size];
+
+#ifdef _OPENMP
+#pragma omp parallel for if(next - end >= bfs_parallel_size)
+#endif
+            for(int i = end; i < next; ++i)
+            {
+                pos[order[i]] = i;
+            }
+
+            begin = end;
+            end   = next;
+        }
+
+        return end;
+    }
+
+    // Breadth-first search (see bfs_cuthill_mckee()) from a pseudo-peripheral node of the
+    // subgraph that contains start. Following George and Liu, the search is repeated from
+    // the node of minimal degree in the last level, as long as the number of levels grows.
+    static int bfs_pseudo_peripheral(int               start,
+                                     const int*        adj_ptr,
+                                     const int*        adj,
+                                     const int*        region,
+                                     int               id,
+                                     int*              pos,
+                                     int*              order,
+                                     std::vector<int>* level_ptr)
+    {
+        int count  = bfs_cuthill_mckee(start, adj_ptr, adj, region, id, pos, order, level_ptr);
+        int nlevel = level_ptr->size() - 1;
+
+        while(true)
+        {
+            // Node of minimal degree in the last level
+            int root = order[(*level_ptr)[nlevel - 1]];
+
+            for(int i = (*level_ptr)[nlevel - 1] + 1; i < count; ++i)
+            {
+                int v = order[i];
+
+                if(adj_ptr[v + 1] - adj_ptr[v] < adj_ptr[root + 1] - adj_ptr[root])
+                {
+                    root = v;
+                }
+            }
+
+            for(int i = 0; i < count; ++i)
+            {
+                pos[order[i]] = -1;
+            }
+
+            // The eccentricity of root is at least the one of the previous start node
+            count = bfs_cuthill_mckee(root, adj_ptr, adj, region, id, pos, order, level_ptr);
+
+            if(static_cast<int>(level_ptr->size()) - 1 <= nlevel)
+            {
+                break;
+            }
+
+            nlevel = level_ptr->size() - 1;
+        }
+
+        return count;
+    }
+
+    void graph_cuthill_mckee(int omp_threads, int n, const int* adj_ptr, const int* adj, int* perm)
+    {
+        omp_set_num_threads(omp_threads);
+
+        std::vector<int> pos(n, -1);
+        std::vector<int> order(n);
+        std::vector<int> level_ptr;
+
+        int next = 0;
+
+        // Traverse each connected component
+        for(int i = 0; i < n; ++i)
+        {
+            if(pos[i] == -1)
+            {
+                next += bfs_pseudo_peripheral(
+                    i, adj_ptr, adj, NULL, 0, pos.data(), order.data() + next, &level_ptr);
+            }
+        }
+
+        assert(next == n);
+
+        for(int i = 0; i < n; ++i)
+        {
+            perm[order[i]] = i;
+        }
+    }
+
+    void graph_nested_dissection(
+        int omp_threads, int n, const int* adj_ptr, const int* adj, int* perm)
+    {
+        omp_set_num_threads(omp_threads);
+
+        // Nodes of all subgraphs, each subgraph is a contiguous range of vtx
+        std::vector<int> vtx(n);
+        // Id of the subgraph a node belongs to (its first position in vtx), -1 for separators
+        std::vector<int> region(n, 0);
+        // Breadth-first search helpers
+        std::vector<int> pos(n, -1);
+        std::vector<int> order(n);
+        std::vector<int> level_ptr;
+
+        for(int i = 0; i < n; ++i)
+        {
+            vtx[i] = i;
+        }
+
+        // Stack of ranges [begin, end) of subgraphs that have to be ordered
+        struct range
+        {
+            int begin;
+            int end;
+        };
+
+        std::vector<range> stack(1);
+
+        stack[0].begin = 0;
+        stack[0].end   = n;
+
+        while(stack.empty() == false)
+        {
+            range r = stack.back();
+            stack.pop_back();
+
+            if(r.begin == r.end)
+            {
+                continue;
+            }
+
+            // Start from a node of minimal degree
+            int start = vtx[r.begin];
+
+            for(int i = r.begin + 1; i < r.end; ++i)
+            {
+                int v = vtx[i];
+
+                if(adj_ptr[v + 1] - adj_ptr[v] < adj_ptr[start + 1] - adj_ptr[start])
+                {
+                    start = v;
+                }
+            }
+
+            int size = bfs_pseudo_peripheral(
+                start, adj_ptr, adj, region.data(), r.begin, pos.data(), order.data(), &level_ptr);
+            int nlevel = level_ptr.size() - 1;
+
+            if(size < r.end - r.begin)
+            {
+                // The subgraph is not connected, split off the nodes that have not been
+                // reached and continue with the component of start
+                std::stable_partition(vtx.begin() + r.begin,
+                                      vtx.begin() + r.end,
+                                      [&pos](int v) { return pos[v] != -1; });
+
+                for(int i = r.begin + size; i < r.end; ++i)
+                {
+                    region[vtx[i]] = r.begin + size;
+                }
+
+                range rest;
+                rest.begin = r.begin + size;
+                rest.end   = r.end;
+
+                stack.push_back(rest);
+
+                r.end = r.begin + size;
+            }
+
+            // Small subgraphs and subgraphs without separating level keep the search order
+            if(size <= nd_leaf_size || nlevel < 3)
+            {
+                for(int i = 0; i < size; ++i)
+                {
+                    vtx[r.begin + i] = order[i];
+                    pos[order[i]]    = -1;
+                }
+
+                continue;
+            }
+
+            // The separator is the smallest level that leaves at least a quarter of the
+            // nodes on each side, or the median level if there is no such level
+            int sep = -1;
+
+            for(int l = 1; l < nlevel - 1; ++l)
+            {
+                if(4 * level_ptr[l] < size || 4 * (size - level_ptr[l + 1]) < size)
+                {
+                    continue;
+                }
+
+                if(sep == -1
+                   || level_ptr[l + 1] - level_ptr[l] < level_ptr[sep + 1] - level_ptr[sep])
+                {
+                    sep = l;
+                }
+            }
+
+            if(sep == -1)
+            {
+                sep = 1;
+
+                while(sep < nlevel - 2 && 2 * level_ptr[sep + 1] <= size)
+                {
+                    ++sep;
+                }
+            }
+
+            int size_a = level_ptr[sep];
+            int size_b = size - level_ptr[sep + 1];
+
+            // Arrange the subgraph as [A | B | separator], the separator is ordered last
+            int k = r.begin;
+
+            for(int i = 0; i < level_ptr[sep]; ++i)
+            {
+                vtx[k++] = order[i];
+            }
+
+            for(int i = level_ptr[sep + 1]; i < size; ++i)
+            {
+                vtx[k++]         = order[i];
+                region[order[i]] = r.begin + size_a;
+            }
+
+            for(int i = level_ptr[sep]; i < level_ptr[sep + 1]; ++i)
+            {
+                vtx[k++]         = order[i];
+                region[order[i]] = -1;
+            }
+
+            for(int i = 0; i < size; ++i)
+            {
+                pos[order[i]] = -1;
+            }
+
+            range a;
+            a.begin = r.begin;
+            a.end   = r.begin + size_a;
+
+            range b;
+            b.begin = r.begin + size_a;
+            b.end   = r.begin + size_a + size_b;
+
+            stack.push_back(a);
+            stack.push_back(b);
+        }
+
+        for(int i = 0; i < n; ++i)
+        {
+            perm[vtx[i]] = i;
+        }
+    }
+
+    void graph_locality_order(
+        int omp_threads, int n, const int* adj_ptr, const int* adj, int block_size, int* perm)
+    {
+        assert(block_size > 0);
+
+        // Seeds are taken in Cuthill-McKee order, such that consecutive blocks are close
+        std::vector<int> cmk(n);
+        graph_cuthill_mckee(omp_threads, n, adj_ptr, adj, cmk.data());
+
+        std::vector<int> seed(n);
+
+        for(int i = 0; i < n; ++i)
+        {
+            seed[cmk[i]] = i;
+            perm[i]      = -1;
+        }
+
+        // order[perm[i]] = i
+        std::vector<int> order(n);
+
+        int next = 0;
+
+        for(int k = 0; k < n; ++k)
+        {
+            int s = seed[k];
+
+            if(perm[s] != -1)
+            {
+                continue;
+            }
+
+            // Grow a compact block by breadth-first search over the unassigned nodes
+            int block_end   = std::min(next + block_size, n);
+            int head        = next;
+
+            perm[s]       = next;
+            order[next++] = s;
+
+            while(head < next && next < block_end)
+            {
+                int u = order[head++];
+
+                for(int j = adj_ptr[u]; j < adj_ptr[u + 1] && next < block_end; ++j)
+                {
+                    int v = adj[j];
+
+                    if(perm[v] == -1)
+                    {
+                        perm[v]       = next;
+                        order[next++] = v;
+                    }
+                }
+            }
+        }
+    }
+
+} // namespace rocalution
@@ -0,0 +1,57 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_HOST_HOST_ORDERING_HPP_
+#define ROCALUTION_HOST_HOST_ORDERING_HPP_
+
+#include <vector>
+
+namespace rocalution
+{
+
+    // Build the adjacency graph of the structure of A + A^T, without the diagonal
+    void graph_symmetric(int               n,
+                         const int*        row_offset,
+                         const int*        col,
+                         std::vector<int>* adj_ptr,
+                         std::vector<int>* adj);
+
+    // Cuthill-McKee ordering of a symmetric graph, perm[i] is the new position of node i.
+    // Each connected component is traversed by a level-synchronous breadth-first search,
+    // that starts in a pseudo-peripheral node and processes large levels in parallel.
+    void graph_cuthill_mckee(int omp_threads, int n, const int* adj_ptr, const int* adj, int* perm);
+
+    // Fill-reducing nested dissection ordering of a symmetric graph, perm[i] is the new
+    // position of node i
+    void graph_nested_dissection(
+        int omp_threads, int n, const int* adj_ptr, const int* adj, int* perm);
+
+    // Cache-oriented ordering of a symmetric graph, nodes are grouped into compact blocks of
+    // block_size nodes, which are ordered along a Cuthill-McKee sweep
+    void graph_locality_order(
+        int omp_threads, int n, const int* adj_ptr, const int* adj, int block_size, int* perm);
+
+} // namespace rocalution
+
+#endif // ROCALUTION_HOST_HOST_ORDERING_HPP_
@@ -0,0 +1,610 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "host_stencil_general.hpp"
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/def.hpp"
+#include "../../utils/log.hpp"
+#include "../stencil_types.hpp"
+#include "host_vector.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <cstdlib>
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_set_num_threads(num) ;
+#endif
+
+namespace rocalution
+{
+
+    // Cache budget of a tile of the spatially blocked apply, in bytes
+    static const size_t stencil_tile_bytes = 262144;
+
+    // Minimal number of points of a line chunk in ApplyPower()
+    static const int stencil_min_chunk = 64;
+
+    template <typename ValueType>
+    HostStencilGeneral<ValueType>::HostStencilGeneral()
+    {
+        // no default constructors
+        LOG_INFO("no default constructor");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    HostStencilGeneral<ValueType>::HostStencilGeneral(
+        const Rocalution_Backend_Descriptor local_backend, unsigned int type)
+    {
+        log_debug(
+            this, "HostStencilGeneral::HostStencilGeneral()", "constructor with local_backend");
+
+        this->set_backend(local_backend);
+
+        this->type_     = type;
+        this->dim_[0]   = 0;
+        this->dim_[1]   = 0;
+        this->dim_[2]   = 0;
+        this->nnz_      = 0;
+        this->var_coef_ = NULL;
+
+        // Predefined stencils, a box stencil of radius one or its star shaped subset
+        bool full = false;
+
+        switch(type)
+        {
+        case Laplace2D:
+            this->ndim_ = 2;
+            break;
+        case Laplace3D:
+            this->ndim_ = 3;
+            break;
+        case Laplace2D9:
+            this->ndim_ = 2;
+            full        = true;
+            break;
+        case Laplace3D27:
+            this->ndim_ = 3;
+            full        = true;
+            break;
+        default:
+            // General stencil, set by SetStencil()
+            this->ndim_ = 0;
+            return;
+        }
+
+        int rz = (this->ndim_ == 3) ? 1 : 0;
+
+        for(int dz = -rz; dz <= rz; ++dz)
+        {
+            for(int dy = -1; dy <= 1; ++dy)
+            {
+                for(int dx = -1; dx <= 1; ++dx)
+                {
+                    int dist = std::abs(dx) + std::abs(dy) + std::abs(dz);
+
+                    if(full == false && dist > 1)
+                    {
+                        continue;
+                    }
+
+                    // Internal grid layout, see grid_()
+                    this->offset_.push_back(dx);
+                    this->offset_.push_back((this->ndim_ == 3) ? dy : 0);
+                    this->offset_.push_back((this->ndim_ == 3) ? dz : dy);
+                    this->coef_.push_back(static_cast<ValueType>(-1));
+                    ++this->nnz_;
+                }
+            }
+        }
+
+        // Diagonal entry, row sums are zero in the interior
+        for(int k = 0; k < this->nnz_; ++k)
+        {
+            if(this->offset_[3 * k] == 0 && this->offset_[3 * k + 1] == 0
+               && this->offset_[3 * k + 2] == 0)
+            {
+                this->coef_[k] = static_cast<ValueType>(this->nnz_ - 1);
+            }
+        }
+    }
+
+    template <typename ValueType>
+    HostStencilGeneral<ValueType>::~HostStencilGeneral()
+    {
+        log_debug(this, "HostStencilGeneral::~HostStencilGeneral()", "destructor");
+
+        this->clear_coefficients_();
+    }
+
+    template <typename ValueType>
+    void HostStencilGeneral<ValueType>::Info(void) const
+    {
+        LOG_INFO("Stencil " << _stencil_type_names[this->type_] << " (Host)"
+                            << " grid=" << this->dim_[0] << "x" << this->dim_[1] << "x"
+                            << this->dim_[2] << " dim=" << this->GetNDim()
+                            << " nnz=" << this->nnz_
+                            << ((this->var_coef_ != NULL) ? " variable coefficients" : ""));
+    }
+
+    template <typename ValueType>
+    int HostStencilGeneral<ValueType>::GetNnz(void) const
+    {
+        return this->nnz_;
+    }
+
+    template <typename ValueType>
+    int HostStencilGeneral<ValueType>::GetM(void) const
+    {
+        if(this->ndim_ == 0)
+        {
+            return 0;
+        }
+
+        int m = 1;
+
+        for(int d = 0; d < this->ndim_; ++d)
+        {
+            m *= this->dim_[d];
+        }
+
+        return m;
+    }
+
+    template <typename ValueType>
+    int HostStencilGeneral<ValueType>::GetN(void) const
+    {
+        return this->GetM();
+    }
+
+    template <typename ValueType>
+    void HostStencilGeneral<ValueType>::SetGrid(int size)
+    {
+        assert(size >= 0);
+
+        this->SetGrid(size, size, size);
+    }
+
+    template <typename ValueType>
+    bool HostStencilGeneral<ValueType>::SetGrid(int nx, int ny, int nz)
+    {
+        assert(nx >= 0);
+        assert(ny >= 0);
+        assert(nz >= 0);
+
+        if(nx != this->dim_[0] || ny != this->dim_[1] || nz != this->dim_[2])
+        {
+            this->clear_coefficients_();
+        }
+
+        this->size_   = nx;
+        this->dim_[0] = nx;
+        this->dim_[1] = ny;
+        this->dim_[2] = nz;
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostStencilGeneral<ValueType>::SetStencil(int              ndim,
+                                                   int              nnz,
+                                                   const int*       offset,
+                                                   const ValueType* coef)
+    {
+        // Predefined stencils cannot be changed
+        if(this->type_ != General)
+        {
+            return false;
+        }
+
+        assert(ndim >= 1 && ndim <= 3);
+        assert(nnz > 0);
+        assert(offset != NULL);
+        assert(coef != NULL);
+
+        this->clear_coefficients_();
+
+        this->ndim_ = ndim;
+        this->nnz_  = nnz;
+        this->offset_.assign(3 * nnz, 0);
+        this->coef_.assign(coef, coef + nnz);
+
+        for(int k = 0; k < nnz; ++k)
+        {
+            const int* off = offset + k * ndim;
+
+            // Internal grid layout, see grid_()
+            this->offset_[3 * k] = off[0];
+
+            if(ndim == 2)
+            {
+                this->offset_[3 * k + 2] = off[1];
+            }
+            else if(ndim == 3)
+            {
+                this->offset_[3 * k + 1] = off[1];
+                this->offset_[3 * k + 2] = off[2];
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostStencilGeneral<ValueType>::SetVariableCoefficients(const ValueType* coef)
+    {
+        assert(coef != NULL);
+
+        int size = this->GetM();
+
+        assert(this->nnz_ > 0);
+        assert(size > 0);
+
+        if(this->var_coef_ == NULL)
+        {
+            allocate_host(static_cast<IndexType2>(this->nnz_) * size, &this->var_coef_);
+        }
+
+        _set_omp_backend_threads(this->local_backend_, size);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < size; ++i)
+        {
+            for(int k = 0; k < this->nnz_; ++k)
+            {
+                size_t idx            = static_cast<size_t>(k) * size + i;
+                this->var_coef_[idx] = coef[idx];
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    void HostStencilGeneral<ValueType>::clear_coefficients_(void)
+    {
+        if(this->var_coef_ != NULL)
+        {
+            free_host(&this->var_coef_);
+        }
+    }
+
+    template <typename ValueType>
+    void HostStencilGeneral<ValueType>::grid_(int* nx, int* ny, int* nz) const
+    {
+        *nx = this->dim_[0];
+        *ny = (this->ndim_ == 3) ? this->dim_[1] : 1;
+        *nz = (this->ndim_ == 3) ? this->dim_[2] : (this->ndim_ == 2) ? this->dim_[1] : 1;
+    }
+
+    template <typename ValueType>
+    void HostStencilGeneral<ValueType>::apply_line_(const ValueType* in,
+                                                    int              in_ring,
+                                                    ValueType        scalar,
+                                                    bool             add,
+                                                    int              y,
+                                                    int              z,
+                                                    int              x_begin,
+                                                    int              x_end,
+                                                    ValueType*       out,
+                                                    int              out_ring) const
+    {
+        int nx, ny, nz;
+        this->grid_(&nx, &ny, &nz);
+
+        size_t size = static_cast<size_t>(nx) * ny * nz;
+        int    zo   = (out_ring > 0) ? z % out_ring : z;
+
+        ValueType* out_line = out + (static_cast<size_t>(zo) * ny + y) * nx;
+
+        if(add == false)
+        {
+            for(int x = x_begin; x < x_end; ++x)
+            {
+                out_line[x] = static_cast<ValueType>(0);
+            }
+        }
+
+        for(int k = 0; k < this->nnz_; ++k)
+        {
+            int dx = this->offset_[3 * k];
+            int yy = y + this->offset_[3 * k + 1];
+            int zz = z + this->offset_[3 * k + 2];
+
+            // Neighbors outside of the grid are dropped
+            if(yy < 0 || yy >= ny || zz < 0 || zz >= nz)
+            {
+                continue;
+            }
+
+            int xb = std::max(x_begin, -dx);
+            int xe = std::min(x_end, nx - dx);
+
+            int zi = (in_ring > 0) ? zz % in_ring : zz;
+
+            const ValueType* in_line = in + (static_cast<size_t>(zi) * ny + yy) * nx + dx;
+
+            // Unit stride along x, vectorized
+            if(this->var_coef_ == NULL)
+            {
+                ValueType c = scalar * this->coef_[k];
+
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+                for(int x = xb; x < xe; ++x)
+                {
+                    out_line[x] += c * in_line[x];
+                }
+            }
+            else
+            {
+                const ValueType* c
+                    = this->var_coef_ + k * size + (static_cast<size_t>(z) * ny + y) * nx;
+
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+                for(int x = xb; x < xe; ++x)
+                {
+                    out_line[x] += scalar * c[x] * in_line[x];
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void HostStencilGeneral<ValueType>::apply_(const ValueType* in,
+                                               ValueType        scalar,
+                                               bool             add,
+                                               ValueType*       out) const
+    {
+        int nx, ny, nz;
+        this->grid_(&nx, &ny, &nz);
+
+        int ry = 0;
+        int rz = 0;
+
+        for(int k = 0; k < this->nnz_; ++k)
+        {
+            ry = std::max(ry, std::abs(this->offset_[3 * k + 1]));
+            rz = std::max(rz, std::abs(this->offset_[3 * k + 2]));
+        }
+
+        // Lines per y tile, such that the input lines a tile touches in all planes
+        // z - rz, ..., z + rz stay in cache while sweeping through z
+        size_t line_bytes = sizeof(ValueType) * nx * (2 * rz + 1);
+        int    tile       = static_cast<int>(stencil_tile_bytes / line_bytes) - 2 * ry;
+
+        tile = std::max(1, std::min(ny, tile));
+
+        int ntile = (ny + tile - 1) / tile;
+
+        // Split z into blocks, such that there are enough tiles for all threads
+        int nthreads = 1;
+#ifdef _OPENMP
+        nthreads = omp_get_max_threads();
+#endif
+
+        int nzblock = std::max(1, std::min(nz, (4 * nthreads + ntile - 1) / ntile));
+        int zblock  = (nz + nzblock - 1) / nzblock;
+
+        nzblock = (nz + zblock - 1) / zblock;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for(int b = 0; b < ntile * nzblock; ++b)
+        {
+            int y_begin = (b % ntile) * tile;
+            int y_end   = std::min(ny, y_begin + tile);
+            int z_begin = (b / ntile) * zblock;
+            int z_end   = std::min(nz, z_begin + zblock);
+
+            for(int z = z_begin; z < z_end; ++z)
+            {
+                for(int y = y_begin; y < y_end; ++y)
+                {
+                    this->apply_line_(in, 0, scalar, add, y, z, 0, nx, out, 0);
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void HostStencilGeneral<ValueType>::Apply(const BaseVector<ValueType>& in,
+                                              BaseVector<ValueType>*       out) const
+    {
+        int nrow = this->GetM();
+
+        if(nrow > 0)
+        {
+            assert(in.GetSize() == nrow);
+            assert(out->GetSize() == nrow);
+
+            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            _set_omp_backend_threads(this->local_backend_, nrow);
+
+            this->apply_(cast_in->vec_, static_cast<ValueType>(1), false, cast_out->vec_);
+        }
+    }
+
+    template <typename ValueType>
+    void HostStencilGeneral<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
+                                                 ValueType                    scalar,
+                                                 BaseVector<ValueType>*       out) const
+    {
+        int nrow = this->GetM();
+
+        if(nrow > 0)
+        {
+            assert(in.GetSize() == nrow);
+            assert(out->GetSize() == nrow);
+
+            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            _set_omp_backend_threads(this->local_backend_, nrow);
+
+            this->apply_(cast_in->vec_, scalar, true, cast_out->vec_);
+        }
+    }
+
+    template <typename ValueType>
+    bool HostStencilGeneral<ValueType>::ApplyPower(const BaseVector<ValueType>& in,
+                                                   int                          power,
+                                                   BaseVector<ValueType>*       out) const
+    {
+        assert(power >= 0);
+
+        int nrow = this->GetM();
+
+        if(nrow == 0)
+        {
+            return true;
+        }
+
+        assert(in.GetSize() == nrow);
+        assert(out->GetSize() == nrow);
+
+        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+
+        if(power == 0)
+        {
+            cast_out->CopyFrom(*cast_in);
+
+            return true;
+        }
+
+        if(power == 1)
+        {
+            this->Apply(in, out);
+
+            return true;
+        }
+
+        _set_omp_backend_threads(this->local_backend_, nrow);
+
+        int nx, ny, nz;
+        this->grid_(&nx, &ny, &nz);
+
+        int rz = 0;
+
+        for(int k = 0; k < this->nnz_; ++k)
+        {
+            rz = std::max(rz, std::abs(this->offset_[3 * k + 2]));
+        }
+
+        // Intermediate powers only keep the z planes that are still needed by the next
+        // power, in a ring buffer of 2 * rz + 2 planes each
+        int    ring  = std::min(nz, 2 * rz + 2);
+        size_t plane = static_cast<size_t>(nx) * ny;
+
+        ValueType* buffer = NULL;
+        allocate_host(static_cast<IndexType2>((power - 1) * ring * plane), &buffer);
+
+        // Split the lines of a plane into chunks, such that all threads get work
+        int nthreads = 1;
+#ifdef _OPENMP
+        nthreads = omp_get_max_threads();
+#endif
+
+        int nchunk = std::max(1, std::min(nx / stencil_min_chunk, (nthreads + ny - 1) / ny));
+        int chunk  = (nx + nchunk - 1) / nchunk;
+
+        // Wavefront over z, in step s power t computes its plane s - t * rz. All planes it
+        // depends on have been computed by power t - 1 in this or a previous step, while
+        // they are still in cache.
+        for(int s = 0; s < nz + (power - 1) * rz; ++s)
+        {
+            for(int t = 0; t < power; ++t)
+            {
+                int z = s - t * rz;
+
+                if(z < 0 || z >= nz)
+                {
+                    continue;
+                }
+
+                const ValueType* src
+                    = (t == 0) ? cast_in->vec_ : buffer + static_cast<size_t>(t - 1) * ring * plane;
+                ValueType* dst = (t == power - 1) ? cast_out->vec_
+                                                  : buffer + static_cast<size_t>(t) * ring * plane;
+
+                int src_ring = (t == 0) ? 0 : ring;
+                int dst_ring = (t == power - 1) ? 0 : ring;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+                for(int i = 0; i < ny * nchunk; ++i)
+                {
+                    int y       = i / nchunk;
+                    int x_begin = (i % nchunk) * chunk;
+                    int x_end   = std::min(nx, x_begin + chunk);
+
+                    this->apply_line_(src,
+                                      src_ring,
+                                      static_cast<ValueType>(1),
+                                      false,
+                                      y,
+                                      z,
+                                      x_begin,
+                                      x_end,
+                                      dst,
+                                      dst_ring);
+                }
+            }
+        }
+
+        free_host(&buffer);
+
+        return true;
+    }
+
+    template class HostStencilGeneral<double>;
+    template class HostStencilGeneral<float>;
+#ifdef SUPPORT_COMPLEX
+    template class HostStencilGeneral<std::complex<double>>;
+    template class HostStencilGeneral<std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,117 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_HOST_STENCIL_GENERAL_HPP_
+#define ROCALUTION_HOST_STENCIL_GENERAL_HPP_
+
+#include "../base_stencil.hpp"
+#include "../base_vector.hpp"
+#include "../stencil_types.hpp"
+
+#include <vector>
+
+namespace rocalution
+{
+
+    /// Host stencil with arbitrary offsets and constant or grid point dependent
+    /// coefficients on a structured 1D, 2D or 3D grid. The grid points are numbered
+    /// with x running fastest, i = (z * ny + y) * nx + x, neighbors outside of the grid
+    /// are dropped (homogeneous Dirichlet boundary).
+    template <typename ValueType>
+    class HostStencilGeneral : public HostStencil<ValueType>
+    {
+    public:
+        HostStencilGeneral();
+        /// Initialize with one of the predefined stencil types (see stencil_types.hpp)
+        HostStencilGeneral(const Rocalution_Backend_Descriptor local_backend, unsigned int type);
+        virtual ~HostStencilGeneral();
+
+        virtual int          GetNnz(void) const;
+        virtual void         Info(void) const;
+        virtual unsigned int GetStencilId(void) const
+        {
+            return this->type_;
+        }
+
+        virtual int GetM(void) const;
+        virtual int GetN(void) const;
+
+        virtual void SetGrid(int size);
+        virtual bool SetGrid(int nx, int ny, int nz);
+        virtual bool SetStencil(int ndim, int nnz, const int* offset, const ValueType* coef);
+        virtual bool SetVariableCoefficients(const ValueType* coef);
+
+        virtual void Apply(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
+        virtual void ApplyAdd(const BaseVector<ValueType>& in,
+                              ValueType                    scalar,
+                              BaseVector<ValueType>*       out) const;
+        virtual bool
+            ApplyPower(const BaseVector<ValueType>& in, int power, BaseVector<ValueType>* out) const;
+
+    private:
+        /// Internal grid sizes, 2D grids are stored as nx x 1 x ny and 1D grids as
+        /// nx x 1 x 1, such that the wavefront of ApplyPower() always runs along z
+        void grid_(int* nx, int* ny, int* nz) const;
+
+        /// out = scalar * this * in (+ out, if add is true) for the points
+        /// [x_begin, x_end) of the grid line (y, z). If in_ring (out_ring) is non-zero,
+        /// the input (output) vector is a ring buffer of in_ring (out_ring) z planes.
+        void apply_line_(const ValueType* in,
+                         int              in_ring,
+                         ValueType        scalar,
+                         bool             add,
+                         int              y,
+                         int              z,
+                         int              x_begin,
+                         int              x_end,
+                         ValueType*       out,
+                         int              out_ring) const;
+
+        /// Spatially blocked out = scalar * this * in (+ out, if add is true)
+        void apply_(const ValueType* in, ValueType scalar, bool add, ValueType* out) const;
+
+        /// Clear the grid point dependent coefficients
+        void clear_coefficients_(void);
+
+        unsigned int type_;
+
+        // Grid size per dimension, as set by the user
+        int dim_[3];
+
+        // Number of entries, their (x, y, z) offsets in the internal grid and their
+        // constant coefficients
+        int                    nnz_;
+        std::vector<int>       offset_;
+        std::vector<ValueType> coef_;
+
+        // Grid point dependent coefficients, var_coef_[k * GetM() + i], NULL if constant
+        ValueType* var_coef_;
+
+        friend class BaseVector<ValueType>;
+        friend class HostVector<ValueType>;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_HOST_STENCIL_GENERAL_HPP_
@@ -105,8 +105,6 @@ namespace rocalution
 
             _set_omp_backend_threads(this->local_backend_, nrow);
 
-            int idx = 0;
-
 // interior
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -114,7 +112,7 @@ namespace rocalution
             for(int i = 1; i < this->size_ - 1; ++i)
                 for(int j = 1; j < this->size_ - 1; ++j)
                 {
-                    idx = i * this->size_ + j;
+                    int idx = i * this->size_ + j;
 
                     cast_out->vec_[idx]
                         = static_cast<ValueType>(-1) * cast_in->vec_[idx - this->size_] // i-1
@@ -131,7 +129,7 @@ namespace rocalution
 #endif
             for(int j = 1; j < this->size_ - 1; ++j)
             {
-                idx = 0 * this->size_ + j;
+                int idx = 0 * this->size_ + j;
 
                 cast_out->vec_[idx]
                     = static_cast<ValueType>(-1) * cast_in->vec_[idx - 1]
@@ -152,7 +150,7 @@ namespace rocalution
 #endif
             for(int i = 1; i < this->size_ - 1; ++i)
             {
-                idx = i * this->size_ + 0;
+                int idx = i * this->size_ + 0;
 
                 cast_out->vec_[idx]
                     = static_cast<ValueType>(-1) * cast_in->vec_[idx - this->size_]
@@ -171,7 +169,7 @@ namespace rocalution
 
             // boundary points
 
-            idx                 = 0 * (this->size_) + 0;
+            int idx             = 0 * (this->size_) + 0;
             cast_out->vec_[idx] = static_cast<ValueType>(4) * cast_in->vec_[idx]
                                   + static_cast<ValueType>(-1) * cast_in->vec_[idx + 1]
                                   + static_cast<ValueType>(-1) * cast_in->vec_[idx + this->size_];
@@ -217,7 +215,8 @@ namespace rocalution
 
             _set_omp_backend_threads(this->local_backend_, nrow);
 
-            int idx = 0;
+            ValueType diag = static_cast<ValueType>(4) * scalar;
+            ValueType offd = static_cast<ValueType>(-1) * scalar;
 
 // interior
 #ifdef _OPENMP
@@ -226,14 +225,14 @@ namespace rocalution
             for(int i = 1; i < this->size_ - 1; ++i)
                 for(int j = 1; j < this->size_ - 1; ++j)
                 {
-                    idx = i * this->size_ + j;
+                    int idx = i * this->size_ + j;
 
                     cast_out->vec_[idx]
-                        += static_cast<ValueType>(-1) * cast_in->vec_[idx - this->size_] // i-1
-                           + static_cast<ValueType>(-1) * cast_in->vec_[idx - 1] // j-1
-                           + static_cast<ValueType>(4) * cast_in->vec_[idx] // i,j
-                           + static_cast<ValueType>(-1) * cast_in->vec_[idx + 1] // j+1
-                           + static_cast<ValueType>(-1) * cast_in->vec_[idx + this->size_]; // i+1
+                        += offd * cast_in->vec_[idx - this->size_] // i-1
+                           + offd * cast_in->vec_[idx - 1] // j-1
+                           + diag * cast_in->vec_[idx] // i,j
+                           + offd * cast_in->vec_[idx + 1] // j+1
+                           + offd * cast_in->vec_[idx + this->size_]; // i+1
                 }
 
                 // boundary layers
@@ -243,20 +242,20 @@ namespace rocalution
 #endif
             for(int j = 1; j < this->size_ - 1; ++j)
             {
-                idx = 0 * this->size_ + j;
+                int idx = 0 * this->size_ + j;
 
                 cast_out->vec_[idx]
-                    += static_cast<ValueType>(-1) * cast_in->vec_[idx - 1]
-                       + static_cast<ValueType>(4) * cast_in->vec_[idx]
-                       + static_cast<ValueType>(-1) * cast_in->vec_[idx + 1]
-                       + static_cast<ValueType>(-1) * cast_in->vec_[idx + this->size_];
+                    += offd * cast_in->vec_[idx - 1]
+                       + diag * cast_in->vec_[idx]
+                       + offd * cast_in->vec_[idx + 1]
+                       + offd * cast_in->vec_[idx + this->size_];
 
                 idx = (this->size_ - 1) * this->size_ + j;
 
-                cast_out->vec_[idx] += static_cast<ValueType>(-1) * cast_in->vec_[idx - this->size_]
-                                       + static_cast<ValueType>(-1) * cast_in->vec_[idx - 1]
-                                       + static_cast<ValueType>(4) * cast_in->vec_[idx]
-                                       + static_cast<ValueType>(-1) * cast_in->vec_[idx + 1];
+                cast_out->vec_[idx] += offd * cast_in->vec_[idx - this->size_]
+                                       + offd * cast_in->vec_[idx - 1]
+                                       + diag * cast_in->vec_[idx]
+                                       + offd * cast_in->vec_[idx + 1];
             }
 
 #ifdef _OPENMP
@@ -264,44 +263,44 @@ namespace rocalution
 #endif
             for(int i = 1; i < this->size_ - 1; ++i)
             {
-                idx = i * this->size_ + 0;
+                int idx = i * this->size_ + 0;
 
                 cast_out->vec_[idx]
-                    += static_cast<ValueType>(-1) * cast_in->vec_[idx - this->size_]
-                       + static_cast<ValueType>(4) * cast_in->vec_[idx]
-                       + static_cast<ValueType>(-1) * cast_in->vec_[idx + 1]
-                       + static_cast<ValueType>(-1) * cast_in->vec_[idx + this->size_];
+                    += offd * cast_in->vec_[idx - this->size_]
+                       + diag * cast_in->vec_[idx]
+                       + offd * cast_in->vec_[idx + 1]
+                       + offd * cast_in->vec_[idx + this->size_];
 
                 idx = i * this->size_ + this->size_ - 1;
 
                 cast_out->vec_[idx]
-                    += static_cast<ValueType>(-1) * cast_in->vec_[idx - this->size_]
-                       + static_cast<ValueType>(-1) * cast_in->vec_[idx - 1]
-                       + static_cast<ValueType>(4) * cast_in->vec_[idx]
-                       + static_cast<ValueType>(-1) * cast_in->vec_[idx + this->size_];
+                    += offd * cast_in->vec_[idx - this->size_]
+                       + offd * cast_in->vec_[idx - 1]
+                       + diag * cast_in->vec_[idx]
+                       + offd * cast_in->vec_[idx + this->size_];
             }
 
             // boundary points
 
-            idx = 0 * (this->size_) + 0;
-            cast_out->vec_[idx] += static_cast<ValueType>(4) * cast_in->vec_[idx]
-                                   + static_cast<ValueType>(-1) * cast_in->vec_[idx + 1]
-                                   + static_cast<ValueType>(-1) * cast_in->vec_[idx + this->size_];
+            int idx = 0 * (this->size_) + 0;
+            cast_out->vec_[idx] += diag * cast_in->vec_[idx]
+                                   + offd * cast_in->vec_[idx + 1]
+                                   + offd * cast_in->vec_[idx + this->size_];
 
             idx = 0 * (this->size_) + this->size_ - 1;
-            cast_out->vec_[idx] += static_cast<ValueType>(-1) * cast_in->vec_[idx - 1]
-                                   + static_cast<ValueType>(4) * cast_in->vec_[idx]
-                                   + static_cast<ValueType>(-1) * cast_in->vec_[idx + this->size_];
+            cast_out->vec_[idx] += offd * cast_in->vec_[idx - 1]
+                                   + diag * cast_in->vec_[idx]
+                                   + offd * cast_in->vec_[idx + this->size_];
 
             idx = (this->size_ - 1) * (this->size_) + 0;
-            cast_out->vec_[idx] += static_cast<ValueType>(-1) * cast_in->vec_[idx - this->size_]
-                                   + static_cast<ValueType>(4) * cast_in->vec_[idx]
-                                   + static_cast<ValueType>(-1) * cast_in->vec_[idx + 1];
+            cast_out->vec_[idx] += offd * cast_in->vec_[idx - this->size_]
+                                   + diag * cast_in->vec_[idx]
+                                   + offd * cast_in->vec_[idx + 1];
 
             idx = (this->size_ - 1) * (this->size_) + this->size_ - 1;
-            cast_out->vec_[idx] += static_cast<ValueType>(-1) * cast_in->vec_[idx - this->size_]
-                                   + static_cast<ValueType>(-1) * cast_in->vec_[idx - 1]
-                                   + static_cast<ValueType>(4) * cast_in->vec_[idx];
+            cast_out->vec_[idx] += offd * cast_in->vec_[idx - this->size_]
+                                   + offd * cast_in->vec_[idx - 1]
+                                   + diag * cast_in->vec_[idx];
         }
     }
 
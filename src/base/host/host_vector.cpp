@@ -27,9 +27,12 @@
 #include "../../utils/log.hpp"
 #include "../../utils/math_functions.hpp"
 #include "../base_vector.hpp"
+#include "host_io.hpp"
 #include "version.hpp"
 
+#include <algorithm>
 #include <complex>
+#include <cstdint>
 #include <fstream>
 #include <limits>
 #include <math.h>
@@ -49,6 +52,61 @@
 namespace rocalution
 {
 
+    // Number of random pairs that are generated at once
+    static const int random_block_size = 256;
+
+    // Philox4x32-10 counter-based random number generator, see
+    // Salmon et al., Parallel random numbers: as easy as 1, 2, 3 (SC11)
+    static inline void philox_round(
+        uint32_t& c0, uint32_t& c1, uint32_t& c2, uint32_t& c3, uint32_t k0, uint32_t k1)
+    {
+        uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+        uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+
+        c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+        c1 = static_cast<uint32_t>(p1);
+        c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+        c3 = static_cast<uint32_t>(p0);
+    }
+
+    // Fill u[0, 2n) with uniformly distributed values of [0,1) with 52 random bits each,
+    // u[2j] and u[2j + 1] are drawn from counter first + j. The loop is vectorized over
+    // the counters, the values are assembled from 32 bit integers for this purpose.
+    static void philox_uniform(unsigned long long seed, IndexType2 first, int n, double* u)
+    {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+        for(int j = 0; j < n; ++j)
+        {
+            uint64_t counter = static_cast<uint64_t>(first + j);
+
+            uint32_t c0 = static_cast<uint32_t>(counter);
+            uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+            uint32_t c2 = 0;
+            uint32_t c3 = 0;
+
+            uint32_t k0 = static_cast<uint32_t>(seed);
+            uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+
+            for(int r = 0; r < 10; ++r)
+            {
+                philox_round(c0, c1, c2, c3, k0, k1);
+
+                k0 += 0x9E3779B9u;
+                k1 += 0xBB67AE85u;
+            }
+
+            // 2^-21 and 2^-52
+            u[2 * j]
+                = static_cast<double>(static_cast<int>(c1 >> 11)) * (1.0 / 2097152.0)
+                  + static_cast<double>(static_cast<int>(c0 >> 1)) * (1.0 / 4503599627370496.0);
+            u[2 * j + 1]
+                = static_cast<double>(static_cast<int>(c3 >> 11)) * (1.0 / 2097152.0)
+                  + static_cast<double>(static_cast<int>(c2 >> 1)) * (1.0 / 4503599627370496.0);
+        }
+    }
+
     template <typename ValueType>
     HostVector<ValueType>::HostVector()
     {
@@ -400,37 +458,107 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void HostVector<ValueType>::SetRandomUniform(unsigned long long seed, ValueType a, ValueType b)
+    void HostVector<ValueType>::SetRandomUniform(unsigned long long seed,
+                                                 IndexType2         offset,
+                                                 ValueType          a,
+                                                 ValueType          b)
     {
         assert(a <= b);
+        assert(offset >= 0);
 
-        // Fill this with random data from interval [a,b]
-        srand(seed);
-        for(int i = 0; i < this->size_; ++i)
+        if(this->size_ > 0)
         {
-            this->vec_[i]
-                = a + static_cast<ValueType>(rand()) / static_cast<ValueType>(RAND_MAX) * (b - a);
+            // Entry i is drawn from the global stream position offset + i, thus the
+            // values do not depend on the number of threads
+            IndexType2 first  = offset / 2;
+            IndexType2 npairs = (offset + this->size_ - 1) / 2 - first + 1;
+            int        nblock = static_cast<int>((npairs - 1) / random_block_size + 1);
+
+            _set_omp_backend_threads(this->local_backend_, this->size_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int blk = 0; blk < nblock; ++blk)
+            {
+                double u[2 * random_block_size];
+
+                IndexType2 start = first + static_cast<IndexType2>(blk) * random_block_size;
+                int        n     = static_cast<int>(
+                    std::min(static_cast<IndexType2>(random_block_size), first + npairs - start));
+
+                philox_uniform(seed, start, n, u);
+
+                // Position of u[0] in this vector
+                IndexType2 pos = 2 * start - offset;
+
+                int jb = static_cast<int>(std::max(static_cast<IndexType2>(0), -pos));
+                int je = static_cast<int>(
+                    std::min(static_cast<IndexType2>(2 * n), this->size_ - pos));
+
+                for(int j = jb; j < je; ++j)
+                {
+                    this->vec_[pos + j] = a + static_cast<ValueType>(u[j]) * (b - a);
+                }
+            }
         }
     }
 
     template <typename ValueType>
     void HostVector<ValueType>::SetRandomNormal(unsigned long long seed,
+                                                IndexType2         offset,
                                                 ValueType          mean,
                                                 ValueType          var)
     {
-        // Fill this with random data from interval [a,b]
-        srand(seed);
-        for(int i = 0; i < this->size_; ++i)
+        assert(offset >= 0);
+
+        if(this->size_ > 0)
         {
-            // Box-Muller
-            ValueType u1 = static_cast<ValueType>(rand()) / static_cast<ValueType>(RAND_MAX);
-            ValueType u2 = static_cast<ValueType>(rand()) / static_cast<ValueType>(RAND_MAX);
+            // Entry i is drawn from the global stream position offset + i, thus the
+            // values do not depend on the number of threads
+            IndexType2 first  = offset / 2;
+            IndexType2 npairs = (offset + this->size_ - 1) / 2 - first + 1;
+            int        nblock = static_cast<int>((npairs - 1) / random_block_size + 1);
+
+            _set_omp_backend_threads(this->local_backend_, this->size_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int blk = 0; blk < nblock; ++blk)
+            {
+                double u[2 * random_block_size];
+
+                IndexType2 start = first + static_cast<IndexType2>(blk) * random_block_size;
+                int        n     = static_cast<int>(
+                    std::min(static_cast<IndexType2>(random_block_size), first + npairs - start));
 
-            this->vec_[i] = sqrt(static_cast<ValueType>(-2) * log(u1))
-                            * cos(static_cast<ValueType>(2 * M_PI) * u2);
+                philox_uniform(seed, start, n, u);
 
-            // Shift
-            this->vec_[i] = mean + var * this->vec_[i];
+                // Box-Muller, each pair of uniform values gives a pair of independent
+                // normally distributed values
+                for(int j = 0; j < n; ++j)
+                {
+                    double r   = sqrt(-2.0 * log(1.0 - u[2 * j]));
+                    double phi = 2.0 * M_PI * u[2 * j + 1];
+
+                    u[2 * j]     = r * cos(phi);
+                    u[2 * j + 1] = r * sin(phi);
+                }
+
+                // Position of u[0] in this vector
+                IndexType2 pos = 2 * start - offset;
+
+                int jb = static_cast<int>(std::max(static_cast<IndexType2>(0), -pos));
+                int je = static_cast<int>(
+                    std::min(static_cast<IndexType2>(2 * n), this->size_ - pos));
+
+                // Shift
+                for(int j = jb; j < je; ++j)
+                {
+                    this->vec_[pos + j] = mean + var * static_cast<ValueType>(u[j]);
+                }
+            }
         }
     }
 
@@ -507,78 +635,22 @@ namespace rocalution
     {
         LOG_INFO("ReadFileBinary: filename=" << filename << "; reading...");
 
-        std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
-
-        if(!in.is_open())
-        {
-            LOG_INFO("ReadFileBinary: filename=" << filename << "; cannot open file");
-            FATAL_ERROR(__FILE__, __LINE__);
-        }
-
-        // Header
-        std::string header;
-        std::getline(in, header);
+        int        size;
+        ValueType* val = NULL;
 
-        if(header != "#rocALUTION binary vector file")
+        if(read_vector_binary(size, &val, filename.c_str()) != true)
         {
-            LOG_INFO("ReadFileBinary: filename=" << filename << " is not a rocALUTION vector");
+            LOG_INFO("ReadFileBinary: filename=" << filename << "; could not read from file");
             FATAL_ERROR(__FILE__, __LINE__);
         }
 
-        // rocALUTION version
-        int version;
-        in.read((char*)&version, sizeof(int));
-
-        /* TODO might need this in the future
-      if(version != __ROCALUTION_VER)
-      {
-          LOG_INFO("ReadFileBinary: filename=" << filename << "; file version mismatch");
-          FATAL_ERROR(__FILE__, __LINE__);
-      }
-    */
-
         this->Clear();
 
-        int n;
-        in.read((char*)&n, sizeof(int));
-
-        this->Allocate(n);
-
-        // We read always in double precision
-        if(typeid(ValueType) == typeid(double))
-        {
-            in.read((char*)this->vec_, sizeof(ValueType) * n);
-        }
-        else if(typeid(ValueType) == typeid(float))
-        {
-            std::vector<double> tmp(n);
-
-            in.read((char*)tmp.data(), sizeof(double) * n);
-
-            for(int i = 0; i < n; ++i)
-            {
-                this->vec_[i] = static_cast<ValueType>(tmp[i]);
-            }
-        }
-        else if(typeid(ValueType) == typeid(int))
-        {
-            in.read((char*)this->vec_, sizeof(ValueType) * n);
-        }
-        else
-        {
-            LOG_INFO("ReadFileBinary: filename=" << filename << "; internal error");
-            FATAL_ERROR(__FILE__, __LINE__);
-        }
-
-        // Check ifstream status
-        if(!in)
+        if(size > 0)
         {
-            LOG_INFO("ReadFileBinary: filename=" << filename << "; could not read from file");
-            FATAL_ERROR(__FILE__, __LINE__);
+            this->SetDataPtr(&val, size);
         }
 
-        in.close();
-
         LOG_INFO("ReadFileBinary: filename=" << filename << "; done");
     }
 
@@ -587,59 +659,12 @@ namespace rocalution
     {
         LOG_INFO("WriteFileBinary: filename=" << filename << "; writing...");
 
-        std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
-
-        if(!out.is_open())
-        {
-            LOG_INFO("WriteFileBinary: filename=" << filename << "; cannot open file");
-            FATAL_ERROR(__FILE__, __LINE__);
-        }
-
-        // Header
-        out << "#rocALUTION binary vector file" << std::endl;
-
-        // rocALUTION version
-        int version = __ROCALUTION_VER;
-        out.write((char*)&version, sizeof(int));
-
-        // Data
-        out.write((char*)&this->size_, sizeof(int));
-
-        // We write always in double precision
-        if(typeid(ValueType) == typeid(double))
-        {
-            out.write((char*)this->vec_, sizeof(ValueType) * this->size_);
-        }
-        else if(typeid(ValueType) == typeid(float))
-        {
-            std::vector<double> tmp(this->size_);
-
-            for(int i = 0; i < this->size_; ++i)
-            {
-                tmp[i] = rocalution_double(this->vec_[i]);
-            }
-
-            out.write((char*)tmp.data(), sizeof(double) * this->size_);
-        }
-        else if(typeid(ValueType) == typeid(int))
-        {
-            out.write((char*)this->vec_, sizeof(ValueType) * this->size_);
-        }
-        else // TODO complex
-        {
-            LOG_INFO("WriteFileBinary: filename=" << filename << "; internal error");
-            FATAL_ERROR(__FILE__, __LINE__);
-        }
-
-        // Check ofstream status
-        if(!out)
+        if(write_vector_binary(this->size_, this->vec_, filename.c_str()) != true)
         {
-            LOG_INFO("ReadFileBinary: filename=" << filename << "; could not write to file");
+            LOG_INFO("WriteFileBinary: filename=" << filename << "; could not write to file");
             FATAL_ERROR(__FILE__, __LINE__);
         }
 
-        out.close();
-
         LOG_INFO("WriteFileBinary: filename=" << filename << "; done");
     }
 
@@ -1375,6 +1400,11 @@ namespace rocalution
     {
         assert(values != NULL);
 
+        _set_omp_backend_threads(this->local_backend_, this->index_size_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
         for(int i = 0; i < this->index_size_; ++i)
         {
             values[i] = this->vec_[this->index_array_[i]];
@@ -1386,6 +1416,11 @@ namespace rocalution
     {
         assert(values != NULL);
 
+        _set_omp_backend_threads(this->local_backend_, this->index_size_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
         for(int i = 0; i < this->index_size_; ++i)
         {
             this->vec_[this->index_array_[i]] = values[i];
@@ -1400,9 +1435,14 @@ namespace rocalution
         assert(end <= this->GetSize());
         assert(values != NULL);
 
-        for(int i = start, j = 0; i < end; ++i, ++j)
+        _set_omp_backend_threads(this->local_backend_, end - start);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = start; i < end; ++i)
         {
-            values[j] = this->vec_[i];
+            values[i - start] = this->vec_[i];
         }
     }
 
@@ -1414,9 +1454,14 @@ namespace rocalution
         assert(end <= this->GetSize());
         assert(values != NULL);
 
-        for(int i = start, j = 0; i < end; ++i, ++j)
+        _set_omp_backend_threads(this->local_backend_, end - start);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = start; i < end; ++i)
         {
-            this->vec_[i] = values[j];
+            this->vec_[i] = values[i - start];
         }
     }
 
@@ -27,6 +27,7 @@
 #include "../base_matrix.hpp"
 #include "../base_stencil.hpp"
 #include "../base_vector.hpp"
+#include "../../utils/types.hpp"
 
 #include <complex>
 
@@ -54,8 +55,14 @@ namespace rocalution
         virtual void Zeros(void);
         virtual void Ones(void);
         virtual void SetValues(ValueType val);
-        virtual void SetRandomUniform(unsigned long long seed, ValueType a, ValueType b);
-        virtual void SetRandomNormal(unsigned long long seed, ValueType mean, ValueType var);
+        virtual void SetRandomUniform(unsigned long long seed,
+                                      IndexType2         offset,
+                                      ValueType          a,
+                                      ValueType          b);
+        virtual void SetRandomNormal(unsigned long long seed,
+                                     IndexType2         offset,
+                                     ValueType          mean,
+                                     ValueType          var);
 
         virtual void CopyFrom(const BaseVector<ValueType>& vec);
         virtual void CopyFromFloat(const BaseVector<float>& vec);
@@ -158,6 +165,8 @@ namespace rocalution
 
         friend class HostMatrix<ValueType>;
         friend class HostMatrixCSR<ValueType>;
+        friend class HostMatrixCSRBase<ValueType, int>;
+        friend class HostMatrixCSRBase<ValueType, IndexType2>;
         friend class HostMatrixCOO<ValueType>;
         friend class HostMatrixDIA<ValueType>;
         friend class HostMatrixELL<ValueType>;
@@ -183,6 +192,7 @@ namespace rocalution
 
         friend class HostStencil<ValueType>;
         friend class HostStencilLaplace2D<ValueType>;
+        friend class HostStencilGeneral<ValueType>;
     };
 
 } // namespace rocalution
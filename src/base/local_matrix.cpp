@@ -26,18 +26,25 @@
 #include "../utils/def.hpp"
 #include "../utils/log.hpp"
 #include "../utils/math_functions.hpp"
+#include "../utils/time_functions.hpp"
 #include "backend_manager.hpp"
 #include "base_matrix.hpp"
 #include "base_vector.hpp"
 #include "host/host_matrix_coo.hpp"
+#include "host/host_io.hpp"
 #include "host/host_matrix_csr.hpp"
 #include "host/host_vector.hpp"
 #include "local_vector.hpp"
 
 #include <algorithm>
 #include <complex>
+#include <limits>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <string.h>
+#include <tuple>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -85,7 +92,7 @@ namespace rocalution
     template <typename ValueType>
     IndexType2 LocalMatrix<ValueType>::GetNnz(void) const
     {
-        return static_cast<IndexType2>(this->matrix_->GetNnz());
+        return this->matrix_->GetNnz();
     }
 
     template <typename ValueType>
@@ -99,9 +106,43 @@ namespace rocalution
     {
         log_debug(this, "LocalMatrix::Clear()", "");
 
+        // Matrices with 64 bit row offsets are replaced by a compact matrix
+        if(this->GetNnz() > std::numeric_limits<int>::max())
+        {
+            this->init_host_matrix_(0);
+            return;
+        }
+
         this->matrix_->Clear();
     }
 
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::init_host_matrix_(IndexType2 nnz)
+    {
+        unsigned int format = this->GetFormat();
+
+        if(this->is_accel_() == true)
+        {
+            if(nnz > std::numeric_limits<int>::max())
+            {
+                LOG_VERBOSE_INFO(2,
+                                 "*** warning: LocalMatrix exceeds 32 bit indexing and is kept "
+                                 "on the host");
+            }
+
+            delete this->matrix_accel_;
+            this->matrix_accel_ = NULL;
+        }
+        else
+        {
+            delete this->matrix_host_;
+        }
+
+        this->matrix_host_
+            = _rocalution_init_base_host_matrix<ValueType>(this->local_backend_, format, nnz);
+        this->matrix_ = this->matrix_host_;
+    }
+
     template <typename ValueType>
     void LocalMatrix<ValueType>::Zeros(void)
     {
@@ -159,7 +200,10 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::AllocateCSR(const std::string name, int nnz, int nrow, int ncol)
+    void LocalMatrix<ValueType>::AllocateCSR(const std::string name,
+                                             IndexType2        nnz,
+                                             int               nrow,
+                                             int               ncol)
     {
         log_debug(this, "LocalMatrix::AllocateCSR()", name, nnz, nrow, ncol);
 
@@ -179,8 +223,13 @@ namespace rocalution
             Rocalution_Backend_Descriptor backend = this->local_backend_;
             unsigned int                  mat     = this->GetFormat();
 
+            // Matrices with 64 bit row offsets are kept on the host
+            if(nnz > std::numeric_limits<int>::max())
+            {
+                this->init_host_matrix_(nnz);
+            }
             // init host matrix
-            if(this->matrix_ == this->matrix_host_)
+            else if(this->matrix_ == this->matrix_host_)
             {
                 delete this->matrix_host_;
                 this->matrix_host_ = _rocalution_init_base_host_matrix<ValueType>(backend, mat);
@@ -205,7 +254,10 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::AllocateCOO(const std::string name, int nnz, int nrow, int ncol)
+    void LocalMatrix<ValueType>::AllocateCOO(const std::string name,
+                                             IndexType2        nnz,
+                                             int               nrow,
+                                             int               ncol)
     {
         log_debug(this, "LocalMatrix::AllocateCOO()", name, nnz, nrow, ncol);
 
@@ -225,8 +277,13 @@ namespace rocalution
             Rocalution_Backend_Descriptor backend = this->local_backend_;
             unsigned int                  mat     = this->GetFormat();
 
+            // Matrices with 64 bit row offsets are kept on the host
+            if(nnz > std::numeric_limits<int>::max())
+            {
+                this->init_host_matrix_(nnz);
+            }
             // init host matrix
-            if(this->matrix_ == this->matrix_host_)
+            else if(this->matrix_ == this->matrix_host_)
             {
                 delete this->matrix_host_;
                 this->matrix_host_ = _rocalution_init_base_host_matrix<ValueType>(backend, mat);
@@ -531,8 +588,13 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::SetDataPtrCOO(
-        int** row, int** col, ValueType** val, std::string name, int nnz, int nrow, int ncol)
+    void LocalMatrix<ValueType>::SetDataPtrCOO(int**       row,
+                                               int**       col,
+                                               ValueType** val,
+                                               std::string name,
+                                               IndexType2  nnz,
+                                               int         nrow,
+                                               int         ncol)
     {
         log_debug(this, "LocalMatrix::SetDataPtrCOO()", row, col, val, name, nnz, nrow, ncol);
 
@@ -553,6 +615,19 @@ namespace rocalution
         //  this->MoveToHost();
         this->ConvertToCOO();
 
+        if(nnz > std::numeric_limits<int>::max())
+        {
+            // Accelerator matrices are limited to 32 bit indexing
+            if(this->is_accel_() == true)
+            {
+                LOG_INFO("LocalMatrix::SetDataPtrCOO() exceeds 32 bit indexing on the accelerator");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            this->init_host_matrix_(nnz);
+        }
+
         this->matrix_->SetDataPtrCOO(row, col, val, nnz, nrow, ncol);
 
         *row = NULL;
@@ -643,6 +718,136 @@ namespace rocalution
         this->matrix_->LeaveDataPtrCSR(row_offset, col, val);
     }
 
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::SetDataPtrCSR(IndexType2** row_offset,
+                                               int**        col,
+                                               ValueType**  val,
+                                               std::string  name,
+                                               IndexType2   nnz,
+                                               int          nrow,
+                                               int          ncol)
+    {
+        log_debug(
+            this, "LocalMatrix::SetDataPtrCSR()", row_offset, col, val, name, nnz, nrow, ncol);
+
+        assert(row_offset != NULL);
+        assert(col != NULL);
+        assert(val != NULL);
+        assert(*row_offset != NULL);
+        assert(*col != NULL);
+        assert(*val != NULL);
+        assert(nnz > 0);
+        assert(nrow > 0);
+        assert(ncol > 0);
+
+        this->Clear();
+
+        this->object_name_ = name;
+
+        // The data is set on the host
+        bool is_accel = this->is_accel_();
+        this->MoveToHost();
+        this->ConvertToCSR();
+
+        if(nnz > std::numeric_limits<int>::max())
+        {
+            this->init_host_matrix_(nnz);
+            this->matrix_->SetDataPtrCSR64(row_offset, col, val, nnz, nrow, ncol);
+        }
+        else
+        {
+            // Compact 32 bit row offsets
+            int* offset = NULL;
+            allocate_host(nrow + 1, &offset);
+
+            _set_omp_backend_threads(this->local_backend_, nrow);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < nrow + 1; ++i)
+            {
+                offset[i] = static_cast<int>((*row_offset)[i]);
+            }
+
+            free_host(row_offset);
+
+            this->matrix_->SetDataPtrCSR(&offset, col, val, static_cast<int>(nnz), nrow, ncol);
+        }
+
+        *row_offset = NULL;
+        *col        = NULL;
+        *val        = NULL;
+
+        if(is_accel == true)
+        {
+            this->MoveToAccelerator();
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::LeaveDataPtrCSR(IndexType2** row_offset,
+                                                 int**        col,
+                                                 ValueType**  val)
+    {
+        log_debug(this, "LocalMatrix::LeaveDataPtrCSR()", row_offset, col, val);
+
+        assert(*row_offset == NULL);
+        assert(*col == NULL);
+        assert(*val == NULL);
+        assert(this->GetM() > 0);
+        assert(this->GetN() > 0);
+        assert(this->GetNnz() > 0);
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        // The data is left on the host
+        bool is_accel = this->is_accel_();
+        this->MoveToHost();
+        this->ConvertToCSR();
+
+        if(this->GetNnz() > std::numeric_limits<int>::max())
+        {
+            this->matrix_->LeaveDataPtrCSR64(row_offset, col, val);
+
+            // Empty matrices are compact
+            this->init_host_matrix_(0);
+        }
+        else
+        {
+            int nrow = this->GetLocalM();
+
+            int* offset = NULL;
+            this->matrix_->LeaveDataPtrCSR(&offset, col, val);
+
+            // Widen the row offsets
+            allocate_host(nrow + 1, row_offset);
+
+            _set_omp_backend_threads(this->local_backend_, nrow);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < nrow + 1; ++i)
+            {
+                (*row_offset)[i] = offset[i];
+            }
+
+            free_host(&offset);
+        }
+
+        if(is_accel == true)
+        {
+            this->MoveToAccelerator();
+        }
+    }
+
     template <typename ValueType>
     void LocalMatrix<ValueType>::SetDataPtrMCSR(
         int** row_offset, int** col, ValueType** val, std::string name, int nnz, int nrow, int ncol)
@@ -1108,6 +1313,31 @@ namespace rocalution
 
         this->Clear();
 
+        // Matrices with more non-zero entries than int can address are read with 64 bit
+        // row offsets on the host
+        IndexType2 nnz = 0;
+
+        if(read_matrix_csr_nnz(nnz, filename.c_str()) == true
+           && nnz > std::numeric_limits<int>::max())
+        {
+            unsigned int format = this->GetFormat();
+
+            this->ConvertToCSR();
+            this->init_host_matrix_(nnz);
+
+            if(this->matrix_->ReadFileCSR(filename) == false)
+            {
+                LOG_INFO("Execution of LocalMatrix::ReadFileCSR() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            this->ConvertTo(format);
+            this->object_name_ = filename;
+
+            return;
+        }
+
         bool err = this->matrix_->ReadFileCSR(filename);
 
         if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
@@ -1144,6 +1374,96 @@ namespace rocalution
 
         this->object_name_ = filename;
 
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ReadFileCSR(const std::string filename, int row_begin, int row_end)
+    {
+        log_debug(this, "LocalMatrix::ReadFileCSR()", filename, row_begin, row_end);
+
+        int        nrow       = 0;
+        int        ncol       = 0;
+        int        nnz        = 0;
+        int*       row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
+
+        if(read_matrix_csr_rows(
+               row_begin, row_end, nrow, ncol, nnz, &row_offset, &col, &val, filename.c_str())
+           == false)
+        {
+            LOG_INFO("Execution of LocalMatrix::ReadFileCSR() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        // The rows are read on the host in CSR format
+        bool         is_accel = this->is_accel_();
+        unsigned int format   = this->GetFormat();
+
+        this->Clear();
+        this->MoveToHost();
+
+        if(nnz > 0)
+        {
+            this->SetDataPtrCSR(&row_offset, &col, &val, filename, nnz, nrow, ncol);
+        }
+        else
+        {
+            this->AllocateCSR(filename, 0, nrow, ncol);
+        }
+
+        if(is_accel == true)
+        {
+            this->MoveToAccelerator();
+        }
+
+        this->ConvertTo(format);
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::MapFileCSR(const std::string filename)
+    {
+        log_debug(this, "LocalMatrix::MapFileCSR()", filename);
+
+        this->Clear();
+
+        // Matrices with more non-zero entries than int can address are mapped with 64 bit
+        // row offsets on the host
+        IndexType2 nnz = 0;
+
+        if(read_matrix_csr_nnz(nnz, filename.c_str()) == true
+           && nnz > std::numeric_limits<int>::max())
+        {
+            this->ConvertToCSR();
+            this->init_host_matrix_(nnz);
+        }
+
+        bool err = this->matrix_->MapFileCSR(filename);
+
+        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+        {
+            LOG_INFO("Execution of LocalMatrix::MapFileCSR() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            // Mapping is only supported by host CSR matrices
+            LOG_VERBOSE_INFO(
+                2, "*** warning: LocalMatrix::MapFileCSR() falls back to LocalMatrix::ReadFileCSR()");
+
+            this->ReadFileCSR(filename);
+
+            return;
+        }
+
+        this->object_name_ = filename;
+
 #ifdef DEBUG_MODE
         this->Check();
 #endif
@@ -1186,6 +1506,20 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ConvertFileCSR(const std::string input, const std::string output)
+    {
+        log_debug(0, "LocalMatrix::ConvertFileCSR()", input, output);
+
+        assert(input != output);
+
+        if(convert_matrix_csr<ValueType>(input.c_str(), output.c_str()) == false)
+        {
+            LOG_INFO("Execution of LocalMatrix::ConvertFileCSR() failed");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+    }
+
     template <typename ValueType>
     void LocalMatrix<ValueType>::CopyFrom(const LocalMatrix<ValueType>& src)
     {
@@ -1193,6 +1527,12 @@ namespace rocalution
 
         assert(this != &src);
 
+        // Matrices with 64 bit row offsets are copied on the host
+        if(src.GetNnz() > std::numeric_limits<int>::max() && this->GetNnz() == 0)
+        {
+            this->init_host_matrix_(src.GetNnz());
+        }
+
         this->matrix_->CopyFrom(*src.matrix_);
     }
 
@@ -1204,6 +1544,12 @@ namespace rocalution
         assert(this->asyncf_ == false);
         assert(this != &src);
 
+        // Matrices with 64 bit row offsets are copied on the host
+        if(src.GetNnz() > std::numeric_limits<int>::max() && this->GetNnz() == 0)
+        {
+            this->init_host_matrix_(src.GetNnz());
+        }
+
         this->matrix_->CopyFromAsync(*src.matrix_);
 
         this->asyncf_ = true;
@@ -1241,8 +1587,8 @@ namespace rocalution
         if(src.matrix_ == src.matrix_host_)
         {
             // host
-            this->matrix_host_
-                = _rocalution_init_base_host_matrix<ValueType>(backend, src.GetFormat());
+            this->matrix_host_ = _rocalution_init_base_host_matrix<ValueType>(
+                backend, src.GetFormat(), src.GetNnz());
             this->matrix_ = this->matrix_host_;
         }
         else
@@ -1367,6 +1713,15 @@ namespace rocalution
                              "- doing nothing");
         }
 
+        // Matrices with 64 bit row offsets are kept on the host
+        if(this->GetNnz() > std::numeric_limits<int>::max())
+        {
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: LocalMatrix::MoveToAccelerator() matrix exceeds 32 bit "
+                             "indexing and is kept on the host");
+            return;
+        }
+
         if((_rocalution_available_accelerator()) && (this->matrix_ == this->matrix_host_))
         {
             this->matrix_accel_ = _rocalution_init_base_backend_matrix<ValueType>(
@@ -1425,6 +1780,15 @@ namespace rocalution
                              "available - doing nothing");
         }
 
+        // Matrices with 64 bit row offsets are kept on the host
+        if(this->GetNnz() > std::numeric_limits<int>::max())
+        {
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: LocalMatrix::MoveToAcceleratorAsync() matrix exceeds "
+                             "32 bit indexing and is kept on the host");
+            return;
+        }
+
         if((_rocalution_available_accelerator()) && (this->matrix_ == this->matrix_host_))
         {
             this->matrix_accel_ = _rocalution_init_base_backend_matrix<ValueType>(
@@ -1568,6 +1932,12 @@ namespace rocalution
     {
         log_debug(this, "LocalMatrix::ConvertTo()", matrix_format);
 
+        if(matrix_format == AUTO)
+        {
+            this->ConvertToBest();
+            return;
+        }
+
         assert((matrix_format == DENSE) || (matrix_format == CSR) || (matrix_format == MCSR)
                || (matrix_format == BCSR) || (matrix_format == COO) || (matrix_format == DIA)
                || (matrix_format == ELL) || (matrix_format == HYB));
@@ -1576,6 +1946,18 @@ namespace rocalution
                          "Converting " << _matrix_format_names[matrix_format] << " <- "
                                        << _matrix_format_names[this->GetFormat()]);
 
+        // Matrices with 64 bit row offsets are only supported in CSR and COO format
+        if(this->GetNnz() > std::numeric_limits<int>::max() && matrix_format != CSR
+           && matrix_format != COO)
+        {
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: Matrix conversion to "
+                                 << _matrix_format_names[matrix_format]
+                                 << " exceeds 32 bit indexing, keeping "
+                                 << _matrix_format_names[this->GetFormat()] << " format");
+            return;
+        }
+
         if(this->GetFormat() != matrix_format)
         {
             if((this->GetFormat() != CSR) && (matrix_format != CSR))
@@ -1589,8 +1971,8 @@ namespace rocalution
                 assert(this->matrix_host_ != NULL);
 
                 HostMatrix<ValueType>* new_mat;
-                new_mat = _rocalution_init_base_host_matrix<ValueType>(this->local_backend_,
-                                                                       matrix_format);
+                new_mat = _rocalution_init_base_host_matrix<ValueType>(
+                    this->local_backend_, matrix_format, this->GetNnz());
                 assert(new_mat != NULL);
 
                 // If conversion fails, try CSR before we give up
@@ -1601,8 +1983,8 @@ namespace rocalution
                                          << _matrix_format_names[matrix_format]
                                          << " failed, falling back to CSR format");
                     delete new_mat;
-                    new_mat
-                        = _rocalution_init_base_host_matrix<ValueType>(this->local_backend_, CSR);
+                    new_mat = _rocalution_init_base_host_matrix<ValueType>(
+                        this->local_backend_, CSR, this->GetNnz());
                     assert(new_mat != NULL);
 
                     // If CSR conversion fails too, exit with error
@@ -1654,57 +2036,243 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::Apply(const LocalVector<ValueType>& in,
-                                       LocalVector<ValueType>*       out) const
+    void LocalMatrix<ValueType>::ConvertToBest(bool trial)
     {
-        log_debug(this, "LocalMatrix::Apply()", (const void*&)in, out);
-
-        assert(out != NULL);
+        log_debug(this, "LocalMatrix::ConvertToBest()", trial);
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
 
-        if(this->GetNnz() > 0)
+        if(this->GetNnz() == 0)
         {
-            assert(in.GetSize() == this->GetN());
-            assert(out->GetSize() == this->GetM());
-
-            assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
-                    && (out->vector_ == out->vector_host_))
-                   || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
-                       && (out->vector_ == out->vector_accel_)));
+            return;
+        }
 
-            this->matrix_->Apply(*in.vector_, out->vector_);
+        // Matrices with 64 bit row offsets are kept in CSR format
+        if(this->GetNnz() > std::numeric_limits<int>::max())
+        {
+            this->ConvertToCSR();
+            return;
         }
+
+        // Formats are selected on the CSR structure
+        this->ConvertToCSR();
+        this->ConvertTo(this->select_format_(this->is_accel_(), trial, NULL));
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ApplyAdd(const LocalVector<ValueType>& in,
-                                          ValueType                     scalar,
-                                          LocalVector<ValueType>*       out) const
+    unsigned int LocalMatrix<ValueType>::SelectFormat(bool accel, bool* cached) const
     {
-        log_debug(this, "LocalMatrix::ApplyAdd()", (const void*&)in, scalar, out);
-
-        assert(out != NULL);
+        log_debug(this, "LocalMatrix::SelectFormat()", accel, cached);
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
 
-        if(this->GetNnz() > 0)
+        if(cached != NULL)
         {
-            assert(in.GetSize() == this->GetN());
-            assert(out->GetSize() == this->GetM());
-
-            assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
-                    && (out->vector_ == out->vector_host_))
-                   || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
-                       && (out->vector_ == out->vector_accel_)));
-
-            this->matrix_->ApplyAdd(*in.vector_, scalar, out->vector_);
+            *cached = false;
         }
-    }
+
+        // Matrices with 64 bit row offsets are kept in CSR format
+        if(this->GetNnz() == 0 || this->GetNnz() > std::numeric_limits<int>::max())
+        {
+            return CSR;
+        }
+
+        return this->select_format_(accel, false, cached);
+    }
+
+    template <typename ValueType>
+    unsigned int LocalMatrix<ValueType>::select_format_(bool accel, bool trial, bool* cached) const
+    {
+        // Previously selected formats, identified by the keys of the sparsity pattern and
+        // the backend; the flag marks selections that have been confirmed by trial runs.
+        // Matrices can be converted by concurrent host tasks, see TaskGraph
+        typedef std::tuple<long int, long int, IndexType2, IndexType2, IndexType2, bool>
+                                                                   format_key;
+        static std::map<format_key, std::pair<unsigned int, bool>> format_cache;
+        static std::mutex                                          format_cache_mutex;
+
+        long int row_key;
+        long int col_key;
+        long int val_key;
+
+        this->Key(row_key, col_key, val_key);
+
+        format_key key(row_key, col_key, this->GetM(), this->GetN(), this->GetNnz(), accel);
+
+        unsigned int mat_format = CSR;
+        bool         found      = false;
+
+        {
+            std::lock_guard<std::mutex> lock(format_cache_mutex);
+
+            typename std::map<format_key, std::pair<unsigned int, bool>>::const_iterator it
+                = format_cache.find(key);
+
+            if(it != format_cache.end() && (trial == false || it->second.second == true))
+            {
+                mat_format = it->second.first;
+                found      = true;
+            }
+        }
+
+        if(cached != NULL)
+        {
+            *cached = found;
+        }
+
+        if(found == true)
+        {
+            LOG_VERBOSE_INFO(4,
+                             "*** info: LocalMatrix::ConvertToBest() cached format "
+                                 << _matrix_format_names[mat_format]);
+
+            return mat_format;
+        }
+
+        // Feature analysis of the sparsity pattern, which is performed on the CSR structure
+        if(this->GetFormat() != CSR || this->matrix_->SelectFormat(accel, mat_format) == false)
+        {
+            LocalMatrix<ValueType> mat_host;
+            mat_host.ConvertTo(this->GetFormat());
+            mat_host.CopyFrom(*this);
+            mat_host.ConvertToCSR();
+
+            if(mat_host.matrix_->SelectFormat(accel, mat_format) == false)
+            {
+                LOG_INFO("Computation of LocalMatrix::ConvertToBest() failed");
+                mat_host.Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(this->is_accel_() == true)
+            {
+                LOG_VERBOSE_INFO(
+                    2,
+                    "*** warning: LocalMatrix::ConvertToBest() analysis is performed on the host");
+            }
+        }
+
+        // Confirm by timing a few SpMVs in all sparse candidate formats
+        if(trial == true)
+        {
+            const int    ntrials    = 10;
+            unsigned int formats[5] = {CSR, ELL, DIA, HYB, mat_format};
+
+            LocalVector<ValueType> x;
+            LocalVector<ValueType> y;
+
+            x.CloneBackend(*this);
+            y.CloneBackend(*this);
+
+            x.Allocate("trial x", this->GetN());
+            y.Allocate("trial y", this->GetM());
+
+            x.Ones();
+
+            double best_time = -1.0;
+
+            for(int i = 0; i < 5; ++i)
+            {
+                LocalMatrix<ValueType> mat;
+                mat.CloneFrom(*this);
+                mat.ConvertTo(formats[i]);
+
+                // Conversion failed
+                if(mat.GetFormat() != formats[i])
+                {
+                    continue;
+                }
+
+                mat.Apply(x, &y);
+
+                _rocalution_sync();
+                double time = rocalution_time();
+
+                for(int k = 0; k < ntrials; ++k)
+                {
+                    mat.Apply(x, &y);
+                }
+
+                _rocalution_sync();
+                time = rocalution_time() - time;
+
+                LOG_VERBOSE_INFO(4,
+                                 "*** info: LocalMatrix::ConvertToBest() trial "
+                                     << _matrix_format_names[formats[i]] << " " << time / ntrials
+                                     << " usec");
+
+                if(best_time < 0.0 || time < best_time)
+                {
+                    best_time  = time;
+                    mat_format = formats[i];
+                }
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(format_cache_mutex);
+            format_cache[key] = std::make_pair(mat_format, trial);
+        }
+
+        return mat_format;
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::Apply(const LocalVector<ValueType>& in,
+                                       LocalVector<ValueType>*       out) const
+    {
+        log_debug(this, "LocalMatrix::Apply()", (const void*&)in, out);
+
+        assert(out != NULL);
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            assert(in.GetSize() == this->GetN());
+            assert(out->GetSize() == this->GetM());
+
+            assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
+                    && (out->vector_ == out->vector_host_))
+                   || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
+                       && (out->vector_ == out->vector_accel_)));
+
+            this->matrix_->Apply(*in.vector_, out->vector_);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ApplyAdd(const LocalVector<ValueType>& in,
+                                          ValueType                     scalar,
+                                          LocalVector<ValueType>*       out) const
+    {
+        log_debug(this, "LocalMatrix::ApplyAdd()", (const void*&)in, scalar, out);
+
+        assert(out != NULL);
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            assert(in.GetSize() == this->GetN());
+            assert(out->GetSize() == this->GetM());
+
+            assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
+                    && (out->vector_ == out->vector_host_))
+                   || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
+                       && (out->vector_ == out->vector_accel_)));
+
+            this->matrix_->ApplyAdd(*in.vector_, scalar, out->vector_);
+        }
+    }
 
     template <typename ValueType>
     void LocalMatrix<ValueType>::ExtractDiagonal(LocalVector<ValueType>* vec_diag) const
@@ -2763,59 +3331,11 @@ namespace rocalution
         {
             if(this->GetNnz() > 0)
             {
-                // with control levels
+                // with control levels, the level-of-fill pattern is factorized by ILU(0)
                 if(level == true)
                 {
-                    LocalMatrix structure;
-                    structure.CloneFrom(*this);
-                    structure.SymbolicPower(p + 1);
-
-                    bool err = this->matrix_->ILUpFactorizeNumeric(p, *structure.matrix_);
-
-                    if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
-                    {
-                        LOG_INFO("Computation of LocalMatrix::ILUpFactorize() failed");
-                        this->Info();
-                        FATAL_ERROR(__FILE__, __LINE__);
-                    }
-
-                    if(err == false)
-                    {
-                        // Move to host
-                        bool is_accel = this->is_accel_();
-                        this->MoveToHost();
-                        structure.MoveToHost();
-
-                        // Convert to CSR
-                        unsigned int format = this->GetFormat();
-                        this->ConvertToCSR();
-                        structure.ConvertToCSR();
-
-                        if(this->matrix_->ILUpFactorizeNumeric(p, *structure.matrix_) == false)
-                        {
-                            LOG_INFO("Computation of LocalMatrix::ILUpFactorize() failed");
-                            this->Info();
-                            FATAL_ERROR(__FILE__, __LINE__);
-                        }
-
-                        if(format != CSR)
-                        {
-                            LOG_VERBOSE_INFO(2,
-                                             "*** warning: LocalMatrix::ILUpFactorize() is "
-                                             "performed in CSR format");
-
-                            this->ConvertTo(format);
-                        }
-
-                        if(is_accel == true)
-                        {
-                            LOG_VERBOSE_INFO(2,
-                                             "*** warning: LocalMatrix::ILUpFactorize() is "
-                                             "performed on the host");
-
-                            this->MoveToAccelerator();
-                        }
-                    }
+                    this->SymbolicILUp(p);
+                    this->ILU0Factorize();
 
                     // without control levels
                 }
@@ -3163,6 +3683,88 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::SchurComplement(int                     size,
+                                                 LocalVector<ValueType>* inv_diag,
+                                                 LocalMatrix<ValueType>* E,
+                                                 LocalMatrix<ValueType>* F,
+                                                 LocalMatrix<ValueType>* S) const
+    {
+        log_debug(this, "LocalMatrix::SchurComplement()", size, inv_diag, E, F, S);
+
+        assert(inv_diag != NULL);
+        assert(E != NULL);
+        assert(F != NULL);
+        assert(S != NULL);
+        assert(E != this);
+        assert(F != this);
+        assert(S != this);
+        assert(this->GetM() == this->GetN());
+        assert(size > 0);
+        assert(static_cast<IndexType2>(size) < this->GetM());
+
+        assert(inv_diag->is_host_() == this->is_host_());
+        assert(E->is_host_() == this->is_host_());
+        assert(F->is_host_() == this->is_host_());
+        assert(S->is_host_() == this->is_host_());
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        int nrow = this->GetLocalM() - size;
+
+        bool err = false;
+
+        if(this->GetNnz() > 0 && this->GetFormat() == CSR)
+        {
+            E->Clear();
+            F->Clear();
+            S->Clear();
+
+            E->ConvertToCSR();
+            F->ConvertToCSR();
+            S->ConvertToCSR();
+
+            std::string vec_inv_diag_name
+                = "Inverse of the diagonal block of " + this->object_name_;
+            inv_diag->Allocate(vec_inv_diag_name, size);
+
+            err = this->matrix_->SchurComplement(
+                size, inv_diag->vector_, E->matrix_, F->matrix_, S->matrix_);
+
+            if((err == false) && (this->is_host_() == true))
+            {
+                LOG_INFO("Computation of LocalMatrix::SchurComplement() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+        }
+
+        // Other formats and the accelerator extract the blocks and multiply them
+        if(err == false)
+        {
+            LocalMatrix<ValueType> D;
+            LocalMatrix<ValueType> C;
+
+            D.CloneBackend(*this);
+            C.CloneBackend(*this);
+
+            this->ExtractSubMatrix(0, 0, size, size, &D);
+            this->ExtractSubMatrix(0, size, size, nrow, F);
+            this->ExtractSubMatrix(size, 0, nrow, size, E);
+            this->ExtractSubMatrix(size, size, nrow, nrow, &C);
+
+            D.ExtractInverseDiagonal(inv_diag);
+            D.Clear();
+
+            E->DiagonalMatrixMult(*inv_diag);
+
+            S->MatrixMult(*E, *F);
+            S->MatrixAdd(C, static_cast<ValueType>(-1), static_cast<ValueType>(1), true);
+        }
+    }
+
     template <typename ValueType>
     void LocalMatrix<ValueType>::Householder(int                     idx,
                                              ValueType&              beta,
@@ -3697,11 +4299,16 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::SymbolicPower(int p)
+    void LocalMatrix<ValueType>::NestedDissection(LocalVector<int>* permutation) const
     {
-        log_debug(this, "LocalMatrix::SymbolicPower()", p);
+        log_debug(this, "LocalMatrix::NestedDissection()", permutation);
 
-        assert(p >= 1);
+        assert(permutation != NULL);
+
+        assert(((this->matrix_ == this->matrix_host_)
+                && (permutation->vector_ == permutation->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (permutation->vector_ == permutation->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -3709,69 +4316,331 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->SymbolicPower(p);
+            bool err = this->matrix_->NestedDissection(permutation->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::SymbolicPower() failed");
+                LOG_INFO("Computation of LocalMatrix::NestedDissection() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat());
+                mat_host.CopyFrom(*this);
+
                 // Move to host
-                bool is_accel = this->is_accel_();
-                this->MoveToHost();
+                permutation->MoveToHost();
 
                 // Convert to CSR
-                unsigned int format = this->GetFormat();
-                this->ConvertToCSR();
+                mat_host.ConvertToCSR();
 
-                if(this->matrix_->SymbolicPower(p) == false)
+                if(mat_host.matrix_->NestedDissection(permutation->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::SymbolicPower() failed");
-                    this->Info();
+                    LOG_INFO("Computation of LocalMatrix::NestedDissection() failed");
+                    mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                if(format != CSR)
+                if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::SymbolicPower() is performed in CSR format");
-
-                    this->ConvertTo(format);
+                        2,
+                        "*** warning: LocalMatrix::NestedDissection() is performed in CSR format");
                 }
 
-                if(is_accel == true)
+                if(this->is_accel_() == true)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::SymbolicPower() is performed on the host");
+                        2, "*** warning: LocalMatrix::NestedDissection() is performed on the host");
 
-                    this->MoveToAccelerator();
+                    permutation->MoveToAccelerator();
                 }
             }
         }
 
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
+        std::string vec_name      = "NestedDissection permutation of " + this->object_name_;
+        permutation->object_name_ = vec_name;
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::MatrixAdd(const LocalMatrix<ValueType>& mat,
-                                           ValueType                     alpha,
-                                           ValueType                     beta,
-                                           bool                          structure)
+    void LocalMatrix<ValueType>::LocalityOrder(int block_size, LocalVector<int>* permutation) const
     {
-        log_debug(this, "LocalMatrix::MatrixAdd()", (const void*&)mat, alpha, beta, structure);
+        log_debug(this, "LocalMatrix::LocalityOrder()", block_size, permutation);
 
-        assert(&mat != this);
-        assert(this->GetFormat() == mat.GetFormat());
-        assert(this->GetM() == mat.GetM());
-        assert(this->GetN() == mat.GetN());
+        assert(permutation != NULL);
+        assert(block_size > 0);
 
-        assert(((this->matrix_ == this->matrix_host_) && (mat.matrix_ == mat.matrix_host_))
+        assert(((this->matrix_ == this->matrix_host_)
+                && (permutation->vector_ == permutation->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (permutation->vector_ == permutation->vector_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->LocalityOrder(block_size, permutation->vector_);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::LocalityOrder() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat());
+                mat_host.CopyFrom(*this);
+
+                // Move to host
+                permutation->MoveToHost();
+
+                // Convert to CSR
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->LocalityOrder(block_size, permutation->vector_) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::LocalityOrder() failed");
+                    mat_host.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->GetFormat() != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::LocalityOrder() is performed in CSR format");
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::LocalityOrder() is performed on the host");
+
+                    permutation->MoveToAccelerator();
+                }
+            }
+        }
+
+        std::string vec_name      = "LocalityOrder permutation of " + this->object_name_;
+        permutation->object_name_ = vec_name;
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::Partition(int nparts, LocalVector<int>* partition) const
+    {
+        log_debug(this, "LocalMatrix::Partition()", nparts, partition);
+
+        assert(partition != NULL);
+        assert(nparts > 0);
+        assert(nparts <= this->GetM());
+        assert(this->GetM() == this->GetN());
+
+        assert(((this->matrix_ == this->matrix_host_)
+                && (partition->vector_ == partition->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (partition->vector_ == partition->vector_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->Partition(nparts, partition->vector_);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::Partition() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat());
+                mat_host.CopyFrom(*this);
+
+                // Move to host
+                partition->MoveToHost();
+
+                // Convert to CSR
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->Partition(nparts, partition->vector_) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::Partition() failed");
+                    mat_host.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->GetFormat() != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::Partition() is performed in CSR format");
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::Partition() is performed on the host");
+
+                    partition->MoveToAccelerator();
+                }
+            }
+        }
+
+        std::string vec_name    = "Partition of " + this->object_name_;
+        partition->object_name_ = vec_name;
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::SymbolicPower(int p)
+    {
+        log_debug(this, "LocalMatrix::SymbolicPower()", p);
+
+        assert(p >= 1);
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->SymbolicPower(p);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::SymbolicPower() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                // Move to host
+                bool is_accel = this->is_accel_();
+                this->MoveToHost();
+
+                // Convert to CSR
+                unsigned int format = this->GetFormat();
+                this->ConvertToCSR();
+
+                if(this->matrix_->SymbolicPower(p) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::SymbolicPower() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(format != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::SymbolicPower() is performed in CSR format");
+
+                    this->ConvertTo(format);
+                }
+
+                if(is_accel == true)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::SymbolicPower() is performed on the host");
+
+                    this->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::SymbolicILUp(int p)
+    {
+        log_debug(this, "LocalMatrix::SymbolicILUp()", p);
+
+        assert(p >= 0);
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->SymbolicILUp(p);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::SymbolicILUp() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                // Move to host
+                bool is_accel = this->is_accel_();
+                this->MoveToHost();
+
+                // Convert to CSR
+                unsigned int format = this->GetFormat();
+                this->ConvertToCSR();
+
+                if(this->matrix_->SymbolicILUp(p) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::SymbolicILUp() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(format != CSR)
+                {
+                    LOG_VERBOSE_INFO(2,
+                                     "*** warning: LocalMatrix::SymbolicILUp() is performed "
+                                     "in CSR format");
+
+                    this->ConvertTo(format);
+                }
+
+                if(is_accel == true)
+                {
+                    LOG_VERBOSE_INFO(2,
+                                     "*** warning: LocalMatrix::SymbolicILUp() is performed "
+                                     "on the host");
+
+                    this->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::MatrixAdd(const LocalMatrix<ValueType>& mat,
+                                           ValueType                     alpha,
+                                           ValueType                     beta,
+                                           bool                          structure)
+    {
+        log_debug(this, "LocalMatrix::MatrixAdd()", (const void*&)mat, alpha, beta, structure);
+
+        assert(&mat != this);
+        assert(this->GetFormat() == mat.GetFormat());
+        assert(this->GetM() == mat.GetM());
+        assert(this->GetN() == mat.GetN());
+
+        assert(((this->matrix_ == this->matrix_host_) && (mat.matrix_ == mat.matrix_host_))
                || ((this->matrix_ == this->matrix_accel_) && (mat.matrix_ == mat.matrix_accel_)));
 
 #ifdef DEBUG_MODE
@@ -3879,6 +4748,307 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::MatrixPowers(int                      k,
+                                              const ValueType*         alpha,
+                                              const ValueType*         beta,
+                                              const ValueType*         gamma,
+                                              LocalVector<ValueType>** v) const
+    {
+        log_debug(this, "LocalMatrix::MatrixPowers()", k, alpha, beta, gamma, v);
+
+        assert(k >= 0);
+        assert(v != NULL);
+        assert(this->GetM() == this->GetN());
+
+        for(int j = 0; j <= k; ++j)
+        {
+            assert(v[j] != NULL);
+            assert(v[j]->GetSize() == this->GetM());
+            assert(v[j]->is_host_() == this->is_host_());
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(k == 0)
+        {
+            return;
+        }
+
+        assert(alpha != NULL);
+        assert(beta != NULL);
+        assert(gamma != NULL);
+
+        bool err = false;
+
+        if(this->GetNnz() > 0)
+        {
+            std::vector<BaseVector<ValueType>*> vec(k + 1);
+
+            for(int j = 0; j <= k; ++j)
+            {
+                vec[j] = v[j]->vector_;
+            }
+
+            err = this->matrix_->MatrixPowers(k, alpha, beta, gamma, vec.data());
+        }
+
+        // Other formats and the accelerator perform separate SpMVs
+        if(err == false)
+        {
+            for(int j = 0; j < k; ++j)
+            {
+                this->Apply(*v[j], v[j + 1]);
+
+                if(j > 0)
+                {
+                    v[j + 1]->ScaleAdd2(alpha[j], *v[j], beta[j], *v[j - 1], gamma[j]);
+                }
+                else
+                {
+                    v[j + 1]->ScaleAddScale(alpha[j], *v[j], beta[j]);
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::MatrixPolynomial(int                           k,
+                                                  const ValueType*              alpha,
+                                                  const ValueType*              beta,
+                                                  const ValueType*              gamma,
+                                                  const ValueType*              weight,
+                                                  const LocalVector<ValueType>* scale,
+                                                  const LocalVector<ValueType>& in,
+                                                  LocalVector<ValueType>*       out) const
+    {
+        log_debug(this,
+                  "LocalMatrix::MatrixPolynomial()",
+                  k,
+                  alpha,
+                  beta,
+                  gamma,
+                  weight,
+                  scale,
+                  (const void*&)in,
+                  out);
+
+        assert(k >= 0);
+        assert(weight != NULL);
+        assert(out != NULL);
+        assert(out != &in);
+        assert(this->GetM() == this->GetN());
+        assert(in.GetSize() == this->GetM());
+        assert(out->GetSize() == this->GetM());
+        assert(in.is_host_() == this->is_host_());
+        assert(out->is_host_() == this->is_host_());
+
+        if(scale != NULL)
+        {
+            assert(scale->GetSize() == this->GetM());
+            assert(scale->is_host_() == this->is_host_());
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(k == 0)
+        {
+            out->CopyFrom(in);
+            out->Scale(weight[0]);
+
+            return;
+        }
+
+        assert(alpha != NULL);
+        assert(beta != NULL);
+        assert(gamma != NULL);
+
+        bool err = false;
+
+        if(this->GetNnz() > 0)
+        {
+            err = this->matrix_->MatrixPolynomial(k,
+                                                  alpha,
+                                                  beta,
+                                                  gamma,
+                                                  weight,
+                                                  (scale != NULL) ? scale->vector_ : NULL,
+                                                  *in.vector_,
+                                                  out->vector_);
+        }
+
+        // Other formats and the accelerator perform separate SpMVs
+        if(err == false)
+        {
+            LocalVector<ValueType> work[3];
+
+            for(int i = 0; i < 3; ++i)
+            {
+                work[i].CloneBackend(*this);
+                work[i].Allocate("polynomial basis", this->GetM());
+            }
+
+            LocalVector<ValueType>* v0 = &work[0];
+            LocalVector<ValueType>* v1 = &work[1];
+            LocalVector<ValueType>* v2 = &work[2];
+
+            v1->CopyFrom(in);
+
+            out->CopyFrom(in);
+            out->Scale(weight[0]);
+
+            for(int j = 0; j < k; ++j)
+            {
+                this->Apply(*v1, v2);
+
+                if(scale != NULL)
+                {
+                    v2->PointWiseMult(*scale);
+                }
+
+                if(j > 0)
+                {
+                    v2->ScaleAdd2(alpha[j], *v1, beta[j], *v0, gamma[j]);
+                }
+                else
+                {
+                    v2->ScaleAddScale(alpha[j], *v1, beta[j]);
+                }
+
+                out->AddScale(*v2, weight[j + 1]);
+
+                LocalVector<ValueType>* tmp = v0;
+                v0                          = v1;
+                v1                          = v2;
+                v2                          = tmp;
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::SORSweep(int                           num_colors,
+                                          const int*                    color_offset,
+                                          const LocalVector<int>&       color_rows,
+                                          ValueType                     omega,
+                                          bool                          symmetric,
+                                          bool                          zero_guess,
+                                          int                           sweeps,
+                                          const LocalVector<ValueType>& rhs,
+                                          LocalVector<ValueType>*       x) const
+    {
+        log_debug(this,
+                  "LocalMatrix::SORSweep()",
+                  num_colors,
+                  color_offset,
+                  (const void*&)color_rows,
+                  omega,
+                  symmetric,
+                  zero_guess,
+                  sweeps,
+                  (const void*&)rhs,
+                  x);
+
+        assert(num_colors > 0);
+        assert(color_offset != NULL);
+        assert(sweeps >= 0);
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->GetM() == this->GetN());
+        assert(color_rows.GetSize() == this->GetM());
+        assert(rhs.GetSize() == this->GetM());
+        assert(x->GetSize() == this->GetM());
+        assert(color_rows.is_host_() == this->is_host_());
+        assert(rhs.is_host_() == this->is_host_());
+        assert(x->is_host_() == this->is_host_());
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(sweeps == 0)
+        {
+            if(zero_guess == true)
+            {
+                x->Zeros();
+            }
+
+            return;
+        }
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->SORSweep(num_colors,
+                                               color_offset,
+                                               *color_rows.vector_,
+                                               omega,
+                                               symmetric,
+                                               zero_guess,
+                                               sweeps,
+                                               *rhs.vector_,
+                                               x->vector_);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::SORSweep() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat());
+                mat_host.CopyFrom(*this);
+
+                LocalVector<int> rows_host;
+                rows_host.CopyFrom(color_rows);
+
+                LocalVector<ValueType> rhs_host;
+                rhs_host.CopyFrom(rhs);
+
+                // Move to host
+                x->MoveToHost();
+
+                // Convert to CSR
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->SORSweep(num_colors,
+                                              color_offset,
+                                              *rows_host.vector_,
+                                              omega,
+                                              symmetric,
+                                              zero_guess,
+                                              sweeps,
+                                              *rhs_host.vector_,
+                                              x->vector_)
+                   == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::SORSweep() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->GetFormat() != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::SORSweep() is performed in CSR format");
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::SORSweep() is performed on the host");
+
+                    x->MoveToAccelerator();
+                }
+            }
+        }
+    }
+
     template <typename ValueType>
     void LocalMatrix<ValueType>::Scale(ValueType alpha)
     {
@@ -5052,10 +6222,33 @@ namespace rocalution
                                              LocalMatrix<ValueType>* prolong,
                                              LocalMatrix<ValueType>* restrict) const
     {
-        log_debug(this, "LocalMatrix::RugeStueben()", eps, prolong, restrict);
+        this->RugeStueben(eps, 0, 0, false, 0, prolong, restrict);
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::RugeStueben(ValueType               eps,
+                                             int                     coarsening,
+                                             int                     interpolation,
+                                             bool                    aggressive,
+                                             int                     max_elements,
+                                             LocalMatrix<ValueType>* prolong,
+                                             LocalMatrix<ValueType>* restrict) const
+    {
+        log_debug(this,
+                  "LocalMatrix::RugeStueben()",
+                  eps,
+                  coarsening,
+                  interpolation,
+                  aggressive,
+                  max_elements,
+                  prolong,
+                  restrict);
 
         assert(eps < static_cast<ValueType>(1));
         assert(eps > static_cast<ValueType>(0));
+        assert(coarsening >= 0 && coarsening <= 2);
+        assert(interpolation >= 0 && interpolation <= 1);
+        assert(max_elements >= 0);
         assert(prolong != NULL);
         assert(restrict != NULL);
         assert(this != prolong);
@@ -5073,7 +6266,13 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->RugeStueben(eps, prolong->matrix_, restrict->matrix_);
+            bool err = this->matrix_->RugeStueben(eps,
+                                                  coarsening,
+                                                  interpolation,
+                                                  aggressive,
+                                                  max_elements,
+                                                  prolong->matrix_,
+                                                  restrict->matrix_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
@@ -5095,7 +6294,14 @@ namespace rocalution
                 // Convert to CSR
                 mat_host.ConvertToCSR();
 
-                if(mat_host.matrix_->RugeStueben(eps, prolong->matrix_, restrict->matrix_) == false)
+                if(mat_host.matrix_->RugeStueben(eps,
+                                                 coarsening,
+                                                 interpolation,
+                                                 aggressive,
+                                                 max_elements,
+                                                 prolong->matrix_,
+                                                 restrict->matrix_)
+                   == false)
                 {
                     LOG_INFO("Computation of LocalMatrix::RugeStueben() failed");
                     mat_host.Info();
@@ -43,6 +43,9 @@ namespace rocalution
     template <typename ValueType>
     class GlobalMatrix;
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    class MultiColoredSOR;
+
     /** \ingroup op_vec_module
   * \class LocalMatrix
   * \brief LocalMatrix class
@@ -98,12 +101,16 @@ namespace rocalution
       *   mat.AllocateCOO("my COO matrix", 200, 100, 100);
       *   mat.Clear();
       * \endcode
+      *
+      * \note
+      * CSR and COO matrices with more non-zero elements than \p int can address are
+      * allocated on the host with 64 bit row offsets (see SetDataPtrCSR()).
       */
         /**@{*/
-        void AllocateCSR(const std::string name, int nnz, int nrow, int ncol);
+        void AllocateCSR(const std::string name, IndexType2 nnz, int nrow, int ncol);
         void AllocateBCSR(void){};
         void AllocateMCSR(const std::string name, int nnz, int nrow, int ncol);
-        void AllocateCOO(const std::string name, int nnz, int nrow, int ncol);
+        void AllocateCOO(const std::string name, IndexType2 nnz, int nrow, int ncol);
         void AllocateDIA(const std::string name, int nnz, int nrow, int ncol, int ndiag);
         void AllocateELL(const std::string name, int nnz, int nrow, int ncol, int max_row);
         void AllocateHYB(
@@ -136,10 +143,22 @@ namespace rocalution
       *   // invalid
       *   mat.SetDataPtrCSR(&csr_row_ptr, &csr_col, &csr_val, "my_matrix", 345, 100, 100);
       * \endcode
+      *
+      * \note
+      * CSR row offsets can also be passed as 64 bit integers (\p IndexType2), the column
+      * indices stay 32 bit. Matrices with more non-zero elements than \p int can address
+      * are kept on the host with 64 bit row offsets and support the CSR/COO conversions,
+      * file I/O and Apply()/ApplyAdd() only, smaller matrices are compacted to 32 bit row
+      * offsets.
       */
         /**@{*/
-        void SetDataPtrCOO(
-            int** row, int** col, ValueType** val, std::string name, int nnz, int nrow, int ncol);
+        void SetDataPtrCOO(int**       row,
+                           int**       col,
+                           ValueType** val,
+                           std::string name,
+                           IndexType2  nnz,
+                           int         nrow,
+                           int         ncol);
         void SetDataPtrCSR(int**       row_offset,
                            int**       col,
                            ValueType** val,
@@ -147,6 +166,13 @@ namespace rocalution
                            int         nnz,
                            int         nrow,
                            int         ncol);
+        void SetDataPtrCSR(IndexType2** row_offset,
+                           int**        col,
+                           ValueType**  val,
+                           std::string  name,
+                           IndexType2   nnz,
+                           int          nrow,
+                           int          ncol);
         void SetDataPtrMCSR(int**       row_offset,
                             int**       col,
                             ValueType** val,
@@ -195,6 +221,7 @@ namespace rocalution
         /**@{*/
         void LeaveDataPtrCOO(int** row, int** col, ValueType** val);
         void LeaveDataPtrCSR(int** row_offset, int** col, ValueType** val);
+        void LeaveDataPtrCSR(IndexType2** row_offset, int** col, ValueType** val);
         void LeaveDataPtrMCSR(int** row_offset, int** col, ValueType** val);
         void LeaveDataPtrELL(int** col, ValueType** val, int& max_row);
         void LeaveDataPtrDIA(int** offset, ValueType** val, int& num_diag);
@@ -266,6 +293,8 @@ namespace rocalution
         /** \brief Create permutation vector for CMK reordering of the matrix
       * \details
       * The Cuthill-McKee ordering minimize the bandwidth of a given sparse matrix.
+      * Each connected component of the adjacency graph is traversed by a level-synchronous
+      * breadth-first search, which starts in a pseudo-peripheral node.
       *
       * @param[out]
       * permutation permutation vector for CMK reordering
@@ -316,6 +345,71 @@ namespace rocalution
       */
         void ConnectivityOrder(LocalVector<int>* permutation) const;
 
+        /** \brief Create permutation vector for nested dissection reordering of the matrix
+      * \details
+      * Nested dissection is a fill-reducing ordering for incomplete and direct
+      * factorizations. The adjacency graph of the matrix is recursively split by a small
+      * separator, which is taken from a breadth-first level structure. Both halves are
+      * ordered first, followed by the separator.
+      *
+      * @param[out]
+      * permutation permutation vector for nested dissection reordering
+      *
+      * \par Example
+      * \code{.cpp}
+      *   LocalVector<int> nd;
+      *
+      *   mat.NestedDissection(&nd);
+      *   mat.Permute(nd);
+      * \endcode
+      */
+        void NestedDissection(LocalVector<int>* permutation) const;
+
+        /** \brief Create permutation vector for cache-oriented reordering of the matrix
+      * \details
+      * The locality ordering groups the rows into compact blocks of \p block_size
+      * neighboring rows, grown by breadth-first search. The blocks are placed along a
+      * Cuthill-McKee sweep of the adjacency graph, such that the entries accessed by the
+      * SpMV and triangular solves of a block are close in memory.
+      *
+      * @param[in]
+      * block_size  number of rows per block
+      * @param[out]
+      * permutation permutation vector for locality reordering
+      *
+      * \par Example
+      * \code{.cpp}
+      *   LocalVector<int> loc;
+      *
+      *   mat.LocalityOrder(256, &loc);
+      *   mat.Permute(loc);
+      * \endcode
+      */
+        void LocalityOrder(int block_size, LocalVector<int>* permutation) const;
+
+        /** \brief Partition the matrix into parts with few couplings between them
+      * \details
+      * The adjacency graph of the matrix is split into \p nparts parts of (almost) equal
+      * size by recursive bisection. Each bisection splits a breadth-first level structure,
+      * started at a pseudo-peripheral node, and is then improved by swapping boundary
+      * nodes between both halves. The partition keeps the number of matrix entries that
+      * couple different parts small, which makes it suitable for distributing the matrix
+      * across processes (see GlobalMatrix::DistributeFrom()).
+      *
+      * @param[in]
+      * nparts      number of parts
+      * @param[out]
+      * partition   part of each row, in the range [0, nparts)
+      *
+      * \par Example
+      * \code{.cpp}
+      *   LocalVector<int> part;
+      *
+      *   mat.Partition(4, &part);
+      * \endcode
+      */
+        void Partition(int nparts, LocalVector<int>* partition) const;
+
         /** \brief Perform multi-coloring decomposition of the matrix
       * \details
       * The Multi-Coloring algorithm builds a permutation (coloring of the matrix) in a
@@ -343,7 +437,11 @@ namespace rocalution
         /** \brief Perform maximal independent set decomposition of the matrix
       * \details
       * The Maximal Independent Set algorithm finds a set with maximal size, that
-      * contains elements that do not depend on other elements in this set.
+      * contains elements that do not depend on other elements in this set. Dependencies
+      * in both directions are taken into account, such that the leading block of the
+      * permuted matrix is diagonal. The nodes of the set are numbered first, in their
+      * original order. On the host, the set is computed in parallel and does not depend
+      * on the number of threads.
       *
       * @param[out]
       * size        number of independent sets
@@ -384,6 +482,44 @@ namespace rocalution
       */
         void ZeroBlockPermutation(int& size, LocalVector<int>* permutation) const;
 
+        /** \brief Compute the Schur complement of a leading diagonal block
+      * \details
+      * The matrix is split into the blocks
+      * \f[
+      *   A = \begin{pmatrix} D & F \\ E & C \end{pmatrix},
+      * \f]
+      * where \f$D\f$ is the diagonal block of the first \p size rows and columns, e.g.
+      * after a MaximalIndependentSet() permutation. Off-diagonal entries of \f$D\f$ are
+      * ignored. On the host, the blocks and the Schur complement
+      * \f$S = C - ED^{-1}F\f$ are computed in a single parallel pass over the rows.
+      *
+      * @param[in]
+      * size        size of the diagonal block
+      * @param[out]
+      * inv_diag    inverse diagonal of \f$D\f$
+      * @param[out]
+      * E           block \f$ED^{-1}\f$
+      * @param[out]
+      * F           block \f$F\f$
+      * @param[out]
+      * S           Schur complement \f$C - ED^{-1}F\f$
+      *
+      * \par Example
+      * \code{.cpp}
+      *   LocalVector<int> mis;
+      *   int size;
+      *
+      *   mat.MaximalIndependentSet(size, &mis);
+      *   mat.Permute(mis);
+      *   mat.SchurComplement(size, &inv_diag, &E, &F, &S);
+      * \endcode
+      */
+        void SchurComplement(int                     size,
+                             LocalVector<ValueType>* inv_diag,
+                             LocalMatrix<ValueType>* E,
+                             LocalMatrix<ValueType>* F,
+                             LocalMatrix<ValueType>* S) const;
+
         /** \brief Perform ILU(0) factorization */
         void ILU0Factorize(void);
         /** \brief Perform LU factorization */
@@ -394,7 +530,12 @@ namespace rocalution
       */
         void ILUTFactorize(double t, int maxrow);
 
-        /** \brief Perform ILU(p) factorization based on power */
+        /** \brief Perform ILU(p) factorization based on power
+      * \details
+      * If \p level is true, the level-of-fill ILU(p) pattern is computed by
+      * SymbolicILUp() and factorized numerically by ILU(0). Otherwise, the pattern of
+      * \f$|A|^{p+1}\f$ is used.
+      */
         void ILUpFactorize(int p, bool level = true);
         /** \brief Analyse the structure (level-scheduling) */
         void LUAnalyse(void);
@@ -494,7 +635,8 @@ namespace rocalution
         /** \brief Read matrix from CSR (rocALUTION binary format) file
       * \details
       * Read a CSR matrix from binary file. For details on the format, see
-      * WriteFileCSR().
+      * WriteFileCSR(). Files written by previous versions of rocALUTION can be read as
+      * well. Values are converted to \p ValueType, if the precision in the file differs.
       *
       * @param[in]
       * filename    name of the file containing the data.
@@ -507,31 +649,90 @@ namespace rocalution
       */
         void ReadFileCSR(const std::string filename);
 
+        /** \brief Read rows of a matrix from CSR (rocALUTION binary format) file
+      * \details
+      * Read the rows [\p row_begin, \p row_end) of a CSR matrix from binary file (see
+      * WriteFileCSR()). Only the row offsets of these rows and their column indices and
+      * values are read from the file, such that e.g. each process can read its own block
+      * of rows of a matrix that does not fit into memory. The matrix has
+      * \p row_end - \p row_begin rows and the number of columns of the file matrix, i.e.
+      * column indices are not shifted. Checksums are not verified.
+      *
+      * @param[in]
+      * filename    name of the file containing the data.
+      * @param[in]
+      * row_begin   first row to read.
+      * @param[in]
+      * row_end     row after the last row to read.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   // Read the second half of the rows
+      *   LocalMatrix<ValueType> mat;
+      *   mat.ReadFileCSR("my_matrix.csr", m / 2, m);
+      * \endcode
+      */
+        void ReadFileCSR(const std::string filename, int row_begin, int row_end);
+
+        /** \brief Map matrix from CSR (rocALUTION binary format) file into memory
+      * \details
+      * Map a CSR matrix from binary file (see WriteFileCSR()) into host memory, without
+      * reading or copying the data. The matrix arrays point directly into the file pages,
+      * which are loaded on first access. The mapping is private, i.e. modifications of
+      * the matrix are never written back to the file. Checksums are not verified.
+      *
+      * If the file cannot be mapped (e.g. file written by a previous version of
+      * rocALUTION, different precision, or the matrix is not a host CSR matrix), the
+      * matrix is read with ReadFileCSR() instead.
+      *
+      * @param[in]
+      * filename    name of the file containing the data.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   LocalMatrix<ValueType> mat;
+      *   mat.MapFileCSR("my_matrix.csr");
+      * \endcode
+      */
+        void MapFileCSR(const std::string filename);
+
         /** \brief Write CSR matrix to binary file
       * \details
       * Write a CSR matrix to binary file.
       *
-      * The binary format contains a header, the rocALUTION version and the matrix data
-      * as follows
+      * The binary format contains a header line, a header, a section table and the
+      * matrix data sections. Values are stored in native precision (\p ValueType) and
+      * each section starts at a 4096 byte aligned offset, such that the file can be
+      * mapped by MapFileCSR().
       * \code{.cpp}
+      *   // Header line
+      *   "#rocALUTION binary csr file v2\n"
+      *
       *   // Header
-      *   out << "#rocALUTION binary csr file" << std::endl;
-      *
-      *   // rocALUTION version
-      *   out.write((char*)&version, sizeof(int));
-      *
-      *   // CSR matrix data
-      *   out.write((char*)&m, sizeof(int));
-      *   out.write((char*)&n, sizeof(int));
-      *   out.write((char*)&nnz, sizeof(int));
-      *   out.write((char*)csr_row_ptr, (m + 1) * sizeof(int));
-      *   out.write((char*)csr_col_ind, nnz * sizeof(int));
-      *   out.write((char*)csr_val, nnz * sizeof(double));
+      *   int32_t version;    // rocALUTION version
+      *   int32_t index_size; // size of row offset and column index type in bytes
+      *   int32_t value_type; // 0 = int, 1 = float, 2 = double,
+      *                       // 3 = complex float, 4 = complex double
+      *   int32_t flags;      // 1 = sections carry a checksum
+      *   int64_t m;
+      *   int64_t n;
+      *   int64_t nnz;
+      *   int32_t nsection;   // 3 (row offsets, column indices and values)
+      *   int32_t alignment;  // 4096
+      *
+      *   // Section table, for each section
+      *   int64_t  offset;    // offset of the section from the beginning of the file
+      *   int64_t  size;      // size of the section in bytes
+      *   uint64_t checksum;  // 64 bit FNV-1a hash over 8 byte words of the section
+      *
+      *   // Sections
+      *   csr_row_ptr[m + 1]
+      *   csr_col_ind[nnz]
+      *   csr_val[nnz]
       * \endcode
       *
-      * \note
-      * Vector values array is always stored in double precision (e.g. double or
-      * std::complex<double>).
+      * Data is streamed to and from the file in chunks, such that no temporary copy of
+      * the matrix is required.
       *
       * @param[in]
       * filename    name of the file to write the data to.
@@ -548,6 +749,25 @@ namespace rocalution
       */
         void WriteFileCSR(const std::string filename) const;
 
+        /** \brief Convert a CSR (rocALUTION binary format) file
+      * \details
+      * Convert a binary CSR file, e.g. written by a previous version of rocALUTION or in
+      * a different precision, into the current format (see WriteFileCSR()) with values in
+      * \p ValueType precision. The file is streamed in chunks, i.e. files larger than the
+      * host memory can be converted and mapped by MapFileCSR() afterwards.
+      *
+      * @param[in]
+      * input       name of the file to convert.
+      * @param[in]
+      * output      name of the converted file, must differ from \p input.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   LocalMatrix<float>::ConvertFileCSR("my_matrix.csr", "my_matrix_float.csr");
+      * \endcode
+      */
+        static void ConvertFileCSR(const std::string input, const std::string output);
+
         virtual void MoveToAccelerator(void);
         virtual void MoveToAcceleratorAsync(void);
         virtual void MoveToHost(void);
@@ -689,9 +909,52 @@ namespace rocalution
         void ConvertToHYB(void);
         /** \brief Convert the matrix to DENSE structure */
         void ConvertToDENSE(void);
-        /** \brief Convert the matrix to specified matrix ID format */
+        /** \brief Convert the matrix to specified matrix ID format
+      * \details
+      * If \p matrix_format is \p AUTO, the format is selected by ConvertToBest().
+      */
         void ConvertTo(unsigned int matrix_format);
 
+        /** \brief Convert the matrix to the most suitable matrix format
+      * \details
+      * The format is selected by a feature analysis of the sparsity pattern (row length
+      * distribution, diagonal structure and bandwidth) for the backend the matrix currently
+      * resides on. Optionally, the selection can be
+      * confirmed by timing a few sparse matrix vector products in all candidate formats.
+      * The selected format is cached, based on the hash keys (see Key()) of the sparsity
+      * pattern, such that matrices with the same pattern are not analysed twice.
+      *
+      * @param[in]
+      * trial   if true, the selection is confirmed by timed trial runs.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   LocalMatrix<ValueType> mat;
+      *
+      *   mat.ReadFileMTX("my_matrix.mtx");
+      *   mat.MoveToAccelerator();
+      *
+      *   // Convert to the fastest format
+      *   mat.ConvertToBest(true);
+      * \endcode
+      */
+        void ConvertToBest(bool trial = false);
+
+        /** \brief Select the most suitable matrix format without converting the matrix
+      * \details
+      * Performs the feature analysis of ConvertToBest() for a matrix residing on the host
+      * or on the accelerator, independent of the backend the matrix currently resides
+      * on. Formats of previously analysed sparsity patterns are taken from the cache.
+      *
+      * @param[in]
+      * accel   if true, the format is selected for the accelerator, else for the host.
+      * @param[out]
+      * cached  if not NULL, set to true if the format has been taken from the cache.
+      *
+      * \retval the selected matrix format.
+      */
+        unsigned int SelectFormat(bool accel, bool* cached = NULL) const;
+
         virtual void Apply(const LocalVector<ValueType>& in, LocalVector<ValueType>* out) const;
         virtual void ApplyAdd(const LocalVector<ValueType>& in,
                               ValueType                     scalar,
@@ -700,6 +963,20 @@ namespace rocalution
         /** \brief Perform symbolic computation (structure only) of \f$|this|^p\f$ */
         void SymbolicPower(int p);
 
+        /** \brief Replace the structure by the level-of-fill ILU(p) pattern
+      * \details
+      * An entry \f$(i,j)\f$ has level of fill \f$l\f$ if the shortest path from \f$i\f$
+      * to \f$j\f$ in the graph of the matrix, whose interior nodes are all smaller than
+      * \f$i\f$ and \f$j\f$, has length \f$l+1\f$. On the host, the pattern is computed
+      * by a breadth-first search of depth \f$p+1\f$ from each row in parallel. The values
+      * of the matrix are kept and fill-in entries are zero, such that the ILU(p)
+      * factorization is obtained by ILU0Factorize().
+      *
+      * @param[in]
+      * p   level of fill
+      */
+        void SymbolicILUp(int p);
+
         /** \brief Perform matrix addition, this = alpha*this + beta*mat;
       * - if structure==false the sparsity pattern of the matrix is not changed;
       * - if structure==true a new sparsity pattern is computed
@@ -730,6 +1007,121 @@ namespace rocalution
         /** \brief Compute the spectrum approximation with Gershgorin circles theorem */
         void Gershgorin(ValueType& lambda_min, ValueType& lambda_max) const;
 
+        /** \brief Compute a polynomial basis of a Krylov subspace (matrix powers kernel)
+      * \details
+      * \p MatrixPowers computes the vectors
+      * \f[
+      *   v_{j+1} = \alpha_{j}Av_{j} + \beta_{j}v_{j} + \gamma_{j}v_{j-1}, \quad
+      *   j = 0, \dots, k-1,
+      * \f]
+      * where \f$v_{0}\f$ is given and \f$v_{-1} = 0\f$. This covers the monomial, Newton
+      * and Chebyshev bases of the s-step Krylov solvers. On the host, the rows of a CSR
+      * matrix are split into cache sized tiles with ghost layers of depth \f$k\f$, such
+      * that all \f$k\f$ products of a tile are computed while its matrix rows are kept in
+      * cache. The tiles are built by the first call and rebuilt when the structure of the
+      * matrix changes. If the ghost layers are too large, e.g. due to a large bandwidth
+      * (see RCMK()), or on the accelerator, \f$k\f$ SpMVs are performed instead.
+      *
+      * \param[in]
+      * k       number of basis vectors to compute.
+      * \param[in]
+      * alpha   array of \p k scaling factors of the matrix products.
+      * \param[in]
+      * beta    array of \p k scaling factors of \f$v_{j}\f$.
+      * \param[in]
+      * gamma   array of \p k scaling factors of \f$v_{j-1}\f$, \p gamma[0] is not used.
+      * \param[inout]
+      * v       array of \p k + 1 vectors, \p v[0] holds the start vector.
+      */
+        void MatrixPowers(int                      k,
+                          const ValueType*         alpha,
+                          const ValueType*         beta,
+                          const ValueType*         gamma,
+                          LocalVector<ValueType>** v) const;
+
+        /** \brief Apply a matrix polynomial given by a three-term recurrence
+      * \details
+      * \p MatrixPolynomial computes
+      * \f[
+      *   out = \sum_{j=0}^{k} \omega_{j}v_{j}, \quad
+      *   v_{j+1} = \alpha_{j}SAv_{j} + \beta_{j}v_{j} + \gamma_{j}v_{j-1},
+      * \f]
+      * with \f$v_{0} = in\f$, \f$v_{-1} = 0\f$ and the diagonal matrix \f$S\f$ holding
+      * the entries of \p scale (e.g. the inverse diagonal of a Jacobi preconditioner).
+      * The basis is computed by the matrix powers kernel (see MatrixPowers()), but only
+      * \p in and \p out are accessed in memory. This applies a polynomial of degree
+      * \f$k\f$, such as a Chebyshev polynomial, reading the matrix only once. Otherwise,
+      * \f$k\f$ SpMVs are performed instead.
+      *
+      * \param[in]
+      * k       degree of the polynomial.
+      * \param[in]
+      * alpha   array of \p k scaling factors of the matrix products.
+      * \param[in]
+      * beta    array of \p k scaling factors of \f$v_{j}\f$.
+      * \param[in]
+      * gamma   array of \p k scaling factors of \f$v_{j-1}\f$, \p gamma[0] is not used.
+      * \param[in]
+      * weight  array of \p k + 1 weights of the basis vectors.
+      * \param[in]
+      * scale   row scaling of the matrix products, can be NULL.
+      * \param[in]
+      * in      start vector \f$v_{0}\f$.
+      * \param[out]
+      * out     polynomial applied to \p in.
+      */
+        void MatrixPolynomial(int                           k,
+                              const ValueType*              alpha,
+                              const ValueType*              beta,
+                              const ValueType*              gamma,
+                              const ValueType*              weight,
+                              const LocalVector<ValueType>* scale,
+                              const LocalVector<ValueType>& in,
+                              LocalVector<ValueType>*       out) const;
+
+        /** \brief Perform multi-colored SOR sweeps in place
+      * \details
+      * \p SORSweep performs \p sweeps SOR relaxation steps
+      * \f[
+      *   x_{i} = x_{i} + \frac{\omega}{a_{ii}} \left(b_{i} - \sum_{j} a_{ij}x_{j}\right)
+      * \f]
+      * on \p x, visiting the rows color by color. The rows of color \f$c\f$ are given by
+      * \p color_rows[\p color_offset[c]], ..., \p color_rows[\p color_offset[c+1]-1] and
+      * must not couple with each other, e.g. as obtained by MultiColoring(). The matrix
+      * is not permuted. Each row is updated in a single pass, computing its residual and
+      * the scaling by the diagonal entry together. If \p symmetric is set, each sweep is
+      * followed by a sweep in reverse color order (SSOR). With \p zero_guess, \p x is set
+      * to zero first and the first color of the first sweep reads the diagonal only.
+      *
+      * \param[in]
+      * num_colors      number of colors.
+      * \param[in]
+      * color_offset    host array of \p num_colors + 1 offsets into \p color_rows.
+      * \param[in]
+      * color_rows      rows of all colors, ordered by color.
+      * \param[in]
+      * omega           relaxation parameter, \f$\omega = 1\f$ gives Gauss-Seidel.
+      * \param[in]
+      * symmetric       perform symmetric sweeps (forward and backward).
+      * \param[in]
+      * zero_guess      the initial guess is zero, the input of \p x is not used.
+      * \param[in]
+      * sweeps          number of sweeps.
+      * \param[in]
+      * rhs             right-hand side.
+      * \param[inout]
+      * x               solution vector.
+      */
+        void SORSweep(int                           num_colors,
+                      const int*                    color_offset,
+                      const LocalVector<int>&       color_rows,
+                      ValueType                     omega,
+                      bool                          symmetric,
+                      bool                          zero_guess,
+                      int                           sweeps,
+                      const LocalVector<ValueType>& rhs,
+                      LocalVector<ValueType>*       x) const;
+
         /** \brief Delete all entries in the matrix which abs(a_ij) <= drop_off;
       * the diagonal elements are never deleted
       */
@@ -775,8 +1167,12 @@ namespace rocalution
 
         /** \brief Strong couplings for aggregation-based AMG */
         void AMGConnect(ValueType eps, LocalVector<int>* connections) const;
-        /** \brief Plain aggregation - Modification of a greedy aggregation scheme from
-      * Vanek (1996)
+        /** \brief Plain aggregation - The roots of the aggregates form a distance-two
+      * maximal independent set of the strength graph, that is computed in parallel
+      * \details
+      * Each root is aggregated with its strongly connected neighbours, the remaining
+      * points join the adjacent aggregate they have most strong connections to. The
+      * aggregates do not depend on the number of threads.
       */
         void AMGAggregate(const LocalVector<int>& connections, LocalVector<int>* aggregates) const;
         /** \brief Interpolation scheme based on smoothed aggregation from Vanek (1996) */
@@ -794,6 +1190,22 @@ namespace rocalution
         void RugeStueben(ValueType               eps,
                          LocalMatrix<ValueType>* prolong,
                          LocalMatrix<ValueType>* restrict) const;
+        /** \brief Ruge Stueben coarsening with given C/F splitting and interpolation
+      * \details
+      * \p coarsening selects the C/F splitting, 0 for the classical sequential splitting,
+      * 1 for PMIS and 2 for HMIS. \p interpolation is 0 for direct and 1 for extended+i
+      * interpolation. If \p aggressive is set, the splitting is applied to the strong
+      * connections of distance two and extended+i interpolation is used. If
+      * \p max_elements is positive, the interpolation is truncated to the
+      * \p max_elements largest entries of each row.
+      */
+        void RugeStueben(ValueType               eps,
+                         int                     coarsening,
+                         int                     interpolation,
+                         bool                    aggressive,
+                         int                     max_elements,
+                         LocalMatrix<ValueType>* prolong,
+                         LocalMatrix<ValueType>* restrict) const;
 
         /** \brief Factorized Sparse Approximate Inverse assembly for given system matrix
       * power pattern or external sparsity pattern
@@ -803,7 +1215,17 @@ namespace rocalution
         /** \brief SParse Approximate Inverse assembly for given system matrix pattern */
         void SPAI(void);
 
-        /** \brief Initial Pairwise Aggregation scheme */
+        /** \brief Initial Pairwise Aggregation scheme
+      * \details
+      * Each row is paired with one of its neighbours. A neighbour \f$j\f$ is a candidate
+      * for row \f$i\f$ if \f$-a_{ij}\f$ exceeds \f$\beta\f$ times the largest positive
+      * off-diagonal entry of row \f$i\f$ (for positive diagonal entries). The pairs are
+      * formed by a matching of the candidate couplings, scaled by the diagonal entries.
+      * The matching is computed in parallel, greedily within blocks of consecutive rows
+      * and by handshaking for the rows at the borders of the blocks, such that it does
+      * not depend on the number of threads. Strongly diagonally dominant rows are not
+      * aggregated. On the host, the matching does not depend on the ordering.
+      */
         void InitialPairwiseAggregation(ValueType         beta,
                                         int&              nc,
                                         LocalVector<int>* G,
@@ -820,7 +1242,11 @@ namespace rocalution
                                         int**                         rG,
                                         int&                          rGsize,
                                         int                           ordering) const;
-        /** \brief Further Pairwise Aggregation scheme */
+        /** \brief Further Pairwise Aggregation scheme
+      * \details
+      * Pairs the aggregates of a previous pairwise aggregation, which are the rows of
+      * the coarse operator, in the same way as InitialPairwiseAggregation().
+      */
         void FurtherPairwiseAggregation(ValueType         beta,
                                         int&              nc,
                                         LocalVector<int>* G,
@@ -851,6 +1277,14 @@ namespace rocalution
         virtual bool is_accel_(void) const;
 
     private:
+        // Replace the current matrix by an empty host matrix of the same format that can
+        // hold nnz non-zero entries (64 bit row offsets for large CSR matrices)
+        void init_host_matrix_(IndexType2 nnz);
+
+        // Format selection of ConvertToBest() and SelectFormat(), optionally confirmed by
+        // trial runs on the current backend
+        unsigned int select_format_(bool accel, bool trial, bool* cached) const;
+
         // Pointer from the base matrix class to the current
         // allocated matrix (host_ or accel_)
         BaseMatrix<ValueType>* matrix_;
@@ -864,6 +1298,9 @@ namespace rocalution
         friend class LocalVector<ValueType>;
         friend class GlobalVector<ValueType>;
         friend class GlobalMatrix<ValueType>;
+
+        // Keeps a host CSR copy of operators the sweeps cannot be performed on
+        friend class MultiColoredSOR<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>;
     };
 
 } // namespace rocalution
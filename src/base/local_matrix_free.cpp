@@ -0,0 +1,320 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "local_matrix_free.hpp"
+#include "../utils/def.hpp"
+#include "../utils/log.hpp"
+#include "../utils/math_functions.hpp"
+#include "local_vector.hpp"
+
+#include <complex>
+#include <vector>
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    LocalMatrixFree<ValueType>::LocalMatrixFree()
+    {
+        log_debug(this, "LocalMatrixFree::LocalMatrixFree()");
+
+        this->object_name_ = "";
+
+        this->nrow_ = 0;
+        this->ncol_ = 0;
+    }
+
+    template <typename ValueType>
+    LocalMatrixFree<ValueType>::~LocalMatrixFree()
+    {
+        log_debug(this, "LocalMatrixFree::~LocalMatrixFree()");
+
+        this->Clear();
+    }
+
+    template <typename ValueType>
+    void LocalMatrixFree<ValueType>::Info(void) const
+    {
+        std::string current_backend_name;
+
+        if(this->is_host_() == true)
+        {
+            current_backend_name = _rocalution_host_name[0];
+        }
+        else
+        {
+            current_backend_name = _rocalution_backend_name[this->local_backend_.backend];
+        }
+
+        LOG_INFO("LocalMatrixFree"
+                 << " name=" << this->object_name_ << ";"
+                 << " rows=" << this->nrow_ << ";"
+                 << " cols=" << this->ncol_ << ";"
+                 << " diagonal=" << (this->diag_.GetSize() > 0 ? "yes" : "no") << ";"
+                 << " prec=" << 8 * sizeof(ValueType) << "bit;"
+                 << " host backend={" << _rocalution_host_name[0] << "};"
+                 << " accelerator backend={"
+                 << _rocalution_backend_name[this->local_backend_.backend] << "};"
+                 << " current=" << current_backend_name);
+    }
+
+    template <typename ValueType>
+    IndexType2 LocalMatrixFree<ValueType>::GetM(void) const
+    {
+        return static_cast<IndexType2>(this->nrow_);
+    }
+
+    template <typename ValueType>
+    IndexType2 LocalMatrixFree<ValueType>::GetN(void) const
+    {
+        return static_cast<IndexType2>(this->ncol_);
+    }
+
+    template <typename ValueType>
+    IndexType2 LocalMatrixFree<ValueType>::GetNnz(void) const
+    {
+        return 0;
+    }
+
+    template <typename ValueType>
+    void LocalMatrixFree<ValueType>::Allocate(const std::string& name, int nrow, int ncol)
+    {
+        log_debug(this, "LocalMatrixFree::Allocate()", name, nrow, ncol);
+
+        assert(nrow >= 0);
+        assert(ncol >= 0);
+
+        this->diag_.Clear();
+        this->inv_diag_.Clear();
+        this->tmp_.Clear();
+
+        this->object_name_ = name;
+
+        this->nrow_ = nrow;
+        this->ncol_ = ncol;
+    }
+
+    template <typename ValueType>
+    void LocalMatrixFree<ValueType>::SetApplyFunction(ApplyFunction apply)
+    {
+        log_debug(this, "LocalMatrixFree::SetApplyFunction()");
+
+        assert(apply != nullptr);
+
+        this->apply_ = apply;
+    }
+
+    template <typename ValueType>
+    void LocalMatrixFree<ValueType>::SetApplyAddFunction(ApplyAddFunction apply_add)
+    {
+        log_debug(this, "LocalMatrixFree::SetApplyAddFunction()");
+
+        assert(apply_add != nullptr);
+
+        this->apply_add_ = apply_add;
+    }
+
+    template <typename ValueType>
+    void LocalMatrixFree<ValueType>::SetDiagonal(const LocalVector<ValueType>& diag)
+    {
+        log_debug(this, "LocalMatrixFree::SetDiagonal()", (const void*&)diag);
+
+        assert(diag.GetSize() == std::min(this->nrow_, this->ncol_));
+
+        int size = diag.GetSize();
+
+        std::vector<ValueType> data(size);
+        diag.CopyToData(data.data());
+
+        for(int i = 0; i < size; ++i)
+        {
+            if(data[i] == static_cast<ValueType>(0))
+            {
+                LOG_INFO("LocalMatrixFree::SetDiagonal() zero diagonal entry in row " << i);
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+        }
+
+        this->diag_.Clear();
+        this->diag_.Allocate("Diagonal elements of " + this->object_name_, size);
+        this->diag_.CopyFromData(data.data());
+
+        for(int i = 0; i < size; ++i)
+        {
+            data[i] = static_cast<ValueType>(1) / data[i];
+        }
+
+        this->inv_diag_.Clear();
+        this->inv_diag_.Allocate("Inverse of the diagonal elements of " + this->object_name_,
+                                 size);
+        this->inv_diag_.CopyFromData(data.data());
+    }
+
+    template <typename ValueType>
+    void LocalMatrixFree<ValueType>::ExtractDiagonal(LocalVector<ValueType>* vec_diag) const
+    {
+        log_debug(this, "LocalMatrixFree::ExtractDiagonal()", vec_diag);
+
+        assert(vec_diag != NULL);
+
+        if(this->diag_.GetSize() == 0 && std::min(this->nrow_, this->ncol_) > 0)
+        {
+            LOG_INFO("LocalMatrixFree::ExtractDiagonal() the diagonal has not been set");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        vec_diag->CloneFrom(this->diag_);
+    }
+
+    template <typename ValueType>
+    void LocalMatrixFree<ValueType>::ExtractInverseDiagonal(
+        LocalVector<ValueType>* vec_inv_diag) const
+    {
+        log_debug(this, "LocalMatrixFree::ExtractInverseDiagonal()", vec_inv_diag);
+
+        assert(vec_inv_diag != NULL);
+
+        if(this->inv_diag_.GetSize() == 0 && std::min(this->nrow_, this->ncol_) > 0)
+        {
+            LOG_INFO("LocalMatrixFree::ExtractInverseDiagonal() the diagonal has not been set");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        vec_inv_diag->CloneFrom(this->inv_diag_);
+    }
+
+    template <typename ValueType>
+    void LocalMatrixFree<ValueType>::Clear(void)
+    {
+        log_debug(this, "LocalMatrixFree::Clear()");
+
+        this->nrow_ = 0;
+        this->ncol_ = 0;
+
+        this->apply_     = nullptr;
+        this->apply_add_ = nullptr;
+
+        this->diag_.Clear();
+        this->inv_diag_.Clear();
+        this->tmp_.Clear();
+    }
+
+    template <typename ValueType>
+    void LocalMatrixFree<ValueType>::Apply(const LocalVector<ValueType>& in,
+                                           LocalVector<ValueType>*       out) const
+    {
+        log_debug(this, "LocalMatrixFree::Apply()", (const void*&)in, out);
+
+        assert(out != NULL);
+        assert(&in != out);
+        assert(in.GetSize() == this->ncol_);
+        assert(out->GetSize() == this->nrow_);
+
+        assert(((this->is_host_() == true) && (in.is_host_() == true) && (out->is_host_() == true))
+               || ((this->is_accel_() == true) && (in.is_accel_() == true)
+                   && (out->is_accel_() == true)));
+
+        if(this->apply_ == nullptr)
+        {
+            LOG_INFO("LocalMatrixFree::Apply() no apply function has been set");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        this->apply_(in, out);
+    }
+
+    template <typename ValueType>
+    void LocalMatrixFree<ValueType>::ApplyAdd(const LocalVector<ValueType>& in,
+                                              ValueType                     scalar,
+                                              LocalVector<ValueType>*       out) const
+    {
+        log_debug(this, "LocalMatrixFree::ApplyAdd()", (const void*&)in, scalar, out);
+
+        assert(out != NULL);
+        assert(&in != out);
+        assert(in.GetSize() == this->ncol_);
+        assert(out->GetSize() == this->nrow_);
+
+        assert(((this->is_host_() == true) && (in.is_host_() == true) && (out->is_host_() == true))
+               || ((this->is_accel_() == true) && (in.is_accel_() == true)
+                   && (out->is_accel_() == true)));
+
+        if(this->apply_add_ != nullptr)
+        {
+            this->apply_add_(in, scalar, out);
+            return;
+        }
+
+        if(this->tmp_.GetSize() != this->nrow_)
+        {
+            this->tmp_.Clear();
+            this->tmp_.Allocate("ApplyAdd temporary of " + this->object_name_, this->nrow_);
+        }
+
+        this->Apply(in, &this->tmp_);
+        out->AddScale(this->tmp_, scalar);
+    }
+
+    template <typename ValueType>
+    void LocalMatrixFree<ValueType>::MoveToAccelerator(void)
+    {
+        log_debug(this, "LocalMatrixFree::MoveToAccelerator()");
+
+        this->diag_.MoveToAccelerator();
+        this->inv_diag_.MoveToAccelerator();
+        this->tmp_.MoveToAccelerator();
+    }
+
+    template <typename ValueType>
+    void LocalMatrixFree<ValueType>::MoveToHost(void)
+    {
+        log_debug(this, "LocalMatrixFree::MoveToHost()");
+
+        this->diag_.MoveToHost();
+        this->inv_diag_.MoveToHost();
+        this->tmp_.MoveToHost();
+    }
+
+    template <typename ValueType>
+    bool LocalMatrixFree<ValueType>::is_host_(void) const
+    {
+        return this->diag_.is_host_();
+    }
+
+    template <typename ValueType>
+    bool LocalMatrixFree<ValueType>::is_accel_(void) const
+    {
+        return this->diag_.is_accel_();
+    }
+
+    template class LocalMatrixFree<double>;
+    template class LocalMatrixFree<float>;
+#ifdef SUPPORT_COMPLEX
+    template class LocalMatrixFree<std::complex<double>>;
+    template class LocalMatrixFree<std::complex<float>>;
+#endif
+
+} // namespace rocalution
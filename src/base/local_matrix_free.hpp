@@ -0,0 +1,156 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_LOCAL_MATRIX_FREE_HPP_
+#define ROCALUTION_LOCAL_MATRIX_FREE_HPP_
+
+#include "../utils/types.hpp"
+#include "local_vector.hpp"
+#include "operator.hpp"
+
+#include <functional>
+#include <string>
+
+namespace rocalution
+{
+
+    /** \ingroup op_vec_module
+  * \class LocalMatrixFree
+  * \brief LocalMatrixFree class
+  * \details
+  * A LocalMatrixFree is an operator that is never assembled. Its action is provided by
+  * a user function, which computes \f$out = A \cdot in\f$ for two LocalVector objects.
+  * Optionally, an ApplyAdd function and the diagonal of the operator can be supplied.
+  * The diagonal is required by preconditioners like Jacobi. All solvers that only
+  * apply the operator, e.g. CG, GMRES, BiCGStab or Chebyshev, accept a
+  * LocalMatrixFree.
+  *
+  * The vectors passed to the user functions reside on the same backend as the
+  * operator, i.e. on the accelerator after MoveToAccelerator() has been called.
+  *
+  * \tparam ValueType - can be float, double, std::complex<float> and
+  *                     std::complex<double>
+  *
+  * \par Example
+  * \code{.cpp}
+  *   LocalMatrixFree<ValueType> op;
+  *
+  *   op.Allocate("A", n, n);
+  *   op.SetApplyFunction([](const LocalVector<ValueType>& in, LocalVector<ValueType>* out)
+  *   {
+  *     // Compute out = A * in
+  *   });
+  *   op.SetDiagonal(diag);
+  *
+  *   CG<LocalMatrixFree<ValueType>, LocalVector<ValueType>, ValueType> ls;
+  *   Jacobi<LocalMatrixFree<ValueType>, LocalVector<ValueType>, ValueType> p;
+  *
+  *   ls.SetOperator(op);
+  *   ls.SetPreconditioner(p);
+  *   ls.Build();
+  *   ls.Solve(rhs, &x);
+  * \endcode
+  */
+    template <typename ValueType>
+    class LocalMatrixFree : public Operator<ValueType>
+    {
+    public:
+        /** \brief Function that computes out = A * in */
+        typedef std::function<void(const LocalVector<ValueType>& in, LocalVector<ValueType>* out)>
+            ApplyFunction;
+        /** \brief Function that computes out = out + scalar * A * in */
+        typedef std::function<void(
+            const LocalVector<ValueType>& in, ValueType scalar, LocalVector<ValueType>* out)>
+            ApplyAddFunction;
+
+        LocalMatrixFree();
+        virtual ~LocalMatrixFree();
+
+        virtual void       Info(void) const;
+        virtual IndexType2 GetM(void) const;
+        virtual IndexType2 GetN(void) const;
+        /** \brief Return zero, the operator does not store any entries */
+        virtual IndexType2 GetNnz(void) const;
+
+        /** \brief Set the name and size of the operator, a previously set diagonal is
+      * cleared
+      */
+        void Allocate(const std::string& name, int nrow, int ncol);
+
+        /** \brief Set the function that computes out = A * in */
+        void SetApplyFunction(ApplyFunction apply);
+
+        /** \brief Set the function that computes out = out + scalar * A * in
+      * \details
+      * If no ApplyAdd function is set, ApplyAdd() calls the Apply function on a
+      * temporary vector and adds the result.
+      */
+        void SetApplyAddFunction(ApplyAddFunction apply_add);
+
+        /** \brief Set the diagonal of the operator
+      * \details
+      * The diagonal is copied. It is required by ExtractDiagonal() and
+      * ExtractInverseDiagonal(), and therefore by the Jacobi preconditioner.
+      *
+      * @param[in]
+      * diag    diagonal entries, all of them have to be non-zero
+      */
+        void SetDiagonal(const LocalVector<ValueType>& diag);
+
+        /** \brief Extract the diagonal of the operator, see SetDiagonal() */
+        void ExtractDiagonal(LocalVector<ValueType>* vec_diag) const;
+        /** \brief Extract the inverse diagonal of the operator, see SetDiagonal() */
+        void ExtractInverseDiagonal(LocalVector<ValueType>* vec_inv_diag) const;
+
+        virtual void Clear(void);
+
+        virtual void Apply(const LocalVector<ValueType>& in, LocalVector<ValueType>* out) const;
+        virtual void ApplyAdd(const LocalVector<ValueType>& in,
+                              ValueType                     scalar,
+                              LocalVector<ValueType>*       out) const;
+
+        virtual void MoveToAccelerator(void);
+        virtual void MoveToHost(void);
+
+    protected:
+        virtual bool is_host_(void) const;
+        virtual bool is_accel_(void) const;
+
+    private:
+        int nrow_;
+        int ncol_;
+
+        ApplyFunction    apply_;
+        ApplyAddFunction apply_add_;
+
+        // Diagonal and inverse diagonal, empty if not supplied
+        LocalVector<ValueType> diag_;
+        LocalVector<ValueType> inv_diag_;
+
+        // Temporary vector for ApplyAdd() without ApplyAdd function
+        mutable LocalVector<ValueType> tmp_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_LOCAL_MATRIX_FREE_HPP_
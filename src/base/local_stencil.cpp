@@ -23,6 +23,7 @@
 
 #include "local_stencil.hpp"
 #include "../utils/def.hpp"
+#include "host/host_stencil_general.hpp"
 #include "host/host_stencil_laplace2d.hpp"
 #include "host/host_vector.hpp"
 #include "local_vector.hpp"
@@ -60,12 +61,21 @@ namespace rocalution
     {
         log_debug(this, "LocalStencil::LocalStencil()", type);
 
-        assert(type == Laplace2D); // the only one at the moment
+        assert(type <= General);
 
         this->object_name_ = _stencil_type_names[type];
 
-        this->stencil_host_ = new HostStencilLaplace2D<ValueType>(this->local_backend_);
-        this->stencil_      = this->stencil_host_;
+        if(type == Laplace2D)
+        {
+            this->stencil_host_ = new HostStencilLaplace2D<ValueType>(this->local_backend_);
+        }
+        else
+        {
+            this->stencil_host_ = new HostStencilGeneral<ValueType>(this->local_backend_, type);
+        }
+
+        this->stencil_accel_ = NULL;
+        this->stencil_       = this->stencil_host_;
     }
 
     template <typename ValueType>
@@ -116,6 +126,62 @@ namespace rocalution
         this->stencil_->SetGrid(size);
     }
 
+    template <typename ValueType>
+    void LocalStencil<ValueType>::SetGrid(int nx, int ny, int nz)
+    {
+        log_debug(this, "LocalStencil::SetGrid()", nx, ny, nz);
+
+        assert(nx >= 0);
+        assert(ny >= 0);
+        assert(nz >= 0);
+
+        if(this->stencil_->SetGrid(nx, ny, nz) == false)
+        {
+            LOG_INFO("Computation of LocalStencil::SetGrid() failed");
+            LOG_INFO("Non-uniform grids are not supported by this stencil");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalStencil<ValueType>::SetStencil(int              ndim,
+                                             int              nnz,
+                                             const int*       offset,
+                                             const ValueType* coef)
+    {
+        log_debug(this, "LocalStencil::SetStencil()", ndim, nnz, offset, coef);
+
+        assert(ndim >= 1 && ndim <= 3);
+        assert(nnz > 0);
+        assert(offset != NULL);
+        assert(coef != NULL);
+
+        if(this->stencil_->SetStencil(ndim, nnz, offset, coef) == false)
+        {
+            LOG_INFO("Computation of LocalStencil::SetStencil() failed");
+            LOG_INFO("Offsets and coefficients can only be set for General stencils");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalStencil<ValueType>::SetVariableCoefficients(const ValueType* coef)
+    {
+        log_debug(this, "LocalStencil::SetVariableCoefficients()", coef);
+
+        assert(coef != NULL);
+        assert(this->GetM() > 0);
+
+        if(this->stencil_->SetVariableCoefficients(coef) == false)
+        {
+            LOG_INFO("Computation of LocalStencil::SetVariableCoefficients() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+    }
+
     template <typename ValueType>
     void LocalStencil<ValueType>::Apply(const LocalVector<ValueType>& in,
                                         LocalVector<ValueType>*       out) const
@@ -146,7 +212,43 @@ namespace rocalution
                || ((this->stencil_ == this->stencil_accel_) && (in.vector_ == in.vector_accel_)
                    && (out->vector_ == out->vector_accel_)));
 
-        this->stencil_->Apply(*in.vector_, out->vector_);
+        this->stencil_->ApplyAdd(*in.vector_, scalar, out->vector_);
+    }
+
+    template <typename ValueType>
+    void LocalStencil<ValueType>::ApplyPower(const LocalVector<ValueType>& in,
+                                             int                           power,
+                                             LocalVector<ValueType>*       out) const
+    {
+        log_debug(this, "LocalStencil::ApplyPower()", (const void*&)in, power, out);
+
+        assert(power >= 0);
+        assert(out != NULL);
+        assert(&in != out);
+
+        assert(((this->stencil_ == this->stencil_host_) && (in.vector_ == in.vector_host_)
+                && (out->vector_ == out->vector_host_))
+               || ((this->stencil_ == this->stencil_accel_) && (in.vector_ == in.vector_accel_)
+                   && (out->vector_ == out->vector_accel_)));
+
+        if(this->stencil_->ApplyPower(*in.vector_, power, out->vector_) == false)
+        {
+            // Apply the stencil power times
+            out->CopyFrom(in);
+
+            if(power > 0)
+            {
+                LocalVector<ValueType> tmp;
+                tmp.CloneBackend(in);
+                tmp.Allocate("stencil power", in.GetSize());
+
+                for(int i = 0; i < power; ++i)
+                {
+                    tmp.CopyFrom(*out);
+                    this->Apply(tmp, out);
+                }
+            }
+        }
     }
 
     template <typename ValueType>
@@ -52,6 +52,14 @@ namespace rocalution
   * system can contain several CPUs via UMA or NUMA memory system or it can contain an
   * accelerator.
   *
+  * The stencil is defined on a structured grid with nx x ny (x nz) points, which are
+  * numbered with x running fastest, i.e. point (x, y, z) has index (z * ny + y) * nx + x.
+  * Neighbors outside of the grid are dropped (homogeneous Dirichlet boundary). Besides
+  * the predefined Laplace stencils (see \ref _stencil_type), a General stencil can be
+  * defined by arbitrary offsets and constant or grid point dependent coefficients. A
+  * LocalStencil can be used as operator of the iterative solvers, without storing a
+  * matrix.
+  *
   * \tparam ValueType - can be int, float, double, std::complex<float> and
   *                     std::complex<double>
   */
@@ -74,6 +82,48 @@ namespace rocalution
 
         /** \brief Set the stencil grid size */
         void SetGrid(int size);
+        /** \brief Set the stencil grid size per dimension
+        * \details
+        * Sets a grid of \p nx x \p ny x \p nz points, unused dimensions are ignored.
+        * Non-uniform grids are not supported by the Laplace2D stencil.
+        */
+        void SetGrid(int nx, int ny, int nz = 1);
+
+        /** \brief Set the offsets and coefficients of a General stencil
+        * \details
+        * Entry \p k of the stencil couples grid point (x, y, z) to its neighbor
+        * (x + offset[k * ndim], y + offset[k * ndim + 1], z + offset[k * ndim + 2])
+        * with coefficient \p coef[k].
+        *
+        * @param[in]
+        * ndim    dimension of the grid (1, 2 or 3).
+        * @param[in]
+        * nnz     number of stencil entries.
+        * @param[in]
+        * offset  array of \p nnz * \p ndim offsets.
+        * @param[in]
+        * coef    array of \p nnz coefficients.
+        *
+        * \par Example
+        * \code{.cpp}
+        *   // 3D 7-point anisotropic diffusion
+        *   int    offset[21] = {0, 0, 0, -1, 0, 0, 1, 0, 0, 0, -1, 0, 0, 1, 0, 0, 0, -1, 0, 0, 1};
+        *   double coef[7]    = {2.0 + 2.0 * eps + 2.0, -1.0, -1.0, -eps, -eps, -1.0, -1.0};
+        *
+        *   LocalStencil<double> stencil(General);
+        *   stencil.SetStencil(3, 7, offset, coef);
+        *   stencil.SetGrid(nx, ny, nz);
+        * \endcode
+        */
+        void SetStencil(int ndim, int nnz, const int* offset, const ValueType* coef);
+
+        /** \brief Set grid point dependent coefficients
+        * \details
+        * \p coef[k * GetM() + i] replaces the coefficient of stencil entry \p k in row
+        * \p i. The grid has to be set before, changing the grid size drops the variable
+        * coefficients.
+        */
+        void SetVariableCoefficients(const ValueType* coef);
 
         virtual void Clear();
 
@@ -82,6 +132,15 @@ namespace rocalution
                               ValueType                     scalar,
                               LocalVector<ValueType>*       out) const;
 
+        /** \brief Apply the stencil \p power times, out = this^power * in
+        * \details
+        * Repeated applications are blocked in time, such that the intermediate vectors
+        * stay in cache, if supported by the stencil.
+        */
+        void ApplyPower(const LocalVector<ValueType>& in,
+                        int                           power,
+                        LocalVector<ValueType>*       out) const;
+
         virtual void MoveToAccelerator(void);
         virtual void MoveToHost(void);
 
@@ -220,7 +220,27 @@ namespace rocalution
     {
         log_debug(this, "LocalVector::SetRandomUniform()", seed, a, b);
 
+        this->SetRandomUniform_(seed, 0, a, b);
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::SetRandomNormal(unsigned long long seed,
+                                                 ValueType          mean,
+                                                 ValueType          var)
+    {
+        log_debug(this, "LocalVector::SetRandomNormal()", seed, mean, var);
+
+        this->SetRandomNormal_(seed, 0, mean, var);
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::SetRandomUniform_(unsigned long long seed,
+                                                   IndexType2         offset,
+                                                   ValueType          a,
+                                                   ValueType          b)
+    {
         assert(a <= b);
+        assert(offset >= 0);
 
         if(this->GetSize() > 0)
         {
@@ -232,7 +252,7 @@ namespace rocalution
             }
 
             assert(this->vector_ == this->vector_host_);
-            this->vector_host_->SetRandomUniform(seed, a, b);
+            this->vector_host_->SetRandomUniform(seed, offset, a, b);
 
             if(on_host == false)
             {
@@ -245,11 +265,12 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void LocalVector<ValueType>::SetRandomNormal(unsigned long long seed,
-                                                 ValueType          mean,
-                                                 ValueType          var)
+    void LocalVector<ValueType>::SetRandomNormal_(unsigned long long seed,
+                                                  IndexType2         offset,
+                                                  ValueType          mean,
+                                                  ValueType          var)
     {
-        log_debug(this, "LocalVector::SetRandomNormal()", seed, mean, var);
+        assert(offset >= 0);
 
         if(this->GetSize() > 0)
         {
@@ -261,7 +282,7 @@ namespace rocalution
             }
 
             assert(this->vector_ == this->vector_host_);
-            this->vector_host_->SetRandomNormal(seed, mean, var);
+            this->vector_host_->SetRandomNormal(seed, offset, mean, var);
 
             if(on_host == false)
             {
@@ -42,6 +42,8 @@ namespace rocalution
 
     template <typename ValueType>
     class LocalStencil;
+    template <typename ValueType>
+    class LocalMatrixFree;
 
     /** \ingroup op_vec_module
   * \class LocalVector
@@ -297,6 +299,16 @@ namespace rocalution
         virtual bool is_accel_(void) const;
 
     private:
+        // Fill with random values, entry i is number offset + i of the random stream
+        void SetRandomUniform_(unsigned long long seed,
+                               IndexType2         offset,
+                               ValueType          a,
+                               ValueType          b);
+        void SetRandomNormal_(unsigned long long seed,
+                              IndexType2         offset,
+                              ValueType          mean,
+                              ValueType          var);
+
         // Pointer from the base vector class to the current allocated vector (host_ or accel_)
         BaseVector<ValueType>* vector_;
 
@@ -322,6 +334,11 @@ namespace rocalution
         friend class LocalStencil<std::complex<double>>;
         friend class LocalStencil<std::complex<float>>;
 
+        friend class LocalMatrixFree<double>;
+        friend class LocalMatrixFree<float>;
+        friend class LocalMatrixFree<std::complex<double>>;
+        friend class LocalMatrixFree<std::complex<float>>;
+
         friend class GlobalVector<ValueType>;
         friend class LocalMatrix<ValueType>;
         friend class GlobalMatrix<ValueType>;
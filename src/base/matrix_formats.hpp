@@ -24,6 +24,7 @@
 #ifndef ROCALUTION_MATRIX_FORMATS_HPP_
 #define ROCALUTION_MATRIX_FORMATS_HPP_
 
+#include <cassert>
 #include <string>
 
 namespace rocalution
@@ -46,12 +47,53 @@ namespace rocalution
         HYB   = 7
     };
 
-    // Sparse Matrix - Sparse Compressed Row Format CSR
-    template <typename ValueType, typename IndexType>
+    // Format selector, not a storage format; conversions to AUTO select the format
+    // automatically (see LocalMatrix::ConvertToBest()). No matrix is ever stored in it,
+    // hence it has no entry in _matrix_format_names
+    const unsigned int AUTO = 8;
+
+    // Matrix format of a format name, returns false if the name is unknown
+    inline bool matrix_format_from_name(const std::string& name, unsigned int& matrix_format)
+    {
+        if(name == "AUTO")
+        {
+            matrix_format = AUTO;
+            return true;
+        }
+
+        for(unsigned int i = 0; i < sizeof(_matrix_format_names) / sizeof(_matrix_format_names[0]);
+            ++i)
+        {
+            if(name == _matrix_format_names[i])
+            {
+                matrix_format = i;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Name of a matrix format or of the AUTO selector
+    inline std::string matrix_format_name(unsigned int matrix_format)
+    {
+        if(matrix_format == AUTO)
+        {
+            return "AUTO";
+        }
+
+        assert(matrix_format < sizeof(_matrix_format_names) / sizeof(_matrix_format_names[0]));
+
+        return _matrix_format_names[matrix_format];
+    }
+
+    // Sparse Matrix - Sparse Compressed Row Format CSR, the row offsets can be wider than
+    // the column indices for matrices with more non-zero entries than IndexType can address
+    template <typename ValueType, typename IndexType, typename PointerType = IndexType>
     struct MatrixCSR
     {
         // Row offsets (row ptr)
-        IndexType* row_offset;
+        PointerType* row_offset;
 
         // Column index
         IndexType* col;
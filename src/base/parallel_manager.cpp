@@ -111,13 +111,13 @@ namespace rocalution
 
         if(this->recv_index_size_ > 0)
         {
-            free_host(&this->boundary_index_);
-
             this->recv_index_size_ = 0;
         }
 
         if(this->send_index_size_ > 0)
         {
+            free_host(&this->boundary_index_);
+
             this->send_index_size_ = 0;
         }
     }
@@ -262,7 +262,7 @@ namespace rocalution
     if(this->nsend_ > 0 && this->send_offset_index_ == NULL) return false;
     if(this->recv_index_size_ < 0) return false;
     if(this->send_index_size_ < 0) return false;
-    if(this->recv_index_size_ > 0 && this->boundary_index_ == NULL) return false;
+    if(this->send_index_size_ > 0 && this->boundary_index_ == NULL) return false;
         // clang-format on
 
         return true;
@@ -37,6 +37,8 @@ namespace rocalution
     class GlobalMatrix;
     template <typename ValueType>
     class GlobalVector;
+    template <typename ValueType>
+    class ReductionBatch;
 
     /** \ingroup backend_module
   * \brief Parallel Manager class
@@ -143,6 +145,10 @@ namespace rocalution
         friend class GlobalVector<std::complex<double>>;
         friend class GlobalVector<std::complex<float>>;
         friend class GlobalVector<int>;
+        friend class ReductionBatch<double>;
+        friend class ReductionBatch<float>;
+        friend class ReductionBatch<std::complex<double>>;
+        friend class ReductionBatch<std::complex<float>>;
     };
 
 } // namespace rocalution
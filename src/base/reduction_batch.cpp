@@ -0,0 +1,301 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "reduction_batch.hpp"
+#include "../utils/def.hpp"
+#include "../utils/log.hpp"
+#include "global_vector.hpp"
+#include "local_vector.hpp"
+
+#ifdef SUPPORT_MULTINODE
+#include "../utils/communicator.hpp"
+#endif
+
+#include <complex>
+#include <math.h>
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    ReductionBatch<ValueType>::ReductionBatch()
+    {
+        log_debug(this, "ReductionBatch::ReductionBatch()");
+
+        this->comm_    = NULL;
+        this->request_ = NULL;
+
+        this->started_   = false;
+        this->completed_ = false;
+    }
+
+    template <typename ValueType>
+    ReductionBatch<ValueType>::~ReductionBatch()
+    {
+        log_debug(this, "ReductionBatch::~ReductionBatch()");
+
+        this->Clear();
+    }
+
+    template <typename ValueType>
+    void ReductionBatch<ValueType>::Clear(void)
+    {
+        log_debug(this, "ReductionBatch::Clear()");
+
+        // Pending reductions need to be completed before the buffers can be released
+        if(this->started_ == true && this->completed_ == false)
+        {
+            this->Wait();
+        }
+
+#ifdef SUPPORT_MULTINODE
+        if(this->request_ != NULL)
+        {
+            delete this->request_;
+            this->request_ = NULL;
+        }
+#endif
+
+        this->send_.clear();
+        this->recv_.clear();
+        this->pos_.clear();
+        this->sqrt_.clear();
+        this->result_.clear();
+
+        this->comm_ = NULL;
+
+        this->started_   = false;
+        this->completed_ = false;
+    }
+
+    template <typename ValueType>
+    int ReductionBatch<ValueType>::GetSize(void) const
+    {
+        return static_cast<int>(this->pos_.size());
+    }
+
+    template <typename ValueType>
+    int ReductionBatch<ValueType>::Dot(const LocalVector<ValueType>& x,
+                                       const LocalVector<ValueType>& y)
+    {
+        log_debug(this, "ReductionBatch::Dot()", (const void*&)x, (const void*&)y);
+
+        return this->Value(x.Dot(y));
+    }
+
+    template <typename ValueType>
+    int ReductionBatch<ValueType>::Dot(const GlobalVector<ValueType>& x,
+                                       const GlobalVector<ValueType>& y)
+    {
+        log_debug(this, "ReductionBatch::Dot()", (const void*&)x, (const void*&)y);
+
+        return this->enqueue_(x.vector_interior_.Dot(y.vector_interior_), false, x.pm_->comm_);
+    }
+
+    template <typename ValueType>
+    int ReductionBatch<ValueType>::DotNonConj(const LocalVector<ValueType>& x,
+                                              const LocalVector<ValueType>& y)
+    {
+        log_debug(this, "ReductionBatch::DotNonConj()", (const void*&)x, (const void*&)y);
+
+        return this->Value(x.DotNonConj(y));
+    }
+
+    template <typename ValueType>
+    int ReductionBatch<ValueType>::DotNonConj(const GlobalVector<ValueType>& x,
+                                              const GlobalVector<ValueType>& y)
+    {
+        log_debug(this, "ReductionBatch::DotNonConj()", (const void*&)x, (const void*&)y);
+
+        return this->enqueue_(
+            x.vector_interior_.DotNonConj(y.vector_interior_), false, x.pm_->comm_);
+    }
+
+    template <typename ValueType>
+    int ReductionBatch<ValueType>::Norm(const LocalVector<ValueType>& x)
+    {
+        log_debug(this, "ReductionBatch::Norm()", (const void*&)x);
+
+        return this->Value(x.Norm());
+    }
+
+    template <typename ValueType>
+    int ReductionBatch<ValueType>::Norm(const GlobalVector<ValueType>& x)
+    {
+        log_debug(this, "ReductionBatch::Norm()", (const void*&)x);
+
+        return this->enqueue_(x.vector_interior_.Dot(x.vector_interior_), true, x.pm_->comm_);
+    }
+
+    template <typename ValueType>
+    int ReductionBatch<ValueType>::Reduce(const LocalVector<ValueType>& x)
+    {
+        log_debug(this, "ReductionBatch::Reduce()", (const void*&)x);
+
+        return this->Value(x.Reduce());
+    }
+
+    template <typename ValueType>
+    int ReductionBatch<ValueType>::Reduce(const GlobalVector<ValueType>& x)
+    {
+        log_debug(this, "ReductionBatch::Reduce()", (const void*&)x);
+
+        return this->enqueue_(x.vector_interior_.Reduce(), false, x.pm_->comm_);
+    }
+
+    template <typename ValueType>
+    int ReductionBatch<ValueType>::Asum(const LocalVector<ValueType>& x)
+    {
+        log_debug(this, "ReductionBatch::Asum()", (const void*&)x);
+
+        return this->Value(x.Asum());
+    }
+
+    template <typename ValueType>
+    int ReductionBatch<ValueType>::Asum(const GlobalVector<ValueType>& x)
+    {
+        log_debug(this, "ReductionBatch::Asum()", (const void*&)x);
+
+        return this->enqueue_(x.vector_interior_.Asum(), false, x.pm_->comm_);
+    }
+
+    template <typename ValueType>
+    int ReductionBatch<ValueType>::Value(ValueType value)
+    {
+        log_debug(this, "ReductionBatch::Value()", value);
+
+        assert(this->started_ == false);
+
+        this->pos_.push_back(-1);
+        this->sqrt_.push_back(false);
+        this->result_.push_back(value);
+
+        return static_cast<int>(this->pos_.size()) - 1;
+    }
+
+    template <typename ValueType>
+    int ReductionBatch<ValueType>::enqueue_(ValueType local, bool sqrt, const void* comm)
+    {
+        assert(this->started_ == false);
+
+        // All global reductions of a batch need to share the same communicator
+        assert(this->comm_ == NULL || this->comm_ == comm);
+
+        this->comm_ = comm;
+
+        this->pos_.push_back(static_cast<int>(this->send_.size()));
+        this->sqrt_.push_back(sqrt);
+        this->result_.push_back(static_cast<ValueType>(0));
+
+        this->send_.push_back(local);
+
+        return static_cast<int>(this->pos_.size()) - 1;
+    }
+
+    template <typename ValueType>
+    void ReductionBatch<ValueType>::Start(void)
+    {
+        log_debug(this, "ReductionBatch::Start()");
+
+        assert(this->started_ == false);
+
+        this->started_ = true;
+        this->recv_.resize(this->send_.size());
+
+        if(this->send_.size() == 0)
+        {
+            return;
+        }
+
+#ifdef SUPPORT_MULTINODE
+        if(this->request_ == NULL)
+        {
+            this->request_ = new MRequest;
+        }
+
+        communication_async_allreduce_sum(this->send_.data(),
+                                          this->recv_.data(),
+                                          static_cast<int>(this->send_.size()),
+                                          this->request_,
+                                          this->comm_);
+#else
+        this->recv_ = this->send_;
+#endif
+    }
+
+    template <typename ValueType>
+    void ReductionBatch<ValueType>::Wait(void)
+    {
+        log_debug(this, "ReductionBatch::Wait()");
+
+        if(this->completed_ == true)
+        {
+            return;
+        }
+
+        if(this->started_ == false)
+        {
+            this->Start();
+        }
+
+#ifdef SUPPORT_MULTINODE
+        if(this->send_.size() > 0)
+        {
+            communication_syncall(1, this->request_);
+        }
+#endif
+
+        for(size_t i = 0; i < this->pos_.size(); ++i)
+        {
+            if(this->pos_[i] < 0)
+            {
+                continue;
+            }
+
+            ValueType sum = this->recv_[this->pos_[i]];
+
+            this->result_[i] = this->sqrt_[i] ? std::sqrt(sum) : sum;
+        }
+
+        this->completed_ = true;
+    }
+
+    template <typename ValueType>
+    ValueType ReductionBatch<ValueType>::Get(int handle) const
+    {
+        assert(handle >= 0);
+        assert(handle < this->GetSize());
+        assert(this->completed_ == true || this->pos_[handle] < 0);
+
+        return this->result_[handle];
+    }
+
+    template class ReductionBatch<double>;
+    template class ReductionBatch<float>;
+#ifdef SUPPORT_COMPLEX
+    template class ReductionBatch<std::complex<double>>;
+    template class ReductionBatch<std::complex<float>>;
+#endif
+
+} // namespace rocalution
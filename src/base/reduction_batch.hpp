@@ -0,0 +1,149 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_REDUCTION_BATCH_HPP_
+#define ROCALUTION_REDUCTION_BATCH_HPP_
+
+#include <vector>
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    class LocalVector;
+    template <typename ValueType>
+    class GlobalVector;
+    struct MRequest;
+
+    /** \ingroup op_vec_module
+  * \class ReductionBatch
+  * \brief Batch of global reductions
+  * \details
+  * Each GlobalVector::Dot(), GlobalVector::Norm(), GlobalVector::Reduce() and
+  * GlobalVector::Asum() performs its own global reduction over all processes. The
+  * reduction batch collects several local partial results first and reduces all of them
+  * with a single (non-blocking) collective operation. Each enqueued reduction returns a
+  * handle that can be used to access its result, once the batch has been completed by
+  * Wait().
+  *
+  * Handles are assigned consecutively, starting from zero after Clear(). For local
+  * vectors, the result is computed immediately when it is enqueued.
+  *
+  * \code{.cpp}
+  *   ReductionBatch<ValueType> batch;
+  *
+  *   int rho = batch.Dot(r0, r);
+  *   int res = batch.Norm(r);
+  *
+  *   batch.Start();
+  *   // Do some independent work here
+  *   batch.Wait();
+  *
+  *   std::cout << batch.Get(rho) << " " << batch.Get(res) << std::endl;
+  * \endcode
+  *
+  * \tparam ValueType - can be float, double, std::complex<float> and
+  *                     std::complex<double>
+  */
+    template <typename ValueType>
+    class ReductionBatch
+    {
+    public:
+        ReductionBatch();
+        ~ReductionBatch();
+
+        /** \brief Clear all enqueued reductions */
+        void Clear(void);
+
+        /** \brief Return the number of enqueued reductions */
+        int GetSize(void) const;
+
+        /** \brief Enqueue the dot product of two vectors and return its handle */
+        int Dot(const LocalVector<ValueType>& x, const LocalVector<ValueType>& y);
+        /** \brief Enqueue the dot product of two vectors and return its handle */
+        int Dot(const GlobalVector<ValueType>& x, const GlobalVector<ValueType>& y);
+        /** \brief Enqueue the non-conjugate dot product of two vectors and return its
+      * handle
+      */
+        int DotNonConj(const LocalVector<ValueType>& x, const LocalVector<ValueType>& y);
+        /** \brief Enqueue the non-conjugate dot product of two vectors and return its
+      * handle
+      */
+        int DotNonConj(const GlobalVector<ValueType>& x, const GlobalVector<ValueType>& y);
+        /** \brief Enqueue the L2 norm of a vector and return its handle */
+        int Norm(const LocalVector<ValueType>& x);
+        /** \brief Enqueue the L2 norm of a vector and return its handle */
+        int Norm(const GlobalVector<ValueType>& x);
+        /** \brief Enqueue the sum of all elements of a vector and return its handle */
+        int Reduce(const LocalVector<ValueType>& x);
+        /** \brief Enqueue the sum of all elements of a vector and return its handle */
+        int Reduce(const GlobalVector<ValueType>& x);
+        /** \brief Enqueue the absolute sum of a vector and return its handle */
+        int Asum(const LocalVector<ValueType>& x);
+        /** \brief Enqueue the absolute sum of a vector and return its handle */
+        int Asum(const GlobalVector<ValueType>& x);
+        /** \brief Enqueue a value that does not need to be reduced and return its handle */
+        int Value(ValueType value);
+
+        /** \brief Start the reduction of all enqueued values
+      * \details
+      * When multinode support is enabled, all local partial results are reduced by a
+      * single non-blocking collective operation. No further reductions can be enqueued
+      * until the batch is cleared.
+      */
+        void Start(void);
+        /** \brief Complete the reduction, calls Start() if required */
+        void Wait(void);
+
+        /** \brief Return the result of an enqueued reduction, the batch needs to be
+      * completed
+      */
+        ValueType Get(int handle) const;
+
+    private:
+        // Enqueue a local partial result that is summed up over all processes of comm
+        int enqueue_(ValueType local, bool sqrt, const void* comm);
+
+        // Local partial results and their global sums
+        std::vector<ValueType> send_;
+        std::vector<ValueType> recv_;
+
+        // Position of each result in the reduction buffers, -1 if the result is final
+        std::vector<int> pos_;
+        // Take the square root of the global sum
+        std::vector<bool> sqrt_;
+        // Results
+        std::vector<ValueType> result_;
+
+        // Communicator of the enqueued global vectors
+        const void* comm_;
+        MRequest*   request_;
+
+        bool started_;
+        bool completed_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_REDUCTION_BATCH_HPP_
@@ -30,12 +30,17 @@ namespace rocalution
 {
 
     // Stencil Names
-    const std::string _stencil_type_names[1] = {"Laplace2D"};
+    const std::string _stencil_type_names[5]
+        = {"Laplace2D", "Laplace3D", "Laplace2D9", "Laplace3D27", "General"};
 
     // Stencil Enumeration
     enum _stencil_type
     {
-        Laplace2D = 0
+        Laplace2D   = 0, // 2D 5-point Laplacian
+        Laplace3D   = 1, // 3D 7-point Laplacian
+        Laplace2D9  = 2, // 2D 9-point Laplacian
+        Laplace3D27 = 3, // 3D 27-point Laplacian
+        General     = 4 // user defined offsets and coefficients, see LocalStencil::SetStencil()
     };
 
 } // namespace rocalution
@@ -83,13 +83,23 @@ namespace rocalution
         /** \brief Set all values of the vector to given argument */
         virtual void SetValues(ValueType val) = 0;
 
-        /** \brief Fill the vector with random values from interval [a,b] */
+        /** \brief Fill the vector with random values from interval [a,b]
+      * \details
+      * The values are drawn from a counter-based random number generator (Philox4x32-10)
+      * \cite philox, the i-th (global) entry only depends on \p seed and i. Thus, the
+      * values do not depend on the number of threads or, for a GlobalVector, on the
+      * number of processes.
+      */
         virtual void SetRandomUniform(unsigned long long seed,
                                       ValueType          a = static_cast<ValueType>(-1),
                                       ValueType          b = static_cast<ValueType>(1))
             = 0;
 
-        /** \brief Fill the vector with random values from normal distribution */
+        /** \brief Fill the vector with random values from normal distribution
+      * \details
+      * The values are computed from the same random stream as SetRandomUniform() by the
+      * Box-Muller transform, scaled by \p var and shifted by \p mean.
+      */
         virtual void SetRandomNormal(unsigned long long seed,
                                      ValueType          mean = static_cast<ValueType>(0),
                                      ValueType          var  = static_cast<ValueType>(1))
@@ -132,6 +142,7 @@ namespace rocalution
         /** \brief Read vector from binary file
       * \details
       * Read a vector from binary file. For details on the format, see WriteFileBinary().
+      * Files written by previous versions of rocALUTION can be read as well.
       *
       * @param[in]
       * filename    name of the file containing the data.
@@ -148,23 +159,9 @@ namespace rocalution
       * \details
       * Write a vector to binary file.
       *
-      * The binary format contains a header, the rocALUTION version and the vector data
-      * as follows
-      * \code{.cpp}
-      *   // Header
-      *   out << "#rocALUTION binary vector file" << std::endl;
-      *
-      *   // rocALUTION version
-      *   out.write((char*)&version, sizeof(int));
-      *
-      *   // Vector data
-      *   out.write((char*)&size, sizeof(int));
-      *   out.write((char*)vec_val, size * sizeof(double));
-      * \endcode
-      *
-      * \note
-      * Vector values array is always stored in double precision (e.g. double or
-      * std::complex<double>).
+      * The binary format is the container described in LocalMatrix::WriteFileCSR(),
+      * with header line "#rocALUTION binary vector file v2", m = nnz = size, n = 1 and a
+      * single section holding the vector values in native precision.
       *
       * @param[in]
       * filename    name of the file to write the data to.
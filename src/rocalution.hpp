@@ -38,10 +38,12 @@
 
 #include "base/global_matrix.hpp"
 #include "base/local_matrix.hpp"
+#include "base/local_matrix_free.hpp"
 #include "base/matrix_formats.hpp"
 
 #include "base/global_vector.hpp"
 #include "base/local_vector.hpp"
+#include "base/reduction_batch.hpp"
 
 #include "base/local_stencil.hpp"
 #include "base/stencil_types.hpp"
@@ -53,14 +55,20 @@
 #include "solvers/iter_ctrl.hpp"
 #include "solvers/krylov/bicgstab.hpp"
 #include "solvers/krylov/bicgstabl.hpp"
+#include "solvers/krylov/cacg.hpp"
+#include "solvers/krylov/cagmres.hpp"
 #include "solvers/krylov/cg.hpp"
 #include "solvers/krylov/cr.hpp"
+#include "solvers/krylov/deflated_cg.hpp"
 #include "solvers/krylov/fcg.hpp"
 #include "solvers/krylov/fgmres.hpp"
+#include "solvers/krylov/gcrodr.hpp"
 #include "solvers/krylov/gmres.hpp"
 #include "solvers/krylov/idr.hpp"
 #include "solvers/krylov/qmrcgstab.hpp"
+#include "solvers/krylov/s_step.hpp"
 #include "solvers/mixed_precision.hpp"
+#include "solvers/multicolored_sor.hpp"
 #include "solvers/multigrid/base_amg.hpp"
 #include "solvers/multigrid/base_multigrid.hpp"
 #include "solvers/multigrid/global_pairwise_amg.hpp"
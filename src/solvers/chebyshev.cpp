@@ -26,27 +26,102 @@
 #include "iter_ctrl.hpp"
 
 #include "../base/local_matrix.hpp"
+#include "../base/local_matrix_free.hpp"
 #include "../base/local_stencil.hpp"
 #include "../base/local_vector.hpp"
 
 #include "../base/global_matrix.hpp"
 #include "../base/global_vector.hpp"
 
+#include "preconditioners/preconditioner.hpp"
+
 #include "../utils/log.hpp"
 #include "../utils/math_functions.hpp"
 
 #include <complex>
 #include <math.h>
+#include <vector>
 
 namespace rocalution
 {
 
+    // The matrix powers kernel can apply the inverse diagonal of a Jacobi preconditioner
+    // to LocalMatrix operators
+    template <typename ValueType>
+    static bool jacobi_scale_(
+        const LocalMatrix<ValueType>&                                            op,
+        const Solver<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>* precond,
+        LocalVector<ValueType>*                                                  inv_diag)
+    {
+        typedef Jacobi<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType> JacobiType;
+
+        if(precond == NULL || dynamic_cast<const JacobiType*>(precond) == NULL)
+        {
+            return false;
+        }
+
+        op.ExtractInverseDiagonal(inv_diag);
+
+        return true;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    static bool jacobi_scale_(const OperatorType&                                op,
+                              const Solver<OperatorType, VectorType, ValueType>* precond,
+                              VectorType*                                        inv_diag)
+    {
+        return false;
+    }
+
+    // Matrix powers kernel of LocalMatrix operators in CSR format
+    template <typename ValueType>
+    static bool polynomial_(const LocalMatrix<ValueType>& op,
+                            int                           k,
+                            const ValueType*              alpha,
+                            const ValueType*              beta,
+                            const ValueType*              gamma,
+                            const ValueType*              weight,
+                            const LocalVector<ValueType>* scale,
+                            const LocalVector<ValueType>& in,
+                            LocalVector<ValueType>*       out)
+    {
+        if(op.GetFormat() != CSR)
+        {
+            return false;
+        }
+
+        op.MatrixPolynomial(k, alpha, beta, gamma, weight, scale, in, out);
+
+        return true;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    static bool polynomial_(const OperatorType& op,
+                            int                 k,
+                            const ValueType*    alpha,
+                            const ValueType*    beta,
+                            const ValueType*    gamma,
+                            const ValueType*    weight,
+                            const VectorType*   scale,
+                            const VectorType&   in,
+                            VectorType*         out)
+    {
+        return false;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     Chebyshev<OperatorType, VectorType, ValueType>::Chebyshev()
     {
         log_debug(this, "Chebyshev::Chebyshev()");
 
         this->init_lambda_ = false;
+
+        this->est_lambda_ = false;
+        this->est_iter_   = 10;
+        this->est_ratio_  = 30.0;
+
+        this->fixed_degree_   = false;
+        this->inv_diag_valid_ = false;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -67,6 +142,30 @@ namespace rocalution
         this->lambda_max_ = lambda_max;
 
         this->init_lambda_ = true;
+        this->est_lambda_  = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Chebyshev<OperatorType, VectorType, ValueType>::SetEigenvalueEstimation(int    iter,
+                                                                                 double ratio)
+    {
+        log_debug(this, "Chebyshev::SetEigenvalueEstimation()", iter, ratio);
+
+        assert(iter > 0);
+        assert(ratio > 1.0);
+
+        this->est_iter_  = iter;
+        this->est_ratio_ = ratio;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Chebyshev<OperatorType, VectorType, ValueType>::SetFixedDegree(bool fixed_degree)
+    {
+        log_debug(this, "Chebyshev::SetFixedDegree()", fixed_degree);
+
+        assert(this->build_ == false);
+
+        this->fixed_degree_ = fixed_degree;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -142,6 +241,79 @@ namespace rocalution
 
         this->p_.CloneBackend(*this->op_);
         this->p_.Allocate("p", this->op_->GetM());
+
+        if(this->init_lambda_ == false)
+        {
+            this->EstimateEigenvalues_();
+        }
+
+        if(this->fixed_degree_ == true)
+        {
+            this->inv_diag_.CloneBackend(*this->op_);
+            this->inv_diag_valid_ = jacobi_scale_(*this->op_, this->precond_, &this->inv_diag_);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Chebyshev<OperatorType, VectorType, ValueType>::EstimateEigenvalues_(void)
+    {
+        log_debug(this, "Chebyshev::EstimateEigenvalues_()", this->est_iter_, this->est_ratio_);
+
+        assert(this->op_ != NULL);
+        assert(this->est_iter_ > 0);
+
+        VectorType* v = &this->p_;
+        VectorType* w = &this->r_;
+        VectorType* z = (this->precond_ != NULL) ? &this->z_ : &this->r_;
+
+        // Random start vector, such that all eigenvectors are present
+        v->SetRandomUniform(12345ULL, static_cast<ValueType>(-1), static_cast<ValueType>(1));
+        v->Scale(static_cast<ValueType>(1) / v->Norm());
+
+        ValueType lambda = static_cast<ValueType>(0);
+
+        // Power iteration on M^-1 A
+        for(int i = 0; i < this->est_iter_; ++i)
+        {
+            // w = A v
+            this->op_->Apply(*v, w);
+
+            // z = M^-1 w
+            if(this->precond_ != NULL)
+            {
+                this->precond_->SolveZeroSol(*w, z);
+            }
+
+            lambda = z->Norm();
+
+            if(std::abs(lambda) == 0.0)
+            {
+                break;
+            }
+
+            // v = z / |z|
+            v->CopyFrom(*z);
+            v->Scale(static_cast<ValueType>(1) / lambda);
+        }
+
+        if(std::abs(lambda) == 0.0)
+        {
+            LOG_INFO("Chebyshev::Build() cannot estimate the eigenvalues of the operator");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        // Power iterations approach lambda_max from below
+        this->lambda_max_ = static_cast<ValueType>(1.1) * lambda;
+        this->lambda_min_ = this->lambda_max_ / static_cast<ValueType>(this->est_ratio_);
+
+        this->init_lambda_ = true;
+        this->est_lambda_  = true;
+
+        log_debug(this,
+                  "Chebyshev::EstimateEigenvalues_()",
+                  "lambda",
+                  this->lambda_min_,
+                  this->lambda_max_);
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -161,10 +333,19 @@ namespace rocalution
             this->z_.Clear();
             this->p_.Clear();
 
+            this->inv_diag_.Clear();
+            this->inv_diag_valid_ = false;
+
             this->iter_ctrl_.Clear();
 
-            this->build_       = false;
-            this->init_lambda_ = false;
+            this->build_ = false;
+
+            // Estimated eigenvalues belong to the operator
+            if(this->est_lambda_ == true)
+            {
+                this->init_lambda_ = false;
+                this->est_lambda_  = false;
+            }
         }
     }
 
@@ -181,13 +362,22 @@ namespace rocalution
 
             this->iter_ctrl_.Clear();
 
-            this->build_       = false;
-            this->init_lambda_ = false;
-
             if(this->precond_ != NULL)
             {
                 this->precond_->ReBuildNumeric();
             }
+
+            // Operator values might have changed, update the estimation
+            if(this->est_lambda_ == true)
+            {
+                this->EstimateEigenvalues_();
+            }
+
+            if(this->fixed_degree_ == true)
+            {
+                this->inv_diag_valid_
+                    = jacobi_scale_(*this->op_, this->precond_, &this->inv_diag_);
+            }
         }
         else
         {
@@ -204,6 +394,7 @@ namespace rocalution
         {
             this->r_.MoveToHost();
             this->p_.MoveToHost();
+            this->inv_diag_.MoveToHost();
 
             if(this->precond_ != NULL)
             {
@@ -221,6 +412,7 @@ namespace rocalution
         {
             this->r_.MoveToAccelerator();
             this->p_.MoveToAccelerator();
+            this->inv_diag_.MoveToAccelerator();
 
             if(this->precond_ != NULL)
             {
@@ -242,6 +434,15 @@ namespace rocalution
         assert(this->build_ == true);
         assert(this->init_lambda_ == true);
 
+        if(this->fixed_degree_ == true)
+        {
+            this->SolveFixedDegree_(rhs, x);
+
+            log_debug(this, "Chebyshev::SolveNonPrecond_()", " #*# end");
+
+            return;
+        }
+
         const OperatorType* op = this->op_;
 
         VectorType* r = &this->r_;
@@ -268,7 +469,8 @@ namespace rocalution
         // p = r
         p->CopyFrom(*r);
 
-        alpha = two / d;
+        // First step with the linear Chebyshev polynomial
+        alpha = static_cast<ValueType>(1) / d;
 
         // x = x + alpha*p
         x->AddScale(*p, alpha);
@@ -278,11 +480,13 @@ namespace rocalution
         r->ScaleAdd(static_cast<ValueType>(-1), rhs);
 
         res = this->Norm_(*r);
+
+        // beta_1 = (c*alpha_0)^2 / 2
+        beta = (c * alpha) * (c * alpha) / two;
+
         while(!this->iter_ctrl_.CheckResidual(std::abs(res), this->index_))
         {
-            beta = (c * alpha / two) * (c * alpha / two);
-
-            alpha = static_cast<ValueType>(1) / (d - beta);
+            alpha = static_cast<ValueType>(1) / (d - beta / alpha);
 
             // p = beta*p + r
             p->ScaleAdd(beta, *r);
@@ -294,6 +498,9 @@ namespace rocalution
             op->Apply(*x, r);
             r->ScaleAdd(static_cast<ValueType>(-1), rhs);
             res = this->Norm_(*r);
+
+            // beta_i = (c*alpha_i / 2)^2
+            beta = (c * alpha / two) * (c * alpha / two);
         }
 
         log_debug(this, "Chebyshev::SolveNonPrecond_()", " #*# end");
@@ -312,6 +519,15 @@ namespace rocalution
         assert(this->build_ == true);
         assert(this->init_lambda_ == true);
 
+        if(this->fixed_degree_ == true)
+        {
+            this->SolveFixedDegree_(rhs, x);
+
+            log_debug(this, "Chebyshev::SolvePrecond_()", " #*# end");
+
+            return;
+        }
+
         const OperatorType* op = this->op_;
 
         VectorType* r = &this->r_;
@@ -342,7 +558,8 @@ namespace rocalution
         // p = z
         p->CopyFrom(*z);
 
-        alpha = two / d;
+        // First step with the linear Chebyshev polynomial
+        alpha = static_cast<ValueType>(1) / d;
 
         // x = x + alpha*p
         x->AddScale(*p, alpha);
@@ -352,14 +569,15 @@ namespace rocalution
         r->ScaleAdd(static_cast<ValueType>(-1), rhs);
         res = this->Norm_(*r);
 
+        // beta_1 = (c*alpha_0)^2 / 2
+        beta = (c * alpha) * (c * alpha) / two;
+
         while(!this->iter_ctrl_.CheckResidual(std::abs(res), this->index_))
         {
             // Solve Mz=r
             this->precond_->SolveZeroSol(*r, z);
 
-            beta = (c * alpha / two) * (c * alpha / two);
-
-            alpha = static_cast<ValueType>(1) / (d - beta);
+            alpha = static_cast<ValueType>(1) / (d - beta / alpha);
 
             // p = beta*p + z
             p->ScaleAdd(beta, *z);
@@ -371,11 +589,137 @@ namespace rocalution
             op->Apply(*x, r);
             r->ScaleAdd(static_cast<ValueType>(-1), rhs);
             res = this->Norm_(*r);
+
+            // beta_i = (c*alpha_i / 2)^2
+            beta = (c * alpha / two) * (c * alpha / two);
         }
 
         log_debug(this, "Chebyshev::SolvePrecond_()", " #*# end");
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Chebyshev<OperatorType, VectorType, ValueType>::SolveFixedDegree_(const VectorType& rhs,
+                                                                           VectorType*       x)
+    {
+        log_debug(this, "Chebyshev::SolveFixedDegree_()", " #*# begin", (const void*&)rhs, x);
+
+        const OperatorType* op = this->op_;
+
+        VectorType* r = &this->r_;
+        VectorType* z = (this->precond_ != NULL) ? &this->z_ : &this->r_;
+        VectorType* p = &this->p_;
+
+        ValueType one = static_cast<ValueType>(1);
+        ValueType two = static_cast<ValueType>(2);
+        ValueType d   = (this->lambda_max_ + this->lambda_min_) / two;
+        ValueType c   = (this->lambda_max_ - this->lambda_min_) / two;
+
+        int m = this->iter_ctrl_.GetMaximumIterations();
+
+        // initial residual = b - Ax
+        op->Apply(*x, r);
+        r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+        ValueType res = this->Norm_(*r);
+
+        if(this->iter_ctrl_.InitResidual(std::abs(res)) == false || m < 1)
+        {
+            log_debug(this, "Chebyshev::SolveFixedDegree_()", " #*# end");
+
+            return;
+        }
+
+        // Coefficients of the Chebyshev iteration, alpha_0 = 1/d, beta_1 = (c*alpha_0)^2 / 2
+        // and beta_i = (c*alpha_i-1 / 2)^2
+        std::vector<ValueType> alpha(m);
+        std::vector<ValueType> beta(m);
+
+        alpha[0] = one / d;
+        beta[0]  = static_cast<ValueType>(0);
+
+        for(int i = 1; i < m; ++i)
+        {
+            beta[i] = (i == 1) ? (c * alpha[0]) * (c * alpha[0]) / two
+                               : (c * alpha[i - 1] / two) * (c * alpha[i - 1] / two);
+            alpha[i] = one / (d - beta[i] / alpha[i - 1]);
+        }
+
+        // The preconditioned residuals z_i of the iteration satisfy the three-term recurrence
+        // z_i+1 = -alpha_i M^-1 A z_i + (1 + mu_i) z_i - mu_i z_i-1 with
+        // mu_i = alpha_i beta_i / alpha_i-1, and x_m = x_0 + sum w_i z_i with
+        // w_m-1 = alpha_m-1 and w_i = alpha_i + beta_i+1 w_i+1
+        std::vector<ValueType> a(m);
+        std::vector<ValueType> b(m);
+        std::vector<ValueType> g(m);
+        std::vector<ValueType> w(m);
+
+        for(int i = 0; i < m; ++i)
+        {
+            ValueType mu = (i > 0) ? alpha[i] * beta[i] / alpha[i - 1] : static_cast<ValueType>(0);
+
+            a[i] = -alpha[i];
+            b[i] = one + mu;
+            g[i] = -mu;
+        }
+
+        w[m - 1] = alpha[m - 1];
+        for(int i = m - 2; i >= 0; --i)
+        {
+            w[i] = alpha[i] + beta[i + 1] * w[i + 1];
+        }
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SolveZeroSol(*r, z);
+        }
+
+        // Matrix powers kernel, z_0 is the preconditioned initial residual
+        if((this->precond_ == NULL || this->inv_diag_valid_ == true)
+           && polynomial_(*op,
+                          m - 1,
+                          a.data(),
+                          b.data(),
+                          g.data(),
+                          w.data(),
+                          (this->precond_ != NULL) ? &this->inv_diag_ : NULL,
+                          *z,
+                          p))
+        {
+            x->AddScale(*p, one);
+
+            log_debug(this, "Chebyshev::SolveFixedDegree_()", " #*# end");
+
+            return;
+        }
+
+        // p = z
+        p->CopyFrom(*z);
+
+        // x = x + alpha*p
+        x->AddScale(*p, alpha[0]);
+
+        for(int i = 1; i < m; ++i)
+        {
+            // compute residual = b - Ax
+            op->Apply(*x, r);
+            r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+            // Solve Mz=r
+            if(this->precond_ != NULL)
+            {
+                this->precond_->SolveZeroSol(*r, z);
+            }
+
+            // p = beta*p + z
+            p->ScaleAdd(beta[i], *z);
+
+            // x = x + alpha*p
+            x->AddScale(*p, alpha[i]);
+        }
+
+        log_debug(this, "Chebyshev::SolveFixedDegree_()", " #*# end");
+    }
+
     template class Chebyshev<LocalMatrix<double>, LocalVector<double>, double>;
     template class Chebyshev<LocalMatrix<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -409,4 +753,15 @@ namespace rocalution
                              std::complex<float>>;
 #endif
 
+    template class Chebyshev<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class Chebyshev<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class Chebyshev<LocalMatrixFree<std::complex<double>>,
+                             LocalVector<std::complex<double>>,
+                             std::complex<double>>;
+    template class Chebyshev<LocalMatrixFree<std::complex<float>>,
+                             LocalVector<std::complex<float>>,
+                             std::complex<float>>;
+#endif
+
 } // namespace rocalution
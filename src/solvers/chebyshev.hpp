@@ -39,7 +39,19 @@ namespace rocalution
   * CG method but requires minimum and maximum eigenvalues of the operator.
   * \cite templates
   *
-  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * If the eigenvalues are not provided via Set(), the maximum eigenvalue of the
+  * (preconditioned) operator is estimated by power iterations during Build(). The
+  * minimum eigenvalue is then chosen as a fraction of the maximum one, which targets
+  * the upper part of the spectrum. This is the typical setup when the Chebyshev
+  * iteration is used as smoother, e.g. with a Jacobi preconditioner inside of AMG.
+  *
+  * As smoother, the iteration can apply a Chebyshev polynomial of fixed degree, see
+  * SetFixedDegree(). For a LocalMatrix with a Jacobi or no preconditioner, the polynomial
+  * is then applied by the cache-blocked matrix powers kernel (see
+  * LocalMatrix::MatrixPolynomial()), which reads the matrix only twice per solve.
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil or
+  *                       LocalMatrixFree
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -55,6 +67,23 @@ namespace rocalution
         /** \brief Set the minimum and maximum eigenvalues of the operator */
         void Set(ValueType lambda_min, ValueType lambda_max);
 
+        /** \brief Set the parameters for the automatic eigenvalue estimation
+      * \details
+      * The maximum eigenvalue is estimated with \p iter power iterations and
+      * enlarged by 10%. The minimum eigenvalue is set to lambda_max / \p ratio.
+      * Default values are 10 iterations and a ratio of 30.
+      */
+        void SetEigenvalueEstimation(int iter, double ratio);
+
+        /** \brief Apply a Chebyshev polynomial of fixed degree
+      * \details
+      * If \p fixed_degree is set, Solve() performs exactly the maximum number of
+      * iterations of the iteration control, without computing the intermediate residuals.
+      * Only the initial residual is checked. This is the typical setup of a smoother. It
+      * has to be set before Build().
+      */
+        void SetFixedDegree(bool fixed_degree);
+
         virtual void Build(void);
         virtual void ReBuildNumeric(void);
         virtual void Clear(void);
@@ -69,12 +98,28 @@ namespace rocalution
         virtual void MoveToHostLocalData_(void);
         virtual void MoveToAcceleratorLocalData_(void);
 
+        /** \brief Estimate the eigenvalue interval by power iterations */
+        void EstimateEigenvalues_(void);
+
+        /** \brief Apply the Chebyshev polynomial of fixed degree to the initial residual */
+        void SolveFixedDegree_(const VectorType& rhs, VectorType* x);
+
     private:
         bool      init_lambda_;
         ValueType lambda_min_, lambda_max_;
 
+        bool   est_lambda_;
+        int    est_iter_;
+        double est_ratio_;
+
         VectorType r_, z_;
         VectorType p_;
+
+        // Fixed degree mode, the inverse diagonal of a Jacobi preconditioner is used as row
+        // scaling of the matrix powers kernel
+        bool       fixed_degree_;
+        bool       inv_diag_valid_;
+        VectorType inv_diag_;
     };
 
 } // namespace rocalution
@@ -26,6 +26,7 @@
 #include "../iter_ctrl.hpp"
 
 #include "../../base/local_matrix.hpp"
+#include "../../base/local_matrix_free.hpp"
 #include "../../base/local_stencil.hpp"
 #include "../../base/local_vector.hpp"
 
@@ -305,8 +306,13 @@ namespace rocalution
             // t = Ar
             op->Apply(*r, t);
 
-            // omega = <t,r> / <t,t>
-            omega = t->Dot(*r) / t->Dot(*t);
+            // omega = <t,r> / <t,t>, both reduced at once
+            this->batch_.Clear();
+            int tr_idx = this->batch_.Dot(*t, *r);
+            int tt_idx = this->batch_.Dot(*t, *t);
+            this->batch_.Wait();
+
+            omega = this->batch_.Get(tr_idx) / this->batch_.Get(tt_idx);
 
             if((std::abs(omega) == std::numeric_limits<ValueType>::infinity()) || (omega != omega)
                || (omega == static_cast<ValueType>(0)))
@@ -334,8 +340,14 @@ namespace rocalution
             // r = r - omega * t
             r->AddScale(*t, -omega);
 
+            // Reduce residual norm and rho = <r0,r> at once
+            this->batch_.Clear();
+            int res_idx = this->Norm_(*r, &this->batch_);
+            int rho_idx = this->batch_.Dot(*r0, *r);
+            this->batch_.Wait();
+
             // Check convergence
-            res_norm = this->Norm_(*r);
+            res_norm = this->batch_.Get(res_idx);
             if(this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
             {
                 break;
@@ -343,7 +355,7 @@ namespace rocalution
 
             // rho = <r0,r>
             rho_old = rho;
-            rho     = r0->Dot(*r);
+            rho     = this->batch_.Get(rho_idx);
 
             // Check rho for zero
             if(rho == static_cast<ValueType>(0))
@@ -431,8 +443,13 @@ namespace rocalution
             // t = Av
             op->Apply(*v, t);
 
-            // omega = (t,r) / (t,t)
-            omega = t->Dot(*r) / t->Dot(*t);
+            // omega = (t,r) / (t,t), both reduced at once
+            this->batch_.Clear();
+            int tr_idx = this->batch_.Dot(*t, *r);
+            int tt_idx = this->batch_.Dot(*t, *t);
+            this->batch_.Wait();
+
+            omega = this->batch_.Get(tr_idx) / this->batch_.Get(tt_idx);
 
             if((std::abs(omega) == std::numeric_limits<ValueType>::infinity()) || (omega != omega)
                || (omega == static_cast<ValueType>(0)))
@@ -453,14 +470,22 @@ namespace rocalution
                 break;
             }
 
+            // r = r - omega * t
+            r->AddScale(*t, -omega);
+
+            // Reduce residual norm and rho = <r0,r> at once, while x is updated
+            this->batch_.Clear();
+            int res_idx = this->Norm_(*r, &this->batch_);
+            int rho_idx = this->batch_.Dot(*r0, *r);
+            this->batch_.Start();
+
             // x = x + alpha * z + omega * v
             x->ScaleAdd2(static_cast<ValueType>(1), *z, alpha, *v, omega);
 
-            // r = r - omega * t
-            r->AddScale(*t, -omega);
+            this->batch_.Wait();
 
             // Check convergence
-            res_norm = this->Norm_(*r);
+            res_norm = this->batch_.Get(res_idx);
             if(this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
             {
                 break;
@@ -468,7 +493,7 @@ namespace rocalution
 
             // rho = <r0,r>
             rho_old = rho;
-            rho     = r0->Dot(*r);
+            rho     = this->batch_.Get(rho_idx);
 
             // Check rho for zero
             if(rho == static_cast<ValueType>(0))
@@ -523,4 +548,15 @@ namespace rocalution
                             std::complex<float>>;
 #endif
 
+    template class BiCGStab<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class BiCGStab<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class BiCGStab<LocalMatrixFree<std::complex<double>>,
+                            LocalVector<std::complex<double>>,
+                            std::complex<double>>;
+    template class BiCGStab<LocalMatrixFree<std::complex<float>>,
+                            LocalVector<std::complex<float>>,
+                            std::complex<float>>;
+#endif
+
 } // namespace rocalution
@@ -37,7 +37,8 @@ namespace rocalution
   * (non) symmetric linear systems \f$Ax=b\f$.
   * \cite SAAD
   *
-  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil or
+  *                       LocalMatrixFree
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -26,6 +26,7 @@
 #include "../iter_ctrl.hpp"
 
 #include "../../base/local_matrix.hpp"
+#include "../../base/local_matrix_free.hpp"
 #include "../../base/local_stencil.hpp"
 #include "../../base/local_vector.hpp"
 
@@ -331,6 +332,9 @@ namespace rocalution
         // u_0 = 0
         u[0]->Zeros();
 
+        // rho = (r_0, r0)
+        rho = r[0]->Dot(*r0);
+
         while(true)
         {
             rho_old *= -omega;
@@ -338,10 +342,7 @@ namespace rocalution
             // BiCG part
             for(int j = 0; j < l; ++j)
             {
-                // rho = (r_j, r0)
-                rho = r[j]->Dot(*r0);
-
-                // Check for breakdown
+                // Check rho = (r_j, r0) for breakdown
                 if(rho == static_cast<ValueType>(0))
                 {
                     LOG_INFO("BiCGStab(l) rho == 0 !!!");
@@ -387,11 +388,25 @@ namespace rocalution
                 // r_j+1 = A r_j
                 op->Apply(*r[j], r[j + 1]);
 
+                // Reduce residual norm and rho = (r_j+1, r0) of the next step at once, while
+                // x is updated
+                this->batch_.Clear();
+                int res_idx = this->Norm_(*r[0], &this->batch_);
+                int rho_idx = (j + 1 < l) ? this->batch_.Dot(*r[j + 1], *r0) : -1;
+                this->batch_.Start();
+
                 // x = x + alpha * u_0
                 x->AddScale(*u[0], alpha);
 
+                this->batch_.Wait();
+
+                if(j + 1 < l)
+                {
+                    rho = this->batch_.Get(rho_idx);
+                }
+
                 // Check convergence
-                res = this->Norm_(*r[0]);
+                res = this->batch_.Get(res_idx);
 
                 if(this->iter_ctrl_.CheckResidualNoCount(std::abs(res)))
                 {
@@ -418,11 +433,16 @@ namespace rocalution
                     r[j + 1]->AddScale(*r[i + 1], -tau[i][j]);
                 }
 
-                // sigma_j = (r_j+1, r_j+1)
-                sigma[j] = r[j + 1]->Dot(*r[j + 1]);
+                // sigma_j = (r_j+1, r_j+1) and (r_0, r_j+1) are reduced at once
+                this->batch_.Clear();
+                int sigma_idx = this->batch_.Dot(*r[j + 1], *r[j + 1]);
+                int gamma_idx = this->batch_.Dot(*r[0], *r[j + 1]);
+                this->batch_.Wait();
+
+                sigma[j] = this->batch_.Get(sigma_idx);
 
                 // gamma' = (r_0, r_j+1) / sigma_j
-                gamma1[j] = r[0]->Dot(*r[j + 1]) / sigma[j];
+                gamma1[j] = this->batch_.Get(gamma_idx) / sigma[j];
             }
 
             // omega = gamma'_l-1; gamma_l-1 = gamma'_l-1
@@ -472,7 +492,14 @@ namespace rocalution
                 r[0]->AddScale(*r[j], -gamma1[j - 1]);
             }
 
-            res = this->Norm_(*r[0]);
+            // Reduce residual norm and rho = (r_0, r0) of the next iteration at once
+            this->batch_.Clear();
+            int res_idx = this->Norm_(*r[0], &this->batch_);
+            int rho_idx = this->batch_.Dot(*r[0], *r0);
+            this->batch_.Wait();
+
+            res = this->batch_.Get(res_idx);
+            rho = this->batch_.Get(rho_idx);
 
             if(this->iter_ctrl_.CheckResidual(std::abs(res), this->index_))
             {
@@ -535,6 +562,9 @@ namespace rocalution
         // u_0 = 0
         u[0]->Zeros();
 
+        // rho = (r_0, r0)
+        rho = r[0]->Dot(*r0);
+
         while(true)
         {
             rho_old *= -omega;
@@ -542,10 +572,7 @@ namespace rocalution
             // BiCG part
             for(int j = 0; j < l; ++j)
             {
-                // rho = (r_j, r0)
-                rho = r[j]->Dot(*r0);
-
-                // Check for breakdown
+                // Check rho = (r_j, r0) for breakdown
                 if(rho == static_cast<ValueType>(0))
                 {
                     LOG_INFO("BiCGStab(l) rho == 0 !!!");
@@ -597,11 +624,25 @@ namespace rocalution
                 // M r_j+1 = z
                 this->precond_->SolveZeroSol(*z, r[j + 1]);
 
+                // Reduce residual norm and rho = (r_j+1, r0) of the next step at once, while
+                // x is updated
+                this->batch_.Clear();
+                int res_idx = this->Norm_(*r[0], &this->batch_);
+                int rho_idx = (j + 1 < l) ? this->batch_.Dot(*r[j + 1], *r0) : -1;
+                this->batch_.Start();
+
                 // x = x + alpha * u_0
                 x->AddScale(*u[0], alpha);
 
+                this->batch_.Wait();
+
+                if(j + 1 < l)
+                {
+                    rho = this->batch_.Get(rho_idx);
+                }
+
                 // Check convergence
-                res = this->Norm_(*r[0]);
+                res = this->batch_.Get(res_idx);
 
                 if(this->iter_ctrl_.CheckResidualNoCount(std::abs(res)))
                 {
@@ -628,11 +669,16 @@ namespace rocalution
                     r[j + 1]->AddScale(*r[i + 1], -tau[i][j]);
                 }
 
-                // sigma_j = (r_j+1, r_j+1)
-                sigma[j] = r[j + 1]->Dot(*r[j + 1]);
+                // sigma_j = (r_j+1, r_j+1) and (r_0, r_j+1) are reduced at once
+                this->batch_.Clear();
+                int sigma_idx = this->batch_.Dot(*r[j + 1], *r[j + 1]);
+                int gamma_idx = this->batch_.Dot(*r[0], *r[j + 1]);
+                this->batch_.Wait();
+
+                sigma[j] = this->batch_.Get(sigma_idx);
 
                 // gamma' = (r_0, r_j+1) / sigma_j
-                gamma1[j] = r[0]->Dot(*r[j + 1]) / sigma[j];
+                gamma1[j] = this->batch_.Get(gamma_idx) / sigma[j];
             }
 
             // omega = gamma'_l-1; gamma_l-1 = gamma'_l-1
@@ -682,7 +728,14 @@ namespace rocalution
                 r[0]->AddScale(*r[j], -gamma1[j - 1]);
             }
 
-            res = this->Norm_(*r[0]);
+            // Reduce residual norm and rho = (r_0, r0) of the next iteration at once
+            this->batch_.Clear();
+            int res_idx = this->Norm_(*r[0], &this->batch_);
+            int rho_idx = this->batch_.Dot(*r[0], *r0);
+            this->batch_.Wait();
+
+            res = this->batch_.Get(res_idx);
+            rho = this->batch_.Get(rho_idx);
 
             if(this->iter_ctrl_.CheckResidual(std::abs(res), this->index_))
             {
@@ -715,4 +768,15 @@ namespace rocalution
                              std::complex<float>>;
 #endif
 
+    template class BiCGStabl<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class BiCGStabl<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class BiCGStabl<LocalMatrixFree<std::complex<double>>,
+                             LocalVector<std::complex<double>>,
+                             std::complex<double>>;
+    template class BiCGStabl<LocalMatrixFree<std::complex<float>>,
+                             LocalVector<std::complex<float>>,
+                             std::complex<float>>;
+#endif
+
 } // namespace rocalution
@@ -40,7 +40,7 @@ namespace rocalution
   * \f$l\f$-dimensional Krylov subspaces. The degree \f$l\f$ can be set with SetOrder().
   * \cite bicgstabl
   *
-  * \tparam OperatorType - can be LocalMatrix or GlobalMatrix
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalMatrixFree
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -0,0 +1,830 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "cacg.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+#include "recycle.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_matrix_free.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+#include "../../base/matrix_formats_ind.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <complex>
+#include <math.h>
+#include <vector>
+
+namespace rocalution
+{
+
+    static inline float conj_(float val)
+    {
+        return val;
+    }
+
+    static inline double conj_(double val)
+    {
+        return val;
+    }
+
+    template <typename T>
+    static inline std::complex<T> conj_(const std::complex<T>& val)
+    {
+        return std::conj(val);
+    }
+
+    static inline bool is_complex_(float)
+    {
+        return false;
+    }
+
+    static inline bool is_complex_(double)
+    {
+        return false;
+    }
+
+    template <typename T>
+    static inline bool is_complex_(const std::complex<T>&)
+    {
+        return true;
+    }
+
+    // out = sum_i c_i Y_i (or out += sum_i c_i Y_i if add is set), two vectors per pass
+    template <class VectorType, typename ValueType>
+    static void combine_(int n, VectorType** Y, const ValueType* c, bool add, VectorType* out)
+    {
+        ValueType zero = static_cast<ValueType>(0);
+        ValueType one  = static_cast<ValueType>(1);
+
+        int i = 0;
+
+        if(add == false)
+        {
+            out->ScaleAddScale(zero, *Y[0], c[0]);
+            i = 1;
+        }
+
+        for(; i + 1 < n; i += 2)
+        {
+            if(c[i] != zero || c[i + 1] != zero)
+            {
+                out->ScaleAdd2(one, *Y[i], c[i], *Y[i + 1], c[i + 1]);
+            }
+        }
+
+        if(i < n && c[i] != zero)
+        {
+            out->AddScale(*Y[i], c[i]);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    CACG<OperatorType, VectorType, ValueType>::CACG()
+    {
+        log_debug(this, "CACG::CACG()", "default constructor");
+
+        this->Y_  = NULL;
+        this->Yt_ = NULL;
+
+        this->G_ = NULL;
+        this->N_ = NULL;
+        this->B_ = NULL;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    CACG<OperatorType, VectorType, ValueType>::~CACG()
+    {
+        log_debug(this, "CACG::~CACG()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CACG<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("CACG solver");
+        }
+        else
+        {
+            LOG_INFO("CACG solver, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CACG<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("CACG(" << this->step_size_ << ") (non-precond) linear solver starts");
+        }
+        else
+        {
+            LOG_INFO("CACG(" << this->step_size_ << ") solver starts, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CACG<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("CACG(" << this->step_size_ << ") (non-precond) ends");
+        }
+        else
+        {
+            LOG_INFO("CACG(" << this->step_size_ << ") ends");
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CACG<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "CACG::Build()", this->build_, " #*# begin");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() > 0);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->step_size_ > 0);
+
+        if(this->res_norm_ != 2)
+        {
+            LOG_INFO(
+                "CACG solver supports only L2 residual norm. The solver is switching to L2 norm");
+            this->res_norm_ = 2;
+        }
+
+        int n = 2 * this->step_size_ + 1;
+
+        this->r_.CloneBackend(*this->op_);
+        this->r_.Allocate("r", this->op_->GetM());
+
+        this->p_.CloneBackend(*this->op_);
+        this->p_.Allocate("p", this->op_->GetM());
+
+        this->q_.CloneBackend(*this->op_);
+        this->q_.Allocate("q", this->op_->GetM());
+
+        this->Y_ = new VectorType*[n];
+
+        for(int i = 0; i < n; ++i)
+        {
+            this->Y_[i] = new VectorType;
+            this->Y_[i]->CloneBackend(*this->op_);
+            this->Y_[i]->Allocate("y", this->op_->GetM());
+        }
+
+        allocate_host(n * n, &this->G_);
+        allocate_host(n * n, &this->N_);
+        allocate_host(n * n, &this->B_);
+
+        if(this->precond_ != NULL)
+        {
+            this->z_.CloneBackend(*this->op_);
+            this->z_.Allocate("z", this->op_->GetM());
+
+            this->t_.CloneBackend(*this->op_);
+            this->t_.Allocate("t", this->op_->GetM());
+
+            this->Yt_ = new VectorType*[n];
+
+            for(int i = 0; i < n; ++i)
+            {
+                this->Yt_[i] = new VectorType;
+                this->Yt_[i]->CloneBackend(*this->op_);
+                this->Yt_[i]->Allocate("yt", this->op_->GetM());
+            }
+
+            this->precond_->SetOperator(*this->op_);
+            this->precond_->Build();
+        }
+
+        this->BuildBasis_();
+
+        this->build_ = true;
+
+        log_debug(this, "CACG::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CACG<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "CACG::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            int n = 2 * this->step_size_ + 1;
+
+            this->r_.Clear();
+            this->p_.Clear();
+            this->q_.Clear();
+
+            for(int i = 0; i < n; ++i)
+            {
+                this->Y_[i]->Clear();
+                delete this->Y_[i];
+            }
+            delete[] this->Y_;
+            this->Y_ = NULL;
+
+            free_host(&this->G_);
+            free_host(&this->N_);
+            free_host(&this->B_);
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.Clear();
+                this->t_.Clear();
+
+                for(int i = 0; i < n; ++i)
+                {
+                    this->Yt_[i]->Clear();
+                    delete this->Yt_[i];
+                }
+                delete[] this->Yt_;
+                this->Yt_ = NULL;
+
+                this->precond_->Clear();
+                this->precond_ = NULL;
+            }
+
+            this->ClearBasis_();
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CACG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "CACG::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.Zeros();
+            this->p_.Zeros();
+            this->q_.Zeros();
+
+            this->iter_ctrl_.Clear();
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.Zeros();
+                this->t_.Zeros();
+
+                this->precond_->ReBuildNumeric();
+            }
+
+            // The spectrum of the operator has changed
+            this->BuildBasis_();
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CACG<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "CACG::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            int n = 2 * this->step_size_ + 1;
+
+            this->r_.MoveToHost();
+            this->p_.MoveToHost();
+            this->q_.MoveToHost();
+
+            for(int i = 0; i < n; ++i)
+            {
+                this->Y_[i]->MoveToHost();
+            }
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.MoveToHost();
+                this->t_.MoveToHost();
+
+                for(int i = 0; i < n; ++i)
+                {
+                    this->Yt_[i]->MoveToHost();
+                }
+
+                this->precond_->MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CACG<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "CACG::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            int n = 2 * this->step_size_ + 1;
+
+            this->r_.MoveToAccelerator();
+            this->p_.MoveToAccelerator();
+            this->q_.MoveToAccelerator();
+
+            for(int i = 0; i < n; ++i)
+            {
+                this->Y_[i]->MoveToAccelerator();
+            }
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.MoveToAccelerator();
+                this->t_.MoveToAccelerator();
+
+                for(int i = 0; i < n; ++i)
+                {
+                    this->Yt_[i]->MoveToAccelerator();
+                }
+
+                this->precond_->MoveToAccelerator();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CACG<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                     VectorType*       x)
+    {
+        log_debug(this, "CACG::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ == NULL);
+        assert(this->build_ == true);
+
+        this->Solve_(rhs, x, &this->r_, &this->p_);
+
+        log_debug(this, "CACG::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CACG<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                  VectorType*       x)
+    {
+        log_debug(this, "CACG::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ != NULL);
+        assert(this->build_ == true);
+
+        this->Solve_(rhs, x, &this->z_, &this->t_);
+
+        log_debug(this, "CACG::SolvePrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    bool CACG<OperatorType, VectorType, ValueType>::Estimate_(VectorType* x,
+                                                             VectorType* z,
+                                                             VectorType* t,
+                                                             ValueType&  rho)
+    {
+        log_debug(this, "CACG::Estimate_()", x, z, t, rho);
+
+        const OperatorType* op = this->op_;
+
+        VectorType* r = &this->r_;
+        VectorType* p = &this->p_;
+        VectorType* q = &this->q_;
+
+        std::vector<ValueType> a;
+        std::vector<ValueType> b;
+
+        for(int j = 0; j < this->step_size_; ++j)
+        {
+            // q = Ap
+            op->Apply(*p, q);
+
+            // alpha = rho / (p,q)
+            ValueType alpha = rho / p->DotNonConj(*q);
+
+            // r = r - alpha*q
+            r->AddScale(*q, -alpha);
+
+            // Reduce residual norm, while x is updated
+            this->batch_.Clear();
+            int res_idx = this->Norm_(*r, &this->batch_);
+            this->batch_.Start();
+
+            // x = x + alpha*p
+            x->AddScale(*p, alpha);
+
+            this->batch_.Wait();
+
+            a.push_back(alpha);
+
+            // Check convergence
+            if(this->iter_ctrl_.CheckResidual(std::abs(this->batch_.Get(res_idx))))
+            {
+                return true;
+            }
+
+            // Solve Mz=r
+            if(this->precond_ != NULL)
+            {
+                this->precond_->SolveZeroSol(*r, z);
+            }
+
+            // rho = (r,z)
+            ValueType rho_old = rho;
+            rho               = r->DotNonConj(*z);
+
+            // p = beta*p + z and Mp = beta*Mp + r
+            ValueType beta = rho / rho_old;
+            p->ScaleAdd(beta, *z);
+
+            if(this->precond_ != NULL)
+            {
+                t->ScaleAdd(beta, *r);
+            }
+
+            b.push_back(beta);
+        }
+
+        // Ritz values are the eigenvalues of the Lanczos matrix
+        int m = static_cast<int>(a.size());
+
+        std::vector<ValueType> T(m * m, static_cast<ValueType>(0));
+
+        for(int j = 0; j < m; ++j)
+        {
+            T[DENSE_IND(j, j, m, m)] = static_cast<ValueType>(1) / a[j];
+
+            if(j > 0)
+            {
+                T[DENSE_IND(j, j, m, m)] += b[j - 1] / a[j - 1];
+            }
+
+            if(j + 1 < m)
+            {
+                ValueType off = sqrt(b[j]) / a[j];
+
+                T[DENSE_IND(j, j + 1, m, m)] = off;
+                T[DENSE_IND(j + 1, j, m, m)] = off;
+            }
+        }
+
+        std::vector<std::complex<double>> theta(m);
+
+        if(recycle_eigenvalues(m, T.data(), theta.data()) == true)
+        {
+            this->SetRitzValues_(m, theta.data());
+        }
+
+        return false;
+    }
+
+    // s-step CG as described in E. Carson, 'Communication-Avoiding Krylov Subspace
+    // Methods in Theory and Practice', PhD thesis, UC Berkeley, 2015 (Algorithm 7)
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CACG<OperatorType, VectorType, ValueType>::Solve_(const VectorType& rhs,
+                                                          VectorType*       x,
+                                                          VectorType*       z,
+                                                          VectorType*       t)
+    {
+        const OperatorType* op = this->op_;
+
+        VectorType* r = &this->r_;
+        VectorType* p = &this->p_;
+
+        ValueType zero = static_cast<ValueType>(0);
+        ValueType one  = static_cast<ValueType>(1);
+
+        bool precond = (this->precond_ != NULL);
+
+        int s = this->step_size_;
+        int n = 2 * s + 1;
+
+        VectorType** Y  = this->Y_;
+        VectorType** Yt = (precond == true) ? this->Yt_ : this->Y_;
+
+        ValueType* G = this->G_;
+        ValueType* B = this->B_;
+
+        // The residual norm requires the conjugate Gram matrix of [MP, MR]
+        bool       conj_gram = (precond == true || is_complex_(ValueType()));
+        ValueType* N         = (conj_gram == true) ? this->N_ : this->G_;
+
+        // Initial residual = b - Ax
+        op->Apply(*x, r);
+        r->ScaleAdd(-one, rhs);
+
+        // Initial residual norm |b-Ax0|
+        ValueType res_norm = this->Norm_(*r);
+
+        if(this->iter_ctrl_.InitResidual(std::abs(res_norm)) == false)
+        {
+            return;
+        }
+
+        // Solve Mz=r, p = z and Mp = r
+        if(precond == true)
+        {
+            this->precond_->SolveZeroSol(*r, z);
+            t->CopyFrom(*r);
+        }
+
+        p->CopyFrom(*z);
+
+        // rho = (r,z)
+        ValueType rho = r->DotNonConj(*z);
+
+        // Classical iterations until the spectrum is known
+        while(this->HasBasis_() == false)
+        {
+            if(this->Estimate_(x, z, t, rho) == true)
+            {
+                return;
+            }
+        }
+
+        std::vector<ValueType> cx(n);
+        std::vector<ValueType> cp(n);
+        std::vector<ValueType> cz(n);
+        std::vector<ValueType> cw(n);
+
+        std::vector<int> gram_idx(n * n);
+        std::vector<int> norm_idx(n * n);
+
+        while(true)
+        {
+            // Change of basis matrix of the blocks [P, R] (the basis may have been refined)
+            set_to_zero_host(n * n, B);
+
+            for(int j = 0; j < s; ++j)
+            {
+                ValueType a = one / this->alpha_[j];
+
+                for(int o = 0; o < n; o += s + 1)
+                {
+                    // The R block has one column less
+                    if(o > 0 && j == s - 1)
+                    {
+                        continue;
+                    }
+
+                    B[DENSE_IND(o + j + 1, o + j, n, n)] = a;
+                    B[DENSE_IND(o + j, o + j, n, n)]     = -this->beta_[j] * a;
+
+                    if(j > 0)
+                    {
+                        B[DENSE_IND(o + j - 1, o + j, n, n)] = -this->gamma_[j] * a;
+                    }
+                }
+            }
+
+            // Bases P of p and R of z
+            Y[0]->CopyFrom(*p);
+            Y[s + 1]->CopyFrom(*z);
+
+            if(precond == true)
+            {
+                Yt[0]->CopyFrom(*t);
+                Yt[s + 1]->CopyFrom(*r);
+            }
+
+            this->PowerBasis_(s,
+                              this->alpha_,
+                              this->beta_,
+                              this->gamma_,
+                              Y,
+                              (precond == true) ? Yt : NULL,
+                              NULL);
+            this->PowerBasis_(s - 1,
+                              this->alpha_,
+                              this->beta_,
+                              this->gamma_,
+                              Y + s + 1,
+                              (precond == true) ? Yt + s + 1 : NULL,
+                              NULL);
+
+            // Gram matrices, a single global reduction for s iterations
+            this->batch_.Clear();
+
+            for(int j = 0; j < n; ++j)
+            {
+                for(int i = 0; i <= j; ++i)
+                {
+                    gram_idx[DENSE_IND(i, j, n, n)] = this->batch_.DotNonConj(*Yt[i], *Y[j]);
+
+                    if(conj_gram == true)
+                    {
+                        norm_idx[DENSE_IND(i, j, n, n)] = this->batch_.Dot(*Yt[i], *Yt[j]);
+                    }
+                }
+            }
+
+            this->batch_.Wait();
+
+            for(int j = 0; j < n; ++j)
+            {
+                for(int i = 0; i <= j; ++i)
+                {
+                    G[DENSE_IND(i, j, n, n)] = this->batch_.Get(gram_idx[DENSE_IND(i, j, n, n)]);
+                    G[DENSE_IND(j, i, n, n)] = G[DENSE_IND(i, j, n, n)];
+
+                    if(conj_gram == true)
+                    {
+                        N[DENSE_IND(i, j, n, n)]
+                            = this->batch_.Get(norm_idx[DENSE_IND(i, j, n, n)]);
+                        N[DENSE_IND(j, i, n, n)] = conj_(N[DENSE_IND(i, j, n, n)]);
+                    }
+                }
+            }
+
+            // rho = (r,z) of the recovered vectors, avoids the drift of the recurrence
+            rho = G[DENSE_IND(s + 1, s + 1, n, n)];
+
+            // Coordinates of x - x_k, p and z in the basis
+            for(int i = 0; i < n; ++i)
+            {
+                cx[i] = zero;
+                cp[i] = zero;
+                cz[i] = zero;
+            }
+
+            cp[0]     = one;
+            cz[s + 1] = one;
+
+            for(int j = 0; j < s; ++j)
+            {
+                // w = M^-1 Ap
+                for(int i = 0; i < n; ++i)
+                {
+                    ValueType sum = zero;
+                    for(int k = 0; k < n; ++k)
+                    {
+                        sum += B[DENSE_IND(i, k, n, n)] * cp[k];
+                    }
+
+                    cw[i] = sum;
+                }
+
+                // alpha = rho / (p,Ap)
+                ValueType pap = zero;
+                for(int i = 0; i < n; ++i)
+                {
+                    ValueType sum = zero;
+                    for(int k = 0; k < n; ++k)
+                    {
+                        sum += G[DENSE_IND(i, k, n, n)] * cw[k];
+                    }
+
+                    pap += cp[i] * sum;
+                }
+
+                ValueType alpha = rho / pap;
+
+                // x = x + alpha*p, z = z - alpha*w
+                for(int i = 0; i < n; ++i)
+                {
+                    cx[i] += alpha * cp[i];
+                    cz[i] -= alpha * cw[i];
+                }
+
+                // |r|^2 = (Mz,Mz) and rho = (Mz,z)
+                ValueType res2 = zero;
+                ValueType rho2 = zero;
+                for(int i = 0; i < n; ++i)
+                {
+                    ValueType sum_n = zero;
+                    ValueType sum_g = zero;
+                    for(int k = 0; k < n; ++k)
+                    {
+                        sum_n += N[DENSE_IND(i, k, n, n)] * cz[k];
+                        sum_g += G[DENSE_IND(i, k, n, n)] * cz[k];
+                    }
+
+                    res2 += conj_(cz[i]) * sum_n;
+                    rho2 += cz[i] * sum_g;
+                }
+
+                res_norm = sqrt(std::abs(res2));
+
+                // Check convergence
+                if(this->iter_ctrl_.CheckResidual(std::abs(res_norm)))
+                {
+                    combine_(n, Y, cx.data(), true, x);
+
+                    return;
+                }
+
+                // p = beta*p + z
+                ValueType beta = rho2 / rho;
+                rho            = rho2;
+
+                for(int i = 0; i < n; ++i)
+                {
+                    cp[i] = cz[i] + beta * cp[i];
+                }
+            }
+
+            // Recover the vectors from their coordinates
+            combine_(n, Y, cx.data(), true, x);
+            combine_(n, Y, cp.data(), false, p);
+            combine_(n, Y, cz.data(), false, z);
+
+            if(precond == true)
+            {
+                combine_(n, Yt, cp.data(), false, t);
+                combine_(n, Yt, cz.data(), false, r);
+            }
+        }
+    }
+
+    template class CACG<LocalMatrix<double>, LocalVector<double>, double>;
+    template class CACG<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class CACG<LocalMatrix<std::complex<double>>,
+                        LocalVector<std::complex<double>>,
+                        std::complex<double>>;
+    template class CACG<LocalMatrix<std::complex<float>>,
+                        LocalVector<std::complex<float>>,
+                        std::complex<float>>;
+#endif
+
+    template class CACG<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class CACG<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class CACG<GlobalMatrix<std::complex<double>>,
+                        GlobalVector<std::complex<double>>,
+                        std::complex<double>>;
+    template class CACG<GlobalMatrix<std::complex<float>>,
+                        GlobalVector<std::complex<float>>,
+                        std::complex<float>>;
+#endif
+
+    template class CACG<LocalStencil<double>, LocalVector<double>, double>;
+    template class CACG<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class CACG<LocalStencil<std::complex<double>>,
+                        LocalVector<std::complex<double>>,
+                        std::complex<double>>;
+    template class CACG<LocalStencil<std::complex<float>>,
+                        LocalVector<std::complex<float>>,
+                        std::complex<float>>;
+#endif
+
+    template class CACG<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class CACG<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class CACG<LocalMatrixFree<std::complex<double>>,
+                        LocalVector<std::complex<double>>,
+                        std::complex<double>>;
+    template class CACG<LocalMatrixFree<std::complex<float>>,
+                        LocalVector<std::complex<float>>,
+                        std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,105 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_KRYLOV_CACG_HPP_
+#define ROCALUTION_KRYLOV_CACG_HPP_
+
+#include "../solver.hpp"
+#include "s_step.hpp"
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class CACG
+  * \brief Communication-Avoiding Conjugate Gradient Method
+  * \details
+  * The Communication-Avoiding (s-step) Conjugate Gradient method performs \f$s\f$
+  * iterations of the (preconditioned) CG method at once. The bases
+  * \f$P = [p, Ap, \dots, A^{s}p]\f$ and \f$R = [r, Ar, \dots, A^{s-1}r]\f$ (of the
+  * preconditioned operator, in the polynomial basis of BaseSStep) are computed first. All
+  * inner products of the next \f$s\f$ iterations are then obtained from the Gram matrix
+  * of \f$[P, R]\f$, which takes a single global reduction. The iterations update the
+  * coordinates of the vectors in this basis, the vectors themselves are recovered after
+  * \f$s\f$ steps. The residual norm is computed from the coordinates as well, thus only
+  * the L2 norm is supported. \cite carson
+  *
+  * Compared to CG, the number of global reductions drops from two per iteration to one
+  * per \f$s\f$ iterations, at the cost of about twice as many operator and
+  * preconditioner applications and more vector updates. The solver targets latency
+  * bound distributed runs. Rounding errors grow with \f$s\f$, values up to about 8
+  * usually keep the convergence of CG with the Chebyshev or Newton basis.
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil or
+  *                       LocalMatrixFree
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class CACG : public BaseSStep<OperatorType, VectorType, ValueType>
+    {
+    public:
+        CACG();
+        virtual ~CACG();
+
+        virtual void Print(void) const;
+
+        virtual void Build(void);
+        virtual void ReBuildNumeric(void);
+        virtual void Clear(void);
+
+    protected:
+        virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+        virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        // s-step (preconditioned) CG iteration, z is r and t is p if there is no
+        // preconditioner
+        void Solve_(const VectorType& rhs, VectorType* x, VectorType* z, VectorType* t);
+
+        // Classical CG iterations that estimate the spectrum, returns true on convergence
+        bool Estimate_(VectorType* x, VectorType* z, VectorType* t, ValueType& rho);
+
+        VectorType r_, z_;
+        VectorType p_, q_, t_;
+
+        // Basis [P, R] and, with a preconditioner M, its image [MP, MR]
+        VectorType** Y_;
+        VectorType** Yt_;
+
+        // Gram matrices Yt^T Y and Yt^H Yt and the change of basis matrix with
+        // M^-1 A Y = Y B (leading dimension 2s + 1)
+        ValueType* G_;
+        ValueType* N_;
+        ValueType* B_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_CACG_HPP_
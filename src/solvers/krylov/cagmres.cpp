@@ -0,0 +1,795 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "cagmres.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+#include "recycle.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_matrix_free.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+#include "../../base/matrix_formats_ind.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <math.h>
+#include <vector>
+
+namespace rocalution
+{
+
+    static inline float conj_(float val)
+    {
+        return val;
+    }
+
+    static inline double conj_(double val)
+    {
+        return val;
+    }
+
+    template <typename T>
+    static inline std::complex<T> conj_(const std::complex<T>& val)
+    {
+        return std::conj(val);
+    }
+
+    // Givens rotation with real c, such that [c s; -conj(s) c] [dx; dy] = [r; 0]
+    template <typename ValueType>
+    static void generate_givens_(ValueType dx, ValueType dy, ValueType& c, ValueType& s)
+    {
+        ValueType zero = static_cast<ValueType>(0);
+        ValueType one  = static_cast<ValueType>(1);
+
+        if(dy == zero)
+        {
+            c = one;
+            s = zero;
+        }
+        else if(dx == zero)
+        {
+            c = zero;
+            s = one;
+        }
+        else
+        {
+            double ax   = std::abs(dx);
+            double ay   = std::abs(dy);
+            double norm = std::max(ax, ay);
+
+            norm *= sqrt((ax / norm) * (ax / norm) + (ay / norm) * (ay / norm));
+
+            c = static_cast<ValueType>(ax / norm);
+            s = dx / static_cast<ValueType>(ax) * conj_(dy) / static_cast<ValueType>(norm);
+        }
+    }
+
+    template <typename ValueType>
+    static void apply_givens_(ValueType c, ValueType s, ValueType& dx, ValueType& dy)
+    {
+        ValueType temp = dx;
+        dx             = c * dx + s * dy;
+        dy             = -conj_(s) * temp + c * dy;
+    }
+
+    // out += sum_i c_i Y_i, two vectors per pass
+    template <class VectorType, typename ValueType>
+    static void combine_(int n, VectorType** Y, const ValueType* c, VectorType* out)
+    {
+        ValueType zero = static_cast<ValueType>(0);
+        ValueType one  = static_cast<ValueType>(1);
+
+        int i = 0;
+
+        for(; i + 1 < n; i += 2)
+        {
+            if(c[i] != zero || c[i + 1] != zero)
+            {
+                out->ScaleAdd2(one, *Y[i], c[i], *Y[i + 1], c[i + 1]);
+            }
+        }
+
+        if(i < n && c[i] != zero)
+        {
+            out->AddScale(*Y[i], c[i]);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    CAGMRES<OperatorType, VectorType, ValueType>::CAGMRES()
+    {
+        log_debug(this, "CAGMRES::CAGMRES()", "default constructor");
+
+        this->size_basis_ = 30;
+
+        this->Q_    = NULL;
+        this->H_    = NULL;
+        this->Hraw_ = NULL;
+        this->R_    = NULL;
+        this->c_    = NULL;
+        this->s_    = NULL;
+        this->g_    = NULL;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    CAGMRES<OperatorType, VectorType, ValueType>::~CAGMRES()
+    {
+        log_debug(this, "CAGMRES::~CAGMRES()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CAGMRES<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("CAGMRES solver");
+        }
+        else
+        {
+            LOG_INFO("CAGMRES solver, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CAGMRES<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("CAGMRES(" << this->size_basis_ << "," << this->step_size_
+                                << ") (non-precond) linear solver starts");
+        }
+        else
+        {
+            LOG_INFO("CAGMRES(" << this->size_basis_ << "," << this->step_size_
+                                << ") solver starts, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CAGMRES<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("CAGMRES(" << this->size_basis_ << "," << this->step_size_
+                                << ") (non-precond) ends");
+        }
+        else
+        {
+            LOG_INFO("CAGMRES(" << this->size_basis_ << "," << this->step_size_ << ") ends");
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CAGMRES<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "CAGMRES::Build()", this->build_, " #*# begin");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() > 0);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->size_basis_ > 0);
+        assert(this->step_size_ > 0);
+
+        if(this->res_norm_ != 2)
+        {
+            LOG_INFO("CAGMRES solver supports only L2 residual norm. The solver is switching "
+                     "to L2 norm");
+            this->res_norm_ = 2;
+        }
+
+        int size = this->size_basis_;
+
+        allocate_host(size, &this->c_);
+        allocate_host(size, &this->s_);
+        allocate_host(size + 1, &this->g_);
+        allocate_host((size + 1) * size, &this->H_);
+        allocate_host((size + 1) * size, &this->Hraw_);
+        allocate_host((size + 1) * (size + 1), &this->R_);
+
+        this->Q_ = new VectorType*[size + 1];
+
+        for(int i = 0; i < size + 1; ++i)
+        {
+            this->Q_[i] = new VectorType;
+            this->Q_[i]->CloneBackend(*this->op_);
+            this->Q_[i]->Allocate("q", this->op_->GetM());
+        }
+
+        if(this->precond_ != NULL)
+        {
+            this->z_.CloneBackend(*this->op_);
+            this->z_.Allocate("z", this->op_->GetM());
+
+            this->precond_->SetOperator(*this->op_);
+            this->precond_->Build();
+        }
+
+        this->BuildBasis_();
+
+        this->build_ = true;
+
+        log_debug(this, "CAGMRES::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CAGMRES<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "CAGMRES::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            if(this->precond_ != NULL)
+            {
+                this->z_.Clear();
+                this->precond_->Clear();
+                this->precond_ = NULL;
+            }
+
+            free_host(&this->c_);
+            free_host(&this->s_);
+            free_host(&this->g_);
+            free_host(&this->H_);
+            free_host(&this->Hraw_);
+            free_host(&this->R_);
+
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->Q_[i]->Clear();
+                delete this->Q_[i];
+            }
+            delete[] this->Q_;
+            this->Q_ = NULL;
+
+            this->ClearBasis_();
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CAGMRES<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "CAGMRES::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->Q_[i]->Zeros();
+            }
+
+            this->iter_ctrl_.Clear();
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.Zeros();
+                this->precond_->ReBuildNumeric();
+            }
+
+            // The spectrum of the operator has changed
+            this->BuildBasis_();
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CAGMRES<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "CAGMRES::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->Q_[i]->MoveToHost();
+            }
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.MoveToHost();
+                this->precond_->MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CAGMRES<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "CAGMRES::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->Q_[i]->MoveToAccelerator();
+            }
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.MoveToAccelerator();
+                this->precond_->MoveToAccelerator();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CAGMRES<OperatorType, VectorType, ValueType>::SetBasisSize(int size_basis)
+    {
+        log_debug(this, "CAGMRES:SetBasisSize()", size_basis);
+
+        assert(size_basis > 0);
+        assert(this->build_ == false);
+
+        this->size_basis_ = size_basis;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CAGMRES<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                        VectorType*       x)
+    {
+        log_debug(this, "CAGMRES::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ == NULL);
+        assert(this->build_ == true);
+        assert(this->size_basis_ > 0);
+        assert(this->res_norm_ == 2);
+
+        this->Solve_(rhs, x);
+
+        log_debug(this, "CAGMRES::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CAGMRES<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                     VectorType*       x)
+    {
+        log_debug(this, "CAGMRES::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ != NULL);
+        assert(this->build_ == true);
+        assert(this->size_basis_ > 0);
+        assert(this->res_norm_ == 2);
+
+        this->Solve_(rhs, x);
+
+        log_debug(this, "CAGMRES::SolvePrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    ValueType CAGMRES<OperatorType, VectorType, ValueType>::Residual_(const VectorType& rhs,
+                                                                      const VectorType& x)
+    {
+        VectorType* v = this->Q_[0];
+        VectorType* r = (this->precond_ != NULL) ? &this->z_ : v;
+
+        // r = b - Ax
+        this->op_->Apply(x, r);
+        r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+        // Solve Mv_0 = r
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SolveZeroSol(*r, v);
+        }
+
+        return this->Norm_(*v);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int CAGMRES<OperatorType, VectorType, ValueType>::Orthogonalize_(int c, int sb)
+    {
+        log_debug(this, "CAGMRES::Orthogonalize_()", c, sb);
+
+        VectorType** Q = this->Q_;
+        VectorType** W = this->Q_ + c + 1;
+
+        ValueType* R = this->R_;
+
+        int nq   = c + 1;
+        int size = this->size_basis_ + 1;
+
+        std::vector<ValueType> G1(nq * sb, static_cast<ValueType>(0));
+        std::vector<ValueType> P(nq * sb);
+        std::vector<ValueType> S(sb * sb);
+        std::vector<ValueType> coef(std::max(nq, sb));
+        std::vector<int>       proj_idx(nq * sb);
+        std::vector<int>       gram_idx(sb * sb);
+        std::vector<int>       keep(sb);
+
+        int nk = 0;
+
+        // Block classical Gram-Schmidt and Cholesky QR, the second pass is only
+        // required if the first one lost (numerically) the rank of the block
+        for(int pass = 0; pass < 2 && nk < sb; ++pass)
+        {
+            // Projections P = Q^H W and Gram matrix W^H W in a single global reduction
+            this->batch_.Clear();
+
+            for(int i = 0; i < sb; ++i)
+            {
+                for(int l = 0; l < nq; ++l)
+                {
+                    proj_idx[DENSE_IND(l, i, nq, sb)] = this->batch_.Dot(*Q[l], *W[i]);
+                }
+
+                for(int l = 0; l <= i; ++l)
+                {
+                    gram_idx[DENSE_IND(l, i, sb, sb)] = this->batch_.Dot(*W[l], *W[i]);
+                }
+            }
+
+            this->batch_.Wait();
+
+            for(int i = 0; i < nq * sb; ++i)
+            {
+                P[i] = this->batch_.Get(proj_idx[i]);
+            }
+
+            // S = W^H W - P^H P is the Gram matrix of the projected block
+            for(int i = 0; i < sb; ++i)
+            {
+                for(int l = 0; l <= i; ++l)
+                {
+                    ValueType sum = this->batch_.Get(gram_idx[DENSE_IND(l, i, sb, sb)]);
+
+                    for(int k = 0; k < nq; ++k)
+                    {
+                        sum -= conj_(P[DENSE_IND(k, l, nq, sb)]) * P[DENSE_IND(k, i, nq, sb)];
+                    }
+
+                    S[DENSE_IND(l, i, sb, sb)] = sum;
+                    S[DENSE_IND(i, l, sb, sb)] = conj_(sum);
+                }
+            }
+
+            // W = W - QP
+            for(int i = 0; i < sb; ++i)
+            {
+                for(int l = 0; l < nq; ++l)
+                {
+                    coef[l] = -P[DENSE_IND(l, i, nq, sb)];
+                    G1[DENSE_IND(l, i, nq, sb)] += P[DENSE_IND(l, i, nq, sb)];
+                }
+
+                combine_(nq, Q, coef.data(), W[i]);
+            }
+
+            // The basis recurrence requires a leading set of independent vectors
+            int kept = recycle_cholesky(sb, S.data(), keep.data(), true);
+
+            for(nk = 0; nk < kept && keep[nk] == nk; ++nk)
+            {
+            }
+        }
+
+        // W = W R22^-1
+        for(int i = 0; i < nk; ++i)
+        {
+            for(int l = 0; l < i; ++l)
+            {
+                coef[l] = -S[DENSE_IND(l, i, sb, sb)];
+            }
+
+            combine_(i, W, coef.data(), W[i]);
+            W[i]->Scale(static_cast<ValueType>(1) / S[DENSE_IND(i, i, sb, sb)]);
+        }
+
+        // Raw basis vectors in terms of the orthonormal basis
+        for(int i = 0; i < nk; ++i)
+        {
+            for(int l = 0; l < size; ++l)
+            {
+                ValueType val = static_cast<ValueType>(0);
+
+                if(l < nq)
+                {
+                    val = G1[DENSE_IND(l, i, nq, sb)];
+                }
+                else if(l - nq <= i)
+                {
+                    val = S[DENSE_IND(l - nq, i, sb, sb)];
+                }
+
+                R[DENSE_IND(l, c + 1 + i, size, size)] = val;
+            }
+        }
+
+        return nk;
+    }
+
+    // s-step GMRES as described in M. Hoemmen, 'Communication-avoiding Krylov subspace
+    // methods', PhD thesis, UC Berkeley, 2010 (Section 3.3), with block classical
+    // Gram-Schmidt and Cholesky QR orthogonalization
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CAGMRES<OperatorType, VectorType, ValueType>::Solve_(const VectorType& rhs,
+                                                             VectorType*       x)
+    {
+        VectorType** Q = this->Q_;
+
+        ValueType* H    = this->H_;
+        ValueType* Hraw = this->Hraw_;
+        ValueType* R    = this->R_;
+        ValueType* c    = this->c_;
+        ValueType* s    = this->s_;
+        ValueType* g    = this->g_;
+
+        ValueType zero = static_cast<ValueType>(0);
+        ValueType one  = static_cast<ValueType>(1);
+
+        int size = this->size_basis_;
+        int ld   = size + 1;
+
+        // Plain Arnoldi coefficients, used until the spectrum is known
+        ValueType mono_alpha = one;
+        ValueType mono_beta  = zero;
+
+        std::vector<ValueType> y(size + 1);
+        std::vector<ValueType> u(size + 1);
+
+        // g = 0
+        set_to_zero_host(size + 1, g);
+
+        // g_0 = ||v_0||
+        g[0] = this->Residual_(rhs, *x);
+
+        // Initial residual
+        if(this->iter_ctrl_.InitResidual(std::abs(g[0])) == false)
+        {
+            return;
+        }
+
+        while(true)
+        {
+            // Normalize v_0
+            Q[0]->Scale(one / g[0]);
+
+            bool warm_up   = !this->HasBasis_();
+            bool converged = false;
+
+            int i = 0;
+            while(i < size && converged == false)
+            {
+                const ValueType* alpha = this->alpha_;
+                const ValueType* beta  = this->beta_;
+                const ValueType* gamma = this->gamma_;
+
+                int sb = std::min(this->step_size_, size - i);
+
+                if(warm_up == true)
+                {
+                    alpha = &mono_alpha;
+                    beta  = &mono_beta;
+                    gamma = &mono_beta;
+                    sb    = 1;
+                }
+
+                // Basis vectors Q_i+1, ..., Q_i+sb from Q_i
+                this->PowerBasis_(sb, alpha, beta, gamma, Q + i, NULL, &this->z_);
+
+                int nk = this->Orthogonalize_(i, sb);
+
+                // Breakdown, the Krylov subspace cannot be extended
+                if(nk == 0)
+                {
+                    break;
+                }
+
+                // Hessenberg columns i, ..., i+nk-1 from the basis recurrence
+                int i0 = i;
+                for(int j = 0; j < nk; ++j)
+                {
+                    // y = (v_j+1 - beta_j v_j - gamma_j v_j-1) / alpha_j is M^-1 A v_j in
+                    // terms of Q, where v_0 = Q_i0 and v_j is column i0+j of R
+                    for(int l = 0; l <= size; ++l)
+                    {
+                        ValueType vj = (j == 0) ? ((l == i0) ? one : zero)
+                                                : R[DENSE_IND(l, i0 + j, ld, ld)];
+
+                        y[l] = R[DENSE_IND(l, i0 + j + 1, ld, ld)] - beta[j] * vj;
+
+                        if(j > 0)
+                        {
+                            y[l] -= gamma[j] * u[l];
+                        }
+
+                        u[l] = vj;
+                        y[l] /= alpha[j];
+                    }
+
+                    // Q_i = (v_j - sum_l<i R_li Q_l) / R_ii, thus
+                    // M^-1 A Q_i = (y - sum_l<i R_li M^-1 A Q_l) / R_ii
+                    if(j > 0)
+                    {
+                        for(int k = 0; k < i; ++k)
+                        {
+                            ValueType rki = R[DENSE_IND(k, i, ld, ld)];
+
+                            for(int l = 0; l <= k + 1; ++l)
+                            {
+                                y[l] -= rki * Hraw[DENSE_IND(l, k, ld, size)];
+                            }
+                        }
+
+                        for(int l = 0; l <= i + 1; ++l)
+                        {
+                            y[l] /= R[DENSE_IND(i, i, ld, ld)];
+                        }
+                    }
+
+                    for(int l = 0; l <= size; ++l)
+                    {
+                        ValueType val = (l <= i + 1) ? y[l] : zero;
+
+                        Hraw[DENSE_IND(l, i, ld, size)] = val;
+                        H[DENSE_IND(l, i, ld, size)]    = val;
+                    }
+
+                    // Apply Givens rotation J(0),...,J(i-1) on (H(0,i),...,H(i,i))
+                    for(int k = 0; k < i; ++k)
+                    {
+                        apply_givens_(c[k],
+                                      s[k],
+                                      H[DENSE_IND(k, i, ld, size)],
+                                      H[DENSE_IND(k + 1, i, ld, size)]);
+                    }
+
+                    int ii   = DENSE_IND(i, i, ld, size);
+                    int ip1i = DENSE_IND(i + 1, i, ld, size);
+
+                    // Construct J(i) and apply it to H and the residual vector g
+                    generate_givens_(H[ii], H[ip1i], c[i], s[i]);
+                    apply_givens_(c[i], s[i], H[ii], H[ip1i]);
+                    apply_givens_(c[i], s[i], g[i], g[i + 1]);
+
+                    // Check convergence
+                    if(this->iter_ctrl_.CheckResidual(std::abs(g[++i])))
+                    {
+                        converged = true;
+                        break;
+                    }
+                }
+            }
+
+            // Shifts of the Newton basis from the Ritz values of the first cycle
+            if(warm_up == true && i > 0)
+            {
+                std::vector<ValueType>            Hi(i * i);
+                std::vector<std::complex<double>> theta(i);
+
+                for(int k = 0; k < i; ++k)
+                {
+                    for(int l = 0; l < i; ++l)
+                    {
+                        Hi[DENSE_IND(l, k, i, i)] = Hraw[DENSE_IND(l, k, ld, size)];
+                    }
+                }
+
+                if(recycle_eigenvalues(i, Hi.data(), theta.data()) == true)
+                {
+                    this->SetRitzValues_(i, theta.data());
+                }
+            }
+
+            // Solve upper triangular system
+            for(int j = i - 1; j >= 0; --j)
+            {
+                g[j] /= H[DENSE_IND(j, j, ld, size)];
+
+                for(int k = 0; k < j; ++k)
+                {
+                    g[k] -= H[DENSE_IND(k, j, ld, size)] * g[j];
+                }
+            }
+
+            // Update solution
+            combine_(i, Q, g, x);
+
+            // g = 0
+            set_to_zero_host(size + 1, g);
+
+            // g_0 = ||v_0||
+            g[0] = this->Residual_(rhs, *x);
+
+            // Check convergence, a cycle without progress cannot be repeated
+            if(this->iter_ctrl_.CheckResidualNoCount(std::abs(g[0])) || i == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    template class CAGMRES<LocalMatrix<double>, LocalVector<double>, double>;
+    template class CAGMRES<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class CAGMRES<LocalMatrix<std::complex<double>>,
+                           LocalVector<std::complex<double>>,
+                           std::complex<double>>;
+    template class CAGMRES<LocalMatrix<std::complex<float>>,
+                           LocalVector<std::complex<float>>,
+                           std::complex<float>>;
+#endif
+
+    template class CAGMRES<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class CAGMRES<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class CAGMRES<GlobalMatrix<std::complex<double>>,
+                           GlobalVector<std::complex<double>>,
+                           std::complex<double>>;
+    template class CAGMRES<GlobalMatrix<std::complex<float>>,
+                           GlobalVector<std::complex<float>>,
+                           std::complex<float>>;
+#endif
+
+    template class CAGMRES<LocalStencil<double>, LocalVector<double>, double>;
+    template class CAGMRES<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class CAGMRES<LocalStencil<std::complex<double>>,
+                           LocalVector<std::complex<double>>,
+                           std::complex<double>>;
+    template class CAGMRES<LocalStencil<std::complex<float>>,
+                           LocalVector<std::complex<float>>,
+                           std::complex<float>>;
+#endif
+
+    template class CAGMRES<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class CAGMRES<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class CAGMRES<LocalMatrixFree<std::complex<double>>,
+                           LocalVector<std::complex<double>>,
+                           std::complex<double>>;
+    template class CAGMRES<LocalMatrixFree<std::complex<float>>,
+                           LocalVector<std::complex<float>>,
+                           std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,114 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_KRYLOV_CAGMRES_HPP_
+#define ROCALUTION_KRYLOV_CAGMRES_HPP_
+
+#include "../solver.hpp"
+#include "s_step.hpp"
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class CAGMRES
+  * \brief Communication-Avoiding Generalized Minimum Residual Method
+  * \details
+  * The Communication-Avoiding (s-step) GMRES method builds the same Krylov subspace as
+  * GMRES, but extends the basis by blocks of \f$s\f$ vectors. Each block is computed in
+  * the polynomial basis of BaseSStep (by the matrix powers kernel, if there is no
+  * preconditioner) and orthogonalized against the previous basis vectors and within
+  * itself by a block classical Gram-Schmidt procedure and a Cholesky QR factorization.
+  * Both take a single global reduction, which is repeated once if the block is
+  * numerically rank deficient. The Hessenberg matrix is recovered from the
+  * R factor and the basis coefficients. \cite hoemmen
+  *
+  * Compared to GMRES, the number of global reductions drops from about \f$i+1\f$ in
+  * iteration \f$i\f$ to one per \f$s\f$ iterations. If the spectrum is not known, the
+  * first restart cycle runs with \f$s = 1\f$ and its Ritz values are used as shifts of
+  * the Newton basis afterwards. The preconditioner is applied from the left, as for
+  * GMRES. The Krylov subspace basis size can be set using SetBasisSize(), the default
+  * size is 30.
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil or
+  *                       LocalMatrixFree
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class CAGMRES : public BaseSStep<OperatorType, VectorType, ValueType>
+    {
+    public:
+        CAGMRES();
+        virtual ~CAGMRES();
+
+        virtual void Print(void) const;
+
+        virtual void Build(void);
+        virtual void ReBuildNumeric(void);
+        virtual void Clear(void);
+
+        /** \brief Set the size of the Krylov subspace basis */
+        virtual void SetBasisSize(int size_basis);
+
+    protected:
+        virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+        virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        // Restarted s-step GMRES iteration
+        void Solve_(const VectorType& rhs, VectorType* x);
+
+        // Compute v_0 = M^-1 (b - Ax) and return its norm
+        ValueType Residual_(const VectorType& rhs, const VectorType& x);
+
+        // Orthogonalize the block Q[c+1], ..., Q[c+sb] against Q[0], ..., Q[c] and
+        // within itself, returns the number of kept vectors and fills the columns
+        // c+1, ... of R
+        int Orthogonalize_(int c, int sb);
+
+        VectorType** Q_;
+        VectorType   z_;
+
+        // Hessenberg matrix before and after the Givens rotations (leading dimension
+        // size_basis_ + 1), R factor of the raw basis vectors (leading dimension
+        // size_basis_ + 1), Givens rotations and residual vector
+        ValueType* H_;
+        ValueType* Hraw_;
+        ValueType* R_;
+        ValueType* c_;
+        ValueType* s_;
+        ValueType* g_;
+
+        int size_basis_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_CAGMRES_HPP_
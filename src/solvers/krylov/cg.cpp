@@ -26,6 +26,7 @@
 #include "../iter_ctrl.hpp"
 
 #include "../../base/local_matrix.hpp"
+#include "../../base/local_matrix_free.hpp"
 #include "../../base/local_stencil.hpp"
 #include "../../base/local_vector.hpp"
 
@@ -337,14 +338,22 @@ namespace rocalution
             // alpha = rho / (p,q)
             alpha = rho / p->DotNonConj(*q);
 
+            // r = r - alpha*q
+            r->AddScale(*q, -alpha);
+
+            // Reduce residual norm and rho = (r,r) at once, while x is updated
+            this->batch_.Clear();
+            int res_idx = this->Norm_(*r, &this->batch_);
+            int rho_idx = this->batch_.DotNonConj(*r, *r);
+            this->batch_.Start();
+
             // x = x + alpha*p
             x->AddScale(*p, alpha);
 
-            // r = r - alpha*q
-            r->AddScale(*q, -alpha);
+            this->batch_.Wait();
 
             // Check convergence
-            res_norm = this->Norm_(*r);
+            res_norm = this->batch_.Get(res_idx);
             if(this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
             {
                 break;
@@ -352,7 +361,7 @@ namespace rocalution
 
             // rho = (r,r)
             rho_old = rho;
-            rho     = r->DotNonConj(*r);
+            rho     = this->batch_.Get(rho_idx);
 
             // p = beta*p + r
             beta = rho / rho_old;
@@ -417,14 +426,21 @@ namespace rocalution
             // alpha = rho / (p,q)
             alpha = rho / p->DotNonConj(*q);
 
+            // r = r - alpha*q
+            r->AddScale(*q, -alpha);
+
+            // Reduce residual norm, while x is updated
+            this->batch_.Clear();
+            int res_idx = this->Norm_(*r, &this->batch_);
+            this->batch_.Start();
+
             // x = x + alpha*p
             x->AddScale(*p, alpha);
 
-            // r = r - alpha*q
-            r->AddScale(*q, -alpha);
+            this->batch_.Wait();
 
             // Check convergence
-            res_norm = this->Norm_(*r);
+            res_norm = this->batch_.Get(res_idx);
             if(this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
             {
                 break;
@@ -478,4 +494,15 @@ namespace rocalution
                       std::complex<float>>;
 #endif
 
+    template class CG<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class CG<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class CG<LocalMatrixFree<std::complex<double>>,
+                      LocalVector<std::complex<double>>,
+                      std::complex<double>>;
+    template class CG<LocalMatrixFree<std::complex<float>>,
+                      LocalVector<std::complex<float>>,
+                      std::complex<float>>;
+#endif
+
 } // namespace rocalution
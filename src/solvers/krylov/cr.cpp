@@ -26,6 +26,7 @@
 #include "../iter_ctrl.hpp"
 
 #include "../../base/local_matrix.hpp"
+#include "../../base/local_matrix_free.hpp"
 #include "../../base/local_stencil.hpp"
 #include "../../base/local_vector.hpp"
 
@@ -319,13 +320,20 @@ namespace rocalution
             // alpha = rho / (q,q)
             alpha = rho / q->DotNonConj(*q);
 
+            // r = r - alpha * q
+            r->AddScale(*q, -alpha);
+
+            // Reduce residual norm, while x is updated
+            this->batch_.Clear();
+            int res_idx = this->Norm_(*r, &this->batch_);
+            this->batch_.Start();
+
             // x = x + alpha * p
             x->AddScale(*p, alpha);
 
-            // r = r - alpha * q
-            r->AddScale(*q, -alpha);
+            this->batch_.Wait();
 
-            res_norm = this->Norm_(*r);
+            res_norm = this->batch_.Get(res_idx);
         }
 
         log_debug(this, "CR::SolveNonPrecond_()", " #*# end");
@@ -431,16 +439,23 @@ namespace rocalution
             // alpha = rho / (q,z)
             alpha = rho / q->DotNonConj(*z);
 
+            // t = t - alpha * q
+            t->AddScale(*q, -alpha);
+
+            // Reduce residual norm, while x and r are updated
+            this->batch_.Clear();
+            int res_idx = this->Norm_(*t, &this->batch_);
+            this->batch_.Start();
+
             // x = x + alpha * p
             x->AddScale(*p, alpha);
 
             // r = r - alpha * z
             r->AddScale(*z, -alpha);
 
-            // t = t - alpha * q
-            t->AddScale(*q, -alpha);
+            this->batch_.Wait();
 
-            res_norm = this->Norm_(*t);
+            res_norm = this->batch_.Get(res_idx);
         }
 
         log_debug(this, "CR::SolvePrecond_()", " #*# end");
@@ -479,4 +494,15 @@ namespace rocalution
                       std::complex<float>>;
 #endif
 
+    template class CR<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class CR<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class CR<LocalMatrixFree<std::complex<double>>,
+                      LocalVector<std::complex<double>>,
+                      std::complex<double>>;
+    template class CR<LocalMatrixFree<std::complex<float>>,
+                      LocalVector<std::complex<float>>,
+                      std::complex<float>>;
+#endif
+
 } // namespace rocalution
@@ -0,0 +1,1171 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "deflated_cg.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+#include "recycle.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_matrix_free.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+#include "../../base/matrix_formats_ind.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <math.h>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    DeflatedCG<OperatorType, VectorType, ValueType>::DeflatedCG()
+    {
+        log_debug(this, "DeflatedCG::DeflatedCG()", "default constructor");
+
+        this->size_recycle_ = 8;
+        this->size_harvest_ = 0;
+
+        this->num_recycle_ = 0;
+        this->num_harvest_ = 0;
+
+        this->keep_recycle_   = true;
+        this->refine_recycle_ = true;
+        this->prepared_       = false;
+
+        this->W_  = NULL;
+        this->AW_ = NULL;
+        this->T_  = NULL;
+        this->Z_  = NULL;
+
+        this->E_ = NULL;
+        this->R_ = NULL;
+        this->F_ = NULL;
+
+        this->VAV_  = NULL;
+        this->VMV_  = NULL;
+        this->mu_   = NULL;
+        this->last_ = NULL;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    DeflatedCG<OperatorType, VectorType, ValueType>::~DeflatedCG()
+    {
+        log_debug(this, "DeflatedCG::~DeflatedCG()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("Deflated CG solver");
+        }
+        else
+        {
+            LOG_INFO("Deflated PCG solver, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("Deflated CG (non-precond) linear solver starts, recycle space: "
+                     << this->num_recycle_);
+        }
+        else
+        {
+            LOG_INFO("Deflated PCG solver starts, recycle space: " << this->num_recycle_
+                                                                   << ", with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("Deflated CG (non-precond) ends");
+        }
+        else
+        {
+            LOG_INFO("Deflated PCG ends");
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "DeflatedCG::Build()", this->build_, " #*# begin");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->op_->GetM() > 0);
+        assert(this->size_recycle_ > 0);
+
+        // The harvest basis is restarted with twice the recycle size, leaving room for
+        // as many new residuals
+        this->size_harvest_ = 4 * this->size_recycle_;
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SetOperator(*this->op_);
+            this->precond_->Build();
+
+            this->z_.CloneBackend(*this->op_);
+            this->z_.Allocate("z", this->op_->GetM());
+        }
+
+        this->r_.CloneBackend(*this->op_);
+        this->r_.Allocate("r", this->op_->GetM());
+
+        this->p_.CloneBackend(*this->op_);
+        this->p_.Allocate("p", this->op_->GetM());
+
+        this->q_.CloneBackend(*this->op_);
+        this->q_.Allocate("q", this->op_->GetM());
+
+        this->W_  = new VectorType*[this->size_recycle_];
+        this->AW_ = new VectorType*[this->size_recycle_];
+        this->T_  = new VectorType*[2 * this->size_recycle_];
+
+        for(int i = 0; i < this->size_recycle_; ++i)
+        {
+            this->W_[i]  = new VectorType;
+            this->AW_[i] = new VectorType;
+
+            this->W_[i]->CloneBackend(*this->op_);
+            this->AW_[i]->CloneBackend(*this->op_);
+
+            this->W_[i]->Allocate("W", this->op_->GetM());
+            this->AW_[i]->Allocate("AW", this->op_->GetM());
+        }
+
+        for(int i = 0; i < 2 * this->size_recycle_; ++i)
+        {
+            this->T_[i] = new VectorType;
+            this->T_[i]->CloneBackend(*this->op_);
+            this->T_[i]->Allocate("T", this->op_->GetM());
+        }
+
+        this->Z_ = new VectorType*[this->size_harvest_];
+
+        for(int i = 0; i < this->size_harvest_; ++i)
+        {
+            this->Z_[i] = new VectorType;
+            this->Z_[i]->CloneBackend(*this->op_);
+            this->Z_[i]->Allocate("Z", this->op_->GetM());
+        }
+
+        allocate_host(this->size_recycle_ * this->size_recycle_, &this->E_);
+        allocate_host(this->size_recycle_ * this->size_recycle_, &this->R_);
+        allocate_host(this->size_recycle_ * this->size_recycle_, &this->F_);
+
+        allocate_host(this->size_harvest_ * this->size_harvest_, &this->VAV_);
+        allocate_host(this->size_harvest_ * this->size_harvest_, &this->VMV_);
+        allocate_host(this->size_recycle_ * this->size_harvest_, &this->mu_);
+        allocate_host(this->size_harvest_, &this->last_);
+
+        this->num_recycle_ = 0;
+        this->num_harvest_ = 0;
+        this->prepared_    = false;
+
+        this->build_ = true;
+
+        log_debug(this, "DeflatedCG::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "DeflatedCG::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            if(this->precond_ != NULL)
+            {
+                this->precond_->Clear();
+                this->precond_ = NULL;
+            }
+
+            this->r_.Clear();
+            this->z_.Clear();
+            this->p_.Clear();
+            this->q_.Clear();
+
+            for(int i = 0; i < this->size_recycle_; ++i)
+            {
+                delete this->W_[i];
+                delete this->AW_[i];
+            }
+
+            for(int i = 0; i < 2 * this->size_recycle_; ++i)
+            {
+                delete this->T_[i];
+            }
+
+            for(int i = 0; i < this->size_harvest_; ++i)
+            {
+                delete this->Z_[i];
+            }
+
+            delete[] this->W_;
+            delete[] this->AW_;
+            delete[] this->T_;
+            delete[] this->Z_;
+
+            this->W_  = NULL;
+            this->AW_ = NULL;
+            this->T_  = NULL;
+            this->Z_  = NULL;
+
+            free_host(&this->E_);
+            free_host(&this->R_);
+            free_host(&this->F_);
+
+            free_host(&this->VAV_);
+            free_host(&this->VMV_);
+            free_host(&this->mu_);
+            free_host(&this->last_);
+
+            this->num_recycle_ = 0;
+            this->num_harvest_ = 0;
+            this->prepared_    = false;
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "DeflatedCG::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.Zeros();
+            this->z_.Zeros();
+            this->p_.Zeros();
+            this->q_.Zeros();
+
+            this->iter_ctrl_.Clear();
+
+            // The recycle space has to be projected onto the new operator
+            if(this->keep_recycle_ == false)
+            {
+                this->num_recycle_ = 0;
+            }
+
+            this->prepared_ = false;
+
+            if(this->precond_ != NULL)
+            {
+                this->precond_->ReBuildNumeric();
+            }
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::SetRecycleSize(int size_recycle)
+    {
+        log_debug(this, "DeflatedCG::SetRecycleSize()", size_recycle);
+
+        assert(size_recycle > 0);
+        assert(this->build_ == false);
+
+        this->size_recycle_ = size_recycle;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::KeepRecycleSpace(bool keep)
+    {
+        log_debug(this, "DeflatedCG::KeepRecycleSpace()", keep);
+
+        this->keep_recycle_ = keep;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::RefineRecycleSpace(bool refine)
+    {
+        log_debug(this, "DeflatedCG::RefineRecycleSpace()", refine);
+
+        this->refine_recycle_ = refine;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::ClearRecycleSpace(void)
+    {
+        log_debug(this, "DeflatedCG::ClearRecycleSpace()");
+
+        this->num_recycle_ = 0;
+        this->prepared_    = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int DeflatedCG<OperatorType, VectorType, ValueType>::GetRecycleSize(void) const
+    {
+        return this->num_recycle_;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "DeflatedCG::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.MoveToHost();
+            this->p_.MoveToHost();
+            this->q_.MoveToHost();
+
+            for(int i = 0; i < this->size_recycle_; ++i)
+            {
+                this->W_[i]->MoveToHost();
+                this->AW_[i]->MoveToHost();
+            }
+
+            for(int i = 0; i < 2 * this->size_recycle_; ++i)
+            {
+                this->T_[i]->MoveToHost();
+            }
+
+            for(int i = 0; i < this->size_harvest_; ++i)
+            {
+                this->Z_[i]->MoveToHost();
+            }
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.MoveToHost();
+                this->precond_->MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "DeflatedCG::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.MoveToAccelerator();
+            this->p_.MoveToAccelerator();
+            this->q_.MoveToAccelerator();
+
+            for(int i = 0; i < this->size_recycle_; ++i)
+            {
+                this->W_[i]->MoveToAccelerator();
+                this->AW_[i]->MoveToAccelerator();
+            }
+
+            for(int i = 0; i < 2 * this->size_recycle_; ++i)
+            {
+                this->T_[i]->MoveToAccelerator();
+            }
+
+            for(int i = 0; i < this->size_harvest_; ++i)
+            {
+                this->Z_[i]->MoveToAccelerator();
+            }
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.MoveToAccelerator();
+                this->precond_->MoveToAccelerator();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::PrepareRecycleSpace_(void)
+    {
+        log_debug(this, "DeflatedCG::PrepareRecycleSpace_()", this->num_recycle_);
+
+        int k  = this->num_recycle_;
+        int ld = this->size_recycle_;
+
+        if(k > 0)
+        {
+            // AW = A W
+            for(int i = 0; i < k; ++i)
+            {
+                this->op_->Apply(*this->W_[i], this->AW_[i]);
+            }
+
+            // E = W^T A W, reduced at once
+            std::vector<int> handle(k * k);
+
+            this->batch_.Clear();
+
+            for(int j = 0; j < k; ++j)
+            {
+                for(int i = 0; i <= j; ++i)
+                {
+                    handle[i + j * k] = this->batch_.DotNonConj(*this->W_[i], *this->AW_[j]);
+                }
+            }
+
+            this->batch_.Wait();
+
+            std::vector<ValueType> E(k * k);
+            std::vector<ValueType> F(k * k);
+
+            for(int j = 0; j < k; ++j)
+            {
+                for(int i = 0; i <= j; ++i)
+                {
+                    E[DENSE_IND(i, j, k, k)] = this->batch_.Get(handle[i + j * k]);
+                    E[DENSE_IND(j, i, k, k)] = E[DENSE_IND(i, j, k, k)];
+                }
+
+                for(int i = 0; i < k; ++i)
+                {
+                    F[DENSE_IND(i, j, k, k)] = this->F_[DENSE_IND(i, j, ld, ld)];
+                }
+            }
+
+            // Cholesky factorization, dropping vectors that became linearly dependent
+            std::vector<ValueType> R(E);
+            std::vector<int>       keep(k);
+
+            int size = recycle_cholesky(k, R.data(), keep.data(), false);
+
+            for(int j = 0; j < size; ++j)
+            {
+                std::swap(this->W_[j], this->W_[keep[j]]);
+                std::swap(this->AW_[j], this->AW_[keep[j]]);
+
+                for(int i = 0; i < size; ++i)
+                {
+                    this->E_[DENSE_IND(i, j, ld, ld)] = E[DENSE_IND(keep[i], keep[j], k, k)];
+                    this->F_[DENSE_IND(i, j, ld, ld)] = F[DENSE_IND(keep[i], keep[j], k, k)];
+                    this->R_[DENSE_IND(i, j, ld, ld)] = R[DENSE_IND(i, j, k, k)];
+                }
+            }
+
+            this->num_recycle_ = size;
+        }
+
+        this->prepared_ = true;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::SolveGalerkin_(ValueType* y) const
+    {
+        int k  = this->num_recycle_;
+        int ld = this->size_recycle_;
+
+        // R^T w = y
+        for(int i = 0; i < k; ++i)
+        {
+            for(int c = 0; c < i; ++c)
+            {
+                y[i] -= this->R_[DENSE_IND(c, i, ld, ld)] * y[c];
+            }
+
+            y[i] /= this->R_[DENSE_IND(i, i, ld, ld)];
+        }
+
+        // R y = w
+        for(int i = k - 1; i >= 0; --i)
+        {
+            for(int c = i + 1; c < k; ++c)
+            {
+                y[i] -= this->R_[DENSE_IND(i, c, ld, ld)] * y[c];
+            }
+
+            y[i] /= this->R_[DENSE_IND(i, i, ld, ld)];
+        }
+    }
+
+    // The harvest basis V is built by a thick restarted Rayleigh-Ritz procedure on the
+    // preconditioned residuals of the solve (eigCG). With z_j = p_j - beta_j p_j-1 + W mu_j,
+    // the A-conjugacy of the search directions and W^T r_j = 0, all inner products follow
+    // from the CG coefficients:
+    //   z_i^T A z_j = T_ij + mu_i^T E mu_j, T tridiagonal (Lanczos)
+    //   z_i^T M z_j = delta_ij r_j^T z_j
+    //   W^T A z_j   = E mu_j
+    //   W^T M z_j   = W^T r_j = 0
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::Harvest_(const VectorType& z,
+                                                                   ValueType         rho,
+                                                                   ValueType         beta,
+                                                                   ValueType         pAp,
+                                                                   ValueType         pAp_old,
+                                                                   const ValueType*  mu)
+    {
+        if(this->num_harvest_ == this->size_harvest_)
+        {
+            this->RestartHarvest_();
+        }
+
+        int k  = this->num_recycle_;
+        int n  = this->num_harvest_;
+        int ld = this->size_recycle_;
+        int lh = this->size_harvest_;
+
+        ValueType zero = static_cast<ValueType>(0);
+
+        this->Z_[n]->CopyFrom(z);
+
+        // E mu_j
+        std::vector<ValueType> Emu(k, zero);
+
+        for(int b = 0; b < k; ++b)
+        {
+            for(int a = 0; a < k; ++a)
+            {
+                Emu[a] += this->E_[DENSE_IND(a, b, ld, ld)] * mu[b];
+            }
+        }
+
+        for(int i = 0; i <= n; ++i)
+        {
+            const ValueType* mu_i = (i < n) ? this->mu_ + i * ld : mu;
+
+            ValueType sum = zero;
+            for(int a = 0; a < k; ++a)
+            {
+                sum += mu_i[a] * Emu[a];
+            }
+
+            if(i < n)
+            {
+                // Only the latest residual z_j-1 is coupled by T
+                sum -= beta * pAp_old * this->last_[i];
+
+                this->VMV_[DENSE_IND(i, n, lh, lh)] = zero;
+                this->VMV_[DENSE_IND(n, i, lh, lh)] = zero;
+            }
+            else
+            {
+                sum += pAp + beta * beta * pAp_old;
+
+                this->VMV_[DENSE_IND(n, n, lh, lh)] = rho;
+            }
+
+            this->VAV_[DENSE_IND(i, n, lh, lh)] = sum;
+            this->VAV_[DENSE_IND(n, i, lh, lh)] = sum;
+        }
+
+        for(int i = 0; i < n; ++i)
+        {
+            this->last_[i] = zero;
+        }
+
+        for(int a = 0; a < k; ++a)
+        {
+            this->mu_[DENSE_IND(a, n, ld, lh)] = mu[a];
+        }
+
+        this->last_[n] = static_cast<ValueType>(1);
+
+        ++this->num_harvest_;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::RestartHarvest_(void)
+    {
+        log_debug(this, "DeflatedCG::RestartHarvest_()", this->num_harvest_);
+
+        int k   = this->num_recycle_;
+        int n   = this->num_harvest_;
+        int ld  = this->size_recycle_;
+        int lh  = this->size_harvest_;
+        int nev = this->size_recycle_;
+
+        ValueType zero = static_cast<ValueType>(0);
+
+        // Ritz vectors of the smallest eigenvalues of V and of V without its latest
+        // vector, the latter approximate the Ritz vectors of the previous step and keep
+        // the restarted procedure close to the unrestarted one
+        std::vector<ValueType> C(n * 2 * nev, zero);
+
+        int c = 0;
+
+        for(int d = 0; d < 2; ++d)
+        {
+            int nd = n - d;
+
+            std::vector<ValueType> A(nd * nd);
+            std::vector<ValueType> M(nd * nd);
+            std::vector<ValueType> Y(nd * nev);
+
+            for(int j = 0; j < nd; ++j)
+            {
+                for(int i = 0; i < nd; ++i)
+                {
+                    A[DENSE_IND(i, j, nd, nd)] = this->VAV_[DENSE_IND(i, j, lh, lh)];
+                    M[DENSE_IND(i, j, nd, nd)] = this->VMV_[DENSE_IND(i, j, lh, lh)];
+                }
+            }
+
+            int size = recycle_eigenvectors(nd, M.data(), A.data(), nev, false, Y.data());
+
+            for(int j = 0; j < size; ++j)
+            {
+                for(int i = 0; i < nd; ++i)
+                {
+                    C[DENSE_IND(i, c, n, 2 * nev)] = Y[DENSE_IND(i, j, nd, nev)];
+                }
+
+                ++c;
+            }
+        }
+
+        // A-orthonormalize the combined coefficients, Q = C R^-1
+        std::vector<ValueType> G(c * c, zero);
+
+        for(int b = 0; b < c; ++b)
+        {
+            for(int a = 0; a < c; ++a)
+            {
+                ValueType sum = zero;
+                for(int j = 0; j < n; ++j)
+                {
+                    for(int i = 0; i < n; ++i)
+                    {
+                        sum += C[DENSE_IND(i, a, n, 2 * nev)] * this->VAV_[DENSE_IND(i, j, lh, lh)]
+                               * C[DENSE_IND(j, b, n, 2 * nev)];
+                    }
+                }
+
+                G[DENSE_IND(a, b, c, c)] = sum;
+            }
+        }
+
+        std::vector<int> keep(c);
+
+        int q = (c > 0) ? recycle_cholesky(c, G.data(), keep.data(), false) : 0;
+
+        std::vector<ValueType> Q(n * q, zero);
+
+        for(int j = 0; j < q; ++j)
+        {
+            for(int i = 0; i < n; ++i)
+            {
+                ValueType sum = C[DENSE_IND(i, keep[j], n, 2 * nev)];
+                for(int l = 0; l < j; ++l)
+                {
+                    sum -= Q[DENSE_IND(i, l, n, q)] * G[DENSE_IND(l, j, c, c)];
+                }
+
+                Q[DENSE_IND(i, j, n, q)] = sum / G[DENSE_IND(j, j, c, c)];
+            }
+        }
+
+        if(q == 0)
+        {
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: DeflatedCG::RestartHarvest_() failed, the harvest "
+                             "basis is discarded");
+        }
+
+        // V = V Q
+        for(int j = 0; j < q; ++j)
+        {
+            this->T_[j]->Zeros();
+
+            for(int i = 0; i < n; ++i)
+            {
+                this->T_[j]->AddScale(*this->Z_[i], Q[DENSE_IND(i, j, n, q)]);
+            }
+        }
+
+        for(int j = 0; j < q; ++j)
+        {
+            std::swap(this->Z_[j], this->T_[j]);
+        }
+
+        // Q^T (V^T A V) Q, Q^T (V^T M V) Q, mu Q and Q^T last
+        std::vector<ValueType> VAV(q * q, zero);
+        std::vector<ValueType> VMV(q * q, zero);
+        std::vector<ValueType> mu(k * q, zero);
+        std::vector<ValueType> last(q, zero);
+
+        for(int b = 0; b < q; ++b)
+        {
+            for(int j = 0; j < n; ++j)
+            {
+                ValueType qjb = Q[DENSE_IND(j, b, n, q)];
+
+                for(int a = 0; a < q; ++a)
+                {
+                    ValueType sa = zero;
+                    ValueType sm = zero;
+                    for(int i = 0; i < n; ++i)
+                    {
+                        sa += Q[DENSE_IND(i, a, n, q)] * this->VAV_[DENSE_IND(i, j, lh, lh)];
+                        sm += Q[DENSE_IND(i, a, n, q)] * this->VMV_[DENSE_IND(i, j, lh, lh)];
+                    }
+
+                    VAV[DENSE_IND(a, b, q, q)] += sa * qjb;
+                    VMV[DENSE_IND(a, b, q, q)] += sm * qjb;
+                }
+
+                for(int a = 0; a < k; ++a)
+                {
+                    mu[DENSE_IND(a, b, k, q)] += this->mu_[DENSE_IND(a, j, ld, lh)] * qjb;
+                }
+
+                last[b] += this->last_[j] * qjb;
+            }
+        }
+
+        for(int b = 0; b < q; ++b)
+        {
+            for(int a = 0; a < q; ++a)
+            {
+                this->VAV_[DENSE_IND(a, b, lh, lh)] = VAV[DENSE_IND(a, b, q, q)];
+                this->VMV_[DENSE_IND(a, b, lh, lh)] = VMV[DENSE_IND(a, b, q, q)];
+            }
+
+            for(int a = 0; a < k; ++a)
+            {
+                this->mu_[DENSE_IND(a, b, ld, lh)] = mu[DENSE_IND(a, b, k, q)];
+            }
+
+            this->last_[b] = last[b];
+        }
+
+        this->num_harvest_ = q;
+    }
+
+    // Rayleigh-Ritz procedure on [W, V] with
+    //   [W, V]^T A [W, V] = [E, E mu; mu^T E, V^T A V]
+    //   [W, V]^T M [W, V] = [F, 0; 0, V^T M V]
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::UpdateRecycleSpace_(void)
+    {
+        log_debug(this,
+                  "DeflatedCG::UpdateRecycleSpace_()",
+                  this->num_recycle_,
+                  this->num_harvest_);
+
+        int k  = this->num_recycle_;
+        int l  = this->num_harvest_;
+        int m  = k + l;
+        int ld = this->size_recycle_;
+        int lh = this->size_harvest_;
+
+        ValueType zero = static_cast<ValueType>(0);
+
+        std::vector<ValueType> A(m * m, zero);
+        std::vector<ValueType> M(m * m, zero);
+
+        for(int j = 0; j < k; ++j)
+        {
+            for(int i = 0; i < k; ++i)
+            {
+                A[DENSE_IND(i, j, m, m)] = this->E_[DENSE_IND(i, j, ld, ld)];
+                M[DENSE_IND(i, j, m, m)] = this->F_[DENSE_IND(i, j, ld, ld)];
+            }
+        }
+
+        for(int j = 0; j < l; ++j)
+        {
+            for(int a = 0; a < k; ++a)
+            {
+                ValueType sum = zero;
+                for(int b = 0; b < k; ++b)
+                {
+                    sum += this->E_[DENSE_IND(a, b, ld, ld)] * this->mu_[DENSE_IND(b, j, ld, lh)];
+                }
+
+                A[DENSE_IND(a, k + j, m, m)] = sum;
+                A[DENSE_IND(k + j, a, m, m)] = sum;
+            }
+
+            for(int i = 0; i < l; ++i)
+            {
+                A[DENSE_IND(k + i, k + j, m, m)] = this->VAV_[DENSE_IND(i, j, lh, lh)];
+                M[DENSE_IND(k + i, k + j, m, m)] = this->VMV_[DENSE_IND(i, j, lh, lh)];
+            }
+        }
+
+        // Ritz vectors of the smallest eigenvalues of M^-1 A, i.e. largest of
+        // ([W, V]^T M [W, V]) y = mu ([W, V]^T A [W, V]) y
+        std::vector<ValueType> Y(m * ld);
+
+        int size = (m > 0) ? recycle_eigenvectors(m, M.data(), A.data(), ld, false, Y.data()) : 0;
+
+        if(size == 0)
+        {
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: DeflatedCG::UpdateRecycleSpace_() failed, the "
+                             "recycle space is kept");
+
+            return;
+        }
+
+        // W = [W, V] Y
+        for(int c = 0; c < size; ++c)
+        {
+            this->T_[c]->Zeros();
+
+            for(int i = 0; i < k; ++i)
+            {
+                this->T_[c]->AddScale(*this->W_[i], Y[DENSE_IND(i, c, m, ld)]);
+            }
+
+            for(int j = 0; j < l; ++j)
+            {
+                this->T_[c]->AddScale(*this->Z_[j], Y[DENSE_IND(k + j, c, m, ld)]);
+            }
+        }
+
+        for(int c = 0; c < size; ++c)
+        {
+            std::swap(this->W_[c], this->T_[c]);
+        }
+
+        // W^T M W = Y^T ([W, V]^T M [W, V]) Y
+        for(int b = 0; b < size; ++b)
+        {
+            for(int a = 0; a < size; ++a)
+            {
+                ValueType sum = zero;
+                for(int j = 0; j < m; ++j)
+                {
+                    for(int i = 0; i < m; ++i)
+                    {
+                        sum += Y[DENSE_IND(i, a, m, ld)] * M[DENSE_IND(i, j, m, m)]
+                               * Y[DENSE_IND(j, b, m, ld)];
+                    }
+                }
+
+                this->F_[DENSE_IND(a, b, ld, ld)] = sum;
+            }
+        }
+
+        this->num_recycle_ = size;
+        this->prepared_    = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                           VectorType*       x)
+    {
+        log_debug(this, "DeflatedCG::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ == NULL);
+        assert(this->build_ == true);
+
+        this->Solve_(rhs, x, &this->r_);
+
+        log_debug(this, "DeflatedCG::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                        VectorType*       x)
+    {
+        log_debug(this, "DeflatedCG::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ != NULL);
+        assert(this->build_ == true);
+
+        this->Solve_(rhs, x, &this->z_);
+
+        log_debug(this, "DeflatedCG::SolvePrecond_()", " #*# end");
+    }
+
+    // Deflated CG implementation is based on the algorithm described in 'A deflated version
+    // of the conjugate gradient algorithm' by Y. Saad, M. Yeung, J. Erhel and F. Guyomarc'h
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::Solve_(const VectorType& rhs,
+                                                                 VectorType*       x,
+                                                                 VectorType*       z)
+    {
+        const OperatorType* op = this->op_;
+
+        VectorType* r = &this->r_;
+        VectorType* p = &this->p_;
+        VectorType* q = &this->q_;
+
+        ValueType one = static_cast<ValueType>(1);
+
+        ValueType alpha, beta;
+        ValueType rho, rho_old;
+
+        // Initial residual = b - Ax
+        op->Apply(*x, r);
+        r->ScaleAdd(-one, rhs);
+
+        // Initial residual norm |b-Ax0|
+        ValueType res_norm = this->Norm_(*r);
+
+        if(this->iter_ctrl_.InitResidual(std::abs(res_norm)) == false)
+        {
+            return;
+        }
+
+        if(this->prepared_ == false)
+        {
+            this->PrepareRecycleSpace_();
+        }
+
+        int k = this->num_recycle_;
+
+        std::vector<ValueType> mu(k);
+        std::vector<int>       handle(k);
+
+        // x = x + W (W^T A W)^-1 W^T r, such that W^T r = 0
+        if(k > 0)
+        {
+            this->batch_.Clear();
+
+            for(int i = 0; i < k; ++i)
+            {
+                handle[i] = this->batch_.DotNonConj(*this->W_[i], *r);
+            }
+
+            this->batch_.Wait();
+
+            for(int i = 0; i < k; ++i)
+            {
+                mu[i] = this->batch_.Get(handle[i]);
+            }
+
+            this->SolveGalerkin_(mu.data());
+
+            for(int i = 0; i < k; ++i)
+            {
+                x->AddScale(*this->W_[i], mu[i]);
+                r->AddScale(*this->AW_[i], -mu[i]);
+            }
+        }
+
+        // Solve Mz = r
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SolveZeroSol(*r, z);
+        }
+
+        // rho = (r,z) and (AW)^T z are reduced at once
+        this->batch_.Clear();
+
+        int rho_idx = this->batch_.DotNonConj(*r, *z);
+
+        for(int i = 0; i < k; ++i)
+        {
+            handle[i] = this->batch_.DotNonConj(*this->AW_[i], *z);
+        }
+
+        this->batch_.Wait();
+
+        rho = this->batch_.Get(rho_idx);
+        beta = static_cast<ValueType>(0);
+
+        for(int i = 0; i < k; ++i)
+        {
+            mu[i] = this->batch_.Get(handle[i]);
+        }
+
+        // p = z - W mu, mu = (W^T A W)^-1 (AW)^T z
+        this->SolveGalerkin_(mu.data());
+
+        p->CopyFrom(*z);
+
+        for(int i = 0; i < k; ++i)
+        {
+            p->AddScale(*this->W_[i], -mu[i]);
+        }
+
+        this->num_harvest_ = 0;
+
+        ValueType pq_old = static_cast<ValueType>(0);
+
+        while(true)
+        {
+            // q = Ap
+            op->Apply(*p, q);
+
+            // alpha = rho / (p,q)
+            ValueType pq = p->DotNonConj(*q);
+            alpha        = rho / pq;
+
+            // Harvest z_j, before r is updated
+            if(this->refine_recycle_ == true)
+            {
+                this->Harvest_(*z, rho, beta, pq, pq_old, mu.data());
+            }
+
+            pq_old = pq;
+
+            // r = r - alpha*q
+            r->AddScale(*q, -alpha);
+
+            // Reduce residual norm, and rho = (r,r) and (AW)^T r if there is no
+            // preconditioner, while x is updated
+            this->batch_.Clear();
+
+            int res_idx = this->Norm_(*r, &this->batch_);
+
+            if(this->precond_ == NULL)
+            {
+                rho_idx = this->batch_.DotNonConj(*r, *r);
+
+                for(int i = 0; i < k; ++i)
+                {
+                    handle[i] = this->batch_.DotNonConj(*this->AW_[i], *r);
+                }
+            }
+
+            this->batch_.Start();
+
+            // x = x + alpha*p
+            x->AddScale(*p, alpha);
+
+            this->batch_.Wait();
+
+            // Check convergence
+            res_norm = this->batch_.Get(res_idx);
+            if(this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
+            {
+                break;
+            }
+
+            if(this->precond_ != NULL)
+            {
+                // Solve Mz = r
+                this->precond_->SolveZeroSol(*r, z);
+
+                this->batch_.Clear();
+
+                rho_idx = this->batch_.DotNonConj(*r, *z);
+
+                for(int i = 0; i < k; ++i)
+                {
+                    handle[i] = this->batch_.DotNonConj(*this->AW_[i], *z);
+                }
+
+                this->batch_.Wait();
+            }
+
+            rho_old = rho;
+            rho     = this->batch_.Get(rho_idx);
+            beta    = rho / rho_old;
+
+            for(int i = 0; i < k; ++i)
+            {
+                mu[i] = this->batch_.Get(handle[i]);
+            }
+
+            this->SolveGalerkin_(mu.data());
+
+            // p = beta*p + z - W mu
+            p->ScaleAdd(beta, *z);
+
+            for(int i = 0; i < k; ++i)
+            {
+                p->AddScale(*this->W_[i], -mu[i]);
+            }
+        }
+
+        // Refine the recycle space for the next solve
+        if(this->refine_recycle_ == true)
+        {
+            this->UpdateRecycleSpace_();
+        }
+    }
+
+    template class DeflatedCG<LocalMatrix<double>, LocalVector<double>, double>;
+    template class DeflatedCG<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class DeflatedCG<LocalMatrix<std::complex<double>>,
+                              LocalVector<std::complex<double>>,
+                              std::complex<double>>;
+    template class DeflatedCG<LocalMatrix<std::complex<float>>,
+                              LocalVector<std::complex<float>>,
+                              std::complex<float>>;
+#endif
+
+    template class DeflatedCG<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class DeflatedCG<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class DeflatedCG<GlobalMatrix<std::complex<double>>,
+                              GlobalVector<std::complex<double>>,
+                              std::complex<double>>;
+    template class DeflatedCG<GlobalMatrix<std::complex<float>>,
+                              GlobalVector<std::complex<float>>,
+                              std::complex<float>>;
+#endif
+
+    template class DeflatedCG<LocalStencil<double>, LocalVector<double>, double>;
+    template class DeflatedCG<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class DeflatedCG<LocalStencil<std::complex<double>>,
+                              LocalVector<std::complex<double>>,
+                              std::complex<double>>;
+    template class DeflatedCG<LocalStencil<std::complex<float>>,
+                              LocalVector<std::complex<float>>,
+                              std::complex<float>>;
+#endif
+
+    template class DeflatedCG<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class DeflatedCG<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class DeflatedCG<LocalMatrixFree<std::complex<double>>,
+                              LocalVector<std::complex<double>>,
+                              std::complex<double>>;
+    template class DeflatedCG<LocalMatrixFree<std::complex<float>>,
+                              LocalVector<std::complex<float>>,
+                              std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,162 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_KRYLOV_DEFLATED_CG_HPP_
+#define ROCALUTION_KRYLOV_DEFLATED_CG_HPP_
+
+#include "../solver.hpp"
+
+#include <vector>
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class DeflatedCG
+  * \brief Deflated Conjugate Gradient Method
+  * \details
+  * The Deflated Conjugate Gradient method targets sequences of symmetric positive
+  * definite linear systems \f$A_{i}x_{i}=b_{i}\f$, where the matrix is the same or
+  * varies slowly, e.g. the systems of a Newton or time stepping scheme. The search
+  * directions are kept \f$A\f$-orthogonal to a recycle space \f$W\f$, which removes the
+  * corresponding eigenvalues from the spectrum seen by the iteration. In addition, the
+  * initial guess is corrected such that the residual is orthogonal to \f$W\f$.
+  * \cite defcg
+  *
+  * The recycle space is kept across calls to Solve(). During each solve, approximate
+  * eigenvectors of the smallest eigenvalues of the (preconditioned) operator are computed
+  * from the preconditioned residuals by a restarted Rayleigh-Ritz procedure (eigCG)
+  * \cite eigcg. After the solve, the recycle space is replaced by the Ritz vectors of
+  * their span and \f$W\f$. All inner products required by the procedure are available
+  * from the CG recurrences, the harvesting does not add any global reduction. Thus, the
+  * number of iterations of later systems in a sequence typically drops considerably.
+  *
+  * The maximum dimension of the recycle space can be set using SetRecycleSize(). The
+  * default size is 8, the harvesting requires another four times as many vectors. When
+  * the operator changes, ReBuildNumeric() has to be called, which keeps the recycle space
+  * unless KeepRecycleSpace() is set to false. The recycle space can be discarded at any
+  * time by ClearRecycleSpace(). Once the recycle space is accurate enough, its refinement
+  * can be switched off by RefineRecycleSpace(), which avoids the cost of the harvesting
+  * in later solves.
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil or
+  *                       LocalMatrixFree
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class DeflatedCG : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        DeflatedCG();
+        virtual ~DeflatedCG();
+
+        virtual void Print(void) const;
+
+        virtual void Build(void);
+        virtual void ReBuildNumeric(void);
+        virtual void Clear(void);
+
+        /** \brief Set the maximum dimension of the recycle space */
+        virtual void SetRecycleSize(int size_recycle);
+
+        /** \brief Keep (default) or discard the recycle space in ReBuildNumeric() */
+        virtual void KeepRecycleSpace(bool keep);
+
+        /** \brief Refine the recycle space after each solve (default) or keep it fixed */
+        virtual void RefineRecycleSpace(bool refine);
+
+        /** \brief Discard the current recycle space */
+        virtual void ClearRecycleSpace(void);
+
+        /** \brief Return the current dimension of the recycle space */
+        virtual int GetRecycleSize(void) const;
+
+    protected:
+        virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+        virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        // Deflated (preconditioned) CG iteration, z is r if there is no preconditioner
+        void Solve_(const VectorType& rhs, VectorType* x, VectorType* z);
+
+        // Compute AW and the Cholesky factor of W^T A W for the current operator
+        void PrepareRecycleSpace_(void);
+        // Overwrite y by (W^T A W)^-1 y
+        void SolveGalerkin_(ValueType* y) const;
+        // Append the preconditioned residual z_j to the harvest basis V
+        void Harvest_(const VectorType& z,
+                      ValueType         rho,
+                      ValueType         beta,
+                      ValueType         pAp,
+                      ValueType         pAp_old,
+                      const ValueType*  mu);
+        // Compress the full harvest basis V to the Ritz vectors of the smallest eigenvalues
+        void RestartHarvest_(void);
+        // Replace W by the Ritz vectors of [W, V]
+        void UpdateRecycleSpace_(void);
+
+        VectorType r_, z_;
+        VectorType p_, q_;
+
+        // Recycle space, its image under A and temporary storage
+        VectorType** W_;
+        VectorType** AW_;
+        VectorType** T_;
+
+        // Harvest basis V, spanned by preconditioned residuals
+        VectorType** Z_;
+
+        // W^T A W, its Cholesky factor and W^T M W (leading dimension size_recycle_)
+        ValueType* E_;
+        ValueType* R_;
+        ValueType* F_;
+
+        // V^T A V and V^T M V (leading dimension size_harvest_), W^T A V = E mu and the
+        // coefficients of V on the latest preconditioned residual
+        ValueType* VAV_;
+        ValueType* VMV_;
+        ValueType* mu_;
+        ValueType* last_;
+
+        int size_recycle_;
+        int size_harvest_;
+
+        int num_recycle_;
+        int num_harvest_;
+
+        bool keep_recycle_;
+        bool refine_recycle_;
+        bool prepared_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_DEFLATED_CG_HPP_
@@ -26,6 +26,7 @@
 #include "../iter_ctrl.hpp"
 
 #include "../../base/local_matrix.hpp"
+#include "../../base/local_matrix_free.hpp"
 #include "../../base/local_stencil.hpp"
 #include "../../base/local_vector.hpp"
 
@@ -294,11 +295,15 @@ namespace rocalution
             // w = Ar
             op->Apply(*r, w);
 
-            // beta = (r,w)
-            beta = r->Dot(*w);
+            // beta = (r,w), gamma = (r,q) and (r,r) are reduced at once
+            this->batch_.Clear();
+            int beta_idx  = this->batch_.Dot(*r, *w);
+            int gamma_idx = this->batch_.Dot(*r, *q);
+            int alpha_idx = this->batch_.Dot(*r, *r);
+            this->batch_.Wait();
 
-            // gamma = (r,q)
-            gamma     = r->Dot(*q);
+            beta      = this->batch_.Get(beta_idx);
+            gamma     = this->batch_.Get(gamma_idx);
             gamma_rho = -gamma / rho;
 
             // p = r - gamma/rho * p
@@ -311,15 +316,22 @@ namespace rocalution
             rho = beta + gamma * gamma_rho;
 
             // alpha = (r,r) / rho
-            alpha = r->Dot(*r) / rho;
+            alpha = this->batch_.Get(alpha_idx) / rho;
+
+            // r = r - alpha*q
+            r->AddScale(*q, -alpha);
+
+            // Reduce residual norm, while x is updated
+            this->batch_.Clear();
+            int res_idx = this->Norm_(*r, &this->batch_);
+            this->batch_.Start();
 
             // x = x + alpha*p
             x->AddScale(*p, alpha);
 
-            // r = r - alpha*q
-            r->AddScale(*q, -alpha);
+            this->batch_.Wait();
 
-            res = this->Norm_(*r);
+            res = this->batch_.Get(res_idx);
         }
 
         log_debug(this, "FCG::SolveNonPrecond_()", " #*# end");
@@ -394,11 +406,15 @@ namespace rocalution
             // w = Az
             op->Apply(*z, w);
 
-            // beta = (r,w)
-            beta = z->Dot(*w);
+            // beta = (z,w), gamma = (z,q) and (z,r) are reduced at once
+            this->batch_.Clear();
+            int beta_idx  = this->batch_.Dot(*z, *w);
+            int gamma_idx = this->batch_.Dot(*z, *q);
+            int alpha_idx = this->batch_.Dot(*z, *r);
+            this->batch_.Wait();
 
-            // gamma = (z,q)
-            gamma     = z->Dot(*q);
+            beta      = this->batch_.Get(beta_idx);
+            gamma     = this->batch_.Get(gamma_idx);
             gamma_rho = -gamma / rho;
 
             // p = z - gamma/rho * p
@@ -411,15 +427,22 @@ namespace rocalution
             rho = beta + gamma * gamma_rho;
 
             // alpha = (z,r) / rho
-            alpha = z->Dot(*r) / rho;
+            alpha = this->batch_.Get(alpha_idx) / rho;
+
+            // r = r - alpha*q
+            r->AddScale(*q, -alpha);
+
+            // Reduce residual norm, while x is updated
+            this->batch_.Clear();
+            int res_idx = this->Norm_(*r, &this->batch_);
+            this->batch_.Start();
 
             // x = x + alpha*p
             x->AddScale(*p, alpha);
 
-            // r = r - alpha*q
-            r->AddScale(*q, -alpha);
+            this->batch_.Wait();
 
-            res = this->Norm_(*r);
+            res = this->batch_.Get(res_idx);
         }
 
         log_debug(this, "FCG::SolvePrecond_()", " #*# end");
@@ -447,4 +470,15 @@ namespace rocalution
                        std::complex<float>>;
 #endif
 
+    template class FCG<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class FCG<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class FCG<LocalMatrixFree<std::complex<double>>,
+                       LocalVector<std::complex<double>>,
+                       std::complex<double>>;
+    template class FCG<LocalMatrixFree<std::complex<float>>,
+                       LocalVector<std::complex<float>>,
+                       std::complex<float>>;
+#endif
+
 } // namespace rocalution
@@ -0,0 +1,987 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "gcrodr.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+#include "recycle.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_matrix_free.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+#include "../../base/matrix_formats_ind.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <math.h>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    GCRODR<OperatorType, VectorType, ValueType>::GCRODR()
+    {
+        log_debug(this, "GCRODR::GCRODR()", "default constructor");
+
+        this->size_basis_   = 30;
+        this->size_recycle_ = 10;
+
+        this->num_recycle_ = 0;
+
+        this->keep_recycle_ = true;
+        this->prepared_     = false;
+
+        this->c_  = NULL;
+        this->s_  = NULL;
+        this->r_  = NULL;
+        this->H_  = NULL;
+        this->Hs_ = NULL;
+        this->B_  = NULL;
+
+        this->v_ = NULL;
+        this->U_ = NULL;
+        this->C_ = NULL;
+        this->T_ = NULL;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    GCRODR<OperatorType, VectorType, ValueType>::~GCRODR()
+    {
+        log_debug(this, "GCRODR::~GCRODR()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("GCRODR solver");
+        }
+        else
+        {
+            LOG_INFO("GCRODR solver, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("GCRODR(" << this->size_basis_ << "," << this->size_recycle_
+                               << ") (non-precond) linear solver starts, recycle space: "
+                               << this->num_recycle_);
+        }
+        else
+        {
+            LOG_INFO("GCRODR(" << this->size_basis_ << "," << this->size_recycle_
+                               << ") solver starts, recycle space: " << this->num_recycle_
+                               << ", with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("GCRODR(" << this->size_basis_ << "," << this->size_recycle_
+                               << ") (non-precond) ends");
+        }
+        else
+        {
+            LOG_INFO("GCRODR(" << this->size_basis_ << "," << this->size_recycle_ << ") ends");
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "GCRODR::Build()", this->build_, " #*# begin");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() > 0);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->size_basis_ > 0);
+        assert(this->size_recycle_ > 0);
+        assert(this->size_recycle_ < this->size_basis_);
+
+        if(this->res_norm_ != 2)
+        {
+            LOG_INFO(
+                "GCRODR solver supports only L2 residual norm. The solver is switching to L2 norm");
+            this->res_norm_ = 2;
+        }
+
+        int m = this->size_basis_;
+        int k = this->size_recycle_;
+
+        allocate_host(m, &this->c_);
+        allocate_host(m, &this->s_);
+        allocate_host(m + 1, &this->r_);
+        allocate_host((m + 1) * m, &this->H_);
+        allocate_host((m + 1) * m, &this->Hs_);
+        allocate_host(k * m, &this->B_);
+
+        this->v_ = new VectorType*[m + 1];
+
+        for(int i = 0; i < m + 1; ++i)
+        {
+            this->v_[i] = new VectorType;
+            this->v_[i]->CloneBackend(*this->op_);
+            this->v_[i]->Allocate("v", this->op_->GetM());
+        }
+
+        this->U_ = new VectorType*[k];
+        this->C_ = new VectorType*[k];
+        this->T_ = new VectorType*[k];
+
+        for(int i = 0; i < k; ++i)
+        {
+            this->U_[i] = new VectorType;
+            this->C_[i] = new VectorType;
+            this->T_[i] = new VectorType;
+
+            this->U_[i]->CloneBackend(*this->op_);
+            this->C_[i]->CloneBackend(*this->op_);
+            this->T_[i]->CloneBackend(*this->op_);
+
+            this->U_[i]->Allocate("U", this->op_->GetM());
+            this->C_[i]->Allocate("C", this->op_->GetM());
+            this->T_[i]->Allocate("T", this->op_->GetM());
+        }
+
+        if(this->precond_ != NULL)
+        {
+            this->z_.CloneBackend(*this->op_);
+            this->z_.Allocate("z", this->op_->GetM());
+
+            this->precond_->SetOperator(*this->op_);
+            this->precond_->Build();
+        }
+
+        this->num_recycle_ = 0;
+        this->prepared_    = false;
+
+        this->build_ = true;
+
+        log_debug(this, "GCRODR::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "GCRODR::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            if(this->precond_ != NULL)
+            {
+                this->z_.Clear();
+                this->precond_->Clear();
+                this->precond_ = NULL;
+            }
+
+            free_host(&this->c_);
+            free_host(&this->s_);
+            free_host(&this->r_);
+            free_host(&this->H_);
+            free_host(&this->Hs_);
+            free_host(&this->B_);
+
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->Clear();
+                delete this->v_[i];
+            }
+            delete[] this->v_;
+            this->v_ = NULL;
+
+            for(int i = 0; i < this->size_recycle_; ++i)
+            {
+                delete this->U_[i];
+                delete this->C_[i];
+                delete this->T_[i];
+            }
+
+            delete[] this->U_;
+            delete[] this->C_;
+            delete[] this->T_;
+
+            this->U_ = NULL;
+            this->C_ = NULL;
+            this->T_ = NULL;
+
+            this->num_recycle_ = 0;
+            this->prepared_    = false;
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "GCRODR::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->Zeros();
+            }
+
+            this->iter_ctrl_.Clear();
+
+            // C has to be recomputed for the new operator
+            if(this->keep_recycle_ == false)
+            {
+                this->num_recycle_ = 0;
+            }
+
+            this->prepared_ = false;
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.Zeros();
+                this->precond_->ReBuildNumeric();
+            }
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "GCRODR::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->MoveToHost();
+            }
+
+            for(int i = 0; i < this->size_recycle_; ++i)
+            {
+                this->U_[i]->MoveToHost();
+                this->C_[i]->MoveToHost();
+                this->T_[i]->MoveToHost();
+            }
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.MoveToHost();
+                this->precond_->MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "GCRODR::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->MoveToAccelerator();
+            }
+
+            for(int i = 0; i < this->size_recycle_; ++i)
+            {
+                this->U_[i]->MoveToAccelerator();
+                this->C_[i]->MoveToAccelerator();
+                this->T_[i]->MoveToAccelerator();
+            }
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.MoveToAccelerator();
+                this->precond_->MoveToAccelerator();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::SetBasisSize(int size_basis)
+    {
+        log_debug(this, "GCRODR::SetBasisSize()", size_basis);
+
+        assert(size_basis > 0);
+        assert(this->build_ == false);
+
+        this->size_basis_ = size_basis;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::SetRecycleSize(int size_recycle)
+    {
+        log_debug(this, "GCRODR::SetRecycleSize()", size_recycle);
+
+        assert(size_recycle > 0);
+        assert(this->build_ == false);
+
+        this->size_recycle_ = size_recycle;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::KeepRecycleSpace(bool keep)
+    {
+        log_debug(this, "GCRODR::KeepRecycleSpace()", keep);
+
+        this->keep_recycle_ = keep;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::ClearRecycleSpace(void)
+    {
+        log_debug(this, "GCRODR::ClearRecycleSpace()");
+
+        this->num_recycle_ = 0;
+        this->prepared_    = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int GCRODR<OperatorType, VectorType, ValueType>::GetRecycleSize(void) const
+    {
+        return this->num_recycle_;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::ApplyOperator_(const VectorType& in,
+                                                                     VectorType*       out)
+    {
+        if(this->precond_ != NULL)
+        {
+            this->op_->Apply(in, &this->z_);
+            this->precond_->SolveZeroSol(this->z_, out);
+        }
+        else
+        {
+            this->op_->Apply(in, out);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::Residual_(const VectorType& rhs,
+                                                                const VectorType& x,
+                                                                VectorType*       out)
+    {
+        if(this->precond_ != NULL)
+        {
+            this->op_->Apply(x, &this->z_);
+            this->z_.ScaleAdd(static_cast<ValueType>(-1), rhs);
+            this->precond_->SolveZeroSol(this->z_, out);
+        }
+        else
+        {
+            this->op_->Apply(x, out);
+            out->ScaleAdd(static_cast<ValueType>(-1), rhs);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::PrepareRecycleSpace_(void)
+    {
+        log_debug(this, "GCRODR::PrepareRecycleSpace_()", this->num_recycle_);
+
+        int k = this->num_recycle_;
+
+        if(k > 0)
+        {
+            ValueType one = static_cast<ValueType>(1);
+
+            // C = M^-1 A U
+            for(int i = 0; i < k; ++i)
+            {
+                this->ApplyOperator_(*this->U_[i], this->C_[i]);
+            }
+
+            // Cholesky QR C = QR, C = C R^-1 and U = U R^-1, repeated once for stability
+            for(int pass = 0; pass < 2 && k > 0; ++pass)
+            {
+                std::vector<int> handle(k * k);
+
+                this->batch_.Clear();
+
+                for(int j = 0; j < k; ++j)
+                {
+                    for(int i = 0; i < k; ++i)
+                    {
+                        handle[i + j * k] = this->batch_.Dot(*this->C_[i], *this->C_[j]);
+                    }
+                }
+
+                this->batch_.Wait();
+
+                std::vector<ValueType> R(k * k);
+                std::vector<int>       keep(k);
+
+                for(int i = 0; i < k * k; ++i)
+                {
+                    R[i] = this->batch_.Get(handle[i]);
+                }
+
+                int size = recycle_cholesky(k, R.data(), keep.data(), true);
+
+                for(int j = 0; j < size; ++j)
+                {
+                    std::swap(this->U_[j], this->U_[keep[j]]);
+                    std::swap(this->C_[j], this->C_[keep[j]]);
+
+                    for(int i = 0; i < j; ++i)
+                    {
+                        this->U_[j]->AddScale(*this->U_[i], -R[DENSE_IND(i, j, k, k)]);
+                        this->C_[j]->AddScale(*this->C_[i], -R[DENSE_IND(i, j, k, k)]);
+                    }
+
+                    this->U_[j]->Scale(one / R[DENSE_IND(j, j, k, k)]);
+                    this->C_[j]->Scale(one / R[DENSE_IND(j, j, k, k)]);
+                }
+
+                k = size;
+            }
+
+            this->num_recycle_ = k;
+        }
+
+        this->prepared_ = true;
+    }
+
+    // The recycle space update is based on the algorithm described in 'Recycling Krylov
+    // subspaces for sequences of linear systems' by M. L. Parks, E. de Sturler, G. Mackey,
+    // D. D. Johnson and S. Maiti. With U~ = U D (unit columns), the cycle satisfies
+    // M^-1 A [U~, V_s] = [C, V_s+1] G, G = [D, B; 0, H]
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::UpdateRecycleSpace_(int size)
+    {
+        log_debug(this, "GCRODR::UpdateRecycleSpace_()", this->num_recycle_, size);
+
+        int k  = this->num_recycle_;
+        int m  = this->size_basis_;
+        int n  = k + size;
+        int nr = n + 1;
+        int ld = this->size_recycle_;
+
+        ValueType zero = static_cast<ValueType>(0);
+        ValueType one  = static_cast<ValueType>(1);
+
+        if(size == 0)
+        {
+            return;
+        }
+
+        // Norms of U, C^H U and V^H U, reduced at once
+        std::vector<int> hnrm(k);
+        std::vector<int> hcu(k * k);
+        std::vector<int> hvu((size + 1) * k);
+
+        this->batch_.Clear();
+
+        for(int b = 0; b < k; ++b)
+        {
+            hnrm[b] = this->batch_.Norm(*this->U_[b]);
+
+            for(int a = 0; a < k; ++a)
+            {
+                hcu[a + b * k] = this->batch_.Dot(*this->C_[a], *this->U_[b]);
+            }
+
+            for(int i = 0; i <= size; ++i)
+            {
+                hvu[i + b * (size + 1)] = this->batch_.Dot(*this->v_[i], *this->U_[b]);
+            }
+        }
+
+        this->batch_.Wait();
+
+        std::vector<ValueType> d(k);
+
+        for(int b = 0; b < k; ++b)
+        {
+            d[b] = one / this->batch_.Get(hnrm[b]);
+        }
+
+        // G and W^H V with W = [C, V_s+1] and V = [U~, V_s]
+        std::vector<ValueType> G(nr * n, zero);
+        std::vector<ValueType> WV(nr * n, zero);
+
+        for(int b = 0; b < k; ++b)
+        {
+            G[DENSE_IND(b, b, nr, n)] = d[b];
+
+            for(int a = 0; a < k; ++a)
+            {
+                WV[DENSE_IND(a, b, nr, n)] = d[b] * this->batch_.Get(hcu[a + b * k]);
+            }
+
+            for(int i = 0; i <= size; ++i)
+            {
+                WV[DENSE_IND(k + i, b, nr, n)]
+                    = d[b] * this->batch_.Get(hvu[i + b * (size + 1)]);
+            }
+        }
+
+        for(int j = 0; j < size; ++j)
+        {
+            for(int a = 0; a < k; ++a)
+            {
+                G[DENSE_IND(a, k + j, nr, n)] = this->B_[DENSE_IND(a, j, ld, m)];
+            }
+
+            for(int i = 0; i <= j + 1; ++i)
+            {
+                G[DENSE_IND(k + i, k + j, nr, n)] = this->Hs_[DENSE_IND(i, j, m + 1, m)];
+            }
+
+            WV[DENSE_IND(k + j, k + j, nr, n)] = one;
+        }
+
+        // Harmonic Ritz vectors P of the smallest harmonic Ritz values
+        std::vector<ValueType> P(n * ld);
+
+        int num = recycle_harmonic_ritz(nr, n, G.data(), WV.data(), ld, P.data());
+
+        if(num == 0)
+        {
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: GCRODR::UpdateRecycleSpace_() failed, the recycle "
+                             "space is kept");
+
+            return;
+        }
+
+        // G P = QR
+        std::vector<ValueType> Q(nr * num, zero);
+        std::vector<ValueType> R(num * num);
+
+        for(int c = 0; c < num; ++c)
+        {
+            for(int j = 0; j < n; ++j)
+            {
+                for(int i = 0; i < nr; ++i)
+                {
+                    Q[DENSE_IND(i, c, nr, num)]
+                        += G[DENSE_IND(i, j, nr, n)] * P[DENSE_IND(j, c, n, ld)];
+                }
+            }
+        }
+
+        recycle_qr(nr, num, Q.data(), R.data());
+
+        // C = W Q
+        for(int c = 0; c < num; ++c)
+        {
+            this->T_[c]->Zeros();
+
+            for(int a = 0; a < k; ++a)
+            {
+                this->T_[c]->AddScale(*this->C_[a], Q[DENSE_IND(a, c, nr, num)]);
+            }
+
+            for(int i = 0; i <= size; ++i)
+            {
+                this->T_[c]->AddScale(*this->v_[i], Q[DENSE_IND(k + i, c, nr, num)]);
+            }
+        }
+
+        std::swap(this->C_, this->T_);
+
+        // U = V P R^-1, such that M^-1 A U = C
+        for(int j = 0; j < n; ++j)
+        {
+            for(int c = 0; c < num; ++c)
+            {
+                for(int a = 0; a < c; ++a)
+                {
+                    P[DENSE_IND(j, c, n, ld)]
+                        -= P[DENSE_IND(j, a, n, ld)] * R[DENSE_IND(a, c, num, num)];
+                }
+
+                P[DENSE_IND(j, c, n, ld)] /= R[DENSE_IND(c, c, num, num)];
+            }
+        }
+
+        for(int c = 0; c < num; ++c)
+        {
+            this->T_[c]->Zeros();
+
+            for(int b = 0; b < k; ++b)
+            {
+                this->T_[c]->AddScale(*this->U_[b], d[b] * P[DENSE_IND(b, c, n, ld)]);
+            }
+
+            for(int j = 0; j < size; ++j)
+            {
+                this->T_[c]->AddScale(*this->v_[j], P[DENSE_IND(k + j, c, n, ld)]);
+            }
+        }
+
+        std::swap(this->U_, this->T_);
+
+        this->num_recycle_ = num;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                       VectorType*       x)
+    {
+        log_debug(this, "GCRODR::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ == NULL);
+        assert(this->build_ == true);
+        assert(this->res_norm_ == 2);
+
+        this->Solve_(rhs, x);
+
+        log_debug(this, "GCRODR::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                    VectorType*       x)
+    {
+        log_debug(this, "GCRODR::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ != NULL);
+        assert(this->build_ == true);
+        assert(this->res_norm_ == 2);
+
+        this->Solve_(rhs, x);
+
+        log_debug(this, "GCRODR::SolvePrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::Solve_(const VectorType& rhs,
+                                                             VectorType*       x)
+    {
+        VectorType** v = this->v_;
+
+        ValueType* c  = this->c_;
+        ValueType* s  = this->s_;
+        ValueType* r  = this->r_;
+        ValueType* H  = this->H_;
+        ValueType* Hs = this->Hs_;
+        ValueType* B  = this->B_;
+
+        ValueType one = static_cast<ValueType>(1);
+
+        int m  = this->size_basis_;
+        int ld = this->size_recycle_;
+
+        std::vector<ValueType> g(ld);
+        std::vector<int>       handle(ld);
+
+        // Initial residual v_0 = M^-1 (b - Ax)
+        this->Residual_(rhs, *x, v[0]);
+
+        // Initial residual
+        if(this->iter_ctrl_.InitResidual(std::abs(this->Norm_(*v[0]))) == false)
+        {
+            return;
+        }
+
+        if(this->prepared_ == false)
+        {
+            this->PrepareRecycleSpace_();
+        }
+
+        while(true)
+        {
+            int k    = this->num_recycle_;
+            int size = m - k;
+
+            // x = x + U C^H v_0, v_0 = v_0 - C C^H v_0
+            if(k > 0)
+            {
+                this->batch_.Clear();
+
+                for(int a = 0; a < k; ++a)
+                {
+                    handle[a] = this->batch_.Dot(*this->C_[a], *v[0]);
+                }
+
+                this->batch_.Wait();
+
+                for(int a = 0; a < k; ++a)
+                {
+                    g[a] = this->batch_.Get(handle[a]);
+
+                    x->AddScale(*this->U_[a], g[a]);
+                    v[0]->AddScale(*this->C_[a], -g[a]);
+                }
+            }
+
+            // r = 0
+            set_to_zero_host(m + 1, r);
+            set_to_zero_host((m + 1) * m, Hs);
+
+            // r_0 = ||v_0||
+            r[0] = this->Norm_(*v[0]);
+
+            // The projection might already have solved the system
+            if(k > 0 && this->iter_ctrl_.CheckResidualNoCount(std::abs(r[0])))
+            {
+                break;
+            }
+
+            // Normalize v_0
+            v[0]->Scale(one / r[0]);
+
+            // Arnoldi iteration for (I - C C^H) M^-1 A
+            int i = 0;
+            while(i < size)
+            {
+                // v_i+1 = M^-1 A v_i
+                this->ApplyOperator_(*v[i], v[i + 1]);
+
+                // B_ai = <c_a,v_i+1>, v_i+1 -= B_ai * c_a
+                if(k > 0)
+                {
+                    this->batch_.Clear();
+
+                    for(int a = 0; a < k; ++a)
+                    {
+                        handle[a] = this->batch_.Dot(*this->C_[a], *v[i + 1]);
+                    }
+
+                    this->batch_.Wait();
+
+                    for(int a = 0; a < k; ++a)
+                    {
+                        B[DENSE_IND(a, i, ld, m)] = this->batch_.Get(handle[a]);
+                        v[i + 1]->AddScale(*this->C_[a], -B[DENSE_IND(a, i, ld, m)]);
+                    }
+                }
+
+                // Build Hessenberg matrix H
+                for(int l = 0; l <= i; ++l)
+                {
+                    int idx = DENSE_IND(l, i, m + 1, m);
+                    // H_li = <v_l,v_i+1>
+                    H[idx] = v[l]->Dot(*v[i + 1]);
+                    // v_i+1 -= H_li * v_l
+                    v[i + 1]->AddScale(*v[l], -H[idx]);
+
+                    Hs[idx] = H[idx];
+                }
+
+                // Precompute some indices
+                int ii   = DENSE_IND(i, i, m + 1, m);
+                int ip1i = DENSE_IND(i + 1, i, m + 1, m);
+
+                // H_i+1i = ||v_i+1||
+                H[ip1i]  = this->Norm_(*v[i + 1]);
+                Hs[ip1i] = H[ip1i];
+
+                // v_i+1 /= H_i+1i
+                v[i + 1]->Scale(one / H[ip1i]);
+
+                // Apply Givens rotation J(0),...,J(j-1) on (H(0,i),...,H(i,i))
+                for(int l = 0; l < i; ++l)
+                {
+                    int li   = DENSE_IND(l, i, m + 1, m);
+                    int lp1i = DENSE_IND(l + 1, i, m + 1, m);
+                    this->ApplyGivensRotation_(c[l], s[l], H[li], H[lp1i]);
+                }
+
+                // Construct J(i)
+                this->GenerateGivensRotation_(H[ii], H[ip1i], c[i], s[i]);
+
+                // Apply J(i) to H(i,i) and H(i,i+1) such that H(i,i+1) = 0
+                this->ApplyGivensRotation_(c[i], s[i], H[ii], H[ip1i]);
+
+                // Apply J(i) to the norm of the residual sg[i]
+                this->ApplyGivensRotation_(c[i], s[i], r[i], r[i + 1]);
+
+                // Check convergence
+                if(this->iter_ctrl_.CheckResidual(std::abs(r[++i])))
+                {
+                    break;
+                }
+            }
+
+            // Solve upper triangular system
+            for(int j = i - 1; j >= 0; --j)
+            {
+                r[j] /= H[DENSE_IND(j, j, m + 1, m)];
+
+                for(int l = 0; l < j; ++l)
+                {
+                    r[l] -= H[DENSE_IND(l, j, m + 1, m)] * r[j];
+                }
+            }
+
+            // Update solution x = x + V y - U B y
+            for(int j = 0; j < i; ++j)
+            {
+                x->AddScale(*v[j], r[j]);
+            }
+
+            for(int a = 0; a < k; ++a)
+            {
+                ValueType by = static_cast<ValueType>(0);
+                for(int j = 0; j < i; ++j)
+                {
+                    by += B[DENSE_IND(a, j, ld, m)] * r[j];
+                }
+
+                x->AddScale(*this->U_[a], -by);
+            }
+
+            // Deflate the harmonic Ritz vectors of this cycle from the next one
+            this->UpdateRecycleSpace_(i);
+
+            // Compute residual v_0 = M^-1 (b - Ax)
+            this->Residual_(rhs, *x, v[0]);
+
+            // Check convergence
+            if(this->iter_ctrl_.CheckResidualNoCount(std::abs(this->Norm_(*v[0]))))
+            {
+                break;
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::GenerateGivensRotation_(ValueType  dx,
+                                                                              ValueType  dy,
+                                                                              ValueType& c,
+                                                                              ValueType& s) const
+    {
+        ValueType zero = static_cast<ValueType>(0);
+        ValueType one  = static_cast<ValueType>(1);
+
+        if(dy == zero)
+        {
+            c = one;
+            s = zero;
+        }
+        else if(dx == zero)
+        {
+            c = zero;
+            s = one;
+        }
+        else if(std::abs(dy) > std::abs(dx))
+        {
+            ValueType tmp = dx / dy;
+            s             = one / sqrt(one + tmp * tmp);
+            c             = tmp * s;
+        }
+        else
+        {
+            ValueType tmp = dy / dx;
+            c             = one / sqrt(one + tmp * tmp);
+            s             = tmp * c;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GCRODR<OperatorType, VectorType, ValueType>::ApplyGivensRotation_(ValueType  c,
+                                                                           ValueType  s,
+                                                                           ValueType& dx,
+                                                                           ValueType& dy) const
+    {
+        ValueType temp = dx;
+        dx             = c * dx + s * dy;
+        dy             = -s * temp + c * dy;
+    }
+
+    template class GCRODR<LocalMatrix<double>, LocalVector<double>, double>;
+    template class GCRODR<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class GCRODR<LocalMatrix<std::complex<double>>,
+                          LocalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class GCRODR<LocalMatrix<std::complex<float>>,
+                          LocalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+    template class GCRODR<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class GCRODR<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class GCRODR<GlobalMatrix<std::complex<double>>,
+                          GlobalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class GCRODR<GlobalMatrix<std::complex<float>>,
+                          GlobalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+    template class GCRODR<LocalStencil<double>, LocalVector<double>, double>;
+    template class GCRODR<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class GCRODR<LocalStencil<std::complex<double>>,
+                          LocalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class GCRODR<LocalStencil<std::complex<float>>,
+                          LocalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+    template class GCRODR<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class GCRODR<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class GCRODR<LocalMatrixFree<std::complex<double>>,
+                          LocalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class GCRODR<LocalMatrixFree<std::complex<float>>,
+                          LocalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+} // namespace rocalution
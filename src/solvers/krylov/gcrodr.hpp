@@ -0,0 +1,147 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_KRYLOV_GCRODR_HPP_
+#define ROCALUTION_KRYLOV_GCRODR_HPP_
+
+#include "../solver.hpp"
+
+#include <vector>
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class GCRODR
+  * \brief Generalized Conjugate Residual Method with Inner Orthogonalization and
+  * Deflated Restarting
+  * \details
+  * GCRO-DR is a restarted GMRES type method for sequences of (non) symmetric linear
+  * systems \f$A_{i}x_{i}=b_{i}\f$, where the matrix is the same or varies slowly, e.g.
+  * the systems of a Newton or time stepping scheme. A recycle space \f$U\f$ with
+  * \f$C = AU\f$, \f$C^{H}C = I\f$ is kept across restarts and across calls to Solve().
+  * Each cycle minimizes the residual over \f$\mathrm{span}\{U\}\f$ and the Krylov
+  * subspace of \f$(I - CC^{H})A\f$. At the end of each cycle, the recycle space is
+  * replaced by the harmonic Ritz vectors of the smallest harmonic Ritz values. Thus,
+  * the corresponding eigenvalues are deflated from restarts as well as from later
+  * systems in a sequence. \cite gcrodr
+  *
+  * The Krylov subspace basis size can be set using SetBasisSize() and the maximum
+  * dimension of the recycle space using SetRecycleSize(). The defaults are 30 and 10,
+  * each cycle performs SetBasisSize() minus the current recycle space dimension
+  * Arnoldi steps. When the operator changes, ReBuildNumeric() has to be called, which
+  * keeps the recycle space unless KeepRecycleSpace() is set to false. The recycle space
+  * can be discarded at any time by ClearRecycleSpace().
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil or
+  *                       LocalMatrixFree
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class GCRODR : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        GCRODR();
+        virtual ~GCRODR();
+
+        virtual void Print(void) const;
+
+        virtual void Build(void);
+        virtual void ReBuildNumeric(void);
+        virtual void Clear(void);
+
+        /** \brief Set the size of the Krylov subspace basis */
+        virtual void SetBasisSize(int size_basis);
+
+        /** \brief Set the maximum dimension of the recycle space */
+        virtual void SetRecycleSize(int size_recycle);
+
+        /** \brief Keep (default) or discard the recycle space in ReBuildNumeric() */
+        virtual void KeepRecycleSpace(bool keep);
+
+        /** \brief Discard the current recycle space */
+        virtual void ClearRecycleSpace(void);
+
+        /** \brief Return the current dimension of the recycle space */
+        virtual int GetRecycleSize(void) const;
+
+    protected:
+        virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+        virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+        /** \brief Generate Givens rotation */
+        void GenerateGivensRotation_(ValueType dx, ValueType dy, ValueType& c, ValueType& s) const;
+        /** \brief Apply Givens rotation */
+        void ApplyGivensRotation_(ValueType c, ValueType s, ValueType& dx, ValueType& dy) const;
+
+    private:
+        // GCRO-DR cycles for the (left preconditioned) operator
+        void Solve_(const VectorType& rhs, VectorType* x);
+
+        // out = M^-1 A in
+        void ApplyOperator_(const VectorType& in, VectorType* out);
+        // out = M^-1 (rhs - A x)
+        void Residual_(const VectorType& rhs, const VectorType& x, VectorType* out);
+
+        // Compute C = M^-1 A U for the current operator and orthonormalize it
+        void PrepareRecycleSpace_(void);
+        // Replace U and C by the harmonic Ritz vectors of a cycle with size Arnoldi steps
+        void UpdateRecycleSpace_(int size);
+
+        VectorType** v_;
+        VectorType   z_;
+
+        // Recycle space U, C = M^-1 A U and temporary storage
+        VectorType** U_;
+        VectorType** C_;
+        VectorType** T_;
+
+        ValueType* c_;
+        ValueType* s_;
+        ValueType* r_;
+        ValueType* H_;
+
+        // Hessenberg matrix before the Givens rotations and B = C^H M^-1 A V
+        ValueType* Hs_;
+        ValueType* B_;
+
+        int size_basis_;
+        int size_recycle_;
+
+        int num_recycle_;
+
+        bool keep_recycle_;
+        bool prepared_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_GCRODR_HPP_
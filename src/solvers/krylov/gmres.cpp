@@ -26,6 +26,7 @@
 #include "../iter_ctrl.hpp"
 
 #include "../../base/local_matrix.hpp"
+#include "../../base/local_matrix_free.hpp"
 #include "../../base/local_stencil.hpp"
 #include "../../base/local_vector.hpp"
 #include "../../base/matrix_formats_ind.hpp"
@@ -640,4 +641,15 @@ namespace rocalution
                          std::complex<float>>;
 #endif
 
+    template class GMRES<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class GMRES<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class GMRES<LocalMatrixFree<std::complex<double>>,
+                         LocalVector<std::complex<double>>,
+                         std::complex<double>>;
+    template class GMRES<LocalMatrixFree<std::complex<float>>,
+                         LocalVector<std::complex<float>>,
+                         std::complex<float>>;
+#endif
+
 } // namespace rocalution
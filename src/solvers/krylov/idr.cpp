@@ -27,6 +27,7 @@
 #include "../iter_ctrl.hpp"
 
 #include "../../base/local_matrix.hpp"
+#include "../../base/local_matrix_free.hpp"
 #include "../../base/local_stencil.hpp"
 #include "../../base/local_vector.hpp"
 
@@ -390,16 +391,23 @@ namespace rocalution
             }
         }
 
+        // Generate rhs for small system
+        // f = P^T * r
+        this->batch_.Clear();
+        for(int i = 0; i < s; ++i)
+        {
+            this->batch_.Dot(*P[i], *r);
+        }
+        this->batch_.Wait();
+
+        for(int i = 0; i < s; ++i)
+        {
+            f[i] = this->batch_.Get(i);
+        }
+
         // IDR(s) iteration
         while(true)
         {
-            // Generate rhs for small system
-            // f = P^T * r
-            for(int i = 0; i < s; ++i)
-            {
-                f[i] = P[i]->Dot(*r);
-            }
-
             // Loop over shadow spaces
             for(int k = 0; k < s; ++k)
             {
@@ -444,11 +452,17 @@ namespace rocalution
                     U[k]->AddScale(*U[i], -alpha);
                 }
 
-                // Update column k of M
+                // Update column k of M, all M_ik = P^T_i * G_k are reduced at once
+                this->batch_.Clear();
+                for(int i = k; i < s; ++i)
+                {
+                    this->batch_.Dot(*P[i], *G[k]);
+                }
+                this->batch_.Wait();
+
                 for(int i = k; i < s; ++i)
                 {
-                    // M_ik = P^T_i * G_k
-                    M[DENSE_IND(i, k, s, s)] = P[i]->Dot(*G[k]);
+                    M[DENSE_IND(i, k, s, s)] = this->batch_.Get(i - k);
                 }
 
                 // Check M_kk for zero
@@ -480,11 +494,18 @@ namespace rocalution
                 // r = r - beta * G_k
                 r->AddScale(*G[k], -beta);
 
+                // Reduce residual norm, while x is updated
+                this->batch_.Clear();
+                int res_idx = this->Norm_(*r, &this->batch_);
+                this->batch_.Start();
+
                 // x = x + beta * U_k
                 x->AddScale(*U[k], beta);
 
+                this->batch_.Wait();
+
                 // Residual norm
-                res_norm = this->Norm_(*r);
+                res_norm = this->batch_.Get(res_idx);
 
                 // Check inner loop for convergence
                 if(this->iter_ctrl_.CheckResidualNoCount(std::abs(res_norm)))
@@ -511,8 +532,13 @@ namespace rocalution
             op->Apply(*r, v);
 
             // omega = (v,r) / ||v||^2
-            ValueType rt = v->Dot(*r);
-            ValueType nt = v->Norm();
+            this->batch_.Clear();
+            int rt_idx = this->batch_.Dot(*v, *r);
+            int nt_idx = this->batch_.Norm(*v);
+            this->batch_.Wait();
+
+            ValueType rt = this->batch_.Get(rt_idx);
+            ValueType nt = this->batch_.Get(nt_idx);
 
             rt /= nt;
 
@@ -551,8 +577,22 @@ namespace rocalution
             // r = r - omega * v
             r->AddScale(*v, -omega);
 
-            // Residual norm to check outer loop convergence
-            res_norm = this->Norm_(*r);
+            // Reduce residual norm to check outer loop convergence and f = P^T * r of the
+            // next iteration at once
+            this->batch_.Clear();
+            for(int i = 0; i < s; ++i)
+            {
+                this->batch_.Dot(*P[i], *r);
+            }
+            int res_idx = this->Norm_(*r, &this->batch_);
+            this->batch_.Wait();
+
+            for(int i = 0; i < s; ++i)
+            {
+                f[i] = this->batch_.Get(i);
+            }
+
+            res_norm = this->batch_.Get(res_idx);
         }
 
         log_debug(this, "IDR::SolveNonPrecond_()", " #*# end");
@@ -618,16 +658,23 @@ namespace rocalution
             }
         }
 
+        // Generate rhs for small system
+        // f = P^T * r
+        this->batch_.Clear();
+        for(int i = 0; i < s; ++i)
+        {
+            this->batch_.Dot(*P[i], *r);
+        }
+        this->batch_.Wait();
+
+        for(int i = 0; i < s; ++i)
+        {
+            f[i] = this->batch_.Get(i);
+        }
+
         // IDR(s) iteration
         while(true)
         {
-            // Generate rhs for small system
-            // f = P^T * r
-            for(int i = 0; i < s; ++i)
-            {
-                f[i] = P[i]->Dot(*r);
-            }
-
             // Loop over shadow spaces
             for(int k = 0; k < s; ++k)
             {
@@ -675,11 +722,17 @@ namespace rocalution
                     U[k]->AddScale(*U[i], -alpha);
                 }
 
-                // Update column k of M
+                // Update column k of M, all M_ik = P^T_i * G_k are reduced at once
+                this->batch_.Clear();
                 for(int i = k; i < s; ++i)
                 {
-                    // M_ik = P^T_i * G_k
-                    M[DENSE_IND(i, k, s, s)] = P[i]->Dot(*G[k]);
+                    this->batch_.Dot(*P[i], *G[k]);
+                }
+                this->batch_.Wait();
+
+                for(int i = k; i < s; ++i)
+                {
+                    M[DENSE_IND(i, k, s, s)] = this->batch_.Get(i - k);
                 }
 
                 // Check M_kk for zero
@@ -711,11 +764,18 @@ namespace rocalution
                 // r = r - beta * G_k
                 r->AddScale(*G[k], -beta);
 
+                // Reduce residual norm, while x is updated
+                this->batch_.Clear();
+                int res_idx = this->Norm_(*r, &this->batch_);
+                this->batch_.Start();
+
                 // x = x + beta * U_k
                 x->AddScale(*U[k], beta);
 
+                this->batch_.Wait();
+
                 // Residual norm
-                res_norm = this->Norm_(*r);
+                res_norm = this->batch_.Get(res_idx);
 
                 // Check inner loop for convergence
                 if(this->iter_ctrl_.CheckResidualNoCount(std::abs(res_norm)))
@@ -745,8 +805,13 @@ namespace rocalution
             op->Apply(*v, t);
 
             // omega = (t,r) / ||t||^2
-            ValueType rt = t->Dot(*r);
-            ValueType nt = t->Norm();
+            this->batch_.Clear();
+            int rt_idx = this->batch_.Dot(*t, *r);
+            int nt_idx = this->batch_.Norm(*t);
+            this->batch_.Wait();
+
+            ValueType rt = this->batch_.Get(rt_idx);
+            ValueType nt = this->batch_.Get(nt_idx);
 
             rt /= nt;
 
@@ -782,11 +847,27 @@ namespace rocalution
             // r = r - omega * t
             r->AddScale(*t, -omega);
 
+            // Reduce residual norm to check outer loop convergence and f = P^T * r of the
+            // next iteration at once, while x is updated
+            this->batch_.Clear();
+            for(int i = 0; i < s; ++i)
+            {
+                this->batch_.Dot(*P[i], *r);
+            }
+            int res_idx = this->Norm_(*r, &this->batch_);
+            this->batch_.Start();
+
             // x = x + omega * v
             x->AddScale(*v, omega);
 
-            // Residual norm to check outer loop convergence
-            res_norm = this->Norm_(*r);
+            this->batch_.Wait();
+
+            for(int i = 0; i < s; ++i)
+            {
+                f[i] = this->batch_.Get(i);
+            }
+
+            res_norm = this->batch_.Get(res_idx);
         }
 
         log_debug(this, "::SolvePrecond_()", " #*# end");
@@ -825,4 +906,15 @@ namespace rocalution
                        std::complex<float>>;
 #endif
 
+    template class IDR<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class IDR<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class IDR<LocalMatrixFree<std::complex<double>>,
+                       LocalVector<std::complex<double>>,
+                       std::complex<double>>;
+    template class IDR<LocalMatrixFree<std::complex<float>>,
+                       LocalVector<std::complex<float>>,
+                       std::complex<float>>;
+#endif
+
 } // namespace rocalution
@@ -26,6 +26,7 @@
 #include "../iter_ctrl.hpp"
 
 #include "../../base/local_matrix.hpp"
+#include "../../base/local_matrix_free.hpp"
 #include "../../base/local_stencil.hpp"
 #include "../../base/local_vector.hpp"
 
@@ -328,8 +329,13 @@ namespace rocalution
         // t = Ar
         op->Apply(*r, t);
 
-        // omega = (r,t) / (t,t)
-        omega = r->Dot(*t) / t->Dot(*t);
+        // omega = (r,t) / (t,t), both reduced at once
+        this->batch_.Clear();
+        int rt_idx = this->batch_.Dot(*r, *t);
+        int tt_idx = this->batch_.Dot(*t, *t);
+        this->batch_.Wait();
+
+        omega = this->batch_.Get(rt_idx) / this->batch_.Get(tt_idx);
 
         // d = theta1 * theta1 * eta1 / omega * d + r
         d->ScaleAdd(theta1sq * eta1 / omega, *r);
@@ -419,8 +425,13 @@ namespace rocalution
             // t = Ar
             op->Apply(*r, t);
 
-            // omega = (t,t)
-            omega = t->Dot(*t);
+            // omega = (t,t) and (r,t) are reduced at once
+            this->batch_.Clear();
+            int rt_idx = this->batch_.Dot(*r, *t);
+            int tt_idx = this->batch_.Dot(*t, *t);
+            this->batch_.Wait();
+
+            omega = this->batch_.Get(tt_idx);
 
             if(omega == static_cast<ValueType>(0))
             {
@@ -429,7 +440,7 @@ namespace rocalution
             }
 
             // omega = (r,t) / (t,t)
-            omega = r->Dot(*t) / omega;
+            omega = this->batch_.Get(rt_idx) / omega;
 
             // d = r + theta1 * theta1 * eta1 / omega * d
             d->ScaleAdd(theta1sq * eta1 / omega, *r);
@@ -562,8 +573,13 @@ namespace rocalution
         // t = Az
         op->Apply(*z, t);
 
-        // omega = (r,t) / (t,t)
-        omega = r->Dot(*t) / t->Dot(*t);
+        // omega = (r,t) / (t,t), both reduced at once
+        this->batch_.Clear();
+        int rt_idx = this->batch_.Dot(*r, *t);
+        int tt_idx = this->batch_.Dot(*t, *t);
+        this->batch_.Wait();
+
+        omega = this->batch_.Get(rt_idx) / this->batch_.Get(tt_idx);
 
         // d = theta1 * theta1 * eta1 / omega * d + r
         d->ScaleAdd(theta1sq * eta1 / omega, *z);
@@ -659,8 +675,13 @@ namespace rocalution
             // t = Ar
             op->Apply(*z, t);
 
-            // omega = (t,t)
-            omega = t->Dot(*t);
+            // omega = (t,t) and (r,t) are reduced at once
+            this->batch_.Clear();
+            int rt_idx = this->batch_.Dot(*r, *t);
+            int tt_idx = this->batch_.Dot(*t, *t);
+            this->batch_.Wait();
+
+            omega = this->batch_.Get(tt_idx);
 
             if(omega == static_cast<ValueType>(0))
             {
@@ -669,7 +690,7 @@ namespace rocalution
             }
 
             // omega = (r,t) / (t,t)
-            omega = r->Dot(*t) / omega;
+            omega = this->batch_.Get(rt_idx) / omega;
 
             // d = r + theta1 * theta1 * eta1 / omega * d
             d->ScaleAdd(theta1sq * eta1 / omega, *z);
@@ -731,4 +752,15 @@ namespace rocalution
                              std::complex<float>>;
 #endif
 
+    template class QMRCGStab<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class QMRCGStab<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class QMRCGStab<LocalMatrixFree<std::complex<double>>,
+                             LocalVector<std::complex<double>>,
+                             std::complex<double>>;
+    template class QMRCGStab<LocalMatrixFree<std::complex<float>>,
+                             LocalVector<std::complex<float>>,
+                             std::complex<float>>;
+#endif
+
 } // namespace rocalution
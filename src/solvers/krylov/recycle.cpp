@@ -0,0 +1,879 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "recycle.hpp"
+#include "../../base/matrix_formats_ind.hpp"
+#include "../../utils/def.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+
+namespace rocalution
+{
+
+    typedef std::complex<double> cdouble;
+
+    static inline float conj_(float val)
+    {
+        return val;
+    }
+
+    static inline double conj_(double val)
+    {
+        return val;
+    }
+
+    template <typename T>
+    static inline std::complex<T> conj_(const std::complex<T>& val)
+    {
+        return std::conj(val);
+    }
+
+    static inline bool is_complex_(float)
+    {
+        return false;
+    }
+
+    static inline bool is_complex_(double)
+    {
+        return false;
+    }
+
+    template <typename T>
+    static inline bool is_complex_(const std::complex<T>&)
+    {
+        return true;
+    }
+
+    static inline double eps_(float)
+    {
+        return std::numeric_limits<float>::epsilon();
+    }
+
+    static inline double eps_(double)
+    {
+        return std::numeric_limits<double>::epsilon();
+    }
+
+    template <typename T>
+    static inline double eps_(const std::complex<T>&)
+    {
+        return std::numeric_limits<T>::epsilon();
+    }
+
+    template <typename ValueType>
+    static inline ValueType from_cdouble_(const cdouble& val)
+    {
+        return static_cast<ValueType>(val.real());
+    }
+
+    template <>
+    inline std::complex<float> from_cdouble_(const cdouble& val)
+    {
+        return std::complex<float>(static_cast<float>(val.real()),
+                                   static_cast<float>(val.imag()));
+    }
+
+    template <>
+    inline std::complex<double> from_cdouble_(const cdouble& val)
+    {
+        return val;
+    }
+
+    static inline cdouble cj_(const cdouble& val, bool conj)
+    {
+        return (conj == true) ? std::conj(val) : val;
+    }
+
+    // Givens rotation G = [c s; -conj(s) c] with G [a; b] = [r; 0]
+    static void givens_(const cdouble& a, const cdouble& b, double& c, cdouble& s)
+    {
+        double nrm = std::sqrt(std::norm(a) + std::norm(b));
+
+        if(nrm == 0.0)
+        {
+            c = 1.0;
+            s = 0.0;
+        }
+        else if(std::abs(a) == 0.0)
+        {
+            c = 0.0;
+            s = 1.0;
+        }
+        else
+        {
+            c = std::abs(a) / nrm;
+            s = (a / std::abs(a)) * std::conj(b) / nrm;
+        }
+    }
+
+    // Apply G from the left to rows p and q = p + 1, starting at column begin
+    static void rot_rows_(int n, cdouble* H, int p, int begin, double c, const cdouble& s)
+    {
+        for(int j = begin; j < n; ++j)
+        {
+            cdouble x = H[DENSE_IND(p, j, n, n)];
+            cdouble y = H[DENSE_IND(p + 1, j, n, n)];
+
+            H[DENSE_IND(p, j, n, n)]     = c * x + s * y;
+            H[DENSE_IND(p + 1, j, n, n)] = -std::conj(s) * x + c * y;
+        }
+    }
+
+    // Apply G^H from the right to columns p and q = p + 1, up to row end
+    static void rot_cols_(int n, cdouble* H, int p, int end, double c, const cdouble& s)
+    {
+        for(int i = 0; i < end; ++i)
+        {
+            cdouble x = H[DENSE_IND(i, p, n, n)];
+            cdouble y = H[DENSE_IND(i, p + 1, n, n)];
+
+            H[DENSE_IND(i, p, n, n)]     = c * x + std::conj(s) * y;
+            H[DENSE_IND(i, p + 1, n, n)] = -s * x + c * y;
+        }
+    }
+
+    // Complex Schur form H = Z T Z^H of a general n x n matrix H, based on the Hessenberg
+    // reduction and the shifted QR algorithm. H is overwritten by T.
+    static bool dense_schur_(int n, cdouble* H, cdouble* Z)
+    {
+        const double eps = std::numeric_limits<double>::epsilon();
+
+        for(int j = 0; j < n; ++j)
+        {
+            for(int i = 0; i < n; ++i)
+            {
+                Z[DENSE_IND(i, j, n, n)] = (i == j) ? 1.0 : 0.0;
+            }
+        }
+
+        double c;
+        cdouble s;
+
+        // Reduction to upper Hessenberg form
+        for(int k = 0; k < n - 2; ++k)
+        {
+            for(int i = n - 1; i > k + 1; --i)
+            {
+                if(H[DENSE_IND(i, k, n, n)] == 0.0)
+                {
+                    continue;
+                }
+
+                givens_(H[DENSE_IND(i - 1, k, n, n)], H[DENSE_IND(i, k, n, n)], c, s);
+
+                rot_rows_(n, H, i - 1, k, c, s);
+                rot_cols_(n, H, i - 1, n, c, s);
+                rot_cols_(n, Z, i - 1, n, c, s);
+
+                H[DENSE_IND(i, k, n, n)] = 0.0;
+            }
+        }
+
+        double nrm = 0.0;
+        for(int i = 0; i < n * n; ++i)
+        {
+            nrm += std::norm(H[i]);
+        }
+        nrm = std::sqrt(nrm);
+
+        // Shifted QR iteration on the active block [lo, hi]
+        std::vector<double>  cs(n);
+        std::vector<cdouble> sn(n);
+
+        int hi    = n - 1;
+        int iter  = 0;
+        int total = 0;
+
+        while(hi > 0)
+        {
+            // Look for a negligible sub-diagonal entry
+            int lo = hi;
+            while(lo > 0)
+            {
+                double scale = std::abs(H[DENSE_IND(lo - 1, lo - 1, n, n)])
+                               + std::abs(H[DENSE_IND(lo, lo, n, n)]);
+                if(scale == 0.0)
+                {
+                    scale = nrm;
+                }
+
+                if(std::abs(H[DENSE_IND(lo, lo - 1, n, n)]) <= eps * scale)
+                {
+                    H[DENSE_IND(lo, lo - 1, n, n)] = 0.0;
+                    break;
+                }
+
+                --lo;
+            }
+
+            // Eigenvalue converged
+            if(lo == hi)
+            {
+                --hi;
+                iter = 0;
+                continue;
+            }
+
+            if(++total > 100 * n)
+            {
+                return false;
+            }
+
+            // Wilkinson shift, with an exceptional shift every ten iterations
+            cdouble a = H[DENSE_IND(hi - 1, hi - 1, n, n)];
+            cdouble b = H[DENSE_IND(hi - 1, hi, n, n)];
+            cdouble d = H[DENSE_IND(hi, hi - 1, n, n)];
+            cdouble e = H[DENSE_IND(hi, hi, n, n)];
+
+            cdouble shift;
+
+            if(++iter % 10 == 0)
+            {
+                shift = e + 0.75 * std::abs(d);
+            }
+            else
+            {
+                cdouble mid  = 0.5 * (a + e);
+                cdouble disc = std::sqrt(0.25 * (a - e) * (a - e) + b * d);
+
+                shift = (std::abs(mid + disc - e) < std::abs(mid - disc - e)) ? mid + disc
+                                                                              : mid - disc;
+            }
+
+            for(int i = lo; i <= hi; ++i)
+            {
+                H[DENSE_IND(i, i, n, n)] -= shift;
+            }
+
+            // H - shift I = QR
+            for(int j = lo; j < hi; ++j)
+            {
+                givens_(H[DENSE_IND(j, j, n, n)], H[DENSE_IND(j + 1, j, n, n)], cs[j], sn[j]);
+                rot_rows_(n, H, j, j, cs[j], sn[j]);
+
+                H[DENSE_IND(j + 1, j, n, n)] = 0.0;
+            }
+
+            // RQ + shift I
+            for(int j = lo; j < hi; ++j)
+            {
+                rot_cols_(n, H, j, std::min(j + 2, hi) + 1, cs[j], sn[j]);
+                rot_cols_(n, Z, j, n, cs[j], sn[j]);
+            }
+
+            for(int i = lo; i <= hi; ++i)
+            {
+                H[DENSE_IND(i, i, n, n)] += shift;
+            }
+        }
+
+        return true;
+    }
+
+    // Swap the diagonal entries p and p + 1 of the Schur form T = Z^H H Z
+    static void schur_swap_(int n, cdouble* T, cdouble* Z, int p)
+    {
+        cdouble t11 = T[DENSE_IND(p, p, n, n)];
+        cdouble t22 = T[DENSE_IND(p + 1, p + 1, n, n)];
+
+        double  c;
+        cdouble s;
+
+        givens_(T[DENSE_IND(p, p + 1, n, n)], t22 - t11, c, s);
+
+        rot_rows_(n, T, p, p + 2, c, s);
+        rot_cols_(n, T, p, p, c, s);
+        rot_cols_(n, Z, p, n, c, s);
+
+        T[DENSE_IND(p, p, n, n)]         = t22;
+        T[DENSE_IND(p + 1, p + 1, n, n)] = t11;
+    }
+
+    template <typename ValueType>
+    int recycle_cholesky(int n, ValueType* A, int* keep, bool conj)
+    {
+        assert(n >= 0);
+        assert(A != NULL || n == 0);
+        assert(keep != NULL || n == 0);
+
+        // Columns with a relative distance below tol to the span of the previous ones
+        // are skipped
+        double tol = std::sqrt(eps_(ValueType()));
+
+        // The transpose of a real matrix is its conjugate transpose
+        conj = conj || !is_complex_(ValueType());
+
+        std::vector<ValueType> R(n * n, static_cast<ValueType>(0));
+
+        int size = 0;
+
+        for(int i = 0; i < n; ++i)
+        {
+            // Next column of R
+            for(int a = 0; a < size; ++a)
+            {
+                ValueType sum = A[DENSE_IND(keep[a], i, n, n)];
+                for(int c = 0; c < a; ++c)
+                {
+                    ValueType rca = R[DENSE_IND(c, a, n, n)];
+                    sum -= ((conj == true) ? conj_(rca) : rca) * R[DENSE_IND(c, size, n, n)];
+                }
+
+                R[DENSE_IND(a, size, n, n)] = sum / R[DENSE_IND(a, a, n, n)];
+            }
+
+            ValueType diag = A[DENSE_IND(i, i, n, n)];
+            for(int c = 0; c < size; ++c)
+            {
+                ValueType rc = R[DENSE_IND(c, size, n, n)];
+                diag -= ((conj == true) ? conj_(rc) : rc) * rc;
+            }
+
+            double ref = std::abs(A[DENSE_IND(i, i, n, n)]);
+
+            if(conj == true)
+            {
+                if(std::real(diag) > tol * ref)
+                {
+                    R[DENSE_IND(size, size, n, n)]
+                        = static_cast<ValueType>(std::sqrt(std::real(diag)));
+                    keep[size++] = i;
+                }
+            }
+            else if(std::abs(diag) > tol * ref)
+            {
+                R[DENSE_IND(size, size, n, n)] = std::sqrt(diag);
+                keep[size++] = i;
+            }
+        }
+
+        for(int j = 0; j < n; ++j)
+        {
+            for(int i = 0; i < n; ++i)
+            {
+                A[DENSE_IND(i, j, n, n)] = (i < size && j < size) ? R[DENSE_IND(i, j, n, n)]
+                                                                  : static_cast<ValueType>(0);
+            }
+        }
+
+        return size;
+    }
+
+    template <typename ValueType>
+    int recycle_eigenvectors(
+        int n, const ValueType* A, const ValueType* B, int k, bool conj, ValueType* Y)
+    {
+        assert(n > 0);
+        assert(k > 0);
+        assert(A != NULL);
+        assert(B != NULL);
+        assert(Y != NULL);
+
+        // B = R^H R, directions in which B is numerically singular are skipped by solving
+        // the reduced problem
+        std::vector<ValueType> R(B, B + n * n);
+        std::vector<int>       keep(n);
+
+        int nk = recycle_cholesky(n, R.data(), keep.data(), conj);
+
+        if(nk == 0)
+        {
+            return 0;
+        }
+
+        if(nk < n)
+        {
+            std::vector<ValueType> Ak(nk * nk);
+            std::vector<ValueType> Bk(nk * nk);
+            std::vector<ValueType> Yk(nk * k);
+
+            for(int j = 0; j < nk; ++j)
+            {
+                for(int i = 0; i < nk; ++i)
+                {
+                    Ak[DENSE_IND(i, j, nk, nk)] = A[DENSE_IND(keep[i], keep[j], n, n)];
+                    Bk[DENSE_IND(i, j, nk, nk)] = B[DENSE_IND(keep[i], keep[j], n, n)];
+                }
+            }
+
+            int size = recycle_eigenvectors(nk, Ak.data(), Bk.data(), k, conj, Yk.data());
+
+            for(int c = 0; c < size; ++c)
+            {
+                for(int i = 0; i < n; ++i)
+                {
+                    Y[DENSE_IND(i, c, n, k)] = static_cast<ValueType>(0);
+                }
+
+                for(int i = 0; i < nk; ++i)
+                {
+                    Y[DENSE_IND(keep[i], c, n, k)] = Yk[DENSE_IND(i, c, nk, k)];
+                }
+            }
+
+            return size;
+        }
+
+        conj = conj || !is_complex_(ValueType());
+
+        // B = L L^H
+        std::vector<cdouble> L(n * n, 0.0);
+
+        for(int j = 0; j < n; ++j)
+        {
+            cdouble diag = B[DENSE_IND(j, j, n, n)];
+            for(int c = 0; c < j; ++c)
+            {
+                diag -= L[DENSE_IND(j, c, n, n)] * cj_(L[DENSE_IND(j, c, n, n)], conj);
+            }
+
+            if(conj == true)
+            {
+                if(diag.real() <= 0.0)
+                {
+                    return 0;
+                }
+
+                diag = std::sqrt(diag.real());
+            }
+            else
+            {
+                if(diag == 0.0)
+                {
+                    return 0;
+                }
+
+                diag = std::sqrt(diag);
+            }
+
+            L[DENSE_IND(j, j, n, n)] = diag;
+
+            for(int i = j + 1; i < n; ++i)
+            {
+                cdouble sum = B[DENSE_IND(i, j, n, n)];
+                for(int c = 0; c < j; ++c)
+                {
+                    sum -= L[DENSE_IND(i, c, n, n)] * cj_(L[DENSE_IND(j, c, n, n)], conj);
+                }
+
+                L[DENSE_IND(i, j, n, n)] = sum / diag;
+            }
+        }
+
+        // Linv = L^-1
+        std::vector<cdouble> Linv(n * n, 0.0);
+
+        for(int j = 0; j < n; ++j)
+        {
+            for(int i = j; i < n; ++i)
+            {
+                cdouble sum = (i == j) ? 1.0 : 0.0;
+                for(int c = j; c < i; ++c)
+                {
+                    sum -= L[DENSE_IND(i, c, n, n)] * Linv[DENSE_IND(c, j, n, n)];
+                }
+
+                Linv[DENSE_IND(i, j, n, n)] = sum / L[DENSE_IND(i, i, n, n)];
+            }
+        }
+
+        // C = L^-1 A L^-H
+        std::vector<cdouble> T(n * n, 0.0);
+        std::vector<cdouble> C(n * n, 0.0);
+
+        for(int j = 0; j < n; ++j)
+        {
+            for(int i = 0; i < n; ++i)
+            {
+                cdouble sum = 0.0;
+                for(int c = 0; c <= i; ++c)
+                {
+                    sum += Linv[DENSE_IND(i, c, n, n)]
+                           * static_cast<cdouble>(A[DENSE_IND(c, j, n, n)]);
+                }
+
+                T[DENSE_IND(i, j, n, n)] = sum;
+            }
+        }
+
+        for(int j = 0; j < n; ++j)
+        {
+            for(int i = 0; i < n; ++i)
+            {
+                cdouble sum = 0.0;
+                for(int c = j; c < n; ++c)
+                {
+                    sum += T[DENSE_IND(i, c, n, n)] * cj_(Linv[DENSE_IND(j, c, n, n)], conj);
+                }
+
+                C[DENSE_IND(i, j, n, n)] = sum;
+            }
+        }
+
+        // Schur form C = Q T Q^H
+        std::vector<cdouble> Q(n * n);
+
+        if(dense_schur_(n, C.data(), Q.data()) == false)
+        {
+            return 0;
+        }
+
+        // Select the eigenvalues of largest magnitude, for real types complex conjugate
+        // pairs are selected together
+        const double tol       = std::sqrt(std::numeric_limits<double>::epsilon());
+        const bool   real_type = !is_complex_(ValueType());
+
+        std::vector<int> perm(n);
+        for(int i = 0; i < n; ++i)
+        {
+            perm[i] = i;
+        }
+
+        std::stable_sort(perm.begin(), perm.end(), [&C, n](int a, int b) {
+            return std::abs(C[DENSE_IND(a, a, n, n)]) > std::abs(C[DENSE_IND(b, b, n, n)]);
+        });
+
+        std::vector<bool> select(n, false);
+
+        int size = 0;
+
+        for(int p = 0; p < n && size < k; ++p)
+        {
+            int idx = perm[p];
+
+            if(select[idx] == true)
+            {
+                continue;
+            }
+
+            cdouble lambda = C[DENSE_IND(idx, idx, n, n)];
+
+            if(real_type == true && std::abs(lambda.imag()) > tol * std::abs(lambda))
+            {
+                int    partner = -1;
+                double dist    = 0.0;
+
+                for(int j = 0; j < n; ++j)
+                {
+                    double d = std::abs(C[DENSE_IND(j, j, n, n)] - std::conj(lambda));
+
+                    if(j != idx && select[j] == false && (partner == -1 || d < dist))
+                    {
+                        partner = j;
+                        dist    = d;
+                    }
+                }
+
+                if(partner == -1 || size + 2 > k)
+                {
+                    break;
+                }
+
+                select[idx]     = true;
+                select[partner] = true;
+                size += 2;
+            }
+            else
+            {
+                select[idx] = true;
+                ++size;
+            }
+        }
+
+        // Reorder the Schur form, such that the leading Schur vectors span the invariant
+        // subspace of the selected eigenvalues
+        int lead = 0;
+
+        for(int j = 0; j < n; ++j)
+        {
+            if(select[j] == true)
+            {
+                for(int p = j; p > lead; --p)
+                {
+                    schur_swap_(n, C.data(), Q.data(), p - 1);
+                    select[p]     = select[p - 1];
+                    select[p - 1] = true;
+                }
+
+                ++lead;
+            }
+        }
+
+        // Orthonormal basis V of the subspace, for real types from the real and imaginary
+        // parts of the Schur vectors
+        std::vector<cdouble> V(n * size, 0.0);
+
+        int num = 0;
+
+        if(real_type == false)
+        {
+            std::copy(Q.begin(), Q.begin() + n * size, V.begin());
+            num = size;
+        }
+        else
+        {
+            std::vector<double> w(n);
+
+            for(int j = 0; j < 2 * size && num < size; ++j)
+            {
+                for(int i = 0; i < n; ++i)
+                {
+                    w[i] = (j % 2 == 0) ? Q[DENSE_IND(i, j / 2, n, n)].real()
+                                        : Q[DENSE_IND(i, j / 2, n, n)].imag();
+                }
+
+                for(int pass = 0; pass < 2; ++pass)
+                {
+                    for(int c = 0; c < num; ++c)
+                    {
+                        double h = 0.0;
+                        for(int i = 0; i < n; ++i)
+                        {
+                            h += V[DENSE_IND(i, c, n, size)].real() * w[i];
+                        }
+
+                        for(int i = 0; i < n; ++i)
+                        {
+                            w[i] -= h * V[DENSE_IND(i, c, n, size)].real();
+                        }
+                    }
+                }
+
+                double nrm = 0.0;
+                for(int i = 0; i < n; ++i)
+                {
+                    nrm += w[i] * w[i];
+                }
+
+                nrm = std::sqrt(nrm);
+
+                // Schur vectors have unit length, skip linearly dependent parts
+                if(nrm <= tol)
+                {
+                    continue;
+                }
+
+                for(int i = 0; i < n; ++i)
+                {
+                    V[DENSE_IND(i, num, n, size)] = w[i] / nrm;
+                }
+
+                ++num;
+            }
+        }
+
+        // Y = L^-H V
+        for(int c = 0; c < num; ++c)
+        {
+            for(int i = 0; i < n; ++i)
+            {
+                cdouble sum = 0.0;
+                for(int l = i; l < n; ++l)
+                {
+                    sum += cj_(Linv[DENSE_IND(l, i, n, n)], conj) * V[DENSE_IND(l, c, n, size)];
+                }
+
+                Y[DENSE_IND(i, c, n, k)] = from_cdouble_<ValueType>(sum);
+            }
+        }
+
+        return num;
+    }
+
+    template <typename ValueType>
+    int recycle_harmonic_ritz(
+        int m, int n, const ValueType* G, const ValueType* WV, int k, ValueType* P)
+    {
+        assert(m >= n);
+        assert(n > 0);
+        assert(G != NULL);
+        assert(WV != NULL);
+
+        // G^H (W^H V) y = 1/theta G^H G y
+        std::vector<ValueType> A(n * n, static_cast<ValueType>(0));
+        std::vector<ValueType> B(n * n, static_cast<ValueType>(0));
+
+        for(int j = 0; j < n; ++j)
+        {
+            for(int i = 0; i < n; ++i)
+            {
+                ValueType a = static_cast<ValueType>(0);
+                ValueType b = static_cast<ValueType>(0);
+
+                for(int l = 0; l < m; ++l)
+                {
+                    a += conj_(G[DENSE_IND(l, i, m, n)]) * WV[DENSE_IND(l, j, m, n)];
+                    b += conj_(G[DENSE_IND(l, i, m, n)]) * G[DENSE_IND(l, j, m, n)];
+                }
+
+                A[DENSE_IND(i, j, n, n)] = a;
+                B[DENSE_IND(i, j, n, n)] = b;
+            }
+        }
+
+        return recycle_eigenvectors(n, A.data(), B.data(), k, true, P);
+    }
+
+    template <typename ValueType>
+    bool recycle_eigenvalues(int n, const ValueType* A, cdouble* lambda)
+    {
+        assert(n >= 0);
+        assert(A != NULL || n == 0);
+        assert(lambda != NULL || n == 0);
+
+        std::vector<cdouble> T(A, A + n * n);
+        std::vector<cdouble> Z(n * n);
+
+        if(dense_schur_(n, T.data(), Z.data()) == false)
+        {
+            return false;
+        }
+
+        for(int i = 0; i < n; ++i)
+        {
+            lambda[i] = T[DENSE_IND(i, i, n, n)];
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    void recycle_qr(int m, int n, ValueType* A, ValueType* R)
+    {
+        assert(m >= n);
+        assert(A != NULL || n == 0);
+        assert(R != NULL || n == 0);
+
+        for(int j = 0; j < n; ++j)
+        {
+            for(int i = 0; i < n; ++i)
+            {
+                R[DENSE_IND(i, j, n, n)] = static_cast<ValueType>(0);
+            }
+
+            // Modified Gram-Schmidt with re-orthogonalization
+            for(int pass = 0; pass < 2; ++pass)
+            {
+                for(int i = 0; i < j; ++i)
+                {
+                    ValueType h = static_cast<ValueType>(0);
+                    for(int l = 0; l < m; ++l)
+                    {
+                        h += conj_(A[DENSE_IND(l, i, m, n)]) * A[DENSE_IND(l, j, m, n)];
+                    }
+
+                    for(int l = 0; l < m; ++l)
+                    {
+                        A[DENSE_IND(l, j, m, n)] -= h * A[DENSE_IND(l, i, m, n)];
+                    }
+
+                    R[DENSE_IND(i, j, n, n)] += h;
+                }
+            }
+
+            double nrm = 0.0;
+            for(int l = 0; l < m; ++l)
+            {
+                nrm += std::norm(A[DENSE_IND(l, j, m, n)]);
+            }
+
+            nrm = std::sqrt(nrm);
+
+            R[DENSE_IND(j, j, n, n)] = static_cast<ValueType>(nrm);
+
+            if(nrm > 0.0)
+            {
+                for(int l = 0; l < m; ++l)
+                {
+                    A[DENSE_IND(l, j, m, n)] /= static_cast<ValueType>(nrm);
+                }
+            }
+        }
+    }
+
+    template int recycle_cholesky(int n, float* A, int* keep, bool conj);
+    template int recycle_cholesky(int n, double* A, int* keep, bool conj);
+#ifdef SUPPORT_COMPLEX
+    template int recycle_cholesky(int n, std::complex<float>* A, int* keep, bool conj);
+    template int recycle_cholesky(int n, std::complex<double>* A, int* keep, bool conj);
+#endif
+
+    template int recycle_eigenvectors(
+        int n, const float* A, const float* B, int k, bool conj, float* Y);
+    template int recycle_eigenvectors(
+        int n, const double* A, const double* B, int k, bool conj, double* Y);
+#ifdef SUPPORT_COMPLEX
+    template int recycle_eigenvectors(int                        n,
+                                      const std::complex<float>* A,
+                                      const std::complex<float>* B,
+                                      int                        k,
+                                      bool                       conj,
+                                      std::complex<float>*       Y);
+    template int recycle_eigenvectors(int                         n,
+                                      const std::complex<double>* A,
+                                      const std::complex<double>* B,
+                                      int                         k,
+                                      bool                        conj,
+                                      std::complex<double>*       Y);
+#endif
+
+    template int recycle_harmonic_ritz(
+        int m, int n, const float* G, const float* WV, int k, float* P);
+    template int recycle_harmonic_ritz(
+        int m, int n, const double* G, const double* WV, int k, double* P);
+#ifdef SUPPORT_COMPLEX
+    template int recycle_harmonic_ritz(int                        m,
+                                       int                        n,
+                                       const std::complex<float>* G,
+                                       const std::complex<float>* WV,
+                                       int                        k,
+                                       std::complex<float>*       P);
+    template int recycle_harmonic_ritz(int                         m,
+                                       int                         n,
+                                       const std::complex<double>* G,
+                                       const std::complex<double>* WV,
+                                       int                         k,
+                                       std::complex<double>*       P);
+#endif
+
+    template bool recycle_eigenvalues(int n, const float* A, cdouble* lambda);
+    template bool recycle_eigenvalues(int n, const double* A, cdouble* lambda);
+#ifdef SUPPORT_COMPLEX
+    template bool recycle_eigenvalues(int n, const std::complex<float>* A, cdouble* lambda);
+    template bool recycle_eigenvalues(int n, const std::complex<double>* A, cdouble* lambda);
+#endif
+
+    template void recycle_qr(int m, int n, float* A, float* R);
+    template void recycle_qr(int m, int n, double* A, double* R);
+#ifdef SUPPORT_COMPLEX
+    template void recycle_qr(int m, int n, std::complex<float>* A, std::complex<float>* R);
+    template void recycle_qr(int m, int n, std::complex<double>* A, std::complex<double>* R);
+#endif
+
+} // namespace rocalution
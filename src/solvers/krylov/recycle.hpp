@@ -0,0 +1,73 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_KRYLOV_RECYCLE_HPP_
+#define ROCALUTION_KRYLOV_RECYCLE_HPP_
+
+#include <complex>
+
+namespace rocalution
+{
+
+    // Small dense kernels of the deflated, recycling and s-step Krylov solvers. All
+    // matrices are stored in column-major order (see DENSE_IND). If conj is false, the
+    // transpose is used instead of the conjugate transpose, which matches the
+    // non-conjugate inner product of the CG type solvers for complex symmetric systems.
+
+    /// Cholesky factorization \f$A = R^{H}R\f$ of an n x n Gram matrix, columns that are
+    /// (numerically) linearly dependent on the previous ones are skipped. Returns the
+    /// number of kept columns, their indices in keep and the upper triangular factor R in
+    /// the leading part of A (leading dimension n).
+    template <typename ValueType>
+    int recycle_cholesky(int n, ValueType* A, int* keep, bool conj);
+
+    /// Compute a B-orthonormal basis of the invariant subspace of the n x n generalized
+    /// eigenvalue problem \f$Ay = \mu By\f$ for up to k eigenvalues with largest
+    /// \f$|\mu|\f$, where B is positive definite. For real types, complex conjugate
+    /// pairs are selected together. Returns the number of vectors stored in the columns of
+    /// Y (n x k), or 0 on failure.
+    template <typename ValueType>
+    int recycle_eigenvectors(
+        int n, const ValueType* A, const ValueType* B, int k, bool conj, ValueType* Y);
+
+    /// Compute a basis of up to k harmonic Ritz vectors for the Arnoldi type relation
+    /// \f$AV = WG\f$, i.e. the eigenvectors of \f$G^{H}Gy = \theta G^{H}(W^{H}V)y\f$
+    /// with smallest \f$|\theta|\f$, where G and \f$W^{H}V\f$ are m x n. Returns the
+    /// number of vectors stored in the columns of P (n x k), or 0 on failure.
+    template <typename ValueType>
+    int recycle_harmonic_ritz(
+        int m, int n, const ValueType* G, const ValueType* WV, int k, ValueType* P);
+
+    /// Compute the eigenvalues of a general n x n matrix A, returns false if the QR
+    /// algorithm did not converge
+    template <typename ValueType>
+    bool recycle_eigenvalues(int n, const ValueType* A, std::complex<double>* lambda);
+
+    /// Thin QR factorization of an m x n matrix, A is overwritten by Q and R is n x n
+    template <typename ValueType>
+    void recycle_qr(int m, int n, ValueType* A, ValueType* R);
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_RECYCLE_HPP_
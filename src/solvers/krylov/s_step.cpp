@@ -0,0 +1,627 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "s_step.hpp"
+#include "../../utils/def.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_matrix_free.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+
+namespace rocalution
+{
+
+    typedef std::complex<double> cdouble;
+
+    static inline bool is_complex_(float)
+    {
+        return false;
+    }
+
+    static inline bool is_complex_(double)
+    {
+        return false;
+    }
+
+    template <typename T>
+    static inline bool is_complex_(const std::complex<T>&)
+    {
+        return true;
+    }
+
+    static inline void from_cdouble_(const cdouble& val, float* out)
+    {
+        *out = static_cast<float>(val.real());
+    }
+
+    static inline void from_cdouble_(const cdouble& val, double* out)
+    {
+        *out = val.real();
+    }
+
+    template <typename T>
+    static inline void from_cdouble_(const cdouble& val, std::complex<T>* out)
+    {
+        *out = std::complex<T>(static_cast<T>(val.real()), static_cast<T>(val.imag()));
+    }
+
+    // Gershgorin bounds are only available for LocalMatrix operators
+    template <typename ValueType>
+    static bool
+        gershgorin_(const LocalMatrix<ValueType>& op, double& lambda_min, double& lambda_max)
+    {
+        ValueType lmin, lmax;
+        op.Gershgorin(lmin, lmax);
+
+        lambda_min = rocalution_double(lmin);
+        lambda_max = rocalution_double(lmax);
+
+        return true;
+    }
+
+    template <class OperatorType>
+    static bool gershgorin_(const OperatorType& op, double& lambda_min, double& lambda_max)
+    {
+        return false;
+    }
+
+    // Matrix powers kernel of LocalMatrix operators, a sequence of Apply() otherwise
+    template <typename ValueType>
+    static void powers_(const LocalMatrix<ValueType>& op,
+                        int                           k,
+                        const ValueType*              alpha,
+                        const ValueType*              beta,
+                        const ValueType*              gamma,
+                        LocalVector<ValueType>**      v)
+    {
+        op.MatrixPowers(k, alpha, beta, gamma, v);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    static void powers_(const OperatorType& op,
+                        int                 k,
+                        const ValueType*    alpha,
+                        const ValueType*    beta,
+                        const ValueType*    gamma,
+                        VectorType**        v)
+    {
+        for(int j = 0; j < k; ++j)
+        {
+            op.Apply(*v[j], v[j + 1]);
+
+            if(j > 0)
+            {
+                v[j + 1]->ScaleAdd2(alpha[j], *v[j], beta[j], *v[j - 1], gamma[j]);
+            }
+            else
+            {
+                v[j + 1]->ScaleAddScale(alpha[j], *v[j], beta[j]);
+            }
+        }
+    }
+
+    // Leja ordering of the points z, the first k points are returned in order (the
+    // sequence is repeated if there are less than k distinct points). If pairs is set,
+    // complex conjugate pairs are kept together, the point with positive imaginary part
+    // first.
+    static void leja_order_(std::vector<cdouble> z, int k, bool pairs, std::vector<cdouble>* out)
+    {
+        out->clear();
+
+        double scale = 0.0;
+        for(size_t i = 0; i < z.size(); ++i)
+        {
+            scale = std::max(scale, std::abs(z[i]));
+        }
+
+        double tol = 1e-10 * scale;
+
+        // Keep one point of each conjugate pair
+        if(pairs == true)
+        {
+            std::vector<cdouble> half;
+            for(size_t i = 0; i < z.size(); ++i)
+            {
+                if(std::abs(z[i].imag()) <= tol)
+                {
+                    half.push_back(cdouble(z[i].real(), 0.0));
+                }
+                else if(z[i].imag() > 0.0)
+                {
+                    half.push_back(z[i]);
+                }
+            }
+
+            z.swap(half);
+        }
+
+        std::vector<cdouble> order;
+        std::vector<double>  logprod(z.size(), 0.0);
+        std::vector<bool>    used(z.size(), false);
+
+        while(static_cast<int>(order.size()) < k && order.size() < 2 * z.size())
+        {
+            // Largest modulus first, then the largest product of distances
+            int    next = -1;
+            double best = -std::numeric_limits<double>::infinity();
+
+            for(size_t i = 0; i < z.size(); ++i)
+            {
+                if(used[i] == true)
+                {
+                    continue;
+                }
+
+                double val = order.empty() ? std::abs(z[i]) : logprod[i];
+                if(next < 0 || val > best)
+                {
+                    next = static_cast<int>(i);
+                    best = val;
+                }
+            }
+
+            if(next < 0
+               || (order.empty() == false && best == -std::numeric_limits<double>::infinity()))
+            {
+                break;
+            }
+
+            used[next] = true;
+
+            std::vector<cdouble> add(1, z[next]);
+            if(pairs == true && z[next].imag() != 0.0)
+            {
+                add.push_back(std::conj(z[next]));
+            }
+
+            for(size_t a = 0; a < add.size(); ++a)
+            {
+                order.push_back(add[a]);
+
+                for(size_t i = 0; i < z.size(); ++i)
+                {
+                    logprod[i] += std::log(std::abs(z[i] - add[a]));
+                }
+            }
+        }
+
+        if(order.empty() == true)
+        {
+            return;
+        }
+
+        // Repeat the sequence, a conjugate pair must not be split at the end
+        for(int i = 0; static_cast<int>(out->size()) < k; ++i)
+        {
+            out->push_back(order[i % order.size()]);
+        }
+
+        if(pairs == true && (*out)[k - 1].imag() > 0.0)
+        {
+            (*out)[k - 1] = cdouble((*out)[k - 1].real(), 0.0);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    BaseSStep<OperatorType, VectorType, ValueType>::BaseSStep()
+    {
+        log_debug(this, "BaseSStep::BaseSStep()", "default constructor");
+
+        this->step_size_ = 4;
+        this->basis_     = NewtonBasis;
+
+        this->alpha_       = NULL;
+        this->beta_        = NULL;
+        this->gamma_       = NULL;
+        this->basis_valid_ = false;
+
+        this->user_interval_ = false;
+        this->interval_      = false;
+        this->lambda_min_    = 0.0;
+        this->lambda_max_    = 0.0;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    BaseSStep<OperatorType, VectorType, ValueType>::~BaseSStep()
+    {
+        log_debug(this, "BaseSStep::~BaseSStep()", "destructor");
+
+        this->ClearBasis_();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseSStep<OperatorType, VectorType, ValueType>::SetStepSize(int step_size)
+    {
+        log_debug(this, "BaseSStep::SetStepSize()", step_size);
+
+        assert(step_size > 0);
+        assert(this->build_ == false);
+
+        this->step_size_ = step_size;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseSStep<OperatorType, VectorType, ValueType>::SetBasis(unsigned int basis)
+    {
+        log_debug(this, "BaseSStep::SetBasis()", basis);
+
+        assert(basis == MonomialBasis || basis == NewtonBasis || basis == ChebyshevBasis);
+
+        this->basis_ = basis;
+
+        if(this->build_ == true)
+        {
+            this->compute_coefficients_();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseSStep<OperatorType, VectorType, ValueType>::SetSpectrum(double lambda_min,
+                                                                      double lambda_max)
+    {
+        log_debug(this, "BaseSStep::SetSpectrum()", lambda_min, lambda_max);
+
+        assert(lambda_min <= lambda_max);
+
+        this->user_interval_ = true;
+        this->interval_      = true;
+        this->lambda_min_    = lambda_min;
+        this->lambda_max_    = lambda_max;
+
+        if(this->build_ == true)
+        {
+            this->compute_coefficients_();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseSStep<OperatorType, VectorType, ValueType>::BuildBasis_(void)
+    {
+        log_debug(this, "BaseSStep::BuildBasis_()");
+
+        assert(this->op_ != NULL);
+
+        if(this->alpha_ == NULL)
+        {
+            allocate_host(this->step_size_, &this->alpha_);
+            allocate_host(this->step_size_, &this->beta_);
+            allocate_host(this->step_size_, &this->gamma_);
+        }
+
+        // The operator has changed, previous estimates are not valid anymore
+        this->ritz_.clear();
+
+        if(this->user_interval_ == false)
+        {
+            this->interval_ = false;
+
+            if(this->precond_ == NULL)
+            {
+                this->interval_
+                    = gershgorin_(*this->op_, this->lambda_min_, this->lambda_max_);
+            }
+        }
+
+        this->compute_coefficients_();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseSStep<OperatorType, VectorType, ValueType>::ClearBasis_(void)
+    {
+        log_debug(this, "BaseSStep::ClearBasis_()");
+
+        if(this->alpha_ != NULL)
+        {
+            free_host(&this->alpha_);
+            free_host(&this->beta_);
+            free_host(&this->gamma_);
+        }
+
+        this->ritz_.clear();
+        this->basis_valid_ = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    bool BaseSStep<OperatorType, VectorType, ValueType>::HasBasis_(void) const
+    {
+        return this->basis_valid_;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseSStep<OperatorType, VectorType, ValueType>::SetRitzValues_(int            n,
+                                                                         const cdouble* theta)
+    {
+        log_debug(this, "BaseSStep::SetRitzValues_()", n, theta);
+
+        assert(n >= 0);
+
+        this->ritz_.clear();
+
+        for(int i = 0; i < n; ++i)
+        {
+            if(std::isfinite(theta[i].real()) && std::isfinite(theta[i].imag()))
+            {
+                this->ritz_.push_back(theta[i]);
+            }
+        }
+
+        this->compute_coefficients_();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseSStep<OperatorType, VectorType, ValueType>::compute_coefficients_(void)
+    {
+        this->basis_valid_ = false;
+
+        if(this->alpha_ == NULL || (this->interval_ == false && this->ritz_.empty() == true))
+        {
+            return;
+        }
+
+        int  s     = this->step_size_;
+        bool pairs = !is_complex_(ValueType());
+
+        // Spectral interval, Ritz values are enlarged by 10 percent
+        double lmin = this->lambda_min_;
+        double lmax = this->lambda_max_;
+
+        // Largest modulus and diameter of the spectrum
+        double radius   = std::max(std::abs(lmin), std::abs(lmax));
+        double diameter = lmax - lmin;
+
+        if(this->interval_ == false)
+        {
+            lmin   = this->ritz_[0].real();
+            lmax   = this->ritz_[0].real();
+            radius = 0.0;
+
+            for(size_t i = 0; i < this->ritz_.size(); ++i)
+            {
+                lmin   = std::min(lmin, this->ritz_[i].real());
+                lmax   = std::max(lmax, this->ritz_[i].real());
+                radius = std::max(radius, std::abs(this->ritz_[i]));
+            }
+
+            diameter = 0.0;
+            for(size_t i = 0; i < this->ritz_.size(); ++i)
+            {
+                for(size_t j = 0; j < i; ++j)
+                {
+                    diameter = std::max(diameter, std::abs(this->ritz_[i] - this->ritz_[j]));
+                }
+            }
+
+            double ext = 0.05 * (lmax - lmin);
+            lmin -= ext;
+            lmax += ext;
+        }
+
+        if(radius == 0.0)
+        {
+            radius = 1.0;
+        }
+
+        std::vector<cdouble> alpha(s, 0.0);
+        std::vector<cdouble> beta(s, 0.0);
+        std::vector<cdouble> gamma(s, 0.0);
+
+        if(this->basis_ == MonomialBasis)
+        {
+            for(int j = 0; j < s; ++j)
+            {
+                alpha[j] = 1.0 / radius;
+            }
+        }
+        else if(this->basis_ == ChebyshevBasis)
+        {
+            double c = 0.5 * (lmax + lmin);
+            double d = 0.5 * (lmax - lmin);
+
+            if(d <= 1e-8 * radius)
+            {
+                d = 0.5 * radius;
+            }
+
+            // T_1(x) = x, T_j+1(x) = 2x T_j(x) - T_j-1(x) with x = (A - c) / d
+            alpha[0] = 1.0 / d;
+            beta[0]  = -c / d;
+
+            for(int j = 1; j < s; ++j)
+            {
+                alpha[j] = 2.0 / d;
+                beta[j]  = -2.0 * c / d;
+                gamma[j] = -1.0;
+            }
+        }
+        else
+        {
+            std::vector<cdouble> points;
+
+            if(this->interval_ == true)
+            {
+                // Chebyshev points of the interval
+                for(int i = 0; i < s; ++i)
+                {
+                    points.push_back(0.5 * (lmax + lmin)
+                                     + 0.5 * (lmax - lmin)
+                                           * std::cos((2.0 * i + 1.0) * M_PI / (2.0 * s)));
+                }
+            }
+            else
+            {
+                points = this->ritz_;
+            }
+
+            std::vector<cdouble> shift;
+            leja_order_(points, s, pairs, &shift);
+
+            // Capacity of the spectrum, keeps the basis vectors at a similar scale
+            double sigma = 0.25 * diameter;
+            if(sigma <= 1e-8 * radius)
+            {
+                sigma = radius;
+            }
+
+            for(int j = 0; j < s; ++j)
+            {
+                alpha[j] = 1.0 / sigma;
+                beta[j]  = -shift[j] / sigma;
+
+                // Complex conjugate pair in real arithmetic,
+                // v_j+2 = ((A - Re(theta)) v_j+1 + Im(theta)^2 / sigma v_j) / sigma
+                if(pairs == true && shift[j].imag() > 0.0 && j + 1 < s)
+                {
+                    alpha[j + 1] = 1.0 / sigma;
+                    beta[j]      = -shift[j].real() / sigma;
+                    beta[j + 1]  = beta[j];
+                    gamma[j + 1] = shift[j].imag() * shift[j].imag() / (sigma * sigma);
+
+                    ++j;
+                }
+            }
+        }
+
+        for(int j = 0; j < s; ++j)
+        {
+            from_cdouble_(alpha[j], &this->alpha_[j]);
+            from_cdouble_(beta[j], &this->beta_[j]);
+            from_cdouble_(gamma[j], &this->gamma_[j]);
+        }
+
+        this->basis_valid_ = true;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseSStep<OperatorType, VectorType, ValueType>::PowerBasis_(int              k,
+                                                                     const ValueType* alpha,
+                                                                     const ValueType* beta,
+                                                                     const ValueType* gamma,
+                                                                     VectorType**     v,
+                                                                     VectorType**     vt,
+                                                                     VectorType*      tmp)
+    {
+        log_debug(this, "BaseSStep::PowerBasis_()", k, v, vt, tmp);
+
+        assert(k >= 0);
+        assert(v != NULL);
+
+        if(this->precond_ == NULL)
+        {
+            powers_(*this->op_, k, alpha, beta, gamma, v);
+
+            return;
+        }
+
+        assert(vt != NULL || tmp != NULL);
+
+        for(int j = 0; j < k; ++j)
+        {
+            VectorType* t = (vt != NULL) ? vt[j + 1] : tmp;
+
+            // v_j+1 = M^-1 A v_j
+            this->op_->Apply(*v[j], t);
+            this->precond_->SolveZeroSol(*t, v[j + 1]);
+
+            if(j > 0)
+            {
+                v[j + 1]->ScaleAdd2(alpha[j], *v[j], beta[j], *v[j - 1], gamma[j]);
+            }
+            else
+            {
+                v[j + 1]->ScaleAddScale(alpha[j], *v[j], beta[j]);
+            }
+
+            // Same recurrence for Mv_j+1
+            if(vt != NULL)
+            {
+                if(j > 0)
+                {
+                    vt[j + 1]->ScaleAdd2(alpha[j], *vt[j], beta[j], *vt[j - 1], gamma[j]);
+                }
+                else
+                {
+                    vt[j + 1]->ScaleAddScale(alpha[j], *vt[j], beta[j]);
+                }
+            }
+        }
+    }
+
+    template class BaseSStep<LocalMatrix<double>, LocalVector<double>, double>;
+    template class BaseSStep<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class BaseSStep<LocalMatrix<std::complex<double>>,
+                             LocalVector<std::complex<double>>,
+                             std::complex<double>>;
+    template class BaseSStep<LocalMatrix<std::complex<float>>,
+                             LocalVector<std::complex<float>>,
+                             std::complex<float>>;
+#endif
+
+    template class BaseSStep<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class BaseSStep<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class BaseSStep<GlobalMatrix<std::complex<double>>,
+                             GlobalVector<std::complex<double>>,
+                             std::complex<double>>;
+    template class BaseSStep<GlobalMatrix<std::complex<float>>,
+                             GlobalVector<std::complex<float>>,
+                             std::complex<float>>;
+#endif
+
+    template class BaseSStep<LocalStencil<double>, LocalVector<double>, double>;
+    template class BaseSStep<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class BaseSStep<LocalStencil<std::complex<double>>,
+                             LocalVector<std::complex<double>>,
+                             std::complex<double>>;
+    template class BaseSStep<LocalStencil<std::complex<float>>,
+                             LocalVector<std::complex<float>>,
+                             std::complex<float>>;
+#endif
+
+    template class BaseSStep<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class BaseSStep<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class BaseSStep<LocalMatrixFree<std::complex<double>>,
+                             LocalVector<std::complex<double>>,
+                             std::complex<double>>;
+    template class BaseSStep<LocalMatrixFree<std::complex<float>>,
+                             LocalVector<std::complex<float>>,
+                             std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,140 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_KRYLOV_S_STEP_HPP_
+#define ROCALUTION_KRYLOV_S_STEP_HPP_
+
+#include "../solver.hpp"
+
+#include <complex>
+#include <vector>
+
+namespace rocalution
+{
+
+    enum _s_step_basis
+    {
+        MonomialBasis  = 0,
+        NewtonBasis    = 1,
+        ChebyshevBasis = 2
+    };
+
+    /** \ingroup solver_module
+  * \class BaseSStep
+  * \brief Base class for s-step Krylov solvers
+  * \details
+  * s-step (communication-avoiding) Krylov solvers compute \f$s\f$ vectors of the Krylov
+  * subspace at once and orthogonalize them by a single block reduction, which reduces
+  * the number of global synchronizations by a factor of \f$s\f$. The basis vectors are
+  * computed by the polynomial recurrence
+  * \f[
+  *   v_{j+1} = \alpha_{j}Av_{j} + \beta_{j}v_{j} + \gamma_{j}v_{j-1},
+  * \f]
+  * which is a single matrix powers kernel (see LocalMatrix::MatrixPowers()) if there is
+  * no preconditioner. The monomial basis becomes ill-conditioned quickly, the Newton and
+  * Chebyshev bases use the spectrum of the (preconditioned) operator to keep larger
+  * \f$s\f$ stable, see SetBasis(). \cite hoemmen
+  *
+  * The spectrum is taken from SetSpectrum(), from the Gershgorin circles of a LocalMatrix
+  * operator without preconditioner, or it is estimated from the Ritz values of a few
+  * classical iterations at the beginning of the first solve. Estimated spectra are kept
+  * across calls to Solve() until the solver is rebuilt.
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil or
+  *                       LocalMatrixFree
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class BaseSStep : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        BaseSStep();
+        virtual ~BaseSStep();
+
+        /** \brief Set the number of steps \f$s\f$ per block reduction (default 4) */
+        void SetStepSize(int step_size);
+
+        /** \brief Set the polynomial basis
+      * \details
+      * \p MonomialBasis scales the powers of the operator by its spectral radius.
+      * \p NewtonBasis uses the Leja ordered Ritz values (or Chebyshev points of the
+      * spectral interval) as shifts. \p ChebyshevBasis uses the Chebyshev polynomials of
+      * the (real) spectral interval.
+      */
+        void SetBasis(unsigned int basis);
+
+        /** \brief Set an interval that contains the (real parts of the) spectrum of the
+      * (preconditioned) operator, which replaces the Gershgorin bounds and estimates
+      */
+        void SetSpectrum(double lambda_min, double lambda_max);
+
+    protected:
+        /** \brief Determine the spectrum and the basis coefficients, if possible */
+        void BuildBasis_(void);
+        /** \brief Release the basis coefficients and the estimated spectrum */
+        void ClearBasis_(void);
+        /** \brief Return true if the basis coefficients are known */
+        bool HasBasis_(void) const;
+        /** \brief Set the spectrum estimate to the Ritz values \p theta */
+        void SetRitzValues_(int n, const std::complex<double>* theta);
+
+        /** \brief Compute the basis vectors \p v[1], ..., \p v[k] from \p v[0]
+      * \details
+      * If there is a preconditioner \f$M\f$, the basis of \f$M^{-1}A\f$ is computed. If
+      * \p vt is not NULL, \p vt[j] = \f$Mv_{j}\f$ is computed as well (\p vt[0] is given),
+      * otherwise \p tmp is used as temporary storage.
+      */
+        void PowerBasis_(int              k,
+                         const ValueType* alpha,
+                         const ValueType* beta,
+                         const ValueType* gamma,
+                         VectorType**     v,
+                         VectorType**     vt,
+                         VectorType*      tmp);
+
+        int          step_size_; /**< \private */
+        unsigned int basis_; /**< \private */
+
+        // Basis coefficients of size step_size_, valid if basis_valid_ is set
+        ValueType* alpha_; /**< \private */
+        ValueType* beta_; /**< \private */
+        ValueType* gamma_; /**< \private */
+        bool       basis_valid_; /**< \private */
+
+    private:
+        // Fill alpha_, beta_ and gamma_ from the current spectrum
+        void compute_coefficients_(void);
+
+        // Spectral interval (from SetSpectrum() or Gershgorin) and estimated Ritz values
+        bool   user_interval_;
+        bool   interval_;
+        double lambda_min_;
+        double lambda_max_;
+
+        std::vector<std::complex<double>> ritz_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_S_STEP_HPP_
@@ -0,0 +1,505 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "multicolored_sor.hpp"
+#include "../utils/def.hpp"
+#include "iter_ctrl.hpp"
+
+#include "../base/local_matrix.hpp"
+#include "../base/local_vector.hpp"
+
+#include "../utils/allocate_free.hpp"
+#include "../utils/log.hpp"
+#include "../utils/math_functions.hpp"
+
+#include <complex>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    MultiColoredSOR<OperatorType, VectorType, ValueType>::MultiColoredSOR()
+    {
+        log_debug(this, "MultiColoredSOR::MultiColoredSOR()");
+
+        this->omega_        = static_cast<ValueType>(1);
+        this->symmetric_    = false;
+        this->fixed_sweeps_ = false;
+
+        this->host_csr_ = false;
+
+        this->num_colors_   = 0;
+        this->color_offset_ = NULL;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    MultiColoredSOR<OperatorType, VectorType, ValueType>::~MultiColoredSOR()
+    {
+        log_debug(this, "MultiColoredSOR::~MultiColoredSOR()");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::SetRelaxation(ValueType omega)
+    {
+        log_debug(this, "MultiColoredSOR::SetRelaxation()", omega);
+
+        this->omega_ = omega;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::SetSymmetric(bool symmetric)
+    {
+        log_debug(this, "MultiColoredSOR::SetSymmetric()", symmetric);
+
+        this->symmetric_ = symmetric;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::SetFixedSweeps(bool fixed_sweeps)
+    {
+        log_debug(this, "MultiColoredSOR::SetFixedSweeps()", fixed_sweeps);
+
+        assert(this->build_ == false);
+
+        this->fixed_sweeps_ = fixed_sweeps;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->symmetric_ == true)
+        {
+            LOG_INFO("Multi-colored SSOR solver");
+        }
+        else
+        {
+            LOG_INFO("Multi-colored SOR solver");
+        }
+
+        if(this->build_ == true)
+        {
+            LOG_INFO("number of colors = " << this->num_colors_);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        LOG_INFO("Multi-colored SOR (non-precond) linear solver starts");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        LOG_INFO("Multi-colored SOR (non-precond) ends");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "MultiColoredSOR::Build()", this->build_, " #*# begin");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->op_->GetM() > 0);
+        assert(this->op_->GetNnz() > 0);
+
+        int n = this->op_->GetM();
+
+        // Colors of the rows
+        LocalVector<int> perm;
+        perm.CloneBackend(*this->op_);
+
+        int* size_colors = NULL;
+        this->op_->MultiColoring(this->num_colors_, &size_colors, &perm);
+
+        perm.MoveToHost();
+
+        int* color = NULL;
+        int* rows  = NULL;
+        allocate_host(n, &color);
+        allocate_host(n, &rows);
+
+        perm.CopyToData(color);
+
+        // The permutation orders the rows by color, its inverse lists the rows of each color
+        for(int i = 0; i < n; ++i)
+        {
+            rows[color[i]] = i;
+        }
+
+        free_host(&color);
+
+        allocate_host(this->num_colors_ + 1, &this->color_offset_);
+
+        this->color_offset_[0] = 0;
+        for(int i = 0; i < this->num_colors_; ++i)
+        {
+            this->color_offset_[i + 1] = this->color_offset_[i] + size_colors[i];
+        }
+
+        free_host(&size_colors);
+
+        this->color_rows_.SetDataPtr(&rows, "MultiColoredSOR color rows", n);
+
+        // The sweeps are performed on the host in CSR format, other operators are copied
+        // once instead of being converted at each sweep
+        this->host_csr_ = (this->op_->GetFormat() != CSR || this->op_->is_accel_() == true);
+
+        if(this->host_csr_ == true)
+        {
+            this->BuildHostCSR_();
+        }
+        else
+        {
+            this->color_rows_.CloneBackend(*this->op_);
+        }
+
+        if(this->fixed_sweeps_ == false)
+        {
+            this->r_.CloneBackend(*this->op_);
+            this->r_.Allocate("r", n);
+        }
+
+        log_debug(this, "MultiColoredSOR::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "MultiColoredSOR::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->csr_op_.Clear();
+            this->rhs_host_.Clear();
+            this->x_host_.Clear();
+            this->host_csr_ = false;
+
+            this->color_rows_.Clear();
+            free_host(&this->color_offset_);
+            this->num_colors_ = 0;
+
+            this->r_.Clear();
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "MultiColoredSOR::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            // The colors only depend on the structure, the values are read by the sweeps
+            if(this->host_csr_ == true)
+            {
+                this->BuildHostCSR_();
+            }
+
+            this->iter_ctrl_.Clear();
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "MultiColoredSOR::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->color_rows_.MoveToHost();
+            this->r_.MoveToHost();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "MultiColoredSOR::MoveToAcceleratorLocalData_()", this->build_);
+
+        // The host CSR copy and its color rows stay on the host
+        if(this->build_ == true)
+        {
+            if(this->host_csr_ == false)
+            {
+                this->color_rows_.MoveToAccelerator();
+            }
+
+            this->r_.MoveToAccelerator();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::SolveZeroSol(const VectorType& rhs,
+                                                                            VectorType*       x)
+    {
+        log_debug(this, "MultiColoredSOR::SolveZeroSol()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->build_ == true);
+
+        if(this->verb_ > 0)
+        {
+            this->PrintStart_();
+            this->iter_ctrl_.PrintInit();
+        }
+
+        if(this->precond_ == NULL)
+        {
+            this->Solve_(rhs, x, true);
+        }
+        else
+        {
+            this->SolvePrecond_(rhs, x);
+        }
+
+        if(this->verb_ > 0)
+        {
+            this->iter_ctrl_.PrintStatus();
+            this->PrintEnd_();
+        }
+
+        log_debug(this, "MultiColoredSOR::SolveZeroSol()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::SolveNonPrecond_(
+        const VectorType& rhs, VectorType* x)
+    {
+        log_debug(this, "MultiColoredSOR::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ == NULL);
+        assert(this->build_ == true);
+
+        this->Solve_(rhs, x, false);
+
+        log_debug(this, "MultiColoredSOR::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                             VectorType*       x)
+    {
+        LOG_INFO("MultiColoredSOR solver does not work with preconditioner");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::Solve_(const VectorType& rhs,
+                                                                      VectorType*       x,
+                                                                      bool              zero_guess)
+    {
+        log_debug(this, "MultiColoredSOR::Solve_()", (const void*&)rhs, x, zero_guess);
+
+        int max_iter = this->iter_ctrl_.GetMaximumIterations();
+
+        if(this->fixed_sweeps_ == true)
+        {
+            this->Sweep_(rhs, x, zero_guess, max_iter);
+
+            return;
+        }
+
+        if(max_iter < 1)
+        {
+            if(zero_guess == true)
+            {
+                x->Zeros();
+            }
+
+            return;
+        }
+
+        ValueType res;
+
+        // initial residual = b - Ax
+        if(zero_guess == true)
+        {
+            res = this->Norm_(rhs);
+        }
+        else
+        {
+            this->op_->Apply(*x, &this->r_);
+            this->r_.ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+            res = this->Norm_(this->r_);
+        }
+
+        if(this->iter_ctrl_.InitResidual(std::abs(res)) == false)
+        {
+            if(zero_guess == true)
+            {
+                x->Zeros();
+            }
+
+            return;
+        }
+
+        // First sweep, x is not read for a zero initial guess
+        this->Sweep_(rhs, x, zero_guess, 1);
+
+        // residual = b - Ax
+        this->op_->Apply(*x, &this->r_);
+        this->r_.ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+        res = this->Norm_(this->r_);
+
+        while(!this->iter_ctrl_.CheckResidual(std::abs(res), this->index_))
+        {
+            this->Sweep_(rhs, x, false, 1);
+
+            // residual = b - Ax
+            this->op_->Apply(*x, &this->r_);
+            this->r_.ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+            res = this->Norm_(this->r_);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::BuildHostCSR_(void)
+    {
+        log_debug(this, "MultiColoredSOR::BuildHostCSR_()");
+
+        if(this->op_->is_accel_() == true)
+        {
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: MultiColoredSOR sweeps are performed on a host copy "
+                             "of the operator");
+        }
+
+        this->csr_op_.Clear();
+        this->csr_op_.MoveToHost();
+        this->csr_op_.ConvertTo(this->op_->GetFormat());
+        this->csr_op_.CopyFrom(*this->op_);
+        this->csr_op_.ConvertToCSR();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSOR<OperatorType, VectorType, ValueType>::Sweep_(const VectorType& rhs,
+                                                                      VectorType*       x,
+                                                                      bool              zero_guess,
+                                                                      int               sweeps)
+    {
+        log_debug(this, "MultiColoredSOR::Sweep_()", (const void*&)rhs, x, zero_guess, sweeps);
+
+        // Operators that have been converted or moved to the accelerator after Build()
+        if(this->host_csr_ == false
+           && (this->op_->GetFormat() != CSR || this->op_->is_accel_() == true))
+        {
+            this->host_csr_ = true;
+            this->BuildHostCSR_();
+            this->color_rows_.MoveToHost();
+        }
+
+        if(this->host_csr_ == false)
+        {
+            this->op_->SORSweep(this->num_colors_,
+                                this->color_offset_,
+                                this->color_rows_,
+                                this->omega_,
+                                this->symmetric_,
+                                zero_guess,
+                                sweeps,
+                                rhs,
+                                x);
+        }
+        else if(this->op_->is_accel_() == false)
+        {
+            this->csr_op_.SORSweep(this->num_colors_,
+                                   this->color_offset_,
+                                   this->color_rows_,
+                                   this->omega_,
+                                   this->symmetric_,
+                                   zero_guess,
+                                   sweeps,
+                                   rhs,
+                                   x);
+        }
+        else
+        {
+            // Vectors of accelerator operators are swept on the host
+            if(this->rhs_host_.GetSize() == 0)
+            {
+                this->rhs_host_.Allocate("rhs host", this->op_->GetM());
+                this->x_host_.Allocate("x host", this->op_->GetM());
+            }
+
+            this->rhs_host_.CopyFrom(rhs);
+
+            if(zero_guess == false)
+            {
+                this->x_host_.CopyFrom(*x);
+            }
+
+            this->csr_op_.SORSweep(this->num_colors_,
+                                   this->color_offset_,
+                                   this->color_rows_,
+                                   this->omega_,
+                                   this->symmetric_,
+                                   zero_guess,
+                                   sweeps,
+                                   this->rhs_host_,
+                                   &this->x_host_);
+
+            x->CopyFrom(this->x_host_);
+        }
+    }
+
+    template class MultiColoredSOR<LocalMatrix<double>, LocalVector<double>, double>;
+    template class MultiColoredSOR<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class MultiColoredSOR<LocalMatrix<std::complex<double>>,
+                                   LocalVector<std::complex<double>>,
+                                   std::complex<double>>;
+    template class MultiColoredSOR<LocalMatrix<std::complex<float>>,
+                                   LocalVector<std::complex<float>>,
+                                   std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,133 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_MULTICOLORED_SOR_HPP_
+#define ROCALUTION_MULTICOLORED_SOR_HPP_
+
+#include "solver.hpp"
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class MultiColoredSOR
+  * \brief Multi-Colored Gauss-Seidel and SOR Iteration Scheme
+  * \details
+  * The Multi-Colored SOR iteration scheme performs Gauss-Seidel (\f$\omega = 1\f$) or
+  * SOR sweeps in place, without a preconditioner and without permuting the operator.
+  * During Build(), the rows are split into colors (see LocalMatrix::MultiColoring()),
+  * such that the rows of a color do not depend on each other. Each sweep then updates
+  * the colors in turn, all rows of a color in parallel (see LocalMatrix::SORSweep()).
+  * With SetSymmetric(), each sweep is followed by a sweep in reverse color order
+  * (SSOR), which keeps the iteration symmetric. For red-black orderable operators, such
+  * as 5- or 7-point stencils, two colors are obtained.
+  *
+  * The scheme is typically used as smoother, see SetFixedSweeps(). Then, Solve()
+  * performs exactly the maximum number of iterations of the iteration control without
+  * computing any residual, all sweeps are performed by a single call to the kernel.
+  * SolveZeroSol() does not read the initial guess, such that the first color of the
+  * first sweep only requires the diagonal of the operator. The coarser levels of the
+  * multigrid solvers use SolveZeroSol() for pre-smoothing.
+  *
+  * The sweeps are performed on the host in CSR format. For operators in other formats
+  * or on the accelerator, Build() creates a host CSR copy of the operator, which is
+  * refreshed by ReBuildNumeric(), and the vectors are transferred at each solve.
+  * Otherwise, the sweeps operate on the operator directly and ReBuildNumeric() does not
+  * perform any computation.
+  *
+  * \tparam OperatorType - can be LocalMatrix
+  * \tparam VectorType - can be LocalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class MultiColoredSOR : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        MultiColoredSOR();
+        virtual ~MultiColoredSOR();
+
+        virtual void Print(void) const;
+
+        /** \brief Set the relaxation parameter \f$\omega\f$ (default 1, Gauss-Seidel) */
+        void SetRelaxation(ValueType omega);
+
+        /** \brief Perform symmetric sweeps, forward and backward over the colors */
+        void SetSymmetric(bool symmetric);
+
+        /** \brief Perform a fixed number of sweeps
+      * \details
+      * If \p fixed_sweeps is set, Solve() performs exactly the maximum number of
+      * iterations of the iteration control, without computing any residual. This is the
+      * typical setup of a smoother.
+      */
+        void SetFixedSweeps(bool fixed_sweeps);
+
+        virtual void Build(void);
+        virtual void ReBuildNumeric(void);
+        virtual void Clear(void);
+
+        virtual void SolveZeroSol(const VectorType& rhs, VectorType* x);
+
+    protected:
+        virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+        virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+        /** \brief Perform the sweeps, x is not read if \p zero_guess is set */
+        void Solve_(const VectorType& rhs, VectorType* x, bool zero_guess);
+
+        /** \brief Copy the operator to the host in CSR format */
+        void BuildHostCSR_(void);
+
+        /** \brief Perform \p sweeps sweeps, on the host CSR copy if required */
+        void Sweep_(const VectorType& rhs, VectorType* x, bool zero_guess, int sweeps);
+
+    private:
+        ValueType omega_;
+        bool      symmetric_;
+        bool      fixed_sweeps_;
+
+        // Host CSR copy of operators in other formats or on the accelerator
+        bool         host_csr_;
+        OperatorType csr_op_;
+
+        // Host copies of the vectors of a solve for operators on the accelerator
+        VectorType rhs_host_;
+        VectorType x_host_;
+
+        // Rows of each color, ordered by color
+        int              num_colors_;
+        int*             color_offset_;
+        LocalVector<int> color_rows_;
+
+        VectorType r_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_MULTICOLORED_SOR_HPP_
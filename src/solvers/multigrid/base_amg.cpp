@@ -31,16 +31,64 @@
 #include "../../base/local_vector.hpp"
 #include "../iter_ctrl.hpp"
 
+#include "../chebyshev.hpp"
 #include "../krylov/cg.hpp"
+#include "../multicolored_sor.hpp"
 #include "../preconditioners/preconditioner.hpp"
 
 #include "../../utils/log.hpp"
+#include "../../utils/task_graph.hpp"
+#include "../../utils/time_functions.hpp"
 
 #include <list>
 
 namespace rocalution
 {
 
+    // Number of host threads for the concurrent setup of the levels. On accelerators and
+    // for distributed operators, whose setup communicates, the levels are set up in order.
+    template <typename ValueType>
+    static int amg_setup_workers(const LocalMatrix<ValueType>& op)
+    {
+        if(_rocalution_available_accelerator() == true)
+        {
+            return 1;
+        }
+
+        return _get_backend_descriptor()->OpenMP_threads;
+    }
+
+    template <class OperatorType>
+    static int amg_setup_workers(const OperatorType& op)
+    {
+        return 1;
+    }
+
+    // Multi-colored Gauss-Seidel smoother, performing symmetric sweeps in place
+    template <typename ValueType>
+    static bool gauss_seidel_smoother_(
+        const LocalMatrix<ValueType>&                                                   op,
+        IterativeLinearSolver<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>** sm)
+    {
+        MultiColoredSOR<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>* gs
+            = new MultiColoredSOR<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>;
+
+        gs->SetSymmetric(true);
+        gs->SetFixedSweeps(true);
+
+        *sm = gs;
+
+        return true;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    static bool
+        gauss_seidel_smoother_(const OperatorType&                                          op,
+                               IterativeLinearSolver<OperatorType, VectorType, ValueType>** sm)
+    {
+        return false;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     BaseAMG<OperatorType, VectorType, ValueType>::BaseAMG()
     {
@@ -54,6 +102,8 @@ namespace rocalution
 
         // default smoother format
         this->sm_format_ = CSR;
+        // default smoother type
+        this->sm_type_ = DefaultSmoother;
         // default operator format
         this->op_format_ = CSR;
 
@@ -114,6 +164,18 @@ namespace rocalution
         this->sm_format_ = op_format;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::SetSmootherType(unsigned int sm_type)
+    {
+        log_debug(this, "BaseAMG::SetSmootherType()", sm_type);
+
+        assert(this->build_ == false);
+        assert(sm_type == DefaultSmoother || sm_type == ChebyshevSmoother
+               || sm_type == GaussSeidelSmoother);
+
+        this->sm_type_ = sm_type;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void BaseAMG<OperatorType, VectorType, ValueType>::SetOperatorFormat(unsigned int op_format)
     {
@@ -142,6 +204,8 @@ namespace rocalution
 
         assert(this->build_ == false);
 
+        double tick_build = rocalution_time();
+
         this->BuildHierarchy();
 
         this->build_ = true;
@@ -230,26 +294,20 @@ namespace rocalution
         // Setup and build smoothers
         if(this->set_sm_ == false)
         {
-            this->BuildSmoothers();
-        }
-
-        for(int i = 0; i < this->levels_ - 1; ++i)
-        {
-            if(i > 0)
+            // Chebyshev and Gauss-Seidel smoothers are the same for all AMG methods
+            if(this->sm_type_ != DefaultSmoother)
             {
-                this->smoother_level_[i]->SetOperator(*this->op_level_[i - 1]);
+                BaseAMG<OperatorType, VectorType, ValueType>::BuildSmoothers();
             }
             else
             {
-                this->smoother_level_[i]->SetOperator(*this->op_);
+                this->BuildSmoothers();
             }
-
-            this->smoother_level_[i]->Build();
         }
 
         log_debug(this, "BaseAMG::Build()", "#*# setup coarse solver");
 
-        // Setup and build coarse grid solver
+        // Setup coarse grid solver
         if(this->set_s_ == false)
         {
             // Coarse Grid Solver
@@ -264,21 +322,123 @@ namespace rocalution
             this->solver_coarse_ = cgs;
         }
 
-        this->solver_coarse_->SetOperator(*this->op_level_[this->levels_ - 2]);
-        this->solver_coarse_->Build();
+        log_debug(this, "BaseAMG::Build()", "#*# build smoothers and coarse solver");
+
+        this->BuildLevels_(false);
+
+        this->ResetLevelTiming_();
+
+        this->time_build_ = (rocalution_time() - tick_build) / 1e6;
+
+        log_debug(this, "BaseAMG::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::BuildLevels_(
+        bool rebuild, const std::function<void(int)>& coarse_op)
+    {
+        log_debug(this, "BaseAMG::BuildLevels_()", rebuild, " #*# begin");
+
+        assert(this->levels_ > 1);
+        assert(this->op_ != NULL);
+        assert(this->solver_coarse_ != NULL);
+
+        int nlevels = this->levels_ - 1;
+
+        double tick_levels = rocalution_time();
+
+        this->time_solver_.assign(this->levels_, 0.0);
+
+        if(coarse_op || (int)this->time_coarsen_.size() != this->levels_)
+        {
+            this->time_coarsen_.assign(this->levels_, 0.0);
+        }
+
+        TaskGraph graph;
 
-        log_debug(this, "BaseAMG::Build()", "#*# convert operators");
+        // Coarse operators, each depends on the previous one
+        std::vector<int> coarse_task(nlevels, -1);
 
-        // Convert operator to op_format
+        if(coarse_op)
+        {
+            for(int i = 0; i < nlevels; ++i)
+            {
+                coarse_task[i] = graph.AddTask([this, &coarse_op, i](void) {
+                    double tick = rocalution_time();
+                    coarse_op(i);
+                    this->time_coarsen_[i + 1] = (rocalution_time() - tick) / 1e6;
+                });
+
+                if(i > 0)
+                {
+                    graph.AddDependency(coarse_task[i], coarse_task[i - 1]);
+                }
+            }
+        }
+
+        // Smoothers and coarse grid solver, the solver of level i operates on
+        // op_level_[i - 1] (op_ for i = 0)
+        std::vector<int> solver_task(nlevels + 1);
+
+        for(int i = 0; i <= nlevels; ++i)
+        {
+            const OperatorType* op = (i > 0) ? this->op_level_[i - 1] : this->op_;
+
+            Solver<OperatorType, VectorType, ValueType>* solver
+                = (i < nlevels) ? this->smoother_level_[i] : this->solver_coarse_;
+
+            if(rebuild == true)
+            {
+                solver->ResetOperator(*op);
+                solver_task[i] = graph.AddTask([this, solver, i](void) {
+                    double tick = rocalution_time();
+                    solver->ReBuildNumeric();
+                    solver->Verbose(0);
+                    this->time_solver_[i] = (rocalution_time() - tick) / 1e6;
+                });
+            }
+            else
+            {
+                solver->SetOperator(*op);
+                solver_task[i] = graph.AddTask([this, solver, i](void) {
+                    double tick = rocalution_time();
+                    solver->Build();
+                    this->time_solver_[i] = (rocalution_time() - tick) / 1e6;
+                });
+            }
+
+            if(i > 0 && coarse_task[i - 1] >= 0)
+            {
+                graph.AddDependency(solver_task[i], coarse_task[i - 1]);
+            }
+        }
+
+        // Convert operator to op_format, once the solver using it has been set up and the
+        // next coarse operator has been computed from it
         if(this->op_format_ != CSR)
         {
-            for(int i = 0; i < this->levels_ - 1; ++i)
+            for(int i = 0; i < nlevels; ++i)
             {
-                this->op_level_[i]->ConvertTo(this->op_format_);
+                OperatorType* op     = this->op_level_[i];
+                unsigned int  format = this->op_format_;
+
+                int task = graph.AddTask([op, format](void) { op->ConvertTo(format); });
+
+                graph.AddDependency(task, solver_task[i + 1]);
+
+                if(i + 1 < nlevels && coarse_task[i + 1] >= 0)
+                {
+                    graph.AddDependency(task, coarse_task[i + 1]);
+                }
             }
         }
 
-        log_debug(this, "BaseAMG::Build()", this->build_, " #*# end");
+        // Levels that move between host and accelerator are set up in order
+        graph.Execute((this->host_level_ > 0) ? 1 : amg_setup_workers(*this->op_));
+
+        this->time_solvers_ = (rocalution_time() - tick_levels) / 1e6;
+
+        log_debug(this, "BaseAMG::BuildLevels_()", rebuild, " #*# end");
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -308,6 +468,11 @@ namespace rocalution
 
             this->levels_ = 1;
 
+            this->time_coarsen_.assign(1, 0.0);
+
+            double tick_hierarchy = rocalution_time();
+            double tick           = tick_hierarchy;
+
             // Build finest hierarchy
             op_list_.push_back(new OperatorType);
             restrict_list_.push_back(new OperatorType);
@@ -323,6 +488,8 @@ namespace rocalution
 
             ++this->levels_;
 
+            this->time_coarsen_.push_back((rocalution_time() - tick) / 1e6);
+
             while(op_list_.back()->GetM() > (IndexType2)this->coarse_size_)
             {
                 // Add new list elements
@@ -335,11 +502,15 @@ namespace rocalution
                 restrict_list_.back()->CloneBackend(*this->op_);
                 prolong_list_.back()->CloneBackend(*this->op_);
 
+                tick = rocalution_time();
+
                 this->Aggregate_(
                     *prev_op_, prolong_list_.back(), restrict_list_.back(), op_list_.back());
 
                 ++this->levels_;
 
+                this->time_coarsen_.push_back((rocalution_time() - tick) / 1e6);
+
                 if(this->levels_ > 19)
                 {
                     LOG_VERBOSE_INFO(2,
@@ -369,6 +540,8 @@ namespace rocalution
                 this->prolong_op_level_[i] = *pro_it;
                 ++pro_it;
             }
+
+            this->time_hierarchy_ = (rocalution_time() - tick_hierarchy) / 1e6;
         }
 
         log_debug(this, "BaseAMG::BuildHierarchy()", " #*# end");
@@ -386,16 +559,52 @@ namespace rocalution
 
         for(int i = 0; i < this->levels_ - 1; ++i)
         {
-            FixedPoint<OperatorType, VectorType, ValueType>* sm
-                = new FixedPoint<OperatorType, VectorType, ValueType>;
+            if(this->sm_type_ == GaussSeidelSmoother)
+            {
+                // Symmetric sweeps keep the cycle symmetric, no preconditioner is required
+                IterativeLinearSolver<OperatorType, VectorType, ValueType>* sm = NULL;
+
+                if(gauss_seidel_smoother_(*this->op_, &sm) == false)
+                {
+                    LOG_INFO("BaseAMG::BuildSmoothers() Gauss-Seidel smoothers are only "
+                             "available for LocalMatrix operators");
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                sm->Verbose(0);
+                this->smoother_level_[i] = sm;
+                this->sm_default_[i]     = NULL;
+
+                continue;
+            }
+
             Jacobi<OperatorType, VectorType, ValueType>* jac
                 = new Jacobi<OperatorType, VectorType, ValueType>;
 
-            sm->SetRelaxation(static_cast<ValueType>(0.67));
-            sm->SetPreconditioner(*jac);
-            sm->Verbose(0);
-            this->smoother_level_[i] = sm;
-            this->sm_default_[i]     = jac;
+            if(this->sm_type_ == ChebyshevSmoother)
+            {
+                // Eigenvalues of D^-1 A are estimated when the smoother is built, the
+                // polynomial of the smoother is applied by the matrix powers kernel
+                Chebyshev<OperatorType, VectorType, ValueType>* sm
+                    = new Chebyshev<OperatorType, VectorType, ValueType>;
+
+                sm->SetFixedDegree(true);
+                sm->SetPreconditioner(*jac);
+                sm->Verbose(0);
+                this->smoother_level_[i] = sm;
+            }
+            else
+            {
+                FixedPoint<OperatorType, VectorType, ValueType>* sm
+                    = new FixedPoint<OperatorType, VectorType, ValueType>;
+
+                sm->SetRelaxation(static_cast<ValueType>(0.67));
+                sm->SetPreconditioner(*jac);
+                sm->Verbose(0);
+                this->smoother_level_[i] = sm;
+            }
+
+            this->sm_default_[i] = jac;
         }
 
         log_debug(this, "BaseAMG::BuildSmoothers()", " #*# end");
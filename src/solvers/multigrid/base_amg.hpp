@@ -27,11 +27,19 @@
 #include "../solver.hpp"
 #include "base_multigrid.hpp"
 
+#include <functional>
 #include <vector>
 
 namespace rocalution
 {
 
+    enum _amg_smoother
+    {
+        DefaultSmoother     = 0,
+        ChebyshevSmoother   = 1,
+        GaussSeidelSmoother = 2
+    };
+
     /** \ingroup solver_module
   * \class BaseAMG
   * \brief Base class for all algebraic multigrid solvers
@@ -43,6 +51,13 @@ namespace rocalution
   * All parameters in the Algebraic MultiGrid class can be set externally, including
   * smoothers and coarse grid solver.
   *
+  * For LocalMatrix operators on the host, the smoothers and the coarse grid solver of
+  * the different levels are built concurrently, distributing the OpenMP threads among
+  * the levels that are set up at the same time. A numerical re-build additionally
+  * overlaps the setup of the finer levels with the computation of the coarser
+  * operators. Smoothers that are set externally therefore must not share data between
+  * levels.
+  *
   * \tparam OperatorType - can be LocalMatrix or GlobalMatrix
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
@@ -76,7 +91,20 @@ namespace rocalution
 
         /** \brief Set the smoother operator format */
         void SetDefaultSmootherFormat(unsigned int op_format);
-        /** \brief Set the operator format */
+        /** \brief Set the type of the smoothers that are built internally
+      * \details
+      * \p DefaultSmoother uses the smoother of the particular AMG method.
+      * \p ChebyshevSmoother uses a Jacobi preconditioned Chebyshev iteration on each
+      * level, where the spectrum of D^-1 A is estimated during Build(). The polynomial
+      * degree is given by the number of pre- and post-smoothing steps.
+      * \p GaussSeidelSmoother uses symmetric multi-colored Gauss-Seidel sweeps on each
+      * level (see MultiColoredSOR), which operate in place on the level operators. It is
+      * only available for LocalMatrix operators.
+      */
+        void SetSmootherType(unsigned int sm_type);
+        /** \brief Set the operator format; \p AUTO selects the format for each level
+      * individually (see LocalMatrix::ConvertToBest())
+      */
         void SetOperatorFormat(unsigned int op_format);
 
         /** \brief Returns the number of levels in hierarchy */
@@ -97,6 +125,16 @@ namespace rocalution
                                 OperatorType*        coarse)
             = 0;
 
+        /** \brief Builds (or numerically re-builds) the smoothers and the coarse grid
+        * solver and converts the operators to the operator format
+        * \details
+        * The setup runs as host task graph, such that the solvers of the different levels
+        * are set up concurrently on the host. If given, \p coarse_op(i) (re-)computes the
+        * coarse operator of level \p i first, overlapping with the setup of the finer
+        * levels.
+        */
+        void BuildLevels_(bool rebuild, const std::function<void(int)>& coarse_op = nullptr);
+
         /** \brief Maximal coarse grid size */
         int coarse_size_;
 
@@ -113,6 +151,8 @@ namespace rocalution
 
         /** \brief Smoother operator format */
         unsigned int sm_format_;
+        /** \brief Smoother type */
+        unsigned int sm_type_;
         /** \brief Operator format */
         unsigned int op_format_;
     };
@@ -33,8 +33,10 @@
 
 #include "../../utils/log.hpp"
 #include "../../utils/math_functions.hpp"
+#include "../../utils/time_functions.hpp"
 
 #include <complex>
+#include <fstream>
 #include <math.h>
 
 namespace rocalution
@@ -74,6 +76,12 @@ namespace rocalution
         this->host_level_ = 0;
 
         this->kcycle_full_ = true;
+
+        this->time_hierarchy_ = 0.0;
+        this->time_solvers_   = 0.0;
+        this->time_build_     = 0.0;
+
+        this->level_timing_ = false;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -180,6 +188,251 @@ namespace rocalution
         this->kcycle_full_ = kcycle_full;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::SetLevelTiming(bool timing)
+    {
+        log_debug(this, "BaseMultiGrid::SetLevelTiming()", timing);
+
+        this->level_timing_ = timing;
+        this->ResetLevelTiming_();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::ResetLevelTiming_(void)
+    {
+        int levels = (this->build_ == true) ? this->levels_ : 0;
+
+        this->visits_level_.assign(levels, 0);
+        this->time_level_.assign(levels, 0.0);
+        this->time_smooth_.assign(levels, 0.0);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::StartLevelTimer_(double* tick) const
+    {
+        if(this->level_timing_ == true)
+        {
+            *tick = rocalution_time();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::StopLevelTimer_(int     level,
+                                                                             bool    smooth,
+                                                                             double* tick)
+    {
+        if(this->level_timing_ == true)
+        {
+            double now  = rocalution_time();
+            double time = (now - *tick) / 1e6;
+
+            this->time_level_[level] += time;
+
+            if(smooth == true)
+            {
+                this->time_smooth_[level] += time;
+            }
+
+            *tick = now;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    double BaseMultiGrid<OperatorType, VectorType, ValueType>::GetOperatorComplexity(void) const
+    {
+        assert(this->levels_ > 1);
+        assert(this->op_ != NULL);
+        assert(this->op_level_ != NULL);
+
+        double nnz = static_cast<double>(this->op_->GetNnz());
+
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            nnz += static_cast<double>(this->op_level_[i]->GetNnz());
+        }
+
+        return nnz / static_cast<double>(this->op_->GetNnz());
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    double BaseMultiGrid<OperatorType, VectorType, ValueType>::GetGridComplexity(void) const
+    {
+        assert(this->levels_ > 1);
+        assert(this->op_ != NULL);
+        assert(this->op_level_ != NULL);
+
+        double nrow = static_cast<double>(this->op_->GetM());
+
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            nrow += static_cast<double>(this->op_level_[i]->GetM());
+        }
+
+        return nrow / static_cast<double>(this->op_->GetM());
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::GetHierarchyStats(
+        MultiGridStats* stats) const
+    {
+        log_debug(this, "BaseMultiGrid::GetHierarchyStats()", stats);
+
+        assert(stats != NULL);
+        assert(this->build_ == true);
+        assert(this->levels_ > 1);
+        assert(this->op_ != NULL);
+
+        stats->levels              = this->levels_;
+        stats->operator_complexity = this->GetOperatorComplexity();
+        stats->grid_complexity     = this->GetGridComplexity();
+        stats->memory              = 0;
+        stats->time_hierarchy      = this->time_hierarchy_;
+        stats->time_solvers        = this->time_solvers_;
+        stats->time_build          = this->time_build_;
+        stats->time_solve          = 0.0;
+
+        stats->level.resize(this->levels_);
+
+        for(int i = 0; i < this->levels_; ++i)
+        {
+            const OperatorType*  op  = (i > 0) ? this->op_level_[i - 1] : this->op_;
+            MultiGridLevelStats& lvl = stats->level[i];
+
+            lvl.nrow         = op->GetM();
+            lvl.nnz          = op->GetNnz();
+            lvl.nnz_transfer = 0;
+            lvl.host         = (this->host_level_ > 0 && i >= this->levels_ - this->host_level_);
+
+            // CSR storage of the operators
+            lvl.memory_operator = (lvl.nrow + 1) * sizeof(int)
+                                  + lvl.nnz * (sizeof(int) + sizeof(ValueType));
+            lvl.memory_transfer = 0;
+
+            if(i > 0)
+            {
+                const Operator<ValueType>* res = this->restrict_op_level_[i - 1];
+                const Operator<ValueType>* pro = this->prolong_op_level_[i - 1];
+
+                lvl.nnz_transfer = res->GetNnz() + pro->GetNnz();
+                lvl.memory_transfer
+                    = (res->GetM() + pro->GetM() + 2) * sizeof(int)
+                      + lvl.nnz_transfer * (sizeof(int) + sizeof(ValueType));
+            }
+
+            // Residual and temporary vectors, defect correction on coarse levels and
+            // four more vectors on inner levels for the K-cycle
+            int nvec = (i > 0) ? 4 : 3;
+
+            if(this->cycle_ == Kcycle && i > 0 && i < this->levels_ - 1)
+            {
+                nvec += 4;
+            }
+
+            lvl.memory_vectors = nvec * lvl.nrow * sizeof(ValueType);
+
+            lvl.time_coarsen = (i < (int)this->time_coarsen_.size()) ? this->time_coarsen_[i] : 0.0;
+            lvl.time_solver  = (i < (int)this->time_solver_.size()) ? this->time_solver_[i] : 0.0;
+
+            bool timed = (i < (int)this->time_level_.size());
+
+            lvl.visits      = timed ? this->visits_level_[i] : 0;
+            lvl.time_solve  = timed ? this->time_level_[i] : 0.0;
+            lvl.time_smooth = timed ? this->time_smooth_[i] : 0.0;
+
+            stats->memory += lvl.memory_operator + lvl.memory_transfer + lvl.memory_vectors;
+            stats->time_solve += lvl.time_solve;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::PrintHierarchyStats(void) const
+    {
+        MultiGridStats stats;
+        this->GetHierarchyStats(&stats);
+
+        LOG_INFO("MultiGrid hierarchy with " << stats.levels << " levels");
+        LOG_INFO("MultiGrid operator complexity " << stats.operator_complexity
+                                                   << ", grid complexity "
+                                                   << stats.grid_complexity);
+        LOG_INFO("MultiGrid memory " << stats.memory << " bytes");
+        LOG_INFO("MultiGrid setup time " << stats.time_build << " sec (hierarchy "
+                                         << stats.time_hierarchy << " sec, smoothers "
+                                         << stats.time_solvers << " sec)");
+
+        for(int i = 0; i < stats.levels; ++i)
+        {
+            const MultiGridLevelStats& lvl = stats.level[i];
+
+            LOG_INFO("MultiGrid level " << i << (lvl.host ? " (host)" : "") << ": rows "
+                                        << lvl.nrow << ", nnz " << lvl.nnz << ", transfer nnz "
+                                        << lvl.nnz_transfer);
+            LOG_INFO("  memory " << lvl.memory_operator + lvl.memory_transfer
+                                        + lvl.memory_vectors
+                                 << " bytes, coarsening " << lvl.time_coarsen
+                                 << " sec, solver setup " << lvl.time_solver << " sec");
+
+            if(this->level_timing_ == true)
+            {
+                LOG_INFO("  visits " << lvl.visits << ", solve " << lvl.time_solve
+                                     << " sec, smoothing " << lvl.time_smooth << " sec");
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::WriteHierarchyStats(
+        const std::string& filename) const
+    {
+        log_debug(this, "BaseMultiGrid::WriteHierarchyStats()", filename);
+
+        MultiGridStats stats;
+        this->GetHierarchyStats(&stats);
+
+        std::ofstream out(filename.c_str());
+
+        if(!out.is_open())
+        {
+            LOG_INFO("Cannot open MultiGrid statistics file [write]: " << filename);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        out << "{" << std::endl;
+        out << "  \"levels\": " << stats.levels << "," << std::endl;
+        out << "  \"operator_complexity\": " << stats.operator_complexity << "," << std::endl;
+        out << "  \"grid_complexity\": " << stats.grid_complexity << "," << std::endl;
+        out << "  \"memory\": " << stats.memory << "," << std::endl;
+        out << "  \"time_hierarchy\": " << stats.time_hierarchy << "," << std::endl;
+        out << "  \"time_solvers\": " << stats.time_solvers << "," << std::endl;
+        out << "  \"time_build\": " << stats.time_build << "," << std::endl;
+        out << "  \"time_solve\": " << stats.time_solve << "," << std::endl;
+        out << "  \"level\": [" << std::endl;
+
+        for(int i = 0; i < stats.levels; ++i)
+        {
+            const MultiGridLevelStats& lvl = stats.level[i];
+
+            out << "    {" << std::endl;
+            out << "      \"nrow\": " << lvl.nrow << "," << std::endl;
+            out << "      \"nnz\": " << lvl.nnz << "," << std::endl;
+            out << "      \"nnz_transfer\": " << lvl.nnz_transfer << "," << std::endl;
+            out << "      \"host\": " << (lvl.host ? "true" : "false") << "," << std::endl;
+            out << "      \"memory_operator\": " << lvl.memory_operator << "," << std::endl;
+            out << "      \"memory_transfer\": " << lvl.memory_transfer << "," << std::endl;
+            out << "      \"memory_vectors\": " << lvl.memory_vectors << "," << std::endl;
+            out << "      \"time_coarsen\": " << lvl.time_coarsen << "," << std::endl;
+            out << "      \"time_solver\": " << lvl.time_solver << "," << std::endl;
+            out << "      \"visits\": " << lvl.visits << "," << std::endl;
+            out << "      \"time_solve\": " << lvl.time_solve << "," << std::endl;
+            out << "      \"time_smooth\": " << lvl.time_smooth << std::endl;
+            out << "    }" << ((i < stats.levels - 1) ? "," : "") << std::endl;
+        }
+
+        out << "  ]" << std::endl;
+        out << "}" << std::endl;
+
+        out.close();
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void BaseMultiGrid<OperatorType, VectorType, ValueType>::Print(void) const
     {
@@ -227,25 +480,41 @@ namespace rocalution
         assert(this->solver_coarse_ != NULL);
         assert(this->levels_ > 0);
 
+        double tick_build = rocalution_time();
+        double tick;
+
+        // The operator hierarchy is provided by the user
+        this->time_hierarchy_ = 0.0;
+        this->time_coarsen_.assign(this->levels_, 0.0);
+        this->time_solver_.assign(this->levels_, 0.0);
+
         log_debug(this, "BaseMultiGrid::Build()", "#*# setup finest level 0");
 
         // Setup finest level 0
+        tick = rocalution_time();
         this->smoother_level_[0]->SetOperator(*this->op_);
         this->smoother_level_[0]->Build();
+        this->time_solver_[0] = (rocalution_time() - tick) / 1e6;
 
         log_debug(this, "BaseMultiGrid::Build()", "#*# setup coarser levels");
 
         // Setup coarser levels
         for(int i = 1; i < this->levels_ - 1; ++i)
         {
+            tick = rocalution_time();
             this->smoother_level_[i]->SetOperator(*this->op_level_[i - 1]);
             this->smoother_level_[i]->Build();
+            this->time_solver_[i] = (rocalution_time() - tick) / 1e6;
         }
 
         log_debug(this, "BaseMultiGrid::Build()", "#*# setup coarse grid solver");
         // Setup coarse grid solver
+        tick = rocalution_time();
         this->solver_coarse_->SetOperator(*op_level_[this->levels_ - 2]);
         this->solver_coarse_->Build();
+        this->time_solver_[this->levels_ - 1] = (rocalution_time() - tick) / 1e6;
+
+        this->time_solvers_ = (rocalution_time() - tick_build) / 1e6;
 
         log_debug(this, "BaseMultiGrid::Build()", "#*# setup all tmp vectors");
 
@@ -315,6 +584,10 @@ namespace rocalution
         this->s_level_[0]->CloneBackend(*this->op_);
         this->s_level_[0]->Allocate("temporary", this->op_->GetM());
 
+        this->ResetLevelTiming_();
+
+        this->time_build_ = (rocalution_time() - tick_build) / 1e6;
+
         log_debug(this, "BaseMultiGrid::Build()", this->build_, " #*# end");
     }
 
@@ -610,6 +883,11 @@ namespace rocalution
             this->iter_ctrl_.PrintInit();
         }
 
+        if(this->level_timing_ == true && (int)this->time_level_.size() != this->levels_)
+        {
+            this->ResetLevelTiming_();
+        }
+
         // initial residual = b - Ax
         this->op_->Apply(*x, this->r_level_[0]);
         this->r_level_[0]->ScaleAdd(static_cast<ValueType>(-1), rhs);
@@ -665,6 +943,17 @@ namespace rocalution
     {
         log_debug(this, "BaseMultiGrid::Vcycle_()", " #*# begin", (const void*&)rhs, x);
 
+        // Level timing, excluding the time spent on coarser levels
+        int    level = this->current_level_;
+        double tick  = 0.0;
+
+        if(this->level_timing_ == true)
+        {
+            ++this->visits_level_[level];
+        }
+
+        this->StartLevelTimer_(&tick);
+
         // Perform cycle
         if(this->current_level_ < this->levels_ - 1)
         {
@@ -673,7 +962,19 @@ namespace rocalution
 
             // Pre-smoothing on finest level
             this->smoother_level_[this->current_level_]->InitMaxIter(this->iter_pre_smooth_);
-            this->smoother_level_[this->current_level_]->Solve(rhs, x);
+
+            // On the coarser levels, the initial guess is zero, except for the second
+            // V-cycle of a W-cycle
+            if(this->current_level_ > 0 && this->cycle_ != Wcycle)
+            {
+                this->smoother_level_[this->current_level_]->SolveZeroSol(rhs, x);
+            }
+            else
+            {
+                this->smoother_level_[this->current_level_]->Solve(rhs, x);
+            }
+
+            this->StopLevelTimer_(level, true, &tick);
 
             if(this->scaling_ == true)
             {
@@ -738,6 +1039,8 @@ namespace rocalution
                 }
             }
 
+            this->StopLevelTimer_(level, false, &tick);
+
             ++this->current_level_;
 
             // Set new solution for recursion to
@@ -777,6 +1080,8 @@ namespace rocalution
                 break;
             }
 
+            this->StartLevelTimer_(&tick);
+
             if(this->current_level_ == this->levels_ - this->host_level_)
             {
                 this->r_level_[this->current_level_ - 1]->MoveToHost();
@@ -853,10 +1158,14 @@ namespace rocalution
                 // Defect correction
                 x->AddScale(*this->r_level_[this->current_level_], static_cast<ValueType>(1));
 
+            this->StopLevelTimer_(level, false, &tick);
+
             // Post-smoothing on finest level
             this->smoother_level_[this->current_level_]->InitMaxIter(this->iter_post_smooth_);
             this->smoother_level_[this->current_level_]->Solve(rhs, x);
 
+            this->StopLevelTimer_(level, true, &tick);
+
             if(this->current_level_ == 0)
             {
                 // Update residual
@@ -864,12 +1173,18 @@ namespace rocalution
                 this->r_level_[this->current_level_]->ScaleAdd(static_cast<ValueType>(-1), rhs);
 
                 this->res_norm_ = std::abs(this->Norm_(*this->r_level_[this->current_level_]));
+
+                this->StopLevelTimer_(level, false, &tick);
             }
         }
         else
+        {
             // Coarse grid solver
             this->solver_coarse_->SolveZeroSol(rhs, x);
 
+            this->StopLevelTimer_(level, true, &tick);
+        }
+
         log_debug(this, "BaseMultiGrid::Vcycle_()", " #*# end");
     }
 
@@ -914,12 +1229,20 @@ namespace rocalution
             ValueType alpha;
             ValueType beta;
 
+            // Level timing of the Krylov acceleration, cycles are timed separately
+            int    level = this->current_level_;
+            double tick  = 0.0;
+
+            this->StartLevelTimer_(&tick);
+
             // r = rhs
             r->CopyFrom(rhs);
 
             // Cycle
             s->Zeros();
+            this->StopLevelTimer_(level, false, &tick);
             this->Vcycle_(*r, s);
+            this->StartLevelTimer_(&tick);
 
             // rho = (r,s)
             rho = r->Dot(*s);
@@ -943,7 +1266,9 @@ namespace rocalution
 
             // Cycle
             p->Zeros();
+            this->StopLevelTimer_(level, false, &tick);
             this->Vcycle_(*r, p);
+            this->StartLevelTimer_(&tick);
 
             // rho = (r,p)
             rho = r->Dot(*p);
@@ -962,10 +1287,21 @@ namespace rocalution
 
             // x = x + alpha*s
             x->AddScale(*s, alpha);
+
+            this->StopLevelTimer_(level, false, &tick);
         }
         else
         {
+            double tick = 0.0;
+
+            if(this->level_timing_ == true)
+            {
+                ++this->visits_level_[this->current_level_];
+            }
+
+            this->StartLevelTimer_(&tick);
             this->solver_coarse_->SolveZeroSol(rhs, x);
+            this->StopLevelTimer_(this->current_level_, true, &tick);
         }
     }
 
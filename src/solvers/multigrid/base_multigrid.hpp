@@ -27,6 +27,9 @@
 #include "../../base/operator.hpp"
 #include "../solver.hpp"
 
+#include <string>
+#include <vector>
+
 namespace rocalution
 {
 
@@ -38,6 +41,75 @@ namespace rocalution
         Fcycle = 3
     };
 
+    /** \ingroup solver_module
+  * \brief Statistics of a single multigrid level
+  * \details
+  * Level 0 is the finest level. The transfer operators between two levels are
+  * accounted to the coarser one. Memory is estimated from the CSR representation of
+  * the operators, times are given in seconds.
+  */
+    struct MultiGridLevelStats
+    {
+        /** \brief Number of rows */
+        IndexType2 nrow;
+        /** \brief Number of non-zero entries of the operator */
+        IndexType2 nnz;
+        /** \brief Number of non-zero entries of restriction and prolongation to this level */
+        IndexType2 nnz_transfer;
+        /** \brief Level is kept on the host, see SetHostLevels() */
+        bool host;
+
+        /** \brief Memory of the operator (bytes) */
+        size_t memory_operator;
+        /** \brief Memory of restriction and prolongation to this level (bytes) */
+        size_t memory_transfer;
+        /** \brief Memory of the temporary vectors of the cycle (bytes) */
+        size_t memory_vectors;
+
+        /** \brief Time to compute the level from the next finer one */
+        double time_coarsen;
+        /** \brief Time to build the smoother, or the coarse grid solver on the coarsest level */
+        double time_solver;
+
+        /** \brief Number of visits of the level during Solve() */
+        IndexType2 visits;
+        /** \brief Time spent on the level during Solve(), excluding coarser levels */
+        double time_solve;
+        /** \brief Part of time_solve spent in the smoother or the coarse grid solver */
+        double time_smooth;
+    };
+
+    /** \ingroup solver_module
+  * \brief Statistics of a multigrid hierarchy
+  * \details
+  * Filled by BaseMultiGrid::GetHierarchyStats(). Times are given in seconds. The time
+  * of Build() contains the computation of the hierarchy, unless it has been built
+  * before, e.g. by BaseAMG::BuildHierarchy().
+  */
+    struct MultiGridStats
+    {
+        /** \brief Number of levels */
+        int levels;
+        /** \brief Sum of non-zero entries of all levels relative to the finest level */
+        double operator_complexity;
+        /** \brief Sum of rows of all levels relative to the finest level */
+        double grid_complexity;
+        /** \brief Estimated memory of all levels (bytes) */
+        size_t memory;
+
+        /** \brief Time to compute the hierarchy of operators */
+        double time_hierarchy;
+        /** \brief Time to build the smoothers and the coarse grid solver */
+        double time_solvers;
+        /** \brief Time of Build() */
+        double time_build;
+        /** \brief Time spent in all levels during Solve() */
+        double time_solve;
+
+        /** \brief Statistics of each level */
+        std::vector<MultiGridLevelStats> level;
+    };
+
     /** \ingroup solver_module
   * \class BaseMultiGrid
   * \brief Base class for all multigrid solvers
@@ -95,6 +167,56 @@ namespace rocalution
         /** \brief Set the depth of the multigrid solver */
         void InitLevels(int levels);
 
+        /** \brief Record the time spent on each level during Solve()
+      * \details
+      * Level timing is disabled by default, as it synchronizes the accelerator after
+      * each step of the cycle. Enabling it resets the recorded times, which then
+      * accumulate over all subsequent calls to Solve().
+      */
+        void SetLevelTiming(bool timing);
+
+        /** \brief Returns the operator complexity of the hierarchy, the number of non-zero
+      * entries of all levels divided by the number of non-zero entries of the finest level
+      */
+        double GetOperatorComplexity(void) const;
+
+        /** \brief Returns the grid complexity of the hierarchy, the number of rows of all
+      * levels divided by the number of rows of the finest level
+      */
+        double GetGridComplexity(void) const;
+
+        /** \brief Return the statistics of the hierarchy
+      * \details
+      * The hierarchy has to be built. Solve times are zero, unless level timing has been
+      * enabled by SetLevelTiming().
+      *
+      * \par Example
+      * \code{.cpp}
+      *   SAAMG<LocalMatrix<double>, LocalVector<double>, double> amg;
+      *
+      *   amg.SetOperator(mat);
+      *   amg.Build();
+      *   amg.SetLevelTiming(true);
+      *
+      *   amg.Solve(rhs, &x);
+      *
+      *   MultiGridStats stats;
+      *   amg.GetHierarchyStats(&stats);
+      *
+      *   for(int i = 0; i < stats.levels; ++i)
+      *   {
+      *       std::cout << stats.level[i].nrow << " " << stats.level[i].time_solve << std::endl;
+      *   }
+      * \endcode
+      */
+        void GetHierarchyStats(MultiGridStats* stats) const;
+
+        /** \brief Print the statistics of the hierarchy */
+        void PrintHierarchyStats(void) const;
+
+        /** \brief Write the statistics of the hierarchy to a JSON file */
+        void WriteHierarchyStats(const std::string& filename) const;
+
         virtual void Solve(const VectorType& rhs, VectorType* x);
 
         virtual void Build(void);
@@ -131,6 +253,13 @@ namespace rocalution
         /** \brief Move all level data to the host */
         void MoveHostLevels_(void);
 
+        /** \brief Set the level times of Solve() to zero */
+        void ResetLevelTiming_(void);
+        /** \brief Restart the level timer, if level timing is enabled */
+        void StartLevelTimer_(double* tick) const;
+        /** \brief Add the time since the last start to level and restart the timer */
+        void StopLevelTimer_(int level, bool smooth, double* tick);
+
         /** \brief Number of levels in the hierarchy */
         int levels_;
         /** \brief Host levels */
@@ -172,6 +301,26 @@ namespace rocalution
         Solver<OperatorType, VectorType, ValueType>* solver_coarse_;
         /** \brief Smoother for each level */
         IterativeLinearSolver<OperatorType, VectorType, ValueType>** smoother_level_;
+
+        /** \brief Time to compute the hierarchy of operators (sec) */
+        double time_hierarchy_;
+        /** \brief Time to build smoothers and coarse grid solver (sec) */
+        double time_solvers_;
+        /** \brief Time of Build() (sec) */
+        double time_build_;
+        /** \brief Time to compute each level from the next finer one (sec) */
+        std::vector<double> time_coarsen_;
+        /** \brief Time to build the smoother or coarse grid solver of each level (sec) */
+        std::vector<double> time_solver_;
+
+        /** \brief Level timing during Solve() */
+        bool level_timing_;
+        /** \brief Number of visits of each level during Solve() */
+        std::vector<IndexType2> visits_level_;
+        /** \brief Time spent on each level during Solve() (sec) */
+        std::vector<double> time_level_;
+        /** \brief Part of time_level_ spent in smoother or coarse grid solver (sec) */
+        std::vector<double> time_smooth_;
     };
 
 } // namespace rocalution
@@ -35,6 +35,7 @@
 #include "../../utils/allocate_free.hpp"
 #include "../../utils/log.hpp"
 #include "../../utils/math_functions.hpp"
+#include "../../utils/time_functions.hpp"
 
 #include <complex>
 #include <list>
@@ -226,6 +227,11 @@ namespace rocalution
 
             this->levels_ = 1;
 
+            this->time_coarsen_.assign(1, 0.0);
+
+            double tick_hierarchy = rocalution_time();
+            double tick           = tick_hierarchy;
+
             // Build finest hierarchy
             op_list_.push_back(new OperatorType);
             pm_list_.push_back(new ParallelManager);
@@ -248,6 +254,8 @@ namespace rocalution
 
             ++this->levels_;
 
+            this->time_coarsen_.push_back((rocalution_time() - tick) / 1e6);
+
             while(op_list_.back()->GetM() > (IndexType2)this->coarse_size_)
             {
                 // Add new list elements
@@ -263,6 +271,8 @@ namespace rocalution
                 prolong_list_.back()->CloneBackend(*this->op_);
                 trans_list_.back()->CloneBackend(*this->op_);
 
+                tick = rocalution_time();
+
                 this->Aggregate_(*prev_op_,
                                  prolong_list_.back(),
                                  restrict_list_.back(),
@@ -271,6 +281,8 @@ namespace rocalution
                                  trans_list_.back());
 
                 ++this->levels_;
+
+                this->time_coarsen_.push_back((rocalution_time() - tick) / 1e6);
             }
 
             // Allocate data structures
@@ -304,6 +316,8 @@ namespace rocalution
                 this->trans_level_[i] = *trans_it;
                 ++trans_it;
             }
+
+            this->time_hierarchy_ = (rocalution_time() - tick_hierarchy) / 1e6;
         }
 
         log_debug(this, "GlobalPairwiseAMG::BuildHierarchy()", " #*# end");
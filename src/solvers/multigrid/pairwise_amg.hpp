@@ -50,6 +50,11 @@ namespace rocalution
   * solving phase to provide low number of iterations.
   * \cite pairwiseamg
   *
+  * The pairs are formed by a parallel matching of the strong couplings, that is
+  * computed greedily within blocks of consecutive rows and by handshaking across the
+  * borders of the blocks. Passes of pairwise aggregation are repeated until the target
+  * coarsening factor is reached.
+  *
   * \tparam OperatorType - can be LocalMatrix
   * \tparam VectorType - can be LocalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
@@ -68,7 +73,11 @@ namespace rocalution
 
         /** \brief Set beta for pairwise aggregation */
         void SetBeta(ValueType beta);
-        /** \brief Set re-ordering for aggregation */
+        /** \brief Set re-ordering for aggregation
+      * \details
+      * The parallel matching of the host backend does not depend on the ordering, the
+      * setting is kept for compatibility.
+      */
         void SetOrdering(unsigned int ordering);
         /** \brief Set target coarsening factor */
         void SetCoarseningFactor(double factor);
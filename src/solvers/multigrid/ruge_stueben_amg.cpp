@@ -42,6 +42,11 @@ namespace rocalution
 
         // parameter for strong couplings in smoothed aggregation
         this->eps_ = static_cast<ValueType>(0.25);
+
+        this->coarsening_        = ClassicalCoarsening;
+        this->interpolation_     = DirectInterpolation;
+        this->max_elements_      = 0;
+        this->aggressive_levels_ = 0;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -58,8 +63,11 @@ namespace rocalution
         LOG_INFO("AMG solver");
         LOG_INFO("AMG number of levels " << this->levels_);
         LOG_INFO("AMG using Ruge-Stüben coarsening");
+        this->PrintCoarsening_();
         LOG_INFO("AMG coarsest operator size = " << this->op_level_[this->levels_ - 2]->GetM());
         LOG_INFO("AMG coarsest level nnz = " << this->op_level_[this->levels_ - 2]->GetNnz());
+        LOG_INFO("AMG operator complexity = " << this->GetOperatorComplexity());
+        LOG_INFO("AMG grid complexity = " << this->GetGridComplexity());
         LOG_INFO("AMG with smoother:");
         this->smoother_level_[0]->Print();
     }
@@ -72,8 +80,11 @@ namespace rocalution
         LOG_INFO("AMG solver starts");
         LOG_INFO("AMG number of levels " << this->levels_);
         LOG_INFO("AMG using Ruge-Stüben coarsening");
+        this->PrintCoarsening_();
         LOG_INFO("AMG coarsest operator size = " << this->op_level_[this->levels_ - 2]->GetM());
         LOG_INFO("AMG coarsest level nnz = " << this->op_level_[this->levels_ - 2]->GetNnz());
+        LOG_INFO("AMG operator complexity = " << this->GetOperatorComplexity());
+        LOG_INFO("AMG grid complexity = " << this->GetGridComplexity());
         LOG_INFO("AMG with smoother:");
         this->smoother_level_[0]->Print();
     }
@@ -84,6 +95,43 @@ namespace rocalution
         LOG_INFO("AMG ends");
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RugeStuebenAMG<OperatorType, VectorType, ValueType>::PrintCoarsening_(void) const
+    {
+        switch(this->coarsening_)
+        {
+        case PMISCoarsening:
+            LOG_INFO("AMG C/F splitting: PMIS");
+            break;
+        case HMISCoarsening:
+            LOG_INFO("AMG C/F splitting: HMIS");
+            break;
+        default:
+            LOG_INFO("AMG C/F splitting: classical");
+            break;
+        }
+
+        if(this->interpolation_ == ExtPIInterpolation)
+        {
+            LOG_INFO("AMG interpolation: extended+i");
+        }
+        else
+        {
+            LOG_INFO("AMG interpolation: direct");
+        }
+
+        if(this->max_elements_ > 0)
+        {
+            LOG_INFO("AMG interpolation truncated to " << this->max_elements_
+                                                       << " elements per row");
+        }
+
+        if(this->aggressive_levels_ > 0)
+        {
+            LOG_INFO("AMG aggressive coarsening on " << this->aggressive_levels_ << " levels");
+        }
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void RugeStuebenAMG<OperatorType, VectorType, ValueType>::SetCouplingStrength(ValueType eps)
     {
@@ -92,6 +140,50 @@ namespace rocalution
         this->eps_ = eps;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RugeStuebenAMG<OperatorType, VectorType, ValueType>::SetCoarseningStrategy(
+        unsigned int coarsening)
+    {
+        log_debug(this, "RugeStuebenAMG::SetCoarseningStrategy()", coarsening);
+
+        assert(coarsening == ClassicalCoarsening || coarsening == PMISCoarsening
+               || coarsening == HMISCoarsening);
+
+        this->coarsening_ = coarsening;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RugeStuebenAMG<OperatorType, VectorType, ValueType>::SetInterpolationType(
+        unsigned int interpolation)
+    {
+        log_debug(this, "RugeStuebenAMG::SetInterpolationType()", interpolation);
+
+        assert(interpolation == DirectInterpolation || interpolation == ExtPIInterpolation);
+
+        this->interpolation_ = interpolation;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RugeStuebenAMG<OperatorType, VectorType, ValueType>::SetInterpolationTruncation(
+        int max_elements)
+    {
+        log_debug(this, "RugeStuebenAMG::SetInterpolationTruncation()", max_elements);
+
+        assert(max_elements >= 0);
+
+        this->max_elements_ = max_elements;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RugeStuebenAMG<OperatorType, VectorType, ValueType>::SetAggressiveCoarsening(int levels)
+    {
+        log_debug(this, "RugeStuebenAMG::SetAggressiveCoarsening()", levels);
+
+        assert(levels >= 0);
+
+        this->aggressive_levels_ = levels;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void RugeStuebenAMG<OperatorType, VectorType, ValueType>::BuildSmoothers(void)
     {
@@ -129,50 +221,11 @@ namespace rocalution
         assert(this->build_);
         assert(this->op_ != NULL);
 
-        this->op_level_[0]->Clear();
-        this->op_level_[0]->ConvertToCSR();
-
-        if(this->op_->GetFormat() != CSR)
-        {
-            OperatorType op_csr;
-            op_csr.CloneFrom(*this->op_);
-            op_csr.ConvertToCSR();
-
-            // Create coarse operator
-            OperatorType tmp;
-            tmp.CloneBackend(*this->op_);
-            this->op_level_[0]->CloneBackend(*this->op_);
-
-            OperatorType* cast_res = dynamic_cast<OperatorType*>(this->restrict_op_level_[0]);
-            OperatorType* cast_pro = dynamic_cast<OperatorType*>(this->prolong_op_level_[0]);
-            assert(cast_res != NULL);
-            assert(cast_pro != NULL);
-
-            tmp.MatrixMult(*cast_res, op_csr);
-            this->op_level_[0]->MatrixMult(tmp, *cast_pro);
-        }
-        else
-        {
-            // Create coarse operator
-            OperatorType tmp;
-            tmp.CloneBackend(*this->op_);
-            this->op_level_[0]->CloneBackend(*this->op_);
-
-            OperatorType* cast_res = dynamic_cast<OperatorType*>(this->restrict_op_level_[0]);
-            OperatorType* cast_pro = dynamic_cast<OperatorType*>(this->prolong_op_level_[0]);
-            assert(cast_res != NULL);
-            assert(cast_pro != NULL);
-
-            tmp.MatrixMult(*cast_res, *this->op_);
-            this->op_level_[0]->MatrixMult(tmp, *cast_pro);
-        }
-
-        for(int i = 1; i < this->levels_ - 1; ++i)
-        {
+        // Coarse operator of level i, recomputed from the transfer operators
+        auto galerkin = [this](int i) {
             this->op_level_[i]->Clear();
             this->op_level_[i]->ConvertToCSR();
 
-            // Create coarse operator
             OperatorType tmp;
             tmp.CloneBackend(*this->op_);
             this->op_level_[i]->CloneBackend(*this->op_);
@@ -182,6 +235,26 @@ namespace rocalution
             assert(cast_res != NULL);
             assert(cast_pro != NULL);
 
+            if(i == 0)
+            {
+                if(this->op_->GetFormat() != CSR)
+                {
+                    OperatorType op_csr;
+                    op_csr.CloneFrom(*this->op_);
+                    op_csr.ConvertToCSR();
+
+                    tmp.MatrixMult(*cast_res, op_csr);
+                }
+                else
+                {
+                    tmp.MatrixMult(*cast_res, *this->op_);
+                }
+
+                this->op_level_[i]->MatrixMult(tmp, *cast_pro);
+
+                return;
+            }
+
             if(i == this->levels_ - this->host_level_ - 1)
             {
                 this->op_level_[i - 1]->MoveToHost();
@@ -194,35 +267,10 @@ namespace rocalution
             {
                 this->op_level_[i - 1]->CloneBackend(*this->restrict_op_level_[i - 1]);
             }
-        }
-
-        for(int i = 0; i < this->levels_ - 1; ++i)
-        {
-            if(i > 0)
-            {
-                this->smoother_level_[i]->ResetOperator(*this->op_level_[i - 1]);
-            }
-            else
-            {
-                this->smoother_level_[i]->ResetOperator(*this->op_);
-            }
-
-            this->smoother_level_[i]->ReBuildNumeric();
-            this->smoother_level_[i]->Verbose(0);
-        }
-
-        this->solver_coarse_->ResetOperator(*this->op_level_[this->levels_ - 2]);
-        this->solver_coarse_->ReBuildNumeric();
-        this->solver_coarse_->Verbose(0);
+        };
 
-        // Convert operator to op_format
-        if(this->op_format_ != CSR)
-        {
-            for(int i = 0; i < this->levels_ - 1; ++i)
-            {
-                this->op_level_[i]->ConvertTo(this->op_format_);
-            }
-        }
+        // Set up the smoothers of the finer levels while coarser operators are computed
+        this->BuildLevels_(true, galerkin);
 
         log_debug(this, "RugeStuebenAMG::ReBuildNumeric()", " #*# end");
     }
@@ -245,8 +293,18 @@ namespace rocalution
         assert(cast_res != NULL);
         assert(cast_pro != NULL);
 
+        // The hierarchy currently consists of the levels up to op, the first levels are
+        // coarsened aggressively
+        bool aggressive = this->levels_ - 1 < this->aggressive_levels_;
+
         // Create prolongation and restriction operators
-        op.RugeStueben(this->eps_, cast_pro, cast_res);
+        op.RugeStueben(this->eps_,
+                       this->coarsening_,
+                       this->interpolation_,
+                       aggressive,
+                       this->max_elements_,
+                       cast_pro,
+                       cast_res);
 
         // Create coarse operator
         OperatorType tmp;
@@ -32,6 +32,19 @@
 namespace rocalution
 {
 
+    enum _rs_coarsening
+    {
+        ClassicalCoarsening = 0,
+        PMISCoarsening      = 1,
+        HMISCoarsening      = 2
+    };
+
+    enum _rs_interpolation
+    {
+        DirectInterpolation = 0,
+        ExtPIInterpolation  = 1
+    };
+
     /** \ingroup solver_module
   * \class RugeStuebenAMG
   * \brief Ruge-Stueben Algebraic MultiGrid Method
@@ -42,6 +55,17 @@ namespace rocalution
   * has a higher building step and requires higher memory usage.
   * \cite stuben
   *
+  * The sequential classical C/F splitting can be replaced by the parallel PMIS or HMIS
+  * splitting, see SetCoarseningStrategy(). Since they produce coarser grids, they are
+  * usually combined with extended+i interpolation, see SetInterpolationType(), where the
+  * interpolation is truncated to a few entries per row, see SetInterpolationTruncation().
+  * This keeps the operator complexity low for three-dimensional problems. \cite pmis
+  * \cite extpi
+  *
+  * The first levels can be coarsened aggressively, see SetAggressiveCoarsening(), where
+  * the C/F splitting is applied to the strong connections of distance two and extended+i
+  * interpolation is used.
+  *
   * \tparam OperatorType - can be LocalMatrix
   * \tparam VectorType - can be LocalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
@@ -59,6 +83,31 @@ namespace rocalution
         /** \brief Set coupling strength */
         void SetCouplingStrength(ValueType eps);
 
+        /** \brief Set the C/F splitting
+      * \details
+      * \p ClassicalCoarsening (default) uses the sequential Ruge-Stueben splitting.
+      * \p PMISCoarsening and \p HMISCoarsening use the parallel modified independent set
+      * splitting, where HMIS applies the classical splitting to blocks of the grid first.
+      * Both splittings do not depend on the number of threads.
+      */
+        void SetCoarseningStrategy(unsigned int coarsening);
+
+        /** \brief Set the interpolation
+      * \details
+      * \p DirectInterpolation (default) interpolates from the strong C neighbours.
+      * \p ExtPIInterpolation additionally interpolates from the strong C neighbours of
+      * strong F neighbours, which is required by the coarser PMIS and HMIS grids.
+      */
+        void SetInterpolationType(unsigned int interpolation);
+
+        /** \brief Truncate the interpolation to the \p max_elements largest entries per
+      * row, 0 (default) disables the truncation
+      */
+        void SetInterpolationTruncation(int max_elements);
+
+        /** \brief Set the number of levels that are coarsened aggressively (default 0) */
+        void SetAggressiveCoarsening(int levels);
+
         virtual void ReBuildNumeric(void);
 
     protected:
@@ -70,9 +119,21 @@ namespace rocalution
         virtual void PrintStart_(void) const;
         virtual void PrintEnd_(void) const;
 
+        /** \brief Print the coarsening parameters */
+        void PrintCoarsening_(void) const;
+
     private:
         /** \brief Coupling strength */
         ValueType eps_;
+
+        /** \brief C/F splitting */
+        unsigned int coarsening_;
+        /** \brief Interpolation */
+        unsigned int interpolation_;
+        /** \brief Maximal number of interpolation entries per row */
+        int max_elements_;
+        /** \brief Number of aggressively coarsened levels */
+        int aggressive_levels_;
     };
 
 } // namespace rocalution
@@ -137,50 +137,11 @@ namespace rocalution
         assert(this->build_);
         assert(this->op_ != NULL);
 
-        this->op_level_[0]->Clear();
-        this->op_level_[0]->ConvertToCSR();
-
-        if(this->op_->GetFormat() != CSR)
-        {
-            OperatorType op_csr;
-            op_csr.CloneFrom(*this->op_);
-            op_csr.ConvertToCSR();
-
-            // Create coarse operator
-            OperatorType tmp;
-            tmp.CloneBackend(*this->op_);
-            this->op_level_[0]->CloneBackend(*this->op_);
-
-            OperatorType* cast_res = dynamic_cast<OperatorType*>(this->restrict_op_level_[0]);
-            OperatorType* cast_pro = dynamic_cast<OperatorType*>(this->prolong_op_level_[0]);
-            assert(cast_res != NULL);
-            assert(cast_pro != NULL);
-
-            tmp.MatrixMult(*cast_res, op_csr);
-            this->op_level_[0]->MatrixMult(tmp, *cast_pro);
-        }
-        else
-        {
-            // Create coarse operator
-            OperatorType tmp;
-            tmp.CloneBackend(*this->op_);
-            this->op_level_[0]->CloneBackend(*this->op_);
-
-            OperatorType* cast_res = dynamic_cast<OperatorType*>(this->restrict_op_level_[0]);
-            OperatorType* cast_pro = dynamic_cast<OperatorType*>(this->prolong_op_level_[0]);
-            assert(cast_res != NULL);
-            assert(cast_pro != NULL);
-
-            tmp.MatrixMult(*cast_res, *this->op_);
-            this->op_level_[0]->MatrixMult(tmp, *cast_pro);
-        }
-
-        for(int i = 1; i < this->levels_ - 1; ++i)
-        {
+        // Coarse operator of level i, recomputed from the transfer operators
+        auto galerkin = [this](int i) {
             this->op_level_[i]->Clear();
             this->op_level_[i]->ConvertToCSR();
 
-            // Create coarse operator
             OperatorType tmp;
             tmp.CloneBackend(*this->op_);
             this->op_level_[i]->CloneBackend(*this->op_);
@@ -190,6 +151,26 @@ namespace rocalution
             assert(cast_res != NULL);
             assert(cast_pro != NULL);
 
+            if(i == 0)
+            {
+                if(this->op_->GetFormat() != CSR)
+                {
+                    OperatorType op_csr;
+                    op_csr.CloneFrom(*this->op_);
+                    op_csr.ConvertToCSR();
+
+                    tmp.MatrixMult(*cast_res, op_csr);
+                }
+                else
+                {
+                    tmp.MatrixMult(*cast_res, *this->op_);
+                }
+
+                this->op_level_[i]->MatrixMult(tmp, *cast_pro);
+
+                return;
+            }
+
             if(i == this->levels_ - this->host_level_ - 1)
             {
                 this->op_level_[i - 1]->MoveToHost();
@@ -202,35 +183,10 @@ namespace rocalution
             {
                 this->op_level_[i - 1]->CloneBackend(*this->restrict_op_level_[i - 1]);
             }
-        }
+        };
 
-        for(int i = 0; i < this->levels_ - 1; ++i)
-        {
-            if(i > 0)
-            {
-                this->smoother_level_[i]->ResetOperator(*this->op_level_[i - 1]);
-            }
-            else
-            {
-                this->smoother_level_[i]->ResetOperator(*this->op_);
-            }
-
-            this->smoother_level_[i]->ReBuildNumeric();
-            this->smoother_level_[i]->Verbose(0);
-        }
-
-        this->solver_coarse_->ResetOperator(*this->op_level_[this->levels_ - 2]);
-        this->solver_coarse_->ReBuildNumeric();
-        this->solver_coarse_->Verbose(0);
-
-        // Convert operator to op_format
-        if(this->op_format_ != CSR)
-        {
-            for(int i = 0; i < this->levels_ - 1; ++i)
-            {
-                this->op_level_[i]->ConvertTo(this->op_format_);
-            }
-        }
+        // Set up the smoothers of the finer levels while coarser operators are computed
+        this->BuildLevels_(true, galerkin);
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
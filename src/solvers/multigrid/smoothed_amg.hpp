@@ -37,8 +37,9 @@ namespace rocalution
   * \brief Smoothed Aggregation Algebraic MultiGrid Method
   * \details
   * The Smoothed Aggregation Algebraic MultiGrid method is based on smoothed
-  * aggregation based interpolation scheme.
-  * \cite vanek
+  * aggregation based interpolation scheme. The aggregates are built in parallel from a
+  * distance-two maximal independent set of the strength graph.
+  * \cite vanek \cite mis2
   *
   * \tparam OperatorType - can be LocalMatrix
   * \tparam VectorType - can be LocalVector
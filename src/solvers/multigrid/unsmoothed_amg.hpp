@@ -37,8 +37,9 @@ namespace rocalution
   * \brief Unsmoothed Aggregation Algebraic MultiGrid Method
   * \details
   * The Unsmoothed Aggregation Algebraic MultiGrid method is based on unsmoothed
-  * aggregation based interpolation scheme.
-  * \cite stuben
+  * aggregation based interpolation scheme. The aggregates are built in parallel from a
+  * distance-two maximal independent set of the strength graph.
+  * \cite stuben \cite mis2
   *
   * \tparam OperatorType - can be LocalMatrix
   * \tparam VectorType - can be LocalVector
@@ -24,6 +24,7 @@
 #include "preconditioner.hpp"
 #include "../../base/global_matrix.hpp"
 #include "../../base/local_matrix.hpp"
+#include "../../base/local_matrix_free.hpp"
 #include "../../utils/def.hpp"
 #include "../solver.hpp"
 
@@ -454,6 +455,37 @@ namespace rocalution
         log_debug(this, "ILU::Build()", this->build_, " #*# end");
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void ILU<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "ILU::ReBuildNumeric()", this->build_);
+
+        assert(this->build_ == true);
+        assert(this->op_ != NULL);
+
+        // The structure of the factors contains the structure of the operator, the
+        // symbolic factorization is not repeated
+        this->ILU_.Zeros();
+
+        if(this->op_->GetFormat() == this->ILU_.GetFormat())
+        {
+            this->ILU_.MatrixAdd(
+                *this->op_, static_cast<ValueType>(0), static_cast<ValueType>(1), false);
+        }
+        else
+        {
+            OperatorType values;
+            values.CloneFrom(*this->op_);
+            values.ConvertTo(this->ILU_.GetFormat());
+
+            this->ILU_.MatrixAdd(
+                values, static_cast<ValueType>(0), static_cast<ValueType>(1), false);
+        }
+
+        this->ILU_.ILU0Factorize();
+        this->ILU_.LUAnalyse();
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void ILU<OperatorType, VectorType, ValueType>::Clear(void)
     {
@@ -882,6 +914,17 @@ namespace rocalution
                                   std::complex<float>>;
 #endif
 
+    template class Preconditioner<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class Preconditioner<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class Preconditioner<LocalMatrixFree<std::complex<double>>,
+                                  LocalVector<std::complex<double>>,
+                                  std::complex<double>>;
+    template class Preconditioner<LocalMatrixFree<std::complex<float>>,
+                                  LocalVector<std::complex<float>>,
+                                  std::complex<float>>;
+#endif
+
     template class Jacobi<LocalMatrix<double>, LocalVector<double>, double>;
     template class Jacobi<LocalMatrix<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -904,6 +947,17 @@ namespace rocalution
                           std::complex<float>>;
 #endif
 
+    template class Jacobi<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class Jacobi<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class Jacobi<LocalMatrixFree<std::complex<double>>,
+                          LocalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class Jacobi<LocalMatrixFree<std::complex<float>>,
+                          LocalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
     template class GS<LocalMatrix<double>, LocalVector<double>, double>;
     template class GS<LocalMatrix<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -33,7 +33,7 @@ namespace rocalution
   * \class Preconditioner
   * \brief Base class for all preconditioners
   *
-  * \tparam OperatorType - can be LocalMatrix or GlobalMatrix
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalMatrixFree
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -66,7 +66,7 @@ namespace rocalution
   *   \right)
   * \f]
   *
-  * \tparam OperatorType - can be LocalMatrix or GlobalMatrix
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalMatrixFree
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -174,7 +174,9 @@ namespace rocalution
   * \brief Incomplete LU Factorization based on levels
   * \details
   * The Incomplete LU Factorization based on levels computes a sparse lower and sparse
-  * upper triangular matrix such that \f$A = LU - R\f$.
+  * upper triangular matrix such that \f$A = LU - R\f$. The structure of the factors is
+  * kept, such that ReBuildNumeric() only repeats the numerical factorization when the
+  * values of the operator change but its structure does not.
   *
   * \tparam OperatorType - can be LocalMatrix
   * \tparam VectorType - can be LocalVector
@@ -199,6 +201,7 @@ namespace rocalution
       */
         virtual void Set(int p, bool level = true);
         virtual void Build(void);
+        virtual void ReBuildNumeric(void);
         virtual void Clear(void);
 
     protected:
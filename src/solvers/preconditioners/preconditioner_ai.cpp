@@ -62,7 +62,7 @@ namespace rocalution
 
         if(this->build_ == true)
         {
-            LOG_INFO("AI matrix nnz = " << this->AIChebyshev_.GetNnz());
+            LOG_INFO("AI polynomial degree = " << this->weight_.size() - 1);
         }
     }
 
@@ -97,8 +97,7 @@ namespace rocalution
         this->build_ = true;
 
         assert(this->op_ != NULL);
-
-        this->AIChebyshev_.CloneFrom(*this->op_);
+        assert(this->op_->GetM() == this->op_->GetN());
 
         ValueType q = (static_cast<ValueType>(1) - sqrt(this->lambda_min_ / this->lambda_max_))
                       / (static_cast<ValueType>(1) + sqrt(this->lambda_min_ / this->lambda_max_));
@@ -106,58 +105,32 @@ namespace rocalution
 
         // Shifting
         // Z = 2/(beta-alpha) [A-(beta+alpha)/2]
-        OperatorType Z;
-        Z.CloneFrom(*this->op_);
-
-        Z.AddScalarDiagonal(static_cast<ValueType>(-1) * (this->lambda_max_ + this->lambda_min_)
-                            / (static_cast<ValueType>(2)));
-        Z.ScaleDiagonal(static_cast<ValueType>(2) / (this->lambda_max_ - this->lambda_min_));
+        ValueType scale = static_cast<ValueType>(2) / (this->lambda_max_ - this->lambda_min_);
+        ValueType shift = (this->lambda_max_ + this->lambda_min_) / static_cast<ValueType>(2);
 
         // Chebyshev formula/series
-        // ai = I c_0 / 2 + sum c_k T_k
-        // Tk = 2 Z T_k-1 - T_k-2
-
-        // 1st term
-        // T_0 = I
-        // ai = I c_0 / 2
-        this->AIChebyshev_.AddScalarDiagonal(c / static_cast<ValueType>(2));
-
-        OperatorType Tkm2;
-        Tkm2.CloneFrom(Z);
-        // 2nd term
-        // T_1 = Z
-        // ai = ai + c_1 Z
-        c = c * static_cast<ValueType>(-1) * q;
-        this->AIChebyshev_.MatrixAdd(Tkm2, static_cast<ValueType>(1), c, true);
-
-        // T_2 = 2*Z*Z - I
-        // + c (2*Z*Z - I)
-        OperatorType Tkm1;
-        Tkm1.CloneBackend(*this->op_);
-        Tkm1.MatrixMult(Z, Z);
-        Tkm1.Scale(static_cast<ValueType>(2));
-        Tkm1.AddScalarDiagonal(static_cast<ValueType>(-1));
-
-        c = c * static_cast<ValueType>(-1) * q;
-        this->AIChebyshev_.MatrixAdd(Tkm1, static_cast<ValueType>(1), c, true);
-
-        // T_k = 2 Z T_k-1 - T_k-2
-        OperatorType Tk;
-        Tk.CloneBackend(*this->op_);
-
-        for(int i = 2; i <= this->p_; ++i)
+        // ai = I c_0 / 2 + sum c_k T_k, k = 1, ..., p + 1
+        // c_k = 2 c (-q)^k
+        // T_0 = I, T_1 = Z, T_k = 2 Z T_k-1 - T_k-2
+        int degree = this->p_ + 1;
+
+        this->alpha_.resize(degree);
+        this->beta_.resize(degree);
+        this->gamma_.resize(degree);
+        this->weight_.resize(degree + 1);
+
+        this->weight_[0] = c;
+
+        for(int k = 0; k < degree; ++k)
         {
-            Tk.MatrixMult(Z, Tkm1);
-            Tk.MatrixAdd(Tkm2, static_cast<ValueType>(2), static_cast<ValueType>(-1), true);
+            ValueType two = (k > 0) ? static_cast<ValueType>(2) : static_cast<ValueType>(1);
 
-            c = c * static_cast<ValueType>(-1) * q;
-            this->AIChebyshev_.MatrixAdd(Tk, static_cast<ValueType>(1), c, true);
+            this->alpha_[k] = two * scale;
+            this->beta_[k]  = static_cast<ValueType>(-1) * two * scale * shift;
+            this->gamma_[k] = (k > 0) ? static_cast<ValueType>(-1) : static_cast<ValueType>(0);
 
-            if(i + 1 <= this->p_)
-            {
-                Tkm2.CloneFrom(Tkm1);
-                Tkm1.CloneFrom(Tk);
-            }
+            c                    = c * static_cast<ValueType>(-1) * q;
+            this->weight_[k + 1] = static_cast<ValueType>(2) * c;
         }
 
         log_debug(this, "AIChebyshev::Build()", this->build_, " #*# end");
@@ -168,7 +141,11 @@ namespace rocalution
     {
         log_debug(this, "AIChebyshev::Clear()", this->build_);
 
-        this->AIChebyshev_.Clear();
+        this->alpha_.clear();
+        this->beta_.clear();
+        this->gamma_.clear();
+        this->weight_.clear();
+
         this->build_ = false;
     }
 
@@ -176,16 +153,12 @@ namespace rocalution
     void AIChebyshev<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
     {
         log_debug(this, "AIChebyshev::MoveToHostLocalData_()", this->build_);
-
-        this->AIChebyshev_.MoveToHost();
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
     void AIChebyshev<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
     {
         log_debug(this, "AIChebyshev::MoveToAcceleratorLocalData_()", this->build_);
-
-        this->AIChebyshev_.MoveToAccelerator();
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -198,7 +171,14 @@ namespace rocalution
         assert(x != NULL);
         assert(x != &rhs);
 
-        this->AIChebyshev_.Apply(rhs, x);
+        this->op_->MatrixPolynomial(static_cast<int>(this->alpha_.size()),
+                                    this->alpha_.data(),
+                                    this->beta_.data(),
+                                    this->gamma_.data(),
+                                    this->weight_.data(),
+                                    NULL,
+                                    rhs,
+                                    x);
 
         log_debug(this, "AIChebyshev::Solve()", " #*# end");
     }
@@ -27,6 +27,8 @@
 #include "../solver.hpp"
 #include "preconditioner.hpp"
 
+#include <vector>
+
 namespace rocalution
 {
 
@@ -39,6 +41,11 @@ namespace rocalution
   * Chebyshev polynomials.
   * \cite chebpoly
   *
+  * The polynomial is not assembled. It is applied to the right-hand side by the
+  * cache-blocked matrix powers kernel (see LocalMatrix::MatrixPolynomial()), which
+  * avoids the fill-in of the matrix powers and reads the matrix only once per
+  * application on the host.
+  *
   * \tparam OperatorType - can be LocalMatrix
   * \tparam VectorType - can be LocalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
@@ -63,9 +70,15 @@ namespace rocalution
         virtual void MoveToAcceleratorLocalData_(void);
 
     private:
-        OperatorType AIChebyshev_;
-        int          p_;
-        ValueType    lambda_min_, lambda_max_;
+        int       p_;
+        ValueType lambda_min_, lambda_max_;
+
+        // Three-term recurrence of the Chebyshev polynomials of the shifted operator and
+        // the weights of the polynomials in the approximate inverse
+        std::vector<ValueType> alpha_;
+        std::vector<ValueType> beta_;
+        std::vector<ValueType> gamma_;
+        std::vector<ValueType> weight_;
     };
 
     /** \ingroup precond_module
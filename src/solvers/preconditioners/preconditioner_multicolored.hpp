@@ -52,7 +52,9 @@ namespace rocalution
 
         virtual void Build(void);
 
-        /** \brief Set a specific matrix type of the decomposed block matrices */
+        /** \brief Set a specific matrix type of the decomposed block matrices; \p AUTO
+      * selects the format for each block individually
+      */
         void SetPrecondMatrixFormat(unsigned int mat_format);
 
         /** \brief Set if the preconditioner should be decomposed or not */
@@ -96,7 +96,10 @@ namespace rocalution
 
             this->rhs_.Clear();
             this->rhs_1_.Clear();
-            this->rhs_1_.Clear();
+            this->rhs_2_.Clear();
+
+            this->inv_vec_D_.Clear();
+            this->vec_D_.Clear();
 
             this->permutation_.Clear();
 
@@ -194,7 +197,7 @@ namespace rocalution
 
         this->rhs_.CloneBackend(*this->op_);
         this->rhs_1_.CloneBackend(*this->op_);
-        this->rhs_1_.CloneBackend(*this->op_);
+        this->rhs_2_.CloneBackend(*this->op_);
 
         this->permutation_.CloneBackend(this->x_);
 
@@ -206,38 +209,12 @@ namespace rocalution
 
         this->A_.Permute(this->permutation_);
 
-        this->A_.ExtractSubMatrix(0, 0, this->size_, this->size_, &this->D_);
-
-        this->A_.ExtractSubMatrix(
-            0, this->size_, this->size_, this->A_.GetLocalN() - this->size_, &this->F_);
-
-        this->A_.ExtractSubMatrix(
-            this->size_, 0, this->A_.GetLocalM() - this->size_, this->size_, &this->E_);
-
-        this->A_.ExtractSubMatrix(this->size_,
-                                  this->size_,
-                                  this->A_.GetLocalM() - this->size_,
-                                  this->A_.GetLocalN() - this->size_,
-                                  &this->C_);
+        // Blocks E D^-1 and F, and AA = C - E D^-1 F in a single pass
+        this->A_.SchurComplement(
+            this->size_, &this->inv_vec_D_, &this->E_, &this->F_, &this->AA_);
 
         this->A_.Clear();
 
-        this->D_.ExtractInverseDiagonal(&this->inv_vec_D_);
-        this->D_.ExtractDiagonal(&this->vec_D_);
-
-        this->E_.DiagonalMatrixMult(this->inv_vec_D_); // E =  E * D^-1
-
-        this->AA_.MatrixMult(this->E_, this->F_); // AA = E * D^-1 * F
-
-        //  this->AA_.ScaleDiagonal(-1.0);
-        //  this->AA_.ScaleOffDiagonal(-1.0);
-        //  this->AA_.MatrixAdd(this->C_);
-
-        // AA = C - E D^-1 F
-        this->AA_.MatrixAdd(this->C_, static_cast<ValueType>(-1), static_cast<ValueType>(1), true);
-
-        this->C_.Clear();
-
         if(this->drop_off_ > 0.0)
         {
             this->AA_.Compress(this->drop_off_);
@@ -279,9 +256,6 @@ namespace rocalution
         this->x_2_.CloneBackend(*this->op_);
         this->x_2_.Allocate("Permuted solution vector", this->op_->GetM() - this->size_);
 
-        this->rhs_1_.CloneBackend(*this->op_);
-        this->rhs_1_.Allocate("Permuted solution vector", this->size_);
-
         this->rhs_2_.CloneBackend(*this->op_);
         this->rhs_2_.Allocate("Permuted solution vector", this->op_->GetM() - this->size_);
 
@@ -50,7 +50,9 @@ namespace rocalution
   * independent set. This procedure can be applied to the block matrix \f$\hat{A}\f$, in
   * this way we can perform the factorization recursively. In the last level of the
   * recursion, we need to provide a solution procedure. By the design of the library,
-  * this can be any kind of solver.
+  * this can be any kind of solver. On the host, the independent set and the blocks
+  * \f$ED^{-1}\f$, \f$F\f$ and \f$\hat{A}\f$ of each level are computed in parallel, see
+  * MaximalIndependentSet() and SchurComplement().
   * \cite SAAD
   *
   * \tparam OperatorType - can be LocalMatrix
@@ -87,7 +89,9 @@ namespace rocalution
                  int                                          level,
                  double                                       drop_off = 0.0);
 
-        /** \brief Set a specific matrix type of the decomposed block matrices */
+        /** \brief Set a specific matrix type of the decomposed block matrices; \p AUTO
+      * selects the format for each block individually
+      */
         void SetPrecondMatrixFormat(unsigned int mat_format);
 
         virtual void Build(void);
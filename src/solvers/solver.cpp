@@ -25,6 +25,7 @@
 #include "../utils/def.hpp"
 
 #include "../base/local_matrix.hpp"
+#include "../base/local_matrix_free.hpp"
 #include "../base/local_stencil.hpp"
 #include "../base/local_vector.hpp"
 
@@ -365,6 +366,37 @@ namespace rocalution
         return 0;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    int IterativeLinearSolver<OperatorType, VectorType, ValueType>::Norm_(
+        const VectorType& vec, ReductionBatch<ValueType>* batch)
+    {
+        log_debug(this, "IterativeLinearSolver::Norm_()", (const void*&)vec, batch);
+
+        assert(batch != NULL);
+
+        // L1 norm
+        if(this->res_norm_ == 1)
+        {
+            return batch->Asum(vec);
+        }
+
+        // L2 norm
+        if(this->res_norm_ == 2)
+        {
+            return batch->Norm(vec);
+        }
+
+        // Infinity norm, cannot be combined with other reductions
+        if(this->res_norm_ == 3)
+        {
+            ValueType amax;
+            this->index_ = vec.Amax(amax);
+            return batch->Value(amax);
+        }
+
+        return batch->Value(static_cast<ValueType>(0));
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void IterativeLinearSolver<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs,
                                                                            VectorType*       x)
@@ -756,6 +788,17 @@ namespace rocalution
                           std::complex<float>>;
 #endif
 
+    template class Solver<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class Solver<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class Solver<LocalMatrixFree<std::complex<double>>,
+                          LocalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class Solver<LocalMatrixFree<std::complex<float>>,
+                          LocalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
     template class IterativeLinearSolver<LocalStencil<double>, LocalVector<double>, double>;
     template class IterativeLinearSolver<LocalStencil<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -767,6 +810,17 @@ namespace rocalution
                                          std::complex<float>>;
 #endif
 
+    template class IterativeLinearSolver<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class IterativeLinearSolver<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class IterativeLinearSolver<LocalMatrixFree<std::complex<double>>,
+                                         LocalVector<std::complex<double>>,
+                                         std::complex<double>>;
+    template class IterativeLinearSolver<LocalMatrixFree<std::complex<float>>,
+                                         LocalVector<std::complex<float>>,
+                                         std::complex<float>>;
+#endif
+
     template class FixedPoint<LocalStencil<double>, LocalVector<double>, double>;
     template class FixedPoint<LocalStencil<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -778,6 +832,17 @@ namespace rocalution
                               std::complex<float>>;
 #endif
 
+    template class FixedPoint<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class FixedPoint<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class FixedPoint<LocalMatrixFree<std::complex<double>>,
+                              LocalVector<std::complex<double>>,
+                              std::complex<double>>;
+    template class FixedPoint<LocalMatrixFree<std::complex<float>>,
+                              LocalVector<std::complex<float>>,
+                              std::complex<float>>;
+#endif
+
     template class DirectLinearSolver<LocalStencil<double>, LocalVector<double>, double>;
     template class DirectLinearSolver<LocalStencil<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -789,4 +854,15 @@ namespace rocalution
                                       std::complex<float>>;
 #endif
 
+    template class DirectLinearSolver<LocalMatrixFree<double>, LocalVector<double>, double>;
+    template class DirectLinearSolver<LocalMatrixFree<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class DirectLinearSolver<LocalMatrixFree<std::complex<double>>,
+                                      LocalVector<std::complex<double>>,
+                                      std::complex<double>>;
+    template class DirectLinearSolver<LocalMatrixFree<std::complex<float>>,
+                                      LocalVector<std::complex<float>>,
+                                      std::complex<float>>;
+#endif
+
 } // namespace rocalution
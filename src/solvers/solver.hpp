@@ -26,6 +26,7 @@
 
 #include "../base/base_rocalution.hpp"
 #include "../base/local_vector.hpp"
+#include "../base/reduction_batch.hpp"
 #include "iter_ctrl.hpp"
 
 namespace rocalution
@@ -35,12 +36,13 @@ namespace rocalution
   * \class Solver
   * \brief Base class for all solvers and preconditioners
   * \details
-  * Most of the solvers can be performed on linear operators LocalMatrix, LocalStencil
-  * and GlobalMatrix - i.e. the solvers can be performed locally (on a shared memory
-  * system) or in a distributed manner (on a cluster) via MPI. The only exception is the
-  * AMG (Algebraic Multigrid) solver which has two versions (one for LocalMatrix and one
-  * for GlobalMatrix class). The only pure local solvers (which do not support global/MPI
-  * operations) are the mixed-precision defect-correction solver and all direct solvers.
+  * Most of the solvers can be performed on linear operators LocalMatrix, LocalStencil,
+  * LocalMatrixFree and GlobalMatrix - i.e. the solvers can be performed locally (on a
+  * shared memory system) or in a distributed manner (on a cluster) via MPI. The only
+  * exception is the AMG (Algebraic Multigrid) solver which has two versions (one for
+  * LocalMatrix and one for GlobalMatrix class). The only pure local solvers (which do not
+  * support global/MPI operations) are the mixed-precision defect-correction solver and all
+  * direct solvers.
   *
   * All solvers need three template parameters - Operators, Vectors and Scalar type.
   *
@@ -55,7 +57,8 @@ namespace rocalution
   * - MoveToHost() and MoveToAccelerator() to offload the solver (including
   *   preconditioners and sub-solvers) to the host/accelerator.
   *
-  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil or
+  *                       LocalMatrixFree
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -184,7 +187,8 @@ namespace rocalution
   * - 3, if divergence tolerance has been reached
   * - 4, if maximum number of iteration has been reached
   *
-  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil or
+  *                       LocalMatrixFree
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -269,6 +273,12 @@ namespace rocalution
 
         /** \brief Computes the vector norm */
         ValueType Norm_(const VectorType& vec);
+
+        /** \brief Enqueues the vector norm into a reduction batch and returns its handle */
+        int Norm_(const VectorType& vec, ReductionBatch<ValueType>* batch);
+
+        /** \brief Reduction batch to combine the global reductions of an iteration */
+        ReductionBatch<ValueType> batch_;
     };
 
     /** \ingroup solver_module
@@ -287,7 +297,8 @@ namespace rocalution
   * The inversion of \f$M\f$ can be performed by preconditioners (Jacobi, Gauss-Seidel,
   * ILU, etc.) or by any type of solvers.
   *
-  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil or
+  *                       LocalMatrixFree
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -38,7 +38,7 @@ namespace rocalution
     //#define LONG_PTR long
 
     template <typename DataType>
-    void allocate_host(int size, DataType** ptr)
+    void allocate_host(IndexType2 size, DataType** ptr)
     {
         log_debug(0, "allocate_host()", "* begin", size, ptr);
 
@@ -122,7 +122,7 @@ namespace rocalution
     }
 
     template <typename DataType>
-    void set_to_zero_host(int size, DataType* ptr)
+    void set_to_zero_host(IndexType2 size, DataType* ptr)
     {
         log_debug(0, "set_to_zero_host()", size, ptr);
 
@@ -137,15 +137,18 @@ namespace rocalution
         }
     }
 
-    template void allocate_host<float>(int size, float** ptr);
-    template void allocate_host<double>(int size, double** ptr);
+    template void allocate_host<float>(IndexType2 size, float** ptr);
+    template void allocate_host<double>(IndexType2 size, double** ptr);
 #ifdef SUPPORT_COMPLEX
-    template void allocate_host<std::complex<float>>(int size, std::complex<float>** ptr);
-    template void allocate_host<std::complex<double>>(int size, std::complex<double>** ptr);
+    template void allocate_host<std::complex<float>>(IndexType2 size,
+                                                     std::complex<float>** ptr);
+    template void allocate_host<std::complex<double>>(IndexType2 size,
+                                                      std::complex<double>** ptr);
 #endif
-    template void allocate_host<int>(int size, int** ptr);
-    template void allocate_host<unsigned int>(int size, unsigned int** ptr);
-    template void allocate_host<char>(int size, char** ptr);
+    template void allocate_host<int>(IndexType2 size, int** ptr);
+    template void allocate_host<IndexType2>(IndexType2 size, IndexType2** ptr);
+    template void allocate_host<unsigned int>(IndexType2 size, unsigned int** ptr);
+    template void allocate_host<char>(IndexType2 size, char** ptr);
 
     template void free_host<float>(float** ptr);
     template void free_host<double>(double** ptr);
@@ -154,17 +157,21 @@ namespace rocalution
     template void free_host<std::complex<double>>(std::complex<double>** ptr);
 #endif
     template void free_host<int>(int** ptr);
+    template void free_host<IndexType2>(IndexType2** ptr);
     template void free_host<unsigned int>(unsigned int** ptr);
     template void free_host<char>(char** ptr);
 
-    template void set_to_zero_host<float>(int size, float* ptr);
-    template void set_to_zero_host<double>(int size, double* ptr);
+    template void set_to_zero_host<float>(IndexType2 size, float* ptr);
+    template void set_to_zero_host<double>(IndexType2 size, double* ptr);
 #ifdef SUPPORT_COMPLEX
-    template void set_to_zero_host<std::complex<float>>(int size, std::complex<float>* ptr);
-    template void set_to_zero_host<std::complex<double>>(int size, std::complex<double>* ptr);
+    template void set_to_zero_host<std::complex<float>>(IndexType2 size,
+                                                        std::complex<float>* ptr);
+    template void set_to_zero_host<std::complex<double>>(IndexType2 size,
+                                                         std::complex<double>* ptr);
 #endif
-    template void set_to_zero_host<int>(int size, int* ptr);
-    template void set_to_zero_host<unsigned int>(int size, unsigned int* ptr);
-    template void set_to_zero_host<char>(int size, char* ptr);
+    template void set_to_zero_host<int>(IndexType2 size, int* ptr);
+    template void set_to_zero_host<IndexType2>(IndexType2 size, IndexType2* ptr);
+    template void set_to_zero_host<unsigned int>(IndexType2 size, unsigned int* ptr);
+    template void set_to_zero_host<char>(IndexType2 size, char* ptr);
 
 } // namespace rocalution
@@ -24,6 +24,8 @@
 #ifndef ROCALUTION_UTILS_ALLOCATE_FREE_HPP_
 #define ROCALUTION_UTILS_ALLOCATE_FREE_HPP_
 
+#include "types.hpp"
+
 namespace rocalution
 {
 
@@ -42,7 +44,7 @@ namespace rocalution
   *         or std::complex<double>.
   */
     template <typename DataType>
-    void allocate_host(int size, DataType** ptr);
+    void allocate_host(IndexType2 size, DataType** ptr);
 
     /** \ingroup backend_module
   * \brief Free buffer on the host
@@ -74,7 +76,7 @@ namespace rocalution
   *         or std::complex<double>.
   */
     template <typename DataType>
-    void set_to_zero_host(int size, DataType* ptr);
+    void set_to_zero_host(IndexType2 size, DataType* ptr);
 
 } // namespace rocalution
 
@@ -113,6 +113,65 @@ namespace rocalution
         CHECK_MPI_ERROR(status, __FILE__, __LINE__);
     }
 
+    template <>
+    void communication_exscan_single_sum(long local, long* global, const void* comm)
+    {
+        int rank;
+        int status = MPI_Comm_rank(*(MPI_Comm*)comm, &rank);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+
+        status = MPI_Exscan(&local, global, 1, MPI_LONG, MPI_SUM, *(MPI_Comm*)comm);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+
+        // Undefined on the first process
+        if(rank == 0)
+        {
+            *global = 0;
+        }
+    }
+
+    template <>
+    void communication_async_allreduce_sum(
+        const double* local, double* global, int count, MRequest* request, const void* comm)
+    {
+        int status = MPI_Iallreduce(
+            local, global, count, MPI_DOUBLE, MPI_SUM, *(MPI_Comm*)comm, &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_async_allreduce_sum(
+        const float* local, float* global, int count, MRequest* request, const void* comm)
+    {
+        int status = MPI_Iallreduce(
+            local, global, count, MPI_FLOAT, MPI_SUM, *(MPI_Comm*)comm, &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_async_allreduce_sum(const std::complex<double>* local,
+                                           std::complex<double>*       global,
+                                           int                         count,
+                                           MRequest*                   request,
+                                           const void*                 comm)
+    {
+        int status = MPI_Iallreduce(
+            local, global, count, MPI_DOUBLE_COMPLEX, MPI_SUM, *(MPI_Comm*)comm, &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_async_allreduce_sum(const std::complex<float>* local,
+                                           std::complex<float>*       global,
+                                           int                        count,
+                                           MRequest*                  request,
+                                           const void*                comm)
+    {
+        int status = MPI_Iallreduce(
+            local, global, count, MPI_COMPLEX, MPI_SUM, *(MPI_Comm*)comm, &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
     template <>
     void communication_async_recv(
         double* buf, int count, int source, int tag, MRequest* request, const void* comm)
@@ -238,6 +297,26 @@ namespace rocalution
         std::complex<float> local, std::complex<float>* global, const void* comm);
 #endif
 
+    template void communication_async_allreduce_sum<double>(
+        const double* local, double* global, int count, MRequest* request, const void* comm);
+    template void communication_async_allreduce_sum<float>(
+        const float* local, float* global, int count, MRequest* request, const void* comm);
+
+#ifdef SUPPORT_COMPLEX
+    template void communication_async_allreduce_sum<std::complex<double>>(
+        const std::complex<double>* local,
+        std::complex<double>*       global,
+        int                         count,
+        MRequest*                   request,
+        const void*                 comm);
+    template void communication_async_allreduce_sum<std::complex<float>>(
+        const std::complex<float>* local,
+        std::complex<float>*       global,
+        int                        count,
+        MRequest*                  request,
+        const void*                comm);
+#endif
+
     template void communication_async_recv<double>(
         double* buf, int count, int source, int tag, MRequest* request, const void* comm);
     template void communication_async_recv<float>(
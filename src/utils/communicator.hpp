@@ -39,6 +39,13 @@ namespace rocalution
     template <typename ValueType>
     void communication_allreduce_single_sum(ValueType local, ValueType* global, const void* comm);
 
+    template <typename ValueType>
+    void communication_exscan_single_sum(ValueType local, ValueType* global, const void* comm);
+
+    template <typename ValueType>
+    void communication_async_allreduce_sum(
+        const ValueType* local, ValueType* global, int count, MRequest* request, const void* comm);
+
     template <typename ValueType>
     void communication_async_recv(
         ValueType* buf, int count, int source, int tag, MRequest* request, const void* comm);
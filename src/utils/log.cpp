@@ -82,4 +82,11 @@ namespace rocalution
         }
     }
 
+    std::mutex& _rocalution_log_mutex(void)
+    {
+        static std::mutex log_mutex;
+
+        return log_mutex;
+    }
+
 } // namespace rocalution
@@ -28,6 +28,7 @@
 #include "def.hpp"
 
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <stdlib.h>
 #include <string>
@@ -38,6 +39,9 @@ namespace rocalution
     void _rocalution_open_log_file(void);
     void _rocalution_close_log_file(void);
 
+    // Serializes the log file output of concurrent host tasks
+    std::mutex& _rocalution_log_mutex(void);
+
     template <typename F, typename... Ts>
     void each_args(F f, Ts&... xs)
     {
@@ -78,6 +82,8 @@ namespace rocalution
     {
         if(_get_backend_descriptor()->log_file != NULL)
         {
+            std::lock_guard<std::mutex> lock(_rocalution_log_mutex());
+
             std::string   comma_separator = ", ";
             std::ostream* os              = _get_backend_descriptor()->log_file;
             log_arguments(*os, comma_separator, _get_backend_descriptor()->rank, ptr, fct, xs...);
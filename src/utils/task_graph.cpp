@@ -0,0 +1,198 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "task_graph.hpp"
+#include "../base/backend_manager.hpp"
+#include "def.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace rocalution
+{
+
+    TaskGraph::TaskGraph()
+    {
+        log_debug(this, "TaskGraph::TaskGraph()");
+    }
+
+    TaskGraph::~TaskGraph()
+    {
+        log_debug(this, "TaskGraph::~TaskGraph()");
+    }
+
+    int TaskGraph::AddTask(const std::function<void(void)>& task)
+    {
+        assert(task);
+
+        Task t;
+        t.func = task;
+        t.ndep = 0;
+
+        this->tasks_.push_back(t);
+
+        return static_cast<int>(this->tasks_.size()) - 1;
+    }
+
+    void TaskGraph::AddDependency(int task, int dep)
+    {
+        assert(task >= 0 && task < this->GetSize());
+        assert(dep >= 0 && dep < this->GetSize());
+
+        // Tasks can only depend on previously added tasks, the graph is acyclic
+        assert(dep < task);
+
+        this->tasks_[dep].succ.push_back(task);
+        ++this->tasks_[task].ndep;
+    }
+
+    int TaskGraph::GetSize(void) const
+    {
+        return static_cast<int>(this->tasks_.size());
+    }
+
+    void TaskGraph::Clear(void)
+    {
+        this->tasks_.clear();
+    }
+
+    void TaskGraph::Execute(int nworkers)
+    {
+        log_debug(this, "TaskGraph::Execute()", nworkers);
+
+        int ntask = this->GetSize();
+
+        if(ntask == 0)
+        {
+            return;
+        }
+
+        // Number of unfinished dependencies and tasks ready to run
+        std::vector<int> ndep(ntask);
+        std::deque<int>  ready;
+
+        for(int i = 0; i < ntask; ++i)
+        {
+            ndep[i] = this->tasks_[i].ndep;
+
+            if(ndep[i] == 0)
+            {
+                ready.push_back(i);
+            }
+        }
+
+        nworkers = std::min(nworkers, ntask);
+
+        // Run the tasks in order
+        if(nworkers <= 1)
+        {
+            while(ready.empty() == false)
+            {
+                int t = ready.front();
+                ready.pop_front();
+
+                this->tasks_[t].func();
+
+                for(size_t j = 0; j < this->tasks_[t].succ.size(); ++j)
+                {
+                    int s = this->tasks_[t].succ[j];
+
+                    if(--ndep[s] == 0)
+                    {
+                        ready.push_back(s);
+                    }
+                }
+            }
+
+            return;
+        }
+
+        std::mutex              mtx;
+        std::condition_variable cv;
+
+        int done = 0;
+
+        auto worker = [&](void) {
+            std::unique_lock<std::mutex> lock(mtx);
+
+            while(true)
+            {
+                cv.wait(lock, [&] { return ready.empty() == false || done == ntask; });
+
+                if(ready.empty() == true)
+                {
+                    break;
+                }
+
+                int t = ready.front();
+                ready.pop_front();
+
+                lock.unlock();
+
+                // The OpenMP threads are split between the running tasks
+                _rocalution_task_begin();
+                this->tasks_[t].func();
+                _rocalution_task_end();
+
+                lock.lock();
+
+                ++done;
+
+                for(size_t j = 0; j < this->tasks_[t].succ.size(); ++j)
+                {
+                    int s = this->tasks_[t].succ[j];
+
+                    if(--ndep[s] == 0)
+                    {
+                        ready.push_back(s);
+                    }
+                }
+
+                cv.notify_all();
+            }
+        };
+
+        // The calling thread is one of the workers
+        std::vector<std::thread> threads;
+
+        for(int i = 1; i < nworkers; ++i)
+        {
+            threads.push_back(std::thread(worker));
+        }
+
+        worker();
+
+        for(size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i].join();
+        }
+
+        assert(done == ntask);
+    }
+
+} // namespace rocalution
@@ -0,0 +1,76 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_UTILS_TASK_GRAPH_HPP_
+#define ROCALUTION_UTILS_TASK_GRAPH_HPP_
+
+#include <functional>
+#include <vector>
+
+namespace rocalution
+{
+
+    /// Host task graph, used to overlap independent phases of the solver setup. A task
+    /// is started as soon as all tasks it depends on have finished. The tasks run on up
+    /// to nworkers host threads (including the calling thread), the OpenMP threads of the
+    /// backend are split between the running tasks.
+    class TaskGraph
+    {
+    public:
+        TaskGraph();
+        ~TaskGraph();
+
+        /// Add a task, returns its id
+        int AddTask(const std::function<void(void)>& task);
+        /// Task \p task cannot start before task \p dep has finished
+        void AddDependency(int task, int dep);
+
+        /// Return the number of tasks
+        int GetSize(void) const;
+
+        /// Execute all tasks and wait for their completion, nworkers <= 1 runs them
+        /// in order on the calling thread
+        void Execute(int nworkers);
+
+        /// Remove all tasks
+        void Clear(void);
+
+    private:
+        struct Task
+        {
+            std::function<void(void)> func;
+
+            // Tasks waiting for this task
+            std::vector<int> succ;
+
+            // Number of tasks this task depends on
+            int ndep;
+        };
+
+        std::vector<Task> tasks_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_UTILS_TASK_GRAPH_HPP_